@@ -213,6 +213,7 @@ class achievements_tracker : public event_subscriber
 
         void clear();
         void notify( const cata::event & ) override;
+        bool handles( event_type ) const override;
 
         void serialize( JsonOut & ) const;
         void deserialize( const JsonObject &jo );
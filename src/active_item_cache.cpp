@@ -8,10 +8,15 @@
 
 void active_item_cache::remove( const item *it )
 {
-    active_items[it->processing_speed()].remove_if( [it]( const item_reference & active_item ) {
-        item *const target = active_item.item_ref.get();
-        return !target || target == it;
-    } );
+    const auto wheel = active_items.find( it->processing_speed() );
+    if( wheel != active_items.end() ) {
+        for( std::list<item_reference> &slot : wheel->second.slots ) {
+            slot.remove_if( [it]( const item_reference & active_item ) {
+                item *const target = active_item.item_ref.get();
+                return !target || target == it;
+            } );
+        }
+    }
     if( it->can_revive() ) {
         special_items[ special_item_type::corpse ].remove_if( [it]( const item_reference & active_item ) {
             item *const target = active_item.item_ref.get();
@@ -29,13 +34,18 @@ void active_item_cache::remove( const item *it )
 
 void active_item_cache::add( item &it, point location )
 {
+    const int speed = it.processing_speed();
+    processing_wheel &wheel = active_items[speed];
+    if( wheel.slots.empty() ) {
+        wheel.slots.resize( std::max( speed, 1 ) );
+    }
     // If the item is already in the cache for some reason, don't add a second reference
-    std::list<item_reference> &target_list = active_items[it.processing_speed()];
-    if( std::find_if( target_list.begin(),
-    target_list.end(), [&it]( const item_reference & active_item_ref ) {
-    return &it == active_item_ref.item_ref.get();
-    } ) != target_list.end() ) {
-        return;
+    for( const std::list<item_reference> &slot : wheel.slots ) {
+        if( std::find_if( slot.begin(), slot.end(), [&it]( const item_reference & active_item_ref ) {
+        return &it == active_item_ref.item_ref.get();
+        } ) != slot.end() ) {
+            return;
+        }
     }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].push_back( item_reference{ location, it.get_safe_reference() } );
@@ -43,26 +53,32 @@ void active_item_cache::add( item &it, point location )
     if( it.get_use( "explosion" ) ) {
         special_items[ special_item_type::explosive ].push_back( item_reference{ location, it.get_safe_reference() } );
     }
-    target_list.push_back( item_reference{ location, it.get_safe_reference() } );
+    wheel.slots[wheel.next_free].push_back( item_reference{ location, it.get_safe_reference() } );
+    wheel.next_free = ( wheel.next_free + 1 ) % wheel.slots.size();
 }
 
 bool active_item_cache::empty() const
 {
     return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
-        return active_queue.second.empty();
+        return std::all_of( active_queue.second.slots.begin(), active_queue.second.slots.end(),
+        []( const std::list<item_reference> &slot ) {
+            return slot.empty();
+        } );
     } );
 }
 
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
-            if( it->item_ref ) {
-                all_cached_items.emplace_back( *it );
-                ++it;
-            } else {
-                it = kv.second.erase( it );
+    for( std::pair<const int, processing_wheel> &kv : active_items ) {
+        for( std::list<item_reference> &slot : kv.second.slots ) {
+            for( std::list<item_reference>::iterator it = slot.begin(); it != slot.end(); ) {
+                if( it->item_ref ) {
+                    all_cached_items.emplace_back( *it );
+                    ++it;
+                } else {
+                    it = slot.erase( it );
+                }
             }
         }
     }
@@ -71,28 +87,25 @@ std::vector<item_reference> active_item_cache::get()
 
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
+    size_t num_due = 0;
+    for( const std::pair<const int, processing_wheel> &kv : active_items ) {
+        num_due += kv.second.slots[kv.second.due].size();
+    }
     std::vector<item_reference> items_to_process;
-    items_to_process.reserve( std::accumulate( active_items.begin(), active_items.end(), 0,
-    []( size_t prev, const auto & kv ) {
-        return prev + kv.second.size() / kv.first;
-    } ) );
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
+    items_to_process.reserve( num_due );
+    for( std::pair<const int, processing_wheel> &kv : active_items ) {
+        processing_wheel &wheel = kv.second;
+        std::list<item_reference> &slot = wheel.slots[wheel.due];
+        for( std::list<item_reference>::iterator it = slot.begin(); it != slot.end(); ) {
             if( it->item_ref ) {
                 items_to_process.push_back( *it );
-                --num_to_process;
                 ++it;
             } else {
                 // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.erase( it );
+                it = slot.erase( it );
             }
         }
-        // Rotate the returned items to the end of their list so that the items that weren't
-        // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
+        wheel.due = ( wheel.due + 1 ) % wheel.slots.size();
     }
     return items_to_process;
 }
@@ -108,30 +121,36 @@ std::vector<item_reference> active_item_cache::get_special( special_item_type ty
 
 void active_item_cache::subtract_locations( const point &delta )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location -= delta;
+    for( std::pair<const int, processing_wheel> &pair : active_items ) {
+        for( std::list<item_reference> &slot : pair.second.slots ) {
+            for( item_reference &ir : slot ) {
+                ir.location -= delta;
+            }
         }
     }
 }
 
 void active_item_cache::rotate_locations( int turns, const point &dim )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location = ir.location.rotate( turns, dim );
+    for( std::pair<const int, processing_wheel> &pair : active_items ) {
+        for( std::list<item_reference> &slot : pair.second.slots ) {
+            for( item_reference &ir : slot ) {
+                ir.location = ir.location.rotate( turns, dim );
+            }
         }
     }
 }
 
 void active_item_cache::mirror( const point &dim, bool horizontally )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            if( horizontally ) {
-                ir.location.x = dim.x - 1 - ir.location.x;
-            } else {
-                ir.location.y = dim.y - 1 - ir.location.y;
+    for( std::pair<const int, processing_wheel> &pair : active_items ) {
+        for( std::list<item_reference> &slot : pair.second.slots ) {
+            for( item_reference &ir : slot ) {
+                if( horizontally ) {
+                    ir.location.x = dim.x - 1 - ir.location.x;
+                } else {
+                    ir.location.y = dim.y - 1 - ir.location.y;
+                }
             }
         }
     }
@@ -37,7 +37,19 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
+        /**
+         * The items sharing one processing_speed(), spread over that many slots.  One slot
+         * comes due per call to get_for_processing(), so every item is returned once every
+         * processing_speed() calls and only the due slot is walked.
+         */
+        struct processing_wheel {
+            std::vector<std::list<item_reference>> slots;
+            // The slot get_for_processing() returns next.
+            size_t due = 0;
+            // The slot the next added item goes to, handed out round robin.
+            size_t next_free = 0;
+        };
+        std::unordered_map<int, processing_wheel> active_items;
         std::unordered_map<special_item_type, std::list<item_reference>> special_items;
 
     public:
@@ -66,9 +78,8 @@ class active_item_cache
         std::vector<item_reference> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the items whose slot is due, about size() / processing_speed() of each speed,
+         * and advances every wheel to its next slot.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
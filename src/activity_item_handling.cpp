@@ -11,6 +11,8 @@
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -1084,7 +1086,8 @@ static activity_reason_info can_do_activity_there( const activity_id &act, Chara
         const tripoint &src_loc, const int distance = ACTIVITY_SEARCH_DISTANCE )
 {
     // see activity_handlers.h cant_do_activity_reason enums
-    you.invalidate_crafting_inventory();
+    // The crafting inventory was invalidated by the caller, before it started to go through the
+    // tiles, and is not changed while it does.
     zone_manager &mgr = zone_manager::get_manager();
     std::vector<zone_data> zones;
     Character &player_character = get_player_character();
@@ -2170,6 +2173,16 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
             items.emplace_back( &it, false );
         }
 
+        // Nothing but the items moved from this tile changes the zones and the destinations
+        // until this returns, so what was found out about them is kept for the other items.
+        // Without a custom zone in range, the destinations of a zone type are the same for
+        // every item.
+        const bool same_dests_for_all = !mgr.has_near( zone_type_LOOT_CUSTOM, abspos,
+                                        ACTIVITY_SEARCH_DISTANCE );
+        std::unordered_map<zone_type_id, std::unordered_set<tripoint>> dests_of_type;
+        // The room a destination had when it was last checked, it can only get less.
+        std::unordered_map<tripoint, units::volume> known_free_space;
+
         //Skip items that have already been processed
         for( auto it = items.begin() + num_processed; it < items.end(); ++it ) {
             ++num_processed;
@@ -2203,8 +2216,19 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
                 continue;
             }
 
-            const std::unordered_set<tripoint> &dest_set = mgr.get_near( id, abspos, ACTIVITY_SEARCH_DISTANCE,
-                    &thisitem );
+            std::unordered_set<tripoint> item_dest_set;
+            const std::unordered_set<tripoint> *dest_set_ptr = &item_dest_set;
+            if( same_dests_for_all ) {
+                auto dests = dests_of_type.find( id );
+                if( dests == dests_of_type.end() ) {
+                    dests = dests_of_type.emplace( id, mgr.get_near( id, abspos,
+                                                   ACTIVITY_SEARCH_DISTANCE ) ).first;
+                }
+                dest_set_ptr = &dests->second;
+            } else {
+                item_dest_set = mgr.get_near( id, abspos, ACTIVITY_SEARCH_DISTANCE, &thisitem );
+            }
+            const std::unordered_set<tripoint> &dest_set = *dest_set_ptr;
 
             // if this item isn't going anywhere and its not sealed
             // then we should unload it and see what is inside
@@ -2231,7 +2255,12 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
                 return;
             }
 
+            const units::volume item_volume = thisitem.volume();
             for( const tripoint &dest : dest_set ) {
+                const auto known_free = known_free_space.find( dest );
+                if( known_free != known_free_space.end() && known_free->second < item_volume ) {
+                    continue;
+                }
                 const tripoint &dest_loc = here.getlocal( dest );
 
                 //Check destination for cargo part
@@ -2257,8 +2286,10 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
                 } else {
                     free_space = here.free_volume( dest_loc );
                 }
+                known_free_space[dest] = free_space;
                 // check free space at destination
-                if( free_space >= thisitem.volume() ) {
+                if( free_space >= item_volume ) {
+                    known_free_space[dest] -= item_volume;
                     move_item( you, thisitem, thisitem.count(), src_loc, dest_loc, this_veh, this_part );
 
                     // moved item away from source so decrement
@@ -2568,11 +2599,15 @@ static std::unordered_set<tripoint> generic_multi_activity_locations( Character
     return src_set;
 }
 
-/** Check if this activity can not be done immediately because it has some requirements */
+/**
+ * Check if this activity can not be done immediately because it has some requirements
+ * @param loot_spots The loot zone tiles near the character, found by the first tile that needs
+ * something fetched and kept for the others.
+ */
 static requirement_check_result generic_multi_activity_check_requirement( Character &you,
         const activity_id &act_id, activity_reason_info &act_info,
         const tripoint &src, const tripoint &src_loc, const std::unordered_set<tripoint> &src_set,
-        const bool check_only = false )
+        cata::optional<std::unordered_set<tripoint>> &loot_spots, const bool check_only = false )
 {
     map &here = get_map();
     const tripoint abspos = here.getabs( you.pos() );
@@ -2637,8 +2672,10 @@ static requirement_check_result generic_multi_activity_check_requirement( Charac
         requirement_id what_we_need;
         std::vector<tripoint> loot_zone_spots;
         std::vector<tripoint> combined_spots;
-        for( const tripoint &elem : mgr.get_point_set_loot( abspos, ACTIVITY_SEARCH_DISTANCE,
-                you.is_npc() ) ) {
+        if( !loot_spots ) {
+            loot_spots = mgr.get_point_set_loot( abspos, ACTIVITY_SEARCH_DISTANCE, you.is_npc() );
+        }
+        for( const tripoint &elem : *loot_spots ) {
             loot_zone_spots.push_back( elem );
             combined_spots.push_back( elem );
         }
@@ -2936,11 +2973,14 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
     if( !check_only ) {
         you.activity = player_activity();
     }
+    // Nothing the character carries changes while the tiles are looked at below.
+    you.invalidate_crafting_inventory();
     // now we setup the target spots based on which activity is occurring
     // the set of target work spots - potentially after we have fetched required tools.
     std::unordered_set<tripoint> src_set = generic_multi_activity_locations( you, activity_to_restore );
     // now we have our final set of points
     std::vector<tripoint> src_sorted = get_sorted_tiles_by_distance( abspos, src_set );
+    cata::optional<std::unordered_set<tripoint>> loot_spots;
     // now loop through the work-spot tiles and judge whether its worth traveling to it yet
     // or if we need to fetch something first.
 
@@ -2974,7 +3014,7 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
                                         src_loc, ACTIVITY_SEARCH_DISTANCE );
         // see activity_handlers.h enum for requirement_check_result
         const requirement_check_result req_res = generic_multi_activity_check_requirement( you,
-                activity_to_restore, act_info, src, src_loc, src_set, check_only );
+                activity_to_restore, act_info, src, src_loc, src_set, loot_spots, check_only );
         if( req_res == requirement_check_result::SKIP_LOCATION ) {
             continue;
         } else if( req_res == requirement_check_result::RETURN_EARLY ) {
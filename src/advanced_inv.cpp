@@ -629,6 +629,8 @@ void advanced_inventory::recalc_pane( side p )
     advanced_inventory_pane &pane = panes[p];
     pane.recalc = false;
     pane.items.clear();
+    // Building the list items and filtering them asks for the same names several times.
+    item::scoped_name_cache names;
     // Add items from the source location or in case of all 9 surrounding squares,
     // add items from several locations.
     if( pane.get_area() == AIM_ALL ) {
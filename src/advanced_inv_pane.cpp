@@ -2,6 +2,7 @@
 #include <iterator>
 #include <list>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "advanced_inv_area.h"
@@ -78,6 +79,7 @@ void advanced_inventory_pane::load_settings( int saved_area_idx,
     sortby = static_cast<advanced_inv_sortby>( save_state->sort_idx );
     index = save_state->selected_idx;
     filter = save_state->filter;
+    filter_fn = nullptr;
 }
 
 bool advanced_inventory_pane::is_filtered( const advanced_inv_listitem &it ) const
@@ -94,15 +96,10 @@ bool advanced_inventory_pane::is_filtered( const item &it ) const
         return false;
     }
 
-    const std::string str = it.tname();
-    if( filtercache.find( str ) == filtercache.end() ) {
-        const auto filter_fn = item_filter_from_string( filter );
-        filtercache[str] = filter_fn;
-
-        return !filter_fn( it );
+    if( !filter_fn ) {
+        filter_fn = item_filter_from_string( filter );
     }
-
-    return !filtercache[str]( it );
+    return !filter_fn( it );
 }
 
 /** converts a raw list of items to "stacks" - items that are not count_by_charges that otherwise stack go into one stack */
@@ -120,7 +117,7 @@ static std::vector<std::vector<item_location>> item_list_to_stack(
                 ++iter_inner;
             }
         }
-        ret.push_back( item_stack );
+        ret.push_back( std::move( item_stack ) );
     }
     return ret;
 }
@@ -138,12 +135,14 @@ std::vector<advanced_inv_listitem> avatar::get_AIM_inventory( const advanced_inv
         for( const std::vector<item_location> &it_stack : item_list_to_stack(
                  item_location( *this, &worn_item ),
                  worn_item.all_items_top( item_pocket::pocket_type::CONTAINER ) ) ) {
-            advanced_inv_listitem adv_it( it_stack, item_index++, square.id, false );
-            if( !pane.is_filtered( *adv_it.items.front() ) ) {
-                square.volume += adv_it.volume;
-                square.weight += adv_it.weight;
-                items.push_back( adv_it );
+            const size_t index = item_index++;
+            if( pane.is_filtered( *it_stack.front() ) ) {
+                continue;
             }
+            advanced_inv_listitem adv_it( it_stack, index, square.id, false );
+            square.volume += adv_it.volume;
+            square.weight += adv_it.weight;
+            items.push_back( std::move( adv_it ) );
         }
     }
     item &weapon = get_wielded_item();
@@ -151,12 +150,14 @@ std::vector<advanced_inv_listitem> avatar::get_AIM_inventory( const advanced_inv
         for( const std::vector<item_location> &it_stack : item_list_to_stack(
                  item_location( *this, &weapon ),
                  weapon.all_items_top( item_pocket::pocket_type::CONTAINER ) ) ) {
-            advanced_inv_listitem adv_it( it_stack, item_index++, square.id, false );
-            if( !pane.is_filtered( *adv_it.items.front() ) ) {
-                square.volume += adv_it.volume;
-                square.weight += adv_it.weight;
-                items.push_back( adv_it );
+            const size_t index = item_index++;
+            if( pane.is_filtered( *it_stack.front() ) ) {
+                continue;
             }
+            advanced_inv_listitem adv_it( it_stack, index, square.id, false );
+            square.volume += adv_it.volume;
+            square.weight += adv_it.weight;
+            items.push_back( std::move( adv_it ) );
         }
     }
     return items;
@@ -182,24 +183,22 @@ void advanced_inventory_pane::add_items_from_area( advanced_inv_area &square,
         square.weight = 0_gram;
 
         item &weapon = u.get_wielded_item();
-        if( !weapon.is_null() ) {
+        if( !weapon.is_null() && !is_filtered( weapon ) ) {
             advanced_inv_listitem it( item_location( u, &weapon ), 0, 1, square.id, false );
-            if( !is_filtered( *it.items.front() ) ) {
-                square.volume += it.volume;
-                square.weight += it.weight;
-                items.push_back( it );
-            }
+            square.volume += it.volume;
+            square.weight += it.weight;
+            items.push_back( std::move( it ) );
         }
 
         auto iter = u.worn.begin();
         for( size_t i = 0; i < u.worn.size(); ++i, ++iter ) {
-            advanced_inv_listitem it( item_location( u, &*iter ), i + 1, 1, square.id, false );
-            if( is_filtered( *it.items.front() ) ) {
+            if( is_filtered( *iter ) ) {
                 continue;
             }
+            advanced_inv_listitem it( item_location( u, &*iter ), i + 1, 1, square.id, false );
             square.volume += it.volume;
             square.weight += it.weight;
-            items.push_back( it );
+            items.push_back( std::move( it ) );
         }
     } else if( square.id == AIM_CONTAINER ) {
         square.volume = 0_ml;
@@ -246,16 +245,17 @@ void advanced_inventory_pane::add_items_from_area( advanced_inv_area &square,
                                                                 is_in_vehicle );
                                 square.volume += aim_item.volume;
                                 square.weight += aim_item.weight;
-                                items.push_back( aim_item );
+                                items.push_back( std::move( aim_item ) );
                             }
                         }
                     }
                 }
             }
-            advanced_inv_listitem it( locs, x, square.id, is_in_vehicle );
-            if( is_filtered( *it.items.front() ) ) {
+            // Filtered before the list item is built, building it names the item twice.
+            if( is_filtered( *stacks[x].front() ) ) {
                 continue;
             }
+            advanced_inv_listitem it( locs, x, square.id, is_in_vehicle );
             if( is_in_vehicle ) {
                 square.volume_veh += it.volume;
                 square.weight_veh += it.weight;
@@ -263,7 +263,7 @@ void advanced_inventory_pane::add_items_from_area( advanced_inv_area &square,
                 square.volume += it.volume;
                 square.weight += it.weight;
             }
-            items.push_back( it );
+            items.push_back( std::move( it ) );
         }
     }
 }
@@ -408,6 +408,6 @@ void advanced_inventory_pane::set_filter( const std::string &new_filter )
         return;
     }
     filter = new_filter;
-    filtercache.clear();
+    filter_fn = nullptr;
     recalc = true;
 }
@@ -5,7 +5,6 @@
 #include <array>
 #include <functional>
 #include <iosfwd>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -118,6 +117,7 @@ class advanced_inventory_pane
         /** Only add offset to index, but wrap around! */
         void mod_index( int offset );
 
-        mutable std::map<std::string, std::function<bool( const item & )>> filtercache;
+        /** The parsed @ref filter, built on first use. */
+        mutable std::function<bool( const item & )> filter_fn;
 };
 #endif // CATA_SRC_ADVANCED_INV_PANE_H
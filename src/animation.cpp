@@ -2,6 +2,7 @@
 
 #include "avatar.h"
 #include "cached_options.h"
+#include "calendar.h"
 #include "character.h"
 #include "creature.h"
 #include "creature_tracker.h"
@@ -34,6 +35,7 @@
 #endif
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iosfwd>
 #include <iterator>
@@ -47,6 +49,22 @@
 namespace
 {
 
+// How long the animations of the current turn took so far.
+struct animation_budget {
+    time_point turn = calendar::before_time_starts;
+    std::chrono::steady_clock::duration used = std::chrono::steady_clock::duration::zero();
+};
+
+animation_budget &current_animation_budget()
+{
+    static animation_budget budget;
+    if( budget.turn != calendar::turn ) {
+        budget.turn = calendar::turn;
+        budget.used = std::chrono::steady_clock::duration::zero();
+    }
+    return budget;
+}
+
 class basic_animation
 {
     public:
@@ -60,16 +78,36 @@ class basic_animation
             .wait_message( "%s", _( "Hang on a bit…" ) )
             .on_top( true );
 
-            g->invalidate_main_ui_adaptor();
+            // The animations are drawn by draw callbacks over the map, so the rest of the
+            // screen stays as it is.
+            g->invalidate_main_ui_adaptor( g->w_terrain );
             ui_manager::redraw_invalidated();
             refresh_display();
         }
 
+        // Draws a frame and waits for the animation delay, unless the animations of this
+        // turn already took ANIMATION_BUDGET. Then the frame is dropped, so long bursts and
+        // turret volleys don't hold up the game.
         void progress() const {
+            animation_budget &budget = current_animation_budget();
+            const std::chrono::nanoseconds limit =
+                std::chrono::milliseconds( get_option<int>( "ANIMATION_BUDGET" ) );
+            if( limit.count() > 0 && budget.used >= limit ) {
+                return;
+            }
+            using clock = std::chrono::steady_clock;
+            const clock::time_point start = clock::now();
             draw();
 
             // NOLINTNEXTLINE(cata-no-long): timespec uses long int
             long int remain = delay;
+            if( limit.count() > 0 ) {
+                using std::chrono::nanoseconds;
+                const nanoseconds left = std::chrono::duration_cast<nanoseconds>(
+                                             limit - budget.used - ( clock::now() - start ) );
+                // NOLINTNEXTLINE(cata-no-long): timespec uses long int
+                remain = std::min<long int>( remain, left.count() );
+            }
             while( remain > 0 ) {
                 // NOLINTNEXTLINE(cata-no-long): timespec uses long int
                 long int do_sleep = std::min( remain, 100'000'000L );
@@ -78,6 +116,7 @@ class basic_animation
                 inp_mngr.pump_events();
                 remain -= do_sleep;
             }
+            budget.used += clock::now() - start;
         }
 
     private:
@@ -25,6 +25,7 @@
 #include "character_martial_arts.h"
 #include "clzones.h"
 #include "color.h"
+#include "creature_tracker.h"
 #include "cursesdef.h"
 #include "debug.h"
 #include "effect.h"
@@ -42,13 +43,16 @@
 #include "itype.h"
 #include "iuse.h"
 #include "kill_tracker.h"
+#include "line.h"
 #include "make_static.h"
 #include "magic_enchantment.h"
 #include "map.h"
 #include "map_memory.h"
 #include "martialarts.h"
+#include "memory_stats.h"
 #include "messages.h"
 #include "mission.h"
+#include "monster.h"
 #include "morale.h"
 #include "morale_types.h"
 #include "move_mode.h"
@@ -259,11 +263,21 @@ bool avatar::should_show_map_memory()
     return show_map_memory;
 }
 
+memory_usage avatar::map_memory_use() const
+{
+    return player_map_memory->memory_use();
+}
+
 bool avatar::save_map_memory()
 {
     return player_map_memory->save( get_map().getabs( pos() ) );
 }
 
+bool avatar::flush_map_memory()
+{
+    return player_map_memory->flush();
+}
+
 void avatar::load_map_memory()
 {
     player_map_memory->load( get_map().getabs( pos() ) );
@@ -274,7 +288,7 @@ void avatar::prepare_map_memory_region( const tripoint &p1, const tripoint &p2 )
     player_map_memory->prepare_region( p1, p2 );
 }
 
-const memorized_terrain_tile &avatar::get_memorized_tile( const tripoint &pos ) const
+memorized_terrain_tile avatar::get_memorized_tile( const tripoint &pos ) const
 {
     return player_map_memory->get_tile( pos );
 }
@@ -837,6 +851,41 @@ void avatar::vomit()
     Character::vomit();
 }
 
+std::vector<Creature *> avatar::get_visible_creatures( const int range ) const
+{
+    if( range > MAPSIZE_X ) {
+        return Character::get_visible_creatures( range );
+    }
+    const visibility_key key{ calendar::turn, moves, get_location(),
+                              get_creature_tracker().change_count() };
+    if( !visible_creatures_key || !( *visible_creatures_key == key ) ) {
+        visible_creatures.clear();
+        for( Creature *critter : Character::get_visible_creatures( MAPSIZE_X ) ) {
+            visible_creatures.emplace_back( g->shared_from( *critter ) );
+        }
+        visible_creatures_key = key;
+    }
+    std::vector<Creature *> result;
+    for( const weak_ptr_fast<Creature> &weak : visible_creatures ) {
+        // Gone from the game since the scan.
+        const shared_ptr_fast<Creature> shared = weak.lock();
+        if( !shared ) {
+            continue;
+        }
+        Creature *const critter = shared.get();
+        // Killed since the scan, but not cleaned up yet.
+        const monster *mon = critter->as_monster();
+        const npc *guy = critter->as_npc();
+        if( ( mon != nullptr && mon->is_dead() ) || ( guy != nullptr && guy->is_dead() ) ) {
+            continue;
+        }
+        if( rl_dist( pos(), critter->pos() ) <= range ) {
+            result.push_back( critter );
+        }
+    }
+    return result;
+}
+
 nc_color avatar::basic_symbol_color() const
 {
     if( has_effect( effect_onfire ) ) {
@@ -20,6 +20,7 @@
 #include "json.h"
 #include "magic_teleporter_list.h"
 #include "memory_fast.h"
+#include "optional.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -43,6 +44,7 @@ class window;
 enum class character_type : int;
 class map_memory;
 struct memorized_terrain_tile;
+struct memory_usage;
 
 namespace debug_menu
 {
@@ -84,6 +86,10 @@ class avatar : public Character
         void serialize( JsonOut &json ) const override;
         void deserialize( const JsonObject &data ) override;
         bool save_map_memory();
+        /** See @ref map_memory::flush. */
+        bool flush_map_memory();
+        /** See @ref map_memory::memory_use. */
+        memory_usage map_memory_use() const;
         void load_map_memory();
 
         // newcharacter.cpp
@@ -131,7 +137,7 @@ class avatar : public Character
         void memorize_tile( const tripoint &pos, const std::string &ter, int subtile,
                             int rotation );
         /** Returns last stored map tile in given location in tiles mode */
-        const memorized_terrain_tile &get_memorized_tile( const tripoint &p ) const;
+        memorized_terrain_tile get_memorized_tile( const tripoint &p ) const;
         /** Memorizes a given tile in curses mode; finalize_terrain_memory_curses needs to be called after it */
         void memorize_symbol( const tripoint &pos, int symbol );
         /** Returns last stored map tile in given location in curses mode */
@@ -279,6 +285,14 @@ class avatar : public Character
             return mon_visible;
         }
 
+        /**
+         * Everything the avatar sees within MAPSIZE_X is looked up once and reused until the
+         * avatar moves or spends moves, the turn changes or the tracked creatures change
+         * (see @ref creature_tracker::change_count), so the sidebar, safe mode and everything
+         * else asking during the same move share one scan.
+         */
+        std::vector<Creature *> get_visible_creatures( int range ) const override;
+
         struct daily_calories {
             int spent = 0;
             int gained = 0;
@@ -393,6 +407,21 @@ class avatar : public Character
 
         monster_visible_info mon_visible;
 
+        struct visibility_key {
+            time_point turn;
+            int moves = 0;
+            tripoint_abs_ms location;
+            int creature_changes = 0;
+
+            bool operator==( const visibility_key &rhs ) const {
+                return turn == rhs.turn && moves == rhs.moves && location == rhs.location &&
+                       creature_changes == rhs.creature_changes;
+            }
+        };
+        // What get_visible_creatures found last time, and for which state of the world.
+        mutable std::vector<weak_ptr_fast<Creature>> visible_creatures; // NOLINT(cata-serialize)
+        mutable cata::optional<visibility_key> visible_creatures_key; // NOLINT(cata-serialize)
+
         /**
          * The NPC that would control the avatar's character in the avatar's absence.
          * The Character data in this object is not relevant/used.
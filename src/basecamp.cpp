@@ -478,7 +478,7 @@ void basecamp::reset_camp_workers()
 {
     camp_workers.clear();
     for( const auto &elem : overmap_buffer.get_companion_mission_npcs() ) {
-        npc_companion_mission c_mission = elem->get_companion_mission();
+        const npc_companion_mission &c_mission = elem->get_companion_mission();
         if( c_mission.position == omt_pos && c_mission.role_id == "FACTION_CAMP" ) {
             camp_workers.push_back( elem );
         }
@@ -548,7 +548,7 @@ comp_list basecamp::get_mission_workers( const std::string &mission_id, bool con
 {
     comp_list available;
     for( const auto &elem : camp_workers ) {
-        npc_companion_mission c_mission = elem->get_companion_mission();
+        const npc_companion_mission &c_mission = elem->get_companion_mission();
         if( ( c_mission.mission_id == mission_id ) ||
             ( contains && c_mission.mission_id.find( mission_id ) != std::string::npos ) ) {
             available.push_back( elem );
@@ -664,12 +664,18 @@ void basecamp::form_crafting_inventory( map &target_map )
 
 void basecamp::form_crafting_inventory()
 {
-    if( by_radio ) {
+    map &here = get_map();
+    const tripoint_abs_ms camp_corner = project_to<coords::ms>( omt_pos );
+    // A camp inside the reality bubble is already loaded and up to date, only a camp further
+    // away needs its submaps loaded and caught up with the time that passed.
+    const bool camp_loaded = here.inbounds( camp_corner ) &&
+                             here.inbounds( camp_corner + point( 2 * SEEX - 1, 2 * SEEY - 1 ) );
+    if( by_radio && !camp_loaded ) {
         tinymap target_map;
         target_map.load( project_to<coords::sm>( omt_pos ), false );
         form_crafting_inventory( target_map );
     } else {
-        form_crafting_inventory( get_map() );
+        form_crafting_inventory( here );
     }
 }
 
@@ -1524,6 +1524,8 @@ void Character::passive_power_gen( int b )
     const std::vector<material_id> &fuel_available = get_fuel_available( bio.id );
     map &here = get_map();
     weather_manager &weather = get_weather();
+    // What all the fuels of the bionic make, added to the power level at once.
+    units::energy generated = 0_kJ;
 
     for( const material_id &fuel : fuel_available ) {
         const int fuel_energy = fuel->get_fuel_data().energy;
@@ -1533,7 +1535,8 @@ void Character::passive_power_gen( int b )
 
         if( fuel == fuel_type_sun_light ) {
             const double modifier = g->natural_light_level( pos().z ) / default_daylight_level();
-            mod_power_level( units::from_kilojoule( fuel_energy ) * modifier * effective_passive_efficiency );
+            generated += units::from_kilojoule( fuel_energy ) * modifier *
+                         effective_passive_efficiency;
         } else if( fuel == fuel_type_wind ) {
             int vehwindspeed = 0;
             const optional_vpart_position vp = here.veh_at( pos() );
@@ -1544,15 +1547,19 @@ void Character::passive_power_gen( int b )
             const double windpower = get_local_windpower( weather.windspeed + vehwindspeed,
                                      overmap_buffer.ter( global_omt_location() ), pos(), weather.winddirection,
                                      g->is_sheltered( pos() ) );
-            mod_power_level( units::from_kilojoule( fuel_energy ) * windpower * effective_passive_efficiency );
+            generated += units::from_kilojoule( fuel_energy ) * windpower *
+                         effective_passive_efficiency;
         } else {
-            mod_power_level( units::from_kilojoule( fuel_energy ) * effective_passive_efficiency );
+            generated += units::from_kilojoule( fuel_energy ) * effective_passive_efficiency;
         }
 
         heat_emission( b, fuel_energy );
         here.emit_field( pos(), bio.info().power_gen_emission );
 
     }
+    if( generated != 0_kJ ) {
+        mod_power_level( generated );
+    }
 }
 
 material_id Character::find_remote_fuel( bool look_only )
@@ -1725,6 +1732,18 @@ static bool attempt_recharge( Character &p, bionic &bio, units::energy &amount )
     return recharged;
 }
 
+void Character::process_bionics()
+{
+    for( size_t i = 0; i < my_bionics->size(); i++ ) {
+        const bionic_data &info = ( *my_bionics )[i].info();
+        // Neither powered nor fueled: it could neither be toggled on nor make power this turn.
+        if( !( *my_bionics )[i].powered && info.fuel_opts.empty() && !info.is_remote_fueled ) {
+            continue;
+        }
+        process_bionic( i );
+    }
+}
+
 void Character::process_bionic( const int b )
 {
     bionic &bio = ( *my_bionics )[b];
@@ -3010,7 +3029,7 @@ std::vector<const item *> bionic::get_available_pseudo_items( bool include_weapo
 
 bool bionic::is_this_fuel_powered( const material_id &this_fuel ) const
 {
-    const std::vector<material_id> fuel_op = info().fuel_opts;
+    const std::vector<material_id> &fuel_op = info().fuel_opts;
     return std::find( fuel_op.begin(), fuel_op.end(), this_fuel ) != fuel_op.end();
 }
 
@@ -2,10 +2,12 @@
 
 bool fov_3d;
 int fov_3d_z_range;
+bool idle_monster_lod;
 bool keycode_mode;
 bool log_from_top;
 int message_ttl;
 int message_cooldown;
+bool parallel_map_cache;
 bool test_mode;
 bool tile_iso;
 bool use_tiles;
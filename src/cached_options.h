@@ -8,6 +8,8 @@
 
 extern bool fov_3d;
 extern int fov_3d_z_range;
+extern bool parallel_map_cache;
+extern bool idle_monster_lod;
 extern bool keycode_mode;
 extern bool log_from_top;
 extern int message_ttl;
@@ -32,6 +32,7 @@
 #include "filesystem.h"
 #include "game.h"
 #include "game_constants.h"
+#include "hash_utils.h"
 #include "int_id.h"
 #include "item.h"
 #include "item_factory.h"
@@ -41,6 +42,7 @@
 #include "map_extras.h"
 #include "map_memory.h"
 #include "mapdata.h"
+#include "memory_stats.h"
 #include "mod_tileset.h"
 #include "monster.h"
 #include "monstergenerator.h"
@@ -193,6 +195,7 @@ cata_tiles::cata_tiles( const SDL_Renderer_Ptr &renderer, const GeometryRenderer
     renderer( renderer ),
     geometry( geometry ),
     cache( cache ),
+    sprites( renderer ),
     minimap( renderer, geometry )
 {
     cata_assert( renderer );
@@ -224,6 +227,8 @@ cata_tiles::~cata_tiles() = default;
 void cata_tiles::on_options_changed()
 {
     memory_map_mode = get_option <std::string>( "MEMORY_MAP_MODE" );
+    // Options like NV_GREEN_TOGGLE change how the tiles look.
+    forget_retained_frame();
 
     pixel_minimap_settings settings;
 
@@ -241,16 +246,29 @@ void cata_tiles::on_options_changed()
 void tileset::clear()
 {
     tile_values.clear();
-    shadow_tile_values.clear();
-    night_tile_values.clear();
-    overexposed_tile_values.clear();
-    memory_tile_values.clear();
+    shadow_tile_values = filtered_tiles();
+    night_tile_values = filtered_tiles();
+    overexposed_tile_values = filtered_tiles();
+    memory_tile_values = filtered_tiles();
+    pages.clear();
     duplicate_ids.clear();
     tile_ids.clear();
     for( int i = 0; i < season_type::NUM_SEASONS; ++i ) {
         tile_ids_by_season[i].clear();
     }
     layer_data.clear();
+    sprite_overhang.reset();
+}
+
+memory_usage tileset::memory_use() const
+{
+    // Every texture made from a page is as large as the page.
+    memory_usage usage;
+    for( const sheet_page &page : pages ) {
+        usage.count += page.textures_built;
+        usage.bytes += ( page.textures_built + ( page.surface ? 1 : 0 ) ) * page.bytes;
+    }
+    return usage;
 }
 
 const tile_type *tileset::find_tile_type( const std::string &id ) const
@@ -259,6 +277,49 @@ const tile_type *tileset::find_tile_type( const std::string &id ) const
     return iter != tile_ids.end() ? &iter->second : nullptr;
 }
 
+int tileset::get_sprite_overhang() const
+{
+    if( sprite_overhang ) {
+        return *sprite_overhang;
+    }
+    int overhang = 0;
+    const auto add_sprites = [&]( const tile_type & tt,
+    const weighted_int_list<std::vector<int>> &sprites ) {
+        for( const weighted_object<int, std::vector<int>> &variant : sprites ) {
+            for( const int index : variant.obj ) {
+                const texture *tex = get_tile( index );
+                if( !tex ) {
+                    continue;
+                }
+                int w = 0;
+                int h = 0;
+                std::tie( w, h ) = tex->dimension();
+                // A sprite turned by 90 degrees keeps its center, with width and height
+                // swapped.
+                const int cx2 = 2 * tt.offset.x + w;
+                const int cy2 = 2 * tt.offset.y + h;
+                const int left = std::min( tt.offset.x, ( cx2 - h ) / 2 );
+                const int right = std::max( tt.offset.x + w, ( cx2 + h + 1 ) / 2 );
+                const int top = std::min( tt.offset.y, ( cy2 - w ) / 2 );
+                const int bottom = std::max( tt.offset.y + h, ( cy2 + w + 1 ) / 2 );
+                overhang = std::max( { overhang, -left, right - tile_width, -top,
+                                       bottom - tile_height
+                                     } );
+            }
+        }
+    };
+    for( const std::pair<const std::string, tile_type> &entry : tile_ids ) {
+        if( entry.second.height_3d != 0 ) {
+            overhang = -1;
+            break;
+        }
+        add_sprites( entry.second, entry.second.fg );
+        add_sprites( entry.second, entry.second.bg );
+    }
+    sprite_overhang = overhang;
+    return overhang;
+}
+
 cata::optional<tile_lookup_res>
 tileset::find_tile_type_by_season( const std::string &id, season_type season ) const
 {
@@ -318,6 +379,11 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force, const bool pump_events )
 {
+    // This runs after every data load, which may change what ids look like.
+    for( auto &by_id : looks_like_cache ) {
+        by_id.clear();
+    }
+    forget_retained_frame();
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -336,6 +402,12 @@ void cata_tiles::reinit()
 {
     set_draw_scale( 16 );
     RenderClear( renderer );
+    forget_retained_frame();
+}
+
+void cata_tiles::forget_retained_frame()
+{
+    frame = retained_frame();
 }
 
 static void get_tile_information( const std::string &config_path, std::string &json_path,
@@ -421,10 +493,13 @@ static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
            smaller.y + smaller.h <= larger.y + larger.h;
 }
 
-void tileset_cache::loader::copy_surface_to_texture( const SDL_Surface_Ptr &surf,
-        const point &offset, std::vector<texture> &target )
+void tileset::copy_surface_to_texture( const SDL_Renderer_Ptr &renderer,
+                                       const SDL_Surface_Ptr &surf, const sheet_page &page,
+                                       std::vector<texture> &target )
 {
     cata_assert( surf );
+    const int sprite_width = page.sprite_width;
+    const int sprite_height = page.sprite_height;
     const rect_range<SDL_Rect> input_range( sprite_width, sprite_height,
                                             point( surf->w / sprite_width,
                                                     surf->h / sprite_height ) );
@@ -433,48 +508,94 @@ void tileset_cache::loader::copy_surface_to_texture( const SDL_Surface_Ptr &surf
     cata_assert( texture_ptr );
 
     for( const SDL_Rect rect : input_range ) {
-        cata_assert( offset.x % sprite_width == 0 );
-        cata_assert( offset.y % sprite_height == 0 );
-        const point pos( offset + point( rect.x, rect.y ) );
+        cata_assert( page.offset.x % sprite_width == 0 );
+        cata_assert( page.offset.y % sprite_height == 0 );
+        const point pos( page.offset + point( rect.x, rect.y ) );
         cata_assert( pos.x % sprite_width == 0 );
         cata_assert( pos.y % sprite_height == 0 );
-        const size_t index = this->offset + ( pos.x / sprite_width ) + ( pos.y / sprite_height ) *
-                             ( tile_atlas_width / sprite_width );
+        const size_t index = page.first_index + ( pos.x / sprite_width ) +
+                             ( pos.y / sprite_height ) * ( page.sheet_width / sprite_width );
         cata_assert( index < target.size() );
         cata_assert( target[index].dimension() == std::make_pair( 0, 0 ) );
         target[index] = texture( texture_ptr, rect );
     }
 }
 
-void tileset_cache::loader::create_textures_from_tile_atlas( const SDL_Surface_Ptr &tile_atlas,
-        const point &offset )
+bool tileset::sheet_page::contains( const size_t index ) const
 {
-    cata_assert( tile_atlas );
+    if( index < static_cast<size_t>( first_index ) ) {
+        return false;
+    }
+    const int sprites_per_row = sheet_width / sprite_width;
+    const int local = static_cast<int>( index ) - first_index;
+    const point pos( local % sprites_per_row * sprite_width,
+                     local / sprites_per_row * sprite_height );
+    return pos.x >= offset.x && pos.x < offset.x + size.x &&
+           pos.y >= offset.y && pos.y < offset.y + size.y;
+}
+
+const texture *tileset::get_filtered_tile( const size_t index, filtered_tiles &tiles ) const
+{
+    if( index >= tiles.values.size() ) {
+        return nullptr;
+    }
+    const texture &tile = tiles.values[index];
+    if( tile.dimension() == std::make_pair( 0, 0 ) ) {
+        build_filtered_page( index, tiles );
+    }
+    return &tile;
+}
 
-    /** perform color filter conversion here */
-    using tiles_pixel_color_entry = std::tuple<std::vector<texture>*, std::string>;
-    std::array<tiles_pixel_color_entry, 5> tile_values_data = {{
-            { std::make_tuple( &ts.tile_values, "color_pixel_none" ) },
-            { std::make_tuple( &ts.shadow_tile_values, "color_pixel_grayscale" ) },
-            { std::make_tuple( &ts.night_tile_values, "color_pixel_nightvision" ) },
-            { std::make_tuple( &ts.overexposed_tile_values, "color_pixel_overexposed" ) },
-            { std::make_tuple( &ts.memory_tile_values, tilecontext->memory_map_mode ) }
+void tileset::build_filtered_page( const size_t index, filtered_tiles &tiles ) const
+{
+    for( size_t i = 0; i < pages.size(); ++i ) {
+        sheet_page &page = pages[i];
+        if( !page.contains( index ) ) {
+            continue;
         }
-    };
-    for( tiles_pixel_color_entry &entry : tile_values_data ) {
-        std::vector<texture> *tile_values = std::get<0>( entry );
-        color_pixel_function_pointer color_pixel_function = get_color_pixel_function( std::get<1>
-                ( entry ) );
-        if( !color_pixel_function ) {
-            // TODO: Move it inside apply_color_filter.
-            copy_surface_to_texture( tile_atlas, offset, *tile_values );
+        tiles.pages_built.resize( pages.size() );
+        if( tiles.pages_built[i] ) {
+            // A sprite the page has no picture for.
+            return;
+        }
+        tiles.pages_built[i] = true;
+        cata_assert( renderer );
+        cata_assert( page.surface );
+        if( !tiles.filter ) {
+            copy_surface_to_texture( *renderer, page.surface, page, tiles.values );
         } else {
-            copy_surface_to_texture( apply_color_filter( tile_atlas, color_pixel_function ), offset,
-                                     *tile_values );
+            const SDL_Surface_Ptr filtered = apply_color_filter( page.surface, tiles.filter );
+            copy_surface_to_texture( *renderer, filtered, page, tiles.values );
+        }
+        if( ++page.textures_built == 1 + filtered_variants ) {
+            page.surface.reset();
         }
+        return;
     }
 }
 
+void tileset_cache::loader::create_textures_from_tile_atlas( SDL_Surface_Ptr tile_atlas,
+        const point &offset )
+{
+    cata_assert( tile_atlas );
+
+    tileset::sheet_page page;
+    page.offset = offset;
+    page.first_index = this->offset;
+    page.sheet_width = tile_atlas_width;
+    page.sprite_width = sprite_width;
+    page.sprite_height = sprite_height;
+    page.size = point( tile_atlas->w, tile_atlas->h );
+    page.bytes = static_cast<size_t>( tile_atlas->pitch ) * tile_atlas->h;
+    tileset::copy_surface_to_texture( renderer, tile_atlas, page, ts.tile_values );
+    page.textures_built = 1;
+
+    // The color filtered variants of the page are built from it when first drawn, see
+    // tileset::build_filtered_page.
+    page.surface = std::move( tile_atlas );
+    ts.pages.emplace_back( std::move( page ) );
+}
+
 template<typename T>
 static void extend_vector_by( std::vector<T> &vec, const size_t additional_size )
 {
@@ -483,7 +604,7 @@ static void extend_vector_by( std::vector<T> &vec, const size_t additional_size
 
 void tileset_cache::loader::load_tileset( const std::string &img_path, const bool pump_events )
 {
-    const SDL_Surface_Ptr tile_atlas = load_image( img_path.c_str() );
+    SDL_Surface_Ptr tile_atlas = load_image( img_path.c_str() );
     cata_assert( tile_atlas );
     tile_atlas_width = tile_atlas->w;
 
@@ -549,10 +670,17 @@ void tileset_cache::loader::load_tileset( const std::string &img_path, const boo
     const int expected_tilecount = ( tile_atlas->w / sprite_width ) *
                                    ( tile_atlas->h / sprite_height );
     extend_vector_by( ts.tile_values, expected_tilecount );
-    extend_vector_by( ts.shadow_tile_values, expected_tilecount );
-    extend_vector_by( ts.night_tile_values, expected_tilecount );
-    extend_vector_by( ts.overexposed_tile_values, expected_tilecount );
-    extend_vector_by( ts.memory_tile_values, expected_tilecount );
+    ts.renderer = &renderer;
+    using filter_entry = std::pair<tileset::filtered_tiles *, std::string>;
+    for( const filter_entry &entry : {
+             filter_entry( &ts.shadow_tile_values, "color_pixel_grayscale" ),
+             filter_entry( &ts.night_tile_values, "color_pixel_nightvision" ),
+             filter_entry( &ts.overexposed_tile_values, "color_pixel_overexposed" ),
+             filter_entry( &ts.memory_tile_values, tilecontext->memory_map_mode )
+         } ) {
+        entry.first->filter = get_color_pixel_function( entry.second );
+        extend_vector_by( entry.first->values, expected_tilecount );
+    }
 
     for( const SDL_Rect sub_rect : output_range ) {
         cata_assert( sub_rect.x % sprite_width == 0 );
@@ -574,10 +702,14 @@ void tileset_cache::loader::load_tileset( const std::string &img_path, const boo
             throwErrorIf( SDL_BlitSurface( tile_atlas.get(), &inp, smaller_surf.get(),
                                            nullptr ) != 0, "SDL_BlitSurface failed" );
         }
-        const SDL_Surface_Ptr &surf_to_use = smaller_surf ? smaller_surf : tile_atlas;
+        // The whole atlas is only contained in the single rectangle of an unsplit atlas,
+        // so this is the last time it is needed here.
+        SDL_Surface_Ptr surf_to_use = smaller_surf ? std::move( smaller_surf ) :
+                                      std::move( tile_atlas );
         cata_assert( surf_to_use );
 
-        create_textures_from_tile_atlas( surf_to_use, point( sub_rect.x, sub_rect.y ) );
+        create_textures_from_tile_atlas( std::move( surf_to_use ),
+                                         point( sub_rect.x, sub_rect.y ) );
 
         if( pump_events ) {
             inp_mngr.pump_events();
@@ -1163,9 +1295,17 @@ struct tile_render_info {
     int height_3d = 0;
     lit_level ll;
     bool invisible[5];
+    // vision effect drawn in the tile before anything else
+    visibility_type shade;
+    // whether the drawing layers are drawn, or just the vision effect
+    bool layers;
+    // the screen tile, row by row
+    int slot;
     tile_render_info( const tripoint &pos, const int height_3d, const lit_level ll,
-                      const bool( &invisible )[5] )
-        : pos( pos ), height_3d( height_3d ), ll( ll ) {
+                      const bool( &invisible )[5], const visibility_type shade, const bool layers,
+                      const int slot )
+        : pos( pos ), height_3d( height_3d ), ll( ll ), shade( shade ), layers( layers ),
+          slot( slot ) {
         std::copy_n( invisible, 5, this->invisible );
     }
 };
@@ -1194,6 +1334,142 @@ static std::map<tripoint, int> display_npc_attack_potential()
     return effectiveness_map;
 }
 
+size_t cata_tiles::tile_fingerprint( const tripoint &p, const lit_level ll,
+                                     const bool ( &invisible )[5], const visibility_type shade,
+                                     const bool layers, const bool revival_indicators ) const
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, static_cast<int>( shade ) );
+    cata::hash_combine( seed, layers );
+    if( !layers ) {
+        return seed;
+    }
+    cata::hash_combine( seed, static_cast<int>( ll ) );
+    for( const bool invis : invisible ) {
+        cata::hash_combine( seed, invis );
+    }
+    map &here = get_map();
+    avatar &you = get_avatar();
+    creature_tracker &creatures = get_creature_tracker();
+    const Creature *critter = creatures.creature_at( p, true );
+    const auto seen_otherwise = [&]( const Creature & c ) {
+        return you.sees_with_infrared( c ) || you.sees_with_specials( c );
+    };
+    if( invisible[0] ) {
+        if( has_memory_at( p ) ) {
+            const memorized_terrain_tile t = you.get_memorized_tile( here.getabs( p ) );
+            cata::hash_combine( seed, t.tile );
+            cata::hash_combine( seed, t.subtile );
+            cata::hash_combine( seed, t.rotation );
+        }
+        if( critter && seen_otherwise( *critter ) ) {
+            cata::hash_combine( seed, critter );
+        }
+        return seed;
+    }
+
+    const maptile tile = here.maptile_at( p );
+    cata::hash_combine( seed, tile.get_ter() );
+    cata::hash_combine( seed, tile.get_furn() );
+    cata::hash_combine( seed, tile.get_trap() );
+    cata::hash_combine( seed, tile.get_trap_t().can_see( p, you ) );
+    cata::hash_combine( seed, tile.has_graffiti() );
+    for( const std::pair<const field_type_id, field_entry> &fd : tile.get_field() ) {
+        cata::hash_combine( seed, fd.first );
+        cata::hash_combine( seed, fd.second.get_field_intensity() );
+    }
+
+    if( tile.get_item_count() > 0 ) {
+        if( here.sees_some_items( p, you ) ) {
+            const item &top = tile.get_uppermost_item();
+            cata::hash_combine( seed, tile.get_item_count() );
+            cata::hash_combine( seed, top.typeId() );
+            if( top.has_itype_variant() ) {
+                cata::hash_combine( seed, top.itype_variant().id );
+            }
+            cata::hash_combine( seed, top.get_mtype() );
+        }
+        // Items are drawn by the layers of the furniture or terrain they lie on.
+        if( tileset_ptr->layer_data.count( tile.get_furn_t().id.str() ) ||
+            tileset_ptr->layer_data.count( tile.get_ter_t().id.str() ) ) {
+            for( const item &i : tile.get_items() ) {
+                cata::hash_combine( seed, i.typeId() );
+                cata::hash_combine( seed, i.seed );
+            }
+        }
+        if( revival_indicators && here.could_see_items( p, you ) ) {
+            cata::hash_combine( seed, std::any_of( tile.get_items().begin(), tile.get_items().end(),
+            []( const item & i ) {
+                return i.can_revive();
+            } ) );
+        }
+    }
+
+    const auto hash_vpart = [&]( const tripoint & q ) {
+        const optional_vpart_position vp = here.veh_at( q );
+        if( !vp ) {
+            return;
+        }
+        const vehicle &veh = vp->vehicle();
+        char part_mod = 0;
+        cata::hash_combine( seed, &veh );
+        cata::hash_combine( seed, vp->part_index() );
+        cata::hash_combine( seed, veh.part_id_string( vp->part_index(), part_mod ) );
+        cata::hash_combine( seed, part_mod );
+        cata::hash_combine( seed, vp->mount() );
+        cata::hash_combine( seed, std::round( to_degrees( veh.face.dir() ) ) );
+        // Whether the part is memorized.
+        cata::hash_combine( seed, veh.forward_velocity() != 0 || veh.player_in_control( you ) );
+        const cata::optional<vpart_reference> cargo = vp.part_with_feature( "CARGO", true );
+        cata::hash_combine( seed, cargo && !veh.get_items( cargo->part_index() ).empty() );
+    };
+    hash_vpart( p );
+
+    const auto hash_character = [&]( const Character & ch ) {
+        cata::hash_combine( seed, ch.male );
+        cata::hash_combine( seed, ch.is_npc() );
+        cata::hash_combine( seed, static_cast<int>( ch.facing ) );
+        for( const std::pair<std::string, std::string> &overlay : ch.get_overlay_ids() ) {
+            cata::hash_combine( seed, overlay.first );
+            cata::hash_combine( seed, overlay.second );
+        }
+    };
+    if( critter ) {
+        const bool sees = you.sees( *critter );
+        cata::hash_combine( seed, critter );
+        cata::hash_combine( seed, sees );
+        if( !sees ) {
+            cata::hash_combine( seed, seen_otherwise( *critter ) );
+        } else if( const monster *m = dynamic_cast<const monster *>( critter ) ) {
+            cata::hash_combine( seed, m->type );
+            cata::hash_combine( seed, static_cast<int>( m->facing ) );
+            cata::hash_combine( seed, m->sees( you ) );
+            cata::hash_combine( seed, static_cast<int>( m->attitude_to( you ) ) );
+            if( m->has_effect( effect_ridden ) && m->mounted_player ) {
+                hash_character( *m->mounted_player );
+            }
+        } else if( const Character *pl = dynamic_cast<const Character *>( critter ) ) {
+            hash_character( *pl );
+            if( !pl->is_avatar() ) {
+                cata::hash_combine( seed, pl->sees( you ) );
+                cata::hash_combine( seed, static_cast<int>( pl->attitude_to( you ) ) );
+            }
+        }
+    }
+
+    if( !here.dont_draw_lower_floor( p ) ) {
+        const tripoint below( p.xy(), p.z - 1 );
+        cata::hash_combine( seed, here.ter( below ) );
+        cata::hash_combine( seed, here.furn( below ) );
+        hash_vpart( below );
+        if( const Creature *critter_below = creatures.creature_at( below, true ) ) {
+            cata::hash_combine( seed, you.sees( *critter_below ) ||
+                                seen_otherwise( *critter_below ) );
+        }
+    }
+    return seed;
+}
+
 void cata_tiles::draw( const point &dest, const tripoint &center, int width, int height,
                        std::multimap<point, formatted_text> &overlay_strings,
                        color_block_overlay_container &color_blocks )
@@ -1318,10 +1594,12 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     }
 
     creature_tracker &creatures = get_creature_tracker();
+    std::vector<std::vector<tile_render_info>> draw_rows( max_row );
     for( int row = min_row; row < max_row; row ++ ) {
-        std::vector<tile_render_info> draw_points;
+        std::vector<tile_render_info> &draw_points = draw_rows[row];
         draw_points.reserve( max_col );
         for( int col = min_col; col < max_col; col ++ ) {
+            const int slot = row * max_col + col;
             point temp;
             if( iso_mode ) {
                 // in isometric, rows and columns represent a checkerboard screen space,
@@ -1342,8 +1620,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
 
             lit_level ll;
             // invisible to normal eyes
-            bool invisible[5];
-            invisible[0] = false;
+            bool invisible[5] = {};
 
             if( y < min_visible.y || y > max_visible.y || x < min_visible.x || x > max_visible.x ) {
                 if( has_memory_at( pos ) ) {
@@ -1353,7 +1630,8 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                     ll = lit_level::DARK;
                     invisible[0] = true;
                 } else {
-                    apply_vision_effects( pos, offscreen_type );
+                    draw_points.emplace_back( pos, 0, lit_level::DARK, invisible, offscreen_type,
+                                              false, slot );
                     continue;
                 }
             } else {
@@ -1515,15 +1793,20 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                 draw_debug_tile( reachable ? 0 : 6, std::to_string( value ) );
             }
 
-            if( !invisible[0] && apply_vision_effects( pos, here.get_visibility( ll, cache ) ) ) {
-                const Creature *critter = creatures.creature_at( pos, true );
-                if( has_draw_override( pos ) || has_memory_at( pos ) ||
-                    ( critter && ( you.sees_with_infrared( *critter ) ||
-                                   you.sees_with_specials( *critter ) ) ) ) {
+            visibility_type shade = visibility_type::CLEAR;
+            if( !invisible[0] ) {
+                shade = here.get_visibility( ll, cache );
+                if( would_apply_vision_effects( shade ) ) {
+                    const Creature *critter = creatures.creature_at( pos, true );
+                    if( has_draw_override( pos ) || has_memory_at( pos ) ||
+                        ( critter && ( you.sees_with_infrared( *critter ) ||
+                                       you.sees_with_specials( *critter ) ) ) ) {
 
-                    invisible[0] = true;
-                } else {
-                    continue;
+                        invisible[0] = true;
+                    } else {
+                        draw_points.emplace_back( pos, 0, ll, invisible, shade, false, slot );
+                        continue;
+                    }
                 }
             }
             for( int i = 0; i < 4; i++ ) {
@@ -1531,30 +1814,250 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                 invisible[1 + i] = apply_visible( np, ch, here );
             }
 
-            int height_3d = 0;
+            draw_points.emplace_back( pos, 0, ll, invisible, shade, true, slot );
+        }
+    }
+
+    // The retained frame only works if the fingerprints cover everything the sprites of
+    // a tile depend on, which the drawing overrides and zone marks are not part of, and if
+    // sprites reach a known distance out of their tile.  Isometric tiles overlap too much
+    // to gain anything from it.
+    const int overhang = tileset_ptr->get_sprite_overhang();
+    bool retain = !iso_mode && overhang >= 0 && !g->is_zones_manager_open() &&
+                  terrain_override.empty() && furniture_override.empty() &&
+                  graffiti_override.empty() && trap_override.empty() &&
+                  field_override.empty() && item_override.empty() &&
+                  vpart_override.empty() && draw_below_override.empty() &&
+                  monster_override.empty();
+    if( retain && ( !frame.texture || std::get<0>( frame.view ) != width ||
+                    std::get<1>( frame.view ) != height ) ) {
+        const auto make_target = [&]() {
+            SDL_Texture_Ptr tex = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                 SDL_TEXTUREACCESS_TARGET, width, height );
+            if( tex ) {
+                SetTextureBlendMode( tex, SDL_BLENDMODE_NONE );
+            }
+            return tex;
+        };
+        forget_retained_frame();
+        frame.texture = make_target();
+        frame.scrolled = make_target();
+        if( !frame.texture || !frame.scrolled ) {
+            forget_retained_frame();
+            retain = false;
+        }
+    }
+    // How far, in pixels, the sprites drawn in a tile may reach out of it.
+    const int reach = retain ? divide_round_up( overhang * std::max( tile_width, tile_height ),
+                      std::min( tileset_ptr->get_tile_width(),
+                                tileset_ptr->get_tile_height() ) ) + 1 : 0;
+    // The parts of the picture to redraw, relative to dest.
+    std::vector<SDL_Rect> dirty;
+    if( retain ) {
+        const int columns = max_col;
+        const int rows = max_row;
+        const tripoint origin = here.getabs( tripoint( o, center.z ) );
+        const auto view = std::make_tuple( width, height, tile_width, tile_height,
+                                           tileset_ptr.get(), center.z, nv_goggles_activated,
+                                           offscreen_type,
+                                           static_cast<int>( season_of_year( calendar::turn ) ),
+                                           memory_map_mode, you.should_show_map_memory() );
+        const point delta = origin.xy() - frame.origin.xy();
+        const bool reuse = frame.view == view &&
+                           frame.origin.z == origin.z && frame.columns == columns &&
+                           frame.rows == rows &&
+                           frame.fingerprints.size() == static_cast<size_t>( columns * rows ) &&
+                           std::abs( delta.x ) < columns && std::abs( delta.y ) < rows;
+
+        const bool revival_indicators =
+            tileset_ptr->find_tile_type( ZOMBIE_REVIVAL_INDICATOR ) != nullptr;
+        std::vector<size_t> fingerprints( columns * rows );
+        for( const std::vector<tile_render_info> &draw_points : draw_rows ) {
+            for( const tile_render_info &p : draw_points ) {
+                fingerprints[p.slot] = tile_fingerprint( p.pos, p.ll, p.invisible, p.shade,
+                                       p.layers, revival_indicators );
+            }
+        }
+        std::vector<bool> changed( columns * rows, true );
+        if( reuse ) {
+            const SDL_Rect from{ std::max( delta.x, 0 ) * tile_width,
+                                 std::max( delta.y, 0 ) * tile_height,
+                                 width - std::abs( delta.x ) * tile_width,
+                                 height - std::abs( delta.y ) * tile_height };
+            if( delta != point_zero && from.w > 0 && from.h > 0 ) {
+                const SDL_Rect to{ std::max( -delta.x, 0 ) * tile_width,
+                                   std::max( -delta.y, 0 ) * tile_height, from.w, from.h };
+                SetRenderTarget( renderer, frame.scrolled );
+                printErrorIf( SDL_RenderSetClipRect( renderer.get(), nullptr ) != 0,
+                              "SDL_RenderSetClipRect failed" );
+                RenderCopy( renderer, frame.texture, &from, &to );
+                std::swap( frame.texture, frame.scrolled );
+            }
+            for( int row = 0; row < rows; row++ ) {
+                for( int col = 0; col < columns; col++ ) {
+                    const point old = point( col, row ) + delta;
+                    if( old.x < 0 || old.y < 0 || old.x >= columns || old.y >= rows ) {
+                        continue;
+                    }
+                    const int slot = row * columns + col;
+                    const int old_slot = old.y * columns + old.x;
+                    // The sprites of the tiles that scrolled out of view may have reached
+                    // into the tiles at the edge they left from.
+                    const bool edge = ( delta.x > 0 && col == 0 ) ||
+                                      ( delta.x < 0 && col == columns - 1 ) ||
+                                      ( delta.y > 0 && row == 0 ) ||
+                                      ( delta.y < 0 && row == rows - 1 );
+                    changed[slot] = edge || frame.animated[old_slot] ||
+                                    fingerprints[slot] != frame.fingerprints[old_slot];
+                }
+            }
+            // Only drawing a tile memorizes what it looks like, so the tiles whose memory
+            // is out of date have to be drawn.
+            for( const std::vector<tile_render_info> &draw_points : draw_rows ) {
+                for( const tile_render_info &p : draw_points ) {
+                    if( p.layers && !p.invisible[0] && here.check_seen_cache( p.pos ) ) {
+                        changed[p.slot] = true;
+                    }
+                }
+            }
 
-            // light level is now used for choosing between grayscale filter and normal lit tiles.
-            draw_terrain( pos, ll, height_3d, invisible );
+            // The picture is redrawn by chunks of tiles.  A changed tile changes how its
+            // neighbours connect to it, and the sprites in all of them reach out of them.
+            constexpr int chunk_tiles = 8;
+            const point chunk_size( chunk_tiles * tile_width, chunk_tiles * tile_height );
+            const point chunks( divide_round_up( columns, chunk_tiles ),
+                                divide_round_up( rows, chunk_tiles ) );
+            std::vector<bool> dirty_chunks( chunks.x * chunks.y, false );
+            for( int row = 0; row < rows; row++ ) {
+                for( int col = 0; col < columns; col++ ) {
+                    if( !changed[row * columns + col] ) {
+                        continue;
+                    }
+                    // The pixels that may look different now.
+                    const point from( ( col - 1 ) * tile_width - reach,
+                                      ( row - 1 ) * tile_height - reach );
+                    const point to( ( col + 2 ) * tile_width + reach,
+                                    ( row + 2 ) * tile_height + reach );
+                    const point first( std::max( divide_round_down( from.x, chunk_size.x ), 0 ),
+                                       std::max( divide_round_down( from.y, chunk_size.y ), 0 ) );
+                    const point last( std::min( ( to.x - 1 ) / chunk_size.x, chunks.x - 1 ),
+                                      std::min( ( to.y - 1 ) / chunk_size.y, chunks.y - 1 ) );
+                    for( int y = first.y; y <= last.y; y++ ) {
+                        for( int x = first.x; x <= last.x; x++ ) {
+                            dirty_chunks[y * chunks.x + x] = true;
+                        }
+                    }
+                }
+            }
+            // Neighbouring chunks in a row are redrawn together.
+            for( int y = 0; y < chunks.y; y++ ) {
+                for( int x = 0; x < chunks.x; x++ ) {
+                    if( !dirty_chunks[y * chunks.x + x] ) {
+                        continue;
+                    }
+                    const int first = x;
+                    while( x + 1 < chunks.x && dirty_chunks[y * chunks.x + x + 1] ) {
+                        x++;
+                    }
+                    SDL_Rect rect{ first * chunk_size.x, y * chunk_size.y,
+                                   ( x + 1 - first ) * chunk_size.x, chunk_size.y };
+                    rect.w = std::min( rect.w, width - rect.x );
+                    rect.h = std::min( rect.h, height - rect.y );
+                    if( rect.w > 0 && rect.h > 0 ) {
+                        dirty.push_back( rect );
+                    }
+                }
+            }
+        } else {
+            dirty.push_back( SDL_Rect{ 0, 0, width, height } );
+        }
+        frame.view = view;
+        frame.origin = origin;
+        frame.columns = columns;
+        frame.rows = rows;
+        frame.fingerprints = std::move( fingerprints );
+        frame.animated.assign( columns * rows, false );
+    } else {
+        frame.fingerprints.clear();
+    }
 
-            draw_points.emplace_back( pos, height_3d, ll, invisible );
+    const std::array<decltype( &cata_tiles::draw_furniture ), 11> drawing_layers = {{
+            &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap,
+            &cata_tiles::draw_field_or_item, &cata_tiles::draw_vpart_below,
+            &cata_tiles::draw_critter_at_below, &cata_tiles::draw_terrain_below,
+            &cata_tiles::draw_vpart, &cata_tiles::draw_critter_at,
+            &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
         }
-        const std::array<decltype( &cata_tiles::draw_furniture ), 11> drawing_layers = {{
-                &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap,
-                &cata_tiles::draw_field_or_item, &cata_tiles::draw_vpart_below,
-                &cata_tiles::draw_critter_at_below, &cata_tiles::draw_terrain_below,
-                &cata_tiles::draw_vpart, &cata_tiles::draw_critter_at,
-                &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
+    };
+    // Draws the tiles in the given screen columns and rows, in the order their sprites
+    // have to overlap in.
+    const auto draw_tiles = [&]( const half_open_rectangle<point> &cells ) {
+        batch_sprites = true;
+        for( int row = std::max( cells.p_min.y, min_row ); row < std::min( cells.p_max.y, max_row );
+             row++ ) {
+            std::vector<tile_render_info> &draw_points = draw_rows[row];
+            const auto in_cells = [&]( const tile_render_info & p ) {
+                return cells.contains( point( p.slot % max_col, row ) );
+            };
+            for( tile_render_info &p : draw_points ) {
+                if( !in_cells( p ) ) {
+                    continue;
+                }
+                drawing_slot = retain ? p.slot : -1;
+                apply_vision_effects( p.pos, p.shade );
+                if( p.layers ) {
+                    p.height_3d = 0;
+                    // light level is now used for choosing between grayscale filter and normal
+                    // lit tiles.
+                    draw_terrain( p.pos, p.ll, p.height_3d, p.invisible );
+                }
             }
-        };
-        // for each of the drawing layers in order, back to front ...
-        for( auto f : drawing_layers ) {
-            // ... draw all the points we drew terrain for, in the same order
-            for( auto &p : draw_points ) {
-                ( this->*f )( p.pos, p.ll, p.height_3d, p.invisible );
+            // for each of the drawing layers in order, back to front ...
+            for( auto f : drawing_layers ) {
+                // ... draw all the points we drew terrain for, in the same order
+                for( auto &p : draw_points ) {
+                    if( p.layers && in_cells( p ) ) {
+                        drawing_slot = retain ? p.slot : -1;
+                        ( this->*f )( p.pos, p.ll, p.height_3d, p.invisible );
+                    }
+                }
             }
         }
+        sprites.flush();
+        batch_sprites = false;
+        drawing_slot = -1;
+    };
+    if( retain ) {
+        // The frame is drawn as if it was at the top left of the screen.
+        op = point_zero;
+        SetRenderTarget( renderer, frame.texture );
+        for( const SDL_Rect &rect : dirty ) {
+            printErrorIf( SDL_RenderSetClipRect( renderer.get(), &rect ) != 0,
+                          "SDL_RenderSetClipRect failed" );
+            geometry->rect( renderer, rect, SDL_Color() );
+            draw_tiles( half_open_rectangle<point>(
+                            point( divide_round_down( rect.x - reach, tile_width ),
+                                   divide_round_down( rect.y - reach, tile_height ) ),
+                            point( divide_round_up( rect.x + rect.w + reach, tile_width ),
+                                   divide_round_up( rect.y + rect.h + reach, tile_height ) ) ) );
+        }
+        op = dest;
+        set_displaybuffer_rendertarget();
+        const SDL_Rect clipRect = { dest.x, dest.y, width, height };
+        printErrorIf( SDL_RenderSetClipRect( renderer.get(), &clipRect ) != 0,
+                      "SDL_RenderSetClipRect failed" );
+        RenderCopy( renderer, frame.texture, nullptr, &clipRect );
+    } else {
+        draw_tiles( half_open_rectangle<point>( point( min_col, min_row ),
+                                                point( max_col, max_row ) ) );
+    }
+
+    for( const std::vector<tile_render_info> &draw_points : draw_rows ) {
         // display number of monsters to spawn in mapgen preview
         for( const auto &p : draw_points ) {
+            if( !p.layers ) {
+                continue;
+            }
             const auto mon_override = monster_override.find( p.pos );
             if( mon_override != monster_override.end() ) {
                 const int count = std::get<1>( mon_override->second );
@@ -1903,6 +2406,29 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     }
 }
 
+cata::optional<tile_lookup_res>
+cata_tiles::find_tile_looks_like_cached( const std::string &id, TILE_CATEGORY category,
+        const std::string &variant, const int intensity_level ) const
+{
+    const season_type season = season_of_year( calendar::turn );
+    if( season != looks_like_cache_season ) {
+        for( auto &by_id : looks_like_cache ) {
+            by_id.clear();
+        }
+        looks_like_cache_season = season;
+    }
+    // The keys are only copied the first time they are seen.
+    auto &by_intensity = looks_like_cache[static_cast<size_t>( category )][id][variant];
+    const auto found = by_intensity.find( intensity_level );
+    if( found != by_intensity.end() ) {
+        return found->second;
+    }
+    const cata::optional<tile_lookup_res> res = find_tile_looks_like( intensity_level > 0 ?
+            id + "_int" + std::to_string( intensity_level ) : id, category, variant );
+    by_intensity.emplace( intensity_level, res );
+    return res;
+}
+
 bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &overlay,
         const std::string &variant, std::string &draw_id )
 {
@@ -1983,14 +2509,14 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
     // check if there is an available intensity tile and if there is use that instead of the basic tile
     // this is only relevant for fields
     if( intensity_level > 0 ) {
-        res = find_tile_looks_like( id + "_int" + std::to_string( intensity_level ), category, variant );
+        res = find_tile_looks_like_cached( id, category, variant, intensity_level );
         if( res ) {
             tt = &res -> tile();
         }
     }
     // if a tile with intensity hasn't already been found then fall back to a base tile
     if( !res ) {
-        res = find_tile_looks_like( id, category, variant );
+        res = find_tile_looks_like_cached( id, category, variant );
         if( res ) {
             tt = &res -> tile();
         }
@@ -2326,6 +2852,9 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
 
         // idle tile animations:
         if( display_tile.animated ) {
+            if( drawing_slot >= 0 ) {
+                frame.animated[drawing_slot] = true;
+            }
             // idle animations run during the user's turn, and the animation speed
             // needs to be defined by the tileset to look good, so we use system clock:
             auto now = std::chrono::system_clock::now();
@@ -2402,8 +2931,12 @@ bool cata_tiles::draw_sprite_at(
 
     //use night vision colors when in use
     //then use low light tile if available
+    SDL_Color color = { 0xFF, 0xFF, 0xFF, 0xFF };
     if( ll == lit_level::MEMORIZED ) {
-        if( const texture *ptr = tileset_ptr->get_memory_tile( sprite_index ) ) {
+        if( batch_sprites && sprite_batch::collects() && tileset_ptr->memory_tiles_darken() ) {
+            // The same as the memory tile, without switching to its texture.
+            color = { 85, 85, 85, 0xFF };
+        } else if( const texture *ptr = tileset_ptr->get_memory_tile( sprite_index ) ) {
             sprite_tex = ptr;
         }
     } else if( apply_night_vision_goggles ) {
@@ -2433,13 +2966,13 @@ bool cata_tiles::draw_sprite_at(
     destination.w = width * tile_width / tileset_ptr->get_tile_width();
     destination.h = height * tile_height / tileset_ptr->get_tile_height();
 
+    int angle = 0;
+    SDL_RendererFlip flip = SDL_FLIP_NONE;
     if( rotate_sprite ) {
         switch( rota ) {
             default:
             case 0:
                 // unrotated (and 180, with just two sprites)
-                ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                  SDL_FLIP_NONE );
                 break;
             case 1:
                 // 90 degrees (and 270, with just two sprites)
@@ -2452,23 +2985,14 @@ bool cata_tiles::draw_sprite_at(
 #endif
                 if( !tile_iso ) {
                     // never rotate isometric tiles
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, -90, nullptr,
-                                                      SDL_FLIP_NONE );
-                } else {
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
+                    angle = -90;
                 }
                 break;
             case 2:
                 // 180 degrees, implemented with flips instead of rotation
                 if( !tile_iso ) {
                     // never flip isometric tiles vertically
-                    ret = sprite_tex->render_copy_ex(
-                              renderer, &destination, 0, nullptr,
-                              static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) );
-                } else {
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
+                    flip = static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL );
                 }
                 break;
             case 3:
@@ -2482,22 +3006,19 @@ bool cata_tiles::draw_sprite_at(
 #endif
                 if( !tile_iso ) {
                     // never rotate isometric tiles
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 90, nullptr,
-                                                      SDL_FLIP_NONE );
-                } else {
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
+                    angle = 90;
                 }
                 break;
             case 4:
                 // flip horizontally
-                ret = sprite_tex->render_copy_ex(
-                          renderer, &destination, 0, nullptr,
-                          static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL ) );
+                flip = SDL_FLIP_HORIZONTAL;
         }
+    }
+
+    if( batch_sprites ) {
+        ret = sprite_tex->render_batched( sprites, destination, angle, flip, color );
     } else {
-        // don't rotate, same as case 0 above
-        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr, SDL_FLIP_NONE );
+        ret = sprite_tex->render_copy_ex( renderer, &destination, angle, nullptr, flip );
     }
 
     printErrorIf( ret != 0, "SDL_RenderCopyEx() failed" );
@@ -2621,6 +3142,7 @@ bool cata_tiles::draw_terrain_below( const tripoint &p, const lit_level, int &,
     if( tile_iso ) {
         belowRect.y += tile_height / 8;
     }
+    sprites.flush();
     geometry->rect( renderer, belowRect, tercol );
 
     return true;
@@ -2995,7 +3517,7 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
     bool ret_draw_items = false;
     // go through each field and draw it
     if( !fld_overridden ) {
-        for( std::map<field_type_id, field_entry>::iterator fd_it = here.field_at( p ).begin();
+        for( field_entry_map::iterator fd_it = here.field_at( p ).begin();
              fd_it != here.field_at( p ).end(); ++fd_it ) {
             const field_type_id &fld = fd_it->first;
             if( !invisible[0] && fld.obj().display_field ) {
@@ -3005,7 +3527,7 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
                 auto has_field = [&]( field_type_id fld, const tripoint & q, const bool invis ) -> field_type_id {
                     // go through the fields and see if they are equal
                     field_type_id found = fd_null;
-                    for( std::map<field_type_id, field_entry>::iterator itt = here.field_at( q ).begin(); itt != here.field_at( q ).end(); ++itt )
+                    for( field_entry_map::iterator itt = here.field_at( q ).begin(); itt != here.field_at( q ).end(); ++itt )
                     {
                         if( itt->first == fld ) {
                             found = fld;
@@ -3350,6 +3872,7 @@ bool cata_tiles::draw_critter_at_below( const tripoint &p, const lit_level, int
         belowRect.y += tile_height / 8;
     }
 
+    sprites.flush();
     geometry->rect( renderer, belowRect, tercol );
 
     return true;
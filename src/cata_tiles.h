@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_CATA_TILES_H
 #define CATA_SRC_CATA_TILES_H
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -21,8 +22,10 @@
 #include "options.h"
 #include "pimpl.h"
 #include "point.h"
+#include "sdl_utils.h"
 #include "sdl_wrappers.h"
 #include "sdl_geometry.h"
+#include "sdl_sprite_batch.h"
 #include "type_id.h"
 #include "weather.h"
 #include "weighted_list.h"
@@ -30,6 +33,7 @@
 class Character;
 class JsonObject;
 class pixel_minimap;
+struct memory_usage;
 
 extern void set_displaybuffer_rendertarget();
 
@@ -105,6 +109,11 @@ class texture
             return SDL_RenderCopyEx( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect, angle, center,
                                      flip );
         }
+        /// Adds this texture to batch, see @ref sprite_batch::add.
+        int render_batched( sprite_batch &batch, const SDL_Rect &dstrect, const int angle,
+                            const SDL_RendererFlip flip, const SDL_Color &color ) const {
+            return batch.add( sdl_texture_ptr.get(), srcrect, dstrect, angle, flip, color );
+        }
 };
 
 class layer_variant
@@ -132,11 +141,56 @@ class tileset
         // multiplier for pixel-doubling tilesets
         float tile_pixelscale = 1.0f;
 
+        /** The number of color filtered variants of each sprite, see @ref filtered_tiles. */
+        static constexpr int filtered_variants = 4;
+
+        /**
+         * A part of a sprite sheet that fits into one texture.  The surface is kept until
+         * every filtered variant of the page is built.
+         */
+        struct sheet_page {
+            SDL_Surface_Ptr surface;
+            // Position of the page in the sheet, in pixels.
+            point offset;
+            // Size of the page, in pixels.
+            point size;
+            // Index of the first sprite of the sheet in the tile vectors.
+            int first_index = 0;
+            int sheet_width = 0;
+            int sprite_width = 0;
+            int sprite_height = 0;
+            // Bytes of the surface, and of each texture made from it.
+            size_t bytes = 0;
+            // Textures made from the page so far, the plain one included.
+            int textures_built = 0;
+
+            /** Whether the sprite at index of the tile vectors is on this page. */
+            bool contains( size_t index ) const;
+        };
+
+        /**
+         * The sprites with a color filter applied, e.g. for night vision.  Most of these are
+         * not drawn at all in a session, so each page of them is only built from @ref pages
+         * the first time one of its sprites is asked for.
+         */
+        struct filtered_tiles {
+            color_pixel_function_pointer filter = nullptr;
+            // Which of @ref pages are built, by index.
+            std::vector<bool> pages_built;
+            std::vector<texture> values;
+        };
+
         std::vector<texture> tile_values;
-        std::vector<texture> shadow_tile_values;
-        std::vector<texture> night_tile_values;
-        std::vector<texture> overexposed_tile_values;
-        std::vector<texture> memory_tile_values;
+        mutable filtered_tiles shadow_tile_values;
+        mutable filtered_tiles night_tile_values;
+        mutable filtered_tiles overexposed_tile_values;
+        mutable filtered_tiles memory_tile_values;
+
+        mutable std::vector<sheet_page> pages;
+        // See get_sprite_overhang, computed the first time it is asked for.
+        mutable cata::optional<int> sprite_overhang;
+        // The renderer the tileset was loaded with, which the filtered tiles are built for.
+        const SDL_Renderer_Ptr *renderer = nullptr;
 
         std::unordered_set<std::string> duplicate_ids;
 
@@ -147,9 +201,17 @@ class tileset
 
 
         static const texture *get_if_available( const size_t index,
-                                                const decltype( shadow_tile_values ) &tiles ) {
+                                                const std::vector<texture> &tiles ) {
             return index < tiles.size() ? & tiles[index] : nullptr;
         }
+        const texture *get_filtered_tile( size_t index, filtered_tiles &tiles ) const;
+        /** Build the page of tiles holding the sprite at index, if it is not built yet. */
+        void build_filtered_page( size_t index, filtered_tiles &tiles ) const;
+
+        /** Cuts surf, which holds page of a sprite sheet, into the sprites stored in target. */
+        static void copy_surface_to_texture( const SDL_Renderer_Ptr &renderer,
+                                             const SDL_Surface_Ptr &surf, const sheet_page &page,
+                                             std::vector<texture> &target );
 
         friend class tileset_cache;
 
@@ -172,22 +234,40 @@ class tileset
             return tileset_id;
         }
 
+        /**
+         * The textures made from the sprite sheets so far, and an estimate of the bytes they
+         * and the kept sheets take.
+         */
+        memory_usage memory_use() const;
+
         const texture *get_tile( const size_t index ) const {
             return get_if_available( index, tile_values );
         }
         const texture *get_night_tile( const size_t index ) const {
-            return get_if_available( index, night_tile_values );
+            return get_filtered_tile( index, night_tile_values );
         }
         const texture *get_shadow_tile( const size_t index ) const {
-            return get_if_available( index, shadow_tile_values );
+            return get_filtered_tile( index, shadow_tile_values );
         }
         const texture *get_overexposed_tile( const size_t index ) const {
-            return get_if_available( index, overexposed_tile_values );
+            return get_filtered_tile( index, overexposed_tile_values );
         }
         const texture *get_memory_tile( const size_t index ) const {
-            return get_if_available( index, memory_tile_values );
+            return get_filtered_tile( index, memory_tile_values );
         }
 
+        /** Whether the memory tiles are the tiles darkened by @ref color_pixel_darken. */
+        bool memory_tiles_darken() const {
+            return memory_tile_values.filter == &color_pixel_darken;
+        }
+
+        /**
+         * How far, in tileset pixels, a sprite of the tileset may reach out of the tile it is
+         * drawn in, or -1 if some tile has a height_3d (sprites stacked on it are drawn
+         * higher up, with no bound on how far).
+         */
+        int get_sprite_overhang() const;
+
         const std::unordered_set<std::string> &get_duplicate_ids() const {
             return duplicate_ids;
         }
@@ -248,9 +328,7 @@ class tileset_cache::loader
 
         void ensure_default_item_highlight();
 
-        void copy_surface_to_texture( const SDL_Surface_Ptr &surf, const point &offset,
-                                      std::vector<texture> &target );
-        void create_textures_from_tile_atlas( const SDL_Surface_Ptr &tile_atlas, const point &offset );
+        void create_textures_from_tile_atlas( SDL_Surface_Ptr tile_atlas, const point &offset );
 
         void process_variations_after_loading( weighted_int_list<std::vector<int>> &v );
 
@@ -359,6 +437,9 @@ class cata_tiles
 
         void on_options_changed();
 
+        /** Makes the next draw redraw every tile, e.g. after the render targets were lost. */
+        void forget_retained_frame();
+
         /** Draw to screen */
         void draw( const point &dest, const tripoint &center, int width, int height,
                    std::multimap<point, formatted_text> &overlay_strings,
@@ -377,6 +458,11 @@ class cata_tiles
         cata::optional<tile_lookup_res>
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category, const std::string &variant,
                               int looks_like_jumps_limit = 10 ) const;
+        /** As find_tile_looks_like for id, or for its "_int" tile if intensity_level is
+         * above 0, but remembers the result until the season or the loaded data change. */
+        cata::optional<tile_lookup_res>
+        find_tile_looks_like_cached( const std::string &id, TILE_CATEGORY category,
+                                     const std::string &variant, int intensity_level = 0 ) const;
 
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
@@ -582,6 +668,10 @@ class cata_tiles
         int get_tile_width() const {
             return tile_width;
         }
+        /** The loaded tileset, if there is one. */
+        const tileset *get_tileset() const {
+            return tileset_ptr.get();
+        }
         float get_tile_ratiox() const {
             return tile_ratiox;
         }
@@ -627,6 +717,15 @@ class cata_tiles
         tileset_cache &cache;
         std::shared_ptr<const tileset> tileset_ptr;
 
+        // Results of find_tile_looks_like_cached by category, id, variant and intensity, so
+        // a lookup never has to build a key.  Cleared by load_tileset, which also runs after
+        // data loads.
+        using looks_like_by_variant = std::unordered_map<std::string,
+              std::map<int, cata::optional<tile_lookup_res>>>;
+        mutable std::array<std::unordered_map<std::string, looks_like_by_variant>,
+                static_cast<size_t>( TILE_CATEGORY::last )> looks_like_cache;
+        mutable season_type looks_like_cache_season = season_type::NUM_SEASONS;
+
         int tile_height = 0;
         int tile_width = 0;
         // The width and height of the area we can draw in,
@@ -702,6 +801,46 @@ class cata_tiles
          */
         bool nv_goggles_activated = false;
 
+        /**
+         * The map as the last draw left it.  Drawing every sprite of every tile is most of
+         * the cost of a frame, so draw keeps the picture in a texture and only redraws the
+         * tiles whose fingerprint (see tile_fingerprint) changed since, scrolling the
+         * picture when the view moved.
+         */
+        struct retained_frame {
+            SDL_Texture_Ptr texture;
+            // Of the same size, the picture is scrolled into it.
+            SDL_Texture_Ptr scrolled;
+            // Everything the picture depends on besides the tiles drawn in it: the size of
+            // the area and of a tile, the tileset, the z-level, the night vision goggles, how
+            // tiles out of view look, the season and the map memory mode and visibility.
+            std::tuple<int, int, int, int, const tileset *, int, bool, visibility_type, int,
+                std::string, bool> view;
+            // Absolute map position of the top left tile.
+            tripoint origin;
+            int columns = 0;
+            int rows = 0;
+            // By screen tile, row by row.
+            std::vector<size_t> fingerprints;
+            // Whether an animated sprite was drawn in the tile, it changes every frame then.
+            std::vector<bool> animated;
+        };
+        retained_frame frame;
+        // The screen tile draw is drawing the sprites of, or -1.
+        int drawing_slot = -1;
+        // The map sprites draw collects, while batch_sprites is set, instead of drawing each.
+        sprite_batch sprites;
+        bool batch_sprites = false;
+
+        /**
+         * Sums up everything the sprites drawn in the tile at p depend on, besides the
+         * neighbouring tiles.  shade is the vision effect drawn in the tile and layers
+         * whether its drawing layers are drawn.
+         */
+        size_t tile_fingerprint( const tripoint &p, lit_level ll, const bool ( &invisible )[5],
+                                 visibility_type shade, bool layers,
+                                 bool revival_indicators ) const;
+
         pimpl<pixel_minimap> minimap;
 
     public:
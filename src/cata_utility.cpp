@@ -21,6 +21,7 @@
 #include "options.h"
 #include "output.h"
 #include "rng.h"
+#include "save_journal.h"
 #include "translations.h"
 #include "zlib.h"
 
@@ -75,30 +76,46 @@ bool isBetween( int test, int down, int up )
 
 bool lcmatch( const std::string &str, const std::string &qry )
 {
-    if( std::locale().name() != "en_US.UTF-8" && std::locale().name() != "C" ) {
-        const auto &f = std::use_facet<std::ctype<wchar_t>>( std::locale() );
-        std::wstring wneedle = utf8_to_wstr( qry );
-        std::wstring whaystack = utf8_to_wstr( str );
+    return lcmatch_query( qry ).matches( str );
+}
 
-        f.tolower( &whaystack[0], &whaystack[0] + whaystack.size() );
+bool lcmatch( const translation &str, const std::string &qry )
+{
+    return lcmatch( str.translated(), qry );
+}
+
+lcmatch_query::lcmatch_query( const std::string &qry )
+{
+    const std::string locale_name = std::locale().name();
+    wide = locale_name != "en_US.UTF-8" && locale_name != "C";
+    if( wide ) {
+        const auto &f = std::use_facet<std::ctype<wchar_t>>( std::locale() );
+        wneedle = utf8_to_wstr( qry );
         f.tolower( &wneedle[0], &wneedle[0] + wneedle.size() );
+    } else {
+        needle.reserve( qry.size() );
+        std::transform( qry.begin(), qry.end(), std::back_inserter( needle ), tolower );
+    }
+}
 
+bool lcmatch_query::matches( const std::string &str ) const
+{
+    if( wide ) {
+        const auto &f = std::use_facet<std::ctype<wchar_t>>( std::locale() );
+        std::wstring whaystack = utf8_to_wstr( str );
+        f.tolower( &whaystack[0], &whaystack[0] + whaystack.size() );
         return whaystack.find( wneedle ) != std::wstring::npos;
     }
-    std::string needle;
-    needle.reserve( qry.size() );
-    std::transform( qry.begin(), qry.end(), std::back_inserter( needle ), tolower );
-
-    std::string haystack;
-    haystack.reserve( str.size() );
-    std::transform( str.begin(), str.end(), std::back_inserter( haystack ), tolower );
-
-    return haystack.find( needle ) != std::string::npos;
+    // Lowers the subject as it goes instead of copying it first.
+    return std::search( str.begin(), str.end(), needle.begin(), needle.end(),
+    []( const char a, const char b ) {
+        return tolower( a ) == b;
+    } ) != str.end() || needle.empty();
 }
 
-bool lcmatch( const translation &str, const std::string &qry )
+bool lcmatch_query::matches( const translation &str ) const
 {
-    return lcmatch( str.translated(), qry );
+    return matches( str.translated() );
 }
 
 bool match_include_exclude( const std::string &text, std::string filter )
@@ -281,19 +298,76 @@ float multi_lerp( const std::vector<std::pair<float, float>> &points, float x )
     return ( t * points[i].second ) + ( ( 1 - t ) * points[i - 1].second );
 }
 
-void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+// Writes data to out as a gzip stream, which read_from_file recognizes by its header.
+static void write_gzipped( std::ostream &out, const std::string &data )
+{
+    z_stream zs;
+    memset( &zs, 0, sizeof( zs ) );
+
+    if( deflateInit2( &zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS | 16, 8,
+                      Z_DEFAULT_STRATEGY ) != Z_OK ) {
+        throw std::runtime_error( "deflateInit failed while compressing." );
+    }
+
+    zs.next_in = reinterpret_cast<unsigned char *>( const_cast<char *>( data.data() ) );
+    zs.avail_in = data.size();
+
+    int ret;
+    char outbuffer[32768];
+    do {
+        zs.next_out = reinterpret_cast<Bytef *>( outbuffer );
+        zs.avail_out = sizeof( outbuffer );
+        ret = deflate( &zs, Z_FINISH );
+        out.write( outbuffer, sizeof( outbuffer ) - zs.avail_out );
+    } while( ret == Z_OK );
+
+    deflateEnd( &zs );
+
+    if( ret != Z_STREAM_END ) {
+        std::ostringstream oss;
+        oss << "Exception during zlib compression: (" << ret << ")";
+        throw std::runtime_error( oss.str() );
+    }
+}
+
+void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
+                    const bool compress )
 {
+    if( save_journal::capturing() ) {
+        std::ostringstream contents;
+        if( compress ) {
+            std::ostringstream uncompressed;
+            writer( uncompressed );
+            write_gzipped( contents, uncompressed.str() );
+        } else {
+            writer( contents );
+        }
+        if( !save_journal::append( path, contents.str() ) ) {
+            ofstream_wrapper fout( fs::u8path( path ), std::ios::binary );
+            fout.stream() << contents.str();
+            fout.close();
+        }
+        return;
+    }
+    // The journal may hold a newer version, which has to be in place before this replaces it.
+    save_journal::settle( path );
     // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
     ofstream_wrapper fout( fs::u8path( path ), std::ios::binary );
-    writer( fout.stream() );
+    if( compress ) {
+        std::ostringstream contents;
+        writer( contents );
+        write_gzipped( fout.stream(), contents.str() );
+    } else {
+        writer( fout.stream() );
+    }
     fout.close();
 }
 
 bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
-                    const char *const fail_message )
+                    const char *const fail_message, const bool compress )
 {
     try {
-        write_to_file( path, writer );
+        write_to_file( path, writer, compress );
         return true;
 
     } catch( const std::exception &err ) {
@@ -304,6 +378,11 @@ bool write_to_file( const std::string &path, const std::function<void( std::ostr
     }
 }
 
+bool compress_save_files()
+{
+    return get_option<bool>( "COMPRESS_SAVES" );
+}
+
 ofstream_wrapper::ofstream_wrapper( const fs::path &path, const std::ios::openmode mode )
     : path( path )
 
@@ -349,6 +428,7 @@ std::istream &safe_getline( std::istream &ins, std::string &str )
 
 bool read_from_file( const std::string &path, const std::function<void( std::istream & )> &reader )
 {
+    save_journal::settle( path );
     try {
         cata::ifstream fin( fs::u8path( path ), std::ios::binary );
         if( !fin ) {
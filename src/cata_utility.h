@@ -107,6 +107,24 @@ bool isBetween( int test, int down, int up );
 bool lcmatch( const std::string &str, const std::string &qry );
 bool lcmatch( const translation &str, const std::string &qry );
 
+/**
+ * The query of @ref lcmatch, lowered once to be matched against many subjects, as a filter
+ * does with every item it is run on.
+ */
+class lcmatch_query
+{
+    public:
+        explicit lcmatch_query( const std::string &qry );
+
+        bool matches( const std::string &str ) const;
+        bool matches( const translation &str ) const;
+    private:
+        // Whether the locale needs the query and the subjects lowered as wide characters.
+        bool wide;
+        std::string needle;
+        std::wstring wneedle;
+};
+
 /**
  * Matches text case insensitive with the include/exclude rules of the filter
  *
@@ -306,16 +324,23 @@ class list_circularizer
  * happens, the function shows a popup containing the
  * \p fail_message, the error text and the path.
  *
+ * With \p compress, the file is written gzip-compressed; @ref read_from_file
+ * recognizes such files and inflates them. See @ref compress_save_files.
+ *
  * @return Whether saving succeeded (no error was caught).
  * @throw The void function throws when writing failes or when the @p writer throws.
  * The other function catches all exceptions and returns false.
  */
 ///@{
 bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
-                    const char *fail_message );
-void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer );
+                    const char *fail_message, bool compress = false );
+void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
+                    bool compress = false );
 ///@}
 
+/** Whether the current world wants its save files compressed (the COMPRESS_SAVES option). */
+bool compress_save_files();
+
 class JsonDeserializer;
 
 /**
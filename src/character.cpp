@@ -542,7 +542,7 @@ Character::Character() :
 
     move_mode = move_mode_walk;
     next_expected_position = cata::nullopt;
-    crafting_cache.time = calendar::before_time_starts;
+    invalidate_crafting_inventory();
 
     set_power_level( 0_kJ );
     cash = 0;
@@ -2180,6 +2180,7 @@ void Character::recalc_sight_limits()
 {
     sight_max = 9999;
     vision_mode_cache.reset();
+    night_vision_range_turn = calendar::before_time_starts;
     const bool in_light = get_map().ambient_light_at( pos() ) > LIGHT_AMBIENT_LIT;
 
     // Set sight_max.
@@ -2266,20 +2267,16 @@ static float threshold_for_range( float range )
     return LIGHT_AMBIENT_MINIMAL / std::exp( range * LIGHT_TRANSPARENCY_OPEN_AIR ) - epsilon;
 }
 
-float Character::get_vision_threshold( float light_level ) const
+float Character::get_night_vision_range() const
 {
-    if( vision_mode_cache[DEBUG_NIGHTVISION] ) {
-        // Debug vision always works with absurdly little light.
-        return 0.01;
+    // Creature::sees asks for several sight ranges at once, for every creature that is checked,
+    // and the limb score is worth keeping between them.
+    const int per = get_per();
+    if( night_vision_range_turn == calendar::turn && night_vision_range_per == per ) {
+        return night_vision_range;
     }
 
-    // As light_level goes from LIGHT_AMBIENT_MINIMAL to LIGHT_AMBIENT_LIT,
-    // dimming goes from 1.0 to 2.0.
-    const float dimming_from_light = 1.0 + ( ( static_cast<float>( light_level ) -
-                                     LIGHT_AMBIENT_MINIMAL ) /
-                                     ( LIGHT_AMBIENT_LIT - LIGHT_AMBIENT_MINIMAL ) );
-
-    float range = get_per() / 3.0f;
+    float range = per / 3.0f;
     if( vision_mode_cache[NV_GOGGLES] || vision_mode_cache[NIGHTVISION_3] ||
         vision_mode_cache[FULL_ELFA_VISION] || vision_mode_cache[CEPH_VISION] ) {
         range += 10;
@@ -2295,10 +2292,27 @@ float Character::get_vision_threshold( float light_level ) const
     }
 
     // Clamp range to 1+, so that we can always see where we are
-    range = std::max( 1.0f, range * get_limb_score( limb_score_night_vis ) );
+    night_vision_range = std::max( 1.0f, range * get_limb_score( limb_score_night_vis ) );
+    night_vision_range_turn = calendar::turn;
+    night_vision_range_per = per;
+    return night_vision_range;
+}
+
+float Character::get_vision_threshold( float light_level ) const
+{
+    if( vision_mode_cache[DEBUG_NIGHTVISION] ) {
+        // Debug vision always works with absurdly little light.
+        return 0.01;
+    }
+
+    // As light_level goes from LIGHT_AMBIENT_MINIMAL to LIGHT_AMBIENT_LIT,
+    // dimming goes from 1.0 to 2.0.
+    const float dimming_from_light = 1.0 + ( ( static_cast<float>( light_level ) -
+                                     LIGHT_AMBIENT_MINIMAL ) /
+                                     ( LIGHT_AMBIENT_LIT - LIGHT_AMBIENT_MINIMAL ) );
 
     return std::min( static_cast<float>( LIGHT_AMBIENT_LOW ),
-                     threshold_for_range( range ) * dimming_from_light );
+                     threshold_for_range( get_night_vision_range() ) * dimming_from_light );
 }
 
 void Character::flag_encumbrance()
@@ -3543,6 +3557,41 @@ bool Character::in_climate_control()
     return regulated_area;
 }
 
+const std::map<bodypart_id, std::vector<const item *>> &Character::get_clothing_map() const
+{
+    // The parts an item covers follow from its type and its side, so the map holds for as long
+    // as the same items are worn in the same order. Copies of the character fail the check, as
+    // their items are elsewhere.
+    bool valid = clothing_map_valid && clothing_map_worn.size() == worn.size();
+    if( valid ) {
+        auto key = clothing_map_worn.begin();
+        for( const item &it : worn ) {
+            if( *key != std::make_tuple( &it, it.type, it.get_side() ) ) {
+                valid = false;
+                break;
+            }
+            ++key;
+        }
+    }
+    if( valid ) {
+        return clothing_map_cache;
+    }
+
+    clothing_map_cache.clear();
+    clothing_map_worn.clear();
+    for( const bodypart_id &bp : get_all_body_parts() ) {
+        clothing_map_cache.emplace( bp, std::vector<const item *>() );
+    }
+    for( const item &it : worn ) {
+        for( const bodypart_str_id &covered : it.get_covered_body_parts() ) {
+            clothing_map_cache[covered.id()].emplace_back( &it );
+        }
+        clothing_map_worn.emplace_back( &it, it.type, it.get_side() );
+    }
+    clothing_map_valid = true;
+    return clothing_map_cache;
+}
+
 std::map<bodypart_id, int> Character::get_wind_resistance( const std::map <bodypart_id,
         std::vector<const item *>> &clothing_map ) const
 {
@@ -6912,6 +6961,8 @@ void Character::recalculate_bodyparts()
             body[bp] = bodypart( bp );
         }
     }
+    body_index.parts.clear();
+    clothing_map_valid = false;
     calc_encumbrance();
 }
 
@@ -7733,7 +7784,7 @@ units::volume Character::free_space() const
     volume_capacity += weapon.get_total_capacity();
     for( const item_pocket *pocket : weapon.get_all_contained_pockets().value() ) {
         if( pocket->contains_phase( phase_id::SOLID ) ) {
-            for( const item *it : pocket->all_items_top() ) {
+            for( const item *it : pocket->top_items() ) {
                 volume_capacity -= it->volume();
             }
         } else if( !pocket->empty() ) {
@@ -7745,7 +7796,7 @@ units::volume Character::free_space() const
         volume_capacity += w.get_total_capacity();
         for( const item_pocket *pocket : w.get_all_contained_pockets().value() ) {
             if( pocket->contains_phase( phase_id::SOLID ) ) {
-                for( const item *it : pocket->all_items_top() ) {
+                for( const item *it : pocket->top_items() ) {
                     volume_capacity -= it->volume();
                 }
             } else if( !pocket->empty() ) {
@@ -4,6 +4,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <climits>
 #include <cstdint>
@@ -15,6 +16,7 @@
 #include <new>
 #include <set>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <queue>
 #include <unordered_map>
@@ -774,6 +776,12 @@ class Character : public Creature, public visitable
         /** Returns wind resistance provided by armor, etc **/
         std::map<bodypart_id, int> get_wind_resistance( const
                 std::map<bodypart_id, std::vector<const item *>> &clothing_map ) const;
+        /**
+         * The worn items covering each body part, in the order they are worn. Kept until the
+         * worn items, their types or their sides change, so the temperature and armor checks
+         * do not ask every worn item which parts it covers each time.
+         */
+        const std::map<bodypart_id, std::vector<const item *>> &get_clothing_map() const;
 
         /** Returns true if the player isn't able to see */
         bool is_blind() const;
@@ -1391,6 +1399,8 @@ class Character : public Creature, public visitable
 
         /** Handles bionic effects over time of the entered bionic */
         void process_bionic( int b );
+        /** @ref process_bionic for every bionic that has something to do this turn */
+        void process_bionics();
         /** finds the index of the bionic that corresponds to the currently wielded fake item
          *  i.e. bionic is `BIONIC_WEAPON` and weapon.typeId() == bio.info().fake_item */
         cata::optional<int> active_bionic_weapon_index() const;
@@ -2676,7 +2686,7 @@ class Character : public Creature, public visitable
          * @param range The maximal distance (@ref rl_dist), creatures at this distance or less
          * are included.
          */
-        std::vector<Creature *> get_visible_creatures( int range ) const;
+        virtual std::vector<Creature *> get_visible_creatures( int range ) const;
         /**
          * As above, but includes all creatures the player can detect well enough to target
          * with ranged weapons, e.g. with infrared vision.
@@ -2745,8 +2755,11 @@ class Character : public Creature, public visitable
         void vitamins_mod( const std::map<vitamin_id, int> &, bool capped = true );
         /** Get vitamin usage rate (minutes per unit) accounting for bionics, mutations and effects */
         time_duration vitamin_rate( const vitamin_id &vit ) const;
-        /** Modify vitamin intake (e.g. due to effects) */
-        std::map<vitamin_id, int> effect_vitamin_mod( const std::map<vitamin_id, int> & );
+        /** @ref vitamin_rate given the result of @ref get_mutations, to ask for every vitamin. */
+        time_duration vitamin_rate( const vitamin_id &vit,
+                                    const std::vector<trait_id> &mutations ) const;
+        /** Modify vitamin intake (e.g. due to effects), in place */
+        void effect_vitamin_mod( std::map<vitamin_id, int> &vits ) const;
         /** Remove all vitamins */
         void clear_vitamins();
 
@@ -3258,6 +3271,12 @@ class Character : public Creature, public visitable
          * Pointers to mutation branches in @ref my_mutations.
          */
         std::vector<const mutation_branch *> cached_mutations;
+        /**
+         * Which mutations are in @ref my_mutations, by @ref mutation_branch::index_of, so that
+         * @ref has_trait does not have to look them up. Kept with @ref cached_mutations.
+         */
+        std::vector<bool> mutation_bits;
+        void set_mutation_bit( const trait_id &trait, bool value );
         /**
          * The amount of weight the Character is carrying.
          * If it is nullopt, needs to be recalculated
@@ -3275,6 +3294,12 @@ class Character : public Creature, public visitable
         // Cached vision values.
         std::bitset<NUM_VISION_MODES> vision_mode_cache;
         int sight_max = 0;
+        // The part of get_vision_threshold that does not depend on the light, kept for the turn
+        // and the perception it was worked out with; reset by recalc_sight_limits.
+        mutable float night_vision_range = 0.0f;
+        mutable time_point night_vision_range_turn = calendar::before_time_starts;
+        mutable int night_vision_range_per = 0;
+        float get_night_vision_range() const;
 
         /// turn the character expired, if calendar::before_time_starts it has not been set yet.
         /// @todo change into an optional<time_point>
@@ -3364,6 +3389,11 @@ class Character : public Creature, public visitable
         bool check_encumbrance = true;
         bool cache_inventory_is_valid = false;
 
+        /** @ref get_clothing_map, and the worn items it was made from. */
+        mutable std::map<bodypart_id, std::vector<const item *>> clothing_map_cache;
+        mutable std::vector<std::tuple<const item *, const itype *, side>> clothing_map_worn;
+        mutable bool clothing_map_valid = false;
+
         int stim;
         int pkill;
 
@@ -3383,7 +3413,11 @@ class Character : public Creature, public visitable
             int radius;
             pimpl<inventory> crafting_inventory;
         };
-        mutable crafting_cache_type crafting_cache;
+        // One entry per recently asked for (position, radius): callers often alternate between
+        // the character's own items (radius -1) and everything in reach.
+        mutable std::array<crafting_cache_type, 2> crafting_cache;
+        // The entry to rebuild on the next miss.
+        mutable size_t crafting_cache_next = 0;
 
         time_point melee_warning_turn = calendar::turn_zero;
 
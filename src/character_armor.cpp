@@ -14,6 +14,15 @@ static const efftype_id effect_onfire( "onfire" );
 
 static const trait_id trait_SEESLEEP( "SEESLEEP" );
 
+// The worn items covering bp, in the order they are worn.
+static const std::vector<const item *> &worn_on( const Character &guy, const bodypart_id &bp )
+{
+    static const std::vector<const item *> none;
+    const std::map<bodypart_id, std::vector<const item *>> &clothing = guy.get_clothing_map();
+    const auto found = clothing.find( bp );
+    return found == clothing.end() ? none : found->second;
+}
+
 bool Character::can_interface_armor() const
 {
     bool okay = std::any_of( my_bionics->begin(), my_bionics->end(),
@@ -78,10 +87,8 @@ int Character::get_armor_type( damage_type dt, bodypart_id bp ) const
         case damage_type::COLD:
         case damage_type::ELECTRIC: {
             int ret = 0;
-            for( const item &i : worn ) {
-                if( i.covers( bp ) ) {
-                    ret += i.damage_resist( dt, false, bp );
-                }
+            for( const item *i : worn_on( *this, bp ) ) {
+                ret += i->damage_resist( dt, false, bp );
             }
 
             ret += mutation_armor( bp, dt );
@@ -152,10 +159,8 @@ std::map<bodypart_id, int> Character::get_all_armor_type( damage_type dt,
 int Character::get_armor_bash_base( bodypart_id bp ) const
 {
     float ret = 0;
-    for( const item &i : worn ) {
-        if( i.covers( bp ) ) {
-            ret += i.bash_resist( false, bp );
-        }
+    for( const item *i : worn_on( *this, bp ) ) {
+        ret += i->bash_resist( false, bp );
     }
     for( const bionic_id &bid : get_bionics() ) {
         const auto bash_prot = bid->bash_protec.find( bp.id() );
@@ -172,10 +177,8 @@ int Character::get_armor_bash_base( bodypart_id bp ) const
 int Character::get_armor_cut_base( bodypart_id bp ) const
 {
     float ret = 0;
-    for( const item &i : worn ) {
-        if( i.covers( bp ) ) {
-            ret += i.cut_resist( false, bp );
-        }
+    for( const item *i : worn_on( *this, bp ) ) {
+        ret += i->cut_resist( false, bp );
     }
     for( const bionic_id &bid : get_bionics() ) {
         const auto cut_prot = bid->cut_protec.find( bp.id() );
@@ -192,10 +195,8 @@ int Character::get_armor_cut_base( bodypart_id bp ) const
 int Character::get_armor_bullet_base( bodypart_id bp ) const
 {
     float ret = 0;
-    for( const item &i : worn ) {
-        if( i.covers( bp ) ) {
-            ret += i.bullet_resist( false, bp );
-        }
+    for( const item *i : worn_on( *this, bp ) ) {
+        ret += i->bullet_resist( false, bp );
     }
 
     for( const bionic_id &bid : get_bionics() ) {
@@ -149,7 +149,16 @@ void Character::update_body_wetness( const w_point &weather )
 
 void Character::update_body()
 {
-    update_body( calendar::turn - 1_turns, calendar::turn );
+    // Asleep, nothing needs the body to be up to the turn, so it is brought up to date once a
+    // minute, the way the bodies of NPCs are. The needs, healing and health tick on whole
+    // minutes anyway, so it is only the stomach, stamina and vitamins that are done in steps.
+    const bool in_steps = in_sleep_state();
+    if( in_steps && !calendar::once_every( 1_minutes ) ) {
+        return;
+    }
+    const time_point from = in_steps ? std::max( last_updated, calendar::turn - 1_minutes ) :
+                            calendar::turn - 1_turns;
+    update_body( from, calendar::turn );
     last_updated = calendar::turn;
 }
 
@@ -204,8 +213,9 @@ void Character::update_body( const time_point &from, const time_point &to )
         get_sick();
     }
 
+    const std::vector<trait_id> mutations = get_mutations();
     for( const auto &v : vitamin::all() ) {
-        const time_duration rate = vitamin_rate( v.first );
+        const time_duration rate = vitamin_rate( v.first, mutations );
 
         // No blood volume regeneration if body lacks fluids
         if( v.first == vitamin_blood && has_effect( effect_hypovolemia ) && get_thirst() > 240 ) {
@@ -354,15 +364,7 @@ void Character::update_bodytemp()
 
     const int h_radiation = get_heat_radiation( pos(), false );
 
-    std::map<bodypart_id, std::vector<const item *>> clothing_map;
-    for( const bodypart_id &bp : get_all_body_parts() ) {
-        clothing_map.emplace( bp, std::vector<const item *>() );
-    }
-    for( const item &it : worn ) {
-        for( const bodypart_str_id &covered : it.get_covered_body_parts() ) {
-            clothing_map[covered.id()].emplace_back( &it );
-        }
-    }
+    const std::map<bodypart_id, std::vector<const item *>> &clothing_map = get_clothing_map();
 
     std::map<bodypart_id, int> warmth_per_bp = warmth( clothing_map );
     std::map<bodypart_id, int> bonus_warmth_per_bp = bonus_item_warmth();
@@ -788,7 +790,8 @@ void Character::update_stomach( const time_point &from, const time_point &to )
         guts.ingest( digested_to_guts );
 
         mod_stored_kcal( digested_to_body.nutr.kcal() );
-        vitamins_mod( effect_vitamin_mod( digested_to_body.nutr.vitamins ), false );
+        effect_vitamin_mod( digested_to_body.nutr.vitamins );
+        vitamins_mod( digested_to_body.nutr.vitamins, false );
         log_activity_level( activity_history.average_activity() );
 
         if( !foodless && rates.hunger > 0.0f ) {
@@ -137,6 +137,8 @@ void zone_manager::clear()
     // Do not clear types since it is needed for the next games.
     area_cache.clear();
     vzone_cache.clear();
+    area_bounds.clear();
+    vzone_bounds.clear();
 }
 
 std::string zone_type::name() const
@@ -621,6 +623,7 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
 void zone_manager::cache_data()
 {
     area_cache.clear();
+    area_bounds.clear();
 
     for( zone_data &elem : zones ) {
         if( !elem.get_enabled() ) {
@@ -640,12 +643,14 @@ void zone_manager::cache_data()
                 elem.get_end_point() ) ) {
             cache.insert( p );
         }
+        area_bounds[type_hash].emplace_back( elem.get_start_point(), elem.get_end_point() );
     }
 }
 
 void zone_manager::cache_vzones()
 {
     vzone_cache.clear();
+    vzone_bounds.clear();
     map &here = get_map();
     auto vzones = here.get_vehicle_zones( here.get_abs_sub().z );
     for( zone_data *elem : vzones ) {
@@ -663,20 +668,45 @@ void zone_manager::cache_vzones()
                 elem->get_end_point() ) ) {
             cache.insert( p );
         }
+        vzone_bounds[type_hash].emplace_back( elem->get_start_point(), elem->get_end_point() );
     }
 }
 
-std::unordered_set<tripoint> zone_manager::get_point_set( const zone_type_id &type,
+static const std::unordered_set<tripoint> no_points;
+
+const std::unordered_set<tripoint> &zone_manager::get_point_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
     const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint>();
+        return no_points;
     }
 
     return type_iter->second;
 }
 
+std::array<const zone_manager::zone_bounds *, 2> zone_manager::get_bounds(
+    const zone_type_id &type, const faction_id &fac ) const
+{
+    static const zone_bounds no_bounds;
+    const std::string type_hash = zone_data::make_type_hash( type, fac );
+    const auto area_iter = area_bounds.find( type_hash );
+    const auto vzone_iter = vzone_bounds.find( type_hash );
+    return {{
+            area_iter == area_bounds.end() ? &no_bounds : &area_iter->second,
+            vzone_iter == vzone_bounds.end() ? &no_bounds : &vzone_iter->second
+        }};
+}
+
+// The point of the zone from @p bounds.first to @p bounds.second closest to @p where.
+static tripoint closest_point_in( const std::pair<tripoint, tripoint> &bounds,
+                                  const tripoint &where )
+{
+    return tripoint( clamp( where.x, bounds.first.x, bounds.second.x ),
+                     clamp( where.y, bounds.first.y, bounds.second.y ),
+                     clamp( where.z, bounds.first.z, bounds.second.z ) );
+}
+
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &where,
         int radius, const faction_id &fac ) const
 {
@@ -702,13 +732,13 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &w
     return res;
 }
 
-std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &type,
+const std::unordered_set<tripoint> &zone_manager::get_vzone_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
     //Only regenerate the vehicle zone cache if any vehicles have moved
     const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint>();
+        return no_points;
     }
 
     return type_iter->second;
@@ -725,19 +755,12 @@ bool zone_manager::has( const zone_type_id &type, const tripoint &where,
 bool zone_manager::has_near( const zone_type_id &type, const tripoint &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( const tripoint &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
+    for( const zone_bounds *bounds : get_bounds( type, fac ) ) {
+        for( const std::pair<tripoint, tripoint> &zone : *bounds ) {
+            if( where.z < zone.first.z || where.z > zone.second.z ) {
+                continue;
             }
-        }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
+            if( square_dist( closest_point_in( zone, where ), where ) <= range ) {
                 return true;
             }
         }
@@ -797,26 +820,21 @@ bool zone_manager::custom_loot_has( const tripoint &where, const item *it ) cons
 std::unordered_set<tripoint> zone_manager::get_near( const zone_type_id &type,
         const tripoint &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     auto near_point_set = std::unordered_set<tripoint>();
-    for( const tripoint &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_type_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
-                }
+    for( const zone_bounds *bounds : get_bounds( type, fac ) ) {
+        for( const std::pair<tripoint, tripoint> &zone : *bounds ) {
+            if( where.z < zone.first.z || where.z > zone.second.z ) {
+                continue;
             }
-        }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
+            // The part of the zone within range on the level of where.
+            const tripoint from( std::max( zone.first.x, where.x - range ),
+                                 std::max( zone.first.y, where.y - range ), where.z );
+            const tripoint to( std::min( zone.second.x, where.x + range ),
+                               std::min( zone.second.y, where.y + range ), where.z );
+            if( from.x > to.x || from.y > to.y ) {
+                continue;
+            }
+            for( const tripoint &point : tripoint_range<tripoint>( from, to ) ) {
                 if( it && has( zone_type_LOOT_CUSTOM, point ) ) {
                     if( custom_loot_has( point, it ) ) {
                         near_point_set.insert( point );
@@ -840,26 +858,16 @@ cata::optional<tripoint> zone_manager::get_nearest( const zone_type_id &type, co
 
     tripoint nearest_pos = tripoint( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint> &point_set = get_point_set( type, fac );
-    for( const tripoint &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
-        }
-    }
-
-    const std::unordered_set<tripoint> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+    for( const zone_bounds *bounds : get_bounds( type, fac ) ) {
+        for( const std::pair<tripoint, tripoint> &zone : *bounds ) {
+            const tripoint p = closest_point_in( zone, where );
+            int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
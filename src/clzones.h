@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_CLZONES_H
 #define CATA_SRC_CLZONES_H
 
+#include <array>
 #include <functional>
 #include <cstddef>
 #include <iosfwd>
@@ -405,10 +406,20 @@ class zone_manager
         std::unordered_map<std::string, std::unordered_set<tripoint>> area_cache;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<std::string, std::unordered_set<tripoint>> vzone_cache;
-        std::unordered_set<tripoint> get_point_set( const zone_type_id &type,
+        // The first and last corner of each of the zones in area_cache and vzone_cache, so
+        // that the queries about a range only walk the part of the zones inside of it.
+        using zone_bounds = std::vector<std::pair<tripoint, tripoint>>;
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<std::string, zone_bounds> area_bounds;
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<std::string, zone_bounds> vzone_bounds;
+        const std::unordered_set<tripoint> &get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint> get_vzone_set( const zone_type_id &type,
+        const std::unordered_set<tripoint> &get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
+        /** The bounds of the zones of @p type in area_cache, then those in vzone_cache */
+        std::array<const zone_bounds *, 2> get_bounds( const zone_type_id &type,
+                const faction_id &fac ) const;
 
     public:
         zone_manager();
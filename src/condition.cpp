@@ -50,6 +50,74 @@ static const efftype_id effect_currently_busy( "currently_busy" );
 
 static const json_character_flag json_flag_MUTATION_THRESHOLD( "MUTATION_THRESHOLD" );
 
+namespace
+{
+// The "op" of a comparison, worked out when the condition is loaded rather than every time the
+// condition is checked.
+enum class comparison : int {
+    equal,
+    not_equal,
+    less_equal,
+    greater_equal,
+    less,
+    greater,
+    // An unknown operator, for which the comparison is never true.
+    never
+};
+
+comparison comparison_from_string( const std::string &op, const bool allow_single_equal )
+{
+    if( op == "==" || ( allow_single_equal && op == "=" ) ) {
+        return comparison::equal;
+    } else if( op == "!=" ) {
+        return comparison::not_equal;
+    } else if( op == "<=" ) {
+        return comparison::less_equal;
+    } else if( op == ">=" ) {
+        return comparison::greater_equal;
+    } else if( op == "<" ) {
+        return comparison::less;
+    } else if( op == ">" ) {
+        return comparison::greater;
+    }
+    return comparison::never;
+}
+
+bool compare( const comparison op, const int lhs, const int rhs )
+{
+    switch( op ) {
+        case comparison::equal:
+            return lhs == rhs;
+        case comparison::not_equal:
+            return lhs != rhs;
+        case comparison::less_equal:
+            return lhs <= rhs;
+        case comparison::greater_equal:
+            return lhs >= rhs;
+        case comparison::less:
+            return lhs < rhs;
+        case comparison::greater:
+            return lhs > rhs;
+        case comparison::never:
+            break;
+    }
+    return false;
+}
+
+// The value of an operand of compare_int that does not depend on the dialogue, the same way
+// get_get_int reads it.
+cata::optional<int> get_constant_int( const JsonObject &jo )
+{
+    if( jo.has_member( "const" ) ) {
+        return jo.get_int( "const" );
+    } else if( jo.has_member( "time" ) ) {
+        return to_turns<int>( read_from_json_string<time_duration>( jo.get_member( "time" ),
+                              time_duration::units ) );
+    }
+    return cata::nullopt;
+}
+} // namespace
+
 // throws an error on failure, so no need to return
 std::string get_talk_varname( const JsonObject &jo, const std::string &member, bool check_value )
 {
@@ -432,7 +500,7 @@ void conditional_t<T>::set_compare_var( const JsonObject &jo, const std::string
                                         bool is_npc )
 {
     const std::string var_name = get_talk_varname( jo, member, false );
-    const std::string &op = jo.get_string( "op" );
+    const comparison op = comparison_from_string( jo.get_string( "op" ), false );
 
     int_or_var iov = get_int_or_var( jo, "value" );
     condition = [var_name, op, iov, is_npc]( const T & d ) {
@@ -442,27 +510,7 @@ void conditional_t<T>::set_compare_var( const JsonObject &jo, const std::string
         if( !var.empty() ) {
             stored_value = std::stoi( var );
         }
-
-        if( op == "==" ) {
-            return stored_value == value;
-
-        } else if( op == "!=" ) {
-            return stored_value != value;
-
-        } else if( op == "<=" ) {
-            return stored_value <= value;
-
-        } else if( op == ">=" ) {
-            return stored_value >= value;
-
-        } else if( op == "<" ) {
-            return stored_value < value;
-
-        } else if( op == ">" ) {
-            return stored_value > value;
-        }
-
-        return false;
+        return compare( op, stored_value, value );
     };
 }
 
@@ -471,7 +519,7 @@ void conditional_t<T>::set_compare_time_since_var( const JsonObject &jo, const s
         bool is_npc )
 {
     const std::string var_name = get_talk_varname( jo, member, false );
-    const std::string &op = jo.get_string( "op" );
+    const comparison op = comparison_from_string( jo.get_string( "op" ), false );
     const int value = to_turns<int>( read_from_json_string<time_duration>( jo.get_member( "time" ),
                                      time_duration::units ) );
     condition = [var_name, op, value, is_npc]( const T & d ) {
@@ -483,28 +531,7 @@ void conditional_t<T>::set_compare_time_since_var( const JsonObject &jo, const s
             stored_value = std::stoi( var );
         }
         stored_value += value;
-        int now = to_turn<int>( calendar::turn );
-
-        if( op == "==" ) {
-            return stored_value == now;
-
-        } else if( op == "!=" ) {
-            return stored_value != now;
-
-        } else if( op == "<=" ) {
-            return now <= stored_value;
-
-        } else if( op == ">=" ) {
-            return now >= stored_value;
-
-        } else if( op == "<" ) {
-            return now < stored_value;
-
-        } else if( op == ">" ) {
-            return now > stored_value;
-        }
-
-        return false;
+        return compare( op, to_turn<int>( calendar::turn ), stored_value );
     };
 }
 
@@ -941,38 +968,42 @@ void conditional_t<T>::set_compare_int( const JsonObject &jo, const std::string
         };
         return;
     }
-    std::function<int( const T & )> get_first_int  = get_get_int( objects.get_object( 0 ) );
-    std::function<int( const T & )> get_second_int = get_get_int( objects.get_object( 1 ) );
-    const std::string &op = jo.get_string( "op" );
-
-    if( op == "==" || op == "=" ) {
-        condition = [get_first_int, get_second_int]( const T & d ) {
-            return get_first_int( d ) == get_second_int( d );
-        };
-    } else if( op == "!=" ) {
-        condition = [get_first_int, get_second_int]( const T & d ) {
-            return get_first_int( d ) != get_second_int( d );
-        };
-    } else if( op == "<=" ) {
-        condition = [get_first_int, get_second_int]( const T & d ) {
-            return get_first_int( d ) <= get_second_int( d );
+    const comparison op = comparison_from_string( jo.get_string( "op" ), true );
+    if( op == comparison::never ) {
+        jo.throw_error( "unexpected operator " + jo.get_string( "op" ) + " in " + jo.str() );
+        condition = []( const T & ) {
+            return false;
         };
-    } else if( op == ">=" ) {
-        condition = [get_first_int, get_second_int]( const T & d ) {
-            return get_first_int( d ) >= get_second_int( d );
+        return;
+    }
+    const JsonObject first = objects.get_object( 0 );
+    const JsonObject second = objects.get_object( 1 );
+    const cata::optional<int> first_const = get_constant_int( first );
+    const cata::optional<int> second_const = get_constant_int( second );
+    // Most conditions compare against a constant, which is then kept as it is instead of being
+    // called for.
+    if( first_const && second_const ) {
+        const bool result = compare( op, *first_const, *second_const );
+        condition = [result]( const T & ) {
+            return result;
         };
-    } else if( op == "<" ) {
-        condition = [get_first_int, get_second_int]( const T & d ) {
-            return get_first_int( d ) < get_second_int( d );
+    } else if( second_const ) {
+        std::function<int( const T & )> get_first_int = get_get_int( first );
+        const int second_int = *second_const;
+        condition = [get_first_int, op, second_int]( const T & d ) {
+            return compare( op, get_first_int( d ), second_int );
         };
-    } else if( op == ">" ) {
-        condition = [get_first_int, get_second_int]( const T & d ) {
-            return get_first_int( d ) > get_second_int( d );
+    } else if( first_const ) {
+        const int first_int = *first_const;
+        std::function<int( const T & )> get_second_int = get_get_int( second );
+        condition = [first_int, op, get_second_int]( const T & d ) {
+            return compare( op, first_int, get_second_int( d ) );
         };
     } else {
-        jo.throw_error( "unexpected operator " + jo.get_string( "op" ) + " in " + jo.str() );
-        condition = []( const T & ) {
-            return false;
+        std::function<int( const T & )> get_first_int  = get_get_int( first );
+        std::function<int( const T & )> get_second_int = get_get_int( second );
+        condition = [get_first_int, op, get_second_int]( const T & d ) {
+            return compare( op, get_first_int( d ), get_second_int( d ) );
         };
     }
 }
@@ -483,10 +483,16 @@ std::pair<int, int> Character::fun_for( const item &comest, bool ignore_already_
 }
 
 time_duration Character::vitamin_rate( const vitamin_id &vit ) const
+{
+    return vitamin_rate( vit, get_mutations() );
+}
+
+time_duration Character::vitamin_rate( const vitamin_id &vit,
+                                       const std::vector<trait_id> &mutations ) const
 {
     time_duration res = vit.obj().rate();
 
-    for( const auto &m : get_mutations() ) {
+    for( const auto &m : mutations ) {
         const auto &mut = m.obj();
         auto iter = mut.vitamin_rates.find( vit );
         if( iter != mut.vitamin_rates.end() ) {
@@ -502,11 +508,12 @@ void Character::clear_vitamins()
     vitamin_levels.clear();
 }
 
-std::map<vitamin_id, int> Character::effect_vitamin_mod( const std::map<vitamin_id, int> &vits )
+void Character::effect_vitamin_mod( std::map<vitamin_id, int> &vits ) const
 {
-    std::vector<std::pair<vitamin_id, float>> mods;
-    // Yuck!
-    // Construct mods, for easy iteration over to modify vitamins
+    if( vits.empty() ) {
+        return;
+    }
+    // Every multiplier is applied in the order of the effects, rounding down each time.
     for( const std::pair<const efftype_id, std::map<bodypart_id, effect>> &elem : *effects ) {
         for( const std::pair<const bodypart_id, effect> &veffect : elem.second ) {
             const bool reduced = resists_effect( veffect.second );
@@ -514,21 +521,13 @@ std::map<vitamin_id, int> Character::effect_vitamin_mod( const std::map<vitamin_
                 if( !rate_mod.absorb_mult ) {
                     continue;
                 }
-                mods.emplace_back( rate_mod.vitamin, *rate_mod.absorb_mult );
-            }
-        }
-    }
-
-    std::map<vitamin_id, int> ret = vits;
-    for( std::pair<const vitamin_id, int> &value : ret ) {
-        for( const std::pair<vitamin_id, float> &mod : mods ) {
-            if( value.first == mod.first ) {
-                value.second *= mod.second;
+                const auto found = vits.find( rate_mod.vitamin );
+                if( found != vits.end() ) {
+                    found->second *= *rate_mod.absorb_mult;
+                }
             }
         }
     }
-
-    return ret;
 }
 
 int Character::vitamin_mod( const vitamin_id &vit, int qty, bool capped )
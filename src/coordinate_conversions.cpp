@@ -2,40 +2,41 @@
 
 #include "game_constants.h"
 
-static int divide( int v, int m )
+// The divisors are all constants, so they are template arguments, which lets the power of two
+// ones divide with a shift.
+template<int M>
+static int divide( int v )
 {
-    if( v >= 0 ) {
-        return v / m;
-    }
-    return ( v - m + 1 ) / m;
+    return divide_round_to_minus_infinity<M>( v );
 }
 
-static int divide( int v, int m, int &r )
+template<int M>
+static int divide( int v, int &r )
 {
-    const int result = divide( v, m );
-    r = v - result * m;
+    const int result = divide<M>( v );
+    r = v - result * M;
     return result;
 }
 
 point omt_to_om_copy( const point &p )
 {
-    return point( divide( p.x, OMAPX ), divide( p.y, OMAPY ) );
+    return point( divide<OMAPX>( p.x ), divide<OMAPY>( p.y ) );
 }
 
 tripoint omt_to_om_copy( const tripoint &p )
 {
-    return tripoint( divide( p.x, OMAPX ), divide( p.y, OMAPY ), p.z );
+    return tripoint( divide<OMAPX>( p.x ), divide<OMAPY>( p.y ), p.z );
 }
 
 void omt_to_om( int &x, int &y )
 {
-    x = divide( x, OMAPX );
-    y = divide( y, OMAPY );
+    x = divide<OMAPX>( x );
+    y = divide<OMAPY>( y );
 }
 
 point omt_to_om_remain( int &x, int &y )
 {
-    return point( divide( x, OMAPX, x ), divide( y, OMAPY, y ) );
+    return point( divide<OMAPX>( x, x ), divide<OMAPY>( y, y ) );
 }
 
 point om_to_omt_copy( const point &p )
@@ -45,44 +46,44 @@ point om_to_omt_copy( const point &p )
 
 point sm_to_omt_copy( const point &p )
 {
-    return point( divide( p.x, 2 ), divide( p.y, 2 ) );
+    return point( divide<2>( p.x ), divide<2>( p.y ) );
 }
 
 tripoint sm_to_omt_copy( const tripoint &p )
 {
-    return tripoint( divide( p.x, 2 ), divide( p.y, 2 ), p.z );
+    return tripoint( divide<2>( p.x ), divide<2>( p.y ), p.z );
 }
 
 void sm_to_omt( int &x, int &y )
 {
-    x = divide( x, 2 );
-    y = divide( y, 2 );
+    x = divide<2>( x );
+    y = divide<2>( y );
 }
 
 point sm_to_omt_remain( int &x, int &y )
 {
-    return point( divide( x, 2, x ), divide( y, 2, y ) );
+    return point( divide<2>( x, x ), divide<2>( y, y ) );
 }
 
 point sm_to_om_copy( const point &p )
 {
-    return point( divide( p.x, 2 * OMAPX ), divide( p.y, 2 * OMAPY ) );
+    return point( divide<2 * OMAPX>( p.x ), divide<2 * OMAPY>( p.y ) );
 }
 
 tripoint sm_to_om_copy( const tripoint &p )
 {
-    return tripoint( divide( p.x, 2 * OMAPX ), divide( p.y, 2 * OMAPY ), p.z );
+    return tripoint( divide<2 * OMAPX>( p.x ), divide<2 * OMAPY>( p.y ), p.z );
 }
 
 void sm_to_om( int &x, int &y )
 {
-    x = divide( x, 2 * OMAPX );
-    y = divide( y, 2 * OMAPY );
+    x = divide<2 * OMAPX>( x );
+    y = divide<2 * OMAPY>( y );
 }
 
 point sm_to_om_remain( int &x, int &y )
 {
-    return point( divide( x, 2 * OMAPX, x ), divide( y, 2 * OMAPY, y ) );
+    return point( divide<2 * OMAPX>( x, x ), divide<2 * OMAPY>( y, y ) );
 }
 
 point omt_to_ms_copy( const point &p )
@@ -124,23 +125,23 @@ void om_to_sm( int &x, int &y )
 
 point ms_to_sm_copy( const point &p )
 {
-    return point( divide( p.x, SEEX ), divide( p.y, SEEY ) );
+    return point( divide<SEEX>( p.x ), divide<SEEY>( p.y ) );
 }
 
 tripoint ms_to_sm_copy( const tripoint &p )
 {
-    return tripoint( divide( p.x, SEEX ), divide( p.y, SEEY ), p.z );
+    return tripoint( divide<SEEX>( p.x ), divide<SEEY>( p.y ), p.z );
 }
 
 void ms_to_sm( int &x, int &y )
 {
-    x = divide( x, SEEX );
-    y = divide( y, SEEY );
+    x = divide<SEEX>( x );
+    y = divide<SEEY>( y );
 }
 
 point ms_to_sm_remain( int &x, int &y )
 {
-    return point( divide( x, SEEX, x ), divide( y, SEEY, y ) );
+    return point( divide<SEEX>( x, x ), divide<SEEY>( y, y ) );
 }
 
 point sm_to_ms_copy( const point &p )
@@ -161,33 +162,33 @@ void sm_to_ms( int &x, int &y )
 
 point ms_to_omt_copy( const point &p )
 {
-    return point( divide( p.x, SEEX * 2 ), divide( p.y, SEEY * 2 ) );
+    return point( divide<SEEX * 2>( p.x ), divide<SEEY * 2>( p.y ) );
 }
 
 tripoint ms_to_omt_copy( const tripoint &p )
 {
-    return tripoint( divide( p.x, SEEX * 2 ), divide( p.y, SEEY * 2 ), p.z );
+    return tripoint( divide<SEEX * 2>( p.x ), divide<SEEY * 2>( p.y ), p.z );
 }
 
 void ms_to_omt( int &x, int &y )
 {
-    x = divide( x, SEEX * 2 );
-    y = divide( y, SEEY * 2 );
+    x = divide<SEEX * 2>( x );
+    y = divide<SEEY * 2>( y );
 }
 
 point ms_to_omt_remain( int &x, int &y )
 {
-    return point( divide( x, SEEX * 2, x ), divide( y, SEEY * 2, y ) );
+    return point( divide<SEEX * 2>( x, x ), divide<SEEY * 2>( y, y ) );
 }
 
 tripoint omt_to_seg_copy( const tripoint &p )
 {
-    return tripoint( divide( p.x, SEG_SIZE ), divide( p.y, SEG_SIZE ), p.z );
+    return tripoint( divide<SEG_SIZE>( p.x ), divide<SEG_SIZE>( p.y ), p.z );
 }
 
 point sm_to_mmr_remain( int &x, int &y )
 {
-    return point( divide( x, MM_REG_SIZE, x ), divide( y, MM_REG_SIZE, y ) );
+    return point( divide<MM_REG_SIZE>( x, x ), divide<MM_REG_SIZE>( y, y ) );
 }
 
 tripoint mmr_to_sm_copy( const tripoint &p )
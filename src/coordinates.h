@@ -303,7 +303,7 @@ struct project_to_impl<0, ScaleDown, ResultScale> {
     coord_point<Point, Origin, ResultScale> operator()(
         const coord_point<Point, Origin, SourceScale> &src ) {
         return coord_point<Point, Origin, ResultScale>(
-                   divide_xy_round_to_minus_infinity( src.raw(), ScaleDown ) );
+                   divide_xy_round_to_minus_infinity<ScaleDown>( src.raw() ) );
     }
 };
 
@@ -398,7 +398,7 @@ inline quotient_remainder_point<Origin, ResultScale, SourceScale> project_remain
     static_assert( ScaleDown > 0, "You can only project to coarser coordinate systems" );
     constexpr static origin RemainderOrigin = origin_from_scale( ResultScale );
     coord_point<point, Origin, ResultScale> quotient(
-        divide_xy_round_to_minus_infinity( src.raw(), ScaleDown ) );
+        divide_xy_round_to_minus_infinity<ScaleDown>( src.raw() ) );
     coord_point<point, RemainderOrigin, SourceScale> remainder(
         src.raw() - quotient.raw() * ScaleDown );
 
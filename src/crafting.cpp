@@ -556,15 +556,20 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     if( src_pos == tripoint_zero ) {
         inv_pos = pos();
     }
-    if( moves == crafting_cache.moves
-        && radius == crafting_cache.radius
-        && calendar::turn == crafting_cache.time
-        && inv_pos == crafting_cache.position ) {
-        return *crafting_cache.crafting_inventory;
-    }
-    crafting_cache.crafting_inventory->clear();
+    for( const crafting_cache_type &cached : crafting_cache ) {
+        if( moves == cached.moves
+            && radius == cached.radius
+            && calendar::turn == cached.time
+            && inv_pos == cached.position ) {
+            return *cached.crafting_inventory;
+        }
+    }
+    crafting_cache_type &cache = crafting_cache[crafting_cache_next];
+    crafting_cache_next = ( crafting_cache_next + 1 ) % crafting_cache.size();
+    inventory &crafting_inv = *cache.crafting_inventory;
+    crafting_inv.clear();
     if( radius >= 0 ) {
-        crafting_cache.crafting_inventory->form_from_map( inv_pos, radius, this, false, clear_path );
+        crafting_inv.form_from_map( inv_pos, radius, this, false, clear_path );
     }
 
     // TODO: Add a const overload of all_items_loc() that returns something like
@@ -574,32 +579,34 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
         if( !it->empty_container() ) {
             // is the non-empty container used for BOIL?
             if( !it->is_watertight_container() || it->get_raw_quality( qual_BOIL ) <= 0 ) {
-                *crafting_cache.crafting_inventory += item( it->typeId(), it->birthday() );
+                crafting_inv += item( it->typeId(), it->birthday() );
             }
             continue;
         }
-        crafting_cache.crafting_inventory->add_item( *it );
+        crafting_inv.add_item( *it );
     }
 
     for( const item *i : get_pseudo_items() ) {
-        *crafting_cache.crafting_inventory += *i;
+        crafting_inv += *i;
     }
 
     if( has_trait( trait_BURROW ) || has_trait( trait_BURROWLARGE ) ) {
-        *crafting_cache.crafting_inventory += item( "pickaxe", calendar::turn );
-        *crafting_cache.crafting_inventory += item( "shovel", calendar::turn );
+        crafting_inv += item( "pickaxe", calendar::turn );
+        crafting_inv += item( "shovel", calendar::turn );
     }
 
-    crafting_cache.moves = moves;
-    crafting_cache.time = calendar::turn;
-    crafting_cache.position = inv_pos;
-    crafting_cache.radius = radius;
-    return *crafting_cache.crafting_inventory;
+    cache.moves = moves;
+    cache.time = calendar::turn;
+    cache.position = inv_pos;
+    cache.radius = radius;
+    return crafting_inv;
 }
 
 void Character::invalidate_crafting_inventory()
 {
-    crafting_cache.time = calendar::before_time_starts;
+    for( crafting_cache_type &cached : crafting_cache ) {
+        cached.time = calendar::before_time_starts;
+    }
 }
 
 void Character::make_craft( const recipe_id &id_to_make, int batch_size,
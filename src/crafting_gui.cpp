@@ -161,19 +161,23 @@ struct availability {
         Character &player = get_player_character();
         const inventory &inv = player.crafting_inventory();
         auto all_items_filter = r->get_component_filter( recipe_filter_flags::none );
-        auto no_rotten_filter = r->get_component_filter( recipe_filter_flags::no_rotten );
         const deduped_requirement_data &req = r->deduped_requirements();
         has_all_skills = r->skill_used.is_null() ||
                          player.get_skill_level( r->skill_used ) >= r->get_difficulty( player );
         has_proficiencies = r->character_has_required_proficiencies( player );
-        can_craft = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
+        // Each inventory check below is only made when its result can be shown:
+        // would_use_rotten only matters for craftable recipes, apparently_craftable only for
+        // the others, and neither needs looking at when the character can't attempt the recipe.
+        const bool can_attempt = ( !r->is_practice() || has_all_skills ) && has_proficiencies;
+        can_craft = can_attempt &&
                     req.can_make_with_inventory( inv, all_items_filter, batch_size, craft_flags::start_only );
-        would_use_rotten = !req.can_make_with_inventory( inv, no_rotten_filter, batch_size,
-                           craft_flags::start_only );
+        would_use_rotten = can_craft &&
+                           !req.can_make_with_inventory( inv, r->get_component_filter( recipe_filter_flags::no_rotten ),
+                                   batch_size, craft_flags::start_only );
         would_not_benefit = r->is_practice() && cannot_gain_skill_or_prof( player, *r );
-        const requirement_data &simple_req = r->simple_requirements();
-        apparently_craftable = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
-                               simple_req.can_make_with_inventory( inv, all_items_filter, batch_size, craft_flags::start_only );
+        apparently_craftable = can_attempt && ( can_craft ||
+                                                r->simple_requirements().can_make_with_inventory( inv, all_items_filter, batch_size,
+                                                        craft_flags::start_only ) );
         proficiency_time_maluses = r->proficiency_time_maluses( player );
         proficiency_failure_maluses = r->proficiency_failure_maluses( player );
         for( const std::pair<const skill_id, int> &e : r->required_skills ) {
@@ -55,6 +55,7 @@ extern "C" {
         // reasons, including the memory allocations and the SDL message box.
         // But it should usually work in practice, unless for example the
         // program segfaults inside malloc.
+        flushDebugLog();
 #if defined(_WIN32)
         dump_to( ".core" );
 #endif
@@ -413,17 +413,17 @@ bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
     }
 
     map &here = get_map();
-    const int range_cur = sight_range( here.ambient_light_at( t ) );
+    const float light_at_t = here.ambient_light_at( t );
+    const int range_cur = sight_range( light_at_t );
     const int range_day = sight_range( default_daylight_level() );
     const int range_night = sight_range( 0 );
     const int range_max = std::max( range_day, range_night );
     const int range_min = std::min( range_cur, range_max );
     const int wanted_range = rl_dist( pos(), t );
-    if( wanted_range <= range_min ||
-        ( wanted_range <= range_max &&
-          here.ambient_light_at( t ) > here.get_cache_ref( t.z ).natural_light_level_cache ) ) {
+    const bool lit_artificially = light_at_t > here.get_cache_ref( t.z ).natural_light_level_cache;
+    if( wanted_range <= range_min || ( wanted_range <= range_max && lit_artificially ) ) {
         int range = 0;
-        if( here.ambient_light_at( t ) > here.get_cache_ref( t.z ).natural_light_level_cache ) {
+        if( lit_artificially ) {
             range = MAX_VIEW_DISTANCE;
         } else {
             range = range_min;
@@ -1571,17 +1571,21 @@ bool Creature::has_effect( const efftype_id &eff_id ) const
 
 bool Creature::has_effect_with_flag( const flag_id &flag, const bodypart_id &bp ) const
 {
-    return std::any_of( effects->begin(), effects->end(), [&]( const auto & elem ) {
-        // effect::has_flag currently delegates to effect_type::has_flag
-        return elem.first->has_flag( flag ) && elem.second.count( bp );
-    } );
+    for( const auto &elem : *effects ) {
+        const auto found = elem.second.find( bp );
+        // The effect holds its type, so checking the flag does not look the type id up.
+        if( found != elem.second.end() && found->second.has_flag( flag ) ) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool Creature::has_effect_with_flag( const flag_id &flag ) const
 {
+    // Every effect of a type has the same flags, so the first one of each is enough to check.
     return std::any_of( effects->begin(), effects->end(), [&]( const auto & elem ) {
-        // effect::has_flag currently delegates to effect_type::has_flag
-        return elem.first->has_flag( flag );
+        return !elem.second.empty() && elem.second.begin()->second.has_flag( flag );
     } );
 }
 
@@ -1589,7 +1593,7 @@ std::vector<effect> Creature::get_effects_with_flag( const flag_id &flag ) const
 {
     std::vector<effect> effs;
     for( auto &elem : *effects ) {
-        if( !elem.first->has_flag( flag ) ) {
+        if( elem.second.empty() || !elem.second.begin()->second.has_flag( flag ) ) {
             continue;
         }
         for( const std::pair<const bodypart_id, effect> &_it : elem.second ) {
@@ -1892,6 +1896,7 @@ const std::map<bodypart_str_id, bodypart> &Creature::get_body() const
 void Creature::set_body()
 {
     body.clear();
+    body_index.parts.clear();
     for( const bodypart_id &bp : get_anatomy()->get_bodyparts() ) {
         body.emplace( bp.id(), bodypart( bp.id() ) );
     }
@@ -1920,29 +1925,38 @@ void Creature::calc_all_parts_hp( float hp_mod, float hp_adjustment, int str_max
     }
 }
 
+const bodypart *Creature::find_part( const bodypart_id &id ) const
+{
+    std::vector<const bodypart *> &parts = body_index.parts;
+    if( parts.empty() && !body.empty() ) {
+        parts.resize( body_part_type::get_all().size(), nullptr );
+        for( const std::pair<const bodypart_str_id, bodypart> &part : body ) {
+            if( part.first.is_valid() ) {
+                parts[bodypart_id( part.first ).to_i()] = &part.second;
+            }
+        }
+    }
+    const int index = id.to_i();
+    return index >= 0 && index < static_cast<int>( parts.size() ) ? parts[index] : nullptr;
+}
+
 bool Creature::has_part( const bodypart_id &id ) const
 {
-    return body.count( id.id() );
+    return find_part( id ) != nullptr;
 }
 
 bodypart *Creature::get_part( const bodypart_id &id )
 {
-    auto found = body.find( id.id() );
-    if( found == body.end() ) {
-        debugmsg( "Could not find bodypart %s in %s's body", id.id().c_str(), get_name() );
-        return nullptr;
-    }
-    return &found->second;
+    return const_cast<bodypart *>( const_cast<const Creature *>( this )->get_part( id ) );
 }
 
 const bodypart *Creature::get_part( const bodypart_id &id ) const
 {
-    auto found = body.find( id.id() );
-    if( found == body.end() ) {
+    const bodypart *part = find_part( id );
+    if( part == nullptr ) {
         debugmsg( "Could not find bodypart %s in %s's body", id.id().c_str(), get_name() );
-        return nullptr;
     }
-    return &found->second;
+    return part;
 }
 
 template<typename T>
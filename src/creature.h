@@ -236,6 +236,22 @@ using terminating_effect = struct terminating_effect_t {
     bodypart_id bp;
 };
 
+// The parts of Creature::body by bodypart_id::to_i(), so that getting a part does not walk the
+// map. The pointers are into the body of one creature, so a copy starts out empty and is
+// filled again by the creature it belongs to.
+class bodypart_index
+{
+    public:
+        bodypart_index() = default;
+        bodypart_index( const bodypart_index & ) {}
+        bodypart_index &operator=( const bodypart_index & ) {
+            parts.clear();
+            return *this;
+        }
+
+        std::vector<const bodypart *> parts;
+};
+
 class Creature : public viewer
 {
     public:
@@ -722,6 +738,9 @@ class Creature : public viewer
         anatomy_id creature_anatomy = anatomy_id( "default_anatomy" );
         /**this is the actual body of the creature*/
         std::map<bodypart_str_id, bodypart> body;
+        /** Must be emptied whenever parts are added to or removed from body. */
+        mutable bodypart_index body_index;
+        const bodypart *find_part( const bodypart_id &id ) const;
     public:
         anatomy_id get_anatomy() const;
         void set_anatomy( const anatomy_id &anat );
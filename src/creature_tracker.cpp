@@ -1,12 +1,16 @@
 #include "creature_tracker.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <ostream>
 #include <utility>
 
 #include "avatar.h"
 #include "cata_assert.h"
+#include "creature.h"
 #include "debug.h"
+#include "line.h"
 #include "map.h"
 #include "mongroup.h"
 #include "monster.h"
@@ -90,7 +94,7 @@ bool creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.get_location()] = critter_ptr;
+    place_in_location_map( critter.get_location(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -139,8 +143,8 @@ bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( old_pos );
-        monsters_by_location[new_pos] = *iter;
+        erase_from_location_map( old_pos );
+        place_in_location_map( new_pos, *iter );
         return true;
     } else {
         // We're changing the x/y/z coordinates of a zombie that hasn't been added
@@ -157,7 +161,7 @@ void creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.get_location() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_from_location_map( pos_iter->first );
         return;
     }
 
@@ -168,10 +172,48 @@ void creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_from_location_map( iter->first );
     }
 }
 
+void creature_tracker::place_in_location_map( const tripoint_abs_ms &pos,
+        const shared_ptr_fast<monster> &critter )
+{
+    erase_from_location_map( pos );
+    note_change();
+    monsters_by_location[pos] = critter;
+    monsters_by_submap[project_to<coords::sm>( pos )].push_back( critter.get() );
+}
+
+void creature_tracker::erase_from_location_map( const tripoint_abs_ms &pos )
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter == monsters_by_location.end() ) {
+        return;
+    }
+    note_change();
+    const auto bucket_iter = monsters_by_submap.find( project_to<coords::sm>( pos ) );
+    if( bucket_iter != monsters_by_submap.end() ) {
+        std::vector<monster *> &bucket = bucket_iter->second;
+        const auto found = std::find( bucket.begin(), bucket.end(), iter->second.get() );
+        if( found != bucket.end() ) {
+            *found = bucket.back();
+            bucket.pop_back();
+        }
+        if( bucket.empty() ) {
+            monsters_by_submap.erase( bucket_iter );
+        }
+    }
+    monsters_by_location.erase( iter );
+}
+
+void creature_tracker::clear_location_map()
+{
+    monsters_by_location.clear();
+    monsters_by_submap.clear();
+    note_change();
+}
+
 void creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -201,17 +243,17 @@ void creature_tracker::remove( const monster &critter )
 void creature_tracker::clear()
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_location_map();
     monster_faction_map_.clear();
     removed_.clear();
 }
 
 void creature_tracker::rebuild_cache()
 {
-    monsters_by_location.clear();
+    clear_location_map();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->get_location()] = mon_ptr;
+        place_in_location_map( mon_ptr->get_location(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -230,14 +272,14 @@ void creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
     }
+    erase_from_location_map( first.get_location() );
+    erase_from_location_map( second.get_location() );
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
     const tripoint_abs_ms temp = second.get_location();
@@ -246,18 +288,98 @@ void creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.get_location()] = first_ptr;
+        place_in_location_map( first.get_location(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.get_location()] = second_ptr;
+        place_in_location_map( second.get_location(), second_ptr );
+    }
+}
+
+void creature_tracker::for_each_in_radius( const tripoint_abs_ms &center, const int radius,
+        const int radiusz, const std::function<void( Creature & )> &fn,
+        const bool allow_hallucination ) const
+{
+    const auto in_box = [&]( const tripoint_abs_ms & p ) {
+        const tripoint d = ( p - center ).raw();
+        return std::abs( d.x ) <= radius && std::abs( d.y ) <= radius && std::abs( d.z ) <= radiusz;
+    };
+
+    const tripoint_abs_ms corner_min = center - tripoint( radius, radius, radiusz );
+    const tripoint_abs_ms corner_max = center + tripoint( radius, radius, radiusz );
+    const tripoint_abs_sm sm_min = project_to<coords::sm>( corner_min );
+    const tripoint_abs_sm sm_max = project_to<coords::sm>( corner_max );
+    const int64_t submaps = static_cast<int64_t>( sm_max.x() - sm_min.x() + 1 ) *
+                            ( sm_max.y() - sm_min.y() + 1 ) * ( sm_max.z() - sm_min.z() + 1 );
+    const auto visit = [&]( monster * critter ) {
+        if( !critter->is_dead() && ( allow_hallucination || !critter->is_hallucination() ) &&
+            in_box( critter->get_location() ) ) {
+            fn( *critter );
+        }
+    };
+    if( submaps > static_cast<int64_t>( monsters_by_submap.size() ) ) {
+        // A huge box, most of its submaps are empty; walking the buckets is cheaper.
+        for( const auto &bucket : monsters_by_submap ) {
+            for( monster *critter : bucket.second ) {
+                visit( critter );
+            }
+        }
+    } else {
+        for( int z = sm_min.z(); z <= sm_max.z(); ++z ) {
+            for( int x = sm_min.x(); x <= sm_max.x(); ++x ) {
+                for( int y = sm_min.y(); y <= sm_max.y(); ++y ) {
+                    const auto bucket = monsters_by_submap.find( tripoint_abs_sm( x, y, z ) );
+                    if( bucket == monsters_by_submap.end() ) {
+                        continue;
+                    }
+                    for( monster *critter : bucket->second ) {
+                        visit( critter );
+                    }
+                }
+            }
+        }
+    }
+
+    avatar &you = get_avatar();
+    if( in_box( you.get_location() ) ) {
+        fn( you );
+    }
+    for( const shared_ptr_fast<npc> &guy : active_npc ) {
+        if( !guy->is_dead() && in_box( guy->get_location() ) ) {
+            fn( *guy );
+        }
     }
 }
 
+Creature *creature_tracker::nearest_hostile( const Creature &from, const int radius ) const
+{
+    const tripoint_abs_ms origin = from.get_location();
+    Creature *nearest = nullptr;
+    int nearest_dist = radius + 1;
+    for_each_in_radius( origin, radius, 0, [&]( Creature & critter ) {
+        if( &critter == &from || from.attitude_to( critter ) != Creature::Attitude::HOSTILE ) {
+            return;
+        }
+        const int dist = rl_dist( origin, critter.get_location() );
+        if( dist < nearest_dist ) {
+            nearest = &critter;
+            nearest_dist = dist;
+        }
+    } );
+    return nearest;
+}
+
 bool creature_tracker::kill_marked_for_death()
 {
     // Important: `Creature::die` must not be called after creature objects (NPCs, monsters) have
     // been removed, the dying creature could still have a pointer (the killer) to another creature.
     bool monster_is_dead = false;
+    const auto is_dead = []( const shared_ptr_fast<monster> &mon_ptr ) {
+        return mon_ptr->is_dead();
+    };
+    // Usually nothing is dying, don't copy the list for nothing.
+    if( std::none_of( monsters_list.begin(), monsters_list.end(), is_dead ) ) {
+        return false;
+    }
     // Copy the list so we can iterate the copy safely *and* add new monsters from within monster::die
     // This happens for example with blob monsters (they split into two smaller monsters).
     const auto copy = monsters_list;
@@ -280,15 +402,20 @@ bool creature_tracker::kill_marked_for_death()
 void creature_tracker::remove_dead()
 {
     // Can't use game::all_monsters() as it would not contain *dead* monsters.
-    for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ) {
+    // Compact in one pass, keeping the order (temporary ids are indices into the list).
+    auto kept = monsters_list.begin();
+    for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ++iter ) {
         const monster &critter = **iter;
         if( critter.is_dead() ) {
             remove_from_location_map( critter );
-            iter = monsters_list.erase( iter );
         } else {
-            ++iter;
+            if( kept != iter ) {
+                *kept = std::move( *iter );
+            }
+            ++kept;
         }
     }
+    monsters_list.erase( kept, monsters_list.end() );
 
     removed_.clear();
 }
@@ -3,6 +3,7 @@
 #define CATA_SRC_CREATURE_TRACKER_H
 
 #include <cstddef>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -82,6 +83,7 @@ class creature_tracker
         void clear();
         void clear_npcs() {
             active_npc.clear();
+            note_change();
         }
         /** Swaps the positions of two monsters */
         void swap_positions( monster &first, monster &second );
@@ -109,6 +111,36 @@ class creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Calls @p fn for every living creature at most @p radius tiles away horizontally and
+         * @p radiusz z-levels away from @p center (a box, like @ref map::points_in_radius).
+         * Monsters come from the submaps overlapping the box rather than from the whole list,
+         * followed by the avatar and the active NPCs.
+         * @p fn must not add, remove or move monsters.
+         * @param allow_hallucination Whether to visit monsters that are actually hallucinations.
+         */
+        void for_each_in_radius( const tripoint_abs_ms &center, int radius, int radiusz,
+                                 const std::function<void( Creature & )> &fn,
+                                 bool allow_hallucination = false ) const;
+        /**
+         * Returns the closest creature on the z-level of @p from, within @p radius tiles,
+         * that @p from is hostile to, or nullptr if there is none.
+         */
+        Creature *nearest_hostile( const Creature &from, int radius ) const;
+
+        /**
+         * Counts changes to the tracked creatures: monsters added, removed or moved, and
+         * whatever else callers report through @ref note_change (NPCs coming and going or
+         * moving, a turn of the world being processed). Results computed from the tracked
+         * creatures can be reused for as long as this stays the same.
+         */
+        int change_count() const {
+            return changes;
+        }
+        void note_change() {
+            ++changes;
+        }
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
@@ -118,10 +150,21 @@ class creature_tracker
 
     private:
         std::list<shared_ptr_fast<npc>> active_npc; // NOLINT(cata-serialize)
+        int changes = 0; // NOLINT(cata-serialize)
         std::vector<shared_ptr_fast<monster>> monsters_list;
         void rebuild_cache();
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * The monsters of @ref monsters_by_location, bucketed by the submap they are in, for
+         * @ref for_each_in_radius. Kept in step with @ref monsters_by_location by the two
+         * functions below, which is why nothing else should write to either.
+         */
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<tripoint_abs_sm, std::vector<monster *>> monsters_by_submap;
+        void place_in_location_map( const tripoint_abs_ms &pos, const shared_ptr_fast<monster> &critter );
+        void erase_from_location_map( const tripoint_abs_ms &pos );
+        void clear_location_map();
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
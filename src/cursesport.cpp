@@ -220,7 +220,7 @@ void catacurses::wredrawln( const window &/*win*/, int /*beg_line*/, int /*num_l
 
 // Get a sequence of Unicode code points, store them in target
 // return the display width of the extracted string.
-static inline int fill( const char *&fmt, int &len, std::string &target )
+static inline int fill( const char *&fmt, int &len, cata_cursesport::cell_text &target )
 {
     const char *const start = fmt;
     int dlen = 0; // display width
@@ -252,7 +252,7 @@ static inline int fill( const char *&fmt, int &len, std::string &target )
         dlen += cw;
     }
     target.assign( start, fmt - start );
-    len -= target.length();
+    len -= fmt - start;
     return dlen;
 }
 
@@ -289,7 +289,7 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
     }
     if( win->cursor.x > 0 && win->line[win->cursor.y].chars[win->cursor.x].ch.empty() ) {
         // start inside a wide character, erase it for good
-        win->line[win->cursor.y].chars[win->cursor.x - 1].ch.assign( " " );
+        win->line[win->cursor.y].chars[win->cursor.x - 1].ch.assign( " ", 1 );
     }
     while( len > 0 ) {
         if( *fmt == '\n' ) {
@@ -315,7 +315,7 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
             // following cell ~> clear it
             cursecell *seccell = cur_cell( win );
             if( seccell && seccell->ch.empty() ) {
-                seccell->ch.assign( ' ', 1 );
+                seccell->ch.assign( " ", 1 );
             }
         } else if( dlen == 2 ) {
             // the second cell, per definition must be empty
@@ -324,12 +324,12 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
                 // the previous cell was valid, this one is outside of the window
                 // --> the previous was the last cell of the last line
                 // --> there should not be a two-cell width character in the last cell
-                curcell->ch.assign( ' ', 1 );
+                curcell->ch.assign( " ", 1 );
                 return;
             }
             seccell->FG = win->FG;
             seccell->BG = win->BG;
-            seccell->ch.erase();
+            seccell->ch.clear();
             addedchar( win );
             // Have just written a wide-character into the last cell, it would not
             // display correctly if it was the last *cell* of a line
@@ -337,12 +337,12 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
                 // So make that last cell a space, move the width
                 // character in the first cell of the line
                 seccell->ch = curcell->ch;
-                curcell->ch.assign( 1, ' ' );
+                curcell->ch.assign( " ", 1 );
                 // and make the second cell on the new line empty.
                 addedchar( win );
                 cursecell *thicell = cur_cell( win );
                 if( thicell != nullptr ) {
-                    thicell->ch.erase();
+                    thicell->ch.clear();
                 }
             }
         }
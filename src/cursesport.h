@@ -5,7 +5,9 @@
 #include <utility>
 #if defined(TILES) || defined(_WIN32)
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -33,13 +35,70 @@ struct pairs {
     base_color BG;
 };
 
+/**
+ * The UTF-8 text of a cell, stored inline: a character and whatever combining characters
+ * follow it, as far as they fit.  An empty text is the second cell of a wide character.
+ */
+class cell_text
+{
+    public:
+        static constexpr size_t capacity = 11;
+
+        cell_text() = default;
+        explicit cell_text( const std::string &text ) {
+            assign( text.data(), text.size() );
+        }
+
+        /** Stores the first n bytes of text, cut after the last whole code point that fits. */
+        void assign( const char *text, size_t n ) {
+            if( n > capacity ) {
+                n = capacity;
+                // Back up to the first byte of the code point that does not fit.
+                while( n > 0 && ( static_cast<unsigned char>( text[n] ) & 0xC0 ) == 0x80 ) {
+                    --n;
+                }
+            }
+            std::copy( text, text + n, bytes.begin() );
+            length = static_cast<unsigned char>( n );
+        }
+        void clear() {
+            length = 0;
+        }
+
+        bool empty() const {
+            return length == 0;
+        }
+        size_t size() const {
+            return length;
+        }
+        const char *data() const {
+            return bytes.data();
+        }
+        std::string str() const {
+            return std::string( bytes.data(), length );
+        }
+
+        bool operator==( const cell_text &b ) const {
+            return length == b.length && std::equal( bytes.begin(), bytes.begin() + length,
+                    b.bytes.begin() );
+        }
+        bool operator==( const char *b ) const {
+            return std::strlen( b ) == length &&
+                   std::equal( bytes.begin(), bytes.begin() + length, b );
+        }
+
+    private:
+        std::array<char, capacity> bytes = {};
+        unsigned char length = 0;
+};
+
 //Individual lines, so that we can track changed lines
 struct cursecell {
-    std::string ch;
+    cell_text ch;
     base_color FG = static_cast<base_color>( 0 );
     base_color BG = static_cast<base_color>( 0 );
 
-    explicit cursecell( std::string ch ) : ch( std::move( ch ) ) { }
+    explicit cursecell( const std::string &ch ) : ch( ch ) { }
     cursecell() : cursecell( std::string( 1, ' ' ) ) { }
 
     bool operator==( const cursecell &b ) const {
@@ -6,7 +6,9 @@
 // IWYU pragma: no_include <sys/unistd.h>
 #include <clocale>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -16,11 +18,13 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <regex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -428,6 +432,39 @@ struct repetition_folder {
 static repetition_folder rep_folder;
 static void output_repetitions( std::ostream &out );
 
+// Messages from one call site beyond a number a second are only counted, so a mod that keeps
+// failing the same check with changing values cannot flood the log.  The identical ones are
+// already folded by rep_folder.
+struct call_site_limiter {
+    static constexpr int max_per_second = 50;
+
+    struct site {
+        time_t second = 0;
+        int count = 0;
+        int suppressed = 0;
+    };
+    std::map<std::pair<const char *, const char *>, site> sites;
+
+    bool allow( const char *filename, const char *line ) {
+        site &s = sites[ { filename, line } ];
+        const time_t now = time( nullptr );
+        if( now != s.second ) {
+            if( s.suppressed > 0 ) {
+                DebugLog( D_ERROR, D_MAIN ) << "[ " << s.suppressed << " more messages from " <<
+                                            filename << ":" << line << " were not logged ]";
+            }
+            s = site{ now, 0, 0 };
+        }
+        if( ++s.count > max_per_second ) {
+            ++s.suppressed;
+            return false;
+        }
+        return true;
+    }
+};
+
+static call_site_limiter site_limiter;
+
 void realDebugmsg( const char *filename, const char *line, const char *funcname,
                    const std::string &text )
 {
@@ -440,9 +477,11 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     } else {
 
         if( !rep_folder.test( filename, line, funcname, text ) ) {
-            DebugLog( D_ERROR, D_MAIN ) << filename << ":" << line << " [" << funcname << "] " << text <<
-                                        std::flush;
-            rep_folder.set( filename, line, funcname, text );
+            if( site_limiter.allow( filename, line ) ) {
+                DebugLog( D_ERROR, D_MAIN ) << filename << ":" << line << " [" << funcname << "] "
+                                            << text << std::flush;
+                rep_folder.set( filename, line, funcname, text );
+            }
         } else {
             rep_folder.increment_count();
         }
@@ -543,6 +582,116 @@ static time_info get_time() noexcept
 }
 #endif
 
+// Keeps what is written to the log file in memory and has a thread write it to the file, so
+// the game does not wait for the disk however much is logged.  Flushing the stream only wakes
+// the writer.  If the writer cannot keep up, text beyond max_pending is dropped and the
+// amount noted in the log.
+class async_log_buf : public std::streambuf
+{
+    public:
+        explicit async_log_buf( std::unique_ptr<std::ostream> target ) :
+            target( std::move( target ) ) {
+            writer = std::thread( [this]() {
+                write_loop();
+            } );
+        }
+        ~async_log_buf() override {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            wake.notify_one();
+            writer.join();
+        }
+
+        async_log_buf( const async_log_buf & ) = delete;
+        async_log_buf &operator=( const async_log_buf & ) = delete;
+
+        // Writes what is pending from the calling thread, for when the game is about to die.
+        // Gives up if the log is busy, as this may run in a signal handler.
+        void write_now() {
+            std::unique_lock<std::mutex> lock( mutex, std::try_to_lock );
+            if( lock.owns_lock() ) {
+                write_pending( lock );
+            }
+        }
+
+    protected:
+        int overflow( int c ) override {
+            if( c != traits_type::eof() ) {
+                const char ch = traits_type::to_char_type( c );
+                xsputn( &ch, 1 );
+            }
+            return traits_type::not_eof( c );
+        }
+        std::streamsize xsputn( const char *s, std::streamsize n ) override {
+            std::lock_guard<std::mutex> lock( mutex );
+            if( pending.size() + n > max_pending ) {
+                dropped += n;
+            } else {
+                pending.append( s, n );
+            }
+            return n;
+        }
+        int sync() override {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                flush_requested = true;
+            }
+            wake.notify_one();
+            return 0;
+        }
+
+    private:
+        static constexpr size_t max_pending = 4 * 1024 * 1024;
+
+        void write_loop() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( !stopping ) {
+                wake.wait_for( lock, std::chrono::milliseconds( 500 ), [this]() {
+                    return stopping || flush_requested;
+                } );
+                write_pending( lock );
+            }
+            write_pending( lock );
+        }
+        // The file is written with the lock released, so logging goes on meanwhile.
+        void write_pending( std::unique_lock<std::mutex> &lock ) {
+            flush_requested = false;
+            if( pending.empty() && dropped == 0 ) {
+                return;
+            }
+            std::string text;
+            text.swap( pending );
+            const size_t dropped_now = dropped;
+            dropped = 0;
+            lock.unlock();
+            *target << text;
+            if( dropped_now > 0 ) {
+                *target << "\n[ " << dropped_now << " bytes of log were dropped ]";
+            }
+            target->flush();
+            lock.lock();
+        }
+
+        std::unique_ptr<std::ostream> target;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::string pending;
+        size_t dropped = 0;
+        bool flush_requested = false;
+        bool stopping = false;
+        std::thread writer;
+};
+
+struct async_log_stream : public std::ostream {
+    explicit async_log_stream( std::unique_ptr<std::ostream> target ) : std::ostream( nullptr ),
+        buf( std::move( target ) ) {
+        rdbuf( &buf );
+    }
+    async_log_buf buf;
+};
+
 struct DebugFile {
     DebugFile();
     ~DebugFile();
@@ -616,8 +765,8 @@ void DebugFile::init( DebugOutput output_mode, const std::string &filename )
                     rename_failed = !rename_file( filename, oldfile );
                 }
             }
-            file = std::make_shared<cata::ofstream>(
-                       fs::u8path( filename ), std::ios::out | std::ios::app );
+            file = std::make_shared<async_log_stream>( std::make_unique<cata::ofstream>(
+                       fs::u8path( filename ), std::ios::out | std::ios::app ) );
             *file << "\n\n-----------------------------------------\n";
             *file << get_time() << " : Starting log.";
             DebugLog( D_INFO, D_MAIN ) << "Cataclysm DDA version " << getVersionString();
@@ -695,6 +844,14 @@ void deinitDebug()
     debugFile().deinit();
 }
 
+void flushDebugLog()
+{
+    async_log_stream *stream = dynamic_cast<async_log_stream *>( debugFile().file.get() );
+    if( stream ) {
+        stream->buf.write_now();
+    }
+}
+
 // OStream Operators                                                {{{2
 // ---------------------------------------------------------------------
 
@@ -1340,7 +1497,10 @@ std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
     }
 
     static NullBuf nullBuf;
+    // A stream in a failed state skips the formatting of what is written to it, so disabled
+    // levels and classes cost little more than the check above.
     static std::ostream nullStream( &nullBuf );
+    nullStream.setstate( std::ios::badbit );
     return nullStream;
 }
 
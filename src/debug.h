@@ -184,6 +184,8 @@ enum class DebugOutput : int {
 void setupDebug( DebugOutput );
 /** Opposite of setupDebug, shuts the debugging system down. */
 void deinitDebug();
+/** Writes out what is still waiting to be written to the log file, e.g. before a crash. */
+void flushDebugLog();
 
 // Function Declarations                                            {{{1
 // ---------------------------------------------------------------------
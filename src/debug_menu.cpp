@@ -69,6 +69,7 @@
 #include "mapgendata.h"
 #include "martialarts.h"
 #include "memory_fast.h"
+#include "memory_stats.h"
 #include "messages.h"
 #include "mission.h"
 #include "monster.h"
@@ -87,11 +88,13 @@
 #include "overmapbuffer.h"
 #include "path_info.h" // IWYU pragma: keep
 #include "panels.h"
+#include "perf_stats.h"
 #include "pimpl.h"
 #include "point.h"
 #include "popup.h"
 #include "recipe_dictionary.h"
 #include "rng.h"
+#include "save_stats.h"
 #include "sounds.h"
 #include "stomach.h"
 #include "string_formatter.h"
@@ -197,6 +200,9 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::TEST_WEATHER: return "TEST_WEATHER";
         case debug_menu::debug_menu_index::WRITE_GLOBAL_EOCS: return "WRITE_GLOBAL_EOCS";
         case debug_menu::debug_menu_index::WRITE_GLOBAL_VARS: return "WRITE_GLOBAL_VARS";
+        case debug_menu::debug_menu_index::PERF_STATS: return "PERF_STATS";
+        case debug_menu::debug_menu_index::SAVE_STATS: return "SAVE_STATS";
+        case debug_menu::debug_menu_index::MEMORY_STATS: return "MEMORY_STATS";
         case debug_menu::debug_menu_index::SAVE_SCREENSHOT: return "SAVE_SCREENSHOT";
         case debug_menu::debug_menu_index::GAME_REPORT: return "GAME_REPORT";
         case debug_menu::debug_menu_index::DISPLAY_SCENTS_LOCAL: return "DISPLAY_SCENTS_LOCAL";
@@ -309,6 +315,9 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( debug_menu_index::BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
             { uilist_entry( debug_menu_index::HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
+            { uilist_entry( debug_menu_index::PERF_STATS, true, 'P', _( "Show turn stage timings" ) ) },
+            { uilist_entry( debug_menu_index::SAVE_STATS, true, 'B', _( "Show last save breakdown" ) ) },
+            { uilist_entry( debug_menu_index::MEMORY_STATS, true, 'u', _( "Show memory usage" ) ) },
             { uilist_entry( debug_menu_index::TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( debug_menu_index::DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
             { uilist_entry( debug_menu_index::DISPLAY_NPC_ATTACK, true, 'A', _( "Toggle NPC attack potential values on map" ) ) },
@@ -2221,6 +2230,54 @@ static void debug_menu_spawn_vehicle()
     }
 }
 
+static void debug_menu_perf_stats()
+{
+    while( true ) {
+        uilist menu;
+        menu.text = perf_stats::summary_table();
+        menu.addentry( 0, true, 'c', perf_stats::csv_dump_enabled() ?
+                       _( "Stop writing per-turn timings to %s" ) :
+                       _( "Write per-turn timings to %s" ), perf_stats::csv_path() );
+        menu.addentry( 1, true, 'r', _( "Reset timings" ) );
+        menu.addentry( 2, true, 'h', _( "Write timing histograms to %s" ),
+                       perf_stats::histograms_path() );
+        menu.query();
+        if( menu.ret == 0 ) {
+            perf_stats::set_csv_dump( !perf_stats::csv_dump_enabled() );
+        } else if( menu.ret == 1 ) {
+            perf_stats::reset();
+        } else if( menu.ret == 2 ) {
+            if( perf_stats::write_histograms() ) {
+                popup( _( "Wrote %s" ), perf_stats::histograms_path() );
+            }
+        } else {
+            break;
+        }
+    }
+}
+
+static void debug_menu_save_stats()
+{
+    uilist menu;
+    menu.text = save_stats::summary_table();
+    menu.addentry( 0, true, 'w', _( "Write the report to %s" ), save_stats::report_path() );
+    menu.query();
+    if( menu.ret == 0 && save_stats::write_report() ) {
+        popup( _( "Wrote %s" ), save_stats::report_path() );
+    }
+}
+
+static void debug_menu_memory_stats()
+{
+    uilist menu;
+    menu.text = memory_stats::summary_table();
+    menu.addentry( 0, true, 'w', _( "Write the report to %s" ), memory_stats::report_path() );
+    menu.query();
+    if( menu.ret == 0 && memory_stats::write_report() ) {
+        popup( _( "Wrote %s" ), memory_stats::report_path() );
+    }
+}
+
 static void debug_menu_change_time()
 {
     auto set_turn = [&]( const int initial, const time_duration & factor, const char *const msg ) {
@@ -2299,6 +2356,9 @@ void debug()
         debug_menu_index::GAME_REPORT,
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::BENCHMARK,
+        debug_menu_index::PERF_STATS,
+        debug_menu_index::SAVE_STATS,
+        debug_menu_index::MEMORY_STATS,
         debug_menu_index::SHOW_MSG,
     };
     const bool should_disable_achievements = action && !is_debug_character() &&
@@ -2720,6 +2780,15 @@ void debug()
         case debug_menu_index::HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
+        case debug_menu_index::PERF_STATS:
+            debug_menu_perf_stats();
+            break;
+        case debug_menu_index::SAVE_STATS:
+            debug_menu_save_stats();
+            break;
+        case debug_menu_index::MEMORY_STATS:
+            debug_menu_memory_stats();
+            break;
         case debug_menu_index::CHANGE_TIME:
             debug_menu_change_time();
             break;
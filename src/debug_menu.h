@@ -92,6 +92,9 @@ enum class debug_menu_index : int {
     EDIT_CAMP_LARDER,
     WRITE_GLOBAL_EOCS,
     WRITE_GLOBAL_VARS,
+    PERF_STATS,
+    SAVE_STATS,
+    MEMORY_STATS,
     last
 };
 
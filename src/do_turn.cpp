@@ -1,10 +1,17 @@
 #include "do_turn.h"
 
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <utility>
+#include <vector>
+
 #include "action.h"
 #include "avatar.h"
 #include "bionics.h"
 #include "cached_options.h"
 #include "calendar.h"
+#include "coordinates.h"
 #include "creature_tracker.h"
 #include "event_bus.h"
 #include "explosion.h"
@@ -12,6 +19,7 @@
 #include "gamemode.h"
 #include "help.h"
 #include "kill_tracker.h"
+#include "line.h"
 #include "make_static.h"
 #include "map.h"
 #include "mapbuffer.h"
@@ -19,14 +27,20 @@
 #include "messages.h"
 #include "mission.h"
 #include "monattack.h"
+#include "monster.h"
 #include "mtype.h"
+#include "npc.h"
 #include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
+#include "pathfinding.h"
+#include "perf_stats.h"
 #include "popup.h"
 #include "scent_map.h"
 #include "string_input_popup.h"
+#include "thread_pool.h"
 #include "timed_event.h"
+#include "trace_zones.h"
 #include "ui_manager.h"
 #include "vehicle.h"
 #include "vpart_position.h"
@@ -270,6 +284,7 @@ bool cleanup_at_end()
                 std::chrono::steady_clock::now() - g->time_of_last_load );
         std::chrono::seconds total_time_played = g->time_played_at_last_load + time_since_load;
         get_event_bus().send<event_type::game_over>( is_suicide, sLastWords, total_time_played );
+        get_event_bus().process_deferred();
         // Struck the save_player_data here to forestall Weirdness
         g->move_save_to_graveyard();
         g->write_memorial_file( sLastWords );
@@ -399,11 +414,94 @@ void handle_key_blocking_activity()
 
 namespace
 {
+// Solves the routes monsters are already due to look for on the thread pool, before any of
+// them moves. Their moves then pick the routes up from map::route_shared in the usual order.
+void plan_monster_routes( map &m )
+{
+    if( get_thread_pool().worker_count() == 0 ) {
+        // The routes would be found one by one anyway, and some of them for nothing.
+        return;
+    }
+    std::vector<route_request> requests;
+    for( monster &critter : g->all_monsters() ) {
+        if( critter.is_dead() || critter.moves <= 0 || critter.has_effect( effect_controlled ) ||
+            !critter.needs_new_path() ) {
+            continue;
+        }
+        route_request request;
+        request.from = critter.pos();
+        request.to = m.getlocal( critter.get_dest() );
+        request.settings = critter.get_pathfinding_settings();
+        requests.push_back( request );
+    }
+    if( requests.size() > 1 ) {
+        m.route_batch( requests );
+    }
+}
+
+// Walks the lines of sight monster::plan is about to ask for on the thread pool, before any of
+// them moves. The plans then read them from the memo of map::sees. Lines of sight only depend on
+// the transparency cache, which holds still for the turn, so every plan comes out as it would have
+// with the lines walked one by one.
+void prefetch_monster_sight( map &m )
+{
+    if( get_thread_pool().worker_count() == 0 ) {
+        return;
+    }
+    const creature_tracker &creatures = get_creature_tracker();
+    std::vector<std::pair<tripoint, tripoint>> pairs;
+    for( monster &critter : g->all_monsters() ) {
+        if( critter.is_dead() || critter.moves <= 0 || critter.has_effect( effect_controlled ) ||
+            critter.has_effect( effect_ridden ) ) {
+            continue;
+        }
+        // Nobody further away can be rated as a target, see monster::plan.
+        const int range = critter.has_flag( MF_PRIORITIZE_TARGETS ) ? MAX_VIEW_DISTANCE :
+                          std::max( critter.type->vision_day, critter.type->vision_night );
+        const tripoint from = critter.pos();
+        creatures.for_each_in_radius( critter.get_location(), range, 0, [&]( Creature & other ) {
+            if( &other != &critter ) {
+                pairs.emplace_back( from, other.pos() );
+            }
+        } );
+    }
+    m.prefetch_sees( pairs );
+}
+
+// How many turns apart idle monsters act, see monster::skip_idle_turn. Nothing but the
+// characters can give an idle monster something to do that it has to react to at once, so the
+// further away the closest one is, the longer it may sit.
+int idle_update_period( const monster &critter, const std::vector<tripoint_abs_ms> &characters )
+{
+    int closest = INT_MAX;
+    for( const tripoint_abs_ms &p : characters ) {
+        closest = std::min( closest, rl_dist( critter.get_location(), p ) );
+    }
+    if( closest > 45 ) {
+        return 4;
+    } else if( closest > 30 ) {
+        return 2;
+    }
+    return 1;
+}
+
 void monmove()
 {
+    perf_timer timer( perf_stage::monmove );
+    CATA_TRACE_ZONE( "monmove" );
     g->cleanup_dead();
     map &m = get_map();
     avatar &u = get_avatar();
+    plan_monster_routes( m );
+    prefetch_monster_sight( m );
+
+    std::vector<tripoint_abs_ms> characters;
+    if( idle_monster_lod ) {
+        characters.push_back( u.get_location() );
+        for( const npc &guy : g->all_npcs() ) {
+            characters.push_back( guy.get_location() );
+        }
+    }
 
     for( monster &critter : g->all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
@@ -441,7 +539,10 @@ void monmove()
             critter.try_biosignature();
             critter.try_reproduce();
         }
-        while( critter.moves > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) ) {
+        const bool sits_out = idle_monster_lod && critter.skip_idle_turn( critter.is_idle() ?
+                              idle_update_period( critter, characters ) : 1 );
+        while( !sits_out && critter.moves > 0 && !critter.is_dead() &&
+               !critter.has_effect( effect_ridden ) ) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
             if( !critter.has_effect( effect_controlled ) ) {
@@ -549,6 +650,11 @@ void overmap_npc_move()
             travelling_npcs.push_back( npc_to_add );
         }
     }
+    // Only the NPCs that leave the map or arrive on it need the active NPCs to be reloaded.
+    // Those travelling far away from the avatar just move on the overmap.
+    const tripoint_abs_sm abs_sub( get_map().get_abs_sub() );
+    const half_open_rectangle<point_abs_sm> map_bounds( abs_sub.xy(), abs_sub.xy() + point( MAPSIZE,
+            MAPSIZE ) );
     bool npcs_need_reload = false;
     for( auto &elem : travelling_npcs ) {
         if( elem->has_omt_destination() ) {
@@ -567,8 +673,11 @@ void overmap_npc_move()
                     elem->goal = npc::no_goal_point;
                 }
             } else {
+                const bool was_active = elem->is_active();
                 elem->travel_overmap( elem->omt_path.back() );
-                npcs_need_reload = true;
+                if( was_active || map_bounds.contains( elem->global_sm_location().xy() ) ) {
+                    npcs_need_reload = true;
+                }
             }
         }
         if( !elem->has_omt_destination() && calendar::once_every( 1_hours ) && one_in( 3 ) ) {
@@ -587,9 +696,12 @@ void overmap_npc_move()
 // Returns true if game is over (death, saved, quit, etc)
 bool do_turn()
 {
+    CATA_TRACE_ZONE( "do_turn" );
     if( g->is_game_over() ) {
         return turn_handler::cleanup_at_end();
     }
+    // Time spent waiting for and handling player input is left out of the do_turn stage.
+    std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
     // Actual stuff
     if( g-> new_game ) {
         g->new_game = false;
@@ -600,7 +712,7 @@ bool do_turn()
 
     weather_manager &weather = get_weather();
     // starting a new turn, clear out temperature cache
-    weather.temperature_cache.clear();
+    weather.clear_temp_cache();
 
     if( g->npcs_dirty ) {
         g->load_npcs();
@@ -669,6 +781,7 @@ bool do_turn()
         sfx::do_hearing_loss();
     }
 
+    perf_stats::add_sample( perf_stage::do_turn, std::chrono::steady_clock::now() - stage_start );
     if( !u.has_effect( effect_sleep ) || g->uquit == QUIT_WATCH ) {
         if( u.moves > 0 || g->uquit == QUIT_WATCH ) {
             while( u.moves > 0 || g->uquit == QUIT_WATCH ) {
@@ -740,7 +853,14 @@ bool do_turn()
             }
 
         }
+    } else {
+        // Nobody is waiting on the screen while the avatar sleeps, so generate the overmaps
+        // around them now rather than when walking or a search first reaches one.
+        overmap_buffer.prepare_neighbor( project_to<coords::om>( u.global_omt_location().xy() ) );
     }
+    stage_start = std::chrono::steady_clock::now();
+    // A turn at a time, so the next map shift does not have to run all its mapgen at once.
+    m.generate_ahead();
 
     if( g->driving_view_offset.x != 0 || g->driving_view_offset.y != 0 ) {
         // Still have a view offset, but might not be driving anymore,
@@ -776,6 +896,8 @@ bool do_turn()
     // consider a stripped down cache just for monsters.
     m.build_map_cache( levz, true );
     monmove();
+    // The world has moved on, so has what the avatar sees.
+    get_creature_tracker().note_change();
     if( calendar::once_every( 5_minutes ) ) {
         overmap_npc_move();
     }
@@ -868,5 +990,10 @@ bool do_turn()
     // reset player noise
     u.volume = 0;
 
+    get_event_bus().process_deferred();
+
+    perf_stats::add_sample( perf_stage::do_turn, std::chrono::steady_clock::now() - stage_start );
+    perf_stats::end_turn();
+
     return false;
 }
@@ -1040,6 +1040,9 @@ std::vector<efftype_id> effect::get_blocks_effects() const
 
 int effect::get_mod( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->modded_args.count( arg ) ) {
+        return 0;
+    }
     const auto &mod_data = eff_type->mod_data;
     double min = 0;
     double max = 0;
@@ -1072,6 +1075,9 @@ int effect::get_mod( const std::string &arg, bool reduced ) const
 
 int effect::get_avg_mod( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->modded_args.count( arg ) ) {
+        return 0;
+    }
     const auto &mod_data = eff_type->mod_data;
     double min = 0;
     double max = 0;
@@ -1104,6 +1110,9 @@ int effect::get_avg_mod( const std::string &arg, bool reduced ) const
 
 int effect::get_amount( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->modded_args.count( arg ) ) {
+        return 0;
+    }
     const auto &mod_data = eff_type->mod_data;
     double ret = 0;
     auto found = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "amount" ) );
@@ -1512,6 +1521,9 @@ void load_effect_type( const JsonObject &jo )
 
     new_etype.load_mod_data( jo, "base_mods" );
     new_etype.load_mod_data( jo, "scaling_mods" );
+    for( const auto &entry : new_etype.mod_data ) {
+        new_etype.modded_args.insert( std::get<2>( entry.first ) );
+    }
 
     new_etype.impairs_movement = hardcoded_movement_impairing.count( new_etype.id ) > 0;
 
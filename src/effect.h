@@ -191,6 +191,9 @@ class effect_type
         /** Key tuple order is:("base_mods"/"scaling_mods", reduced: bool, type of mod: "STR", desired argument: "tick") */
         std::unordered_map <
         std::tuple<std::string, bool, std::string, std::string>, double, cata::tuple_hash > mod_data;
+        /** The types of mod ("STR", "SPEED", ...) that have any entry in mod_data, so that asking
+         * an effect for a mod it does not have skips the lookups of every key. */
+        std::set<std::string> modded_args;
         std::vector<vitamin_rate_effect> vitamin_data;
         std::vector<std::pair<int, int>> kill_chance;
         std::vector<std::pair<int, int>> red_kill_chance;
@@ -36,9 +36,15 @@ event_bus::~event_bus()
     }
 }
 
-void event_bus::subscribe( event_subscriber *s )
+void event_bus::subscribe( event_subscriber *s, const event_dispatch dispatch )
 {
     subscribers.push_back( s );
+    subscriber_lists &lists = dispatch == event_dispatch::deferred ? deferred : immediate;
+    for( size_t i = 0; i < lists.size(); ++i ) {
+        if( s->handles( static_cast<event_type>( i ) ) ) {
+            lists[i].push_back( s );
+        }
+    }
     s->on_subscribe( this );
 }
 
@@ -50,12 +56,37 @@ void event_bus::unsubscribe( event_subscriber *s )
     } else {
         ( *it )->on_unsubscribe( this );
         subscribers.erase( it );
+        for( subscriber_lists *lists : {
+                 &immediate, &deferred
+             } ) {
+            for( std::vector<event_subscriber *> &list : *lists ) {
+                list.erase( std::remove( list.begin(), list.end(), s ), list.end() );
+            }
+        }
     }
 }
 
-void event_bus::send( const cata::event &e ) const
+void event_bus::send( const cata::event &e )
 {
-    for( event_subscriber *s : subscribers ) {
+    const size_t type = static_cast<size_t>( e.type() );
+    if( !deferred[type].empty() ) {
+        deferred_events.push_back( e );
+    }
+    for( event_subscriber *s : immediate[type] ) {
         s->notify( e );
     }
 }
+
+void event_bus::process_deferred()
+{
+    // Deferred subscribers may send events of their own, which are handed on in another round.
+    while( !deferred_events.empty() ) {
+        std::vector<cata::event> events;
+        events.swap( deferred_events );
+        for( const cata::event &e : events ) {
+            for( event_subscriber *s : deferred[static_cast<size_t>( e.type() )] ) {
+                s->notify( e );
+            }
+        }
+    }
+}
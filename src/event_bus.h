@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_EVENT_BUS_H
 #define CATA_SRC_EVENT_BUS_H
 
+#include <array>
 #include <type_traits>
 #include <vector>
 
@@ -9,6 +10,15 @@
 
 class event_subscriber;
 
+/** When a subscriber gets the events sent to the bus. */
+enum class event_dispatch : int {
+    // Right away, from within send.
+    immediate,
+    // From @ref event_bus::process_deferred, once per turn. For subscribers that only record
+    // what happened, so that the events they get cost one copy instead of a call each.
+    deferred,
+};
+
 class event_bus
 {
     public:
@@ -16,16 +26,33 @@ class event_bus
         event_bus( const event_bus & ) = delete;
         event_bus &operator=( const event_bus & ) = delete;
         ~event_bus();
-        void subscribe( event_subscriber * );
+        /** Subscribes to the event types that the subscriber @ref event_subscriber::handles. */
+        void subscribe( event_subscriber *, event_dispatch = event_dispatch::immediate );
         void unsubscribe( event_subscriber * );
 
-        void send( const cata::event & ) const;
+        void send( const cata::event & );
         template<event_type Type, typename... Args>
-        void send( Args &&... args ) const {
+        void send( Args &&... args ) {
             send( cata::event::make<Type>( std::forward<Args>( args )... ) );
         }
+
+        /**
+         * Hands the events sent so far to the deferred subscribers, in the order they were
+         * sent.  Called at the end of every turn, and before anything reads what those
+         * subscribers recorded outside of a turn.
+         */
+        void process_deferred();
     private:
+        using subscriber_lists =
+            std::array<std::vector<event_subscriber *>,
+            static_cast<size_t>( event_type::num_event_types )>;
+
+        // Every subscriber, for unsubscribing them all.
         std::vector<event_subscriber *> subscribers;
+        // The subscribers that handle each event type.
+        subscriber_lists immediate;
+        subscriber_lists deferred;
+        std::vector<cata::event> deferred_events;
 };
 
 event_bus &get_event_bus();
@@ -517,9 +517,6 @@ struct event_transformation_impl : public event_transformation::impl {
             trans->source_->add_watcher( stats, this );
             for( const auto &p : trans->constraints_ ) {
                 if( p.second.equals_statistic_ ) {
-                    // TODO: we need a version of value_constraint that is
-                    // itself a watcher so that it can cache the statistic
-                    // value it cares about and not constantly recompute it.
                     stats.add_watcher( *p.second.equals_statistic_, this );
                 }
             }
@@ -544,6 +541,10 @@ struct event_transformation_impl : public event_transformation::impl {
             stats.transformed_set_changed( transformation_->id_, data_ );
         }
 
+        const event_multiset &get_events() const override {
+            return data_;
+        }
+
         const event_transformation_impl *transformation_;
         event_multiset data_;
     };
@@ -6,6 +6,7 @@ namespace cata
 class event;
 }  // namespace cata
 class event_bus;
+enum class event_type : int;
 
 class event_subscriber
 {
@@ -15,6 +16,13 @@ class event_subscriber
         event_subscriber &operator=( const event_subscriber & ) = delete;
         virtual ~event_subscriber();
         virtual void notify( const cata::event & ) = 0;
+        /**
+         * Whether @ref notify wants events of this type.  The bus asks once, when subscribing,
+         * so the answer must not change while subscribed.
+         */
+        virtual bool handles( event_type ) const {
+            return true;
+        }
     private:
         friend class event_bus;
         void on_subscribe( event_bus * );
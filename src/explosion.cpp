@@ -13,6 +13,8 @@
 #include <random>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -176,9 +178,9 @@ static void do_blast( const tripoint &p, const float power,
 
     std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp_first >
     open;
-    std::set<tripoint> closed;
-    std::set<tripoint> bashed{ p };
-    std::map<tripoint, float> dist_map;
+    std::unordered_set<tripoint> closed;
+    std::unordered_set<tripoint> bashed{ p };
+    std::unordered_map<tripoint, float> dist_map;
     open.push( std::make_pair( 0.0f, p ) );
     dist_map[p] = 0.0f;
     // Find all points to blast
@@ -252,16 +254,22 @@ static void do_blast( const tripoint &p, const float power,
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+            const auto known = dist_map.emplace( dest, next_dist );
+            if( known.second || known.first->second > next_dist ) {
                 open.push( std::make_pair( next_dist, dest ) );
-                dist_map[dest] = next_dist;
+                known.first->second = next_dist;
             }
         }
     }
 
+    // The hashed sets above are only for lookups; apply the blast in a stable order so
+    // the random rolls below fall the same way every time.
+    std::vector<tripoint> blasted( closed.begin(), closed.end() );
+    std::sort( blasted.begin(), blasted.end() );
+
     // Draw the explosion
     std::map<tripoint, nc_color> explosion_colors;
-    for( const tripoint &pt : closed ) {
+    for( const tripoint &pt : blasted ) {
         if( here.impassable( pt ) ) {
             continue;
         }
@@ -280,7 +288,7 @@ static void do_blast( const tripoint &p, const float power,
     draw_custom_explosion( get_player_character().pos(), explosion_colors );
 
     creature_tracker &creatures = get_creature_tracker();
-    for( const tripoint &pt : closed ) {
+    for( const tripoint &pt : blasted ) {
         const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
         if( force < 1.0f ) {
             // Too weak to matter
@@ -364,6 +372,21 @@ static void do_blast( const tripoint &p, const float power,
     }
 }
 
+namespace
+{
+struct shrapnel_caches {
+    fragment_cloud obstacle_cache[MAPSIZE_X][MAPSIZE_Y];
+    fragment_cloud visited_cache[MAPSIZE_X][MAPSIZE_Y];
+};
+} // namespace
+
+// Big enough that allocating and constructing it for every grenade shows up, so keep one.
+static shrapnel_caches &get_shrapnel_caches()
+{
+    static std::unique_ptr<shrapnel_caches> caches = std::make_unique<shrapnel_caches>();
+    return *caches;
+}
+
 static std::vector<tripoint> shrapnel( const tripoint &src, int power,
                                        int casing_mass, float per_fragment_mass, int range = -1 )
 {
@@ -381,14 +404,12 @@ static std::vector<tripoint> shrapnel( const tripoint &src, int power,
     proj.range = range;
     proj.proj_effects.insert( "NULL_SOURCE" );
 
-    struct local_caches {
-        fragment_cloud obstacle_cache[MAPSIZE_X][MAPSIZE_Y];
-        fragment_cloud visited_cache[MAPSIZE_X][MAPSIZE_Y];
-    };
-
-    std::unique_ptr<local_caches> caches = std::make_unique<local_caches>();
-    fragment_cloud( &obstacle_cache )[MAPSIZE_X][MAPSIZE_Y] = caches->obstacle_cache;
-    fragment_cloud( &visited_cache )[MAPSIZE_X][MAPSIZE_Y] = caches->visited_cache;
+    shrapnel_caches &caches = get_shrapnel_caches();
+    fragment_cloud( &obstacle_cache )[MAPSIZE_X][MAPSIZE_Y] = caches.obstacle_cache;
+    fragment_cloud( &visited_cache )[MAPSIZE_X][MAPSIZE_Y] = caches.visited_cache;
+    // The obstacle cache is rebuilt over the whole z-level below, but the cast only writes
+    // the squares it reaches, so clear what the last explosion left behind.
+    std::fill( &visited_cache[0][0], &visited_cache[0][0] + MAPSIZE_X * MAPSIZE_Y, fragment_cloud() );
 
     map &here = get_map();
     // TODO: Calculate range based on max effective range for projectiles.
@@ -565,10 +586,12 @@ void flashbang( const tripoint &p, bool player_immune )
                                              time_duration::from_turns( 10 - dist ) );
         }
     }
-    for( monster &critter : g->all_monsters() ) {
-        if( critter.type->in_species( species_ROBOT ) ) {
-            continue;
+    get_creature_tracker().for_each_in_radius( here.getglobal( p ), 8, 0, [&]( Creature & who ) {
+        monster *const mon = who.as_monster();
+        if( mon == nullptr || mon->type->in_species( species_ROBOT ) ) {
+            return;
         }
+        monster &critter = *mon;
         // TODO: can the following code be called for all types of creatures
         dist = rl_dist( critter.pos(), p );
         if( dist <= 8 ) {
@@ -582,7 +605,7 @@ void flashbang( const tripoint &p, bool player_immune )
                 critter.add_effect( effect_deaf, time_duration::from_turns( 60 - dist * 4 ) );
             }
         }
-    }
+    }, true );
     sounds::sound( p, 12, sounds::sound_t::combat, _( "a huge boom!" ), false, "misc", "flashbang" );
     // TODO: Blind/deafen NPC
 }
@@ -595,24 +618,17 @@ void shockwave( const tripoint &p, int radius, int force, int stun, int dam_mult
     sounds::sound( p, force * force * dam_mult / 2, sounds::sound_t::combat, _( "Crack!" ), false,
                    "misc", "shockwave" );
 
-    for( monster &critter : g->all_monsters() ) {
-        if( critter.posz() != p.z ) {
-            continue;
-        }
-        if( rl_dist( critter.pos(), p ) <= radius ) {
-            add_msg( _( "%s is caught in the shockwave!" ), critter.name() );
-            g->knockback( p, critter.pos(), force, stun, dam_mult );
-        }
-    }
-    // TODO: combine the two loops and the case for avatar using all_creatures()
-    for( npc &guy : g->all_npcs() ) {
-        if( guy.posz() != p.z ) {
-            continue;
-        }
-        if( rl_dist( guy.pos(), p ) <= radius ) {
-            add_msg( _( "%s is caught in the shockwave!" ), guy.get_name() );
-            g->knockback( p, guy.pos(), force, stun, dam_mult );
-        }
+    // Knockback moves creatures, so collect them before throwing any of them.
+    std::vector<Creature *> caught;
+    get_creature_tracker().for_each_in_radius( get_map().getglobal( p ), radius, 0,
+    [&]( Creature & critter ) {
+        if( !critter.is_avatar() && rl_dist( critter.pos(), p ) <= radius ) {
+            caught.push_back( &critter );
+        }
+    }, true );
+    for( Creature *critter : caught ) {
+        add_msg( _( "%s is caught in the shockwave!" ), critter->get_name() );
+        g->knockback( p, critter->pos(), force, stun, dam_mult );
     }
     Character &player_character = get_player_character();
     if( rl_dist( player_character.pos(), p ) <= radius && !ignore_player &&
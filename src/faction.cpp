@@ -557,7 +557,7 @@ int npc::faction_display( const catacurses::window &fac_w, const int width ) con
             }
             mission_string = _( "Current Mission: " ) + dest_string;
         } else {
-            npc_companion_mission c_mission = get_companion_mission();
+            const npc_companion_mission &c_mission = get_companion_mission();
             mission_string = _( "Current Mission: " ) +
                              get_mission_action_string( c_mission.mission_id );
         }
@@ -1751,7 +1751,7 @@ void basecamp::abandon_camp()
 {
     validate_assignees();
     for( npc_ptr &guy : overmap_buffer.get_companion_mission_npcs( 10 ) ) {
-        npc_companion_mission c_mission = guy->get_companion_mission();
+        const npc_companion_mission &c_mission = guy->get_companion_mission();
         if( c_mission.role_id != base_camps::id ) {
             continue;
         }
@@ -9,6 +9,9 @@
 #include "make_static.h"
 #include "rng.h"
 
+// The last turn map::process_fields finished, see field_entry::set_last_processed.
+static time_point fields_last_processed;
+
 std::string field_entry::symbol() const
 {
     return get_field_type()->get_symbol( get_field_intensity() - 1 );
@@ -69,11 +72,20 @@ void field_entry::mod_field_intensity( int mod )
 
 time_duration field_entry::get_field_age() const
 {
-    return age;
+    return get_field_age( fields_last_processed );
+}
+
+time_duration field_entry::get_field_age( const time_point &until ) const
+{
+    if( !asleep ) {
+        return age;
+    }
+    return age + std::max( std::min( until, fields_last_processed ) - asleep_since, 0_turns );
 }
 
 time_duration field_entry::set_field_age( const time_duration &new_age )
 {
+    asleep = false;
     decay_time = time_point();
     return age = new_age;
 }
@@ -183,7 +195,7 @@ bool field::remove_field( const field_type_id &field_to_remove )
     return true;
 }
 
-void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
+void field::remove_field( field_entry_map::iterator const it )
 {
     _field_type_list.erase( it );
     _displayed_field_type = fd_null;
@@ -211,22 +223,22 @@ unsigned int field::field_count() const
     return _field_type_list.size();
 }
 
-std::map<field_type_id, field_entry>::iterator field::begin()
+field_entry_map::iterator field::begin()
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::begin() const
+field_entry_map::const_iterator field::begin() const
 {
     return _field_type_list.begin();
 }
 
-std::map<field_type_id, field_entry>::iterator field::end()
+field_entry_map::iterator field::end()
 {
     return _field_type_list.end();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::end() const
+field_entry_map::const_iterator field::end() const
 {
     return _field_type_list.end();
 }
@@ -260,6 +272,51 @@ int field::total_move_cost() const
     return current_cost;
 }
 
+bool field_entry::is_idle( cata::optional<time_point> &wake ) const
+{
+    if( !is_field_alive() || age <= 0_turns ) {
+        return false;
+    }
+    if( type.obj().half_life <= 0_turns ) {
+        return true;
+    }
+    // Not drawn yet: the next do_decay rolls for it.
+    if( decay_time == calendar::turn_zero ) {
+        return false;
+    }
+    if( !wake || decay_time < *wake ) {
+        wake = decay_time;
+    }
+    return true;
+}
+
+void field_entry::fall_asleep()
+{
+    asleep = true;
+    asleep_since = calendar::turn;
+}
+
+void field_entry::wake_up()
+{
+    wake_up( fields_last_processed );
+}
+
+void field_entry::wake_up( const time_point &until )
+{
+    if( !asleep ) {
+        return;
+    }
+    // Woken while processing, the last processed turn is the previous one and do_decay
+    // then adds this turn itself.
+    age = get_field_age( until );
+    asleep = false;
+}
+
+void field_entry::set_last_processed( const time_point &turn )
+{
+    fields_last_processed = turn;
+}
+
 std::vector<field_effect> field_entry::field_effects() const
 {
     return type->get_intensity_level( intensity - 1 ).field_effects;
@@ -2,14 +2,19 @@
 #ifndef CATA_SRC_FIELD_H
 #define CATA_SRC_FIELD_H
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <map>
+#include <new>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
 #include "color.h"
 #include "enums.h"
 #include "field_type.h"
+#include "optional.h"
 #include "type_id.h"
 
 /**
@@ -49,6 +54,8 @@ class field_entry
 
         /// @returns @ref age.
         time_duration get_field_age() const;
+        /// @returns @ref age, counting the time spent asleep only up to @p until.
+        time_duration get_field_age( const time_point &until ) const;
         /// Sets @ref age to the given value.
         /// @returns New value of @ref age.
         time_duration set_field_age( const time_duration &new_age );
@@ -78,6 +85,24 @@ class field_entry
 
         void do_decay();
 
+        /**
+         * Whether, processors aside, all this entry does on the coming turns is age: it is past
+         * its first turn and its next decay is already scheduled.  If it is going to decay,
+         * @p wake is lowered to the time it does.
+         */
+        bool is_idle( cata::optional<time_point> &wake ) const;
+        /** Stop aging turn by turn; @ref get_field_age adds the time spent asleep. */
+        void fall_asleep();
+        /** Fold the turns skipped while asleep into @ref age, ahead of this turn's processing. */
+        void wake_up();
+        /** As @ref wake_up, but count the time spent asleep only up to @p until. */
+        void wake_up( const time_point &until );
+        /**
+         * Sleeping entries age with the turns field processing has finished, not with the
+         * clock, so they read the same as awake ones before and after processing.
+         */
+        static void set_last_processed( const time_point &turn );
+
         std::vector<field_effect> field_effects() const;
 
     private:
@@ -91,8 +116,92 @@ class field_entry
         time_point decay_time;
         // True if this is an active field, false if it should be destroyed next check.
         bool is_alive;
+        // True while field processing skips this entry, see @ref fall_asleep.
+        bool asleep = false;
+        // The turn it was last processed before falling asleep.
+        time_point asleep_since;
 };
 
+/**
+ * Allocator for the nodes of a field's entry map.  Freed nodes of single elements are kept
+ * on a per-thread free list and handed out again, so fields coming and going every turn on
+ * busy squares (fire, smoke, gas) mostly reuse memory instead of reaching the general heap.
+ * The free list keeps at most @ref max_free_nodes nodes.
+ */
+template<typename T>
+class field_node_allocator
+{
+    public:
+        using value_type = T;
+
+        field_node_allocator() = default;
+        template<typename U>
+        explicit field_node_allocator( const field_node_allocator<U> & ) noexcept {}
+
+        T *allocate( std::size_t n ) {
+            if( n == 1 && free_nodes.head != nullptr ) {
+                free_node *const reused = free_nodes.head;
+                free_nodes.head = reused->next;
+                --free_nodes.count;
+                return reinterpret_cast<T *>( reused );
+            }
+            return static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+        }
+
+        void deallocate( T *p, std::size_t n ) noexcept {
+            if( n == 1 && free_nodes.count < max_free_nodes ) {
+                free_node *const freed = reinterpret_cast<free_node *>( p );
+                freed->next = free_nodes.head;
+                free_nodes.head = freed;
+                ++free_nodes.count;
+                return;
+            }
+            ::operator delete( p );
+        }
+
+        template<typename U>
+        bool operator==( const field_node_allocator<U> & ) const noexcept {
+            return true;
+        }
+        template<typename U>
+        bool operator!=( const field_node_allocator<U> & ) const noexcept {
+            return false;
+        }
+
+    private:
+        static constexpr std::size_t max_free_nodes = 1 << 16;
+
+        struct free_node {
+            free_node *next;
+        };
+        static_assert( sizeof( T ) >= sizeof( free_node ), "node too small for the free list" );
+
+        struct free_list {
+            free_node *head = nullptr;
+            std::size_t count = 0;
+
+            // Gives the nodes back when the thread exits.  Fields freed after that, by
+            // objects with static storage, go straight to the heap since the list counts
+            // as full.
+            ~free_list() {
+                while( head != nullptr ) {
+                    free_node *const next = head->next;
+                    ::operator delete( head );
+                    head = next;
+                }
+                count = max_free_nodes;
+            }
+        };
+
+        static thread_local free_list free_nodes;
+};
+
+template<typename T>
+thread_local typename field_node_allocator<T>::free_list field_node_allocator<T>::free_nodes;
+
+using field_entry_map = std::map<field_type_id, field_entry, std::less<field_type_id>,
+      field_node_allocator<std::pair<const field_type_id, field_entry>>>;
+
 /**
  * A variable sized collection of field entries on a given map square.
  * It contains one (at most) entry of each field type (e. g. one smoke entry and one
@@ -141,7 +250,7 @@ class field
          * Make sure to decrement the field counter in the submap.
          * Removes the field entry, the iterator must point into @ref _field_type_list and must be valid.
          */
-        void remove_field( std::map<field_type_id, field_entry>::iterator );
+        void remove_field( field_entry_map::iterator );
 
         /**
          * Removes all fields.
@@ -165,12 +274,12 @@ class field
         description_affix displayed_description_affix() const;
 
         //Returns the vector iterator to begin searching through the list.
-        std::map<field_type_id, field_entry>::iterator begin();
-        std::map<field_type_id, field_entry>::const_iterator begin() const;
+        field_entry_map::iterator begin();
+        field_entry_map::const_iterator begin() const;
 
         //Returns the vector iterator to end searching through the list.
-        std::map<field_type_id, field_entry>::iterator end();
-        std::map<field_type_id, field_entry>::const_iterator end() const;
+        field_entry_map::iterator end();
+        field_entry_map::const_iterator end() const;
 
         /**
          * Returns the total move cost from all fields.
@@ -179,7 +288,7 @@ class field
 
     private:
         // A pointer lookup table of all field effects on the current tile.
-        std::map<field_type_id, field_entry> _field_type_list;
+        field_entry_map _field_type_list;
         //_displayed_field_type currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_type_id _displayed_field_type;
 };
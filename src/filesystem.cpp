@@ -14,6 +14,7 @@
 
 #include "cata_utility.h"
 #include "debug.h"
+#include "save_journal.h"
 
 #if defined(_WIN32)
 #   include "platform_win.h"
@@ -34,6 +35,8 @@ bool dir_exist( const std::string &path )
 
 bool file_exist( const std::string &path )
 {
+    // A file that was only saved to the journal so far has to be there for its reader.
+    save_journal::settle( path );
     return fs::exists( path ) && !fs::is_directory( path );
 }
 
@@ -69,6 +72,7 @@ const char *cata_files::eol()
 
 std::string read_entire_file( const std::string &path )
 {
+    save_journal::settle( path );
     cata::ifstream infile( fs::u8path( path ), std::ifstream::in | std::ifstream::binary );
     return std::string( std::istreambuf_iterator<char>( infile ),
                         std::istreambuf_iterator<char>() );
@@ -1,6 +1,7 @@
 #include "flag.h"
 
 #include "debug.h"
+#include "flag_bitset.h"
 #include "generic_factory.h"
 #include "json.h"
 #include "type_id.h"
@@ -352,6 +353,13 @@ const json_flag &flag_id::obj() const
     return json_flags_all.obj( *this );
 }
 
+/** @relates string_id */
+template<>
+int_id<json_flag> flag_id::id() const
+{
+    return json_flags_all.convert( *this, int_id<json_flag>( -1 ), false );
+}
+
 json_flag::operator bool() const
 {
     return id.is_valid();
@@ -416,3 +424,55 @@ const std::vector<json_flag> &json_flag::get_all()
 {
     return json_flags_all.get_all();
 }
+
+int flag_bitset::dense_index( const flag_id &f )
+{
+    const int index = f.id().to_i();
+    return index >= 0 && index < static_cast<int>( json_flags_all.size() ) ? index : -1;
+}
+
+bool flag_bitset::test( const flag_id &f ) const
+{
+    const int index = dense_index( f );
+    if( index >= 0 && static_cast<size_t>( index / 64 ) < words.size() &&
+        ( words[index / 64] >> ( index % 64 ) & 1 ) ) {
+        return true;
+    }
+    return !overflow.empty() && overflow.count( f );
+}
+
+void flag_bitset::set( const flag_id &f )
+{
+    const int index = dense_index( f );
+    if( index >= 0 ) {
+        if( static_cast<size_t>( index / 64 ) >= words.size() ) {
+            words.resize( index / 64 + 1 );
+        }
+        words[index / 64] |= uint64_t( 1 ) << ( index % 64 );
+    } else {
+        overflow.insert( f );
+    }
+}
+
+void flag_bitset::reset( const flag_id &f )
+{
+    const int index = dense_index( f );
+    if( index >= 0 && static_cast<size_t>( index / 64 ) < words.size() ) {
+        words[index / 64] &= ~( uint64_t( 1 ) << ( index % 64 ) );
+    }
+    overflow.erase( f );
+}
+
+void flag_bitset::clear()
+{
+    words.clear();
+    overflow.clear();
+}
+
+void flag_bitset::assign( const std::set<flag_id> &flags )
+{
+    clear();
+    for( const flag_id &f : flags ) {
+        set( f );
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#ifndef CATA_SRC_FLAG_BITSET_H
+#define CATA_SRC_FLAG_BITSET_H
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "type_id.h"
+
+/**
+ * A set of flags stored as one bit per flag, indexed by the int id each json_flag got when
+ * the flags were loaded.  The bits are only allocated up to the highest flag set, so a set
+ * with no flags holds no memory.  Flags which were added before their definition was
+ * loaded are kept in a sparse overflow set.
+ * Only membership is stored; keep a std::set alongside for iteration and serialization.
+ */
+class flag_bitset
+{
+    public:
+        bool test( const flag_id &f ) const;
+        void set( const flag_id &f );
+        void reset( const flag_id &f );
+        void clear();
+        void assign( const std::set<flag_id> &flags );
+
+    private:
+        /** Bit index into @ref words, or -1 if the flag has no int id yet. */
+        static int dense_index( const flag_id &f );
+
+        std::vector<uint64_t> words;
+        std::set<flag_id> overflow;
+};
+
+#endif // CATA_SRC_FLAG_BITSET_H
@@ -148,6 +148,8 @@
 #include "ret_val.h"
 #include "rng.h"
 #include "safemode_ui.h"
+#include "save_journal.h"
+#include "save_stats.h"
 #include "scenario.h"
 #include "scent_map.h"
 #include "scores_ui.h"
@@ -161,6 +163,7 @@
 #include "talker.h"
 #include "tileray.h"
 #include "timed_event.h"
+#include "trace_zones.h"
 #include "translations.h"
 #include "trap.h"
 #include "ui.h"
@@ -404,7 +407,8 @@ game::game() :
     reset_light_level();
     events().subscribe( &*stats_tracker_ptr );
     events().subscribe( &*kill_tracker_ptr );
-    events().subscribe( &*memorial_logger_ptr );
+    // The memorial only records what happened, so it can wait for the end of the turn.
+    events().subscribe( &*memorial_logger_ptr, event_dispatch::deferred );
     events().subscribe( &*achievements_tracker_ptr );
     events().subscribe( &*spell_events_ptr );
     world_generator = std::make_unique<worldfactory>();
@@ -1030,6 +1034,7 @@ void game::load_npcs()
             temp->die( nullptr );
         } else {
             critter_tracker->active_npc.push_back( temp );
+            critter_tracker->note_change();
             just_added.push_back( temp );
         }
     }
@@ -2509,6 +2514,8 @@ void game::move_save_to_graveyard()
 
 void game::load_master()
 {
+    // Saves an earlier session journaled are replayed before anything of the world is read.
+    save_journal::apply();
     using namespace std::placeholders;
     const auto datafile = PATH_INFO::world_base_save_path() + "/" + SAVE_MASTER;
     read_from_file_optional( datafile, std::bind( &game::unserialize_master, this, _1 ) );
@@ -2737,14 +2744,17 @@ void game::reset_npc_dispositions()
 //Saves all factions and missions and npcs.
 bool game::save_factions_missions_npcs()
 {
+    save_timer timer( save_part::master );
     std::string masterfile = PATH_INFO::world_base_save_path() + "/" + SAVE_MASTER;
     return write_to_file( masterfile, [&]( std::ostream & fout ) {
         serialize_master( fout );
-    }, _( "factions data" ) );
+        save_stats::add_file( save_part::master, fout.tellp() );
+    }, _( "factions data" ), compress_save_files() );
 }
 
 bool game::save_maps()
 {
+    save_timer timer( save_part::submaps );
     try {
         m.save();
         overmap_buffer.save(); // can throw
@@ -2758,20 +2768,24 @@ bool game::save_maps()
 
 bool game::save_player_data()
 {
+    save_timer timer( save_part::player );
     const std::string playerfile = PATH_INFO::player_base_save_path();
 
     const bool saved_data = write_to_file( playerfile + SAVE_EXTENSION, [&]( std::ostream & fout ) {
         serialize( fout );
+        save_stats::add_file( save_part::player, fout.tellp() );
     }, _( "player data" ) );
     const bool saved_map_memory = u.save_map_memory();
     const bool saved_log = write_to_file( playerfile + SAVE_EXTENSION_LOG, [&](
     std::ostream & fout ) {
         memorial().save( fout );
+        save_stats::add_file( save_part::player, fout.tellp() );
     }, _( "player memorial" ) );
 #if defined(__ANDROID__)
     const bool saved_shortcuts = write_to_file( playerfile + SAVE_EXTENSION_SHORTCUTS, [&](
     std::ostream & fout ) {
         save_shortcuts( fout );
+        save_stats::add_file( save_part::player, fout.tellp() );
     }, _( "quick shortcuts" ) );
 #endif
     const bool saved_diary = u.get_avatar_diary()->store();
@@ -2807,14 +2821,24 @@ spell_events &game::spell_events_subscriber()
     return *spell_events_ptr;
 }
 
-bool game::save()
+bool game::save( const bool journaled )
 {
     std::chrono::seconds time_since_load =
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::steady_clock::now() - time_of_last_load );
     std::chrono::seconds total_time_played = time_played_at_last_load + time_since_load;
     events().send<event_type::game_save>( time_since_load, total_time_played );
+    events().process_deferred();
+    save_stats::begin_save();
+    save_timer timer( save_part::other );
+    if( !journaled ) {
+        // Fold in the journal of earlier saves, so that it can't be replayed over this one.
+        save_journal::apply();
+    }
+    save_journal::capture journal( journaled );
     try {
+        // The memory map files are written in the background while the rest is saved,
+        // and the save only succeeds once they are written too.
         if( !save_player_data() ||
             !save_factions_missions_npcs() ||
             !save_maps() ||
@@ -2824,7 +2848,8 @@ bool game::save()
         !write_to_file( PATH_INFO::world_base_save_path() + "/uistate.json", [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
             uistate.serialize( jsout );
-        }, _( "uistate data" ) ) ) {
+        }, _( "uistate data" ) ) ||
+        !u.flush_map_memory() ) {
             return false;
         } else {
             world_generator->active_world->add_save( save_t::from_save_id( u.get_save_id() ) );
@@ -3055,8 +3080,8 @@ shared_ptr_fast<ui_adaptor> game::create_or_get_main_ui_adaptor()
     shared_ptr_fast<ui_adaptor> ui = main_ui_adaptor.lock();
     if( !ui ) {
         main_ui_adaptor = ui = make_shared_fast<ui_adaptor>();
-        ui->on_redraw( []( const ui_adaptor & ) {
-            g->draw();
+        ui->on_redraw( []( const ui_adaptor & ui ) {
+            g->draw( ui );
         } );
         ui->on_screen_resize( [this]( ui_adaptor & ui ) {
             // remove some space for the sidebar, this is the maximal space
@@ -3121,6 +3146,14 @@ void game::invalidate_main_ui_adaptor() const
     }
 }
 
+void game::invalidate_main_ui_adaptor( const catacurses::window &win ) const
+{
+    shared_ptr_fast<ui_adaptor> ui = main_ui_adaptor.lock();
+    if( ui ) {
+        ui->invalidate_window( win );
+    }
+}
+
 void game::mark_main_ui_adaptor_resize() const
 {
     shared_ptr_fast<ui_adaptor> ui = main_ui_adaptor.lock();
@@ -3222,31 +3255,38 @@ static shared_ptr_fast<game::draw_callback_t> create_trail_callback(
     } );
 }
 
-void game::draw()
+void game::draw( const ui_adaptor &ui )
 {
     if( test_mode ) {
         return;
     }
+    CATA_TRACE_ZONE( "game::draw" );
 
     //temporary fix for updating visibility for minimap
     ter_view_p.z = ( u.pos() + u.view_offset ).z;
     m.build_map_cache( ter_view_p.z );
     m.update_visibility_cache( ter_view_p.z );
 
-    werase( w_terrain );
-    draw_ter();
-    for( auto it = draw_callbacks.begin(); it != draw_callbacks.end(); ) {
-        shared_ptr_fast<draw_callback_t> cb = it->lock();
-        if( cb ) {
-            ( *cb )();
-            ++it;
-        } else {
-            it = draw_callbacks.erase( it );
+    // When only a popup over the sidebar went away, the map on screen is still the same.
+    if( ui.is_dirty( w_terrain ) ) {
+        werase( w_terrain );
+        draw_ter();
+        for( auto it = draw_callbacks.begin(); it != draw_callbacks.end(); ) {
+            shared_ptr_fast<draw_callback_t> cb = it->lock();
+            if( cb ) {
+                ( *cb )();
+                ++it;
+            } else {
+                it = draw_callbacks.erase( it );
+            }
         }
+        wnoutrefresh( w_terrain );
     }
-    wnoutrefresh( w_terrain );
 
-    draw_panels( true );
+    // Animations redraw only the map, the sidebar on screen is still the same.
+    if( ui.is_dirty_outside( w_terrain ) ) {
+        draw_panels( true );
+    }
 
     // This breaks stuff in the SDL port, see
     // https://github.com/CleverRaven/Cataclysm-DDA/issues/45910
@@ -4054,6 +4094,7 @@ void game::cleanup_dead()
                 remove_npc_follower( ( *it )->getID() );
                 overmap_buffer.remove_npc( ( *it )->getID() );
                 it = critter_tracker->active_npc.erase( it );
+                critter_tracker->note_change();
             } else {
                 it++;
             }
@@ -10922,6 +10963,10 @@ point game::update_map( int &x, int &y, bool z_level_changed )
         m.shift( this_shift );
         remaining_shift -= this_shift;
     }
+    // Whoever crossed into a new submap, most of all a vehicle, is likely to keep going
+    // the same way.
+    m.prefetch_ahead( shift );
+    m.drop_uniform_behind( shift );
 
     // Shift monsters
     shift_monsters( tripoint( shift, 0 ) );
@@ -10936,6 +10981,7 @@ point game::update_map( int &x, int &y, bool z_level_changed )
             //Remove the npc from the active list. It remains in the overmap list.
             ( *it )->on_unload();
             it = critter_tracker->active_npc.erase( it );
+            critter_tracker->note_change();
         } else {
             it++;
         }
@@ -10954,10 +11000,7 @@ point game::update_map( int &x, int &y, bool z_level_changed )
     // Put those in the active list.
     load_npcs();
 
-    // Make sure map cache is consistent since it may have shifted.
-    for( int zlev = -OVERMAP_DEPTH; zlev <= OVERMAP_HEIGHT; ++zlev ) {
-        m.invalidate_map_cache( zlev );
-    }
+    // map::shift has moved or invalidated the caches, bring them up to date.
     m.build_map_cache( m.get_abs_sub().z );
 
     // Spawn monsters if appropriate
@@ -11315,7 +11358,7 @@ void game::init_autosave()
     last_save_timestamp = time( nullptr );
 }
 
-void game::quicksave()
+void game::quicksave( const bool journaled )
 {
     //Don't autosave if the player hasn't done anything since the last autosave/quicksave,
     if( !moves_since_last_save ) {
@@ -11331,7 +11374,7 @@ void game::quicksave()
     time_t now = time( nullptr ); //timestamp for start of saving procedure
 
     //perform save
-    save();
+    save( journaled );
     //Now reset counters for autosaving, so we don't immediately autosave after a quicksave or autosave.
     moves_since_last_save = 0;
     last_save_timestamp = now;
@@ -11366,7 +11409,7 @@ void game::autosave()
     if( time( nullptr ) < last_save_timestamp + 60 * get_option<int>( "AUTOSAVE_MINUTES" ) ) {
         return;
     }
-    quicksave();    //Driving checks are handled by quicksave()
+    quicksave( get_option<bool>( "AUTOSAVE_JOURNAL" ) ); //Driving checks are handled by quicksave()
 }
 
 void game::start_calendar()
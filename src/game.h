@@ -214,8 +214,11 @@ class game
         /** write statistics to stdout and @return true if successful */
         bool dump_stats( const std::string &what, dump_mode mode, const std::vector<std::string> &opts );
 
-        /** Returns false if saving failed. */
-        bool save();
+        /**
+         * Returns false if saving failed. A journaled save appends the files it writes to
+         * the save journal (see save_journal.h) instead of replacing them.
+         */
+        bool save( bool journaled = false );
 
         /** Returns a list of currently active character saves. */
         std::vector<std::string> list_active_saves();
@@ -223,8 +226,10 @@ class game
         void start_calendar();
         shared_ptr_fast<ui_adaptor> create_or_get_main_ui_adaptor();
         void invalidate_main_ui_adaptor() const;
+        // Only the part of the main UI covered by win gets redrawn.
+        void invalidate_main_ui_adaptor( const catacurses::window &win ) const;
         void mark_main_ui_adaptor_resize() const;
-        void draw();
+        void draw( const ui_adaptor &ui );
         void draw_ter( bool draw_sounds = true );
         void draw_ter( const tripoint &center, bool looking = false, bool draw_sounds = true );
 
@@ -919,7 +924,7 @@ class game
         //  int autosave_timeout();  // If autosave enabled, how long we should wait for user inaction before saving.
         void autosave();         // automatic quicksaves - Performs some checks before calling quicksave()
     public:
-        void quicksave();        // Saves the game without quitting
+        void quicksave( bool journaled = false ); // Saves the game without quitting
         void disp_NPCs();        // Currently for debug use.  Lists global NPCs.
 
         void list_missions();       // Listed current, completed and failed missions (mission_ui.cpp)
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <bitset>
+#include <cstdint>
+#include <functional>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -137,7 +139,94 @@ class generic_factory
 
     protected:
         std::vector<T> list;
-        std::unordered_map<string_id<T>, int_id<T>> map;
+        /**
+         * Maps ids and aliases to their index in `list`.  Each string_id remembers its last
+         * lookup, so this is only searched for ids that were just built from a string.  It is
+         * an open-addressing table over one flat array, which keeps those lookups to a probe
+         * or two without chasing a node per bucket.
+         */
+        class id_map
+        {
+            public:
+                const int_id<T> *find( const string_id<T> &id ) const {
+                    if( slots.empty() ) {
+                        return nullptr;
+                    }
+                    for( size_t i = slot_of( id ); slots[i].used; i = ( i + 1 ) & mask() ) {
+                        if( slots[i].id == id ) {
+                            return &slots[i].cid;
+                        }
+                    }
+                    return nullptr;
+                }
+
+                int_id<T> &operator[]( const string_id<T> &id ) {
+                    if( ( count + 1 ) * 2 > slots.size() ) {
+                        rehash( std::max<size_t>( 64, slots.size() * 2 ) );
+                    }
+                    size_t i = slot_of( id );
+                    for( ; slots[i].used; i = ( i + 1 ) & mask() ) {
+                        if( slots[i].id == id ) {
+                            return slots[i].cid;
+                        }
+                    }
+                    slots[i].used = true;
+                    slots[i].id = id;
+                    ++count;
+                    return slots[i].cid;
+                }
+
+                /** Erase every entry for which pred( id, cid ) is true. */
+                template<typename Predicate>
+                void erase_if( Predicate pred ) {
+                    std::vector<slot> old( slots.size() );
+                    old.swap( slots );
+                    count = 0;
+                    for( const slot &s : old ) {
+                        if( s.used && !pred( s.id, s.cid ) ) {
+                            ( *this )[s.id] = s.cid;
+                        }
+                    }
+                }
+
+                void clear() {
+                    slots.clear();
+                    count = 0;
+                }
+
+            private:
+                struct slot {
+                    string_id<T> id;
+                    int_id<T> cid;
+                    bool used = false;
+                };
+
+                size_t mask() const {
+                    return slots.size() - 1;
+                }
+
+                size_t slot_of( const string_id<T> &id ) const {
+                    // Interned ids hash to small consecutive numbers, so spread them out.
+                    const uint64_t hash = std::hash<string_id<T>>()( id );
+                    return static_cast<size_t>( ( hash * 0x9E3779B97F4A7C15ULL ) >> 32 ) & mask();
+                }
+
+                void rehash( const size_t size ) {
+                    std::vector<slot> old( size );
+                    old.swap( slots );
+                    count = 0;
+                    for( const slot &s : old ) {
+                        if( s.used ) {
+                            ( *this )[s.id] = s.cid;
+                        }
+                    }
+                }
+
+                std::vector<slot> slots;
+                size_t count = 0;
+        };
+
+        id_map map;
         std::unordered_map<std::string, T> abstracts;
 
         std::string type_name;
@@ -151,14 +240,14 @@ class generic_factory
                 result = int_id<T>( id._cid );
                 return is_valid( result );
             }
-            const auto iter = map.find( id );
+            const int_id<T> *found = map.find( id );
             // map lookup happens at most once per string_id instance per generic_factory::version
             // id was not found, explicitly marking it as "invalid"
-            if( iter == map.end() ) {
+            if( found == nullptr ) {
                 id.set_cid_version( INVALID_CID, version );
                 return false;
             }
-            result = iter->second;
+            result = *found;
             id.set_cid_version( result.to_i(), version );
             return true;
         }
@@ -168,15 +257,9 @@ class generic_factory
             if( !find_id( id, i_id ) ) {
                 return;
             }
-            auto iter = map.begin();
-            const auto end = map.end();
-            while( iter != end ) {
-                if( iter->second == i_id && iter->first != id ) {
-                    map.erase( iter++ );
-                } else {
-                    ++iter;
-                }
-            }
+            map.erase_if( [&]( const string_id<T> &e, const int_id<T> &cid ) {
+                return cid == i_id && e != id;
+            } );
         }
 
         const T dummy_obj;
@@ -215,10 +298,10 @@ class generic_factory
             static const std::string abstract_member_name( "abstract" );
             if( jo.has_string( copy_from_member_name ) ) {
                 const std::string source = jo.get_string( copy_from_member_name );
-                auto base = map.find( string_id<T>( source ) );
+                const int_id<T> *base = map.find( string_id<T>( source ) );
 
-                if( base != map.end() ) {
-                    def = obj( base->second );
+                if( base != nullptr ) {
+                    def = obj( *base );
                 } else {
                     auto ab = abstracts.find( source );
 
@@ -347,11 +430,11 @@ class generic_factory
             // in the common scenario there is no loss of performance, as `finalize` will make cache
             // for all ids valid again
             inc_version();
-            const auto iter = map.find( obj.id );
-            if( iter != map.end() ) {
-                T &result = list[iter->second.to_i()];
+            const int_id<T> *found = map.find( obj.id );
+            if( found != nullptr ) {
+                T &result = list[found->to_i()];
                 result = obj;
-                result.id.set_cid_version( iter->second.to_i(), version );
+                result.id.set_cid_version( found->to_i(), version );
                 return result;
             }
 
@@ -1,10 +1,18 @@
 #include "init.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "achievement.h"
@@ -115,6 +123,99 @@ DynamicDataLoader &DynamicDataLoader::get_instance()
     return theDynamicDataLoader;
 }
 
+using stage_time = std::pair<std::string, std::chrono::steady_clock::duration>;
+
+struct DynamicDataLoader::load_profile {
+    struct totals {
+        int objects = 0;
+        std::chrono::steady_clock::duration time{};
+    };
+
+    std::string path;
+    std::map<std::string, totals> types;
+    std::map<std::string, totals> files;
+    std::vector<stage_time> stages;
+    int objects_loaded = 0;
+
+    void clear() {
+        types.clear();
+        files.clear();
+        stages.clear();
+        objects_loaded = 0;
+    }
+
+    void write() const;
+
+    // Writes the totals slowest first, the order anyone reading the report wants.
+    static void write_totals( JsonOut &jsout, const std::string &name, const std::string &key,
+                              const std::map<std::string, totals> &table );
+};
+
+static double to_milliseconds( std::chrono::steady_clock::duration d )
+{
+    return std::chrono::duration<double, std::milli>( d ).count();
+}
+
+void DynamicDataLoader::load_profile::write_totals( JsonOut &jsout, const std::string &name,
+        const std::string &key, const std::map<std::string, totals> &table )
+{
+    using entry = std::pair<std::string, load_profile::totals>;
+    std::vector<entry> sorted( table.begin(), table.end() );
+    std::stable_sort( sorted.begin(), sorted.end(), []( const entry & a, const entry & b ) {
+        return a.second.time > b.second.time;
+    } );
+    jsout.member( name );
+    jsout.start_array();
+    for( const entry &e : sorted ) {
+        jsout.start_object();
+        jsout.member( key, e.first );
+        jsout.member( "objects", e.second.objects );
+        jsout.member( "ms", to_milliseconds( e.second.time ) );
+        jsout.end_object();
+    }
+    jsout.end_array();
+}
+
+void DynamicDataLoader::load_profile::write() const
+{
+    const bool written = write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        write_totals( jsout, "types", "type", types );
+        write_totals( jsout, "files", "file", files );
+        std::vector<stage_time> sorted_stages = stages;
+        std::stable_sort( sorted_stages.begin(), sorted_stages.end(),
+        []( const stage_time & a, const stage_time & b ) {
+            return a.second > b.second;
+        } );
+        jsout.member( "stages" );
+        jsout.start_array();
+        for( const stage_time &stage : sorted_stages ) {
+            jsout.start_object();
+            jsout.member( "stage", stage.first );
+            jsout.member( "ms", to_milliseconds( stage.second ) );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, nullptr );
+    if( !written ) {
+        DebugLog( D_ERROR, DC_ALL ) << "Could not write the data loading profile to " << path;
+    }
+}
+
+void DynamicDataLoader::set_load_profile_path( const std::string &path )
+{
+    if( path.empty() ) {
+        profile.reset();
+        return;
+    }
+    if( !profile ) {
+        profile = std::make_unique<load_profile>();
+    }
+    profile->path = path;
+}
+
 void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &src,
                                      const std::string &base_path,
                                      const std::string &full_path )
@@ -124,7 +225,16 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
     if( it == type_function_map.end() ) {
         jo.throw_error( "unrecognized JSON object", "type" );
     }
+    if( !profile ) {
+        it->second( jo, src, base_path, full_path );
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
     it->second( jo, src, base_path, full_path );
+    load_profile::totals &type_totals = profile->types[type];
+    type_totals.objects++;
+    type_totals.time += std::chrono::steady_clock::now() - start;
+    profile->objects_loaded++;
 }
 
 struct DynamicDataLoader::cached_streams {
@@ -467,6 +577,81 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+namespace
+{
+
+/**
+ * Reads a list of files into memory on a separate thread, a few files ahead of
+ * the caller, who takes them in order while it loads the previous ones.
+ */
+class file_reader_ahead
+{
+    public:
+        explicit file_reader_ahead( const std::vector<std::string> &files ) : files( files ),
+            contents( files.size() ) {
+            reader = std::thread( [this]() {
+                read_all();
+            } );
+        }
+
+        ~file_reader_ahead() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            changed.notify_all();
+            reader.join();
+        }
+
+        file_reader_ahead( const file_reader_ahead & ) = delete;
+        file_reader_ahead &operator=( const file_reader_ahead & ) = delete;
+
+        /** The contents of the next file, waiting for the reader if it is not there yet. */
+        std::string next() {
+            std::unique_lock<std::mutex> lock( mutex );
+            changed.wait( lock, [this]() {
+                return read > taken;
+            } );
+            std::string result = std::move( contents[taken++] );
+            changed.notify_all();
+            return result;
+        }
+
+    private:
+        // Bounds the memory held by files that were read ahead but not loaded yet.
+        static constexpr size_t max_ahead = 8;
+
+        void read_all() {
+            for( size_t i = 0; i < files.size(); ++i ) {
+                {
+                    std::unique_lock<std::mutex> lock( mutex );
+                    changed.wait( lock, [this]() {
+                        return stopping || read - taken < max_ahead;
+                    } );
+                    if( stopping ) {
+                        return;
+                    }
+                }
+                std::string text = read_entire_file( files[i] );
+                std::lock_guard<std::mutex> lock( mutex );
+                contents[i] = std::move( text );
+                ++read;
+                changed.notify_all();
+            }
+        }
+
+        const std::vector<std::string> &files;
+        std::vector<std::string> contents;
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t read = 0;
+        size_t taken = 0;
+        bool stopping = false;
+        std::thread reader;
+};
+
+} // namespace
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
         loading_ui &ui )
 {
@@ -488,10 +673,15 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
+    // Reading the files needs nothing from the game, so it runs ahead of the loading,
+    // which has to happen in file order on this thread.
+    file_reader_ahead reader( files );
     // iterate over each file
     for( const std::string &file : files ) {
         // and stuff it into ram
-        std::istringstream iss( read_entire_file( file ) );
+        std::istringstream iss( reader.next() );
+        const auto start = std::chrono::steady_clock::now();
+        const int objects_before = profile ? profile->objects_loaded : 0;
         try {
             // parse it
             JsonIn jsin( iss, file );
@@ -499,6 +689,11 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
         } catch( const JsonError &err ) {
             throw std::runtime_error( err.what() );
         }
+        if( profile ) {
+            load_profile::totals &file_totals = profile->files[file];
+            file_totals.objects += profile->objects_loaded - objects_before;
+            file_totals.time += std::chrono::steady_clock::now() - start;
+        }
     }
 }
 
@@ -533,6 +728,9 @@ void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    if( profile ) {
+        profile->clear();
+    }
 
     achievement::reset();
     activity_type::reset();
@@ -623,6 +821,35 @@ void DynamicDataLoader::unload_data()
     weather_types::reset();
 }
 
+using named_entry = std::pair<std::string, std::function<void()>>;
+
+// Runs the stages in order, one by one, and logs how long the slow ones took, so it
+// shows up in the debug log which stage a long startup or --check-mods run goes to.
+// The time of every stage is appended to @p times, if given.
+static void run_stages( loading_ui &ui, const std::vector<named_entry> &entries,
+                        std::vector<stage_time> *times )
+{
+    for( const named_entry &e : entries ) {
+        ui.add_entry( e.first );
+    }
+
+    ui.show();
+    for( const named_entry &e : entries ) {
+        const auto start = std::chrono::steady_clock::now();
+        e.second();
+        const std::chrono::steady_clock::duration taken = std::chrono::steady_clock::now() - start;
+        if( times ) {
+            times->emplace_back( e.first, taken );
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>( taken );
+        if( elapsed.count() >= 100 ) {
+            DebugLog( D_INFO, DC_ALL ) << "Data stage \"" << e.first << "\" took "
+                                       << elapsed.count() << " ms";
+        }
+        ui.proceed();
+    }
+}
+
 void DynamicDataLoader::finalize_loaded_data()
 {
     // Create a dummy that will not display anything
@@ -643,7 +870,6 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 
     ui.new_context( _( "Finalizing" ) );
 
-    using named_entry = std::pair<std::string, std::function<void()>>;
     const std::vector<named_entry> entries = {{
             { _( "Flags" ), &json_flag::finalize_all },
             { _( "Body parts" ), &body_part_type::finalize_all },
@@ -670,6 +896,7 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
             { _( "Traps" ), &trap::finalize },
             { _( "Terrain" ), &set_ter_ids },
             { _( "Furniture" ), &set_furn_ids },
+            { _( "Transparency tables" ), &finalize_transparency_tables },
             { _( "Overmap land use codes" ), &overmap_land_use_codes::finalize },
             { _( "Overmap terrain" ), &overmap_terrains::finalize },
             { _( "Overmap connections" ), &overmap_connections::finalize },
@@ -706,25 +933,19 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
         }
     };
 
-    for( const named_entry &e : entries ) {
-        ui.add_entry( e.first );
-    }
-
-    ui.show();
-    for( const named_entry &e : entries ) {
-        e.second();
-        ui.proceed();
-    }
+    run_stages( ui, entries, profile ? &profile->stages : nullptr );
 
     check_consistency( ui );
     finalized = true;
+    if( profile ) {
+        profile->write();
+    }
 }
 
 void DynamicDataLoader::check_consistency( loading_ui &ui )
 {
     ui.new_context( _( "Verifying" ) );
 
-    using named_entry = std::pair<std::string, std::function<void()>>;
     const std::vector<named_entry> entries = {{
             { _( "Flags" ), &json_flag::check_consistency },
             {
@@ -803,13 +1024,5 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
         }
     };
 
-    for( const named_entry &e : entries ) {
-        ui.add_entry( e.first );
-    }
-
-    ui.show();
-    for( const named_entry &e : entries ) {
-        e.second();
-        ui.proceed();
-    }
+    run_stages( ui, entries, profile ? &profile->stages : nullptr );
 }
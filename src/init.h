@@ -75,6 +75,10 @@ class DynamicDataLoader
 
         std::unique_ptr<cached_streams> stream_cache;
 
+        struct load_profile;
+
+        std::unique_ptr<load_profile> profile;
+
     protected:
         /**
          * Maps the type string (coming from json) to the
@@ -178,6 +182,14 @@ class DynamicDataLoader
          * cached stream is returned.
          */
         shared_ptr_fast<std::istream> get_cached_stream( const std::string &path );
+
+        /**
+         * Records the time spent and objects loaded per JSON type and per data file, and
+         * the time of each finalize and consistency check stage.  The report is written
+         * as JSON to @p path each time the data is finalized.  An empty path turns the
+         * recording off.
+         */
+        void set_load_profile_path( const std::string &path );
 };
 
 #endif // CATA_SRC_INIT_H
@@ -27,12 +27,14 @@
 #include "filesystem.h"
 #include "game.h"
 #include "help.h"
+#include "input_replay.h"
 #include "json.h"
 #include "map.h"
 #include "optional.h"
 #include "options.h"
 #include "output.h"
 #include "path_info.h"
+#include "perf_stats.h"
 #include "point.h"
 #include "popup.h"
 #include "sdltiles.h" // IWYU pragma: keep
@@ -1111,7 +1113,12 @@ const std::string &input_context::handle_input( const int timeout )
     next_action.type = input_event_t::error;
     const std::string *result = &CATA_ERROR;
     while( true ) {
-        next_action = inp_mngr.get_input_event( preferred_keyboard_mode );
+        if( input_replay::is_playing() ) {
+            next_action = input_replay::next_event();
+        } else {
+            next_action = inp_mngr.get_input_event( preferred_keyboard_mode );
+            input_replay::record( next_action );
+        }
         if( next_action.type == input_event_t::timeout ) {
             result = &TIMEOUT;
             break;
@@ -1132,6 +1139,7 @@ const std::string &input_context::handle_input( const int timeout )
             && !handling_coordinate_input && action == CATA_ERROR ) {
             continue; // Ignore mouse movement.
         }
+        perf_stats::input_received();
         coordinate_input_received = true;
         coordinate = next_action.mouse_pos;
 
@@ -0,0 +1,182 @@
+#include "input_replay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "cata_utility.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "input.h"
+#include "json.h"
+#include "perf_stats.h"
+#include "point.h"
+
+namespace
+{
+
+constexpr int replay_version = 1;
+
+struct replay_state {
+    std::unique_ptr<cata::ofstream> recording;
+    bool playing = false;
+    std::deque<input_event> events;
+    size_t played = 0;
+    std::function<void()> on_end;
+    std::chrono::steady_clock::time_point playback_start;
+};
+
+replay_state &get_state()
+{
+    static replay_state state;
+    return state;
+}
+
+// [ type, [ modifiers ], [ sequence ], x, y, text ]
+std::string write_event( const input_event &ev )
+{
+    std::ostringstream out;
+    JsonOut jsout( out );
+    jsout.start_array();
+    jsout.write( static_cast<int>( ev.type ) );
+    jsout.start_array();
+    for( const keymod_t mod : ev.modifiers ) {
+        jsout.write( static_cast<int>( mod ) );
+    }
+    jsout.end_array();
+    jsout.write( ev.sequence );
+    jsout.write( ev.mouse_pos.x );
+    jsout.write( ev.mouse_pos.y );
+    jsout.write( ev.text );
+    jsout.end_array();
+    return out.str();
+}
+
+input_event read_event( const JsonArray &ja )
+{
+    input_event ev;
+    ev.type = static_cast<input_event_t>( ja.get_int( 0 ) );
+    for( const int mod : ja.get_array( 1 ) ) {
+        ev.modifiers.insert( static_cast<keymod_t>( mod ) );
+    }
+    for( const int key : ja.get_array( 2 ) ) {
+        ev.sequence.push_back( key );
+    }
+    ev.mouse_pos = point( ja.get_int( 3 ), ja.get_int( 4 ) );
+    ev.text = ja.get_string( 5 );
+    return ev;
+}
+
+} // namespace
+
+namespace input_replay
+{
+
+bool start_recording( const std::string &path, const int seed )
+{
+    replay_state &state = get_state();
+    state.recording = std::make_unique<cata::ofstream>( fs::u8path( path ),
+                      std::ios::out | std::ios::trunc );
+    if( !state.recording->is_open() ) {
+        state.recording.reset();
+        return false;
+    }
+    std::ostringstream header;
+    JsonOut jsout( header );
+    jsout.start_object();
+    jsout.member( "version", replay_version );
+    jsout.member( "seed", seed );
+    jsout.end_object();
+    *state.recording << header.str() << '\n';
+    return true;
+}
+
+void stop_recording()
+{
+    get_state().recording.reset();
+}
+
+bool start_playback( const std::string &path, int &seed, const std::function<void()> &on_end )
+{
+    replay_state &state = get_state();
+    bool read_header = false;
+    const bool read = read_from_file( path, [&]( std::istream & fin ) {
+        std::string line;
+        while( std::getline( fin, line ) ) {
+            if( line.empty() ) {
+                continue;
+            }
+            std::istringstream line_in( line );
+            JsonIn jsin( line_in );
+            if( !read_header ) {
+                JsonObject header = jsin.get_object();
+                if( header.get_int( "version" ) != replay_version ) {
+                    header.throw_error( "unsupported replay version" );
+                }
+                seed = header.get_int( "seed" );
+                read_header = true;
+            } else {
+                state.events.push_back( read_event( jsin.get_array() ) );
+            }
+        }
+    } );
+    if( !read || !read_header ) {
+        state.events.clear();
+        return false;
+    }
+    state.playing = true;
+    state.played = 0;
+    state.on_end = on_end;
+    perf_stats::reset();
+    perf_stats::set_csv_dump( true );
+    state.playback_start = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool is_recording()
+{
+    return !!get_state().recording;
+}
+
+bool is_playing()
+{
+    return get_state().playing;
+}
+
+void record( const input_event &ev )
+{
+    replay_state &state = get_state();
+    if( !state.recording ) {
+        return;
+    }
+    // Flushed every time, so a session that crashes can still be played back up to the crash.
+    *state.recording << write_event( ev ) << std::endl;
+}
+
+input_event next_event()
+{
+    replay_state &state = get_state();
+    if( state.events.empty() ) {
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - state.playback_start;
+        printf( "Played %zu input events in %.3f s\n", state.played, elapsed.count() );
+        printf( "%s\n", perf_stats::summary_table().c_str() );
+        printf( "Time of every turn written to %s\n", perf_stats::csv_path().c_str() );
+        DebugLog( D_INFO, DC_ALL ) << "Replay finished after " << state.played << " events";
+        perf_stats::set_csv_dump( false );
+        state.playing = false;
+        state.on_end();
+        // on_end quits the game; if it does not, go on with the keyboard.
+        return input_event();
+    }
+    input_event ev = std::move( state.events.front() );
+    state.events.pop_front();
+    ++state.played;
+    return ev;
+}
+
+} // namespace input_replay
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef CATA_SRC_INPUT_REPLAY_H
+#define CATA_SRC_INPUT_REPLAY_H
+
+#include <functional>
+#include <string>
+
+struct input_event;
+
+// Records the input a session is played with, so that the same session can be played again
+// on another build to compare how fast the turns are.  Started by the --record-replay and
+// --replay command line parameters.
+//
+// The replay file holds the random number seed and then every input event handed out by
+// input_context::handle_input, one JSON array per line.  Playing it back seeds the numbers
+// the same way and hands out the recorded events instead of reading the keyboard, so it
+// only stays in step if it starts from the same save, with the same options and key
+// bindings.  Keep a copy of the world from before the recording, and copy it back before
+// every playback.  The UI is drawn as usual, as the menus and prompts need it to take the
+// same input.  Playing back writes the time of every turn with @ref perf_stats and prints a
+// summary once the events run out.
+
+namespace input_replay
+{
+
+/** Starts writing the events to @p path, the first line being @p seed. */
+bool start_recording( const std::string &path, int seed );
+void stop_recording();
+
+/**
+ * Reads the events of @p path for playing back.
+ * @param seed Set to the seed the recording started with.
+ * @param on_end Called once all the events were played, to quit the game.
+ */
+bool start_playback( const std::string &path, int &seed, const std::function<void()> &on_end );
+
+bool is_recording();
+bool is_playing();
+
+/** Appends @p ev to the recording, if there is one. */
+void record( const input_event &ev );
+
+/**
+ * The next recorded event. Once they are all played, prints the summary, stops playing and
+ * calls the on_end of @ref start_playback; should that return, this returns an error event.
+ */
+input_event next_event();
+
+} // namespace input_replay
+
+#endif // CATA_SRC_INPUT_REPLAY_H
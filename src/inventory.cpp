@@ -223,6 +223,7 @@ inventory inventory::operator+ ( const item &rhs )
 void inventory::unsort()
 {
     binned = false;
+    qualities_indexed = false;
 }
 
 static bool stack_compare( const std::list<item> &lhs, const std::list<item> &rhs )
@@ -234,6 +235,7 @@ void inventory::clear()
 {
     items.clear();
     binned = false;
+    qualities_indexed = false;
 }
 
 void inventory::push_back( const std::list<item> &newits )
@@ -281,6 +283,7 @@ char inventory::find_usable_cached_invlet( const itype_id &item_type )
 item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, bool should_stack )
 {
     binned = false;
+    qualities_indexed = false;
 
     Character &player_character = get_player_character();
     if( should_stack ) {
@@ -377,6 +380,8 @@ void inventory::restack( Character &p )
     // 3. combine matching stacks
 
     binned = false;
+
+    qualities_indexed = false;
     std::list<item> to_restack;
     int idx = 0;
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter, ++idx ) {
@@ -483,6 +488,8 @@ void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Characte
                                bool assign_invlet )
 {
     items.clear();
+    binned = false;
+    qualities_indexed = false;
     provisioned_pseudo_tools.clear();
 
     for( const tripoint &p : pts ) {
@@ -565,6 +572,7 @@ std::list<item> inventory::reduce_stack( const int position, const int quantity
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            qualities_indexed = false;
             if( quantity >= static_cast<int>( iter->size() ) || quantity < 0 ) {
                 ret = *iter;
                 items.erase( iter );
@@ -587,6 +595,7 @@ item inventory::remove_item( const item *it )
     }, 1 );
     if( !tmp.empty() ) {
         binned = false;
+        qualities_indexed = false;
         return tmp.front();
     }
     debugmsg( "Tried to remove a item not in inventory." );
@@ -599,6 +608,7 @@ item inventory::remove_item( const int position )
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            qualities_indexed = false;
             if( iter->size() > 1 ) {
                 std::list<item>::iterator stack_member = iter->begin();
                 char invlet = stack_member->invlet;
@@ -644,6 +654,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
         }
         if( chosen_stack->empty() ) {
             binned = false;
+            qualities_indexed = false;
             items.erase( chosen_stack );
         }
     }
@@ -726,6 +737,7 @@ int inventory::position_by_type( const itype_id &type ) const
 std::list<item> inventory::use_amount( const itype_id &it, int quantity,
                                        const std::function<bool( const item & )> &filter )
 {
+    qualities_indexed = false;
     items.sort( stack_compare );
     std::list<item> ret;
     for( invstack::iterator iter = items.begin(); iter != items.end() && quantity > 0; /* noop */ ) {
@@ -740,6 +752,7 @@ std::list<item> inventory::use_amount( const itype_id &it, int quantity,
         }
         if( iter->empty() ) {
             binned = false;
+            qualities_indexed = false;
             iter = items.erase( iter );
         } else if( iter != items.end() ) {
             ++iter;
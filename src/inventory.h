@@ -266,6 +266,14 @@ class inventory : public visitable
          * `mutable` because this is a pure cache that doesn't affect the contained items.
          */
         mutable itype_bin binned_items;
+
+        mutable bool qualities_indexed = false;
+        /**
+         * For each quality the visited items have, how many of them have it at each level.
+         * Built on demand by @ref has_quality and dropped whenever @ref binned_items is.
+         */
+        mutable std::map<quality_id, std::map<int, int>> quality_index;
+        void index_qualities() const;
 };
 
 #endif // CATA_SRC_INVENTORY_H
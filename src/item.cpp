@@ -10,6 +10,7 @@
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -1260,7 +1261,7 @@ bool item::stacks_with( const item &rhs, bool check_components, bool combine_liq
     // Guns that differ only by dirt/shot_counter can still stack,
     // but other item_vars such as label/note will prevent stacking
     const std::vector<std::string> ignore_keys = { "dirt", "shot_counter", "spawn_location_omt" };
-    if( map_without_keys( item_vars, ignore_keys ) != map_without_keys( rhs.item_vars, ignore_keys ) ) {
+    if( !item_vars.equal_except( rhs.item_vars, ignore_keys ) ) {
         return false;
     }
     const std::string omt_loc_var = "spawn_location_omt";
@@ -1445,11 +1446,11 @@ void item::set_var( const std::string &name, const double value )
 
 double item::get_var( const std::string &name, const double default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const std::string *it = item_vars.find( name );
+    if( it == nullptr ) {
         return default_value;
     }
-    const std::string &val = it->second;
+    const std::string &val = *it;
     char *end;
     errno = 0;
     double result = strtod( &val[0], &end );
@@ -1471,11 +1472,11 @@ void item::set_var( const std::string &name, const tripoint &value )
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const std::string *it = item_vars.find( name );
+    if( it == nullptr ) {
         return default_value;
     }
-    std::vector<std::string> values = string_split( it->second, ',' );
+    std::vector<std::string> values = string_split( *it, ',' );
     cata_assert( values.size() == 3 );
     auto convert_or_error = []( const std::string & s ) {
         ret_val<int> result = try_parse_integer<int>( s, false );
@@ -1498,11 +1499,11 @@ void item::set_var( const std::string &name, const std::string &value )
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const std::string *it = item_vars.find( name );
+    if( it == nullptr ) {
         return default_value;
     }
-    return it->second;
+    return *it;
 }
 
 std::string item::get_var( const std::string &name ) const
@@ -1512,7 +1513,7 @@ std::string item::get_var( const std::string &name ) const
 
 bool item::has_var( const std::string &name ) const
 {
-    return item_vars.count( name ) > 0;
+    return item_vars.contains( name );
 }
 
 void item::erase_var( const std::string &name )
@@ -1983,14 +1984,13 @@ void item::basic_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
 
     if( parts->test( iteminfo_parts::DESCRIPTION ) ) {
         insert_separation_line( info );
-        const std::map<std::string, std::string>::const_iterator idescription =
-            item_vars.find( "description" );
+        const std::string *idescription = item_vars.find( "description" );
         const cata::optional<translation> snippet = SNIPPET.get_snippet_by_id( snip_id );
         if( snippet.has_value() ) {
             // Just use the dynamic description
             info.emplace_back( "DESCRIPTION", snippet.value().translated() );
-        } else if( idescription != item_vars.end() ) {
-            info.emplace_back( "DESCRIPTION", idescription->second );
+        } else if( idescription != nullptr ) {
+            info.emplace_back( "DESCRIPTION", *idescription );
         } else if( has_itype_variant() ) {
             info.emplace_back( "DESCRIPTION", itype_variant().alt_description.translated() );
         } else {
@@ -2085,10 +2085,10 @@ void item::debug_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
             }, enumeration_conjunction::none );
 
             info.emplace_back( "BASE", string_format( _( "flags: %s" ), flags_listed ) );
-            for( auto const &imap : item_vars ) {
+            for( const item_var_map::entry &imap : item_vars ) {
                 info.emplace_back( "BASE",
-                                   string_format( _( "item var: %s, %s" ), imap.first,
-                                                  imap.second ) );
+                                   string_format( _( "item var: %s, %s" ), imap.name(),
+                                                  imap.value ) );
             }
 
             info.emplace_back( "BASE", _( "wetness: " ),
@@ -4798,27 +4798,26 @@ void item::final_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
         }
     }
 
-    std::map<std::string, std::string>::const_iterator item_note = item_vars.find( "item_note" );
+    const std::string *item_note = item_vars.find( "item_note" );
 
-    if( item_note != item_vars.end() && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
+    if( item_note != nullptr && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
         insert_separation_line( info );
         std::string ntext;
-        std::map<std::string, std::string>::const_iterator item_note_tool =
-            item_vars.find( "item_note_tool" );
+        const std::string *item_note_tool = item_vars.find( "item_note_tool" );
         const use_function *use_func =
-            item_note_tool != item_vars.end() ?
+            item_note_tool != nullptr ?
             item_controller->find_template(
-                itype_id( item_note_tool->second ) )->get_use( "inscribe" ) :
+                itype_id( *item_note_tool ) )->get_use( "inscribe" ) :
             nullptr;
         const inscribe_actor *use_actor =
             use_func ? dynamic_cast<const inscribe_actor *>( use_func->get_actor_ptr() ) : nullptr;
         if( use_actor ) {
             //~ %1$s: gerund (e.g. carved), %2$s: item name, %3$s: inscription text
             ntext = string_format( pgettext( "carving", "%1$s on the %2$s is: %3$s" ),
-                                   use_actor->gerund, tname(), item_note->second );
+                                   use_actor->gerund, tname(), *item_note );
         } else {
             //~ %1$s: inscription text
-            ntext = string_format( pgettext( "carving", "Note: %1$s" ), item_note->second );
+            ntext = string_format( pgettext( "carving", "Note: %1$s" ), *item_note );
         }
         info.emplace_back( "DESCRIPTION", ntext );
     }
@@ -5428,8 +5427,57 @@ std::string item::dirt_symbol() const
     return dirt_symbol;
 }
 
+namespace
+{
+
+struct name_cache_key {
+    const item *it;
+    unsigned int quantity;
+    bool with_prefix;
+    unsigned int truncate;
+    bool with_contents;
+
+    bool operator<( const name_cache_key &rhs ) const {
+        return std::tie( it, quantity, with_prefix, truncate, with_contents ) <
+               std::tie( rhs.it, rhs.quantity, rhs.with_prefix, rhs.truncate, rhs.with_contents );
+    }
+};
+
+int name_cache_depth = 0;
+std::map<name_cache_key, std::string> name_cache;
+
+} // namespace
+
+item::scoped_name_cache::scoped_name_cache()
+{
+    ++name_cache_depth;
+}
+
+item::scoped_name_cache::~scoped_name_cache()
+{
+    if( --name_cache_depth == 0 ) {
+        name_cache.clear();
+    }
+}
+
 std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int truncate,
                          bool with_contents ) const
+{
+    if( name_cache_depth == 0 ) {
+        return build_tname( quantity, with_prefix, truncate, with_contents );
+    }
+    const name_cache_key key{ this, quantity, with_prefix, truncate, with_contents };
+    const auto cached = name_cache.find( key );
+    if( cached != name_cache.end() ) {
+        return cached->second;
+    }
+    std::string name = build_tname( quantity, with_prefix, truncate, with_contents );
+    name_cache.emplace( key, name );
+    return name;
+}
+
+std::string item::build_tname( unsigned int quantity, bool with_prefix, unsigned int truncate,
+                               bool with_contents ) const
 {
     // item damage and/or fouling level
     std::string damtext;
@@ -5481,7 +5529,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int t
     std::string maintext;
     std::string contents_suffix_text;
 
-    if( is_corpse() || typeId() == itype_blood || item_vars.find( "name" ) != item_vars.end() ) {
+    if( is_corpse() || typeId() == itype_blood || item_vars.contains( "name" ) ) {
         maintext = type_name( quantity );
     } else if( ( is_gun() || is_tool() || is_magazine() ) && !is_power_armor() ) {
         int amt = 0;
@@ -5681,7 +5729,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int t
         ret = utf8_truncate( ret, truncate + truncate_override );
     }
 
-    if( item_vars.find( "item_note" ) != item_vars.end() ) {
+    if( item_vars.contains( "item_note" ) ) {
         //~ %s is an item name. This style is used to denote items with notes.
         return string_format( _( "*%s*" ), ret );
     } else {
@@ -6328,6 +6376,7 @@ int item::current_reach_range( const Character &guy ) const
 void item::unset_flags()
 {
     item_tags.clear();
+    item_tag_bits.clear();
     requires_tags_processing = true;
 }
 
@@ -6348,7 +6397,7 @@ bool item::has_fault_flag( const std::string &searched_flag ) const
 
 bool item::has_own_flag( const flag_id &f ) const
 {
-    return item_tags.count( f );
+    return item_tag_bits.test( f );
 }
 
 bool item::has_flag( const flag_id &f ) const
@@ -6383,6 +6432,7 @@ item &item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
         item_tags.insert( flag );
+        item_tag_bits.set( flag );
         requires_tags_processing = true;
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
@@ -6393,6 +6443,7 @@ item &item::set_flag( const flag_id &flag )
 item &item::unset_flag( const flag_id &flag )
 {
     item_tags.erase( flag );
+    item_tag_bits.reset( flag );
     requires_tags_processing = true;
     return *this;
 }
@@ -10628,15 +10679,15 @@ bool item_compare_by_charges( const item &left, const item &right )
 static const std::string USED_BY_IDS( "USED_BY_IDS" );
 bool item::already_used_by_player( const Character &p ) const
 {
-    const auto it = item_vars.find( USED_BY_IDS );
-    if( it == item_vars.end() ) {
+    const std::string *it = item_vars.find( USED_BY_IDS );
+    if( it == nullptr ) {
         return false;
     }
     // USED_BY_IDS always starts *and* ends with a ';', the search string
     // ';<id>;' matches at most one part of USED_BY_IDS, and only when exactly that
     // id has been added.
     const std::string needle = string_format( ";%d;", p.getID().get_value() );
-    return it->second.find( needle ) != std::string::npos;
+    return it->find( needle ) != std::string::npos;
 }
 
 void item::mark_as_used_by_player( const Character &p )
@@ -10803,8 +10854,7 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos,
         int enviroment_mod;
         // Toilets and vending machines will try to get the heat radiation and convection during mapgen and segfault.
         if( !g->new_game ) {
-            enviroment_mod = get_heat_radiation( pos, false );
-            enviroment_mod += get_convection_temperature( pos );
+            enviroment_mod = get_weather().get_temperature_mod( pos );
         } else {
             enviroment_mod = 0;
         }
@@ -10813,17 +10863,12 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos,
             local_mod += 5; // body heat increases inventory temperature
         }
 
-        // Process the past of this item in 1h chunks until there is less than 1h left.
-        time_duration time_delta = 1_hours;
-
-        while( now - time > 1_hours ) {
-            time += time_delta;
-
-            // Get the environment temperature
-            // Use weather if above ground, use map temp if below
+        // Get the environment temperature
+        // Use weather if above ground, use map temp if below
+        const auto environment_temperature = [&]( const time_point & at ) {
             double env_temperature = 0;
             if( pos.z >= 0 && flag != temperature_flag::ROOT_CELLAR ) {
-                double weather_temperature = wgen.get_weather_temperature( pos, time, seed );
+                double weather_temperature = wgen.get_weather_temperature( pos, at, seed );
                 env_temperature = weather_temperature + enviroment_mod + local_mod;
             } else {
                 env_temperature = AVERAGE_ANNUAL_TEMPERATURE + enviroment_mod + local_mod;
@@ -10848,6 +10893,29 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos,
                 default:
                     debugmsg( "Temperature flag enum not valid.  Using normal temperature." );
             }
+            return env_temperature;
+        };
+
+        // Below ground and in root cellars the environment does not follow the weather,
+        // so every hour of the past sees the same temperature.
+        const bool steady_environment = pos.z < 0 || flag == temperature_flag::ROOT_CELLAR;
+
+        // Process the past of this item in 1h chunks until there is less than 1h left.
+        while( now - time > 1_hours ) {
+            time_duration time_delta = 1_hours;
+            if( steady_environment ) {
+                // Hours that are too old for temperature to matter, or that start with the item
+                // already at the temperature around it, change nothing but rot.  Rot grows
+                // linearly at a steady temperature, so those hours are taken as one chunk.
+                const int steady_temp = environment_temperature( time );
+                const bool settled = specific_energy >= 0 &&
+                                     std::abs( temp_to_kelvin( steady_temp ) - 0.00001 * temperature ) < 0.9;
+                const int whole_hours = ( now - time - 1_turns ) / 1_hours;
+                const int old_hours = ( now - time - 2_days ) / 1_hours;
+                time_delta = std::max( 1, settled ? whole_hours : old_hours ) * 1_hours;
+            }
+            time += time_delta;
+            const double env_temperature = environment_temperature( time );
 
             // Calculate item temperature from environment temperature
             // If the time was more than 2 d ago we do not care about item temperature.
@@ -11825,7 +11893,7 @@ bool item::is_reloadable() const
 
 std::string item::type_name( unsigned int quantity ) const
 {
-    const auto iter = item_vars.find( "name" );
+    const std::string *iter = item_vars.find( "name" );
     std::string ret_name;
     if( typeId() == itype_blood ) {
         if( corpse == nullptr || corpse->id.is_null() ) {
@@ -11835,8 +11903,8 @@ std::string item::type_name( unsigned int quantity ) const
                                              "%s blood",  quantity ),
                                   corpse->nname() );
         }
-    } else if( iter != item_vars.end() ) {
-        return iter->second;
+    } else if( iter != nullptr ) {
+        return *iter;
     } else if( has_itype_variant() ) {
         ret_name = itype_variant().alt_name.translated();
     } else {
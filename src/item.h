@@ -19,11 +19,13 @@
 #include "cata_utility.h"
 #include "compatibility.h"
 #include "enums.h"
+#include "flag_bitset.h"
 #include "gun_mode.h"
 #include "io_tags.h"
 #include "item_contents.h"
 #include "item_location.h"
 #include "item_pocket.h"
+#include "item_vars.h"
 #include "material.h"
 #include "optional.h"
 #include "requirements.h"
@@ -372,6 +374,21 @@ class item : public visitable
          */
         std::string tname( unsigned int quantity = 1, bool with_prefix = true,
                            unsigned int truncate = 0, bool with_contents = true ) const;
+        /**
+         * While one of these is alive, @ref tname remembers the names it builds, so asking
+         * again for the same item with the same arguments is a lookup.  The remembered names
+         * do not follow changes to the items, so only use this around passes that leave every
+         * item alone, such as gathering and filtering the lists of a menu.  Nested scopes share
+         * the outermost one's names.
+         */
+        class scoped_name_cache
+        {
+            public:
+                scoped_name_cache();
+                ~scoped_name_cache();
+                scoped_name_cache( const scoped_name_cache & ) = delete;
+                scoped_name_cache &operator=( const scoped_name_cache & ) = delete;
+        };
         std::string display_money( unsigned int quantity, unsigned int total,
                                    const cata::optional<unsigned int> &selected = cata::nullopt ) const;
         /**
@@ -2524,6 +2541,9 @@ class item : public visitable
         bool is_collapsed() const;
 
     private:
+        /** The uncached body of @ref tname. */
+        std::string build_tname( unsigned int quantity, bool with_prefix, unsigned int truncate,
+                                 bool with_contents ) const;
         /** migrates an item into this item. */
         void migrate_content_item( const item &contained );
 
@@ -2607,9 +2627,10 @@ class item : public visitable
          */
         bool requires_tags_processing = true;
         FlagsSetType item_tags; // generic item specific flags
+        flag_bitset item_tag_bits; // NOLINT(cata-serialize) mirror of item_tags for has_flag
         safe_reference_anchor anchor;
         const itype *curammo = nullptr;
-        std::map<std::string, std::string> item_vars;
+        item_var_map item_vars;
         const mtype *corpse = nullptr;
         std::string corpse_name;       // Name of the late lamented
         std::set<matec_id> techniques; // item specific techniques
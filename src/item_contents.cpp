@@ -347,7 +347,7 @@ void item_contents::read_mods( const item_contents &read_input )
 {
     for( const item_pocket &pocket : read_input.contents ) {
         if( pocket.saved_type() == item_pocket::pocket_type::MOD ) {
-            for( const item *it : pocket.all_items_top() ) {
+            for( const item *it : pocket.top_items() ) {
                 insert_item( *it, item_pocket::pocket_type::MOD );
             }
         }
@@ -371,7 +371,7 @@ void item_contents::combine( const item_contents &read_input, const bool convert
                     pocket.is_type( item_pocket::pocket_type::MAGAZINE ) ||
                     pocket.is_type( item_pocket::pocket_type::MAGAZINE_WELL ) ) {
                     ++pocket_index;
-                    for( const item *it : pocket.all_items_top() ) {
+                    for( const item *it : pocket.top_items() ) {
                         insert_item( *it, pocket.get_pocket_data()->type );
                     }
                     continue;
@@ -388,7 +388,7 @@ void item_contents::combine( const item_contents &read_input, const bool convert
                     continue;
                 } else if( pocket.saved_type() == item_pocket::pocket_type::MIGRATION ||
                            pocket.saved_type() == item_pocket::pocket_type::CORPSE ) {
-                    for( const item *it : pocket.all_items_top() ) {
+                    for( const item *it : pocket.top_items() ) {
                         insert_item( *it, pocket.saved_type() );
                     }
                     ++pocket_index;
@@ -398,7 +398,7 @@ void item_contents::combine( const item_contents &read_input, const bool convert
             auto current_pocket_iter = contents.begin();
             std::advance( current_pocket_iter, pocket_index );
 
-            for( const item *it : pocket.all_items_top() ) {
+            for( const item *it : pocket.top_items() ) {
                 const ret_val<item_pocket::contain_code> inserted = current_pocket_iter->insert_item( *it );
                 if( !inserted.success() ) {
                     uninserted_items.push_back( *it );
@@ -412,7 +412,7 @@ void item_contents::combine( const item_contents &read_input, const bool convert
             }
             current_pocket_iter->settings = pocket.settings;
         } else {
-            for( const item *it : pocket.all_items_top() ) {
+            for( const item *it : pocket.top_items() ) {
                 uninserted_items.push_back( *it );
             }
         }
@@ -904,7 +904,7 @@ const item &item_contents::first_ammo() const
             continue;
         }
         if( pocket.front().has_flag( json_flag_CASING ) ) {
-            for( const item *i : pocket.all_items_top() ) {
+            for( const item *i : pocket.top_items() ) {
                 if( !i->has_flag( json_flag_CASING ) ) {
                     return *i;
                 }
@@ -1187,9 +1187,9 @@ std::list<item *> item_contents::all_items_top( const std::function<bool( item_p
     std::list<item *> all_items_internal;
     for( item_pocket &pocket : contents ) {
         if( filter( pocket ) ) {
-            std::list<item *> contained_items = pocket.all_items_top();
-            all_items_internal.insert( all_items_internal.end(), contained_items.begin(),
-                                       contained_items.end() );
+            for( item *it : pocket.top_items() ) {
+                all_items_internal.push_back( it );
+            }
         }
     }
     return all_items_internal;
@@ -1215,9 +1215,9 @@ std::list<const item *> item_contents::all_items_top( const
     std::list<const item *> all_items_internal;
     for( const item_pocket &pocket : contents ) {
         if( filter( pocket ) ) {
-            std::list<const item *> contained_items = pocket.all_items_top();
-            all_items_internal.insert( all_items_internal.end(), contained_items.begin(),
-                                       contained_items.end() );
+            for( const item *it : pocket.top_items() ) {
+                all_items_internal.push_back( it );
+            }
         }
     }
     return all_items_internal;
@@ -1301,7 +1301,7 @@ std::vector<const item *> item_contents::mods() const
     std::vector<const item *> mods;
     for( const item_pocket &pocket : contents ) {
         if( pocket.is_type( item_pocket::pocket_type::MOD ) ) {
-            for( const item *it : pocket.all_items_top() ) {
+            for( const item *it : pocket.top_items() ) {
                 mods.insert( mods.end(), it );
             }
         }
@@ -1314,7 +1314,7 @@ std::vector<const item *> item_contents::softwares() const
     std::vector<const item *> softwares;
     for( const item_pocket &pocket : contents ) {
         if( pocket.is_type( item_pocket::pocket_type::SOFTWARE ) ) {
-            for( const item *it : pocket.all_items_top() ) {
+            for( const item *it : pocket.top_items() ) {
                 softwares.insert( softwares.end(), it );
             }
         }
@@ -1327,7 +1327,7 @@ std::vector<item *> item_contents::ebooks()
     std::vector<item *> ebooks;
     for( item_pocket &pocket : contents ) {
         if( pocket.is_type( item_pocket::pocket_type::EBOOK ) ) {
-            for( item *it : pocket.all_items_top() ) {
+            for( item *it : pocket.top_items() ) {
                 ebooks.emplace_back( it );
             }
         }
@@ -1340,7 +1340,7 @@ std::vector<const item *> item_contents::ebooks() const
     std::vector<const item *> ebooks;
     for( const item_pocket &pocket : contents ) {
         if( pocket.is_type( item_pocket::pocket_type::EBOOK ) ) {
-            for( const item *it : pocket.all_items_top() ) {
+            for( const item *it : pocket.top_items() ) {
                 ebooks.emplace_back( it );
             }
         }
@@ -1609,7 +1609,7 @@ units::volume item_contents::total_container_capacity( const bool unrestricted_p
             // item in it or is a pocket that has normal pickup disabled
             // instead of returning the volume return the volume of things contained
             if( pocket.volume_capacity() >= pocket_data::max_volume_for_container ||
-                pocket.settings.is_disabled() || ( p_data->holster && !pocket.all_items_top().empty() ) ) {
+                pocket.settings.is_disabled() || ( p_data->holster && !pocket.empty() ) ) {
                 total_vol += pocket.contains_volume();
             } else {
                 total_vol += pocket.volume_capacity();
@@ -1709,7 +1709,7 @@ units::volume item_contents::get_contents_volume_with_tweaks( const std::map<con
                 ret += pocket->volume_capacity();
             }
         } else {
-            for( const item *i : pocket->all_items_top() ) {
+            for( const item *i : pocket->top_items() ) {
                 if( i->count_by_charges() ) {
                     ret += i->volume() - i->get_selected_stack_volume( without );
                 } else if( !without.count( i ) ) {
@@ -1736,7 +1736,7 @@ units::volume item_contents::get_nested_content_volume_recursive( const
                 ret += pocket->volume_capacity();
             }
         } else {
-            for( const item *i : pocket->all_items_top() ) {
+            for( const item *i : pocket->top_items() ) {
                 if( i->count_by_charges() ) {
                     ret += i->get_selected_stack_volume( without );
                 } else if( without.count( i ) ) {
@@ -625,6 +625,8 @@ void Item_factory::finalize_post( itype &obj )
         }
         return false;
     } );
+    obj.item_tag_bits.assign( obj.item_tags );
+    obj.item_tag_bits_ready = true;
 
     // handle complex firearms as a special case
     if( obj.gun && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON ) ) {
@@ -1394,6 +1396,7 @@ void Item_factory::init()
     // id valid, so it can be used all over the place without need to explicitly check for it.
     m_template_groups[Item_spawn_data_EMPTY_GROUP] =
         std::make_unique<Item_group>( Item_group::G_COLLECTION, 100, 0, 0, "EMPTY_GROUP" );
+    groups_version++;
 }
 
 bool Item_factory::check_ammo_type( std::string &msg, const ammotype &ammo ) const
@@ -3772,6 +3775,7 @@ void Item_factory::reset()
 void Item_factory::clear()
 {
     m_template_groups.clear();
+    groups_version++;
 
     iuse_function_list.clear();
 
@@ -4021,6 +4025,7 @@ void Item_factory::load_item_group( const JsonArray &entries, const item_group_i
     }
     const Item_group::Type type = is_collection ? Item_group::G_COLLECTION : Item_group::G_DISTRIBUTION;
     std::unique_ptr<Item_spawn_data> &isd = m_template_groups[group_id];
+    groups_version++;
     Item_group *const ig =
         make_group_or_throw( group_id, isd, type, ammo_chance, magazine_chance, context );
 
@@ -4036,6 +4041,7 @@ void Item_factory::load_item_group( const JsonObject &jsobj, const item_group_id
         context = group_id.str();
     }
     std::unique_ptr<Item_spawn_data> &isd = m_template_groups[group_id];
+    groups_version++;
 
     Item_group::Type type = Item_group::G_COLLECTION;
     if( subtype == "old" || subtype == "distribution" ) {
@@ -4314,11 +4320,8 @@ void item_group::debug_spawn()
         }
         // Spawn items from the group 100 times
         std::map<std::string, int> itemnames;
-        for( size_t a = 0; a < 100; a++ ) {
-            const auto items = items_from( groups[index], calendar::turn );
-            for( const item &it : items ) {
-                itemnames[it.display_name()]++;
-            }
+        for( const item &it : items_from( groups[index], calendar::turn, 100 ) ) {
+            itemnames[it.display_name()]++;
         }
         // Invert the map to get sorting!
         std::multimap<int, std::string> itemnames2;
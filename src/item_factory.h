@@ -149,6 +149,13 @@ class Item_factory
          * Get the item group object. Returns null if the item group does not exists.
          */
         Item_spawn_data *get_group( const item_group_id & );
+        /**
+         * Changes whenever an item group object is created, replaced or dropped, so the
+         * pointers @ref get_group returned are still valid as long as this stays the same.
+         */
+        int get_groups_version() const {
+            return groups_version;
+        }
         /**
          * Returns the idents of all item groups that are known.
          */
@@ -275,6 +282,7 @@ class Item_factory
 
         using GroupMap = std::map<item_group_id, std::unique_ptr<Item_spawn_data>>;
         GroupMap m_template_groups;
+        int groups_version = 0;
 
         std::unordered_map<itype_id, ammotype> migrated_ammo;
         std::unordered_map<itype_id, itype_id> migrated_magazines;
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <iterator>
 #include <new>
 #include <set>
 #include <string>
@@ -169,7 +170,7 @@ item Single_item_creator::create_single( const time_point &birthday, RecursionLi
             return item( null_item_id, birthday );
         }
         rec.push_back( group_id );
-        Item_spawn_data *isd = item_controller->get_group( group_id );
+        Item_spawn_data *isd = get_group();
         if( isd == nullptr ) {
             debugmsg( "unknown item spawn list %s", id.c_str() );
             return item( null_item_id, birthday );
@@ -217,7 +218,8 @@ Item_spawn_data::ItemList Single_item_creator::create(
                       modifier_count.first, modifier_count.second );
         }
     }
-    float spawn_rate = get_option<float>( "ITEM_SPAWNRATE" );
+    const float spawn_rate = flags & spawn_flags::use_spawn_rate ?
+                             get_option<float>( "ITEM_SPAWNRATE" ) : 1.0f;
     for( ; cnt > 0; cnt-- ) {
         if( type == S_ITEM ) {
             const item itm = create_single( birthday, rec );
@@ -235,7 +237,7 @@ Item_spawn_data::ItemList Single_item_creator::create(
                 return result;
             }
             rec.push_back( group_id );
-            Item_spawn_data *isd = item_controller->get_group( group_id );
+            Item_spawn_data *isd = get_group();
             if( isd == nullptr ) {
                 debugmsg( "unknown item spawn list %s", id.c_str() );
                 return result;
@@ -259,6 +261,16 @@ Item_spawn_data::ItemList Single_item_creator::create(
     return result;
 }
 
+Item_spawn_data *Single_item_creator::get_group() const
+{
+    const int version = item_controller->get_groups_version();
+    if( group_version != version ) {
+        group = item_controller->get_group( item_group_id( id ) );
+        group_version = version;
+    }
+    return group;
+}
+
 void Single_item_creator::check_consistency() const
 {
     if( type == S_ITEM ) {
@@ -643,6 +655,7 @@ void Item_group::add_entry( std::unique_ptr<Item_spawn_data> ptr )
         ptr->set_probablility( std::min( 100, ptr->get_probability( true ) ) );
     }
     sum_prob += ptr->get_probability( true );
+    prob_sums.push_back( sum_prob );
 
     // Make the ammo and magazine probabilities from the outer entity apply to the nested entity:
     // If ptr is an Item_group, it already inherited its parent's ammo/magazine chances in its constructor.
@@ -653,6 +666,22 @@ void Item_group::add_entry( std::unique_ptr<Item_spawn_data> ptr )
     items.push_back( std::move( ptr ) );
 }
 
+const Item_spawn_data *Item_group::pick_entry() const
+{
+    const int p = rng( 0, sum_prob - 1 );
+    // The roll lands on the first entry whose running sum exceeds it.  Entries of holidays
+    // that are not on pass it on to the next entry.
+    const size_t first = std::upper_bound( prob_sums.begin(), prob_sums.end(), p ) -
+                         prob_sums.begin();
+    for( size_t i = first; i < items.size(); ++i ) {
+        const Item_spawn_data &elem = *items[i];
+        if( !elem.is_event_based() || elem.get_probability( false ) != 0 ) {
+            return &elem;
+        }
+    }
+    return nullptr;
+}
+
 Item_spawn_data::ItemList Item_group::create(
     const time_point &birthday, RecursionList &rec, spawn_flags flags ) const
 {
@@ -666,18 +695,9 @@ Item_spawn_data::ItemList Item_group::create(
             result.insert( result.end(), tmp.begin(), tmp.end() );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
+        if( const Item_spawn_data *elem = pick_entry() ) {
             ItemList tmp = elem->create( birthday, rec, flags );
             result.insert( result.end(), tmp.begin(), tmp.end() );
-            break;
         }
     }
     put_into_container( result, container_item, birthday, on_overflow, context() );
@@ -695,15 +715,7 @@ item Item_group::create_single( const time_point &birthday, RecursionList &rec )
             return elem->create_single( birthday, rec );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
+        if( const Item_spawn_data *elem = pick_entry() ) {
             return elem->create_single( birthday, rec );
         }
     }
@@ -755,6 +767,12 @@ bool Item_group::remove_item( const itype_id &itemid )
             ++a;
         }
     }
+    prob_sums.clear();
+    int running_sum = 0;
+    for( const std::unique_ptr<Item_spawn_data> &elem : items ) {
+        running_sum += elem->get_probability( true );
+        prob_sums.push_back( running_sum );
+    }
     return items.empty();
 }
 
@@ -800,6 +818,22 @@ item_group::ItemList item_group::items_from( const item_group_id &group_id )
     return items_from( group_id, calendar::turn_zero );
 }
 
+item_group::ItemList item_group::items_from( const item_group_id &group_id,
+        const time_point &birthday, const int count, spawn_flags flags )
+{
+    ItemList result;
+    const Item_spawn_data *group = item_controller->get_group( group_id );
+    if( group == nullptr ) {
+        return result;
+    }
+    for( int i = 0; i < count; i++ ) {
+        ItemList tmp = group->create( birthday, flags );
+        result.insert( result.end(), std::make_move_iterator( tmp.begin() ),
+                       std::make_move_iterator( tmp.end() ) );
+    }
+    return result;
+}
+
 item item_group::item_from( const item_group_id &group_id, const time_point &birthday )
 {
     const Item_spawn_data *group = item_controller->get_group( group_id );
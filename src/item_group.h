@@ -69,6 +69,12 @@ ItemList items_from( const item_group_id &group_id, const time_point &birthday,
  * Same as above but with implicit birthday at turn 0.
  */
 ItemList items_from( const item_group_id &group_id );
+/**
+ * Create items from the given group count times, as count calls of the function above
+ * would, and return all of them in one list.
+ */
+ItemList items_from( const item_group_id &group_id, const time_point &birthday, int count,
+                     spawn_flags flags = spawn_flags::none );
 /**
  * Check whether a specific item group contains a specific item type.
  */
@@ -329,6 +335,14 @@ class Single_item_creator : public Item_spawn_data
 
         bool has_item( const itype_id &itemid ) const override;
         std::set<const itype *> every_item() const override;
+
+    private:
+        /** The group id names (if type is S_ITEM_GROUP), or nullptr if it does not exist. */
+        Item_spawn_data *get_group() const;
+
+        mutable Item_spawn_data *group = nullptr;
+        /** The @ref Item_factory::get_groups_version group was looked up at. */
+        mutable int group_version = -1;
 };
 
 /**
@@ -393,6 +407,13 @@ class Item_group : public Item_spawn_data
          * that this group contains.
          */
         int sum_prob;
+        /**
+         * The running sums of the entries' probabilities, so a G_DISTRIBUTION can find
+         * the entry a roll lands on by binary search.
+         */
+        std::vector<int> prob_sums;
+        /** The entry of a G_DISTRIBUTION chosen by one roll, or nullptr for none. */
+        const Item_spawn_data *pick_entry() const;
         /**
          * Links to the entries in this group.
          */
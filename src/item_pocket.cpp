@@ -1415,7 +1415,7 @@ bool item_pocket::can_reload_with( const item &ammo, const bool now ) const
                 return false;
             }
 
-            for( const item *loaded : all_items_top() ) {
+            for( const item *loaded : top_items() ) {
                 if( loaded->has_flag( flag_CASING ) ) {
                     continue;
                 }
@@ -1786,7 +1786,7 @@ std::string item_pocket::get_description() const
 bool item_pocket::holster_full() const
 {
     const pocket_data *p_data = get_pocket_data();
-    return p_data->holster && !all_items_top().empty();
+    return p_data->holster && !empty();
 }
 
 bool item_pocket::is_valid() const
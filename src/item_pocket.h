@@ -161,6 +161,50 @@ class item_pocket
 
         const pocket_data *get_pocket_data() const;
 
+        /**
+         * Pointers to the items directly in this pocket, walked in place.  Prefer this over
+         * all_items_top() when the result is only iterated, as it builds no list.
+         */
+        template<typename Iterator>
+        class top_item_range
+        {
+            public:
+                class iterator
+                {
+                    public:
+                        explicit iterator( Iterator it ) : it( it ) {}
+                        auto operator*() const -> decltype( &*std::declval<Iterator>() ) {
+                            return &*it;
+                        }
+                        iterator &operator++() {
+                            ++it;
+                            return *this;
+                        }
+                        bool operator!=( const iterator &rhs ) const {
+                            return it != rhs.it;
+                        }
+                    private:
+                        Iterator it;
+                };
+
+                top_item_range( Iterator first, Iterator last ) : first( first ), last( last ) {}
+                iterator begin() const {
+                    return iterator( first );
+                }
+                iterator end() const {
+                    return iterator( last );
+                }
+            private:
+                Iterator first;
+                Iterator last;
+        };
+        top_item_range<std::list<item>::iterator> top_items() {
+            return { contents.begin(), contents.end() };
+        }
+        top_item_range<std::list<item>::const_iterator> top_items() const {
+            return { contents.cbegin(), contents.cend() };
+        }
+
         std::list<item *> all_items_top();
         std::list<const item *> all_items_top() const;
         std::list<item *> all_items_ptr( pocket_type pk_type );
@@ -23,41 +23,45 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             filter = filter.substr( colon + 1 );
         }
     }
+    // Lowered once here rather than for every item the filter is run on.
+    const lcmatch_query query( filter );
     switch( flag ) {
         // category
         case 'c':
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category_of_contents().name(), filter );
+            return [query]( const item & i ) {
+                return query.matches( i.get_category_of_contents().name() );
             };
         // material
         case 'm':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 return std::any_of( i.made_of().begin(), i.made_of().end(),
-                [&filter]( const std::pair<material_id, int> &mat ) {
-                    return lcmatch( mat.first->name(), filter );
+                [&query]( const std::pair<material_id, int> &mat ) {
+                    return query.matches( mat.first->name() );
                 } );
             };
         // qualities
         case 'q':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 return std::any_of( i.quality_of().begin(), i.quality_of().end(),
-                [&filter]( const std::pair<quality_id, int> &e ) {
-                    return lcmatch( e.first->name, filter );
+                [&query]( const std::pair<quality_id, int> &e ) {
+                    return query.matches( e.first->name );
                 } );
             };
         // both
-        case 'b':
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
+        case 'b': {
+            const auto pair = get_both( filter );
+            std::function<bool( const item & )> first = item_filter_from_string( pair.first );
+            std::function<bool( const item & )> second = item_filter_from_string( pair.second );
+            return [first, second]( const item & i ) {
+                return first( i ) && second( i );
             };
+        }
         // disassembled components
         case 'd':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 const auto &components = i.get_uncraft_components();
                 for( const item_comp &component : components ) {
-                    if( lcmatch( component.to_string(), filter ) ) {
+                    if( query.matches( component.to_string() ) ) {
                         return true;
                     }
                 }
@@ -65,22 +69,22 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             };
         // item notes
         case 'n':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 const std::string note = i.get_var( "item_note" );
-                return !note.empty() && lcmatch( note, filter );
+                return !note.empty() && query.matches( note );
             };
         // by book skill
         case 's':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 if( get_avatar().has_identified( i.typeId() ) ) {
-                    return lcmatch( i.get_book_skill(), filter );
+                    return query.matches( i.get_book_skill() );
                 }
                 return false;
             };
         // by name
         default:
-            return [filter]( const item & a ) {
-                return lcmatch( a.tname(), filter );
+            return [query]( const item & a ) {
+                return query.matches( a.tname() );
             };
     }
 }
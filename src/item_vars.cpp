@@ -0,0 +1,131 @@
+#include "item_vars.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "json.h"
+
+namespace
+{
+
+struct var_names {
+    std::unordered_map<std::string, int> keys;
+    std::vector<std::string> names;
+};
+
+var_names &get_var_names()
+{
+    static var_names data;
+    return data;
+}
+
+} // namespace
+
+const std::string &item_var_map::entry::name() const
+{
+    return get_var_names().names[key];
+}
+
+int item_var_map::lookup( const std::string &name )
+{
+    const var_names &table = get_var_names();
+    const auto it = table.keys.find( name );
+    return it == table.keys.end() ? -1 : it->second;
+}
+
+int item_var_map::intern( const std::string &name )
+{
+    var_names &table = get_var_names();
+    const auto inserted = table.keys.emplace( name, static_cast<int>( table.names.size() ) );
+    if( inserted.second ) {
+        table.names.push_back( name );
+    }
+    return inserted.first->second;
+}
+
+const std::string *item_var_map::find( const std::string &name ) const
+{
+    if( entries.empty() ) {
+        return nullptr;
+    }
+    const int key = lookup( name );
+    for( const entry &e : entries ) {
+        if( e.key == key ) {
+            return &e.value;
+        }
+    }
+    return nullptr;
+}
+
+std::string &item_var_map::operator[]( const std::string &name )
+{
+    const int key = intern( name );
+    auto it = entries.begin();
+    for( ; it != entries.end(); ++it ) {
+        if( it->key == key ) {
+            return it->value;
+        }
+        if( it->name() > name ) {
+            break;
+        }
+    }
+    return entries.insert( it, entry{ key, std::string() } )->value;
+}
+
+void item_var_map::erase( const std::string &name )
+{
+    if( entries.empty() ) {
+        return;
+    }
+    const int key = lookup( name );
+    const auto it = std::find_if( entries.begin(), entries.end(), [key]( const entry & e ) {
+        return e.key == key;
+    } );
+    if( it != entries.end() ) {
+        entries.erase( it );
+    }
+}
+
+bool item_var_map::equal_except( const item_var_map &rhs,
+                                 const std::vector<std::string> &ignored ) const
+{
+    std::vector<int> ignored_keys;
+    for( const std::string &name : ignored ) {
+        ignored_keys.push_back( lookup( name ) );
+    }
+    const auto is_kept = [&]( const entry & e ) {
+        return std::find( ignored_keys.begin(), ignored_keys.end(), e.key ) == ignored_keys.end();
+    };
+    auto a = entries.begin();
+    auto b = rhs.entries.begin();
+    while( true ) {
+        a = std::find_if( a, entries.end(), is_kept );
+        b = std::find_if( b, rhs.entries.end(), is_kept );
+        if( a == entries.end() || b == rhs.entries.end() ) {
+            return a == entries.end() && b == rhs.entries.end();
+        }
+        if( !( *a == *b ) ) {
+            return false;
+        }
+        ++a;
+        ++b;
+    }
+}
+
+void item_var_map::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    for( const entry &e : entries ) {
+        jsout.member( e.name(), e.value );
+    }
+    jsout.end_object();
+}
+
+void item_var_map::deserialize( JsonIn &jsin )
+{
+    entries.clear();
+    JsonObject jo = jsin.get_object();
+    for( JsonMember member : jo ) {
+        ( *this )[member.name()] = member.get_string();
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef CATA_SRC_ITEM_VARS_H
+#define CATA_SRC_ITEM_VARS_H
+
+#include <string>
+#include <vector>
+
+class JsonIn;
+class JsonOut;
+
+/**
+ * The named string variables of an item (see item::set_var).
+ *
+ * Names are interned into one process-wide table, so each entry only stores a small
+ * int key next to its value.  Entries live in a vector kept sorted by name, which keeps
+ * iteration and the saved JSON in the same order a std::map would give.  Items rarely
+ * carry more than a handful of variables, so lookups just scan the vector.
+ */
+class item_var_map
+{
+    public:
+        struct entry {
+            int key;
+            std::string value;
+
+            const std::string &name() const;
+
+            bool operator==( const entry &rhs ) const {
+                return key == rhs.key && value == rhs.value;
+            }
+        };
+
+        using const_iterator = std::vector<entry>::const_iterator;
+
+        /** The value stored under name, or nullptr if there is none. */
+        const std::string *find( const std::string &name ) const;
+        /** The value stored under name, inserted as an empty string if there was none. */
+        std::string &operator[]( const std::string &name );
+        bool contains( const std::string &name ) const {
+            return find( name ) != nullptr;
+        }
+        void erase( const std::string &name );
+        /** Erase every entry whose name matches pred. */
+        template<typename Predicate>
+        void erase_if( Predicate pred ) {
+            for( auto it = entries.begin(); it != entries.end(); ) {
+                if( pred( it->name() ) ) {
+                    it = entries.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+        }
+        void clear() {
+            entries.clear();
+        }
+
+        bool empty() const {
+            return entries.empty();
+        }
+        size_t size() const {
+            return entries.size();
+        }
+        const_iterator begin() const {
+            return entries.begin();
+        }
+        const_iterator end() const {
+            return entries.end();
+        }
+
+        /** Whether both maps hold the same entries once the named ones are left out. */
+        bool equal_except( const item_var_map &rhs, const std::vector<std::string> &ignored ) const;
+
+        bool operator==( const item_var_map &rhs ) const {
+            return entries == rhs.entries;
+        }
+        bool operator!=( const item_var_map &rhs ) const {
+            return !( *this == rhs );
+        }
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( JsonIn &jsin );
+
+    private:
+        /** The interned key of name, or -1 if no item variable ever used it. */
+        static int lookup( const std::string &name );
+        static int intern( const std::string &name );
+
+        std::vector<entry> entries;
+};
+
+#endif // CATA_SRC_ITEM_VARS_H
@@ -91,7 +91,7 @@ bool itype::has_use() const
 
 bool itype::has_flag( const flag_id &flag ) const
 {
-    return item_tags.count( flag );
+    return item_tag_bits_ready ? item_tag_bits.test( flag ) : item_tags.count( flag ) > 0;
 }
 
 const itype::FlagsSetType &itype::get_flags() const
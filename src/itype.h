@@ -18,6 +18,7 @@
 #include "damage.h"
 #include "enums.h" // point
 #include "explosion.h"
+#include "flag_bitset.h"
 #include "game_constants.h"
 #include "item_pocket.h"
 #include "iuse.h" // use_function
@@ -1110,6 +1111,9 @@ struct itype {
 
     private:
         FlagsSetType item_tags;
+        /** Mirror of @ref item_tags for has_flag, filled by Item_factory::finalize_post */
+        flag_bitset item_tag_bits;
+        bool item_tag_bits_ready = false;
 
     public:
         // How should the item explode
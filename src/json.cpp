@@ -33,6 +33,36 @@ static bool is_whitespace( char ch )
     return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r';
 }
 
+// std::istream::get and peek build a sentry for every character they read.  The parser
+// reads one character at a time, so it goes to the stream's buffer directly instead and
+// only touches the stream state when the input runs out, as get and peek would.
+static int buffered_peek( std::istream &stream )
+{
+    if( !stream.good() ) {
+        return stream.peek();
+    }
+    const int ch = stream.rdbuf()->sgetc();
+    if( ch == std::char_traits<char>::eof() ) {
+        stream.setstate( std::ios::eofbit );
+    }
+    return ch;
+}
+
+static bool buffered_get( std::istream &stream, char &ch )
+{
+    if( !stream.good() ) {
+        stream.setstate( std::ios::failbit );
+        return false;
+    }
+    const int got = stream.rdbuf()->sbumpc();
+    if( got == std::char_traits<char>::eof() ) {
+        stream.setstate( std::ios::eofbit | std::ios::failbit );
+        return false;
+    }
+    ch = static_cast<char>( got );
+    return true;
+}
+
 // Thw following function would fit more logically in catacharset.cpp, but it's
 // needed for the json formatter and we can't easily include that file in that
 // binary.
@@ -89,10 +119,9 @@ JsonObject::JsonObject( JsonIn &j )
     while( !jsin->end_object() ) {
         std::string n = jsin->get_member_name();
         int p = jsin->tell();
-        if( positions.count( n ) > 0 ) {
+        if( !positions.emplace( std::move( n ), p ).second ) {
             j.error( "duplicate entry in json object" );
         }
-        positions[n] = p;
         jsin->skip_value();
     }
     end_ = jsin->tell();
@@ -796,7 +825,7 @@ int JsonIn::tell()
 }
 char JsonIn::peek()
 {
-    return static_cast<char>( stream->peek() );
+    return static_cast<char>( buffered_peek( *stream ) );
 }
 bool JsonIn::good()
 {
@@ -813,7 +842,7 @@ void JsonIn::seek( int pos )
 void JsonIn::eat_whitespace()
 {
     while( is_whitespace( peek() ) ) {
-        stream->get();
+        stream->rdbuf()->sbumpc();
     }
 }
 
@@ -877,7 +906,7 @@ void JsonIn::skip_pair_separator()
 {
     char ch;
     eat_whitespace();
-    stream->get( ch );
+    buffered_get( *stream, ch );
     if( ch != ':' ) {
         std::stringstream err;
         err << "expected pair separator ':', not '" << ch << "'";
@@ -892,16 +921,16 @@ void JsonIn::skip_string()
 {
     char ch;
     eat_whitespace();
-    stream->get( ch );
+    buffered_get( *stream, ch );
     if( ch != '"' ) {
         std::stringstream err;
         err << "expecting string but found '" << ch << "'";
         error( err.str(), -1 );
     }
     while( stream->good() ) {
-        stream->get( ch );
+        buffered_get( *stream, ch );
         if( ch == '\\' ) {
-            stream->get( ch );
+            buffered_get( *stream, ch );
             continue;
         } else if( ch == '"' ) {
             break;
@@ -962,6 +991,34 @@ void JsonIn::skip_array()
     // end_value called by end_array
 }
 
+int JsonIn::count_rle_array()
+{
+    const int start = tell();
+    const bool start_ate_separator = ate_separator;
+    int count = 0;
+    try {
+        start_array();
+        while( !end_array() ) {
+            if( test_array() ) {
+                start_array();
+                skip_value();
+                count += std::max( get_int(), 0 );
+                while( !end_array() ) {
+                    skip_value();
+                }
+            } else {
+                skip_value();
+                ++count;
+            }
+        }
+    } catch( const JsonError & ) {
+        count = 0;
+    }
+    seek( start );
+    ate_separator = start_ate_separator;
+    return count;
+}
+
 void JsonIn::skip_true()
 {
     char text[5];
@@ -1007,7 +1064,7 @@ void JsonIn::skip_number()
     eat_whitespace();
     // skip all of (+-0123456789.eE)
     while( stream->good() ) {
-        stream->get( ch );
+        buffered_get( *stream, ch );
         if( ch != '+' && ch != '-' && ( ch < '0' || ch > '9' ) &&
             ch != 'e' && ch != 'E' && ch != '.' ) {
             stream->unget();
@@ -1031,14 +1088,14 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
         return false;
     }
     char ch;
-    stream.get( ch );
+    buffered_get( stream, ch );
     if( !stream.good() ) {
         err = "read operation failed";
         return false;
     }
     if( ch == '\\' ) {
         // converting \", \\, \/, \b, \f, \n, \r, \t and \uxxxx according to JSON spec.
-        stream.get( ch );
+        buffered_get( stream, ch );
         if( !stream.good() ) {
             err = "read operation failed";
             return false;
@@ -1071,7 +1128,7 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
             case 'u': {
                     uint32_t u = 0;
                     for( int i = 0; i < 4; ++i ) {
-                        stream.get( ch );
+                        buffered_get( stream, ch );
                         if( !stream.good() ) {
                             err = "read operation failed";
                             return false;
@@ -1132,7 +1189,7 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
         }
         s += ch;
         for( ; n > 0; --n ) {
-            stream.get( ch );
+            buffered_get( stream, ch );
             if( !stream.good() ) {
                 err = "read operation failed";
                 return false;
@@ -1162,7 +1219,7 @@ std::string JsonIn::get_string()
     bool success = false;
     do {
         // the first character had better be a '"'
-        stream->get( ch );
+        buffered_get( *stream, ch );
         if( !stream->good() ) {
             err = "read operation failed";
             break;
@@ -1173,16 +1230,22 @@ std::string JsonIn::get_string()
         }
         // add chars to the string, one at a time
         do {
-            ch = stream->peek();
+            ch = buffered_peek( *stream );
             if( !stream->good() ) {
                 err = "read operation failed";
                 break;
             }
             if( ch == '"' ) {
-                stream->ignore();
+                stream->rdbuf()->sbumpc();
                 success = true;
                 break;
             }
+            // Most of any string is plain ASCII, which needs no decoding.
+            if( ch >= 0x20 && ch != '\\' ) {
+                s += ch;
+                stream->rdbuf()->sbumpc();
+                continue;
+            }
             if( !get_escaped_or_unicode( *stream, s, err ) ) {
                 break;
             }
@@ -1334,11 +1397,11 @@ number_sci_notation JsonIn::get_any_number()
     number_sci_notation ret;
     int mod_e = 0;
     eat_whitespace();
-    if( !stream->get( ch ) ) {
+    if( !buffered_get( *stream, ch ) ) {
         error( "unexpected end of input", 0 );
     }
     if( ( ret.negative = ch == '-' ) ) {
-        if( !stream->get( ch ) ) {
+        if( !buffered_get( *stream, ch ) ) {
             error( "unexpected end of input", 0 );
         }
     } else if( ch != '.' && ( ch < '0' || ch > '9' ) ) {
@@ -1349,7 +1412,7 @@ number_sci_notation JsonIn::get_any_number()
     }
     if( ch == '0' ) {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get( ch );
+        buffered_get( *stream, ch );
         if( ch >= '0' && ch <= '9' ) {
             error( "leading zeros not allowed", -1 );
         }
@@ -1357,31 +1420,31 @@ number_sci_notation JsonIn::get_any_number()
     while( ch >= '0' && ch <= '9' ) {
         ret.number *= 10;
         ret.number += ( ch - '0' );
-        if( !stream->get( ch ) ) {
+        if( !buffered_get( *stream, ch ) ) {
             break;
         }
     }
     if( ch == '.' ) {
-        while( stream->get( ch ) && ch >= '0' && ch <= '9' ) {
+        while( buffered_get( *stream, ch ) && ch >= '0' && ch <= '9' ) {
             ret.number *= 10;
             ret.number += ( ch - '0' );
             mod_e -= 1;
         }
     }
     if( stream && ( ch == 'e' || ch == 'E' ) ) {
-        if( !stream->get( ch ) ) {
+        if( !buffered_get( *stream, ch ) ) {
             error( "unexpected end of input", 0 );
         }
         bool neg;
         if( ( neg = ch == '-' ) || ch == '+' ) {
-            if( !stream->get( ch ) ) {
+            if( !buffered_get( *stream, ch ) ) {
                 error( "unexpected end of input", 0 );
             }
         }
         while( ch >= '0' && ch <= '9' ) {
             ret.exp *= 10;
             ret.exp += ( ch - '0' );
-            if( !stream->get( ch ) ) {
+            if( !buffered_get( *stream, ch ) ) {
                 break;
             }
         }
@@ -2182,21 +2245,50 @@ void JsonOut::write_null()
     need_separator = true;
 }
 
-void JsonOut::write( const std::string &val )
+void JsonOut::write_unsigned( unsigned long long val )
+{
+    char digits[std::numeric_limits<unsigned long long>::digits10 + 1];
+    char *const end = digits + sizeof( digits );
+    char *first = end;
+    do {
+        *--first = static_cast<char>( '0' + val % 10 );
+        val /= 10;
+    } while( val != 0 );
+    stream->write( first, end - first );
+}
+
+void JsonOut::write_signed( long long val )
+{
+    if( val < 0 ) {
+        stream->put( '-' );
+        // Negate as unsigned, which is also right for the lowest value.
+        write_unsigned( 0ULL - static_cast<unsigned long long>( val ) );
+    } else {
+        write_unsigned( val );
+    }
+}
+
+void JsonOut::write_string( const char *val, size_t length )
 {
     if( need_separator ) {
         write_separator();
     }
     stream->put( '"' );
-    for( const auto &i : val ) {
-        unsigned char ch = i;
+    // Nearly every character is written as it is, so they are written in runs between
+    // the ones that need escaping, rather than one by one.
+    const char *run = val;
+    const char *const end = val + length;
+    for( const char *p = val; p != end; ++p ) {
+        unsigned char ch = *p;
+        if( ch >= 0x20 && ch != '"' && ch != '\\' ) {
+            continue;
+        }
+        stream->write( run, p - run );
+        run = p + 1;
         if( ch == '"' ) {
             stream->write( "\\\"", 2 );
         } else if( ch == '\\' ) {
             stream->write( "\\\\", 2 );
-        } else if( ch == '/' ) {
-            // don't technically need to escape this
-            stream->put( '/' );
         } else if( ch == '\b' ) {
             stream->write( "\\b", 2 );
         } else if( ch == '\f' ) {
@@ -2207,7 +2299,7 @@ void JsonOut::write( const std::string &val )
             stream->write( "\\r", 2 );
         } else if( ch == '\t' ) {
             stream->write( "\\t", 2 );
-        } else if( ch < 0x20 ) {
+        } else {
             // convert to "\uxxxx" unicode escape
             stream->write( "\\u00", 4 );
             stream->put( ( ch < 0x10 ) ? '0' : '1' );
@@ -2217,10 +2309,9 @@ void JsonOut::write( const std::string &val )
             } else {
                 stream->put( 'A' + ( remainder - 0x0A ) );
             }
-        } else {
-            stream->put( ch );
         }
     }
+    stream->write( run, end - run );
     stream->put( '"' );
     need_separator = true;
 }
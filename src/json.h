@@ -6,6 +6,7 @@
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <map>
@@ -304,6 +305,12 @@ class JsonIn
         void skip_null();
         void skip_number();
 
+        /**
+         * Number of elements in the run-length encoded array ahead (see the colony<item>
+         * overload of JsonOut::write), or 0 if it is malformed.  The stream is left where it was.
+         */
+        int count_rle_array();
+
         // data parsing
         std::string get_string(); // get the next value as a string
         int get_int(); // get the next value as an int
@@ -583,8 +590,10 @@ class JsonIn
                 return error_or_false( throw_on_error, "Expected json array" );
             }
             try {
-                start_array();
                 v.clear();
+                // Without this a pile grows through several colony groups of increasing size.
+                v.reserve( count_rle_array() );
+                start_array();
                 while( !end_array() ) {
                     T element;
                     const int prev_pos = tell();
@@ -743,6 +752,33 @@ class JsonOut
         int indent_level = 0;
         bool need_separator = false;
 
+        // Numbers are what saves write most of. Integers are formatted by hand, which is
+        // much faster than going through the stream operators; floats keep them.
+        void write_number( bool val ) {
+            if( val ) {
+                stream->write( "true", 4 );
+            } else {
+                stream->write( "false", 5 );
+            }
+        }
+        template < typename T, std::enable_if_t < std::is_integral<T>::value &&
+                   std::is_signed<T>::value > * = nullptr >
+        void write_number( T val ) {
+            write_signed( val );
+        }
+        template < typename T, std::enable_if_t < std::is_integral<T>::value &&
+                   !std::is_signed<T>::value > * = nullptr >
+        void write_number( T val ) {
+            write_unsigned( val );
+        }
+        template<typename T, std::enable_if_t<std::is_floating_point<T>::value> * = nullptr>
+        void write_number( T val ) {
+            *stream << val;
+        }
+        void write_signed( long long val );
+        void write_unsigned( unsigned long long val );
+        void write_string( const char *val, size_t length );
+
     public:
         explicit JsonOut( std::ostream &stream, bool pretty_print = false, int depth = 0 );
         JsonOut( const JsonOut & ) = delete;
@@ -779,7 +815,7 @@ class JsonOut
             if( need_separator ) {
                 write_separator();
             }
-            *stream << val;
+            write_number( val );
             need_separator = true;
         }
 
@@ -801,9 +837,11 @@ class JsonOut
         }
 
         // strings need escaping and quoting
-        void write( const std::string &val );
+        void write( const std::string &val ) {
+            write_string( val.data(), val.size() );
+        }
         void write( const char *val ) {
-            write( std::string( val ) );
+            write_string( val, std::strlen( val ) );
         }
 
         // char should always be written as an unquoted numeral
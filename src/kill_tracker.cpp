@@ -136,6 +136,12 @@ static int compute_kill_xp( const mtype_id &mon_type )
 
 static constexpr int npc_kill_xp = 10;
 
+bool kill_tracker::handles( const event_type type ) const
+{
+    return type == event_type::character_kills_monster ||
+           type == event_type::character_kills_character;
+}
+
 void kill_tracker::notify( const cata::event &e )
 {
     switch( e.type() ) {
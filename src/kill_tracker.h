@@ -39,6 +39,7 @@ class kill_tracker : public event_subscriber
         void clear();
 
         void notify( const cata::event & ) override;
+        bool handles( event_type ) const override;
 
         void serialize( JsonOut & ) const;
         void deserialize( const JsonObject &data );
@@ -6,14 +6,24 @@ level_cache::level_cache()
 {
     const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
     transparency_cache_dirty.set();
+    scent_cache_dirty.set();
     outside_cache_dirty = true;
     floor_cache_dirty = false;
+    sunlight_cache_dirty.set();
+    minimap_dirty.set();
     constexpr four_quadrants four_zeros( 0.0f );
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
+    std::fill_n( &sunlight_cache[0][0], map_dimensions, four_zeros );
+    std::fill_n( &sunlight_outside[0][0], map_dimensions, false );
+    std::fill_n( &sunlight_floor[0][0], map_dimensions, false );
+    std::fill_n( &sunlight_transparency[0][0], map_dimensions, 0.0f );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
+    std::fill_n( &buffered_light_transparency[0][0], map_dimensions, 0.0f );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
+    std::fill_n( &scent_blocker_cache[0][0], map_dimensions, false );
+    std::fill_n( &scent_reducer_cache[0][0], map_dimensions, false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &vision_transparency_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
@@ -45,7 +55,11 @@ std::pair<vehicle *, int> level_cache::get_veh_cached_parts( const tripoint &pt
 void level_cache::set_veh_exists_at( const tripoint &pt, bool exists_at )
 {
     veh_cache_cleared = false;
-    veh_exists_at[ pt.x * MAPSIZE_X + pt.y ] = exists_at;
+    const int offset = pt.x * MAPSIZE_X + pt.y;
+    if( veh_exists_at[offset] != exists_at ) {
+        veh_exists_at[offset] = exists_at;
+        minimap_dirty.set( offset );
+    }
 }
 
 void level_cache::set_veh_cached_parts( const tripoint &pt, vehicle &veh, int part_num )
@@ -54,11 +68,25 @@ void level_cache::set_veh_cached_parts( const tripoint &pt, vehicle &veh, int pa
     veh_cached_parts[ pt ] = std::make_pair( &veh, part_num );
 }
 
+bool level_cache::set_floor( const point &p, const bool has_floor )
+{
+    bool &floor = floor_cache[p.x][p.y];
+    if( floor == has_floor ) {
+        return false;
+    }
+    floor = has_floor;
+    floor_gap_count += has_floor ? -1 : 1;
+    no_floor_gaps = floor_gap_count == 0;
+    return true;
+}
+
 void level_cache::clear_vehicle_cache()
 {
     if( veh_cache_cleared ) {
         return;
     }
+    // Both are indexed the same way.
+    minimap_dirty |= veh_exists_at;
     veh_exists_at.reset();
     veh_cached_parts.clear();
     veh_cache_cleared = true;
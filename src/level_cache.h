@@ -4,19 +4,69 @@
 
 #include <array>
 #include <bitset>
+#include <cstdint>
 #include <set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "game_constants.h"
 #include "lightmap.h"
 #include "point.h"
 #include "reachability_cache.h"
 #include "shadowcasting.h"
+#include "units.h"
 #include "value_ptr.h"
 
 class vehicle;
 
+// Rays cast by one bulk light source (see map::add_light_source), kept between turns so that
+// generate_lightmap only has to recast the sources that changed or had nearby transparency change.
+struct buffered_light_contribution {
+    float luminance = 0.0f;
+    // Which of the four cardinal cones were cast, see map::apply_light_source
+    uint8_t directions = 0;
+    // Chebyshev radius around the source bounding every tile the cast read or wrote
+    int radius = 0;
+    // Value of level_cache::buffered_light_generation when this was last applied
+    int generation = 0;
+    // Value of level_cache::light_transparency_generation when this was cast
+    int transparency_generation = 0;
+    std::vector<std::pair<point, four_quadrants>> cells;
+};
+
+// Rays cast by one map::apply_light_arc call, e.g. a vehicle headlight, kept between turns so
+// that lights which did not move and whose surroundings did not change are not recast.
+struct cached_light_arc {
+    point origin;
+    units::angle angle = 0_degrees;
+    units::angle width = 0_degrees;
+    float luminance = 0.0f;
+    int radius = 0;
+    // Value of level_cache::light_transparency_generation when this was cast
+    int transparency_generation = 0;
+    // Value of map::light_pass when this was last applied
+    int pass = 0;
+    std::vector<std::pair<point, four_quadrants>> cells;
+};
+
+// What map::build_sunlight_cache computed a level's sunlight_cache with, see there.
+struct sunlight_cache_key {
+    // 0: wholly outside, 1: wholly inside, 2: tile by tile; -1 if never computed
+    int mode = -1;
+    float outside_light_level = 0.0f;
+    float inside_light_level = 0.0f;
+    float sight_penalty = 0.0f;
+
+    bool operator==( const sunlight_cache_key &rhs ) const {
+        return mode == rhs.mode && outside_light_level == rhs.outside_light_level &&
+               inside_light_level == rhs.inside_light_level && sight_penalty == rhs.sight_penalty;
+    }
+    bool operator!=( const sunlight_cache_key &rhs ) const {
+        return !( *this == rhs );
+    }
+};
+
 struct level_cache {
     public:
         // Zeros all relevant values
@@ -24,14 +74,24 @@ struct level_cache {
         level_cache( const level_cache &other ) = default;
 
         std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
+        // Submaps (x * MAPSIZE + y) whose part of scent_blocker_cache and scent_reducer_cache
+        // has to be looked up again.
+        std::bitset<MAPSIZE *MAPSIZE> scent_cache_dirty;
         bool outside_cache_dirty = false;
         bool floor_cache_dirty = false;
         bool seen_cache_dirty = false;
         // This is a single value indicating that the entire level is floored.
         bool no_floor_gaps = false;
+        // Number of tiles of floor_cache without floor, kept in step by set_floor.
+        int floor_gap_count = MAPSIZE_X * MAPSIZE_Y;
 
         four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
         float sm[MAPSIZE_X][MAPSIZE_Y];
+
+        // The terrain and furniture part of map::scent_blockers, vehicles are added on top.
+        bool scent_blocker_cache[MAPSIZE_X][MAPSIZE_Y];
+        bool scent_reducer_cache[MAPSIZE_X][MAPSIZE_Y];
+
         // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
         // This is only valid for the duration of generate_lightmap
         float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
@@ -39,6 +99,37 @@ struct level_cache {
         // Cache of natural light level is useful if it needs to be in sync with the light cache.
         float natural_light_level_cache;
 
+        // Sunlight reaching each tile, i.e. lm before light sources are added, as last computed by
+        // map::build_sunlight_cache. Only up to date for levels lit tile by tile (sunlight_key.mode 2).
+        four_quadrants sunlight_cache[MAPSIZE_X][MAPSIZE_Y];
+        sunlight_cache_key sunlight_key;
+        // Submaps (x * MAPSIZE + y) whose outside, floor or transparency cache may have changed
+        // since build_sunlight_cache last looked at them.
+        std::bitset<MAPSIZE *MAPSIZE> sunlight_cache_dirty;
+        // Submaps where sunlight_cache is brighter than the inside light level.
+        std::bitset<MAPSIZE *MAPSIZE> sunlight_lit;
+        // The outside, floor and transparency caches as build_sunlight_cache last saw them, used to
+        // narrow sunlight_cache_dirty down to the submaps that really changed.
+        bool sunlight_outside[MAPSIZE_X][MAPSIZE_Y];
+        bool sunlight_floor[MAPSIZE_X][MAPSIZE_Y];
+        float sunlight_transparency[MAPSIZE_X][MAPSIZE_Y];
+
+        // Per-source results of the bulk light pass, keyed by source position.
+        std::unordered_map<point, buffered_light_contribution> buffered_light_contributions;
+        std::vector<cached_light_arc> light_arcs;
+        // transparency_cache as it was when cached light was last checked against it,
+        // used to find the submaps whose light sources need to be recast.
+        float buffered_light_transparency[MAPSIZE_X][MAPSIZE_Y];
+        // Bumped whenever buffered_light_transparency is found to differ. Per submap
+        // (x * MAPSIZE + y), the generation at which it last differed.
+        int light_transparency_generation = 0;
+        std::array<int, MAPSIZE *MAPSIZE> light_transparency_changed = {};
+        // Value of map::light_pass when buffered_light_transparency was last compared.
+        int light_transparency_pass = 0;
+        // map::abs_sub the cached light was computed for; it is dropped when that changes.
+        tripoint buffered_light_origin = tripoint_min;
+        int buffered_light_generation = 0;
+
         // if false, means tile is under the roof ("inside"), true means tile is "outside"
         // "inside" tiles are protected from sun, rain, etc. (see ter_furn_flag::TFLAG_INDOORS flag)
         bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -48,6 +139,8 @@ struct level_cache {
         // false otherwise
         // i.e. true == has floor
         bool floor_cache[MAPSIZE_X][MAPSIZE_Y];
+        // Tiles without floor of their own that vehicles floored in the last do_vehicle_caching.
+        std::vector<point> vehicle_floor_points;
 
         // stores cached transparency of the tiles
         // units: "transparency" (see LIGHT_TRANSPARENCY_OPEN_AIR)
@@ -59,6 +152,11 @@ struct level_cache {
         // true, if tile is not opaque
         std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> transparent_cache_wo_fields;
 
+        // transparency_cache[x][y] > LIGHT_TRANSPARENCY_SOLID, fields included, packed for
+        // map::sees_many. Rebuilt from transparency_cache on first use after it changed.
+        std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> transparent_bitboard;
+        bool transparent_bitboard_dirty = true;
+
         // stores "adjusted transparency" of the tiles
         // initial values derived from transparency_cache, uses same units
         // examples of adjustment: changed transparency on player's tile and special case for crouching
@@ -86,6 +184,9 @@ struct level_cache {
         lit_level visibility_cache[MAPSIZE_X][MAPSIZE_Y];
         std::bitset<MAPSIZE_X *MAPSIZE_Y> map_memory_seen_cache;
         std::bitset<MAPSIZE *MAPSIZE> field_cache;
+        // Tiles (x * MAPSIZE_X + y) whose color on the pixel minimap may have changed since
+        // the minimap last looked at them: terrain, furniture, vehicles or visibility changed.
+        std::bitset<MAPSIZE_X *MAPSIZE_Y> minimap_dirty;
 
         std::set<vehicle *> vehicle_list;
         std::set<vehicle *> zone_vehicles;
@@ -97,6 +198,14 @@ struct level_cache {
         void set_veh_exists_at( const tripoint &pt, bool exists_at );
         void set_veh_cached_parts( const tripoint &pt, vehicle &veh, int part_num );
 
+        void set_minimap_dirty( const point &p ) {
+            minimap_dirty.set( p.x * MAPSIZE_X + p.y );
+        }
+
+        // Sets floor_cache at p, keeping floor_gap_count and no_floor_gaps in step.
+        // Returns whether the value changed.
+        bool set_floor( const point &p, bool has_floor );
+
         void clear_vehicle_cache();
         void clear_veh_from_veh_cached_parts( const tripoint &pt, vehicle *veh );
 
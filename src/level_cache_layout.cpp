@@ -0,0 +1,21 @@
+#include "level_cache_layout.h"
+
+void pack_apparent_light_tiles( const level_cache &cache, apparent_light_tiles &out )
+{
+    const level_cache_flat_view flat{ cache };
+    // Walk submap by submap so the writes stay within one tile block at a time.
+    for( int smx = 0; smx < MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < MAPSIZE; ++smy ) {
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                for( int sy = 0; sy < SEEY; ++sy ) {
+                    const point p( smx * SEEX + sx, smy * SEEY + sy );
+                    apparent_light_tile &tile = out[p];
+                    tile.lm = flat.lm( p );
+                    tile.seen = flat.seen( p );
+                    tile.camera = flat.camera( p );
+                    tile.opaque = flat.opaque( p );
+                }
+            }
+        }
+    }
+}
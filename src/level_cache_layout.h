@@ -0,0 +1,95 @@
+#pragma once
+#ifndef CATA_SRC_LEVEL_CACHE_LAYOUT_H
+#define CATA_SRC_LEVEL_CACHE_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+
+#include "game_constants.h"
+#include "level_cache.h"
+#include "lightmap.h"
+#include "point.h"
+#include "shadowcasting.h"
+
+// Views over the per-tile vision fields of a level, so that code like
+// map::apparent_light_helper can be written once and run against either the
+// usual one-array-per-field level_cache grids or a packed, submap-tiled copy.
+//
+// A view provides seen(), camera(), opaque() and lm() for a point in map-local
+// coordinates.
+
+/** Reads straight from level_cache, one [MAPSIZE_X][MAPSIZE_Y] array per field. */
+struct level_cache_flat_view {
+    const level_cache &cache;
+
+    float seen( const point &p ) const {
+        return cache.seen_cache[p.x][p.y];
+    }
+    float camera( const point &p ) const {
+        return cache.camera_cache[p.x][p.y];
+    }
+    bool opaque( const point &p ) const {
+        return cache.transparency_cache[p.x][p.y] <= LIGHT_TRANSPARENCY_SOLID &&
+               cache.vision_transparency_cache[p.x][p.y] <= LIGHT_TRANSPARENCY_SOLID;
+    }
+    const four_quadrants &lm( const point &p ) const {
+        return cache.lm[p.x][p.y];
+    }
+};
+
+/** The fields map::apparent_light_helper reads for one tile, side by side. */
+struct apparent_light_tile {
+    four_quadrants lm;
+    float seen = 0.0f;
+    float camera = 0.0f;
+    bool opaque = false;
+};
+
+/**
+ * A MAPSIZE_X * MAPSIZE_Y grid stored as one contiguous SEEX * SEEY block per
+ * submap, so a tile and its neighbours usually share cache lines and pages.
+ */
+template<typename T>
+class submap_tiled_grid
+{
+    public:
+        T &operator[]( const point &p ) {
+            return cells[index( p )];
+        }
+        const T &operator[]( const point &p ) const {
+            return cells[index( p )];
+        }
+
+    private:
+        static size_t index( const point &p ) {
+            const size_t block = static_cast<size_t>( p.x / SEEX ) * MAPSIZE + p.y / SEEY;
+            return block * ( SEEX * SEEY ) + static_cast<size_t>( p.x % SEEX ) * SEEY + p.y % SEEY;
+        }
+
+        std::array<T, MAPSIZE_X * MAPSIZE_Y> cells;
+};
+
+using apparent_light_tiles = submap_tiled_grid<apparent_light_tile>;
+
+/** Reads from a packed copy made by pack_apparent_light_tiles. */
+struct level_cache_tiled_view {
+    const apparent_light_tiles &tiles;
+
+    float seen( const point &p ) const {
+        return tiles[p].seen;
+    }
+    float camera( const point &p ) const {
+        return tiles[p].camera;
+    }
+    bool opaque( const point &p ) const {
+        return tiles[p].opaque;
+    }
+    const four_quadrants &lm( const point &p ) const {
+        return tiles[p].lm;
+    }
+};
+
+/** Copies the fields of @p cache read by map::apparent_light_helper into @p out. */
+void pack_apparent_light_tiles( const level_cache &cache, apparent_light_tiles &out );
+
+#endif // CATA_SRC_LEVEL_CACHE_LAYOUT_H
@@ -1,8 +1,10 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <map>
@@ -25,6 +27,7 @@
 #include "item.h"
 #include "item_stack.h"
 #include "level_cache.h"
+#include "level_cache_layout.h"
 #include "line.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -34,9 +37,11 @@
 #include "mtype.h"
 #include "npc.h"
 #include "optional.h"
+#include "perf_stats.h"
 #include "point.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "type_id.h"
 #include "units.h"
@@ -87,6 +92,7 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
+    perf_timer timer( perf_stage::build_transparency_cache );
     auto &map_cache = get_cache( zlev );
     auto &transparent_cache_wo_fields = map_cache.transparent_cache_wo_fields;
     auto &transparency_cache = map_cache.transparency_cache;
@@ -110,6 +116,11 @@ bool map::build_transparency_cache( const int zlev )
 
     const float sight_penalty = get_weather().weather_id->sight_penalty;
 
+    const transparency_tables &luts = get_transparency_tables();
+    const bool use_row_kernel = use_transparency_row_kernel && !luts.empty();
+    const std::vector<uint8_t> &ter_lut = luts.ter;
+    const std::vector<uint8_t> &furn_lut = luts.furn;
+
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
@@ -165,10 +176,48 @@ bool map::build_transparency_cache( const int zlev )
                     for( int sx = 0; sx < SEEX; ++sx ) {
                         // init all sy indices in one go
                         std::uninitialized_fill_n( &transparency_cache[sm_offset.x + sx][sm_offset.y], SEEY, value );
-                        if( opaque ) {
+                        // A partial rebuild may find anything left over from before here.
+                        if( opaque || !rebuild_all ) {
                             auto &bs = transparent_cache_wo_fields[sm_offset.x + sx];
                             for( int i = 0; i < SEEY; i++ ) {
-                                bs[sm_offset.y + i] = false;
+                                bs[sm_offset.y + i] = !opaque;
+                            }
+                        }
+                    }
+                }
+            } else if( use_row_kernel ) {
+                // Same result as calc_transp, but works a whole SEEY row at a time off the
+                // flat per-type tables, and only touches the field map for tiles that have one.
+                const float outside_value = LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty;
+                for( int sx = 0; sx < SEEX; ++sx ) {
+                    const int x = sx + sm_offset.x;
+                    float *const cache_row = &transparency_cache[x][sm_offset.y];
+                    const bool *const outside_row = &outside_cache[x][sm_offset.y];
+                    uint8_t transparent_row[SEEY];
+                    for( int sy = 0; sy < SEEY; ++sy ) {
+                        const point sp( sx, sy );
+                        transparent_row[sy] = ter_lut[cur_submap->get_ter( sp ).to_i()] &
+                                              furn_lut[cur_submap->get_furn( sp ).to_i()];
+                    }
+                    for( int sy = 0; sy < SEEY; ++sy ) {
+                        const float open = outside_row[sy] ? outside_value : LIGHT_TRANSPARENCY_OPEN_AIR;
+                        cache_row[sy] = transparent_row[sy] ? open : LIGHT_TRANSPARENCY_SOLID;
+                    }
+                    auto &bs = transparent_cache_wo_fields[x];
+                    for( int sy = 0; sy < SEEY; ++sy ) {
+                        bs[sm_offset.y + sy] = cache_row[sy] > LIGHT_TRANSPARENCY_SOLID;
+                    }
+                    if( cur_submap->field_count == 0 ) {
+                        continue;
+                    }
+                    for( int sy = 0; sy < SEEY; ++sy ) {
+                        if( !transparent_row[sy] ) {
+                            continue;
+                        }
+                        for( const auto &fld : cur_submap->get_field( { sx, sy } ) ) {
+                            const field_intensity_level &i_level = fld.second.get_intensity_level();
+                            if( !i_level.transparent ) {
+                                cache_row[sy] *= i_level.translucency;
                             }
                         }
                     }
@@ -240,12 +289,86 @@ void map::apply_character_light( Character &p )
     }
 }
 
+using submap_bitset = std::bitset<MAPSIZE * MAPSIZE>;
+
+// Compares the dirty submaps of the outside, floor and transparency caches with the copy
+// kept for the sunlight cache, refreshes it, and returns the submaps that really changed.
+static submap_bitset update_sunlight_inputs( level_cache &map_cache )
+{
+    submap_bitset changed;
+    if( map_cache.sunlight_cache_dirty.none() ) {
+        return changed;
+    }
+    for( int smx = 0; smx < MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < MAPSIZE; ++smy ) {
+            const int index = smx * MAPSIZE + smy;
+            if( !map_cache.sunlight_cache_dirty[index] ) {
+                continue;
+            }
+            const int y = smy * SEEY;
+            bool same = true;
+            for( int x = smx * SEEX; same && x < ( smx + 1 ) * SEEX; ++x ) {
+                same = std::equal( &map_cache.outside_cache[x][y], &map_cache.outside_cache[x][y + SEEY],
+                                   &map_cache.sunlight_outside[x][y] ) &&
+                       std::equal( &map_cache.floor_cache[x][y], &map_cache.floor_cache[x][y + SEEY],
+                                   &map_cache.sunlight_floor[x][y] ) &&
+                       std::equal( &map_cache.transparency_cache[x][y],
+                                   &map_cache.transparency_cache[x][y + SEEY],
+                                   &map_cache.sunlight_transparency[x][y] );
+            }
+            if( same ) {
+                continue;
+            }
+            changed.set( index );
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; ++x ) {
+                std::copy_n( &map_cache.outside_cache[x][y], SEEY, &map_cache.sunlight_outside[x][y] );
+                std::copy_n( &map_cache.floor_cache[x][y], SEEY, &map_cache.sunlight_floor[x][y] );
+                std::copy_n( &map_cache.transparency_cache[x][y], SEEY,
+                             &map_cache.sunlight_transparency[x][y] );
+            }
+        }
+    }
+    map_cache.sunlight_cache_dirty.reset();
+    return changed;
+}
+
+// Adds the submaps sharing an edge with any submap in the set.
+static submap_bitset grow_submaps( const submap_bitset &submaps )
+{
+    submap_bitset result = submaps;
+    for( int smx = 0; smx < MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < MAPSIZE; ++smy ) {
+            if( !submaps[smx * MAPSIZE + smy] ) {
+                continue;
+            }
+            if( smx > 0 ) {
+                result.set( ( smx - 1 ) * MAPSIZE + smy );
+            }
+            if( smx < MAPSIZE - 1 ) {
+                result.set( ( smx + 1 ) * MAPSIZE + smy );
+            }
+            if( smy > 0 ) {
+                result.set( smx * MAPSIZE + smy - 1 );
+            }
+            if( smy < MAPSIZE - 1 ) {
+                result.set( smx * MAPSIZE + smy + 1 );
+            }
+        }
+    }
+    return result;
+}
+
 // This function raytraces starting at the upper limit of the simulated area descending
 // toward the lower limit. Since it's sunlight, the rays are parallel.
 // Each layer consults the next layer up to determine the intensity of the light that reaches it.
 // Once this is complete, additional operations add more dynamic lighting.
+//
+// Light only ever moves one tile sideways per level, so a level lit tile by tile keeps its
+// sunlight_cache and only recomputes the vertical columns of submaps whose own caches, or whose
+// neighbours on the level above, changed since the last call.
 void map::build_sunlight_cache( int pzlev )
 {
+    perf_timer timer( perf_stage::build_sunlight_cache );
     const int zlev_min = -OVERMAP_DEPTH;
     // Start at the topmost populated zlevel to avoid unnecessary raycasting
     // Plus one zlevel to prevent clipping inside structures
@@ -264,21 +387,39 @@ void map::build_sunlight_cache( int pzlev )
     //    ↓
     // when fully below ground: fully_outside=false, fully_inside=true  (fast fill)
 
+    // Grab illumination at ground level.
+    const float outside_light_level = g->natural_light_level( 0 );
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    // Submaps where the level above changed, be it its sunlight or its floor and transparency.
+    submap_bitset changed_above;
+
     // Iterate top to bottom because sunlight cache needs to construct in that order.
     for( int zlev = zlev_max; zlev >= zlev_min; zlev-- ) {
 
         level_cache &map_cache = get_cache( zlev );
         map_cache.natural_light_level_cache = g->natural_light_level( zlev );
         auto &lm = map_cache.lm;
-        // Grab illumination at ground level.
-        const float outside_light_level = g->natural_light_level( 0 );
         // TODO: if zlev < 0 is open to sunlight, this won't calculate correct light, but neither does g->natural_light_level()
         const float inside_light_level = ( zlev >= 0 && outside_light_level > LIGHT_SOURCE_BRIGHT ) ?
                                          LIGHT_AMBIENT_DIM * 0.8 : LIGHT_AMBIENT_LOW;
 
+        const submap_bitset inputs_changed = update_sunlight_inputs( map_cache );
+        sunlight_cache_key key;
+        key.mode = fully_inside ? 1 : fully_outside ? 0 : 2;
+        key.outside_light_level = outside_light_level;
+        key.inside_light_level = inside_light_level;
+        key.sight_penalty = sight_penalty;
+        const bool key_changed = key != map_cache.sunlight_key;
+        map_cache.sunlight_key = key;
+
         // all light was blocked before
         if( fully_inside ) {
             std::fill_n( &lm[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( inside_light_level ) );
+            changed_above = inputs_changed;
+            if( key_changed ) {
+                changed_above.set();
+            }
             continue;
         }
 
@@ -304,6 +445,10 @@ void map::build_sunlight_cache( int pzlev )
                                                      this_floor_cache[x][y] );
                 }
             }
+            changed_above = inputs_changed;
+            if( key_changed ) {
+                changed_above.set();
+            }
             continue;
         }
 
@@ -311,12 +456,13 @@ void map::build_sunlight_cache( int pzlev )
         // At first compress the angle such that it takes no more than one tile of shift per level.
         // To exceed that, we'll have to handle casting light from the side instead of the top.
         point offset;
+        // lm of the level above was already overwritten with its sunlight by this pass.
         const level_cache &prev_map_cache = get_cache_ref( zlev + 1 );
         const auto &prev_lm = prev_map_cache.lm;
         const auto &prev_transparency_cache = prev_map_cache.transparency_cache;
         const auto &prev_floor_cache = prev_map_cache.floor_cache;
         const auto &outside_cache = map_cache.outside_cache;
-        const float sight_penalty = get_weather().weather_id->sight_penalty;
+        auto &sunlight = map_cache.sunlight_cache;
         // TODO: Replace these with a lookup inside the four_quadrants class.
         constexpr std::array<point, 5> cardinals = {
             {point_zero, point_north, point_west, point_east, point_south}
@@ -330,55 +476,79 @@ void map::build_sunlight_cache( int pzlev )
             }
         };
 
-        fully_inside = true; // recalculate
-
-        // Fall back to minimal light level if we don't find anything.
-        std::fill_n( &lm[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( inside_light_level ) );
+        submap_bitset recompute = grow_submaps( changed_above ) | inputs_changed;
+        if( key_changed ) {
+            recompute.set();
+        }
+        submap_bitset changed;
 
-        for( int x = 0; x < MAPSIZE_X; ++x ) {
-            for( int y = 0; y < MAPSIZE_Y; ++y ) {
-                // Check center, then four adjacent cardinals.
-                for( int i = 0; i < 5; ++i ) {
-                    point prev( cardinals[i] + offset + point( x, y ) );
-                    bool inbounds = prev.x >= 0 && prev.x < MAPSIZE_X &&
-                                    prev.y >= 0 && prev.y < MAPSIZE_Y;
+        for( int smx = 0; smx < MAPSIZE; ++smx ) {
+            for( int smy = 0; smy < MAPSIZE; ++smy ) {
+                const int index = smx * MAPSIZE + smy;
+                if( !recompute[index] ) {
+                    continue;
+                }
+                bool submap_changed = false;
+                bool submap_lit = false;
+                for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; ++x ) {
+                    for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY; ++y ) {
+                        // Fall back to minimal light level if we don't find anything.
+                        four_quadrants light( inside_light_level );
+                        // Check center, then four adjacent cardinals.
+                        for( int i = 0; i < 5; ++i ) {
+                            point prev( cardinals[i] + offset + point( x, y ) );
+                            bool inbounds = prev.x >= 0 && prev.x < MAPSIZE_X &&
+                                            prev.y >= 0 && prev.y < MAPSIZE_Y;
+
+                            if( !inbounds ) {
+                                continue;
+                            }
 
-                    if( !inbounds ) {
-                        continue;
-                    }
+                            float prev_light_max;
+                            float prev_transparency = prev_transparency_cache[prev.x][prev.y];
+                            // This is pretty gross, this cancels out the per-tile transparency effect
+                            // derived from weather.
+                            if( outside_cache[x][y] ) {
+                                prev_transparency /= sight_penalty;
+                            }
 
-                    float prev_light_max;
-                    float prev_transparency = prev_transparency_cache[prev.x][prev.y];
-                    // This is pretty gross, this cancels out the per-tile transparency effect
-                    // derived from weather.
-                    if( outside_cache[x][y] ) {
-                        prev_transparency /= sight_penalty;
-                    }
+                            if( prev_transparency > LIGHT_TRANSPARENCY_SOLID &&
+                                !prev_floor_cache[prev.x][prev.y] &&
+                                ( prev_light_max = prev_lm[prev.x][prev.y].max() ) > 0.0 ) {
+                                const float light_level = clamp( prev_light_max * LIGHT_TRANSPARENCY_OPEN_AIR / prev_transparency,
+                                                                 inside_light_level, prev_light_max );
 
-                    if( prev_transparency > LIGHT_TRANSPARENCY_SOLID &&
-                        !prev_floor_cache[prev.x][prev.y] &&
-                        ( prev_light_max = prev_lm[prev.x][prev.y].max() ) > 0.0 ) {
-                        const float light_level = clamp( prev_light_max * LIGHT_TRANSPARENCY_OPEN_AIR / prev_transparency,
-                                                         inside_light_level, prev_light_max );
-
-                        if( i == 0 ) {
-                            lm[x][y].fill( light_level );
-                            fully_inside &= light_level <= inside_light_level;
-                            break;
-                        } else {
-                            fully_inside &= light_level <= inside_light_level;
-                            lm[x][y][dir_quadrants[i][0]] = light_level;
-                            lm[x][y][dir_quadrants[i][1]] = light_level;
+                                submap_lit |= light_level > inside_light_level;
+                                if( i == 0 ) {
+                                    light.fill( light_level );
+                                    break;
+                                } else {
+                                    light[dir_quadrants[i][0]] = light_level;
+                                    light[dir_quadrants[i][1]] = light_level;
+                                }
+                            }
                         }
+                        submap_changed |= light.values != sunlight[x][y].values;
+                        sunlight[x][y] = light;
                     }
                 }
+                changed.set( index, submap_changed );
+                map_cache.sunlight_lit.set( index, submap_lit );
             }
         }
+
+        std::copy_n( &sunlight[0][0], MAPSIZE_X * MAPSIZE_Y, &lm[0][0] );
+        fully_inside = map_cache.sunlight_lit.none();
+        changed_above = changed | inputs_changed;
+        if( key_changed ) {
+            changed_above.set();
+        }
     }
 }
 
 void map::generate_lightmap( const int zlev )
 {
+    perf_timer timer( perf_stage::generate_lightmap );
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -412,6 +582,7 @@ void map::generate_lightmap( const int zlev )
     };
 
     const float natural_light = g->natural_light_level( zlev );
+    ++light_pass;
 
     build_sunlight_cache( zlev );
 
@@ -581,16 +752,18 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
-    const tripoint cache_start( 0, 0, zlev );
-    const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
-        }
-    }
+    apply_buffered_light_sources( zlev );
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
     }
+
+    // Drop the arcs of lights that were switched off or moved away.
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        std::vector<cached_light_arc> &arcs = get_cache( z ).light_arcs;
+        arcs.erase( std::remove_if( arcs.begin(), arcs.end(), [this]( const cached_light_arc & arc ) {
+            return arc.pass != light_pass;
+        } ), arcs.end() );
+    }
 }
 
 void map::add_light_source( const tripoint &p, float luminance )
@@ -650,15 +823,16 @@ float map::light_transparency( const tripoint &p ) const
 map::apparent_light_info map::apparent_light_helper( const level_cache &map_cache,
         const tripoint &p )
 {
-    const float vis = std::max( map_cache.seen_cache[p.x][p.y], map_cache.camera_cache[p.x][p.y] );
-    const bool obstructed = vis <= LIGHT_TRANSPARENCY_SOLID + 0.1;
+    return apparent_light_helper( level_cache_flat_view{ map_cache }, p.xy() );
+}
 
-    auto is_opaque = [&map_cache]( const point & p ) {
-        return map_cache.transparency_cache[p.x][p.y] <= LIGHT_TRANSPARENCY_SOLID &&
-               map_cache.vision_transparency_cache[p.x][p.y] <= LIGHT_TRANSPARENCY_SOLID;
-    };
+template<typename Layout>
+map::apparent_light_info map::apparent_light_helper( const Layout &layout, const point &p )
+{
+    const float vis = std::max( layout.seen( p ), layout.camera( p ) );
+    const bool obstructed = vis <= LIGHT_TRANSPARENCY_SOLID + 0.1;
 
-    const bool p_opaque = is_opaque( p.xy() );
+    const bool p_opaque = layout.opaque( p );
     float apparent_light;
 
     if( p_opaque && vis > 0 ) {
@@ -683,16 +857,15 @@ map::apparent_light_info map::apparent_light_helper( const level_cache &map_cach
 
         four_quadrants seen_from( 0 );
         for( const offset_and_quadrants &oq : adjacent_offsets ) {
-            const point neighbour = p.xy() + oq.offset;
+            const point neighbour = p + oq.offset;
 
             if( !lightmap_boundaries.contains( neighbour ) ) {
                 continue;
             }
-            if( is_opaque( neighbour ) ) {
+            if( layout.opaque( neighbour ) ) {
                 continue;
             }
-            if( map_cache.seen_cache[neighbour.x][neighbour.y] == 0 &&
-                map_cache.camera_cache[neighbour.x][neighbour.y] == 0 ) {
+            if( layout.seen( neighbour ) == 0 && layout.camera( neighbour ) == 0 ) {
                 continue;
             }
             // This is a non-opaque visible neighbour, so count visibility from the relevant
@@ -700,15 +873,20 @@ map::apparent_light_info map::apparent_light_helper( const level_cache &map_cach
             seen_from[oq.quadrants[0]] = vis;
             seen_from[oq.quadrants[1]] = vis;
         }
-        apparent_light = ( seen_from * map_cache.lm[p.x][p.y] ).max();
+        apparent_light = ( seen_from * layout.lm( p ) ).max();
     } else {
         // This is the simple case, for a non-opaque tile light from all
         // directions is equivalent
-        apparent_light = vis * map_cache.lm[p.x][p.y].max();
+        apparent_light = vis * layout.lm( p ).max();
     }
     return { obstructed, apparent_light };
 }
 
+template map::apparent_light_info map::apparent_light_helper<level_cache_flat_view>(
+    const level_cache_flat_view &layout, const point &p );
+template map::apparent_light_info map::apparent_light_helper<level_cache_tiled_view>(
+    const level_cache_tiled_view &layout, const point &p );
+
 lit_level map::apparent_light_at( const tripoint &p, const visibility_variables &cache ) const
 {
     Character &player_character = get_player_character();
@@ -939,6 +1117,83 @@ void castLightAll( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
         output_cache, input_array, offset, offsetDistance, numerator );
 }
 
+template<typename T, T( *calc )( const T &, const T &, const int & ),
+         bool( *check )( const T &, const T & ),
+         void( *update_output )( T &, const T &, quadrant ),
+         T( *accumulate )( const T &, const T &, const int & )>
+void castLightAllParallel( T( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                           const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                           const point &offset, int offsetDistance, T numerator )
+{
+    using grid = T[MAPSIZE_X][MAPSIZE_Y];
+    struct octant {
+        void( *cast )( grid &, const grid &, const point &, int, T, int, float, float, T );
+        int xx;
+        int xy;
+        int yx;
+        int yy;
+    };
+    // Same order as castLightAll.
+    static const std::array<octant, 8> octants = { {
+            { castLight<0, 1, 1, 0, T, T, calc, check, update_output, accumulate>, 0, 1, 1, 0 },
+            { castLight<1, 0, 0, 1, T, T, calc, check, update_output, accumulate>, 1, 0, 0, 1 },
+            { castLight < 0, -1, 1, 0, T, T, calc, check, update_output, accumulate >, 0, -1, 1, 0 },
+            { castLight < -1, 0, 0, 1, T, T, calc, check, update_output, accumulate >, -1, 0, 0, 1 },
+            { castLight < 0, 1, -1, 0, T, T, calc, check, update_output, accumulate >, 0, 1, -1, 0 },
+            { castLight < 1, 0, 0, -1, T, T, calc, check, update_output, accumulate >, 1, 0, 0, -1 },
+            { castLight < 0, -1, -1, 0, T, T, calc, check, update_output, accumulate >, 0, -1, -1, 0 },
+            { castLight < -1, 0, 0, -1, T, T, calc, check, update_output, accumulate >, -1, 0, 0, -1 },
+        }
+    };
+    // Neighbouring octants share the tiles on the axes and diagonals between them, so each
+    // gets a private grid and they are merged once all are done.
+    static std::unique_ptr<std::array<grid, 8>> octant_grids = std::make_unique<std::array<grid, 8>>();
+
+    const int radius = 60 - offsetDistance;
+    std::array<inclusive_rectangle<point>, 8> bounds;
+    for( size_t i = 0; i < octants.size(); ++i ) {
+        const octant &o = octants[i];
+        // The octant is the triangle with corners at offset, offset + R * (-xy, -yy) and
+        // offset + R * (-xx - xy, -yx - yy).
+        const point corner_a( -radius * o.xy, -radius * o.yy );
+        const point corner_b( -radius * ( o.xx + o.xy ), -radius * ( o.yx + o.yy ) );
+        const point min_delta( std::min( { 0, corner_a.x, corner_b.x } ),
+                               std::min( { 0, corner_a.y, corner_b.y } ) );
+        const point max_delta( std::max( { 0, corner_a.x, corner_b.x } ),
+                               std::max( { 0, corner_a.y, corner_b.y } ) );
+        bounds[i] = inclusive_rectangle<point>(
+                        point( std::max( 0, offset.x + min_delta.x ), std::max( 0, offset.y + min_delta.y ) ),
+                        point( std::min( MAPSIZE_X - 1, offset.x + max_delta.x ),
+                               std::min( MAPSIZE_Y - 1, offset.y + max_delta.y ) ) );
+    }
+
+    get_thread_pool().parallel_for( 0, static_cast<int>( octants.size() ), [&]( const int i ) {
+        grid &out = ( *octant_grids )[i];
+        const inclusive_rectangle<point> &r = bounds[i];
+        for( int x = r.p_min.x; x <= r.p_max.x; ++x ) {
+            std::copy( &output_cache[x][r.p_min.y], &output_cache[x][r.p_max.y] + 1, &out[x][r.p_min.y] );
+        }
+        octants[i].cast( out, input_array, offset, offsetDistance, numerator, 1, 1.0f, 0.0f,
+                         T( LIGHT_TRANSPARENCY_OPEN_AIR ) );
+    } );
+
+    for( size_t i = 0; i < octants.size(); ++i ) {
+        const grid &out = ( *octant_grids )[i];
+        const inclusive_rectangle<point> &r = bounds[i];
+        for( int x = r.p_min.x; x <= r.p_max.x; ++x ) {
+            for( int y = r.p_min.y; y <= r.p_max.y; ++y ) {
+                update_output( output_cache[x][y], out[x][y], quadrant::default_ );
+            }
+        }
+    }
+}
+
+template void castLightAllParallel<float, sight_calc, sight_check, update_light,
+                                   accumulate_transparency>(
+                                       float ( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                                       const float ( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                                       const point &offset, int offsetDistance, float numerator );
+
 template void castLightAll<float, four_quadrants, sight_calc, sight_check,
                            update_light_quadrants, accumulate_transparency>(
                                four_quadrants( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
@@ -967,6 +1222,7 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
  */
 void map::build_seen_cache( const tripoint &origin, const int target_z )
 {
+    perf_timer timer( perf_stage::build_seen_cache );
     auto &map_cache = get_cache( target_z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.vision_transparency_cache;
     float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
@@ -988,8 +1244,15 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
 
             if( z == target_z ) {
                 seen_cache[origin.x][origin.y] = VISIBILITY_FULL;
-                castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
-                    seen_cache, transparency_cache, origin.xy(), 0 );
+                // Casts from indoors end after a few tiles, so only open terrain is worth
+                // spreading over several threads.
+                if( get_thread_pool().worker_count() > 0 && map_cache.outside_cache[origin.x][origin.y] ) {
+                    castLightAllParallel<float, sight_calc, sight_check, update_light, accumulate_transparency>(
+                        seen_cache, transparency_cache, origin.xy(), 0 );
+                } else {
+                    castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+                        seen_cache, transparency_cache, origin.xy(), 0 );
+                }
             }
         }
     } else {
@@ -1105,50 +1368,17 @@ static bool light_check( const float &transparency, const float &intensity )
     return transparency > LIGHT_TRANSPARENCY_SOLID && intensity > LIGHT_AMBIENT_LOW;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
-{
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-
-    const point p2( p.xy() );
+// Cardinal cones cast by a light source, see map::apply_light_source
+static constexpr uint8_t light_cone_north = 1 << 0;
+static constexpr uint8_t light_cone_east = 1 << 1;
+static constexpr uint8_t light_cone_south = 1 << 2;
+static constexpr uint8_t light_cone_west = 1 << 3;
 
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
-        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
-    }
-    if( luminance <= lit_level::LOW ) {
-        return;
-    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
-        luminance = 1.49f;
-    }
-
-    /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
-         neighboring fires to the north and west that were applied via light_source_buffer
-       If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
-       If there's a 100 luminance magnesium flare south added via apply_light_source instead od
-         add_light_source, it's unbuffered so we'll still cast rays into sy.
-
-          ey
-        nnnNnnn
-        w     e
-        w  5 +e
-     sx W 5*1+E ex
-        w ++++e
-        w+++++e
-        sssSsss
-           sy
-    */
-    const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance;
-    bool south = p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance;
-    bool east = p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance;
-    bool west = p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance;
-
-    if( north ) {
+static void cast_light_cones( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                              const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                              const point &p2, const float luminance, const uint8_t cones )
+{
+    if( cones & light_cone_north ) {
         castLight < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, p2, 0, luminance );
@@ -1157,7 +1387,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                       lm, transparency_cache, p2, 0, luminance );
     }
 
-    if( east ) {
+    if( cones & light_cone_east ) {
         castLight < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, p2, 0, luminance );
@@ -1166,7 +1396,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                       lm, transparency_cache, p2, 0, luminance );
     }
 
-    if( south ) {
+    if( cones & light_cone_south ) {
         castLight<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, p2, 0, luminance );
@@ -1175,7 +1405,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                       lm, transparency_cache, p2, 0, luminance );
     }
 
-    if( west ) {
+    if( cones & light_cone_west ) {
         castLight<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, p2, 0, luminance );
@@ -1185,6 +1415,232 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+// Applies the unconditional part of a light source to its own tile and returns the luminance
+// its cones are cast with, or 0 if it casts none.
+static float light_source_center( four_quadrants &lm, float &sm, float luminance )
+{
+    const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+    lm = elementwise_max( lm, min_light );
+    sm = std::max( sm, luminance );
+    if( luminance <= lit_level::LOW ) {
+        return 0.0f;
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        return 1.49f;
+    }
+    return luminance;
+}
+
+/* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
+     neighboring fires to the north and west that were applied via light_source_buffer
+   If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
+   If there's a 100 luminance magnesium flare south added via apply_light_source instead od
+     add_light_source, it's unbuffered so we'll still cast rays into sy.
+
+      ey
+    nnnNnnn
+    w     e
+    w  5 +e
+ sx W 5*1+E ex
+    w ++++e
+    w+++++e
+    sssSsss
+       sy
+*/
+static uint8_t light_source_cones( const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y],
+                                   const point &p2, const float luminance )
+{
+    const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
+    uint8_t cones = 0;
+    if( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance ) {
+        cones |= light_cone_north;
+    }
+    if( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance ) {
+        cones |= light_cone_east;
+    }
+    if( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance ) {
+        cones |= light_cone_south;
+    }
+    if( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance ) {
+        cones |= light_cone_west;
+    }
+    return cones;
+}
+
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
+    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
+    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
+    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
+
+    const point p2( p.xy() );
+
+    if( inbounds( p ) ) {
+        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
+        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
+    }
+    if( luminance <= lit_level::LOW ) {
+        return;
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        luminance = 1.49f;
+    }
+
+    cast_light_cones( lm, transparency_cache, p2, luminance,
+                      light_source_cones( light_source_buffer, p2, luminance ) );
+}
+
+void map::update_light_transparency( const int zlev )
+{
+    level_cache &map_cache = get_cache( zlev );
+    if( map_cache.light_transparency_pass == light_pass ) {
+        return;
+    }
+    map_cache.light_transparency_pass = light_pass;
+
+    // Local coordinates mean something else after a shift, so nothing cached can be reused.
+    if( map_cache.buffered_light_origin != abs_sub ) {
+        map_cache.buffered_light_contributions.clear();
+        map_cache.light_arcs.clear();
+        map_cache.buffered_light_origin = abs_sub;
+    }
+
+    // Comparing the cache itself rather than the dirty bits also catches what vehicle
+    // caching writes into it directly.
+    const auto &transparency_cache = map_cache.transparency_cache;
+    auto &snapshot = map_cache.buffered_light_transparency;
+    bool any_changed = false;
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                const int x = smx * SEEX + sx;
+                const int y = smy * SEEY;
+                if( std::memcmp( &transparency_cache[x][y], &snapshot[x][y], SEEY * sizeof( float ) ) != 0 ) {
+                    if( !any_changed ) {
+                        any_changed = true;
+                        ++map_cache.light_transparency_generation;
+                    }
+                    map_cache.light_transparency_changed[smx * MAPSIZE + smy] =
+                        map_cache.light_transparency_generation;
+                    break;
+                }
+            }
+        }
+    }
+    if( any_changed ) {
+        std::memcpy( &snapshot, &transparency_cache, sizeof( transparency_cache ) );
+    }
+}
+
+// Whether the transparency of any submap within radius of p changed after the given generation.
+static bool light_transparency_changed_since( const level_cache &map_cache, const point &p,
+        const int radius, const int generation )
+{
+    if( map_cache.light_transparency_generation == generation ) {
+        return false;
+    }
+    const int min_smx = std::max( 0, p.x - radius ) / SEEX;
+    const int min_smy = std::max( 0, p.y - radius ) / SEEY;
+    const int max_smx = std::min( LIGHTMAP_CACHE_X - 1, p.x + radius ) / SEEX;
+    const int max_smy = std::min( LIGHTMAP_CACHE_Y - 1, p.y + radius ) / SEEY;
+    for( int smx = min_smx; smx <= max_smx; ++smx ) {
+        for( int smy = min_smy; smy <= max_smy; ++smy ) {
+            if( map_cache.light_transparency_changed[smx * MAPSIZE + smy] > generation ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// light_calc falls off at least as 1 / distance, and castLight stops once a row is
+// below LIGHT_AMBIENT_LOW, so a cast never reads or writes anything past this radius.
+static int light_cast_radius( const float luminance )
+{
+    return std::min( 60, static_cast<int>( luminance / LIGHT_AMBIENT_LOW ) + 2 );
+}
+
+// Scratch target for recasting a single light; every cell written is cleared again
+// by take_light_scratch, so it stays zeroed between uses.
+static four_quadrants light_scratch[MAPSIZE_X][MAPSIZE_Y];
+
+// Moves the lit cells of light_scratch within radius of center into cells.
+static void take_light_scratch( const point &center, const int radius,
+                                std::vector<std::pair<point, four_quadrants>> &cells )
+{
+    constexpr four_quadrants four_zeros( 0.0f );
+    cells.clear();
+    const int max_x = std::min( LIGHTMAP_CACHE_X - 1, center.x + radius );
+    const int max_y = std::min( LIGHTMAP_CACHE_Y - 1, center.y + radius );
+    for( int cx = std::max( 0, center.x - radius ); cx <= max_x; ++cx ) {
+        for( int cy = std::max( 0, center.y - radius ); cy <= max_y; ++cy ) {
+            four_quadrants &cell = light_scratch[cx][cy];
+            if( cell.max() > 0.0f ) {
+                cells.emplace_back( point( cx, cy ), cell );
+                cell = four_zeros;
+            }
+        }
+    }
+}
+
+static void blit_light_cells( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                              const std::vector<std::pair<point, four_quadrants>> &cells )
+{
+    for( const std::pair<point, four_quadrants> &cell : cells ) {
+        four_quadrants &out = lm[cell.first.x][cell.first.y];
+        out = elementwise_max( out, cell.second );
+    }
+}
+
+void map::apply_buffered_light_sources( const int zlev )
+{
+    update_light_transparency( zlev );
+    level_cache &map_cache = get_cache( zlev );
+    auto &lm = map_cache.lm;
+    auto &sm = map_cache.sm;
+    const auto &transparency_cache = map_cache.transparency_cache;
+    const auto &light_source_buffer = map_cache.light_source_buffer;
+    auto &contributions = map_cache.buffered_light_contributions;
+
+    const int generation = ++map_cache.buffered_light_generation;
+    for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+            if( light_source_buffer[x][y] <= 0.0f ) {
+                continue;
+            }
+            const point p2( x, y );
+            const float luminance = light_source_center( lm[x][y], sm[x][y], light_source_buffer[x][y] );
+            if( luminance <= 0.0f ) {
+                continue;
+            }
+            const uint8_t cones = light_source_cones( light_source_buffer, p2, light_source_buffer[x][y] );
+            buffered_light_contribution &contrib = contributions[p2];
+            if( contrib.generation == 0 || contrib.luminance != luminance || contrib.directions != cones ||
+                light_transparency_changed_since( map_cache, p2, contrib.radius,
+                                                  contrib.transparency_generation ) ) {
+                const int radius = light_cast_radius( luminance );
+                cast_light_cones( light_scratch, transparency_cache, p2, luminance, cones );
+                contrib.luminance = luminance;
+                contrib.directions = cones;
+                contrib.radius = radius;
+                contrib.transparency_generation = map_cache.light_transparency_generation;
+                take_light_scratch( p2, radius, contrib.cells );
+            }
+            contrib.generation = generation;
+            blit_light_cells( lm, contrib.cells );
+        }
+    }
+
+    for( auto it = contributions.begin(); it != contributions.end(); ) {
+        if( it->second.generation != generation ) {
+            it = contributions.erase( it );
+        } else {
+            ++it;
+        }
+    }
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const point p2( p.xy() );
@@ -1224,6 +1680,11 @@ void map::apply_directional_light( const tripoint &p, int direction, float lumin
     }
 }
 
+static void cast_light_arc( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                            const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                            const point &p2, const units::angle &angle, float luminance,
+                            const units::angle &wideangle );
+
 void map::apply_light_arc( const tripoint &p, const units::angle &angle, float luminance,
                            const units::angle &wideangle )
 {
@@ -1234,11 +1695,42 @@ void map::apply_light_arc( const tripoint &p, const units::angle &angle, float l
     apply_light_source( p, LIGHT_SOURCE_LOCAL );
 
     const point p2( p.xy() );
+    update_light_transparency( p.z );
+    level_cache &cache = get_cache( p.z );
+
+    // Parked vehicles with their lights on cast the same arcs turn after turn, reuse those.
+    cached_light_arc *arc = nullptr;
+    for( cached_light_arc &cached : cache.light_arcs ) {
+        if( cached.origin == p2 && cached.angle == angle && cached.width == wideangle &&
+            cached.luminance == luminance ) {
+            arc = &cached;
+            break;
+        }
+    }
+    if( arc == nullptr || light_transparency_changed_since( cache, p2, arc->radius,
+            arc->transparency_generation ) ) {
+        if( arc == nullptr ) {
+            cache.light_arcs.emplace_back();
+            arc = &cache.light_arcs.back();
+            arc->origin = p2;
+            arc->angle = angle;
+            arc->width = wideangle;
+            arc->luminance = luminance;
+            arc->radius = light_cast_radius( luminance );
+        }
+        cast_light_arc( light_scratch, cache.transparency_cache, p2, angle, luminance, wideangle );
+        arc->transparency_generation = cache.light_transparency_generation;
+        take_light_scratch( p2, arc->radius, arc->cells );
+    }
+    arc->pass = light_pass;
+    blit_light_cells( cache.lm, arc->cells );
+}
 
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-
+static void cast_light_arc( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                            const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                            const point &p2, const units::angle &angle, const float luminance,
+                            const units::angle &wideangle )
+{
     // Normalize (should work with negative values too)
     units::angle wangle = wideangle / 2.0;
     units::angle oangle = angle - wangle;
@@ -1,77 +1,197 @@
 #include "lru_cache.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <sstream>
-#include <iterator>
 #include <memory>
 #include <string>
 
 #include "memory_fast.h"
 #include "point.h"
 
+template<typename Key, typename Value>
+constexpr int lru_cache<Key, Value>::none;
+
+template<typename Key, typename Value>
+size_t lru_cache<Key, Value>::home_slot( const Key &key ) const
+{
+    // The hashes of neighbouring points differ only in their low bits, so spread them out
+    // before masking or they would pile up into long probe runs.
+    uint64_t h = std::hash<Key>()( key );
+    h *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>( h ^ h >> 32 ) & ( buckets.size() - 1 );
+}
+
+template<typename Key, typename Value>
+size_t lru_cache<Key, Value>::slot_of( const Key &key ) const
+{
+    const size_t mask = buckets.size() - 1;
+    size_t slot = home_slot( key );
+    while( buckets[slot] != none && !( nodes[buckets[slot]].entry.first == key ) ) {
+        slot = ( slot + 1 ) & mask;
+    }
+    return slot;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::erase_slot( size_t slot )
+{
+    // Shift later entries of the probe sequence back into the hole, so lookups never have
+    // to skip over deleted slots.
+    const size_t mask = buckets.size() - 1;
+    size_t hole = slot;
+    for( size_t i = ( slot + 1 ) & mask; buckets[i] != none; i = ( i + 1 ) & mask ) {
+        const size_t home = home_slot( nodes[buckets[i]].entry.first );
+        if( ( ( i - home ) & mask ) >= ( ( i - hole ) & mask ) ) {
+            buckets[hole] = buckets[i];
+            hole = i;
+        }
+    }
+    buckets[hole] = none;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::unlink( int n )
+{
+    node &nd = nodes[n];
+    if( nd.prev == none ) {
+        head = nd.next;
+    } else {
+        nodes[nd.prev].next = nd.next;
+    }
+    if( nd.next == none ) {
+        tail = nd.prev;
+    } else {
+        nodes[nd.next].prev = nd.prev;
+    }
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::link_back( int n )
+{
+    node &nd = nodes[n];
+    nd.prev = tail;
+    nd.next = none;
+    if( tail == none ) {
+        head = n;
+    } else {
+        nodes[tail].next = n;
+    }
+    tail = n;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::erase_node( int n )
+{
+    erase_slot( slot_of( nodes[n].entry.first ) );
+    unlink( n );
+    // Let go of the value now rather than when the node is reused.
+    nodes[n].entry.second = Value();
+    nodes[n].next = free_head;
+    free_head = n;
+    count--;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::rehash( size_t size )
+{
+    buckets.assign( size, none );
+    for( int n = head; n != none; n = nodes[n].next ) {
+        buckets[slot_of( nodes[n].entry.first )] = n;
+    }
+}
+
 template<typename Key, typename Value>
 Value lru_cache<Key, Value>::get( const Key &pos, const Value &default_ ) const
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        return found->second->second;
+    if( count == 0 ) {
+        return default_;
     }
-    return default_;
+    const int n = buckets[slot_of( pos )];
+    return n == none ? default_ : nodes[n].entry.second;
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::remove( const Key &pos )
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        ordered_list.erase( found->second );
-        map.erase( found );
+    if( count == 0 ) {
+        return;
+    }
+    const int n = buckets[slot_of( pos )];
+    if( n != none ) {
+        erase_node( n );
     }
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::insert( int limit, const Key &pos, const Value &t )
 {
-    auto found = map.find( pos );
+    if( buckets.empty() ) {
+        rehash( 16 );
+    }
+    size_t slot = slot_of( pos );
+    int n = buckets[slot];
+    if( n != none ) {
+        // Move the existing entry to the back.
+        nodes[n].entry.second = t;
+        unlink( n );
+        link_back( n );
+        return;
+    }
 
-    if( found == map.end() ) {
-        // Need new entry in map.  Make the new list entry and point to it.
-        ordered_list.emplace_back( pos, t );
-        map[pos] = std::prev( ordered_list.end() );
-        trim( limit );
+    if( ( count + 1 ) * 2 > buckets.size() ) {
+        rehash( buckets.size() * 2 );
+        slot = slot_of( pos );
+    }
+    if( free_head != none ) {
+        n = free_head;
+        free_head = nodes[n].next;
+        nodes[n].entry = Pair( pos, t );
     } else {
-        // Splice existing entry to the back.  Does not invalidate the
-        // iterator, so no need to change the map.
-        auto list_iterator = found->second;
-        ordered_list.splice( ordered_list.end(), ordered_list, list_iterator );
-        // Update the moved item
-        list_iterator->second = t;
+        n = static_cast<int>( nodes.size() );
+        nodes.push_back( node{ Pair( pos, t ), none, none } );
     }
+    buckets[slot] = n;
+    link_back( n );
+    count++;
+    trim( limit );
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::trim( int limit )
 {
-    while( map.size() > static_cast<size_t>( limit ) ) {
-        map.erase( ordered_list.front().first );
-        ordered_list.pop_front();
+    while( count > static_cast<size_t>( limit ) ) {
+        erase_node( head );
     }
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::clear()
 {
-    map.clear();
-    ordered_list.clear();
+    nodes.clear();
+    buckets.clear();
+    head = none;
+    tail = none;
+    free_head = none;
+    count = 0;
 }
 
 template<typename Key, typename Value>
-const std::list<typename lru_cache<Key, Value>::Pair> &lru_cache<Key, Value>::list() const
+std::vector<typename lru_cache<Key, Value>::Pair> lru_cache<Key, Value>::list() const
 {
-    return ordered_list;
+    std::vector<Pair> ret;
+    ret.reserve( count );
+    for( int n = head; n != none; n = nodes[n].next ) {
+        ret.push_back( nodes[n].entry );
+    }
+    return ret;
 }
 
 // explicit template initialization for lru_cache of all types
 template class lru_cache<tripoint, int>;
 template class lru_cache<point, char>;
+template class lru_cache<point, std::vector<tripoint>>;
 template class lru_cache<std::string, shared_ptr_fast<std::istringstream>>;
+template class lru_cache<std::string, std::shared_ptr<const std::string>>;
+template class lru_cache<std::string, std::shared_ptr<const std::vector<std::string>>>;
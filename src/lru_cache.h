@@ -2,17 +2,25 @@
 #ifndef CATA_SRC_LRU_CACHE_H
 #define CATA_SRC_LRU_CACHE_H
 
-#include <list>
+#include <cstddef>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "enums.h" // IWYU pragma: keep
 #include "point.h"
 
 struct memorized_terrain_tile;
 
+/**
+ * A map that forgets its least recently inserted entries once it holds more than the limit
+ * given to insert.
+ *
+ * Entries live in one contiguous array and are chained in recency order by indices into it,
+ * and an open addressing table of indices finds them by key.  Removed entries are reused,
+ * so once the cache has grown to its limit inserting allocates nothing.
+ */
 template<typename Key, typename Value>
 class lru_cache
 {
@@ -24,11 +32,38 @@ class lru_cache
         void remove( const Key & );
 
         void clear();
-        const std::list<Pair> &list() const;
+        /** The entries, from the least to the most recently inserted. */
+        std::vector<Pair> list() const;
+        size_t size() const {
+            return count;
+        }
     private:
+        static constexpr int none = -1;
+
+        struct node {
+            Pair entry;
+            int prev;
+            // Also links the unused nodes, starting at free_head.
+            int next;
+        };
+
+        size_t home_slot( const Key &key ) const;
+        /** The slot of buckets holding key, or the empty slot where it would go. */
+        size_t slot_of( const Key &key ) const;
+        void erase_slot( size_t slot );
+        void erase_node( int n );
+        void unlink( int n );
+        void link_back( int n );
+        void rehash( size_t size );
         void trim( int limit );
-        std::list<Pair> ordered_list;
-        std::unordered_map<Key, typename std::list<Pair>::iterator> map;
+
+        std::vector<node> nodes;
+        // Indices into nodes, or none.  Kept a power of two at most half full.
+        std::vector<int> buckets;
+        int head = none;
+        int tail = none;
+        int free_head = none;
+        size_t count = 0;
 };
 
 #endif // CATA_SRC_LRU_CACHE_H
@@ -1137,9 +1137,9 @@ void spell::create_field( const tripoint &at ) const
     }
     if( one_in( type->field_chance ) ) {
         map &here = get_map();
-        field_entry *field = here.get_field( at, *type->field );
-        if( field ) {
-            field->set_field_intensity( field->get_field_intensity() + intensity );
+        if( here.get_field( at, *type->field ) ) {
+            // Through the map, so a sleeping square wakes up to the new intensity.
+            here.mod_field_intensity( at, *type->field, intensity );
         } else {
             here.add_field( at, *type->field, intensity, -duration_turns() );
         }
@@ -2417,6 +2417,11 @@ spell fake_spell::get_spell( int min_level_override ) const
     return sp;
 }
 
+bool spell_events::handles( const event_type type ) const
+{
+    return type == event_type::player_levels_spell;
+}
+
 void spell_events::notify( const cata::event &e )
 {
     switch( e.type() ) {
@@ -180,6 +180,7 @@ class spell_events : public event_subscriber
 {
     public:
         void notify( const cata::event & ) override;
+        bool handles( event_type ) const override;
 };
 
 class spell_type
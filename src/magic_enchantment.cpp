@@ -322,11 +322,13 @@ void enchantment::load( const JsonObject &jo, const std::string &,
                                             ( value_obj.get_string( "value" ) );
             const int add = value_obj.get_int( "add", 0 );
             const double mult = value_obj.get_float( "multiply", 0.0 );
-            if( add != 0 ) {
-                values_add.emplace( value, add );
+            const size_t index = static_cast<size_t>( value );
+            // A value that is already there, copied from another enchantment, is kept.
+            if( add != 0 && values_add[index] == 0 ) {
+                values_add[index] = add;
             }
-            if( mult != 0.0 ) {
-                values_multiply.emplace( value, mult );
+            if( mult != 0.0 && values_multiply[index] == 0.0 ) {
+                values_multiply[index] = mult;
             }
         }
     }
@@ -425,13 +427,11 @@ bool enchantment::add( const enchantment &rhs )
 
 void enchantment::force_add( const enchantment &rhs )
 {
-    for( const std::pair<const enchant_vals::mod, int> &pair_values : rhs.values_add ) {
-        values_add[pair_values.first] += pair_values.second;
-    }
-    for( const std::pair<const enchant_vals::mod, double> &pair_values : rhs.values_multiply ) {
+    for( size_t i = 0; i < num_mods; ++i ) {
+        values_add[i] += rhs.values_add[i];
         // values do not multiply against each other, they add.
         // so +10% and -10% will add to 0%
-        values_multiply[pair_values.first] += pair_values.second;
+        values_multiply[i] += rhs.values_multiply[i];
     }
 
     hit_me_effect.insert( hit_me_effect.end(), rhs.hit_me_effect.begin(), rhs.hit_me_effect.end() );
@@ -467,12 +467,12 @@ void enchantment::set_has( enchantment::has value )
 
 void enchantment::add_value_add( enchant_vals::mod value, int add_value )
 {
-    values_add[value] = add_value;
+    values_add[static_cast<size_t>( value )] = add_value;
 }
 
 void enchantment::add_value_mult( enchant_vals::mod value, float mult_value )
 {
-    values_multiply[value] = mult_value;
+    values_multiply[static_cast<size_t>( value )] = mult_value;
 }
 
 void enchantment::add_hit_me( const fake_spell &sp )
@@ -487,20 +487,12 @@ void enchantment::add_hit_you( const fake_spell &sp )
 
 int enchantment::get_value_add( const enchant_vals::mod value ) const
 {
-    const auto found = values_add.find( value );
-    if( found == values_add.cend() ) {
-        return 0;
-    }
-    return found->second;
+    return values_add[static_cast<size_t>( value )];
 }
 
 double enchantment::get_value_multiply( const enchant_vals::mod value ) const
 {
-    const auto found = values_multiply.find( value );
-    if( found == values_multiply.cend() ) {
-        return 0;
-    }
-    return found->second;
+    return values_multiply[static_cast<size_t>( value )];
 }
 
 double enchantment::modify_value( const enchant_vals::mod mod_val, double value ) const
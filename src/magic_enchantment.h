@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_MAGIC_ENCHANTMENT_H
 #define CATA_SRC_MAGIC_ENCHANTMENT_H
 
+#include <array>
 #include <iosfwd>
 #include <map>
 #include <new>
@@ -222,11 +223,13 @@ class enchantment
         std::set<trait_id> mutations;
         cata::optional<emit_id> emitter;
         std::map<efftype_id, int> ench_effects;
-        // values that add to the base value
-        std::map<enchant_vals::mod, int> values_add; // NOLINT(cata-serialize)
+        static constexpr size_t num_mods = static_cast<size_t>( enchant_vals::mod::NUM_MOD );
+        // values that add to the base value, by enchant_vals::mod
+        // kept for every mod, so the values asked for on the stat paths are found by index
+        std::array<int, num_mods> values_add = {}; // NOLINT(cata-serialize)
         // values that get multiplied to the base value
         // multipliers add to each other instead of multiply against themselves
-        std::map<enchant_vals::mod, double> values_multiply; // NOLINT(cata-serialize)
+        std::array<double, num_mods> values_multiply = {}; // NOLINT(cata-serialize)
 
         std::vector<fake_spell> hit_me_effect;
         std::vector<fake_spell> hit_you_effect;
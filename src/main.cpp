@@ -33,7 +33,9 @@
 #include "filesystem.h"
 #include "game.h"
 #include "game_ui.h"
+#include "init.h"
 #include "input.h"
+#include "input_replay.h"
 #include "loading_ui.h"
 #include "main_menu.h"
 #include "mapsharing.h"
@@ -43,7 +45,9 @@
 #include "path_info.h"
 #include "rng.h"
 #include "system_language.h"
+#include "thread_pool.h"
 #include "translations.h"
+#include "turn_benchmark.h"
 #include "type_id.h"
 #include "ui_manager.h"
 
@@ -235,6 +239,11 @@ struct cli_opts {
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    std::string load_profile; /** if set write the data loading profile to this file */
+    int benchmark_turns = 0; /** if set run that many turns of world without a UI, then exit */
+    int benchmark_zombies = 0;
+    std::string record_replay; /** if set write the input to this file for --replay */
+    std::string replay; /** if set play the input of this file instead of the keyboard's */
 };
 
 cli_opts parse_commandline( int argc, const char **argv )
@@ -244,7 +253,7 @@ cli_opts parse_commandline( int argc, const char **argv )
     const char *section_default = nullptr;
     const char *section_map_sharing = "Map sharing";
     const char *section_user_directory = "User directories";
-    const std::array<arg_handler, 12> first_pass_arguments = {{
+    const std::array<arg_handler, 16> first_pass_arguments = {{
             {
                 "--seed", "<string of letters and or numbers>",
                 "Sets the random number generator's seed value",
@@ -281,6 +290,16 @@ cli_opts parse_commandline( int argc, const char **argv )
                     return 0;
                 }
             },
+            {
+                "--load-profile", "<file>",
+                "Writes the time spent loading each JSON type, file and finalize stage to <file>",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.load_profile = params[0];
+                    return 1;
+                }
+            },
             {
                 "--dump-stats", "<what> [mode = TSV] [opts…]",
                 "Dumps item stats",
@@ -308,6 +327,49 @@ cli_opts parse_commandline( int argc, const char **argv )
                     return 0;
                 }
             },
+            {
+                "--benchmark", "<turns> [zombies]",
+                "Runs <turns> turns of the --world without a UI, optionally with that many "
+                "zombies around the avatar, and prints how long they took.  Use with --seed for "
+                "comparable runs",
+                section_default,
+                1,
+                [&result]( int n, const char **params ) -> int {
+                    test_mode = true;
+                    result.benchmark_turns = std::atoi( params[0] );
+                    if( result.benchmark_turns <= 0 )
+                    {
+                        return -1;
+                    }
+                    if( n >= 2 && params[1][0] != '-' )
+                    {
+                        result.benchmark_zombies = std::atoi( params[1] );
+                        return 2;
+                    }
+                    return 1;
+                }
+            },
+            {
+                "--record-replay", "<file>",
+                "Writes the seed and all the input of the session to <file>, for --replay",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.record_replay = params[0];
+                    return 1;
+                }
+            },
+            {
+                "--replay", "<file>",
+                "Plays the input recorded by --record-replay, from the same save, and prints "
+                "how long the turns took",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.replay = params[0];
+                    return 1;
+                }
+            },
             {
                 "--world", "<name>",
                 "Load world",
@@ -564,6 +626,15 @@ int main( int argc, const char *argv[] )
 
     cli_opts cli = parse_commandline( argc, const_cast<const char **>( argv ) );
 
+    if( cli.benchmark_turns > 0 && cli.world.empty() ) {
+        printf( "--benchmark needs the world to run in, given by --world.\n" );
+        exit( 1 );
+    }
+    if( !cli.record_replay.empty() && !cli.replay.empty() ) {
+        printf( "--record-replay and --replay cannot be used together.\n" );
+        exit( 1 );
+    }
+
     if( !dir_exist( PATH_INFO::datadir() ) ) {
         printf( "Fatal: Can't find data directory \"%s\"\nPlease ensure the current working directory is correct or specify data directory with --datadir.  Perhaps you meant to start \"cataclysm-launcher\"?\n",
                 PATH_INFO::datadir().c_str() );
@@ -643,12 +714,31 @@ int main( int argc, const char *argv[] )
     }
 
     set_language();
+    set_thread_pool_threads( get_option<int>( "WORKER_THREADS" ) );
+
+    if( !cli.replay.empty() ) {
+        const auto quit = []() {
+            exit_handler( -999 );
+        };
+        if( !input_replay::start_playback( cli.replay, cli.seed, quit ) ) {
+            DebugLog( D_ERROR, DC_ALL ) << "Could not read the replay " << cli.replay;
+            return 1;
+        }
+    } else if( !cli.record_replay.empty() ) {
+        if( !input_replay::start_recording( cli.record_replay, cli.seed ) ) {
+            DebugLog( D_ERROR, DC_ALL ) << "Could not write the replay " << cli.record_replay;
+            return 1;
+        }
+    }
 
     rng_set_engine_seed( cli.seed );
 
     game_ui::init_ui();
 
     g = std::make_unique<game>();
+    if( !cli.load_profile.empty() ) {
+        DynamicDataLoader::get_instance().set_load_profile_path( cli.load_profile );
+    }
     // First load and initialize everything that does not
     // depend on the mods.
     try {
@@ -699,6 +789,10 @@ int main( int argc, const char *argv[] )
                 break;
             }
             cli.world.clear(); // ensure quit returns to opening screen
+            if( cli.benchmark_turns > 0 ) {
+                exit( turn_benchmark::run( cli.benchmark_turns, cli.benchmark_zombies,
+                                           cli.seed ) ? 0 : 1 );
+            }
 
         } else {
             main_menu menu;
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <climits>
 #include <cmath>
 #include <cstdlib>
@@ -11,6 +12,8 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "active_item_cache.h"
 #include "ammo.h"
@@ -76,6 +79,7 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "pathfinding.h"
+#include "perf_stats.h"
 #include "projectile.h"
 #include "relic.h"
 #include "ret_val.h"
@@ -86,8 +90,10 @@
 #include "sounds.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
+#include "trace_zones.h"
 #include "translations.h"
 #include "trap.h"
 #include "ui_manager.h"
@@ -381,11 +387,23 @@ void map::on_vehicle_moved( const int smz )
 {
     set_outside_cache_dirty( smz );
     set_transparency_cache_dirty( smz );
-    set_floor_cache_dirty( smz );
-    set_floor_cache_dirty( smz + 1 );
     set_pathfinding_cache_dirty( smz );
 }
 
+void map::on_vehicle_moved( const tripoint &p )
+{
+    set_outside_cache_dirty( p.z );
+    // The reachability caches are still rebuilt for the whole level, as they were before
+    // vehicle moves were invalidated per square.
+    set_transparency_cache_dirty( p, true );
+    if( inbounds( p ) ) {
+        level_cache &ch = get_cache( p.z );
+        ch.r_hor_cache->invalidate();
+        ch.r_up_cache->invalidate();
+    }
+    set_pathfinding_cache_dirty( p );
+}
+
 void map::vehmove()
 {
     // give vehicles movement points
@@ -1229,7 +1247,27 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp, const bool adjust_
     }
 
     veh.shed_loose_parts();
+    // Remember the squares the vehicle covered, so that only those it leaves are cleared
+    // from the vehicle caches and only those it leaves or enters are invalidated.
+    std::vector<tripoint> vacated;
+    for( const vpart_reference &vpr : veh.get_all_parts() ) {
+        vacated.push_back( veh.global_part_pos3( vpr.part() ) );
+    }
     smzs = veh.advance_precalc_mounts( dst_offset, src, dp, ramp_offset, adjust_pos, parts_to_move );
+    std::unordered_set<tripoint> entered;
+    for( const vpart_reference &vpr : veh.get_all_parts() ) {
+        if( !vpr.part().removed ) {
+            entered.insert( veh.global_part_pos3( vpr.part() ) );
+        }
+    }
+    std::sort( vacated.begin(), vacated.end() );
+    vacated.erase( std::unique( vacated.begin(), vacated.end() ), vacated.end() );
+    vacated.erase( std::remove_if( vacated.begin(), vacated.end(), [&]( const tripoint & p ) {
+        return entered.count( p ) > 0;
+    } ), vacated.end() );
+    for( const tripoint &p : vacated ) {
+        clear_vehicle_point_from_cache( &veh, p );
+    }
     if( src_submap != dst_submap ) {
         veh.set_submap_moved( tripoint( dst.x / SEEX, dst.y / SEEY, dst.z ) );
         auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
@@ -1238,8 +1276,9 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp, const bool adjust_
         dst_submap->is_uniform = false;
         invalidate_max_populated_zlev( dst.z );
     }
+    bool map_shifted = false;
     if( need_update ) {
-        g->update_map( player_character );
+        map_shifted = g->update_map( player_character ) != point_zero;
     }
     add_vehicle_to_cache( &veh );
 
@@ -1274,8 +1313,18 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp, const bool adjust_
     //global positions of vehicle loot zones have changed.
     veh.zones_dirty = true;
 
-    for( int vsmz : smzs ) {
-        on_vehicle_moved( dst.z + vsmz );
+    if( map_shifted || z_change || src.z != dst.z ) {
+        // The squares recorded above are in the old local coordinates, or on another level.
+        for( int vsmz : smzs ) {
+            on_vehicle_moved( dst.z + vsmz );
+        }
+    } else {
+        for( const tripoint &p : vacated ) {
+            on_vehicle_moved( p );
+        }
+        for( const tripoint &p : entered ) {
+            on_vehicle_moved( p );
+        }
     }
     return true;
 }
@@ -1427,13 +1476,17 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture, const bool
 
     if( old_t.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) != new_t.has_flag(
             ter_furn_flag::TFLAG_NO_FLOOR ) ) {
-        set_floor_cache_dirty( p.z );
         set_seen_cache_dirty( p );
     }
 
     if( old_t.has_flag( ter_furn_flag::TFLAG_SUN_ROOF_ABOVE ) != new_t.has_flag(
             ter_furn_flag::TFLAG_SUN_ROOF_ABOVE ) ) {
-        set_floor_cache_dirty( p.z + 1 );
+        update_floor_cache( p + tripoint_above );
+    }
+
+    if( old_t.has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT ) != new_t.has_flag(
+            ter_furn_flag::TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p );
     }
 
     invalidate_max_populated_zlev( p.z );
@@ -1441,7 +1494,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture, const bool
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1714,6 +1767,10 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     }
 
     current_submap->set_ter( l, new_terrain );
+    if( current_submap->field_tile_asleep( l ) ) {
+        // Whether field processors have work here can depend on the terrain.
+        current_submap->mark_field_tile( l );
+    }
 
     // Set the dirty flags
     const ter_t &old_t = old_id.obj();
@@ -1745,11 +1802,22 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
 
     if( new_t.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) != old_t.has_flag(
             ter_furn_flag::TFLAG_NO_FLOOR ) ) {
-        set_floor_cache_dirty( p.z );
         // It's a set, not a flag
         support_cache_dirty.insert( p );
         set_seen_cache_dirty( p );
     }
+    if( new_t.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) != old_t.has_flag(
+            ter_furn_flag::TFLAG_NO_FLOOR ) ||
+        new_t.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) != old_t.has_flag(
+            ter_furn_flag::TFLAG_GOES_DOWN ) ) {
+        update_floor_cache( p );
+    }
+    if( new_t.has_flag( ter_furn_flag::TFLAG_NO_SCENT ) != old_t.has_flag(
+            ter_furn_flag::TFLAG_NO_SCENT ) ||
+        new_t.has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT ) != old_t.has_flag(
+            ter_furn_flag::TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p );
+    }
 
     if( new_t.has_flag( "SPAWN_WITH_LIQUID" ) ) {
         if( new_t.has_flag( "FRESH_WATER" ) ) {
@@ -1770,7 +1838,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -4768,6 +4836,7 @@ std::vector<tripoint> map::check_submap_active_item_consistency()
 
 void map::process_items()
 {
+    CATA_TRACE_ZONE( "map::process_items" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -5033,13 +5102,20 @@ std::list<item> map::use_amount( const tripoint &origin, const int range, const
                                  int &quantity, const std::function<bool( const item & )> &filter )
 {
     std::list<item> ret;
-    for( int radius = 0; radius <= range && quantity > 0; radius++ ) {
-        for( const tripoint &p : points_in_radius( origin, radius ) ) {
-            if( rl_dist( origin, p ) >= radius ) {
-                std::list<item> tmp = use_amount_square( p, type, quantity, filter );
-                ret.splice( ret.end(), tmp );
-            }
+    // Nearest squares first. Each square is looked at once: the ones further out used to be
+    // looked at again for every larger radius, which found nothing more to take.
+    const tripoint_range<tripoint> in_range = points_in_radius( origin, range );
+    std::vector<tripoint> squares( in_range.begin(), in_range.end() );
+    std::stable_sort( squares.begin(), squares.end(), [&origin]( const tripoint & a,
+    const tripoint & b ) {
+        return square_dist( origin, a ) < square_dist( origin, b );
+    } );
+    for( const tripoint &p : squares ) {
+        if( quantity <= 0 ) {
+            break;
         }
+        std::list<item> tmp = use_amount_square( p, type, quantity, filter );
+        ret.splice( ret.end(), tmp );
     }
     return ret;
 }
@@ -5394,6 +5470,8 @@ time_duration map::set_field_age( const tripoint &p, const field_type_id &type,
                                   const time_duration &age, const bool isoffset )
 {
     if( field_entry *const field_ptr = get_field( p, type ) ) {
+        point l;
+        unsafe_get_submap_at( p, l )->mark_field_tile( l );
         return field_ptr->set_field_age( ( isoffset ? field_ptr->get_field_age() : 0_turns ) + age );
     }
     return -1_turns;
@@ -5413,6 +5491,8 @@ int map::set_field_intensity( const tripoint &p, const field_type_id &type,
                     field_ptr->get_field_intensity() : 0 ) + new_intensity;
         on_field_modified( p, *type );
         field_ptr->set_field_intensity( adj );
+        point l;
+        unsafe_get_submap_at( p, l )->mark_field_tile( l );
         return adj;
     } else if( new_intensity > 0 ) {
         return add_field( p, type, new_intensity ) ? new_intensity : 0;
@@ -5507,6 +5587,8 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     current_submap->is_uniform = false;
     invalidate_max_populated_zlev( p.z );
 
+    // Marking also wakes the square if it was asleep, an existing entry may have changed.
+    current_submap->mark_field_tile( l );
     if( current_submap->get_field( l ).add_field( converted_type_id, intensity, age ) ) {
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
@@ -5547,7 +5629,7 @@ void map::on_field_modified( const tripoint &p, const field_type &fd_type )
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5681,6 +5763,7 @@ void map::update_submap_active_item_status( const tripoint &p )
 
 void map::update_visibility_cache( const int zlev )
 {
+    perf_timer timer( perf_stage::update_visibility_cache );
     Character &player_character = get_player_character();
     visibility_variables_cache.variables_set = true; // Not used yet
     visibility_variables_cache.g_light_level = static_cast<int>( g->light_level( zlev ) );
@@ -5699,7 +5782,8 @@ void map::update_visibility_cache( const int zlev )
     int sm_squares_seen[MAPSIZE][MAPSIZE];
     std::memset( sm_squares_seen, 0, sizeof( sm_squares_seen ) );
 
-    auto &visibility_cache = get_cache( zlev ).visibility_cache;
+    level_cache &ch = get_cache( zlev );
+    auto &visibility_cache = ch.visibility_cache;
 
     tripoint p;
     p.z = zlev;
@@ -5708,7 +5792,10 @@ void map::update_visibility_cache( const int zlev )
     for( x = 0; x < MAPSIZE_X; x++ ) {
         for( y = 0; y < MAPSIZE_Y; y++ ) {
             lit_level ll = apparent_light_at( p, visibility_variables_cache );
-            visibility_cache[x][y] = ll;
+            if( visibility_cache[x][y] != ll ) {
+                visibility_cache[x][y] = ll;
+                ch.set_minimap_dirty( p.xy() );
+            }
             sm_squares_seen[ x / SEEX ][ y / SEEY ] += ( ll == lit_level::BRIGHT || ll == lit_level::LIT );
         }
     }
@@ -6227,6 +6314,19 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range ) const
 /**
  * This one is internal-only, we don't want to expose the slope tweaking ickiness outside the map class.
  **/
+// Key of the pair in map::skew_vision_cache.
+static point skew_vision_key( const tripoint &F, const tripoint &T )
+{
+    // Cannonicalize the order of the tripoints so the cache is reflexive.
+    const tripoint &min = F < T ? F : T;
+    const tripoint &max = !( F < T ) ? F : T;
+    // A little gross, just pack the values into a point.
+    return point(
+               min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
+               max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
+           );
+}
+
 bool map::sees( const tripoint &F, const tripoint &T, const int range,
                 int &bresenham_slope ) const
 {
@@ -6235,14 +6335,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    // Cannonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint &min = F < T ? F : T;
-    const tripoint &max = !( F < T ) ? F : T;
-    // A little gross, just pack the values into a point.
-    const point key(
-        min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
-        max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
-    );
+    const point key = skew_vision_key( F, T );
     char cached = skew_vision_cache.get( key, -1 );
     if( cached >= 0 ) {
         return cached > 0;
@@ -6300,6 +6393,111 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
     return visible;
 }
 
+// Same line as the planar case of map::sees(), read off one bit per tile instead of a float.
+static bool planar_sight_line( const std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> &transparent,
+                               const point &F, const point &T )
+{
+    bool visible = true;
+    int bresenham_slope = 0;
+    bresenham( F, T, bresenham_slope,
+    [&visible, &T, &transparent]( const point & new_point ) {
+        if( new_point == T ) {
+            return false;
+        }
+        if( !transparent[new_point.x][new_point.y] ) {
+            visible = false;
+            return false;
+        }
+        return true;
+    } );
+    return visible;
+}
+
+const std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> &map::transparent_bitboard( const int zlev ) const
+{
+    level_cache &ch = get_cache( zlev );
+    if( ch.transparent_bitboard_dirty ) {
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            std::bitset<MAPSIZE_Y> &column = ch.transparent_bitboard[x];
+            const float *transparency = ch.transparency_cache[x];
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                column[y] = transparency[y] > LIGHT_TRANSPARENCY_SOLID;
+            }
+        }
+        ch.transparent_bitboard_dirty = false;
+    }
+    return ch.transparent_bitboard;
+}
+
+std::vector<bool> map::sees_many( const tripoint &F, const std::vector<tripoint> &targets,
+                                  const int range ) const
+{
+    std::vector<bool> result( targets.size(), false );
+    for( size_t i = 0; i < targets.size(); ++i ) {
+        const tripoint &T = targets[i];
+        if( fov_3d && F.z != T.z ) {
+            result[i] = sees( F, T, range );
+            continue;
+        }
+        if( ( range >= 0 && range < rl_dist( F, T ) ) || !inbounds( T ) ) {
+            continue;
+        }
+        const point key = skew_vision_key( F, T );
+        const char cached = skew_vision_cache.get( key, -1 );
+        if( cached >= 0 ) {
+            result[i] = cached > 0;
+            continue;
+        }
+        const bool visible = planar_sight_line( transparent_bitboard( T.z ), F.xy(), T.xy() );
+        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        result[i] = visible;
+    }
+    return result;
+}
+
+void map::prefetch_sees( const std::vector<std::pair<tripoint, tripoint>> &pairs ) const
+{
+    std::vector<std::pair<tripoint, tripoint>> todo;
+    std::unordered_set<point> queued;
+    using bitboard = std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X>;
+    std::array<const bitboard *, OVERMAP_LAYERS> boards{};
+    for( const std::pair<tripoint, tripoint> &pair : pairs ) {
+        const tripoint &F = pair.first;
+        const tripoint &T = pair.second;
+        if( F.z != T.z || !inbounds( F ) || !inbounds( T ) ) {
+            continue;
+        }
+        const point key = skew_vision_key( F, T );
+        if( skew_vision_cache.get( key, -1 ) >= 0 || !queued.insert( key ).second ) {
+            continue;
+        }
+        // Built here, on this thread, so the workers below only ever read them.
+        const bitboard *&board = boards[T.z + OVERMAP_DEPTH];
+        if( board == nullptr ) {
+            board = &transparent_bitboard( T.z );
+        }
+        todo.push_back( pair );
+    }
+
+    // Lines are short, hand them out in chunks.
+    constexpr int chunk_size = 256;
+    const int chunks = ( static_cast<int>( todo.size() ) + chunk_size - 1 ) / chunk_size;
+    std::vector<char> visible( todo.size() );
+    get_thread_pool().parallel_for( 0, chunks, [&]( const int chunk ) {
+        const size_t end = std::min( todo.size(), static_cast<size_t>( chunk + 1 ) * chunk_size );
+        for( size_t i = static_cast<size_t>( chunk ) * chunk_size; i < end; ++i ) {
+            const tripoint &F = todo[i].first;
+            const tripoint &T = todo[i].second;
+            visible[i] = planar_sight_line( *boards[T.z + OVERMAP_DEPTH], F.xy(), T.xy() ) ? 1 : 0;
+        }
+    } );
+
+    for( size_t i = 0; i < todo.size(); ++i ) {
+        skew_vision_cache.insert( 100000, skew_vision_key( todo[i].first, todo[i].second ),
+                                  visible[i] );
+    }
+}
+
 int map::obstacle_coverage( const tripoint &loc1, const tripoint &loc2 ) const
 {
     // Can't hide if you are standing on furniture, or non-flat slowing-down terrain tile.
@@ -6347,6 +6545,28 @@ int map::coverage( const tripoint &p ) const
 // Basically it does, "Find a line from any point in the source that ends up in the target square".
 std::vector<tripoint> map::find_clear_path( const tripoint &source,
         const tripoint &destination ) const
+{
+    // Bursts, shotgun pellets and the aiming cursor ask for the same line over and over.
+    const bool cacheable = source != destination && inbounds( source ) && inbounds( destination );
+    point key;
+    if( cacheable ) {
+        // Unlike skew_vision_key, the order matters: the path runs from source to destination.
+        key = point( source.x << 16 | source.y << 8 | ( source.z + OVERMAP_DEPTH ),
+                     destination.x << 16 | destination.y << 8 | ( destination.z + OVERMAP_DEPTH ) );
+        std::vector<tripoint> cached = clear_path_cache.get( key, {} );
+        if( !cached.empty() ) {
+            return cached;
+        }
+    }
+    std::vector<tripoint> path = find_clear_path_uncached( source, destination );
+    if( cacheable ) {
+        clear_path_cache.insert( 10000, key, path );
+    }
+    return path;
+}
+
+std::vector<tripoint> map::find_clear_path_uncached( const tripoint &source,
+        const tripoint &destination ) const
 {
     // TODO: Push this junk down into the Bresenham method, it's already doing it.
     const point d( destination.xy() - source.xy() );
@@ -6621,6 +6841,7 @@ void map::load( const tripoint_abs_sm &w, const bool update_vehicle,
     field_furn_locs.clear();
     field_ter_locs.clear();
     submaps_with_active_items.clear();
+    quads_ahead.clear();
     // TODO: fix point types
     set_abs_sub( w.raw() );
     clear_vehicle_level_caches();
@@ -6716,6 +6937,76 @@ shift_bitset_cache<MAPSIZE_X, SEEX>( std::bitset<MAPSIZE_X *MAPSIZE_X> &cache,
 template void
 shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, const point &s );
 
+// Moves a per-tile cache along with a shift of the map by s submaps: what was at p + s * SEE
+// ends up at p, and the tiles of the newly loaded submaps are set to fill.
+template<typename T>
+static void shift_tile_cache( T( &cache )[MAPSIZE_X][MAPSIZE_Y], const point &s, const T &fill )
+{
+    const int dx = s.x * SEEX;
+    const int dy = s.y * SEEY;
+    for( int i = 0; i < MAPSIZE_X; ++i ) {
+        // Walk against the shift, so no source column is overwritten before it is read.
+        const int x = dx >= 0 ? i : MAPSIZE_X - 1 - i;
+        const int src_x = x + dx;
+        T *const column = cache[x];
+        if( src_x < 0 || src_x >= MAPSIZE_X ) {
+            std::fill_n( column, MAPSIZE_Y, fill );
+        } else if( dy >= 0 ) {
+            std::copy( cache[src_x] + dy, cache[src_x] + MAPSIZE_Y, column );
+            std::fill( column + MAPSIZE_Y - dy, column + MAPSIZE_Y, fill );
+        } else {
+            std::copy_backward( cache[src_x], cache[src_x] + MAPSIZE_Y + dy, column + MAPSIZE_Y );
+            std::fill( column, column - dy, fill );
+        }
+    }
+}
+
+// The transparency cache only depends on what is on each tile, so a shift of the map can move
+// it along instead of having it rebuilt; only the newly loaded submaps are left dirty. The
+// caches derived from it are laid out in the old coordinates and are rebuilt as usual.
+static void shift_transparency_cache( level_cache &ch, const point &s )
+{
+    shift_tile_cache( ch.transparency_cache, s, static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
+
+    const int dy = s.y * SEEY;
+    auto &wo_fields = ch.transparent_cache_wo_fields;
+    for( int i = 0; i < MAPSIZE_X; ++i ) {
+        const int x = s.x >= 0 ? i : MAPSIZE_X - 1 - i;
+        const int src_x = x + s.x * SEEX;
+        if( src_x < 0 || src_x >= MAPSIZE_X ) {
+            wo_fields[x].set();
+            continue;
+        }
+        wo_fields[x] = wo_fields[src_x];
+        if( dy > 0 ) {
+            wo_fields[x] >>= dy;
+            for( int y = MAPSIZE_Y - dy; y < MAPSIZE_Y; ++y ) {
+                wo_fields[x].set( y );
+            }
+        } else if( dy < 0 ) {
+            wo_fields[x] <<= -dy;
+            for( int y = 0; y < -dy; ++y ) {
+                wo_fields[x].set( y );
+            }
+        }
+    }
+
+    std::bitset<MAPSIZE *MAPSIZE> dirty;
+    for( int smx = 0; smx < MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < MAPSIZE; ++smy ) {
+            const point src( smx + s.x, smy + s.y );
+            const bool loaded = src.x >= 0 && src.x < MAPSIZE && src.y >= 0 && src.y < MAPSIZE;
+            dirty[smx * MAPSIZE + smy] = !loaded ||
+                                         ch.transparency_cache_dirty[src.x * MAPSIZE + src.y];
+        }
+    }
+    ch.transparency_cache_dirty = dirty;
+    ch.transparent_bitboard_dirty = true;
+    ch.sunlight_cache_dirty.set();
+    ch.r_hor_cache->invalidate();
+    ch.r_up_cache->invalidate();
+}
+
 void map::shift( const point &sp )
 {
     // Special case of 0-shift; refresh the map
@@ -6754,8 +7045,10 @@ void map::shift( const point &sp )
         // mlangsdorf 2020 - this is kind of insane, building the cache is not free, why are
         // we doing this?
         clear_vehicle_list( gridz );
+        shift_transparency_cache( get_cache( gridz ), sp );
         shift_bitset_cache<MAPSIZE_X, SEEX>( get_cache( gridz ).map_memory_seen_cache, sp );
         shift_bitset_cache<MAPSIZE, 1>( get_cache( gridz ).field_cache, sp );
+        get_cache( gridz ).minimap_dirty.set();
         if( sp.x >= 0 ) {
             for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
                 if( sp.y >= 0 ) {
@@ -6845,6 +7138,18 @@ void map::shift( const point &sp )
     }
     rebuild_vehicle_level_caches();
 
+    // Everything else that is laid out in local coordinates has to be rebuilt.
+    for( int zlev = -OVERMAP_DEPTH; zlev <= OVERMAP_HEIGHT; ++zlev ) {
+        if( zlev < zmin || zlev > zmax ) {
+            invalidate_map_cache( zlev );
+            continue;
+        }
+        level_cache &ch = get_cache( zlev );
+        ch.floor_cache_dirty = true;
+        ch.seen_cache_dirty = true;
+        ch.outside_cache_dirty = true;
+    }
+
     g->setremoteveh( remoteveh );
 
     if( !support_cache_dirty.empty() ) {
@@ -6856,6 +7161,80 @@ void map::shift( const point &sp )
     }
 }
 
+void map::prefetch_ahead( const point &dir )
+{
+    if( dir == point_zero ) {
+        return;
+    }
+    const point step( clamp( dir.x, -1, 1 ), clamp( dir.y, -1, 1 ) );
+    const tripoint abs = get_abs_sub();
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs.z;
+    // The grid grows by one submap on the leading sides; the new column and row are
+    // what the next shift along dir loads.
+    const int minx = step.x < 0 ? -1 : 0;
+    const int maxx = step.x > 0 ? my_MAPSIZE : my_MAPSIZE - 1;
+    const int miny = step.y < 0 ? -1 : 0;
+    const int maxy = step.y > 0 ? my_MAPSIZE : my_MAPSIZE - 1;
+    std::vector<tripoint> quads;
+    for( int gridx = minx; gridx <= maxx; ++gridx ) {
+        for( int gridy = miny; gridy <= maxy; ++gridy ) {
+            const bool new_column = step.x != 0 && gridx == ( step.x < 0 ? minx : maxx );
+            const bool new_row = step.y != 0 && gridy == ( step.y < 0 ? miny : maxy );
+            if( !new_column && !new_row ) {
+                continue;
+            }
+            for( int gridz = zmin; gridz <= zmax; ++gridz ) {
+                const tripoint sm( abs.xy() + point( gridx, gridy ), gridz );
+                quads.push_back( sm_to_omt_copy( sm ) );
+            }
+        }
+    }
+    std::sort( quads.begin(), quads.end() );
+    quads.erase( std::unique( quads.begin(), quads.end() ), quads.end() );
+    MAPBUFFER.prefetch_quads( quads );
+    // generate_ahead takes them from the back, nearest z-level first.
+    const int z = abs.z;
+    std::stable_sort( quads.begin(), quads.end(), [z]( const tripoint & l, const tripoint & r ) {
+        return std::abs( l.z - z ) > std::abs( r.z - z );
+    } );
+    quads_ahead = std::move( quads );
+}
+
+void map::drop_uniform_behind( const point &dir ) const
+{
+    if( dir == point_zero ) {
+        return;
+    }
+    const tripoint abs = get_abs_sub();
+    const half_open_rectangle<point> now_loaded( abs.xy(), abs.xy() + point( my_MAPSIZE,
+            my_MAPSIZE ) );
+    const point old_origin = abs.xy() - dir;
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs.z;
+    std::vector<point> quads;
+    for( int gridx = 0; gridx < my_MAPSIZE; ++gridx ) {
+        for( int gridy = 0; gridy < my_MAPSIZE; ++gridy ) {
+            const point old_sm = old_origin + point( gridx, gridy );
+            const point first = omt_to_sm_copy( sm_to_omt_copy( old_sm ) );
+            // The quad must have left the map as a whole.
+            if( now_loaded.contains( first ) || now_loaded.contains( first + point_south ) ||
+                now_loaded.contains( first + point_east ) ||
+                now_loaded.contains( first + point_south_east ) ) {
+                continue;
+            }
+            quads.push_back( sm_to_omt_copy( first ) );
+        }
+    }
+    std::sort( quads.begin(), quads.end() );
+    quads.erase( std::unique( quads.begin(), quads.end() ), quads.end() );
+    for( const point &quad : quads ) {
+        for( int gridz = zmin; gridz <= zmax; ++gridz ) {
+            MAPBUFFER.drop_uniform_quad( tripoint( quad, gridz ) );
+        }
+    }
+}
+
 void map::vertical_shift( const int newz )
 {
     if( !zlevels ) {
@@ -6915,6 +7294,43 @@ void map::saven( const tripoint &grid )
 
 // Optimized mapgen function that only works properly for very simple overmap types
 // Does not create or require a temporary map and does its own saving
+static void generate_uniform( const tripoint &p, const ter_id &terrain_type );
+
+// Generate the quad whose north-west submap is at grid_abs_sub_rounded into the mapbuffer.
+// Returns whether that needed a full mapgen rather than a uniform fill.
+static bool generate_quad( const tripoint &grid_abs_sub_rounded )
+{
+    const tripoint_abs_omt grid_abs_omt( sm_to_omt_copy( grid_abs_sub_rounded ) );
+    const oter_id terrain_type = overmap_buffer.ter( grid_abs_omt );
+
+    // Short-circuit if the map tile is uniform
+    // TODO: Replace with json mapgen functions.
+    if( terrain_type == oter_open_air ) {
+        generate_uniform( grid_abs_sub_rounded, t_open_air );
+    } else if( terrain_type == oter_empty_rock || terrain_type == oter_deep_rock ) {
+        generate_uniform( grid_abs_sub_rounded, t_rock );
+    } else if( terrain_type == oter_solid_earth ) {
+        generate_uniform( grid_abs_sub_rounded, ter_t_soil );
+    } else {
+        tinymap tmp_map;
+        tmp_map.generate( grid_abs_sub_rounded, calendar::turn );
+        return true;
+    }
+    return false;
+}
+
+void map::generate_ahead()
+{
+    while( !quads_ahead.empty() ) {
+        const tripoint sm = omt_to_sm_copy( quads_ahead.back() );
+        quads_ahead.pop_back();
+        // Loads the quad if it was saved before.
+        if( MAPBUFFER.lookup_submap( sm ) == nullptr && generate_quad( sm ) ) {
+            return;
+        }
+    }
+}
+
 static void generate_uniform( const tripoint &p, const ter_id &terrain_type )
 {
     dbg( D_INFO ) << "generate_uniform p: " << p
@@ -6952,23 +7368,7 @@ void map::loadn( const tripoint &grid, const bool update_vehicles, bool _actuali
         // Each overmap square is two nonants; to prevent overlap, generate only at
         //  squares divisible by 2.
         // TODO: fix point types
-        const tripoint_abs_omt grid_abs_omt( sm_to_omt_copy( grid_abs_sub ) );
-        const tripoint grid_abs_sub_rounded = omt_to_sm_copy( grid_abs_omt.raw() );
-
-        const oter_id terrain_type = overmap_buffer.ter( grid_abs_omt );
-
-        // Short-circuit if the map tile is uniform
-        // TODO: Replace with json mapgen functions.
-        if( terrain_type == oter_open_air ) {
-            generate_uniform( grid_abs_sub_rounded, t_open_air );
-        } else if( terrain_type == oter_empty_rock || terrain_type == oter_deep_rock ) {
-            generate_uniform( grid_abs_sub_rounded, t_rock );
-        } else if( terrain_type == oter_solid_earth ) {
-            generate_uniform( grid_abs_sub_rounded, ter_t_soil );
-        } else {
-            tinymap tmp_map;
-            tmp_map.generate( grid_abs_sub_rounded, calendar::turn );
-        }
+        generate_quad( omt_to_sm_copy( sm_to_omt_copy( grid_abs_sub ) ) );
 
         // This is the same call to MAPBUFFER as above!
         tmpsub = MAPBUFFER.lookup_submap( grid_abs_sub );
@@ -6982,9 +7382,11 @@ void map::loadn( const tripoint &grid, const bool update_vehicles, bool _actuali
     // New submap changes the content of the map and all caches must be recalculated
     set_transparency_cache_dirty( grid.z );
     set_seen_cache_dirty( grid.z );
+    set_scent_cache_dirty( grid.z );
     set_outside_cache_dirty( grid.z );
     set_floor_cache_dirty( grid.z );
     set_pathfinding_cache_dirty( grid.z );
+    get_cache( grid.z ).minimap_dirty.set();
     setsubmap( gridn, tmpsub );
     if( !tmpsub->active_items.empty() ) {
         submaps_with_active_items.emplace( grid_abs_sub );
@@ -7344,6 +7746,9 @@ void map::actualize( const tripoint &grid )
     const time_duration time_since_last_actualize = calendar::turn - tmpsub->last_touched;
     const bool do_funnels = grid.z >= 0;
 
+    // Cosmetic field decay below redraws decay times, so let every field square be looked at again.
+    tmpsub->wake_field_tiles();
+
     // check spoiled stuff, and fill up funnels while we're at it
     process_items_in_submap( *tmpsub, grid );
     for( int x = 0; x < SEEX; x++ ) {
@@ -7368,19 +7773,36 @@ void map::actualize( const tripoint &grid )
                 traplocs[ter.trap.to_i()].push_back( pnt );
             }
 
-            if( do_funnels ) {
+            // The catch-up helpers below each look the square up through the map again
+            // only to bail out on most of them, so test their entry conditions against the
+            // submap first.  Earlier helpers can change the square, hence the fresh reads.
+            if( do_funnels && ( ter.trap != tr_null ? ter.trap : trap_here ).obj().is_funnel() ) {
                 fill_funnels( pnt, tmpsub->last_touched );
             }
 
-            grow_plant( pnt );
+            if( tmpsub->get_furn( p ).obj().has_flag( ter_furn_flag::TFLAG_PLANT ) ) {
+                grow_plant( pnt );
+            }
 
-            restock_fruits( pnt, time_since_last_actualize );
+            if( tmpsub->get_ter( p ).obj().has_flag( ter_furn_flag::TFLAG_HARVESTED ) ) {
+                restock_fruits( pnt, time_since_last_actualize );
+            }
 
-            produce_sap( pnt, time_since_last_actualize );
+            if( tmpsub->get_ter( p ) == t_tree_maple_tapped ) {
+                produce_sap( pnt, time_since_last_actualize );
+            }
 
-            rad_scorch( pnt, time_since_last_actualize );
+            if( tmpsub->get_radiation( p ) != 0 ) {
+                rad_scorch( pnt, time_since_last_actualize );
+            }
 
-            decay_cosmetic_fields( pnt, time_since_last_actualize );
+            if( tmpsub->get_field( p ).field_count() > 0 ) {
+                // Sleeping entries count their age up to the last touch, the decay the rest.
+                for( auto &fd : tmpsub->get_field( p ) ) {
+                    fd.second.wake_up( tmpsub->last_touched );
+                }
+                decay_cosmetic_fields( pnt, time_since_last_actualize );
+            }
         }
     }
 
@@ -7580,7 +8002,9 @@ void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group,
                                tmp.wander_pos.to_string_writable() );
             }
 
-            monster *const placed = g->place_critter_at( make_shared_fast<monster>( tmp ), local_pos );
+            // The group is cleared below, so the monster can be moved out of it.
+            monster *const placed = g->place_critter_at(
+                                        make_shared_fast<monster>( std::move( tmp ) ), local_pos );
             if( placed ) {
                 placed->on_load();
             }
@@ -8033,6 +8457,19 @@ std::bitset<OVERMAP_LAYERS> map::get_inter_level_visibility( const int origin_zl
     return seen_levels;
 }
 
+// Whether the tile at @p sp has a floor, not counting vehicles. @p below_submap is the submap
+// under @p cur_submap, or null on the lowest level.
+static bool tile_has_floor( const submap &cur_submap, const submap *below_submap, const point &sp )
+{
+    const ter_t &terrain = cur_submap.get_ter( sp ).obj();
+    if( !terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) &&
+        !terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ) {
+        return true;
+    }
+    return below_submap &&
+           below_submap->get_furn( sp ).obj().has_flag( ter_furn_flag::TFLAG_SUN_ROOF_ABOVE );
+}
+
 bool map::build_floor_cache( const int zlev )
 {
     auto &ch = get_cache( zlev );
@@ -8043,8 +8480,9 @@ bool map::build_floor_cache( const int zlev )
     auto &floor_cache = ch.floor_cache;
     std::uninitialized_fill_n(
         &floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y, true );
-    bool &no_floor_gaps = ch.no_floor_gaps;
-    no_floor_gaps = true;
+    ch.floor_gap_count = 0;
+    // Everything is back to the bare terrain.
+    ch.vehicle_floor_points.clear();
 
     bool lowest_z_lev = zlev <= -OVERMAP_DEPTH;
 
@@ -8066,26 +8504,59 @@ bool map::build_floor_cache( const int zlev )
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     point sp( sx, sy );
-                    const ter_t &terrain = cur_submap->get_ter( sp ).obj();
-                    if( terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) ||
-                        terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ) {
-                        if( below_submap &&
-                            below_submap->get_furn( sp ).obj().has_flag( ter_furn_flag::TFLAG_SUN_ROOF_ABOVE ) ) {
-                            continue;
-                        }
+                    if( !tile_has_floor( *cur_submap, below_submap, sp ) ) {
                         const point p( sx + smx * SEEX, sy + smy * SEEY );
                         floor_cache[p.x][p.y] = false;
-                        no_floor_gaps = false;
+                        ++ch.floor_gap_count;
                     }
                 }
             }
         }
     }
+    ch.no_floor_gaps = ch.floor_gap_count == 0;
 
     ch.floor_cache_dirty = false;
     return zlevels;
 }
 
+bool map::tile_has_floor_without_vehicles( const tripoint &p ) const
+{
+    point l;
+    const submap *cur_submap = get_submap_at( p, l );
+    if( cur_submap == nullptr ) {
+        return true;
+    }
+    point l_below;
+    const submap *below_submap = p.z > -OVERMAP_DEPTH ? get_submap_at( p + tripoint_below,
+                                 l_below ) : nullptr;
+    return tile_has_floor( *cur_submap, below_submap, l );
+}
+
+void map::floor_cache_changed_at( const tripoint &p )
+{
+    get_cache( p.z ).sunlight_cache_dirty.set( p.x / SEEX * MAPSIZE + p.y / SEEY );
+    if( p.z > -OVERMAP_DEPTH ) {
+        get_cache( p.z - 1 ).r_up_cache->invalidate( p.xy() );
+    }
+}
+
+void map::update_floor_cache( const tripoint &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    level_cache &ch = get_cache( p.z );
+    // A full rebuild is pending anyway.
+    if( ch.floor_cache_dirty ) {
+        return;
+    }
+    // A vehicle floor stays until the next build_map_cache puts the vehicles back on top.
+    if( ch.set_floor( p.xy(), tile_has_floor_without_vehicles( p ) ) ) {
+        floor_cache_changed_at( p );
+        set_seen_cache_dirty( p );
+    }
+}
+
 void map::build_floor_caches()
 {
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
@@ -8099,7 +8570,6 @@ static void vehicle_caching_internal( level_cache &zch, const vpart_reference &v
 {
     auto &outside_cache = zch.outside_cache;
     auto &transparency_cache = zch.transparency_cache;
-    auto &floor_cache = zch.floor_cache;
 
     const size_t part = vp.part_index();
     const tripoint part_pos =  v->global_part_pos3( vp.part() );
@@ -8119,9 +8589,12 @@ static void vehicle_caching_internal( level_cache &zch, const vpart_reference &v
         outside_cache[part_pos.x][part_pos.y] = false;
     }
 
-    if( vp.has_feature( VPFLAG_BOARDABLE ) && !vp.part().is_broken() ) {
-        floor_cache[part_pos.x][part_pos.y] = true;
+    if( vp.has_feature( VPFLAG_BOARDABLE ) && !vp.part().is_broken() &&
+        zch.set_floor( part_pos.xy(), true ) ) {
+        zch.vehicle_floor_points.push_back( part_pos.xy() );
     }
+    // Vehicles are re-applied over the rebuilt caches without marking them dirty.
+    zch.sunlight_cache_dirty.set( part_pos.x / SEEX * MAPSIZE + part_pos.y / SEEY );
 }
 
 static void vehicle_caching_internal_above( level_cache &zch_above, const vpart_reference &vp,
@@ -8129,7 +8602,10 @@ static void vehicle_caching_internal_above( level_cache &zch_above, const vpart_
 {
     if( vp.has_feature( VPFLAG_ROOF ) || vp.has_feature( VPFLAG_OPAQUE ) ) {
         const tripoint part_pos = v->global_part_pos3( vp.part() );
-        zch_above.floor_cache[part_pos.x][part_pos.y] = true;
+        if( zch_above.set_floor( part_pos.xy(), true ) ) {
+            zch_above.vehicle_floor_points.push_back( part_pos.xy() );
+        }
+        zch_above.sunlight_cache_dirty.set( part_pos.x / SEEX * MAPSIZE + part_pos.y / SEEY );
     }
 }
 
@@ -8152,31 +8628,73 @@ void map::do_vehicle_caching( int z )
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    perf_timer timer( perf_stage::build_map_cache );
+    CATA_TRACE_ZONE( "map::build_map_cache" );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
+    // The outside, transparency and floor caches of a level only read that level's
+    // (and the one below's) submaps and write that level's cache, so they can be
+    // built for all levels at once. Anything touching a neighbouring level's cache
+    // is left for the serial pass below.
+    std::array<bool, OVERMAP_LAYERS> floor_cache_was_dirty_at = {};
+    std::array<bool, OVERMAP_LAYERS> transparency_cache_was_dirty_at = {};
+    const auto build_level_caches = [&]( const int z ) {
+        build_outside_cache( z );
+        transparency_cache_was_dirty_at[z + OVERMAP_DEPTH] = build_transparency_cache( z );
+        floor_cache_was_dirty_at[z + OVERMAP_DEPTH] = build_floor_cache( z );
+    };
+    if( parallel_map_cache && maxz > minz ) {
+        get_thread_pool().parallel_for( minz, maxz + 1, build_level_caches );
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            build_level_caches( z );
+        }
+    }
     for( int z = minz; z <= maxz; z++ ) {
         // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
         const bool affects_seen_cache =  z == zlev || fov_3d;
-        build_outside_cache( z );
-        build_transparency_cache( z );
-        bool floor_cache_was_dirty = build_floor_cache( z );
+        const bool floor_cache_was_dirty = floor_cache_was_dirty_at[z + OVERMAP_DEPTH];
         seen_cache_dirty |= ( floor_cache_was_dirty && affects_seen_cache );
         if( floor_cache_was_dirty && z > -OVERMAP_DEPTH ) {
             get_cache( z - 1 ).r_up_cache->invalidate();
         }
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
     }
+    // Vehicles may have moved off the tiles they floored last time, so take their floors away
+    // before putting them back on top, for all levels first as roofs floor the level above.
+    for( int z = minz; z <= maxz; z++ ) {
+        level_cache &ch = get_cache( z );
+        for( const point &p : ch.vehicle_floor_points ) {
+            const tripoint pt( p, z );
+            if( ch.set_floor( p, tile_has_floor_without_vehicles( pt ) ) ) {
+                floor_cache_changed_at( pt );
+            }
+        }
+        ch.vehicle_floor_points.clear();
+    }
     // needs a separate pass as it changes the caches on neighbour z-levels (e.g. floor_cache);
     // otherwise such changes might be overwritten by main cache-building logic
     for( int z = minz; z <= maxz; z++ ) {
         do_vehicle_caching( z );
     }
+    for( int z = minz; z <= maxz; z++ ) {
+        for( const point &p : get_cache( z ).vehicle_floor_points ) {
+            floor_cache_changed_at( tripoint( p, z ) );
+        }
+    }
+    for( int z = minz; z <= maxz; z++ ) {
+        level_cache &ch = get_cache( z );
+        // Vehicle caching writes opaque parts straight into the transparency cache.
+        ch.transparent_bitboard_dirty |= transparency_cache_was_dirty_at[z + OVERMAP_DEPTH] ||
+                                         !ch.vehicle_list.empty();
+    }
 
     seen_cache_dirty |= build_vision_transparency_cache( zlev );
 
     if( seen_cache_dirty ) {
         skew_vision_cache.clear();
+        clear_path_cache.clear();
     }
     // Initial value is illegal player position.
     const tripoint p = get_player_character().pos();
@@ -8296,6 +8814,7 @@ void map::draw_fill_background( const ter_id &type )
     set_transparency_cache_dirty( abs_sub.z );
     set_seen_cache_dirty( abs_sub.z );
     set_outside_cache_dirty( abs_sub.z );
+    set_scent_cache_dirty( abs_sub.z );
     set_pathfinding_cache_dirty( abs_sub.z );
 
     // Fill each submap rather than each tile
@@ -8514,27 +9033,44 @@ void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &bl
                           std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
                           const point &min, const point &max )
 {
-    ter_furn_flag reduce = ter_furn_flag::TFLAG_REDUCE_SCENT;
-    ter_furn_flag block = ter_furn_flag::TFLAG_NO_SCENT;
-    auto fill_values = [&]( const tripoint & gp, const submap * sm, const point & lp ) {
-        // We need to generate the x/y coordinates, because we can't get them "for free"
-        const point p = lp + sm_to_ms_copy( gp.xy() );
-        if( sm->get_ter( lp ).obj().has_flag( block ) ) {
-            blocks_scent[p.x][p.y] = true;
-            reduces_scent[p.x][p.y] = false;
-        } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
-                   sm->get_furn( lp ).obj().has_flag( reduce ) ) {
-            blocks_scent[p.x][p.y] = false;
-            reduces_scent[p.x][p.y] = true;
-        } else {
-            blocks_scent[p.x][p.y] = false;
-            reduces_scent[p.x][p.y] = false;
+    level_cache &cache = get_cache( abs_sub.z );
+    if( cache.scent_cache_dirty.any() ) {
+        for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+            for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+                if( !cache.scent_cache_dirty[smx * MAPSIZE + smy] ) {
+                    continue;
+                }
+                const submap *sm = get_submap_at_grid( tripoint( smx, smy, abs_sub.z ) );
+                if( sm == nullptr ) {
+                    continue;
+                }
+                const point sm_offset = sm_to_ms_copy( point( smx, smy ) );
+                for( int sx = 0; sx < SEEX; ++sx ) {
+                    for( int sy = 0; sy < SEEY; ++sy ) {
+                        const point lp( sx, sy );
+                        const point p = sm_offset + lp;
+                        const ter_t &ter = sm->get_ter( lp ).obj();
+                        const bool blocks = ter.has_flag( ter_furn_flag::TFLAG_NO_SCENT );
+                        cache.scent_blocker_cache[p.x][p.y] = blocks;
+                        cache.scent_reducer_cache[p.x][p.y] = !blocks &&
+                                                              ( ter.has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT ) ||
+                                                                sm->get_furn( lp ).obj().has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT ) );
+                    }
+                }
+            }
         }
+        cache.scent_cache_dirty.reset();
+    }
 
-        return ITER_CONTINUE;
-    };
-
-    function_over( tripoint( min, abs_sub.z ), tripoint( max, abs_sub.z ), fill_values );
+    const point lo( std::max( min.x, 0 ), std::max( min.y, 0 ) );
+    const point hi( std::min( max.x, SEEX * my_MAPSIZE - 1 ), std::min( max.y,
+                    SEEY * my_MAPSIZE - 1 ) );
+    for( int x = lo.x; x <= hi.x; ++x ) {
+        std::copy( &cache.scent_blocker_cache[x][lo.y], &cache.scent_blocker_cache[x][hi.y] + 1,
+                   &blocks_scent[x][lo.y] );
+        std::copy( &cache.scent_reducer_cache[x][lo.y], &cache.scent_reducer_cache[x][hi.y] + 1,
+                   &reduces_scent[x][lo.y] );
+    }
 
     const inclusive_rectangle<point> local_bounds( min, max );
 
@@ -8684,13 +9220,14 @@ std::list<Creature *> map::get_creatures_in_radius( const tripoint &center, size
 {
     creature_tracker &creatures = get_creature_tracker();
     std::list<Creature *> creature_list;
-    for( const auto &loc : points_in_radius( center, radius, radiusz ) ) {
-        Creature *tmp_critter = creatures.creature_at( loc );
-        if( tmp_critter != nullptr ) {
-            creature_list.push_back( tmp_critter );
+    creatures.for_each_in_radius( getglobal( center ), radius, radiusz, [&]( Creature & critter ) {
+        // One creature per tile, like creature_at: a monster hides a character on the same tile.
+        if( !inbounds( critter.pos() ) ||
+            ( !critter.is_monster() && creatures.find( critter.get_location() ) ) ) {
+            return;
         }
-
-    }
+        creature_list.push_back( &critter );
+    } );
     return creature_list;
 }
 
@@ -8714,13 +9251,6 @@ const level_cache &map::access_cache( int zlev ) const
     return nullcache;
 }
 
-pathfinding_cache::pathfinding_cache()
-{
-    dirty = true;
-}
-
-pathfinding_cache::~pathfinding_cache() = default;
-
 pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 {
     return *pathfinding_caches[zlev + OVERMAP_DEPTH];
@@ -8733,6 +9263,26 @@ void map::set_pathfinding_cache_dirty( const int zlev )
     }
 }
 
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    pathfinding_cache &cache = get_pathfinding_cache( p.z );
+    const int index = p.x * MAPSIZE_Y + p.y;
+    if( cache.dirty || cache.dirty_point_set[index] ) {
+        return;
+    }
+    // Past this many tiles a rebuild of the whole level is cheaper than looking them up one by one.
+    constexpr size_t max_dirty_points = MAPSIZE_X * MAPSIZE_Y / 8;
+    if( cache.dirty_points.size() >= max_dirty_points ) {
+        cache.dirty = true;
+        return;
+    }
+    cache.dirty_point_set.set( index );
+    cache.dirty_points.push_back( p.xy() );
+}
+
 const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
 {
     if( !inbounds_z( zlev ) ) {
@@ -8740,21 +9290,108 @@ const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
         return *pathfinding_caches[ OVERMAP_DEPTH ];
     }
     auto &cache = get_pathfinding_cache( zlev );
-    if( cache.dirty ) {
+    if( cache.dirty || !cache.dirty_points.empty() ) {
         update_pathfinding_cache( zlev );
     }
 
     return cache;
 }
 
+pf_special map::pathfinding_cache_value( const maptile &tile, const tripoint &p ) const
+{
+    pf_special cur_value = PF_NORMAL;
+
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const auto &field = tile.get_field();
+    int part;
+    const vehicle *veh = veh_at_internal( p, part );
+
+    const int cost = move_cost_internal( furniture, terrain, field, veh, part );
+
+    if( cost > 2 ) {
+        cur_value |= PF_SLOW;
+    } else if( cost <= 0 ) {
+        cur_value |= PF_WALL;
+        if( terrain.has_flag( ter_furn_flag::TFLAG_CLIMBABLE ) ) {
+            cur_value |= PF_CLIMBABLE;
+        }
+    }
+
+    if( veh != nullptr ) {
+        cur_value |= PF_VEHICLE;
+    }
+
+    for( const auto &fld : tile.get_field() ) {
+        const field_entry &cur = fld.second;
+        if( cur.is_dangerous() ) {
+            cur_value |= PF_FIELD;
+        }
+    }
+
+    if( !tile.get_trap_t().is_benign() || !terrain.trap.obj().is_benign() ) {
+        cur_value |= PF_TRAP;
+    }
+
+    if( terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ||
+        terrain.has_flag( ter_furn_flag::TFLAG_GOES_UP ) ||
+        terrain.has_flag( ter_furn_flag::TFLAG_RAMP ) || terrain.has_flag( ter_furn_flag::TFLAG_RAMP_UP ) ||
+        terrain.has_flag( ter_furn_flag::TFLAG_RAMP_DOWN ) ) {
+        cur_value |= PF_UPDOWN;
+    }
+
+    if( terrain.has_flag( ter_furn_flag::TFLAG_SHARP ) ) {
+        cur_value |= PF_SHARP;
+    }
+
+    return cur_value;
+}
+
+// Stores the new value of one tile, noting a change of the cluster costs.
+// Returns whether the value changed.
+static bool set_pathfinding_cache_value( pathfinding_cache &cache, const point &p,
+        const pf_special value )
+{
+    pf_special &old_value = cache.special[p.x][p.y];
+    if( old_value == value ) {
+        return false;
+    }
+    if( pf_cluster_step_cost( old_value ) != pf_cluster_step_cost( value ) ) {
+        cache.cluster_dirty.set( p.x / SEEX * MAPSIZE + p.y / SEEY );
+    }
+    old_value = value;
+    return true;
+}
+
 void map::update_pathfinding_cache( int zlev ) const
 {
     auto &cache = get_pathfinding_cache( zlev );
     if( !cache.dirty ) {
+        if( cache.dirty_points.empty() ) {
+            return;
+        }
+        bool changed = false;
+        for( const point &p : cache.dirty_points ) {
+            point l;
+            submap *cur_submap = get_submap_at( tripoint( p, zlev ), l );
+            if( cur_submap != nullptr ) {
+                const maptile tile( cur_submap, l );
+                changed |= set_pathfinding_cache_value( cache, p,
+                                                        pathfinding_cache_value( tile, tripoint( p, zlev ) ) );
+            }
+            cache.dirty_point_set.reset( p.x * MAPSIZE_Y + p.y );
+        }
+        cache.dirty_points.clear();
+        if( changed ) {
+            cache.generation++;
+        }
         return;
     }
 
+    // Whatever the loop below does not reach, e.g. past a missing submap, reads as normal
+    // ground.  The fill bypasses the per-tile change tracking, so every cluster is redone.
     std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    cache.cluster_dirty.set();
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
@@ -8769,60 +9406,16 @@ void map::update_pathfinding_cache( int zlev ) const
                 p.x = sx + smx * SEEX;
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     p.y = sy + smy * SEEY;
-
-                    pf_special cur_value = PF_NORMAL;
-
-                    maptile tile( cur_submap, point( sx, sy ) );
-
-                    const auto &terrain = tile.get_ter_t();
-                    const auto &furniture = tile.get_furn_t();
-                    const auto &field = tile.get_field();
-                    int part;
-                    const vehicle *veh = veh_at_internal( p, part );
-
-                    const int cost = move_cost_internal( furniture, terrain, field, veh, part );
-
-                    if( cost > 2 ) {
-                        cur_value |= PF_SLOW;
-                    } else if( cost <= 0 ) {
-                        cur_value |= PF_WALL;
-                        if( terrain.has_flag( ter_furn_flag::TFLAG_CLIMBABLE ) ) {
-                            cur_value |= PF_CLIMBABLE;
-                        }
-                    }
-
-                    if( veh != nullptr ) {
-                        cur_value |= PF_VEHICLE;
-                    }
-
-                    for( const auto &fld : tile.get_field() ) {
-                        const field_entry &cur = fld.second;
-                        if( cur.is_dangerous() ) {
-                            cur_value |= PF_FIELD;
-                        }
-                    }
-
-                    if( !tile.get_trap_t().is_benign() || !terrain.trap.obj().is_benign() ) {
-                        cur_value |= PF_TRAP;
-                    }
-
-                    if( terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ||
-                        terrain.has_flag( ter_furn_flag::TFLAG_GOES_UP ) ||
-                        terrain.has_flag( ter_furn_flag::TFLAG_RAMP ) || terrain.has_flag( ter_furn_flag::TFLAG_RAMP_UP ) ||
-                        terrain.has_flag( ter_furn_flag::TFLAG_RAMP_DOWN ) ) {
-                        cur_value |= PF_UPDOWN;
-                    }
-
-                    if( terrain.has_flag( ter_furn_flag::TFLAG_SHARP ) ) {
-                        cur_value |= PF_SHARP;
-                    }
-
-                    cache.special[p.x][p.y] = cur_value;
+                    const maptile tile( cur_submap, point( sx, sy ) );
+                    set_pathfinding_cache_value( cache, p.xy(), pathfinding_cache_value( tile, p ) );
                 }
             }
         }
     }
 
+    cache.dirty_points.clear();
+    cache.dirty_point_set.reset();
+    cache.generation++;
     cache.dirty = false;
 }
 
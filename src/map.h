@@ -90,6 +90,11 @@ class map;
 
 enum class ter_furn_flag : int;
 struct pathfinding_cache;
+struct pathfinding_flow_field;
+struct pathfinding_flow_fields;
+struct pf_step;
+struct route_request;
+enum pf_special : int;
 struct pathfinding_settings;
 template<typename T>
 struct weighted_int_list;
@@ -333,6 +338,7 @@ class map
         void set_transparency_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
                 get_cache( zlev ).transparency_cache_dirty.set();
+                get_cache( zlev ).sunlight_cache_dirty.set();
                 get_cache( zlev ).r_hor_cache->invalidate();
                 get_cache( zlev ).r_up_cache->invalidate();
             }
@@ -348,6 +354,7 @@ class map
             if( inbounds( p ) ) {
                 const tripoint smp = ms_to_sm_copy( p );
                 get_cache( smp.z ).transparency_cache_dirty.set( smp.x * MAPSIZE + smp.y );
+                get_cache( smp.z ).sunlight_cache_dirty.set( smp.x * MAPSIZE + smp.y );
                 if( !field ) {
                     get_cache( smp.z ).r_hor_cache->invalidate( p.xy() );
                     get_cache( smp.z ).r_up_cache->invalidate( p.xy() );
@@ -355,6 +362,20 @@ class map
             }
         }
 
+        // invalidates the terrain and furniture scent masks of the submap containing p
+        void set_scent_cache_dirty( const tripoint &p ) {
+            if( inbounds( p ) ) {
+                const tripoint smp = ms_to_sm_copy( p );
+                get_cache( smp.z ).scent_cache_dirty.set( smp.x * MAPSIZE + smp.y );
+            }
+        }
+
+        void set_scent_cache_dirty( const int zlev ) {
+            if( inbounds_z( zlev ) ) {
+                get_cache( zlev ).scent_cache_dirty.set();
+            }
+        }
+
         void set_seen_cache_dirty( const tripoint &change_location ) {
             if( inbounds( change_location ) ) {
                 level_cache &cache = get_cache( change_location.z );
@@ -379,22 +400,28 @@ class map
         void set_outside_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
                 get_cache( zlev ).outside_cache_dirty = true;
+                get_cache( zlev ).sunlight_cache_dirty.set();
             }
         }
 
         void set_floor_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
                 get_cache( zlev ).floor_cache_dirty = true;
+                get_cache( zlev ).sunlight_cache_dirty.set();
             }
         }
 
         void set_pathfinding_cache_dirty( int zlev );
+        // Only the given tile changed.
+        void set_pathfinding_cache_dirty( const tripoint &p );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p ) {
             const int offset = p.x + p.y * MAPSIZE_Y;
             if( offset >= 0 && offset < MAPSIZE_X * MAPSIZE_Y ) {
-                get_cache( p.z ).map_memory_seen_cache.reset( offset );
+                level_cache &ch = get_cache( p.z );
+                ch.map_memory_seen_cache.reset( offset );
+                ch.set_minimap_dirty( p.xy() );
             }
         }
 
@@ -453,6 +480,11 @@ class map
          * Callback invoked when a vehicle has moved.
          */
         void on_vehicle_moved( int smz );
+        /**
+         * Same, but for a vehicle that only left or entered p: the transparency and
+         * pathfinding caches are invalidated for p, the rest as for the whole z-level.
+         */
+        void on_vehicle_moved( const tripoint &p );
 
         struct apparent_light_info {
             bool obstructed;
@@ -462,6 +494,11 @@ class map
          */
         static apparent_light_info apparent_light_helper( const level_cache &map_cache,
                 const tripoint &p );
+        /** Same as above, reading the per-tile fields through a view from level_cache_layout.h;
+         * instantiated for level_cache_flat_view and level_cache_tiled_view.
+         */
+        template<typename Layout>
+        static apparent_light_info apparent_light_helper( const Layout &layout, const point &p );
         /** Determine the visible light level for a tile, based on light_at
          * for the tile, vision distance, etc
          *
@@ -533,6 +570,25 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( const point &s );
+        /**
+         * Have the @ref mapbuffer read ahead the quads that another shift along dir would
+         * load, so that shift does not wait on the disk. Those quads are also queued for
+         * @ref generate_ahead.
+         */
+        void prefetch_ahead( const point &dir );
+        /**
+         * Load or generate the next quads queued by @ref prefetch_ahead into the mapbuffer,
+         * stopping after the first one that had to run mapgen. Called once a turn, this
+         * spreads the mapgen of a new row of submaps over the turns before the shift that
+         * needs them.
+         */
+        void generate_ahead();
+        /**
+         * Free the uniform quads that the last shift, by dir, moved entirely off the map,
+         * see @ref mapbuffer::drop_uniform_quad. Only for the main map, which is the only
+         * one that lives on while the player moves.
+         */
+        void drop_uniform_behind( const point &dir ) const;
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -629,7 +685,21 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+        * Same as calling sees( F, T, range ) for each of `targets`, in order. Lines on
+        * one level are walked over a packed copy of the transparency cache, and every
+        * answer is remembered for later sees() calls until the vision caches change.
+        */
+        std::vector<bool> sees_many( const tripoint &F, const std::vector<tripoint> &targets,
+                                     int range ) const;
+        /**
+        * Works out the lines of sight between many pairs of points on the shared thread
+        * pool and remembers them for later sees() and sees_many() calls. Pairs that are on
+        * different levels, out of bounds or already known are skipped.
+        */
+        void prefetch_sees( const std::vector<std::pair<tripoint, tripoint>> &pairs ) const;
     private:
+        const std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> &transparent_bitboard( int zlev ) const;
         /**
          * Don't expose the slope adjust outside map functions.
          *
@@ -683,6 +753,10 @@ class map
          * returns the line found, which may be the straight line, but blocked.
          */
         std::vector<tripoint> find_clear_path( const tripoint &source, const tripoint &destination ) const;
+    private:
+        std::vector<tripoint> find_clear_path_uncached( const tripoint &source,
+                const tripoint &destination ) const;
+    public:
 
         /**
          * Check whether the player can access the items located @p. Certain furniture/terrain
@@ -699,6 +773,9 @@ class map
         /**
          * Calculate the best path using A*
          *
+         * Long routes on one z-level are first planned between the entrances of the submaps
+         * on the way and then refined tile by tile, see route_clusters.
+         *
          * @param f The source location from which to path.
          * @param t The destination to which to path.
          * @param settings Structure describing pathfinding parameters.
@@ -707,6 +784,32 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Brings @p old_route, an earlier route from @p f, up to date for @p t without a new
+         * search over the whole way: steps that can no longer be taken are planned around
+         * locally, and a goal that moved by a few tiles is reached by extending the route.
+         * Returns an empty route if the old one can't be saved like that; use @ref route then.
+         */
+        std::vector<tripoint> repair_route( const tripoint &f, const std::vector<tripoint> &old_route,
+                                            const tripoint &t, const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Like @ref route, for crowds heading to the same place. Once a goal has been asked for
+         * more than once in a turn with the same settings, the costs to it are flooded over its
+         * z-level and later routes there just follow them, until the turn ends or the
+         * pathfinding cache of the level changes.
+         */
+        std::vector<tripoint> route_shared( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Solves @p requests on the thread pool, sharing flow fields between requests for the
+         * same goal. The pathfinding caches of the levels involved are brought up to date
+         * first and only read while solving, so results don't depend on the thread count.
+         * The routes are also kept for @ref route_shared to hand out later in the turn,
+         * as long as the pathfinding cache of their level has not changed by then.
+         */
+        void route_batch( std::vector<route_request> &requests ) const;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -1513,6 +1616,8 @@ class map
         /**
          * Build the map of scent-resistant tiles.
          * Should be way faster than if done in `game.cpp` using public map functions.
+         * Terrain and furniture come from the level cache, which is only looked up again
+         * for submaps marked with set_scent_cache_dirty.
          */
         void scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &blocks_scent,
                              std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
@@ -1544,6 +1649,8 @@ class map
     private:
         // Tiles whose ability to support things was removed in the last turn
         std::set<tripoint> support_cache_dirty;
+        // Quads (in omt coordinates) generate_ahead still has to look at, nearest last
+        std::vector<tripoint> quads_ahead;
         // Checks if the tile is supported and adds it to support_cache_dirty if it isn't
         void support_dirty( const tripoint &p );
     public:
@@ -1817,14 +1924,30 @@ class map
         bool build_floor_cache( int zlev );
         // We want this visible in `game`, because we want it built earlier in the turn than the rest
         void build_floor_caches();
+        // Recomputes the floor cache at one tile after its terrain or the furniture below changed.
+        void update_floor_cache( const tripoint &p );
+        // Floor at p from terrain and the furniture below alone, as build_floor_cache sees it.
+        bool tile_has_floor_without_vehicles( const tripoint &p ) const;
+        // Invalidates what was derived from the floor cache at p.
+        void floor_cache_changed_at( const tripoint &p );
 
     protected:
         void generate_lightmap( int zlev );
+        // Applies everything queued by add_light_source, recasting only the sources that changed.
+        void apply_buffered_light_sources( int zlev );
+        // Once per generate_lightmap pass, finds the submaps of the level whose transparency changed
+        // since cached light was cast (see level_cache::light_transparency_changed).
+        void update_light_transparency( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
         void apply_character_light( Character &p );
 
         int my_MAPSIZE;
         bool zlevels;
+        // If false, build_transparency_cache always uses the per-tile reference path
+        // instead of the lookup-table row kernel.
+        bool use_transparency_row_kernel = true;
+        // Counts generate_lightmap calls, to tell cached light still in use from stale.
+        int light_pass = 0;
 
         /**
          * Absolute coordinates of first submap (get_submap_at(0,0))
@@ -2021,6 +2144,7 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        mutable std::unique_ptr<pathfinding_flow_fields> flow_fields;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -2030,6 +2154,11 @@ class map
          * Cache of coordinate pairs recently checked for visibility.
          */
         mutable lru_cache<point, char> skew_vision_cache;
+        /**
+         * Recent results of find_clear_path.  They follow from the sight lines of
+         * skew_vision_cache alone, so both are cleared together.
+         */
+        mutable lru_cache<point, std::vector<tripoint>> clear_path_cache;
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
@@ -2038,6 +2167,23 @@ class map
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
 
+        // Pathfinding cache flags of one tile.
+        pf_special pathfinding_cache_value( const maptile &tile, const tripoint &p ) const;
+        pf_step route_step( const tripoint &cur, const tripoint &p, pf_special p_special,
+                            const pathfinding_settings &settings ) const;
+        // Fills in the costs and steps of a field whose goal and settings are set.
+        void flood_flow_field( pathfinding_flow_field &field ) const;
+        // Plain A* over the tiles of a box around f and t, which is what route() runs for
+        // anything but long routes.
+        std::vector<tripoint> route_tiles( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings,
+                                           const std::set<tripoint> &pre_closed ) const;
+        // Plans a route on one z-level over the submap cluster graph, then refines it with
+        // route_tiles. Returns an empty route if either step fails.
+        std::vector<tripoint> route_clusters( const tripoint &f, const tripoint &t,
+                                              const pathfinding_settings &settings,
+                                              const std::set<tripoint> &pre_closed ) const;
+
         visibility_variables visibility_variables_cache;
 
         // caches the highest zlevel above which all zlevels are uniform
@@ -2062,6 +2208,16 @@ class map
         const std::set<tripoint> &get_submaps_with_active_items() const {
             return submaps_with_active_items;
         }
+        // Just exposed so unit tests can compare both transparency cache builders.
+        void set_transparency_row_kernel( bool enabled ) {
+            use_transparency_row_kernel = enabled;
+        }
+        // Makes the next build_sunlight_cache recompute every level from scratch.
+        void invalidate_sunlight_cache() {
+            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+                get_cache( z ).sunlight_key = sunlight_cache_key();
+            }
+        }
         // Clips the area to map bounds
         tripoint_range<tripoint> points_in_rectangle(
             const tripoint &from, const tripoint &to ) const;
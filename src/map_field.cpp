@@ -53,12 +53,14 @@
 #include "npc.h"
 #include "optional.h"
 #include "overmapbuffer.h"
+#include "perf_stats.h"
 #include "point.h"
 #include "rng.h"
 #include "scent_block.h"
 #include "scent_map.h"
 #include "submap.h"
 #include "teleport.h"
+#include "trace_zones.h"
 #include "translations.h"
 #include "type_id.h"
 #include "units.h"
@@ -149,6 +151,8 @@ int map::burn_body_part( Character &you, field_entry &cur, const bodypart_id &bp
 
 void map::process_fields()
 {
+    perf_timer timer( perf_stage::process_fields );
+    CATA_TRACE_ZONE( "map::process_fields" );
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         auto &field_cache = get_cache( z ).field_cache;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
@@ -167,6 +171,7 @@ void map::process_fields()
             }
         }
     }
+    field_entry::set_last_processed( calendar::turn );
 }
 
 bool ter_furn_has_flag( const ter_t &ter, const furn_t &furn, const ter_furn_flag flag )
@@ -187,6 +192,25 @@ static int ter_furn_movecost( const ter_t &ter, const furn_t &furn )
     return ter.movecost + furn.movecost;
 }
 
+// map::flammable_items_at for a square whose tile is already at hand, so the terrain and
+// items are not looked up again through the map
+static bool flammable_items_in( const maptile &tile )
+{
+    if( tile.get_item_count() == 0 ) {
+        return false;
+    }
+    const ter_t &ter = tile.get_ter_t();
+    const furn_t &frn = tile.get_furn_t();
+    if( ter_furn_has_flag( ter, frn, ter_furn_flag::TFLAG_SEALED ) &&
+        !ter_furn_has_flag( ter, frn, ter_furn_flag::TFLAG_ALLOW_FIELD_EFFECT ) ) {
+        // Sealed containers don't allow fire, so shouldn't allow setting the fire either
+        return false;
+    }
+    return std::any_of( tile.get_items().begin(), tile.get_items().end(), []( const item & it ) {
+        return it.flammable();
+    } );
+}
+
 // Wrapper to allow skipping bound checks except at the edges of the map
 std::pair<tripoint, maptile> map::maptile_has_bounds( const tripoint &p, const bool bounds_checked )
 {
@@ -261,13 +285,6 @@ void map::gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p )
 void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                       const time_duration &outdoor_age_speedup, scent_block &sblk, const oter_id &om_ter )
 {
-    // TODO: fix point types
-    const bool sheltered = g->is_sheltered( p );
-    weather_manager &weather = get_weather();
-    const int winddirection = weather.winddirection;
-    const int windpower = get_local_windpower( weather.windspeed, om_ter, p, winddirection,
-                          sheltered );
-
     const int current_intensity = cur.get_field_intensity();
     const field_type_id ft_id = cur.get_field_type();
 
@@ -287,8 +304,20 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
-    // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+    // Bail out if we don't meet the required intensity, before paying for the wind.
+    if( current_intensity <= 1 ) {
+        return;
+    }
+
+    // TODO: fix point types
+    const bool sheltered = g->is_sheltered( p );
+    weather_manager &weather = get_weather();
+    const int winddirection = weather.winddirection;
+    const int windpower = get_local_windpower( weather.windspeed, om_ter, p, winddirection,
+                          sheltered );
+
+    // Bail out if we don't meet the spread chance.
+    if( rng( 1, 100 - windpower ) > percent_spread ) {
         return;
     }
 
@@ -305,7 +334,9 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
 
     auto neighs = get_neighbors( p );
     size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
-    std::vector<size_t> spread;
+    // Indices into neighs, kept on the stack since this runs for every gas square every turn.
+    std::array<size_t, 8> spread;
+    size_t spread_count = 0;
     // Then, spread to a nearby point.
     // If not possible (or randomly), try to spread up
     // Wind direction will block the field spreading into the wind.
@@ -315,33 +346,35 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
          i = ( i + 1 ) % neighs.size(), count++ ) {
         const auto &neigh = neighs[i];
         if( gas_can_spread_to( cur, neigh.second ) ) {
-            spread.push_back( i );
+            spread[spread_count++] = i;
         }
     }
 
-    if( !spread.empty() && one_in( spread.size() ) ) {
+    if( spread_count != 0 && one_in( spread_count ) ) {
         // Construct the destination from offset and p
         if( sheltered || windpower < 5 ) {
-            std::pair<tripoint, maptile> &n = neighs[ random_entry( spread ) ];
+            std::pair<tripoint, maptile> &n = neighs[ spread[rng( 0, spread_count - 1 )] ];
             gas_spread_to( cur, n.second, n.first );
         } else {
-            std::vector<size_t> neighbour_vec;
+            std::array<size_t, 8> neighbour_vec;
+            size_t neighbour_count = 0;
             auto maptiles = get_wind_blockers( winddirection, p );
             // Three map tiles that are facing the wind direction.
             const maptile &remove_tile = std::get<0>( maptiles );
             const maptile &remove_tile2 = std::get<1>( maptiles );
             const maptile &remove_tile3 = std::get<2>( maptiles );
-            for( const auto &i : spread ) {
+            for( size_t j = 0; j < spread_count; ++j ) {
+                const size_t i = spread[j];
                 const auto &neigh = neighs[i].second;
                 if( ( neigh.pos_ != remove_tile.pos_ &&
                       neigh.pos_ != remove_tile2.pos_ &&
                       neigh.pos_ != remove_tile3.pos_ ) ||
                     x_in_y( 1, std::max( 2, windpower ) ) ) {
-                    neighbour_vec.push_back( i );
+                    neighbour_vec[neighbour_count++] = i;
                 }
             }
-            if( !neighbour_vec.empty() ) {
-                std::pair<tripoint, maptile> &n = neighs[ random_entry( neighbour_vec ) ];
+            if( neighbour_count != 0 ) {
+                std::pair<tripoint, maptile> &n = neighs[ neighbour_vec[rng( 0, neighbour_count - 1 )] ];
                 gas_spread_to( cur, n.second, n.first );
             }
         }
@@ -398,6 +431,29 @@ struct field_proc_data {
     field_type const *cur_fd_type;
 };
 
+static void field_processor_underwater_dissipation( const tripoint &, field_entry &cur,
+        field_proc_data &pd )
+{
+    // Dissipate faster in water
+    if( pd.map_tile.get_ter_t().has_flag( ter_furn_flag::TFLAG_SWIMMABLE ) ) {
+        cur.mod_field_age( pd.cur_fd_type->underwater_age_speedup );
+    }
+}
+
+// Whether the processors of the field type would leave its entries alone on this square.
+static bool field_processors_idle( const field_type &ft, const maptile &map_tile )
+{
+    for( const FieldProcessorPtr &proc : ft.get_processors() ) {
+        // Gore only has this one, and most of it is not lying in water.
+        if( proc == &field_processor_underwater_dissipation &&
+            !map_tile.get_ter_t().has_flag( ter_furn_flag::TFLAG_SWIMMABLE ) ) {
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
 /*
 Function: process_fields_in_submap
 Iterates over every field on every tile of the given submap given as parameter.
@@ -427,9 +483,15 @@ void map::process_fields_in_submap( submap *const current_submap,
         &( *fd_null )
     };
 
-    // Loop through all tiles in this submap indicated by current_submap
+    current_submap->wake_field_tiles( calendar::turn );
+
+    // Loop through the tiles of this submap that are marked as holding fields
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            if( !current_submap->field_tile_marked( map_tile.pos() ) ||
+                current_submap->field_tile_asleep( map_tile.pos() ) ) {
+                continue;
+            }
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
             field &curfield = current_submap->get_field( {static_cast<int>( locx ), static_cast<int>( locy )} );
@@ -437,15 +499,21 @@ void map::process_fields_in_submap( submap *const current_submap,
             // when displayed_field_type == fd_null it means that `curfield` has no fields inside
             // avoids instantiating (relatively) expensive map iterator
             if( !curfield.displayed_field_type() ) {
+                current_submap->unmark_field_tile( map_tile.pos() );
                 continue;
             }
 
             // This is a translation from local coordinates to submap coordinates.
             const tripoint p = tripoint( map_tile.pos() + sm_offset, submap.z );
 
+            // Whether every entry left on the square only ages until the wake time,
+            // like old blood and gibs, so the square can be skipped until then.
+            bool idle = true;
+            cata::optional<time_point> wake;
             for( auto it = curfield.begin(); it != curfield.end(); ) {
                 // Iterating through all field effects in the submap's field.
                 field_entry &cur = it->second;
+                cur.wake_up();
                 const int prev_intensity = cur.is_field_alive() ? cur.get_field_intensity() : 0;
 
                 pd.cur_fd_type_id = cur.get_field_type();
@@ -465,6 +533,7 @@ void map::process_fields_in_submap( submap *const current_submap,
                     if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
                         on_field_modified( p, *pd.cur_fd_type );
                     }
+                    idle = false;
                     it++;
                     continue;
                 }
@@ -477,8 +546,18 @@ void map::process_fields_in_submap( submap *const current_submap,
                 if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
                     on_field_modified( p, *pd.cur_fd_type );
                 }
+                idle = idle && field_processors_idle( *pd.cur_fd_type, map_tile ) &&
+                       cur.is_idle( wake );
                 it++;
             }
+            if( !curfield.displayed_field_type() ) {
+                current_submap->unmark_field_tile( map_tile.pos() );
+            } else if( idle ) {
+                for( auto &entry : curfield ) {
+                    entry.second.fall_asleep();
+                }
+                current_submap->sleep_field_tile( map_tile.pos(), wake );
+            }
         }
     }
     sblk.commit_modifications();
@@ -497,15 +576,6 @@ static void field_processor_upgrade_intensity( const tripoint &, field_entry &cu
     }
 }
 
-static void field_processor_underwater_dissipation( const tripoint &, field_entry &cur,
-        field_proc_data &pd )
-{
-    // Dissipate faster in water
-    if( pd.map_tile.get_ter_t().has_flag( ter_furn_flag::TFLAG_SWIMMABLE ) ) {
-        cur.mod_field_age( pd.cur_fd_type->underwater_age_speedup );
-    }
-}
-
 static void field_processor_fd_acid( const tripoint &p, field_entry &cur, field_proc_data &pd )
 {
     //cur_fd_type_id == fd_acid
@@ -1151,8 +1221,8 @@ void field_processor_fd_fire( const tripoint &p, field_entry &cur, field_proc_da
     maptile remove_tile = std::get<0>( maptiles );
     maptile remove_tile2 = std::get<1>( maptiles );
     maptile remove_tile3 = std::get<2>( maptiles );
-    std::vector<size_t> neighbour_vec;
-    neighbour_vec.reserve( neighs.size() );
+    std::array<size_t, 8> neighbour_vec;
+    size_t neighbour_count = 0;
     size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
     // Start at end_it + 1, then wrap around until all elements have been processed
     for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
@@ -1163,7 +1233,7 @@ void field_processor_fd_fire( const tripoint &p, field_entry &cur, field_proc_da
             ( neigh.pos().x != remove_tile2.pos().x && neigh.pos().y != remove_tile2.pos().y ) ||
             ( neigh.pos().x != remove_tile3.pos().x && neigh.pos().y != remove_tile3.pos().y ) ||
             x_in_y( 1, std::max( 2, windpower ) ) ) {
-            neighbour_vec.push_back( i );
+            neighbour_vec[neighbour_count++] = i;
         }
     }
     // If the flames are in a pit, it can't spread to non-pit
@@ -1205,10 +1275,10 @@ void field_processor_fd_fire( const tripoint &p, field_entry &cur, field_proc_da
                     }
                 }
             } else {
-                end_it = static_cast<size_t>( rng( 0, neighbour_vec.size() - 1 ) );
-                for( size_t i = ( end_it + 1 ) % neighbour_vec.size(), count = 0;
-                     count != neighbour_vec.size() && cur.get_field_age() < 0_turns;
-                     i = ( i + 1 ) % neighbour_vec.size(), count++ ) {
+                end_it = static_cast<size_t>( rng( 0, neighbour_count - 1 ) );
+                for( size_t i = ( end_it + 1 ) % neighbour_count, count = 0;
+                     count != neighbour_count && cur.get_field_age() < 0_turns;
+                     i = ( i + 1 ) % neighbour_count, count++ ) {
                     maptile &dst = neighs[neighbour_vec[i]].second;
                     field_entry *dstfld = dst.find_field( fd_fire );
                     // If the fire exists and is weaker than ours, boost it
@@ -1333,8 +1403,7 @@ void field_processor_fd_fire( const tripoint &p, field_entry &cur, field_proc_da
                     ( power >= 3 && ( ter_furn_has_flag( dster, dsfrn, ter_furn_flag::TFLAG_FLAMMABLE_HARD ) &&
                                       one_in( 5 ) ) ) ||
                     nearwebfld ||
-                    ( one_in( 5 ) && dst.get_item_count() > 0 &&
-                      here.flammable_items_at( p + eight_horizontal_neighbors[i] ) )
+                    ( one_in( 5 ) && flammable_items_in( dst ) )
                 ) ) {
                 // Nearby open flammable ground? Set it on fire.
                 // Make the new fire quite weak, so that it doesn't start jumping around instantly
@@ -1348,16 +1417,16 @@ void field_processor_fd_fire( const tripoint &p, field_entry &cur, field_proc_da
             }
         }
     } else {
-        const size_t end_i = static_cast<size_t>( rng( 0, neighbour_vec.size() - 1 ) );
-        for( size_t i = ( end_i + 1 ) % neighbour_vec.size(), count = 0;
-             count != neighbour_vec.size();
-             i = ( i + 1 ) % neighbour_vec.size(), count++ ) {
+        const size_t end_i = static_cast<size_t>( rng( 0, neighbour_count - 1 ) );
+        for( size_t i = ( end_i + 1 ) % neighbour_count, count = 0;
+             count != neighbour_count;
+             i = ( i + 1 ) % neighbour_count, count++ ) {
             if( one_in( cur.get_field_intensity() * 2 ) ) {
                 // Skip some processing to save on CPU
                 continue;
             }
 
-            if( neighbour_vec.empty() ) {
+            if( neighbour_count == 0 ) {
                 continue;
             }
 
@@ -1393,8 +1462,7 @@ void field_processor_fd_fire( const tripoint &p, field_entry &cur, field_proc_da
                     ( power >= 3 && ( ter_furn_has_flag( dster, dsfrn, ter_furn_flag::TFLAG_FLAMMABLE_HARD ) &&
                                       one_in( 5 ) ) ) ||
                     nearwebfld ||
-                    ( one_in( 5 ) && dst.get_item_count() > 0 &&
-                      here.flammable_items_at( p + eight_horizontal_neighbors[i] ) )
+                    ( one_in( 5 ) && flammable_items_in( dst ) )
                 ) ) {
                 // Nearby open flammable ground? Set it on fire.
                 // Make the new fire quite weak, so that it doesn't start jumping around instantly
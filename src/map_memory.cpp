@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
 #include "cata_assert.h"
 #include "cached_options.h"
 #include "cata_utility.h"
@@ -5,9 +11,14 @@
 #include "cuboid_rectangle.h"
 #include "debug.h"
 #include "filesystem.h"
+#include "json.h"
 #include "line.h"
 #include "map_memory.h"
+#include "memory_stats.h"
+#include "output.h"
 #include "path_info.h"
+#include "save_journal.h"
+#include "save_stats.h"
 #include "string_formatter.h"
 #include "translations.h"
 
@@ -46,6 +57,71 @@ struct reg_coord_pair {
     }
 };
 
+namespace
+{
+
+struct tile_names {
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<std::string> names{ std::string() };
+};
+
+tile_names &get_tile_names()
+{
+    static tile_names data;
+    return data;
+}
+
+} // namespace
+
+const std::string &mm_submap::tile_name( const uint32_t id )
+{
+    const tile_names &table = get_tile_names();
+    return id < table.names.size() ? table.names[id] : table.names[0];
+}
+
+uint32_t mm_submap::intern_tile_name( const std::string &name )
+{
+    if( name.empty() ) {
+        return 0;
+    }
+    tile_names &table = get_tile_names();
+    const auto found = table.ids.find( name );
+    if( found != table.ids.end() ) {
+        return found->second;
+    }
+    const uint32_t id = table.names.size();
+    if( id > tile_id_mask ) {
+        debugmsg( "Too many distinct memorized tiles, forgetting %s", name );
+        return 0;
+    }
+    table.ids.emplace( name, id );
+    table.names.push_back( name );
+    return id;
+}
+
+mm_submap::packed_tile mm_submap::pack( const memorized_terrain_tile &value )
+{
+    int subtile = value.subtile;
+    if( subtile < 0 || subtile >= 1 << subtile_bits ) {
+        debugmsg( "Memorized tile %s has out of range subtile %d", value.tile, subtile );
+        subtile = 0;
+    }
+    // Vehicle parts pass their facing in degrees, everything else a rotation of 0 to 3.
+    const int rotation = ( value.rotation % 360 + 360 ) % 360;
+    return intern_tile_name( value.tile ) |
+           static_cast<uint32_t>( subtile ) << tile_id_bits |
+           static_cast<uint32_t>( rotation ) << ( tile_id_bits + subtile_bits );
+}
+
+memorized_terrain_tile mm_submap::unpack( const packed_tile value )
+{
+    return memorized_terrain_tile{
+        tile_name( tile_id( value ) ),
+        static_cast<int>( value >> tile_id_bits & ( ( 1u << subtile_bits ) - 1 ) ),
+        static_cast<int>( value >> ( tile_id_bits + subtile_bits ) )
+    };
+}
+
 mm_submap::mm_submap() = default;
 mm_submap::mm_submap( bool make_valid ) : valid( make_valid ) {}
 
@@ -73,7 +149,114 @@ map_memory::map_memory()
     clear_cache();
 }
 
-const memorized_terrain_tile &map_memory::get_tile( const tripoint &pos ) const
+map_memory::~map_memory()
+{
+    finish_prefetch();
+    // Too late to report anything, but the files still get written.
+    if( writer.joinable() ) {
+        writer.join();
+    }
+}
+
+bool map_memory::flush()
+{
+    if( writer.joinable() ) {
+        writer.join();
+    }
+    if( !write_error.empty() ) {
+        popup( _( "Failed to save the memory map: %s" ), write_error );
+        write_error.clear();
+        return false;
+    }
+    return true;
+}
+
+memory_usage map_memory::memory_use() const
+{
+    memory_usage usage;
+    for( const auto &sm : submaps ) {
+        ++usage.count;
+        usage.bytes += sm.second->memory_bytes();
+    }
+    return usage;
+}
+
+void map_memory::finish_prefetch()
+{
+    if( prefetcher.joinable() ) {
+        prefetcher.join();
+    }
+}
+
+void map_memory::prefetch_around_cache()
+{
+    if( test_mode ) {
+        return;
+    }
+    const std::string dirname = find_mm_dir();
+    if( !dir_exist( dirname ) ) {
+        return;
+    }
+    finish_prefetch();
+
+    // The regions one region's width beyond the cached area on every side; the ones
+    // inside it were just loaded.  Paths are worked out here, the thread only touches
+    // the file system.
+    const point margin( MM_REG_SIZE, MM_REG_SIZE );
+    const tripoint reg_min = reg_coord_pair( cache_pos - margin ).reg;
+    const tripoint reg_max = reg_coord_pair( cache_pos + cache_size + margin ).reg;
+    std::vector<std::string> paths;
+    for( int y = reg_min.y; y <= reg_max.y; y++ ) {
+        for( int x = reg_min.x; x <= reg_max.x; x++ ) {
+            const tripoint reg( x, y, cache_pos.z );
+            // Regions are always loaded whole, so one of their submaps tells.
+            if( submaps.count( mmr_to_sm_copy( reg ) ) == 0 ) {
+                paths.push_back( find_region_path( dirname, reg ) );
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock( region_files_mutex );
+        // Files still being written would be read half old, and loading finds them anyway.
+        const auto being_written = [this]( const std::string & path ) {
+            return unwritten.count( path ) != 0;
+        };
+        paths.erase( std::remove_if( paths.begin(), paths.end(), being_written ), paths.end() );
+        for( auto it = prefetched.begin(); it != prefetched.end(); ) {
+            if( std::find( paths.begin(), paths.end(), it->first ) == paths.end() ) {
+                it = prefetched.erase( it );
+            } else {
+                ++it;
+            }
+        }
+        const auto already_read = [this]( const std::string & path ) {
+            return prefetched.count( path ) != 0;
+        };
+        paths.erase( std::remove_if( paths.begin(), paths.end(), already_read ), paths.end() );
+    }
+    if( paths.empty() ) {
+        return;
+    }
+
+    prefetcher = std::thread( [this, paths]() {
+        for( const std::string &path : paths ) {
+            std::string contents;
+            try {
+                if( !file_exist( path ) ) {
+                    continue;
+                }
+                contents = read_entire_file( path );
+            } catch( const std::exception & ) {
+                // Leave it to load_submap, which reports errors from the main thread.
+                continue;
+            }
+            std::lock_guard<std::mutex> lock( region_files_mutex );
+            prefetched[path] = std::move( contents );
+        }
+    } );
+}
+
+memorized_terrain_tile map_memory::get_tile( const tripoint &pos ) const
 {
     coord_pair p( pos );
     const mm_submap &sm = get_submap( p.sm );
@@ -148,6 +331,7 @@ bool map_memory::prepare_region( const tripoint &p1, const tripoint &p2 )
             cached.push_back( fetch_submap( cache_pos + point( dx, dy ) ) );
         }
     }
+    prefetch_around_cache();
     return true;
 }
 
@@ -217,8 +401,28 @@ shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint &sm_pos )
         mmr.deserialize( jsin );
     };
 
+    std::string contents;
+    {
+        std::lock_guard<std::mutex> lock( region_files_mutex );
+        const auto pending = unwritten.find( path );
+        const auto it = prefetched.find( path );
+        if( pending != unwritten.end() ) {
+            // The writer may be busy with it, so it has to stay where it is.
+            contents = pending->second;
+        } else if( it != prefetched.end() ) {
+            contents = std::move( it->second );
+            prefetched.erase( it );
+        }
+    }
+    // Compressed files are left to read_from_file_optional_json, which inflates them.
+    const bool compressed = contents.size() >= 2 && contents[0] == '\x1f' && contents[1] == '\x8b';
+
     try {
-        if( !read_from_file_optional_json( path, loader ) ) {
+        if( !contents.empty() && !compressed ) {
+            std::istringstream fin( contents );
+            JsonIn jsin( fin, path );
+            loader( jsin );
+        } else if( !read_from_file_optional_json( path, loader ) ) {
             // Region not found
             return nullptr;
         }
@@ -280,6 +484,9 @@ void map_memory::load( const tripoint &pos )
 {
     const std::string dirname = find_mm_dir();
 
+    finish_prefetch();
+    flush();
+    prefetched.clear();
     clear_cache();
 
     if( !dir_exist( dirname ) ) {
@@ -311,10 +518,14 @@ void map_memory::load( const tripoint &pos )
 
 bool map_memory::save( const tripoint &pos )
 {
+    save_timer timer( save_part::map_memory );
     tripoint sm_center = coord_pair( pos ).sm;
     const std::string dirname = find_mm_dir();
     assure_dir_exist( dirname );
 
+    // Regions are about to be written, so neither thread may be working on them.
+    finish_prefetch();
+    const bool wrote_previous = flush();
     clear_cache();
 
     dbg( D_INFO ) << "N submaps before save: " << submaps.size();
@@ -334,27 +545,18 @@ bool map_memory::save( const tripoint &pos )
     dbg( D_INFO ) << "[SAVE] Saving memory map around " << sm_center << ". Keeping submaps within " <<
                   rect_keep.p_min << "->" << rect_keep.p_max;
 
-    bool result = true;
-
     for( auto &it : regions ) {
         const tripoint &regp = it.first;
         mm_region &reg = it.second;
         if( !reg.is_empty() ) {
             const std::string path = find_region_path( dirname, regp );
-            const std::string descr = string_format(
-                                          _( "memory map region for (%d,%d,%d)" ),
-                                          regp.x, regp.y, regp.z
-                                      );
-
-            const auto writer = [&]( std::ostream & fout ) -> void {
-                fout << serialize_wrapper( [&]( JsonOut & jsout )
-                {
-                    reg.serialize( jsout );
-                } );
-            };
-
-            const bool res = write_to_file( path, writer, descr.c_str() );
-            result = result & res;
+            // Whatever was read ahead of time is older than what gets written now.
+            prefetched.erase( path );
+            std::string &contents = unwritten[path];
+            contents = serialize_wrapper( [&]( JsonOut & jsout ) {
+                reg.serialize( jsout );
+            } );
+            save_stats::add_file( save_part::map_memory, contents.size() );
         }
         tripoint regp_sm = mmr_to_sm_copy( regp );
         half_open_rectangle<point> rect_reg( regp_sm.xy(), regp_sm.xy() + point( MM_REG_SIZE,
@@ -377,7 +579,41 @@ bool map_memory::save( const tripoint &pos )
     dbg( D_INFO ) << "[SAVE] Done.";
     dbg( D_INFO ) << "N submaps after save: " << submaps.size();
 
-    return result;
+    std::vector<std::string> paths;
+    paths.reserve( unwritten.size() );
+    for( const auto &elem : unwritten ) {
+        paths.push_back( elem.first );
+    }
+    if( paths.empty() ) {
+        return wrote_previous;
+    }
+    // Options are only safe to read here, on the main thread.
+    const bool compress = compress_save_files();
+    // Nothing else adds to unwritten until this thread is joined, so the contents
+    // stay put while they are written; only erasing needs the lock.
+    writer = std::thread( [this, paths, compress]() {
+        for( const std::string &path : paths ) {
+            const std::string &contents = unwritten.find( path )->second;
+            try {
+                write_to_file( path, [&]( std::ostream & fout ) {
+                    fout << contents;
+                }, compress );
+            } catch( const std::exception &err ) {
+                std::lock_guard<std::mutex> lock( region_files_mutex );
+                if( write_error.empty() ) {
+                    write_error = string_format( "%s: %s", path, err.what() );
+                }
+                continue;
+            }
+            std::lock_guard<std::mutex> lock( region_files_mutex );
+            unwritten.erase( path );
+        }
+    } );
+    if( save_journal::capturing() ) {
+        // Only writes made while the journal captures end up in it.
+        return flush() && wrote_previous;
+    }
+    return wrote_previous;
 }
 
 void map_memory::clear_cache()
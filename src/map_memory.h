@@ -2,7 +2,14 @@
 #ifndef CATA_SRC_MAP_MEMORY_H
 #define CATA_SRC_MAP_MEMORY_H
 
+#include <cstdint>
 #include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "game_constants.h"
 #include "memory_fast.h"
@@ -12,6 +19,8 @@ class JsonOut;
 class JsonIn;
 class JsonObject;
 class JsonOut;
+struct memory_usage;
+struct mm_tile_palette;
 
 struct memorized_terrain_tile {
     std::string tile;
@@ -27,12 +36,31 @@ struct memorized_terrain_tile {
     }
 };
 
-/** Represent a submap-sized chunk of tile memory. */
+/**
+ * Represent a submap-sized chunk of tile memory.
+ *
+ * Tiles are kept packed into 32 bits each: the low 19 bits are an id into one process-wide
+ * table of interned tile names, followed by 4 bits of subtile and 9 bits of rotation (vehicle
+ * parts remember their facing in degrees).  Id 0 is the empty name, so a zero record is
+ * default_tile.  The names are only looked up again when a tile is read back.
+ */
 struct mm_submap {
     public:
         static const memorized_terrain_tile default_tile;
         static const int default_symbol;
 
+        using packed_tile = uint32_t;
+        static packed_tile pack( const memorized_terrain_tile &value );
+        static memorized_terrain_tile unpack( packed_tile value );
+        /** The id of the tile name in a packed record. */
+        static uint32_t tile_id( packed_tile value ) {
+            return value & tile_id_mask;
+        }
+        /** The interned name of a tile id. */
+        static const std::string &tile_name( uint32_t id );
+        /** The id of name, added to the table if it was not there yet. */
+        static uint32_t intern_tile_name( const std::string &name );
+
         mm_submap();
         explicit mm_submap( bool make_valid );
 
@@ -41,24 +69,41 @@ struct mm_submap {
             return tiles.empty() && symbols.empty();
         }
 
+        /** Estimate of the bytes this holds, with the tiles and symbols. */
+        size_t memory_bytes() const {
+            return sizeof( *this ) + tiles.capacity() * sizeof( packed_tile ) +
+                   symbols.capacity() * sizeof( int );
+        }
+
         // Whether this mm_submap is invalid, i.e. returned from an uninitialized region.
         bool is_valid() const {
             return valid;
         }
 
-        inline const memorized_terrain_tile &tile( const point &p ) const {
+        inline memorized_terrain_tile tile( const point &p ) const {
+            return unpack( packed( p ) );
+        }
+
+        inline packed_tile packed( const point &p ) const {
             if( tiles.empty() ) {
-                return default_tile;
+                return 0;
             } else {
                 return tiles[p.y * SEEX + p.x];
             }
         }
 
         inline void set_tile( const point &p, const memorized_terrain_tile &value ) {
+            set_packed( p, pack( value ) );
+        }
+
+        inline void set_packed( const point &p, packed_tile value ) {
             if( tiles.empty() ) {
+                if( value == 0 ) {
+                    return;
+                }
                 // call 'reserve' first to force allocation of exact size
                 tiles.reserve( SEEX * SEEY );
-                tiles.resize( SEEX * SEEY, default_tile );
+                tiles.resize( SEEX * SEEY, 0 );
             }
             tiles[p.y * SEEX + p.x] = value;
         }
@@ -80,12 +125,21 @@ struct mm_submap {
             symbols[p.y * SEEX + p.x] = value;
         }
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( JsonIn &jsin );
+        /** Writes the tiles as indices into palette, which must hold all their names. */
+        void serialize( JsonOut &jsout, const mm_tile_palette &palette ) const;
+        /**
+         * Reads tiles written either as indices into palette or, in saves from before the
+         * palette, as names.
+         */
+        void deserialize( JsonIn &jsin, const std::vector<uint32_t> &palette );
 
     private:
+        static constexpr uint32_t tile_id_bits = 19;
+        static constexpr uint32_t subtile_bits = 4;
+        static constexpr uint32_t tile_id_mask = ( 1u << tile_id_bits ) - 1;
+
         // NOLINTNEXTLINE(cata-serialize)
-        std::vector<memorized_terrain_tile> tiles; // holds either 0 or SEEX*SEEY elements
+        std::vector<packed_tile> tiles; // holds either 0 or SEEX*SEEY elements
         // NOLINTNEXTLINE(cata-serialize)
         std::vector<int> symbols; // holds either 0 or SEEX*SEEY elements
         bool valid = true; // NOLINT(cata-serialize)
@@ -94,7 +148,8 @@ struct mm_submap {
 /**
  * Represents a square of mm_submaps.
  * For faster save/load, submaps are collected into regions
- * and each region is saved in its own file.
+ * and each region is saved in its own file.  The file starts with the names of the tiles
+ * the region remembers, and the submaps refer to them by their index in that list.
  */
 struct mm_region {
     shared_ptr_fast<mm_submap> submaps[MM_REG_SIZE][MM_REG_SIZE];
@@ -130,6 +185,10 @@ class map_memory
 
     public:
         map_memory();
+        ~map_memory();
+
+        map_memory( const map_memory & ) = delete;
+        map_memory &operator=( const map_memory & ) = delete;
 
         /** Load memorized submaps around given global map square pos. */
         void load( const tripoint &pos );
@@ -137,14 +196,29 @@ class map_memory
         /** Load legacy memory file. TODO: remove after 0.F (or whatever BN will have instead). */
         void load_legacy( JsonIn &jsin );
 
-        /** Save memorized submaps to disk, drop ones far from given global map square pos. */
+        /**
+         * Save memorized submaps to disk, drop ones far from given global map square pos.
+         * The regions are serialized right away, but the files are written by a background
+         * thread; @ref flush waits for that.
+         * @returns false if writing the files of the previous save failed.
+         */
         bool save( const tripoint &pos );
+        /**
+         * Wait until the files of the last @ref save are written, and report failures.
+         * @returns whether all of them were written.
+         */
+        bool flush();
+
+        /** The loaded submaps, and an estimate of the bytes they hold. */
+        memory_usage memory_use() const;
 
         /**
          * Prepares map memory for rendering and/or memorization of given region.
          * @param p1 top-left corner of the region, in global ms coords
          * @param p2 bottom-right corner of the region, in global ms coords
          * Both coords are inclusive and should be on the same Z level.
+         * Region files around it that are not loaded yet are read ahead on a background
+         * thread, so that moving the view further does not wait for the disk.
          * @return whether the region was re-cached
          */
         bool prepare_region( const tripoint &p1, const tripoint &p2 );
@@ -159,7 +233,7 @@ class map_memory
          * Returns memorized tile.
          * @param pos tile position, in global ms coords.
          */
-        const memorized_terrain_tile &get_tile( const tripoint &pos ) const;
+        memorized_terrain_tile get_tile( const tripoint &pos ) const;
 
         /**
          * Memorizes given symbol, overwriting old value.
@@ -202,6 +276,25 @@ class map_memory
         //@}
 
         void clear_cache();
+
+        /** Start reading the files of the regions next to the cached area that are not loaded. */
+        void prefetch_around_cache();
+        /** Wait for the thread started by @ref prefetch_around_cache, if any. */
+        void finish_prefetch();
+
+        std::thread prefetcher;
+        std::thread writer;
+        /** Guards @ref prefetched and @ref unwritten, which the threads work through. */
+        std::mutex region_files_mutex;
+        /** Contents of region files read ahead of time, by file path. */
+        std::unordered_map<std::string, std::string> prefetched;
+        /**
+         * Serialized regions waiting for the writer, by file path. They are newer than the
+         * files on disk, so loading reads them from here.
+         */
+        std::unordered_map<std::string, std::string> unwritten;
+        /** Why the writer failed to write a file, reported by @ref flush. */
+        std::string write_error;
 };
 
 #endif // CATA_SRC_MAP_MEMORY_H
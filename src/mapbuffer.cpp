@@ -1,5 +1,6 @@
 #include "mapbuffer.h"
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <functional>
@@ -19,9 +20,12 @@
 #include "map.h"
 #include "output.h"
 #include "path_info.h"
+#include "save_journal.h"
+#include "save_stats.h"
 #include "popup.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "trace_zones.h"
 #include "translations.h"
 #include "ui_manager.h"
 
@@ -48,11 +52,142 @@ static std::string find_dirname( const tripoint &om_addr )
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
-mapbuffer::~mapbuffer() = default;
+
+mapbuffer::~mapbuffer()
+{
+    finish_prefetch();
+    // Too late to report anything, but the files still get written.
+    if( writer.joinable() ) {
+        writer.join();
+    }
+}
 
 void mapbuffer::clear()
 {
+    finish_prefetch();
+    flush();
     submaps.clear();
+    prefetched.clear();
+    unwritten.clear();
+    written_hashes.clear();
+    recent.fill( recent_submap() );
+}
+
+void mapbuffer::flush()
+{
+    if( writer.joinable() ) {
+        writer.join();
+    }
+    if( !write_error.empty() ) {
+        popup( _( "Failed to save the maps: %s" ), write_error );
+        write_error.clear();
+    }
+}
+
+void mapbuffer::start_writer()
+{
+    std::vector<std::string> paths;
+    paths.reserve( unwritten.size() );
+    for( const auto &elem : unwritten ) {
+        paths.push_back( elem.first );
+    }
+    if( paths.empty() ) {
+        return;
+    }
+    // Options are only safe to read here, on the main thread.
+    const bool compress = compress_save_files();
+    // Nothing else adds to unwritten until this thread is joined, so the contents
+    // stay put while they are written; only erasing needs the lock.
+    writer = std::thread( [this, paths, compress]() {
+        for( const std::string &path : paths ) {
+            const std::string &contents = unwritten.find( path )->second;
+            try {
+                write_to_file( path, [&]( std::ostream & fout ) {
+                    fout << contents;
+                }, compress );
+            } catch( const std::exception &err ) {
+                std::lock_guard<std::mutex> lock( quad_files_mutex );
+                if( write_error.empty() ) {
+                    write_error = string_format( "%s: %s", path, err.what() );
+                }
+                written_hashes.erase( path );
+                continue;
+            }
+            std::lock_guard<std::mutex> lock( quad_files_mutex );
+            unwritten.erase( path );
+        }
+    } );
+}
+
+void mapbuffer::finish_prefetch()
+{
+    if( prefetcher.joinable() ) {
+        prefetcher.join();
+    }
+}
+
+void mapbuffer::prefetch_quads( const std::vector<tripoint> &om_addrs )
+{
+    finish_prefetch();
+
+    // Paths are worked out here, the thread only touches the file system.
+    std::vector<std::string> paths;
+    for( const tripoint &om_addr : om_addrs ) {
+        if( find_submap( omt_to_sm_copy( om_addr ) ) == nullptr ) {
+            paths.push_back( find_quad_path( find_dirname( om_addr ), om_addr ) );
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock( quad_files_mutex );
+        // Files still being written would be read half old, and loading finds them anyway.
+        const auto being_written = [this]( const std::string & path ) {
+            return unwritten.count( path ) != 0;
+        };
+        paths.erase( std::remove_if( paths.begin(), paths.end(), being_written ), paths.end() );
+        for( auto it = prefetched.begin(); it != prefetched.end(); ) {
+            if( std::find( paths.begin(), paths.end(), it->first ) == paths.end() ) {
+                it = prefetched.erase( it );
+            } else {
+                ++it;
+            }
+        }
+        const auto already_read = [this]( const std::string & path ) {
+            return prefetched.count( path ) != 0;
+        };
+        paths.erase( std::remove_if( paths.begin(), paths.end(), already_read ), paths.end() );
+    }
+    if( paths.empty() ) {
+        return;
+    }
+
+    prefetcher = std::thread( [this, paths]() {
+        for( const std::string &path : paths ) {
+            std::string contents;
+            try {
+                if( !file_exist( path ) ) {
+                    continue;
+                }
+                contents = read_entire_file( path );
+            } catch( const std::exception & ) {
+                // Leave it to lookup_submap, which reports errors from the main thread.
+                continue;
+            }
+            std::lock_guard<std::mutex> lock( quad_files_mutex );
+            prefetched[path] = std::move( contents );
+        }
+    } );
+}
+
+size_t mapbuffer::recent_slot( const tripoint &p )
+{
+    // Neighbouring submaps land in different slots, which is all the map needs.
+    return static_cast<size_t>( ( p.x & 7 ) + 8 * ( p.y & 7 ) ) % recent_submaps_size;
+}
+
+submap *mapbuffer::find_submap( const tripoint &p ) const
+{
+    const auto iter = submaps.find( p );
+    return iter == submaps.end() ? nullptr : iter->second.get();
 }
 
 bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
@@ -61,7 +196,7 @@ bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
         return false;
     }
 
-    submaps[p] = std::move( sm );
+    submaps.emplace( p, std::move( sm ) );
 
     return true;
 }
@@ -85,28 +220,74 @@ void mapbuffer::remove_submap( tripoint addr )
         debugmsg( "Tried to remove non-existing submap %d,%d,%d", addr.x, addr.y, addr.z );
         return;
     }
+    recent_submap &slot = recent[recent_slot( addr )];
+    if( slot.p == addr ) {
+        slot = recent_submap();
+    }
     submaps.erase( m_target );
 }
 
+bool mapbuffer::drop_uniform_quad( const tripoint &om_addr )
+{
+    const tripoint first = omt_to_sm_copy( om_addr );
+    std::vector<tripoint> loaded;
+    for( const point &offset : {
+             point_zero, point_south, point_east, point_south_east
+         } ) {
+        const tripoint addr = first + offset;
+        const submap *sm = find_submap( addr );
+        if( sm == nullptr ) {
+            continue;
+        }
+        if( !sm->is_uniform ) {
+            return false;
+        }
+        loaded.push_back( addr );
+    }
+    for( const tripoint &addr : loaded ) {
+        remove_submap( addr );
+    }
+    return !loaded.empty();
+}
+
+void mapbuffer::drop_submap( const tripoint &p )
+{
+    if( find_submap( p ) != nullptr ) {
+        remove_submap( p );
+    }
+}
+
 submap *mapbuffer::lookup_submap( const tripoint &p )
 {
     dbg( D_INFO ) << "mapbuffer::lookup_submap( x[" << p.x << "], y[" << p.y << "], z[" << p.z << "])";
 
-    const auto iter = submaps.find( p );
-    if( iter == submaps.end() ) {
+    recent_submap &slot = recent[recent_slot( p )];
+    if( slot.sm != nullptr && slot.p == p ) {
+        return slot.sm;
+    }
+
+    submap *sm = find_submap( p );
+    if( sm == nullptr ) {
         try {
-            return unserialize_submaps( p );
+            sm = unserialize_submaps( p );
         } catch( const std::exception &err ) {
             debugmsg( "Failed to load submap (%d,%d,%d): %s", p.x, p.y, p.z, err.what() );
         }
-        return nullptr;
     }
-
-    return iter->second.get();
+    if( sm != nullptr ) {
+        slot.p = p;
+        slot.sm = sm;
+    }
+    return sm;
 }
 
 void mapbuffer::save( bool delete_after_save )
 {
+    save_timer timer( save_part::submaps );
+    CATA_TRACE_ZONE( "mapbuffer::save" );
+    // Quads are about to be written, so neither thread may be working on them.
+    finish_prefetch();
+    flush();
     assure_dir_exist( PATH_INFO::world_base_save_path() + "/maps" );
 
     int num_saved_submaps = 0;
@@ -121,10 +302,20 @@ void mapbuffer::save( bool delete_after_save )
     // A set of already-saved submaps, in global overmap coordinates.
     std::set<tripoint> saved_submaps;
     std::list<tripoint> submaps_to_delete;
+    // Segment directories known to exist, so each is only checked once per save().
+    std::set<std::string> made_dirs;
     static constexpr std::chrono::milliseconds update_interval( 500 );
     auto last_update = std::chrono::steady_clock::now();
 
-    for( auto &elem : submaps ) {
+    // Save in coordinate order, so the quads of a segment are written together.
+    std::vector<tripoint> addrs;
+    addrs.reserve( submaps.size() );
+    for( const auto &elem : submaps ) {
+        addrs.push_back( elem.first );
+    }
+    std::sort( addrs.begin(), addrs.end() );
+
+    for( const tripoint &addr : addrs ) {
         auto now = std::chrono::steady_clock::now();
         if( last_update + update_interval < now ) {
             popup.message( _( "Please wait as the map saves [%d/%d]" ),
@@ -138,7 +329,7 @@ void mapbuffer::save( bool delete_after_save )
         // we're saving a 2x2 quad of submaps at a time.
         // Submaps are generated in quads, so we know if we have one member of a quad,
         // we have the rest of it, if that assumption is broken we have REAL problems.
-        const tripoint om_addr = sm_to_omt_copy( elem.first );
+        const tripoint om_addr = sm_to_omt_copy( addr );
         if( saved_submaps.count( om_addr ) != 0 ) {
             // Already handled this one.
             continue;
@@ -147,14 +338,13 @@ void mapbuffer::save( bool delete_after_save )
 
         // A segment is a chunk of 32x32 submap quads.
         // We're breaking them into subdirectories so there aren't too many files per directory.
-        // Might want to make a set for this one too so it's only checked once per save().
         const std::string dirname = find_dirname( om_addr );
         const std::string quad_path = find_quad_path( dirname, om_addr );
 
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != get_map().get_abs_sub().z;
-        save_quad( dirname, quad_path, om_addr, submaps_to_delete,
+        save_quad( dirname, quad_path, om_addr, submaps_to_delete, made_dirs,
                    delete_after_save || zlev_del ||
                    om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
                    om_addr.x > map_origin.x + HALF_MAPSIZE ||
@@ -164,11 +354,16 @@ void mapbuffer::save( bool delete_after_save )
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    start_writer();
+    if( save_journal::capturing() ) {
+        // Only writes made while the journal captures end up in it.
+        flush();
+    }
 }
 
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+                           std::set<std::string> &made_dirs, bool delete_after_save )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -183,7 +378,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr].get();
+        submap *sm = find_submap( submap_addr );
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
@@ -193,7 +388,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                if( find_submap( submap_addr ) != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -202,21 +397,32 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
+    // Whatever was read ahead of time is older than what gets written now.
+    {
+        std::lock_guard<std::mutex> lock( quad_files_mutex );
+        prefetched.erase( filename );
+    }
+
     // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
+    if( made_dirs.count( dirname ) == 0 ) {
+        assure_dir_exist( dirname );
+        made_dirs.insert( dirname );
+    }
+    std::ostringstream fout;
+    int items = 0;
+    {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr].get();
-
+            submap *sm = find_submap( submap_addr );
             if( sm == nullptr ) {
                 continue;
             }
+            for( int x = 0; x < SEEX; ++x ) {
+                for( int y = 0; y < SEEY; ++y ) {
+                    items += static_cast<int>( sm->get_items( point( x, y ) ).size() );
+                }
+            }
 
             jsout.start_object();
 
@@ -239,13 +445,28 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         }
 
         jsout.end_array();
-    } );
+    }
+    // Most quads of a long game are not visited between two saves; their files need not
+    // be written again.
+    std::string contents = fout.str();
+    save_stats::add_quad( om_addr, contents.size(), items );
+    const size_t hash = std::hash<std::string>()( contents );
+    const auto written = written_hashes.find( filename );
+    if( written != written_hashes.end() && written->second == hash &&
+        unwritten.count( filename ) == 0 ) {
+        save_stats::add_unchanged_file( save_part::submaps );
+        return;
+    }
+    save_stats::add_file( save_part::submaps, contents.size() );
+    written_hashes[filename] = hash;
+    unwritten[filename] = std::move( contents );
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
+    CATA_TRACE_ZONE( "mapbuffer::unserialize_submaps" );
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
     const std::string dirname = find_dirname( om_addr );
@@ -263,17 +484,39 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         }
     }
 
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
-        // If it doesn't exist, trigger generating it.
-        return nullptr;
+    std::string contents;
+    {
+        std::lock_guard<std::mutex> lock( quad_files_mutex );
+        const auto pending = unwritten.find( find_quad_path( dirname, om_addr ) );
+        const auto it = prefetched.find( quad_path );
+        if( pending != unwritten.end() ) {
+            // The writer may be busy with it, so it has to stay where it is.
+            contents = pending->second;
+        } else if( it != prefetched.end() ) {
+            contents = std::move( it->second );
+            prefetched.erase( it );
+        }
+    }
+    // Compressed files are rare enough to leave to read_from_file, which inflates them.
+    const bool compressed = contents.size() >= 2 && contents[0] == '\x1f' && contents[1] == '\x8b';
+    if( !contents.empty() && !compressed ) {
+        std::istringstream fin( contents );
+        JsonIn jsin( fin, quad_path );
+        deserialize( jsin );
+    } else {
+        using namespace std::placeholders;
+        if( !read_from_file_optional_json( quad_path,
+                                           std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
+            // If it doesn't exist, trigger generating it.
+            return nullptr;
+        }
     }
-    if( submaps.count( p ) == 0 ) {
+    submap *sm = find_submap( p );
+    if( sm == nullptr ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
                   quad_path, p.x, p.y, p.z );
-        return nullptr;
     }
-    return submaps[ p ].get();
+    return sm;
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
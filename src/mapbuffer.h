@@ -2,10 +2,16 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <array>
 #include <iosfwd>
 #include <list>
-#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "point.h"
 
@@ -14,6 +20,12 @@ class submap;
 
 /**
  * Store, buffer, save and load the entire world map.
+ *
+ * On disk, each overmap terrain's 2x2 quad of submaps is one JSON file,
+ * maps/<segment>/<x>.<y>.<z>.map, where a segment holds 32x32 quads. Quads that are
+ * entirely uniform are not saved at all, as regenerating them is faster than reading
+ * them. Each file is replaced whole through a temporary file and a rename, so a save
+ * that is cut short never leaves a quad half-written.
  */
 class mapbuffer
 {
@@ -22,12 +34,17 @@ class mapbuffer
         ~mapbuffer();
 
         /** Store all submaps in this instance into savefiles.
+         * The submaps are serialized right away, but the files are written by a
+         * background thread; @ref flush waits for that.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
          **/
         void save( bool delete_after_save = false );
 
-        /** Delete all buffered submaps. **/
+        /** Wait until the files of every earlier @ref save are written, and report failures. */
+        void flush();
+
+        /** Delete all buffered submaps, once every saved file is written. **/
         void clear();
 
         /** Add a new submap to the buffer.
@@ -54,8 +71,32 @@ class mapbuffer
          */
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Start reading the quad files at the given overmap terrain coordinates on a
+         * background thread, so that a later @ref lookup_submap of their submaps only has
+         * to parse them. Quads that are already loaded are skipped, and files read by an
+         * earlier call that are not asked for again are dropped.
+         * Only the file contents are read off the main thread; submaps are still
+         * deserialized by @ref lookup_submap.
+         */
+        void prefetch_quads( const std::vector<tripoint> &om_addrs );
+
+        /**
+         * Delete the loaded submaps of the quad at om_addr if every one of them is uniform.
+         * Such quads are never saved and are regenerated faster than they would be read,
+         * so they need not stay in memory once no map shows them. The caller must make
+         * sure that no map still points at them.
+         * @return Whether the quad was dropped.
+         */
+        bool drop_uniform_quad( const tripoint &om_addr );
+        /**
+         * Delete the loaded submap at p, if any, unsaved changes and all.  The caller must
+         * make sure that no map still points at it.
+         */
+        void drop_submap( const tripoint &p );
+
     private:
-        using submap_map_t = std::map<tripoint, std::unique_ptr<submap>>;
+        using submap_map_t = std::unordered_map<tripoint, std::unique_ptr<submap>>;
 
     public:
         inline submap_map_t::iterator begin() {
@@ -69,12 +110,52 @@ class mapbuffer
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
+        /** The stored submap at p, or nullptr. Never loads from disk. */
+        submap *find_submap( const tripoint &p ) const;
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
+                        std::set<std::string> &made_dirs, bool delete_after_save );
+        /** Wait for the thread started by @ref prefetch_quads, if any. */
+        void finish_prefetch();
+        /** Start a thread writing out everything in @ref unwritten. */
+        void start_writer();
         submap_map_t submaps; // NOLINT(cata-serialize)
+
+        std::thread prefetcher; // NOLINT(cata-serialize)
+        std::thread writer; // NOLINT(cata-serialize)
+        /** Guards @ref prefetched and @ref unwritten, which the threads work through. */
+        std::mutex quad_files_mutex; // NOLINT(cata-serialize)
+        /** Contents of quad files read ahead of time, by file path. */
+        std::unordered_map<std::string, std::string> prefetched; // NOLINT(cata-serialize)
+        /**
+         * Serialized quads waiting for the writer, by file path. They are newer than the
+         * files on disk, so loading reads them from here. Entries whose write failed stay
+         * until the next save tries again.
+         */
+        std::unordered_map<std::string, std::string> unwritten; // NOLINT(cata-serialize)
+        /** Why the writer failed to write a file, reported by @ref flush. */
+        std::string write_error; // NOLINT(cata-serialize)
+        /**
+         * Hashes of the quad files as last written, by file path. A quad that serializes
+         * to the same contents again is not written again. The writer drops the entries
+         * of files it failed to write.
+         */
+        std::unordered_map<std::string, size_t> written_hashes; // NOLINT(cata-serialize)
+
+        /**
+         * The last submaps found by @ref lookup_submap, direct-mapped by coordinates.
+         * The map and the overmap code look up the same few submaps over and over, and
+         * this spares them the hash lookup. Slots are dropped when their submap goes.
+         */
+        struct recent_submap {
+            tripoint p;
+            submap *sm = nullptr;
+        };
+        static constexpr size_t recent_submaps_size = 64;
+        std::array<recent_submap, recent_submaps_size> recent; // NOLINT(cata-serialize)
+        static size_t recent_slot( const tripoint &p );
 };
 
 extern mapbuffer MAPBUFFER;
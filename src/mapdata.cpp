@@ -1092,10 +1092,34 @@ void set_ter_ids()
     }
 }
 
+static transparency_tables transparency_lut;
+
+const transparency_tables &get_transparency_tables()
+{
+    return transparency_lut;
+}
+
+void finalize_transparency_tables()
+{
+    // generic_factory stores its entries in int_id order, so the position in
+    // get_all() is the index used by ter_id::to_i() / furn_id::to_i().
+    transparency_lut.ter.clear();
+    transparency_lut.ter.reserve( terrain_data.size() );
+    for( const ter_t &ter : terrain_data.get_all() ) {
+        transparency_lut.ter.push_back( ter.transparent ? 1 : 0 );
+    }
+    transparency_lut.furn.clear();
+    transparency_lut.furn.reserve( furniture_data.size() );
+    for( const furn_t &furn : furniture_data.get_all() ) {
+        transparency_lut.furn.push_back( furn.transparent ? 1 : 0 );
+    }
+}
+
 void reset_furn_ter()
 {
     terrain_data.reset();
     furniture_data.reset();
+    transparency_lut = transparency_tables();
 }
 
 furn_id f_null, f_clear,
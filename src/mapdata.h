@@ -5,6 +5,7 @@
 #include <array>
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <set>
 #include <string>
@@ -606,6 +607,22 @@ void set_ter_ids();
 void set_furn_ids();
 void reset_furn_ter();
 
+/**
+ * Flat copies of map_data_common_t::transparent, indexed by ter_id / furn_id.
+ * Lets hot loops such as map::build_transparency_cache skip the generic_factory
+ * lookup for every tile. Empty until finalize_transparency_tables() has run.
+ */
+struct transparency_tables {
+    std::vector<uint8_t> ter;
+    std::vector<uint8_t> furn;
+
+    bool empty() const {
+        return ter.empty() || furn.empty();
+    }
+};
+const transparency_tables &get_transparency_tables();
+void finalize_transparency_tables();
+
 /*
  * The terrain list contains the master list of  information and metadata for a given type of terrain.
  */
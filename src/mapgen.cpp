@@ -1159,6 +1159,9 @@ class mapgen_value
         struct param_source : value_source {
             std::string param_name;
             cata::optional<StringId> fallback;
+            // The argument value last looked up, and what it resolved to.
+            mutable std::string resolved_from;
+            mutable cata::optional<Id> resolved;
 
             explicit param_source( const JsonObject &jo )
                 : param_name( jo.get_string( "param" ) ) {
@@ -1166,11 +1169,21 @@ class mapgen_value
             }
 
             Id get( const mapgendata &dat ) const override {
-                if( fallback ) {
-                    return Id( dat.get_arg_or<StringId>( param_name, *fallback ) );
-                } else {
-                    return Id( dat.get_arg<StringId>( param_name ) );
+                const cata_variant *arg = dat.find_arg( param_name );
+                if( arg == nullptr ) {
+                    if( fallback ) {
+                        return Id( *fallback );
+                    }
+                    debugmsg( "No such parameter \"%s\"", param_name );
+                    return Id( StringId() );
+                }
+                // A palette entry is shared by every cell using its key, and the arguments
+                // stay the same for the whole mapgen, so this mostly sees the same value.
+                if( !resolved || arg->get_string() != resolved_from ) {
+                    resolved_from = arg->get_string();
+                    resolved = Id( mapgendata_detail::extract_variant_value<StringId>( *arg ) );
                 }
+                return *resolved;
             }
 
             void check( const std::string &context, const mapgen_parameters &parameters
@@ -1276,6 +1289,9 @@ class mapgen_value
             // mapgen_value, but that would make the code much more verbose.
             std::unique_ptr<mapgen_value<std::string>> on;
             std::unordered_map<std::string, StringId> cases;
+            // The case last looked up, and what it resolved to.
+            mutable std::string resolved_from;
+            mutable cata::optional<Id> resolved;
 
             explicit switch_source( const JsonObject &jo )
                 : on( std::make_unique<mapgen_value<std::string>>( jo.get_object( "switch" ) ) ) {
@@ -1284,12 +1300,17 @@ class mapgen_value
 
             Id get( const mapgendata &dat ) const override {
                 std::string based_on = on->get( dat );
+                if( resolved && based_on == resolved_from ) {
+                    return *resolved;
+                }
                 auto it = cases.find( based_on );
                 if( it == cases.end() ) {
                     debugmsg( "switch does not handle case %s", based_on );
                     return make_null_helper<Id> {}();
                 }
-                return Id( it->second );
+                resolved_from = std::move( based_on );
+                resolved = Id( it->second );
+                return *resolved;
             }
 
             void check( const std::string &context, const mapgen_parameters &params
@@ -1398,6 +1419,12 @@ class mapgen_value
             return is_null_;
         }
 
+        /** The id this value always takes, or nullptr if it depends on the mapgendata. */
+        const Id *constant() const {
+            const id_source *s = dynamic_cast<const id_source *>( source_.get() );
+            return s ? &s->id : nullptr;
+        }
+
         void check( const std::string &context, const mapgen_parameters &params ) const {
             source_->check( context, params );
         }
@@ -3801,6 +3828,48 @@ void jmapgen_objects::finalize()
     []( const jmapgen_obj & l, const jmapgen_obj & r ) {
         return l.second->phase() < r.second->phase();
     } );
+
+    // Placing a fixed id at a fixed point draws no random numbers, so those placements can
+    // skip their piece without changing what the rest of the mapgen rolls.
+    const auto fixed_point = []( const jmapgen_place & where, const jmapgen_piece & what ) {
+        return where.x.val == where.x.valmax && where.y.val == where.y.valmax &&
+               where.repeat.val == 1 && where.repeat.valmax == 1 &&
+               what.repeat.val == 1 && what.repeat.valmax == 1;
+    };
+    program.clear();
+    program.reserve( objects.size() );
+    for( size_t i = 0; i < objects.size(); ++i ) {
+        const jmapgen_place &where = objects[i].first;
+        const jmapgen_piece &what = *objects[i].second;
+        instruction ins;
+        ins.p = point( where.x.val, where.y.val );
+        ins.index = i;
+        const ter_id *ter = nullptr;
+        const furn_id *furn = nullptr;
+        if( const jmapgen_terrain *piece = dynamic_cast<const jmapgen_terrain *>( &what ) ) {
+            ter = piece->id.constant();
+        } else if( const jmapgen_furniture *piece = dynamic_cast<const jmapgen_furniture *>
+                   ( &what ) ) {
+            furn = piece->id.constant();
+        }
+        if( ter && fixed_point( where, what ) ) {
+            if( ter->id().is_null() ) {
+                continue;
+            }
+            ins.op = instruction::opcode::terrain;
+            ins.ter = *ter;
+        } else if( furn && fixed_point( where, what ) ) {
+            if( furn->id().is_null() ) {
+                continue;
+            }
+            ins.op = instruction::opcode::furniture;
+            ins.furn = *furn;
+        } else {
+            ins.op = typeid( what ) == typeid( jmapgen_vehicle ) ?
+                     instruction::opcode::vehicle : instruction::opcode::piece;
+        }
+        program.push_back( ins );
+    }
 }
 
 void jmapgen_objects::check( const std::string &context, const mapgen_parameters &parameters ) const
@@ -4078,40 +4147,48 @@ void mapgen_function_json_nested::nest( const mapgendata &md, const point &offse
  */
 void jmapgen_objects::apply( const mapgendata &dat ) const
 {
-    bool terrain_resolved = false;
-    for( const jmapgen_obj &obj : objects ) {
-        const jmapgen_place &where = obj.first;
-        const jmapgen_piece &what = *obj.second;
-        // The user will only specify repeat once in JSON, but it may get loaded both
-        // into the what and where in some cases--we just need the greater value of the two.
-        if( !terrain_resolved && typeid( what ) == typeid( jmapgen_vehicle ) ) {
-            // In order to determine collisions between vehicles and local "terrain" the terrain has to be resolved
-            // This code is based on two assumptions:
-            // 1. The terrain part of a definition is always placed first.
-            // 2. Only vehicles require the terrain to be resolved. The general solution is to use a virtual function.
-            resolve_regional_terrain_and_furniture( dat );
-            terrain_resolved = true;
-        }
-        const int repeat = std::max( where.repeat.get(), what.repeat.get() );
-        for( int i = 0; i < repeat; i++ ) {
-            what.apply( dat, where.x, where.y );
-        }
-    }
+    apply( dat, point_zero );
 }
 
 void jmapgen_objects::apply( const mapgendata &dat, const point &offset ) const
 {
-    if( offset == point_zero ) {
-        // It's a bit faster
-        apply( dat );
-        return;
-    }
-
-    for( const jmapgen_obj &obj : objects ) {
-        jmapgen_place where = obj.first;
+    // Chunks nested at an offset leave the regional terrain to their parent.
+    bool terrain_resolved = offset != point_zero;
+    for( const instruction &ins : program ) {
+        switch( ins.op ) {
+            case instruction::opcode::terrain: {
+                const point p = ins.p + offset;
+                dat.m.ter_set( p, ins.ter );
+                // Delete furniture if a wall was just placed over it, as jmapgen_terrain does.
+                if( ins.ter->has_flag( ter_furn_flag::TFLAG_WALL ) &&
+                    dat.m.has_flag_ter( ter_furn_flag::TFLAG_WALL, p ) ) {
+                    dat.m.furn_clear( p );
+                    if( !dat.m.has_flag_ter( ter_furn_flag::TFLAG_PLACE_ITEM, p ) ) {
+                        dat.m.i_clear( tripoint( p, dat.m.get_abs_sub().z ) );
+                    }
+                }
+                continue;
+            }
+            case instruction::opcode::furniture:
+                dat.m.furn_set( ins.p + offset, ins.furn );
+                continue;
+            case instruction::opcode::vehicle:
+                if( !terrain_resolved ) {
+                    // In order to determine collisions between vehicles and local "terrain"
+                    // the terrain has to be resolved.  This code is based on two assumptions:
+                    // 1. The terrain part of a definition is always placed first.
+                    // 2. Only vehicles require the terrain to be resolved. The general
+                    //    solution is to use a virtual function.
+                    resolve_regional_terrain_and_furniture( dat );
+                    terrain_resolved = true;
+                }
+                break;
+            case instruction::opcode::piece:
+                break;
+        }
+        jmapgen_place where = objects[ins.index].first;
         where.offset( -offset );
-
-        const jmapgen_piece &what = *obj.second;
+        const jmapgen_piece &what = *objects[ins.index].second;
         // The user will only specify repeat once in JSON, but it may get loaded both
         // into the what and where in some cases--we just need the greater value of the two.
         const int repeat = std::max( where.repeat.get(), what.repeat.get() );
@@ -7147,6 +7224,17 @@ bool update_mapgen_function_json::update_map( const tripoint_abs_omt &omt_pos, c
     bool const u = update_map( md, offset, verify );
     update_tmap.mirror( mirror_horizontal, mirror_vertical );
     update_tmap.rotate( rotation );
+    if( u ) {
+        // The update went through the tinymap, so the main map did not see its terrain and
+        // furniture change. Its scent blockers are kept per submap, for the submaps of this OMT.
+        map &here = get_map();
+        const tripoint omt_corner = here.getlocal( project_to<coords::ms>( omt_pos ).raw() );
+        for( const point &sm_offset : {
+                 point_zero, point( SEEX, 0 ), point( 0, SEEY ), point( SEEX, SEEY )
+             } ) {
+            here.set_scent_cache_dirty( omt_corner + sm_offset );
+        }
+    }
     return u;
 }
 
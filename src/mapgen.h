@@ -388,6 +388,25 @@ struct jmapgen_objects {
          */
         using jmapgen_obj = std::pair<jmapgen_place, shared_ptr_fast<const jmapgen_piece> >;
         std::vector<jmapgen_obj> objects;
+        /**
+         * What @ref apply runs, built from @ref objects by @ref finalize. Terrain and furniture
+         * with a fixed id at a fixed point (most cells of "rows") are set directly from their
+         * resolved id; everything else applies its object.
+         */
+        struct instruction {
+            enum class opcode : char {
+                terrain,
+                furniture,
+                vehicle,
+                piece,
+            };
+            opcode op;
+            point p;
+            ter_id ter;
+            furn_id furn;
+            size_t index;
+        };
+        std::vector<instruction> program;
         point m_offset;
         point mapgensize;
         point total_size;
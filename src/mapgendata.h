@@ -184,6 +184,12 @@ class mapgendata
         const oter_id &last_predecessor() const;
         void pop_last_predecessor();
 
+        /** The argument called name, or nullptr if there is none. */
+        const cata_variant *find_arg( const std::string &name ) const {
+            auto it = mapgen_args_.map.find( name );
+            return it == mapgen_args_.map.end() ? nullptr : &it->second;
+        }
+
         template<typename Result>
         Result get_arg( const std::string &name ) const {
             auto it = mapgen_args_.map.find( name );
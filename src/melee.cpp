@@ -1060,6 +1060,13 @@ float Character::get_dodge() const
         return 0.0f;
     }
 
+    // Ensure no attempt to dodge without sources of extra dodges, eg martial arts.
+    // Checked before the rest, as a swarm uses up the dodges within the first few attacks
+    // of a turn and every attack after that asks again.
+    if( dodges_left <= 0 ) {
+        return 0.0f;
+    }
+
     float ret = Creature::get_dodge();
     // Chop in half if we are unable to move
     if( has_effect( effect_beartrap ) || has_effect( effect_lightsnare ) ||
@@ -1081,9 +1088,11 @@ float Character::get_dodge() const
         }
     }
 
-    if( worn_with_flag( flag_ROLLER_INLINE ) ||
-        worn_with_flag( flag_ROLLER_QUAD ) ||
-        worn_with_flag( flag_ROLLER_ONE ) ) {
+    const bool skating = std::any_of( worn.begin(), worn.end(), []( const item & it ) {
+        return it.has_flag( flag_ROLLER_INLINE ) || it.has_flag( flag_ROLLER_QUAD ) ||
+               it.has_flag( flag_ROLLER_ONE );
+    } );
+    if( skating ) {
         ret /= has_trait( trait_PROF_SKATER ) ? 2 : 5;
     }
 
@@ -1091,11 +1100,6 @@ float Character::get_dodge() const
         ret /= 4;
     }
 
-    // Ensure no attempt to dodge without sources of extra dodges, eg martial arts
-    if( dodges_left <= 0 ) {
-        return 0.0f;
-    }
-
     // Speed below 100 linearly decreases dodge effectiveness
     int speed_stat = get_speed();
     if( speed_stat < 100 ) {
@@ -3,6 +3,7 @@
 #define CATA_SRC_MEMORY_FAST_H
 
 #include <memory>
+#include <utility>
 
 #if __GLIBCXX__
 template<typename T> using shared_ptr_fast = std::__shared_ptr<T, __gnu_cxx::_S_single>;
@@ -10,7 +11,7 @@ template<typename T> using weak_ptr_fast = std::__weak_ptr<T, __gnu_cxx::_S_sing
 template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
     Args &&... args )
 {
-    return std::__make_shared<T, __gnu_cxx::_S_single>( args... );
+    return std::__make_shared<T, __gnu_cxx::_S_single>( std::forward<Args>( args )... );
 }
 #else
 template<typename T> using shared_ptr_fast = std::shared_ptr<T>;
@@ -18,7 +19,7 @@ template<typename T> using weak_ptr_fast = std::weak_ptr<T>;
 template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
     Args &&... args )
 {
-    return std::make_shared<T>( args... );
+    return std::make_shared<T>( std::forward<Args>( args )... );
 }
 #endif
 
@@ -0,0 +1,245 @@
+#include "memory_stats.h"
+
+#include <iterator>
+#include <set>
+#include <sstream>
+
+#include "avatar.h"
+#include "cata_utility.h"
+#include "character.h"
+#include "colony.h"
+#include "creature_tracker.h"
+#include "debug.h"
+#include "enum_conversions.h"
+#include "game.h"
+#include "item.h"
+#include "json.h"
+#include "mapbuffer.h"
+#include "memory_fast.h"
+#include "monster.h"
+#include "npc.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "vehicle.h"
+
+#if defined(TILES)
+#include "cata_tiles.h"
+#include "sdltiles.h"
+#endif
+
+#if defined(LOCALIZE)
+#include "translation_manager.h"
+#endif
+
+namespace io
+{
+
+template<>
+std::string enum_to_string<memory_part>( memory_part data )
+{
+    switch( data ) {
+        // *INDENT-OFF*
+        case memory_part::submaps: return "submaps";
+        case memory_part::items: return "items";
+        case memory_part::map_memory: return "map_memory";
+        case memory_part::overmaps: return "overmaps";
+        case memory_part::creatures: return "creatures";
+        case memory_part::vehicles: return "vehicles";
+        case memory_part::tileset_textures: return "tileset_textures";
+        case memory_part::translations: return "translations";
+        // *INDENT-ON*
+        case memory_part::last:
+            break;
+    }
+    cata_fatal( "Invalid memory_part" );
+}
+
+} // namespace io
+
+namespace
+{
+
+constexpr int num_parts = static_cast<int>( memory_part::last );
+
+// The item and everything inside of it.
+void add_item( memory_usage &usage, const item &it )
+{
+    it.visit_items( [&usage]( const item *, const item * ) {
+        ++usage.count;
+        usage.bytes += sizeof( item );
+        return VisitResponse::NEXT;
+    } );
+}
+
+void add_items( memory_usage &usage, const cata::colony<item> &items )
+{
+    for( const item &it : items ) {
+        add_item( usage, it );
+    }
+    // The outer items are held in the blocks of the colony, which have room to spare.
+    usage.bytes += items.approximate_memory_use() - items.size() * sizeof( item );
+}
+
+memory_usage measure_items()
+{
+    memory_usage usage;
+    for( auto &entry : MAPBUFFER ) {
+        const submap &sm = *entry.second;
+        for( int x = 0; x < SEEX; ++x ) {
+            for( int y = 0; y < SEEY; ++y ) {
+                add_items( usage, sm.get_items( point( x, y ) ) );
+            }
+        }
+        for( const std::unique_ptr<vehicle> &veh : sm.vehicles ) {
+            for( int p = 0; p < veh->part_count(); ++p ) {
+                for( const item &it : veh->get_items( p ) ) {
+                    add_item( usage, it );
+                }
+            }
+        }
+    }
+    const auto add_character = [&usage]( const Character &who ) {
+        who.visit_items( [&usage]( const item *, const item * ) {
+            ++usage.count;
+            usage.bytes += sizeof( item );
+            return VisitResponse::NEXT;
+        } );
+    };
+    add_character( get_avatar() );
+    for( const npc &guy : g->all_npcs() ) {
+        add_character( guy );
+    }
+    for( const shared_ptr_fast<monster> &mon : get_creature_tracker().get_monsters_list() ) {
+        for( const item &it : mon->inv ) {
+            add_item( usage, it );
+        }
+    }
+    return usage;
+}
+
+memory_usage measure_tileset_textures()
+{
+    memory_usage usage;
+#if defined(TILES)
+    // The overmap tiles may share the tileset of the map.
+    std::set<const tileset *> tilesets;
+    for( const std::unique_ptr<cata_tiles> *context : {
+             &tilecontext, &overmap_tilecontext
+         } ) {
+        if( *context && ( *context )->get_tileset() ) {
+            tilesets.insert( ( *context )->get_tileset() );
+        }
+    }
+    for( const tileset *ts : tilesets ) {
+        usage += ts->memory_use();
+    }
+#endif
+    return usage;
+}
+
+} // namespace
+
+namespace memory_stats
+{
+
+memory_usage measure( const memory_part part )
+{
+    memory_usage usage;
+    switch( part ) {
+        case memory_part::submaps:
+            usage.count = std::distance( MAPBUFFER.begin(), MAPBUFFER.end() );
+            usage.bytes = usage.count * sizeof( submap );
+            break;
+        case memory_part::items:
+            usage = measure_items();
+            break;
+        case memory_part::map_memory:
+            usage = get_avatar().map_memory_use();
+            break;
+        case memory_part::overmaps:
+            usage = overmap_buffer.memory_use();
+            break;
+        case memory_part::creatures: {
+            const size_t monsters = get_creature_tracker().get_monsters_list().size();
+            size_t npcs = 0;
+            for( const npc &guy : g->all_npcs() ) {
+                static_cast<void>( guy );
+                ++npcs;
+            }
+            usage.count = 1 + monsters + npcs;
+            usage.bytes = sizeof( avatar ) + monsters * sizeof( monster ) + npcs * sizeof( npc );
+            break;
+        }
+        case memory_part::vehicles:
+            for( auto &entry : MAPBUFFER ) {
+                for( const std::unique_ptr<vehicle> &veh : entry.second->vehicles ) {
+                    ++usage.count;
+                    usage.bytes += sizeof( vehicle ) + veh->part_count() * sizeof( vehicle_part );
+                }
+            }
+            break;
+        case memory_part::tileset_textures:
+            usage = measure_tileset_textures();
+            break;
+        case memory_part::translations:
+#if defined(LOCALIZE)
+            usage.count = TranslationManager::GetInstance().CountStrings();
+            usage.bytes = TranslationManager::GetInstance().MemoryUsage();
+#endif
+            break;
+        case memory_part::last:
+            break;
+    }
+    return usage;
+}
+
+std::string summary_table()
+{
+    std::ostringstream out;
+    out << string_format( "%-18s %10s %10s\n", "part", "count", "MB" );
+    memory_usage sum;
+    for( int i = 0; i < num_parts; ++i ) {
+        const memory_part part = static_cast<memory_part>( i );
+        const memory_usage usage = measure( part );
+        out << string_format( "%-18s %10d %10.1f\n", io::enum_to_string( part ), usage.count,
+                              usage.bytes / ( 1024.0 * 1024.0 ) );
+        sum += usage;
+    }
+    out << string_format( "%-18s %10s %10.1f\n", "total", "", sum.bytes / ( 1024.0 * 1024.0 ) );
+    return out.str();
+}
+
+void serialize( JsonOut &jsout )
+{
+    jsout.start_object();
+    jsout.member( "parts" );
+    jsout.start_array();
+    for( int i = 0; i < num_parts; ++i ) {
+        const memory_part part = static_cast<memory_part>( i );
+        const memory_usage usage = measure( part );
+        jsout.start_object();
+        jsout.member( "part", io::enum_to_string( part ) );
+        jsout.member( "count", usage.count );
+        jsout.member( "bytes", usage.bytes );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+bool write_report()
+{
+    return write_to_file( report_path(), []( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        serialize( jsout );
+    }, "memory report" );
+}
+
+std::string report_path()
+{
+    return PATH_INFO::config_dir() + "memory_stats.json";
+}
+
+} // namespace memory_stats
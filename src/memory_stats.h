@@ -0,0 +1,64 @@
+#pragma once
+#ifndef CATA_SRC_MEMORY_STATS_H
+#define CATA_SRC_MEMORY_STATS_H
+
+#include <cstddef>
+#include <string>
+
+#include "enum_traits.h"
+
+class JsonOut;
+
+// How much memory the big parts of the game hold, so that it can be seen what grows over a
+// long session.
+//
+// Nothing is counted as it is allocated: every report walks what the game holds at that
+// moment. The bytes are estimates, from the size of the objects and of the buffers they are
+// known to own, not what the allocator handed out. Items are counted on their own, so the
+// submaps, vehicles and creatures holding them do not count them again.
+
+enum class memory_part : int {
+    submaps,
+    items,
+    map_memory,
+    overmaps,
+    creatures,
+    vehicles,
+    tileset_textures,
+    translations,
+    last
+};
+
+template<>
+struct enum_traits<memory_part> {
+    static constexpr memory_part last = memory_part::last;
+};
+
+struct memory_usage {
+    size_t count = 0;
+    size_t bytes = 0;
+
+    memory_usage &operator+=( const memory_usage &rhs ) {
+        count += rhs.count;
+        bytes += rhs.bytes;
+        return *this;
+    }
+};
+
+namespace memory_stats
+{
+
+/** Walks what the game holds of @p part. */
+memory_usage measure( memory_part part );
+
+/** Human readable table of @ref measure for every part. */
+std::string summary_table();
+
+void serialize( JsonOut &jsout );
+/** Writes @ref serialize to @ref report_path. */
+bool write_report();
+std::string report_path();
+
+} // namespace memory_stats
+
+#endif // CATA_SRC_MEMORY_STATS_H
@@ -1805,7 +1805,7 @@ std::vector<npc_ptr> talk_function::companion_list( const npc &p, const std::str
     std::vector<npc_ptr> available;
     const tripoint_abs_omt omt_pos = p.global_omt_location();
     for( const auto &elem : overmap_buffer.get_companion_mission_npcs() ) {
-        npc_companion_mission c_mission = elem->get_companion_mission();
+        const npc_companion_mission &c_mission = elem->get_companion_mission();
         if( c_mission.position == omt_pos && c_mission.mission_id == mission_id &&
             c_mission.role_id == p.companion_mission_role_id ) { // NOLINT(bugprone-branch-clone)
             available.push_back( elem );
@@ -1931,7 +1931,6 @@ npc_ptr talk_function::companion_choose( const std::map<skill_id, int> &required
         if( !guy ) {
             continue;
         }
-        npc_companion_mission c_mission = guy->get_companion_mission();
         // get non-assigned visible followers
         if( player_character.posz() == guy->posz() && !guy->has_companion_mission() &&
             !guy->is_travelling() &&
@@ -2044,7 +2043,7 @@ npc_ptr talk_function::companion_choose_return( const tripoint_abs_omt &omt_pos,
     std::vector<npc_ptr> available;
     Character &player_character = get_player_character();
     for( npc_ptr &guy : overmap_buffer.get_companion_mission_npcs() ) {
-        npc_companion_mission c_mission = guy->get_companion_mission();
+        const npc_companion_mission &c_mission = guy->get_companion_mission();
         if( c_mission.position != omt_pos ||
             ( by_mission && c_mission.mission_id != mission_id ) || c_mission.role_id != role_id ) {
             continue;
@@ -15,6 +15,10 @@
 // for legacy reasons "monfaction::id" is called "name" in json
 static generic_factory<monfaction> faction_factory( "MONSTER_FACTION", "name" );
 
+// attitude_vec of every faction one after another, row `from`, column `to`
+static std::vector<uint8_t> attitude_matrix;
+static size_t attitude_matrix_size = 0;
+
 /** @relates int_id */
 template<>
 const monfaction &int_id<monfaction>::obj() const
@@ -86,6 +90,19 @@ cata::optional<mf_attitude> monfaction::attitude_rec( const mfaction_str_id &oth
 void monfactions::reset()
 {
     faction_factory.reset();
+    attitude_matrix.clear();
+    attitude_matrix_size = 0;
+}
+
+mf_attitude monfactions::attitude( const mfaction_id &from, const mfaction_id &to )
+{
+    const size_t row = static_cast<size_t>( from.to_i() );
+    const size_t col = static_cast<size_t>( to.to_i() );
+    if( row >= attitude_matrix_size || col >= attitude_matrix_size ) {
+        debugmsg( "Invalid mfaction_id in the attitude check: %d -> %d", from.to_i(), to.to_i() );
+        return MFA_FRIENDLY;
+    }
+    return static_cast<mf_attitude>( attitude_matrix[row * attitude_matrix_size + col] );
 }
 
 void monfactions::load_monster_faction( const JsonObject &jo, const std::string &src )
@@ -180,6 +197,13 @@ void monfactions::finalize()
     for( const auto &f : faction_factory.get_all() ) {
         f.populate_attitude_vec();
     }
+
+    attitude_matrix_size = faction_factory.get_all().size();
+    attitude_matrix.clear();
+    attitude_matrix.reserve( attitude_matrix_size * attitude_matrix_size );
+    for( const auto &f : faction_factory.get_all() ) {
+        attitude_matrix.insert( attitude_matrix.end(), f.attitude_vec.begin(), f.attitude_vec.end() );
+    }
 }
 
 void monfaction::load( const JsonObject &jo, const std::string & )
@@ -43,6 +43,12 @@ const std::vector<monfaction> &get_all();
 void reset();
 void finalize();
 void load_monster_faction( const JsonObject &jo, const std::string &src );
+/**
+ * Attitude of faction @p from towards faction @p to, the same as `from->attitude( to )`.
+ * Answered from one dense table of all faction pairs built by @ref finalize, without going
+ * through the faction factory, for the targeting loops that ask many times per turn.
+ */
+mf_attitude attitude( const mfaction_id &from, const mfaction_id &to );
 } // namespace monfactions
 
 class monfaction
@@ -69,6 +69,8 @@ static const itype_id itype_pressurized_tank( "pressurized_tank" );
 
 static const material_id material_iflesh( "iflesh" );
 
+static const mfaction_str_id monfaction_player( "player" );
+
 static const species_id species_FUNGUS( "FUNGUS" );
 static const species_id species_ZOMBIE( "ZOMBIE" );
 
@@ -387,15 +389,28 @@ void monster::plan()
         return;
     }
 
-    int valid_targets = ( target == nullptr ) ? 0 : 1;
+    // Range within which rate_target can still pick a target; lines of sight to candidates within
+    // it are walked in one batch, so that the sees() calls in rate_target are answered from memory.
+    const int prefetch_range = smart_planning ? MAX_VIEW_DISTANCE : static_cast<int>( dist );
+    std::vector<npc *> hostile_npcs;
+    std::vector<tripoint> candidate_positions;
     for( npc &who : g->all_npcs() ) {
-        mf_attitude faction_att = faction.obj().attitude( who.get_monster_faction() );
+        mf_attitude faction_att = monfactions::attitude( faction, who.get_monster_faction() );
         if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
             continue;
         }
         if( !seen_levels.test( who.pos().z + OVERMAP_DEPTH ) ) {
             continue;
         }
+        hostile_npcs.push_back( &who );
+        candidate_positions.push_back( who.pos() );
+    }
+    here.sees_many( pos(), candidate_positions, prefetch_range );
+
+    int valid_targets = ( target == nullptr ) ? 0 : 1;
+    for( npc *who_ptr : hostile_npcs ) {
+        npc &who = *who_ptr;
+        mf_attitude faction_att = monfactions::attitude( faction, who.get_monster_faction() );
 
         float rating = rate_target( who, dist, smart_planning );
         bool fleeing_from = is_fleeing( who );
@@ -455,48 +470,77 @@ void monster::plan()
                                  turns_since_target );
     int turns_to_skip = max_turns_to_skip * rate_limiting_factor;
     if( friendly == 0 && ( turns_to_skip == 0 || turns_since_target % turns_to_skip == 0 ) ) {
-        for( const auto &fac_list : factions ) {
-            mf_attitude faction_att = faction.obj().attitude( fac_list.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
-            }
-
-            for( const auto &fac : fac_list.second ) {
-                if( !seen_levels.test( fac.first + OVERMAP_DEPTH ) ) {
+        std::vector<shared_ptr_fast<monster>> hostile_monsters;
+        candidate_positions.clear();
+        if( smart_planning ) {
+            // A strong enough target is worth going after from anywhere.
+            for( const auto &fac_list : factions ) {
+                mf_attitude faction_att = monfactions::attitude( faction, fac_list.first );
+                if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
                     continue;
                 }
-                for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                    const shared_ptr_fast<monster> shared = weak.lock();
-                    if( !shared ) {
+
+                for( const auto &fac : fac_list.second ) {
+                    if( !seen_levels.test( fac.first + OVERMAP_DEPTH ) ) {
                         continue;
                     }
-                    monster &mon = *shared;
-                    float rating = rate_target( mon, dist, smart_planning );
-                    if( rating == dist ) {
-                        ++valid_targets;
-                        if( one_in( valid_targets ) ) {
-                            target = &mon;
-                        }
-                    }
-                    if( rating < dist ) {
-                        target = &mon;
-                        dist = rating;
-                        valid_targets = 1;
-                    }
-                    if( rating <= 5 ) {
-                        if( anger <= 30 ) {
-                            anger += angers_hostile_near;
+                    for( const weak_ptr_fast<monster> &weak : fac.second ) {
+                        shared_ptr_fast<monster> shared = weak.lock();
+                        if( !shared ) {
+                            continue;
                         }
-                        morale -= fears_hostile_near;
-                    }
-                    if( !fleeing && anger <= 20 && valid_targets != 0 ) {
-                        anger += angers_hostile_seen;
-                    }
-                    if( !fleeing && valid_targets != 0 ) {
-                        morale -= fears_hostile_seen;
+                        candidate_positions.push_back( shared->pos() );
+                        hostile_monsters.push_back( std::move( shared ) );
                     }
                 }
             }
+        } else {
+            // rate_target never picks anything out of sight.  Hostiles in sight that are
+            // further away than the best target still make the monster angrier and more
+            // afraid below, so the box is as large as the sight range, not the best distance.
+            g->critter_tracker->for_each_in_radius( get_location(), max_sight_range, OVERMAP_LAYERS,
+            [&]( Creature & who ) {
+                monster *const mon = who.as_monster();
+                if( mon == nullptr || !seen_levels.test( mon->posz() + OVERMAP_DEPTH ) ) {
+                    return;
+                }
+                const mf_attitude faction_att = monfactions::attitude( faction, mon->friendly == 0 ?
+                                                mon->faction : mfaction_id( monfaction_player ) );
+                if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
+                    return;
+                }
+                candidate_positions.push_back( mon->pos() );
+                hostile_monsters.push_back( g->shared_from( *mon ) );
+            }, true );
+        }
+        here.sees_many( pos(), candidate_positions, prefetch_range );
+
+        for( const shared_ptr_fast<monster> &shared : hostile_monsters ) {
+            monster &mon = *shared;
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
+                    target = &mon;
+                }
+            }
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                if( anger <= 30 ) {
+                    anger += angers_hostile_near;
+                }
+                morale -= fears_hostile_near;
+            }
+            if( !fleeing && anger <= 20 && valid_targets != 0 ) {
+                anger += angers_hostile_seen;
+            }
+            if( !fleeing && valid_targets != 0 ) {
+                morale -= fears_hostile_seen;
+            }
         }
     }
     if( target == nullptr ) {
@@ -883,11 +927,15 @@ void monster::move()
                 path.erase( path.begin() );
             }
 
-            const auto &pf_settings = get_pathfinding_settings();
-            if( pf_settings.max_dist >= rl_dist( get_location(), get_dest() ) &&
-                ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != local_dest ) ) {
-                // We need a new path
-                path = here.route( pos(), local_dest, pf_settings, get_path_avoid() );
+            if( needs_new_path() ) {
+                // Usually the target moved a little, or something got in the way
+                const pathfinding_settings &pf_settings = get_pathfinding_settings();
+                const std::set<tripoint> avoid = get_path_avoid();
+                path = here.repair_route( pos(), path, local_dest, pf_settings, avoid );
+                if( path.empty() ) {
+                    // We need a new path, likely to the same place as others of a horde
+                    path = here.route_shared( pos(), local_dest, pf_settings, avoid );
+                }
             }
 
             // Try to respect old paths, even if we can't pathfind at the moment
@@ -1119,6 +1119,34 @@ bool monster::is_wandering() const
     return !has_dest() && patrol_route.empty();
 }
 
+bool monster::is_idle() const
+{
+    return friendly == 0 && turns_since_target > 0 && is_wandering() && wandf <= 0 && !disturbed;
+}
+
+bool monster::skip_idle_turn( const int period )
+{
+    if( period > 1 && is_idle() && ++idle_turns < period ) {
+        return true;
+    }
+    idle_turns = 0;
+    disturbed = false;
+    return false;
+}
+
+bool monster::needs_new_path() const
+{
+    if( is_wandering() || get_pathfinding_settings().max_dist < rl_dist( get_location(), get_dest() ) ) {
+        return false;
+    }
+    const tripoint here = pos();
+    const auto next = std::find_if( path.begin(), path.end(), [&here]( const tripoint & p ) {
+        return p != here;
+    } );
+    return next == path.end() || rl_dist( here, *next ) >= 2 ||
+           path.back() != get_map().getlocal( get_dest() );
+}
+
 void monster::wander_to( const tripoint_abs_ms &p, int f )
 {
     wander_pos = p;
@@ -1161,7 +1189,7 @@ Creature::Attitude monster::attitude_to( const Creature &other ) const
             return Attitude::FRIENDLY;
         }
 
-        mf_attitude faction_att = faction.obj().attitude( m->faction );
+        mf_attitude faction_att = monfactions::attitude( faction, m->faction );
         if( ( friendly != 0 && m->friendly != 0 ) ||
             ( friendly == 0 && m->friendly == 0 && faction_att == MFA_FRIENDLY ) ) {
             // Friendly (to player) monsters are friendly to each other
@@ -1628,9 +1656,9 @@ bool monster::melee_attack( Creature &target, float accuracy )
 
     const int total_dealt = dealt_dam.total_damage();
     if( hitspread < 0 ) {
-        bool target_dodging = target.dodge_roll() > 0.0;
         // Miss
         if( u_see_my_spot && !target.in_sleep_state() ) {
+            const bool target_dodging = target.dodge_roll() > 0.0;
             if( target.is_avatar() ) {
                 if( target_dodging ) {
                     add_msg( _( "You dodge %s." ), u_see_me ? disp_name() : "something" );
@@ -1866,6 +1894,9 @@ void monster::apply_damage( Creature *source, bodypart_id /*bp*/, int dam,
         return;
     }
     hp -= dam;
+    if( dam > 0 ) {
+        disturbed = true;
+    }
     if( hp < 1 ) {
         set_killer( source );
     } else if( dam > 0 ) {
@@ -3129,6 +3160,7 @@ void monster::hear_sound( const tripoint &source, const int vol, const int dist,
     if( volume <= 0 ) {
         return;
     }
+    disturbed = true;
 
     int tmp_provocative = provocative || volume >= normal_roll( 30, 5 );
     // already following a more interesting sound
@@ -216,6 +216,19 @@ class monster : public Creature
 
         // Returns true if the monster has no plans.
         bool is_wandering() const;
+        // Returns true if move() would look for a new path to our destination.
+        bool needs_new_path() const;
+        /**
+         * Returns true if the monster has nothing to react to: it had no target when it last
+         * planned, has nowhere to go, no sound to follow and was not hurt since it last moved.
+         */
+        bool is_idle() const;
+        /**
+         * Called once per turn by monmove. With @p period above 1, returns true on all but one
+         * in @p period turns, which the monster then sits out, saving its moves for the turn it
+         * acts. Always returns false once @ref is_idle stops being true.
+         */
+        bool skip_idle_turn( int period );
         /**
          * Set p as wander destination.
          *
@@ -592,6 +605,10 @@ class monster : public Creature
         std::bitset<NUM_MEFF> effect_cache;
         cata::optional<time_duration> summon_time_limit = cata::nullopt;
         int turns_since_target = 0;
+        /** Set by anything an idle monster must react to, cleared when it acts. */
+        bool disturbed = false;
+        /** Turns sat out in a row by @ref skip_idle_turn. */
+        int idle_turns = 0;
 
         Character *find_dragged_foe();
         void nursebot_operate( Character *dragged_foe );
@@ -244,6 +244,8 @@ void player_morale::mutation_data::clear()
 
 player_morale::player_morale() :
     level( 0 ),
+    total_positive( 0 ),
+    total_negative( 0 ),
     level_is_valid( false ),
     took_prozac( false ),
     took_prozac_bad( false ),
@@ -404,15 +406,8 @@ void player_morale::calculate_percentage()
 
 int player_morale::get_total_negative_value() const
 {
-    const morale_mult mult = get_temper_mult();
-    int sum = 0;
-    for( const morale_point &m : points ) {
-        const int bonus = m.get_net_bonus( mult );
-        if( bonus < 0 ) {
-            sum += std::pow( bonus, 2 );
-        }
-    }
-    return std::sqrt( sum );
+    update_level();
+    return total_negative;
 }
 
 int player_morale::get_perceived_pain() const
@@ -422,60 +417,64 @@ int player_morale::get_perceived_pain() const
 
 int player_morale::get_total_positive_value() const
 {
+    update_level();
+    return total_positive;
+}
+
+void player_morale::update_level() const
+{
+    if( level_is_valid ) {
+        return;
+    }
     const morale_mult mult = get_temper_mult();
-    int sum = 0;
+
+    int sum_of_positive_squares = 0;
+    int sum_of_negative_squares = 0;
+
     for( const morale_point &m : points ) {
         const int bonus = m.get_net_bonus( mult );
         if( bonus > 0 ) {
-            sum += std::pow( bonus, 2 );
+            sum_of_positive_squares += std::pow( bonus, 2 );
+        } else {
+            sum_of_negative_squares += std::pow( bonus, 2 );
         }
-
     }
-    return std::sqrt( sum );
-}
 
-int player_morale::get_level() const
-{
-    if( !level_is_valid ) {
-        const morale_mult mult = get_temper_mult();
-
-        int sum_of_positive_squares = 0;
-        int sum_of_negative_squares = 0;
-
-        for( const morale_point &m : points ) {
-            const int bonus = m.get_net_bonus( mult );
-            if( bonus > 0 ) {
-                sum_of_positive_squares += std::pow( bonus, 2 );
-            } else {
-                sum_of_negative_squares += std::pow( bonus, 2 );
-            }
-        }
-
-        level = std::sqrt( sum_of_positive_squares ) - std::sqrt( sum_of_negative_squares );
+    total_positive = std::sqrt( sum_of_positive_squares );
+    total_negative = std::sqrt( sum_of_negative_squares );
+    level = std::sqrt( sum_of_positive_squares ) - std::sqrt( sum_of_negative_squares );
 
-        if( took_prozac ) {
-            level *= morale_mults::prozac;
-            if( took_prozac_bad ) {
-                level *= morale_mults::prozac_bad;
-            }
+    if( took_prozac ) {
+        level *= morale_mults::prozac;
+        if( took_prozac_bad ) {
+            level *= morale_mults::prozac_bad;
         }
-
-        level_is_valid = true;
     }
 
+    level_is_valid = true;
+}
+
+int player_morale::get_level() const
+{
+    update_level();
     return level;
 }
 
 void player_morale::decay( const time_duration &ticks )
 {
-    const auto do_decay = [ &ticks ]( morale_point & m ) {
+    // Permanent points and those that have not started to decay keep their bonus, so the
+    // level only has to be worked out again if one of the others changed.
+    bool changed = false;
+    for( morale_point &m : points ) {
+        const int prev_bonus = m.get_net_bonus();
         m.decay( ticks );
-    };
-
-    std::for_each( points.begin(), points.end(), do_decay );
+        changed = changed || m.get_net_bonus() != prev_bonus;
+    }
     remove_expired();
     update_bodytemp_penalty( ticks );
-    invalidate();
+    if( changed ) {
+        invalidate();
+    }
 }
 
 void player_morale::display( int focus_eq, int pain_penalty, int fatigue_penalty )
@@ -150,6 +150,8 @@ class player_morale
         void remove_if( const std::function<bool( const morale_point & )> &func );
         void remove_expired();
         void invalidate();
+        /** Works out the level and the totals, unless they are still valid */
+        void update_level() const;
 
         void update_stylish_bonus();
         void update_squeamish_penalty();
@@ -201,6 +203,10 @@ class player_morale
 
         // Mutability is required for lazy initialization
         mutable int level;
+        // The totals of @ref get_total_positive_value and @ref get_total_negative_value,
+        // worked out along with the level.
+        mutable int total_positive;
+        mutable int total_negative;
         mutable bool level_is_valid;
 
         bool took_prozac;
@@ -117,7 +117,22 @@ std::string enum_to_string<mutagen_technique>( mutagen_technique data )
 
 bool Character::has_trait( const trait_id &b ) const
 {
-    return my_mutations.count( b ) || enchantment_cache->get_mutations().count( b );
+    const int index = mutation_branch::index_of( b );
+    const bool own = index >= 0 && index < static_cast<int>( mutation_bits.size() ) &&
+                     mutation_bits[index];
+    return own || enchantment_cache->get_mutations().count( b );
+}
+
+void Character::set_mutation_bit( const trait_id &trait, const bool value )
+{
+    const int index = mutation_branch::index_of( trait );
+    if( index < 0 ) {
+        return;
+    }
+    if( index >= static_cast<int>( mutation_bits.size() ) ) {
+        mutation_bits.resize( mutation_branch::get_all().size(), false );
+    }
+    mutation_bits[index] = value;
 }
 
 bool Character::has_trait_flag( const json_character_flag &b ) const
@@ -180,6 +195,7 @@ void Character::set_mutation_unsafe( const trait_id &trait )
     }
     my_mutations.emplace( trait, trait_data{} );
     cached_mutations.push_back( &trait.obj() );
+    set_mutation_bit( trait, true );
     mutation_effect( trait, false );
 
     if( is_avatar() ) {
@@ -225,6 +241,7 @@ void Character::unset_mutation( const trait_id &trait_ )
     const mutation_branch &mut = *trait;
     cached_mutations.erase( std::remove( cached_mutations.begin(), cached_mutations.end(), &mut ),
                             cached_mutations.end() );
+    set_mutation_bit( trait, false );
     my_mutations.erase( iter );
     mutation_loss_effect( trait );
     recalc_sight_limits();
@@ -364,6 +364,8 @@ struct mutation_branch {
          * also get by calling @ref get.
          */
         static const std::vector<mutation_branch> &get_all();
+        /** Position of @p mutation_id in @ref get_all, or -1 if there is no such mutation. */
+        static int index_of( const trait_id &mutation_id );
         // For init.cpp: reset (clear) the mutation data
         static void reset_all();
         // For init.cpp: load mutation data from json
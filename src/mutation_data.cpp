@@ -687,6 +687,11 @@ const std::vector<mutation_branch> &mutation_branch::get_all()
     return trait_factory.get_all();
 }
 
+int mutation_branch::index_of( const trait_id &mutation_id )
+{
+    return trait_factory.convert( mutation_id, int_id<mutation_branch>( -1 ), false ).to_i();
+}
+
 void mutation_branch::reset_all()
 {
     mutations_category.clear();
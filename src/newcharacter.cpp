@@ -4108,6 +4108,7 @@ void Character::clear_mutations()
         mutation_loss_effect( trait );
     }
     cached_mutations.clear();
+    mutation_bits.clear();
     recalc_sight_limits();
     calc_encumbrance();
 }
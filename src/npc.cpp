@@ -1062,6 +1062,7 @@ void npc::set_known_to_u( bool known )
 void npc::on_move( const tripoint_abs_ms &old_pos )
 {
     Character::on_move( old_pos );
+    get_creature_tracker().note_change();
     const point_abs_om pos_om_old = project_to<coords::om>( old_pos.xy() );
     const point_abs_om pos_om_new = project_to<coords::om>( get_location().xy() );
     if( !is_fake() && pos_om_old != pos_om_new ) {
@@ -2823,6 +2824,12 @@ void npc::reboot()
     ai_cache.guard_pos = cata::nullopt;
     ai_cache.my_weapon_value = 0;
     ai_cache.friends.clear();
+    ai_cache.quiet_surroundings = cata::nullopt;
+    ai_cache.current_attack.reset();
+    ai_cache.attack_candidates.clear();
+    ai_cache.attack_candidates_key = cata::nullopt;
+    ai_cache.usable_ammo.clear();
+    ai_cache.usable_ammo_key = cata::nullopt;
     ai_cache.dangerous_explosives.clear();
     ai_cache.threat_map.clear();
     ai_cache.searched_tiles.clear();
@@ -3474,7 +3481,7 @@ bool npc::has_companion_mission() const
     return !comp_mission.mission_id.empty();
 }
 
-npc_companion_mission npc::get_companion_mission() const
+const npc_companion_mission &npc::get_companion_mission() const
 {
     return comp_mission;
 }
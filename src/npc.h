@@ -575,6 +575,13 @@ struct npc_short_term_cache {
 
     npc_attack_rating current_attack_evaluation;
     std::shared_ptr<npc_attack> current_attack;
+    // Every attack evaluate_best_weapon picks from except spells, and the key
+    // (npc::inventory_fingerprint plus what else decides the list) it was built for.
+    std::vector<std::shared_ptr<npc_attack>> attack_candidates;
+    cata::optional<size_t> attack_candidates_key;
+    // find_usable_ammo answers by weapon and its remaining ammo, for one inventory_fingerprint.
+    std::map<std::pair<const item *, int>, item_location> usable_ammo;
+    cata::optional<size_t> usable_ammo_key;
 
     // Use weak_ptr to avoid circular references between Creatures
     // attitude of creatures the npc can see
@@ -583,6 +590,9 @@ struct npc_short_term_cache {
     std::vector<weak_ptr_fast<Creature>> friends;
     std::vector<sphere> dangerous_explosives;
     std::map<direction, float> threat_map;
+    // npc::surroundings_signature the last time assess_danger found no hostiles; while it stays
+    // the same the friends and neutrals found then are kept and the assessment is skipped.
+    cata::optional<size_t> quiet_surroundings;
     // Cache of locations the NPC has searched recently in npc::find_item()
     lru_cache<tripoint, int> searched_tiles;
     // returns the value of the distance between a friendly creature and the closest enemy to that
@@ -1087,6 +1097,11 @@ class npc : public Character
         float evaluate_enemy( const Creature &target ) const;
 
         void assess_danger();
+        /**
+         * Warns about and backs off from fire right next to us; adds the fire within 6 tiles
+         * to @p threat_map.  Part of @ref assess_danger, but runs in quiet turns too.
+         */
+        void assess_fire( std::map<direction, float> &threat_map );
         bool is_safe() const;
         // Functions which choose an action for a particular goal
         npc_action method_of_fleeing();
@@ -1128,6 +1143,12 @@ class npc : public Character
         /** Finds ammo the NPC could use to reload a given object */
         item_location find_usable_ammo( const item &weap );
         item_location find_usable_ammo( const item &weap ) const;
+        /**
+         * Hash of every item carried: where it is, what it is, its charges and whether it is
+         * active. Much cheaper than evaluating the items, so results derived from the
+         * inventory are kept until this changes.
+         */
+        size_t inventory_fingerprint() const;
 
         bool dispose_item( item_location &&obj, const std::string &prompt = std::string() ) override;
 
@@ -1386,7 +1407,7 @@ class npc : public Character
         void reset_companion_mission();
         cata::optional<tripoint_abs_omt> get_mission_destination() const;
         bool has_companion_mission() const;
-        npc_companion_mission get_companion_mission() const;
+        const npc_companion_mission &get_companion_mission() const;
         attitude_group get_attitude_group( npc_attitude att ) const;
 
     protected:
@@ -1406,6 +1427,12 @@ class npc : public Character
         bool could_move_onto( const tripoint &p ) const;
 
         std::vector<sphere> find_dangerous_explosives() const;
+        /**
+         * Hash of what assess_danger looks at in a quiet turn: where we, the player and every
+         * other active creature are, how those creatures feel about us, nearby fire and the
+         * light level.
+         */
+        size_t surroundings_signature() const;
 
         npc_companion_mission comp_mission;
 };
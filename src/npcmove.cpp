@@ -40,6 +40,7 @@
 #include "game_constants.h"
 #include "gates.h"
 #include "gun_mode.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "item_factory.h"
 #include "itype.h"
@@ -373,6 +374,39 @@ std::vector<sphere> npc::find_dangerous_explosives() const
     return result;
 }
 
+size_t npc::surroundings_signature() const
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, get_location() );
+    cata::hash_combine( seed, get_player_character().get_location() );
+    cata::hash_combine( seed, static_cast<int>( attitude ) );
+    cata::hash_combine( seed, my_fac );
+    cata::hash_combine( seed, clairvoyance() );
+    cata::hash_combine( seed, g->light_level( posz() ) );
+    // assess_danger considers everyone, as far as a potential line of sight goes.
+    const auto hash_creature = [&]( const Creature & critter ) {
+        cata::hash_combine( seed, &critter );
+        cata::hash_combine( seed, critter.get_location() );
+        cata::hash_combine( seed, static_cast<int>( critter.attitude_to( *this ) ) );
+    };
+    for( const npc &guy : g->all_npcs() ) {
+        if( &guy != this ) {
+            hash_creature( guy );
+        }
+    }
+    for( const monster &critter : g->all_monsters() ) {
+        hash_creature( critter );
+    }
+    map &here = get_map();
+    const field_type_id fd_fire = ::fd_fire;
+    for( const tripoint &pt : here.points_in_radius( pos(), 6 ) ) {
+        if( here.get_field( pt, fd_fire ) ) {
+            cata::hash_combine( seed, pt );
+        }
+    }
+    return seed;
+}
+
 float npc::evaluate_enemy( const Creature &target ) const
 {
     if( target.is_monster() ) {
@@ -412,6 +446,27 @@ cata::optional<int> npc_short_term_cache::closest_enemy_to_friendly_distance() c
     return distance;
 }
 
+void npc::assess_fire( std::map<direction, float> &threat_map )
+{
+    map &here = get_map();
+    // cache string_id -> int_id conversion before hot loop
+    const field_type_id fd_fire = ::fd_fire;
+    // `map::get_field` uses `field_cache`, so in general case (no fire) it provides an early exit
+    for( const tripoint &pt : here.points_in_radius( pos(), 6 ) ) {
+        if( pt == pos() || !here.get_field( pt, fd_fire ) ||
+            here.has_flag( ter_furn_flag::TFLAG_FIRE_CONTAINER,  pt ) ) {
+            continue;
+        }
+        int dist = rl_dist( pos(), pt );
+        threat_map[direction_from( pos(), pt )] += 2.0f * ( NPC_DANGER_MAX - dist );
+        if( dist < 3 && !has_effect( effect_npc_fire_bad ) ) {
+            warn_about( "fire_bad", 1_minutes );
+            add_effect( effect_npc_fire_bad, 5_turns );
+            path.clear();
+        }
+    }
+}
+
 void npc::assess_danger()
 {
     float assessment = 0.0f;
@@ -476,26 +531,27 @@ void npc::assess_danger()
         cur_threat_map[ threat_dir ] = 0.25f * ai_cache.threat_map[ threat_dir ];
     }
     map &here = get_map();
-    // cache string_id -> int_id conversion before hot loop
-    const field_type_id fd_fire = ::fd_fire;
     // first, check if we're about to be consumed by fire
-    // `map::get_field` uses `field_cache`, so in general case (no fire) it provides an early exit
-    for( const tripoint &pt : here.points_in_radius( pos(), 6 ) ) {
-        if( pt == pos() || !here.get_field( pt, fd_fire ) ||
-            here.has_flag( ter_furn_flag::TFLAG_FIRE_CONTAINER,  pt ) ) {
-            continue;
+    assess_fire( cur_threat_map );
+
+    // find our Character friends and enemies
+    const bool clairvoyant = clairvoyance();
+    // Walk the lines of sight to everyone considered below in one batch, the sees() calls in the
+    // loops are then answered from memory.
+    std::vector<tripoint> candidate_positions;
+    for( const npc &guy : g->all_npcs() ) {
+        if( &guy != this && ( clairvoyant || here.has_potential_los( pos(), guy.pos() ) ) ) {
+            candidate_positions.push_back( guy.pos() );
         }
-        int dist = rl_dist( pos(), pt );
-        cur_threat_map[direction_from( pos(), pt )] += 2.0f * ( NPC_DANGER_MAX - dist );
-        if( dist < 3 && !has_effect( effect_npc_fire_bad ) ) {
-            warn_about( "fire_bad", 1_minutes );
-            add_effect( effect_npc_fire_bad, 5_turns );
-            path.clear();
+    }
+    candidate_positions.push_back( player_character.pos() );
+    for( const monster &critter : g->all_monsters() ) {
+        if( clairvoyant || here.has_potential_los( pos(), critter.pos() ) ) {
+            candidate_positions.push_back( critter.pos() );
         }
     }
+    here.sees_many( pos(), candidate_positions, MAX_VIEW_DISTANCE );
 
-    // find our Character friends and enemies
-    const bool clairvoyant = clairvoyance();
     for( const npc &guy : g->all_npcs() ) {
         if( &guy == this ) {
             continue;
@@ -743,9 +799,6 @@ void npc::regen_ai_cache()
         }
     }
     float old_assessment = ai_cache.danger_assessment;
-    ai_cache.friends.clear();
-    ai_cache.hostile_guys.clear();
-    ai_cache.neutral_guys.clear();
     ai_cache.target = shared_ptr_fast<Creature>();
     ai_cache.ally = shared_ptr_fast<Creature>();
     ai_cache.can_heal.clear_all();
@@ -754,7 +807,24 @@ void npc::regen_ai_cache()
     ai_cache.my_weapon_value = weapon_value( get_wielded_item() );
     ai_cache.dangerous_explosives = find_dangerous_explosives();
 
-    assess_danger();
+    // Nobody around wants to hurt us and nothing moved since: same friends, same neutrals and
+    // still no danger, without walking the lines of sight to everyone again.
+    const size_t surroundings = surroundings_signature();
+    if( !ai_cache.quiet_surroundings || *ai_cache.quiet_surroundings != surroundings ) {
+        ai_cache.friends.clear();
+        ai_cache.hostile_guys.clear();
+        ai_cache.neutral_guys.clear();
+        assess_danger();
+        if( ai_cache.hostile_guys.empty() ) {
+            ai_cache.quiet_surroundings = surroundings;
+        } else {
+            ai_cache.quiet_surroundings = cata::nullopt;
+        }
+    } else {
+        // A quiet assessment keeps no threat map, but the fire right next to us still matters.
+        std::map<direction, float> unused_threats;
+        assess_fire( unused_threats );
+    }
     if( old_assessment > NPC_DANGER_VERY_LOW && ai_cache.danger_assessment <= 0 ) {
         warn_about( "relax", 30_minutes );
     } else if( old_assessment <= 0.0f && ai_cache.danger_assessment > NPC_DANGER_VERY_LOW ) {
@@ -1430,8 +1500,61 @@ npc_action npc::method_of_attack()
     }
 }
 
+size_t npc::inventory_fingerprint() const
+{
+    size_t seed = 0;
+    visit_items( [&seed]( const item * it, const item * ) {
+        cata::hash_combine( seed, it );
+        cata::hash_combine( seed, it->typeId() );
+        cata::hash_combine( seed, it->charges );
+        cata::hash_combine( seed, it->active );
+        return VisitResponse::NEXT;
+    } );
+    return seed;
+}
+
 void npc::evaluate_best_weapon( const Creature *target )
 {
+    const int ups_charges = available_ups();
+    size_t key = inventory_fingerprint();
+    cata::hash_combine( key, ups_charges );
+    cata::hash_combine( key, rules.has_flag( ally_rule::use_guns ) );
+    cata::hash_combine( key, rules.has_flag( ally_rule::use_silent ) && is_player_ally() );
+    // can_use checks stat requirements
+    cata::hash_combine( key, str_cur );
+    cata::hash_combine( key, dex_cur );
+    cata::hash_combine( key, int_cur );
+    cata::hash_combine( key, per_cur );
+    std::vector<std::shared_ptr<npc_attack>> &candidates = ai_cache.attack_candidates;
+    if( !ai_cache.attack_candidates_key || *ai_cache.attack_candidates_key != key ) {
+        candidates.clear();
+        // punching things is always available
+        candidates.push_back( std::make_shared<npc_attack_melee>( null_item_reference() ) );
+        visit_items( [&candidates, &ups_charges, this]( item * it, item * ) {
+            // you can theoretically melee with anything.
+            candidates.push_back( std::make_shared<npc_attack_melee>( *it ) );
+            if( !is_wielding( *it ) || !it->has_flag( flag_NO_UNWIELD ) ) {
+                candidates.push_back( std::make_shared<npc_attack_throw>( *it ) );
+            }
+            if( !it->type->use_methods.empty() ) {
+                candidates.push_back( std::make_shared<npc_attack_activate_item>( *it ) );
+            }
+            if( rules.has_flag( ally_rule::use_guns ) ) {
+                for( const std::pair<const gun_mode_id, gun_mode> &mode : it->gun_all_modes() ) {
+                    if( !( mode.second.melee() || mode.second.flags.count( "NPC_AVOID" ) ||
+                           !can_use( *mode.second.target ) || mode.second->get_gun_ups_drain() > ups_charges ||
+                           ( rules.has_flag( ally_rule::use_silent ) && is_player_ally() &&
+                             !mode.second->is_silent() ) ) ) {
+                        candidates.push_back( std::make_shared<npc_attack_gun>( *it, mode.second ) );
+                    }
+                }
+            }
+            return VisitResponse::NEXT;
+        } );
+        ai_cache.attack_candidates_key = key;
+    }
+
+    // The ratings depend on where everyone stands, so they are worked out every time.
     std::shared_ptr<npc_attack> best_attack;
     npc_attack_rating best_evaluated_attack;
     const auto compare = [&best_attack, &best_evaluated_attack, this, &target]
@@ -1442,31 +1565,9 @@ void npc::evaluate_best_weapon( const Creature *target )
             best_evaluated_attack = evaluated;
         }
     };
-
-    // punching things is always available
-    compare( std::make_shared<npc_attack_melee>( null_item_reference() ) );
-    const int ups_charges = available_ups();
-    visit_items( [&compare, &ups_charges, this]( item * it, item * ) {
-        // you can theoretically melee with anything.
-        compare( std::make_shared<npc_attack_melee>( *it ) );
-        if( !is_wielding( *it ) || !it->has_flag( flag_NO_UNWIELD ) ) {
-            compare( std::make_shared<npc_attack_throw>( *it ) );
-        }
-        if( !it->type->use_methods.empty() ) {
-            compare( std::make_shared<npc_attack_activate_item>( *it ) );
-        }
-        if( rules.has_flag( ally_rule::use_guns ) ) {
-            for( const std::pair<const gun_mode_id, gun_mode> &mode : it->gun_all_modes() ) {
-                if( !( mode.second.melee() || mode.second.flags.count( "NPC_AVOID" ) ||
-                       !can_use( *mode.second.target ) || mode.second->get_gun_ups_drain() > ups_charges ||
-                       ( rules.has_flag( ally_rule::use_silent ) && is_player_ally() &&
-                         !mode.second->is_silent() ) ) ) {
-                    compare( std::make_shared<npc_attack_gun>( *it, mode.second ) );
-                }
-            }
-        }
-        return VisitResponse::NEXT;
-    } );
+    for( const std::shared_ptr<npc_attack> &candidate : candidates ) {
+        compare( candidate );
+    }
     for( const spell_id &sp : magic->spells() ) {
         compare( std::make_shared<npc_attack_spell>( sp ) );
     }
@@ -1565,11 +1666,25 @@ item_location npc::find_usable_ammo( const item &weap )
         return item_location();
     }
 
+    const size_t fingerprint = inventory_fingerprint();
+    if( !ai_cache.usable_ammo_key || *ai_cache.usable_ammo_key != fingerprint ) {
+        ai_cache.usable_ammo.clear();
+        ai_cache.usable_ammo_key = fingerprint;
+    }
+    const std::pair<const item *, int> asked( &weap, weap.ammo_remaining() );
+    const auto cached = ai_cache.usable_ammo.find( asked );
+    if( cached != ai_cache.usable_ammo.end() && cached->second ) {
+        return cached->second;
+    }
+
     item_location loc = select_ammo( weap ).ammo;
     if( !loc || !wants_to_reload_with( weap, *loc ) ) {
         return item_location();
     }
-
+    // Ammo lying next to us can go away without us noticing, only our own is remembered.
+    if( loc.held_by( *this ) ) {
+        ai_cache.usable_ammo[asked] = loc;
+    }
     return loc;
 }
 
@@ -2221,8 +2336,13 @@ bool npc::update_path( const tripoint &p, const bool no_bashing, bool force )
         }
     }
 
-    auto new_path = get_map().route( pos(), p, get_pathfinding_settings( no_bashing ),
-                                     get_path_avoid() );
+    map &here = get_map();
+    const pathfinding_settings &settings = get_pathfinding_settings( no_bashing );
+    const std::set<tripoint> avoid = get_path_avoid();
+    std::vector<tripoint> new_path = here.repair_route( pos(), path, p, settings, avoid );
+    if( new_path.empty() ) {
+        new_path = here.route( pos(), p, settings, avoid );
+    }
     if( new_path.empty() ) {
         if( !ai_cache.sound_alerts.empty() ) {
             ai_cache.sound_alerts.erase( ai_cache.sound_alerts.begin() );
@@ -522,7 +522,10 @@ class overmap_special
         bool has_flag( const std::string & ) const;
         int longest_side() const;
         std::vector<overmap_special_terrain> preview_terrains() const;
-        std::vector<overmap_special_locations> required_locations() const;
+        /** The terrains every placement has to check, worked out once in finalize. */
+        const std::vector<overmap_special_locations> &required_locations() const {
+            return required_locations_;
+        }
         int score_rotation_at( const overmap &om, const tripoint_om_omt &p,
                                om_direction::type r ) const;
         special_placement_result place(
@@ -558,6 +561,7 @@ class overmap_special
 
         // These locations are the default values if ones are not specified for the individual OMTs.
         cata::flat_set<string_id<overmap_location>> default_locations_;
+        std::vector<overmap_special_locations> required_locations_;
         mapgen_parameters mapgen_params_;
 };
 
@@ -1307,6 +1307,13 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "AUTOSAVE_JOURNAL", "general", to_translation( "Journal autosaves" ),
+         to_translation( "If true, autosaves append the files they change to a journal in the world folder instead of rewriting them, which is faster.  The journal is folded into the save files on the next manual save, and replayed on loading if the game stopped before that." ),
+         false
+       );
+
+    get_option( "AUTOSAVE_JOURNAL" ).setPrerequisite( "AUTOSAVE" );
+
     add_empty_line();
 
     add( "AUTO_NOTES", "general", to_translation( "Auto notes" ),
@@ -1792,6 +1799,13 @@ void options_manager::add_options_graphics()
 
     get_option( "ANIMATION_DELAY" ).setPrerequisite( "ANIMATIONS" );
 
+    add( "ANIMATION_BUDGET", "graphics", to_translation( "Animation time budget" ),
+         to_translation( "The most time in ms animations may take in a single turn, frames past it are skipped.  Lets long bursts of fire resolve quickly.  0 for no limit." ),
+         0, 10000, 1000
+       );
+
+    get_option( "ANIMATION_BUDGET" ).setPrerequisite( "ANIMATIONS" );
+
     add( "FORCE_REDRAW", "graphics", to_translation( "Force redraw" ),
          to_translation( "If true, forces the game to redraw at least once per turn." ),
          true
@@ -2148,6 +2162,11 @@ void options_manager::add_options_world_default()
     }, "reset"
        );
 
+    add( "COMPRESS_SAVES", "world_default", to_translation( "Compress save files" ),
+         to_translation( "If true, map, overmap, map memory and master save files are written gzip-compressed.  They take far less disk space, and both kinds load either way." ),
+         false
+       );
+
     add_empty_line();
 
     add( "CITY_SIZE", "world_default", to_translation( "Size of cities" ),
@@ -2266,6 +2285,13 @@ void options_manager::add_options_debug()
         debug_page_.items_.emplace_back();
     };
 
+    add( "WORKER_THREADS", "debug", to_translation( "Worker threads" ),
+         to_translation( "How many threads, the main one included, share the work that is split up, such as building the map caches, planning monster routes and saving.  0 uses as many as the processor has, 1 does everything on the main thread.  Requires restart." ),
+         0, 64, 0
+       );
+
+    add_empty_line();
+
     add( "DISTANCE_INITIAL_VISIBILITY", "debug", to_translation( "Distance initial visibility" ),
          to_translation( "Determines the scope, which is known in the beginning of the game." ),
          3, 20, 15
@@ -2325,6 +2351,18 @@ void options_manager::add_options_debug()
        );
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
+
+    add_empty_line();
+
+    add( "PARALLEL_MAP_CACHE", "debug", to_translation( "Parallel map cache rebuild" ),
+         to_translation( "If true and the world is in z-level mode, the per-level outside, transparency and floor caches are rebuilt on several threads at once.  Only helps on machines with more than one core." ),
+         false
+       );
+
+    add( "IDLE_MONSTER_LOD", "debug", to_translation( "Reduced updates for idle distant monsters" ),
+         to_translation( "If true, monsters with no target, destination or sound to follow only act every few turns while far from you and any NPC, spending the moves saved up in the meantime all at once.  Hearing a sound or getting hurt makes them act on the next turn." ),
+         false
+       );
 }
 
 void options_manager::add_options_android()
@@ -3202,6 +3240,8 @@ static void update_options_cache()
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
+    parallel_map_cache = ::get_option<bool>( "PARALLEL_MAP_CACHE" );
+    idle_monster_lod = ::get_option<bool>( "IDLE_MONSTER_LOD" );
     keycode_mode = ::get_option<std::string>( "SDL_KEYBOARD_MODE" ) == "keycode";
 }
 
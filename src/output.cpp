@@ -10,6 +10,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <new>
 #include <sstream>
 #include <stack>
@@ -26,6 +28,7 @@
 #include "input.h"
 #include "item.h"
 #include "line.h"
+#include "lru_cache.h"
 #include "name.h"
 #include "options.h"
 #include "point.h"
@@ -64,14 +67,38 @@ int OVERMAP_LEGEND_WIDTH;
 
 scrollingcombattext SCT;
 
-// utf8 version
-std::vector<std::string> foldstring( const std::string &str, int width, const char split )
+namespace
 {
-    std::vector<std::string> lines;
-    if( width < 1 ) {
-        lines.push_back( str );
-        return lines;
+
+// Panels redraw the same text on every keypress, so the folded lines and color segments of
+// the most recently used strings are kept rather than parsed again.
+constexpr int text_cache_size = 512;
+
+template<typename T>
+using text_cache = lru_cache<std::string, std::shared_ptr<const T>>;
+
+template<typename T, typename F>
+std::shared_ptr<const T> cached_text( text_cache<T> &cache, const std::string &key, F compute )
+{
+    static std::mutex mutex;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        std::shared_ptr<const T> value = cache.get( key, nullptr );
+        if( value ) {
+            // Inserting it again makes it the most recently used.
+            cache.insert( text_cache_size, key, value );
+            return value;
+        }
     }
+    std::shared_ptr<const T> value = std::make_shared<const T>( compute() );
+    std::lock_guard<std::mutex> lock( mutex );
+    cache.insert( text_cache_size, key, value );
+    return value;
+}
+
+std::vector<std::string> fold_uncached( const std::string &str, int width, const char split )
+{
+    std::vector<std::string> lines;
     std::stringstream sstr( str );
     std::string strline;
     std::vector<std::string> tags;
@@ -128,7 +155,7 @@ std::vector<std::string> foldstring( const std::string &str, int width, const ch
     return lines;
 }
 
-std::vector<std::string> split_by_color( const std::string &s )
+std::vector<std::string> split_by_color_uncached( const std::string &s )
 {
     std::vector<std::string> ret;
     std::vector<size_t> tag_positions = get_tag_positions( s );
@@ -142,22 +169,53 @@ std::vector<std::string> split_by_color( const std::string &s )
     return ret;
 }
 
-std::string remove_color_tags( const std::string &s )
+std::shared_ptr<const std::vector<std::string>> color_segments_of( const std::string &s )
 {
-    std::string ret;
-    std::vector<size_t> tag_positions = get_tag_positions( s );
-    if( tag_positions.empty() ) {
-        return s;
+    static text_cache<std::vector<std::string>> cache;
+    return cached_text( cache, s, [&]() {
+        return split_by_color_uncached( s );
+    } );
+}
+
+} // namespace
+
+// utf8 version
+std::vector<std::string> foldstring( const std::string &str, int width, const char split )
+{
+    if( width < 1 ) {
+        return { str };
     }
+    static text_cache<std::vector<std::string>> cache;
+    // Neither the split character nor the digits of the width can be a newline.
+    const std::string key = split + std::to_string( width ) + '\n' + str;
+    return *cached_text( cache, key, [&]() {
+        return fold_uncached( str, width, split );
+    } );
+}
 
-    size_t next_pos = 0;
-    for( size_t tag_position : tag_positions ) {
-        ret += s.substr( next_pos, tag_position - next_pos );
-        next_pos = s.find( ">", tag_position, 1 ) + 1;
+std::vector<std::string> split_by_color( const std::string &s )
+{
+    return *color_segments_of( s );
+}
+
+std::string remove_color_tags( const std::string &s )
+{
+    if( s.find( '<' ) == std::string::npos ) {
+        return s;
     }
+    static text_cache<std::string> cache;
+    return *cached_text( cache, s, [&]() {
+        std::string ret;
+        std::vector<size_t> tag_positions = get_tag_positions( s );
+        size_t next_pos = 0;
+        for( size_t tag_position : tag_positions ) {
+            ret += s.substr( next_pos, tag_position - next_pos );
+            next_pos = s.find( ">", tag_position, 1 ) + 1;
+        }
 
-    ret += s.substr( next_pos, std::string::npos );
-    return ret;
+        ret += s.substr( next_pos, std::string::npos );
+        return ret;
+    } );
 }
 
 color_tag_parse_result::tag_type update_color_stack(
@@ -188,11 +246,12 @@ void print_colored_text( const catacurses::window &w, const point &p, nc_color &
     if( p.y > -1 && p.x > -1 ) {
         wmove( w, p );
     }
-    const auto color_segments = split_by_color( text );
+    const std::shared_ptr<const std::vector<std::string>> color_segments =
+                color_segments_of( text );
     std::stack<nc_color> color_stack;
     color_stack.push( color );
 
-    for( auto seg : color_segments ) {
+    for( std::string seg : *color_segments ) {
         if( seg.empty() ) {
             continue;
         }
@@ -6,11 +6,14 @@
 #include <cmath>
 #include <cstring>
 #include <exception>
+#include <functional>
 #include <istream>
 #include <memory>
 #include <numeric>
 #include <ostream>
 #include <set>
+#include <sstream>
+#include <string>
 #include <type_traits>
 #include <unordered_set>
 #include <vector>
@@ -53,10 +56,12 @@
 #include "regional_settings.h"
 #include "rng.h"
 #include "rotatable_symbols.h"
+#include "save_stats.h"
 #include "sets_intersect.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "trace_zones.h"
 #include "translations.h"
 
 static const mongroup_id GROUP_NEMESIS( "GROUP_NEMESIS" );
@@ -2514,6 +2519,7 @@ overmap_special::overmap_special( const overmap_special_id &i, const overmap_spe
     : id( i )
     , subtype_( overmap_special_subtype::fixed )
     , data_{ make_shared_fast<fixed_overmap_special_data>( ter ) }
+    , required_locations_( data_->required_locations() )
 {}
 
 bool overmap_special::can_spawn() const
@@ -2552,7 +2558,7 @@ int overmap_special::longest_side() const
 {
     // Figure out the longest side of the special for purposes of determining our sector size
     // when attempting placements.
-    std::vector<overmap_special_locations> req_locations = required_locations();
+    const std::vector<overmap_special_locations> &req_locations = required_locations();
     auto min_max_x = std::minmax_element( req_locations.begin(), req_locations.end(),
     []( const overmap_special_locations & lhs, const overmap_special_locations & rhs ) {
         return lhs.p.x < rhs.p.x;
@@ -2573,11 +2579,6 @@ std::vector<overmap_special_terrain> overmap_special::preview_terrains() const
     return data_->preview_terrains();
 }
 
-std::vector<overmap_special_locations> overmap_special::required_locations() const
-{
-    return data_->required_locations();
-}
-
 int overmap_special::score_rotation_at( const overmap &om, const tripoint_om_omt &p,
                                         om_direction::type r ) const
 {
@@ -2657,6 +2658,7 @@ void overmap_special::finalize()
 {
     const_cast<overmap_special_data &>( *data_ ).finalize(
         "overmap special " + id.str(), default_locations_ );
+    required_locations_ = data_->required_locations();
 }
 
 void overmap_special::finalize_mapgen_parameters()
@@ -2743,6 +2745,7 @@ oter_id overmap::get_default_terrain( int z ) const
 
 void overmap::init_layers()
 {
+    terrain_index.clear();
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
         const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
 
@@ -2767,9 +2770,72 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
     if( id->has_flag( oter_flags::requires_predecessor ) ) {
         predecessors_[p].push_back( val );
     }
+    if( val != id ) {
+        overmap_buffer.invalidate_travel_paths();
+        if( !terrain_index.empty() ) {
+            terrain_locations &old_locations = terrain_index[val.to_i()];
+            old_locations.count--;
+            if( old_locations.listed ) {
+                std::vector<tripoint_om_omt> &points = old_locations.points;
+                const auto it = std::find( points.begin(), points.end(), p );
+                if( it != points.end() ) {
+                    points.erase( it );
+                }
+            }
+            index_terrain( p, id );
+        }
+    }
     val = id;
 }
 
+// Terrains found more often than this on one overmap are not listed: they are never far away,
+// so a search by scanning outwards is quick to find them.
+static constexpr int max_listed_terrain_count = 256;
+
+void overmap::index_terrain( const tripoint_om_omt &p, const oter_id &id ) const
+{
+    terrain_locations &locations = terrain_index[id.to_i()];
+    locations.count++;
+    if( !locations.listed ) {
+        return;
+    }
+    if( locations.count > max_listed_terrain_count ) {
+        locations.listed = false;
+        locations.points.clear();
+        locations.points.shrink_to_fit();
+        return;
+    }
+    locations.points.push_back( p );
+}
+
+cata::optional<std::vector<tripoint_om_omt>> overmap::find_terrain_locations(
+            const std::vector<bool> &wanted ) const
+{
+    if( terrain_index.empty() ) {
+        terrain_index.resize( overmap_terrains::get_all().size() );
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                for( int y = 0; y < OMAPY; ++y ) {
+                    const tripoint_om_omt p( x, y, z );
+                    index_terrain( p, ter_unsafe( p ) );
+                }
+            }
+        }
+    }
+
+    std::vector<tripoint_om_omt> result;
+    for( size_t i = 0; i < wanted.size() && i < terrain_index.size(); ++i ) {
+        if( !wanted[i] || terrain_index[i].count == 0 ) {
+            continue;
+        }
+        if( !terrain_index[i].listed ) {
+            return cata::nullopt;
+        }
+        result.insert( result.end(), terrain_index[i].points.begin(), terrain_index[i].points.end() );
+    }
+    return result;
+}
+
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
@@ -3114,6 +3180,7 @@ void overmap::generate( const overmap *north, const overmap *east,
                         const overmap *south, const overmap *west,
                         overmap_special_batch &enabled_specials )
 {
+    CATA_TRACE_ZONE( "overmap::generate" );
     if( g->gametype() == special_game_type::DEFENSE ) {
         dbg( D_INFO ) << "overmap::generate skipped in Defense special game mode!";
         return;
@@ -3123,10 +3190,21 @@ void overmap::generate( const overmap *north, const overmap *east,
 
     populate_connections_out_from_neighbors( north, east, south, west );
 
+    // The noise only depends on the position and the seed, so work it out for the whole
+    // overmap at once instead of square by square inside the passes.
+    const unsigned seed = g->get_seed();
+    const om_noise::om_noise_layer_lake lake_noise( global_base_point(), seed );
+    const om_noise::om_noise_layer_forest forest_noise( global_base_point(), seed );
+    const om_noise::om_noise_layer_floodplain floodplain_noise( global_base_point(), seed );
+    om_noise::om_noise_field lake_field( lake_noise );
+    om_noise::om_noise_field forest_field( forest_noise );
+    om_noise::om_noise_field floodplain_field( floodplain_noise );
+    om_noise::om_noise_field::fill( { &lake_field, &forest_field, &floodplain_field } );
+
     place_rivers( north, east, south, west );
-    place_lakes();
-    place_forests();
-    place_swamps();
+    place_lakes( lake_field );
+    place_forests( forest_field );
+    place_swamps( floodplain_field );
     place_ravines();
     place_cities();
     place_forest_trails();
@@ -3716,9 +3794,11 @@ void overmap::move_hordes()
                 mg.pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint_om_sm, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
+            // Erase the group at it's old location, add the group with the new location.
+            // Moved rather than copied, a horde can carry a lot of monsters.
+            const tripoint_om_sm new_pos = mg.pos;
+            tmpzg.emplace( new_pos, std::move( mg ) );
+            it = zg.erase( it );
         } else {
             ++it;
         }
@@ -3777,11 +3857,12 @@ void overmap::move_hordes()
                 if( add_to_group == nullptr ) {
                     mongroup m( GROUP_ZOMBIE, p, 1, 0 );
                     m.horde = true;
-                    m.monsters.push_back( this_monster );
+                    // The monster is erased right below.
+                    m.monsters.push_back( std::move( this_monster ) );
                     m.interest = 0; // Ensures that we will select a new target.
                     add_mon_group( m );
                 } else {
-                    add_to_group->monsters.push_back( this_monster );
+                    add_to_group->monsters.push_back( std::move( this_monster ) );
                 }
             } else { // Bad luck--the zombie would have joined a larger horde, but not this one.  Skip.
                 // Don't delete the monster, just increment the iterator.
@@ -4167,12 +4248,10 @@ void overmap::place_forest_trailheads()
     }
 }
 
-void overmap::place_forests()
+void overmap::place_forests( const om_noise::om_noise_field &f )
 {
     const oter_id default_oter_id( settings->default_oter[OVERMAP_DEPTH] );
 
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
-
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             const tripoint_om_omt p( x, y, 0 );
@@ -4196,10 +4275,8 @@ void overmap::place_forests()
     }
 }
 
-void overmap::place_lakes()
+void overmap::place_lakes( const om_noise::om_noise_field &f )
 {
-    const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
-
     const auto is_lake = [&]( const point_om_omt & p ) {
         return f.noise_at( p ) > settings->overmap_lake.noise_threshold_lake;
     };
@@ -4486,7 +4563,7 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     }
 }
 
-void overmap::place_swamps()
+void overmap::place_swamps( const om_noise::om_noise_field &f )
 {
     // Buffer our river terrains by a variable radius and increment a counter for the location each
     // time it's included in a buffer. It's a floodplain that we'll then intersect later with some
@@ -4511,9 +4588,7 @@ void overmap::place_swamps()
         }
     }
 
-    // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
-
+    // f is the layer of noise to use in conjunction with our river buffered floodplain.
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             const tripoint_om_omt pos( x, y, 0 );
@@ -5754,7 +5829,7 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
         return false;
     }
 
-    const std::vector<overmap_special_locations> fixed_terrains = special.required_locations();
+    const std::vector<overmap_special_locations> &fixed_terrains = special.required_locations();
 
     return std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
     [&]( const overmap_special_locations & elem ) {
@@ -6181,12 +6256,46 @@ void overmap::open( overmap_special_batch &enabled_specials )
 // Note: this may throw io errors from std::ofstream
 void overmap::save() const
 {
-    write_to_file( overmapbuffer::player_filename( loc ), [&]( std::ostream & stream ) {
-        serialize_view( stream );
-    } );
+    std::ostringstream view;
+    serialize_view( view );
+    std::ostringstream terrain;
+    serialize( terrain );
+    save( view.str(), terrain.str() );
+}
 
-    write_to_file( overmapbuffer::terrain_filename( loc ), [&]( std::ostream & stream ) {
-        serialize( stream );
+// Note: this may throw io errors from std::ofstream
+void overmap::save( const std::string &view, const std::string &terrain ) const
+{
+    const bool compress = compress_save_files();
+    // Most overmaps of a long game are not visited between two saves, so their files
+    // would be written again unchanged.
+    const auto save_if_changed = [compress]( const std::string & path,
+    cata::optional<size_t> &saved_hash, const std::string & data ) {
+        const size_t hash = std::hash<std::string>()( data );
+        if( saved_hash && *saved_hash == hash ) {
+            save_stats::add_unchanged_file( save_part::overmaps );
+            return;
+        }
+        // Forget the old hash first: if writing throws, the next save must try again.
+        saved_hash.reset();
+        write_to_file( path, [&]( std::ostream & stream ) {
+            stream << data;
+        }, compress );
+        saved_hash = hash;
+        save_stats::add_file( save_part::overmaps, data.size() );
+    };
+    save_if_changed( overmapbuffer::player_filename( loc ), saved_view_hash, view );
+    save_if_changed( overmapbuffer::terrain_filename( loc ), saved_terrain_hash, terrain );
+}
+
+bool overmap::can_serialize_concurrently() const
+{
+    if( !npcs.empty() || !monster_map.empty() || !camps.empty() ) {
+        return false;
+    }
+    using group = std::pair<const tripoint_om_sm, mongroup>;
+    return std::all_of( zg.begin(), zg.end(), []( const group & g ) {
+        return g.second.monsters.empty();
     } );
 }
 
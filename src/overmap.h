@@ -40,6 +40,10 @@ class npc;
 class overmap_connection;
 struct regional_settings;
 
+namespace om_noise
+{
+class om_noise_field;
+} // namespace om_noise
 namespace pf
 {
 template<typename Point>
@@ -217,6 +221,18 @@ class overmap
         }
 
         void save() const;
+        /**
+         * Writes the already serialized contents of the files @ref save writes, skipping
+         * the ones that did not change since they were last written.
+         */
+        void save( const std::string &view, const std::string &terrain ) const;
+        /**
+         * Whether @ref serialize only reads this overmap, so that it may run on another
+         * thread while other overmaps are serialized. NPCs, monsters and camps are saved
+         * with the terrain and their serialization is not safe off the main thread.
+         * @ref serialize_view always is.
+         */
+        bool can_serialize_concurrently() const;
 
         /**
          * @return The (local) overmap terrain coordinates of a randomly
@@ -236,6 +252,13 @@ class overmap
          */
         std::vector<point_abs_omt> find_terrain( const std::string &term, int zlevel );
 
+        /**
+         * Every location on this overmap with a terrain marked in @p wanted (indexed by
+         * oter_id), or nullopt if one of those terrains is too common here to be listed.
+         */
+        cata::optional<std::vector<tripoint_om_omt>> find_terrain_locations(
+                    const std::vector<bool> &wanted ) const;
+
         void ter_set( const tripoint_om_omt &p, const oter_id &id );
         // ter has bounds checking, and returns ot_null when out of bounds.
         const oter_id &ter( const tripoint_om_omt &p ) const;
@@ -375,6 +398,22 @@ class overmap
         // predecessor terrains so they can be used for mapgen later
         std::unordered_map<tripoint_om_omt, std::vector<oter_id>> predecessors_;
 
+        struct terrain_locations {
+            int count = 0;
+            // Dropped once count gets past the limit in overmap.cpp.
+            bool listed = true;
+            std::vector<tripoint_om_omt> points;
+        };
+        // Where each oter_id (by index) lies, built by the first find_terrain_locations
+        // and then kept up to date by ter_set.
+        mutable std::vector<terrain_locations> terrain_index; // NOLINT(cata-serialize)
+        void index_terrain( const tripoint_om_omt &p, const oter_id &id ) const;
+
+        // Hashes of the files the last save() wrote, so that it can skip the ones that
+        // came out the same this time.
+        mutable cata::optional<size_t> saved_view_hash; // NOLINT(cata-serialize)
+        mutable cata::optional<size_t> saved_terrain_hash; // NOLINT(cata-serialize)
+
         // Records mapgen parameters required at the overmap special level
         // These are lazily evaluated; empty optional means that they have yet
         // to be evaluated.
@@ -438,11 +477,11 @@ class overmap
 
         // Overall terrain
         void place_river( const point_om_omt &pa, const point_om_omt &pb );
-        void place_forests();
-        void place_lakes();
+        void place_forests( const om_noise::om_noise_field &f );
+        void place_lakes( const om_noise::om_noise_field &f );
         void place_rivers( const overmap *north, const overmap *east, const overmap *south,
                            const overmap *west );
-        void place_swamps();
+        void place_swamps( const om_noise::om_noise_field &f );
         void place_forest_trails();
         void place_forest_trailheads();
 
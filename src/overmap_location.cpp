@@ -33,6 +33,10 @@ const overmap_location &string_id<overmap_location>::obj() const
 
 bool overmap_location::test( const int_id<oter_t> &oter ) const
 {
+    const size_t i = oter.to_i();
+    if( i < matches.size() ) {
+        return matches[i];
+    }
     return terrains.count( oter->get_type_id() );
 }
 
@@ -80,6 +84,15 @@ void overmap_location::finalize()
             }
         }
     }
+
+    // Placing overmap specials tests locations for every terrain they would cover, so look
+    // them up by int id instead of comparing type names.
+    const std::vector<oter_t> &all_oters = overmap_terrains::get_all();
+    matches.clear();
+    matches.reserve( all_oters.size() );
+    for( const oter_t &ter_elem : all_oters ) {
+        matches.push_back( terrains.count( ter_elem.get_type_id() ) > 0 );
+    }
 }
 
 void overmap_locations::load( const JsonObject &jo, const std::string &src )
@@ -31,6 +31,8 @@ struct overmap_location {
     private:
         TerrColType terrains;
         std::vector<std::string> flags;
+        // Whether each overmap terrain, by int id, is of one of the terrains, filled in finalize.
+        std::vector<bool> matches;
 };
 
 namespace overmap_locations
@@ -1,12 +1,21 @@
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 #include "overmap_noise.h"
 #include "simplexnoise.h"
+#include "thread_pool.h"
 
 namespace om_noise
 {
 
+void om_noise_layer::fill_column( const point_om_omt &start, const int count, float *out ) const
+{
+    for( int n = 0; n < count; n++ ) {
+        out[n] = noise_at( start + point( 0, n ) );
+    }
+}
+
 float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -19,6 +28,19 @@ float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
     return std::max( 0.0f, r - d * 0.5f );
 }
 
+void om_noise_layer_forest::fill_column( const point_om_omt &start, const int count,
+                                         float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( start );
+    std::vector<float> d( count );
+    scaled_octave_noise_3d_row( 4, 0.5, 0.03, 0, 1, p.x(), p.y(), count, get_seed(), out );
+    scaled_octave_noise_3d_row( 6, 0.5, 0.07, 0, 1, p.x(), p.y(), count, get_seed(), d.data() );
+    for( int n = 0; n < count; n++ ) {
+        const float r = std::pow( out[n], 2.0f );
+        out[n] = std::max( 0.0f, r - std::pow( d[n], 3.0f ) * 0.5f );
+    }
+}
+
 float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -27,6 +49,16 @@ float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) c
     return r;
 }
 
+void om_noise_layer_floodplain::fill_column( const point_om_omt &start, const int count,
+        float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( start );
+    scaled_octave_noise_3d_row( 4, 0.5, 0.05, 0, 1, p.x(), p.y(), count, get_seed(), out );
+    for( int n = 0; n < count; n++ ) {
+        out[n] = std::pow( out[n], 2.0f );
+    }
+}
+
 float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -35,4 +67,27 @@ float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+void om_noise_layer_lake::fill_column( const point_om_omt &start, const int count,
+                                       float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( start );
+    scaled_octave_noise_3d_row( 8, 0.5, 0.002, 0, 1, p.x(), p.y(), count, get_seed(), out );
+    for( int n = 0; n < count; n++ ) {
+        out[n] = std::pow( out[n], 4.0f );
+    }
+}
+
+void om_noise_field::fill( std::initializer_list<om_noise_field *> fields )
+{
+    const std::vector<om_noise_field *> todo( fields );
+    for( om_noise_field *field : todo ) {
+        field->values.resize( OMAPX * OMAPY );
+    }
+    get_thread_pool().parallel_for( 0, static_cast<int>( todo.size() ) * OMAPX, [&]( const int i ) {
+        om_noise_field &field = *todo[i / OMAPX];
+        const int x = i % OMAPX;
+        field.layer.fill_column( point_om_omt( x, 0 ), OMAPY, &field.values[x * OMAPY] );
+    } );
+}
+
 } // namespace om_noise
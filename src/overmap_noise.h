@@ -2,6 +2,9 @@
 #ifndef CATA_SRC_OVERMAP_NOISE_H
 #define CATA_SRC_OVERMAP_NOISE_H
 
+#include <initializer_list>
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
 
@@ -20,6 +23,11 @@ class om_noise_layer
          * @param omt_local point location in overmap terrain local coordinates.
          */
         virtual float noise_at( const point_om_omt &omt_local ) const = 0;
+        /**
+         * Writes the noise of count terrains going south from start to out, the same values
+         * noise_at would give.  Layers override this to work through a whole column at once.
+         */
+        virtual void fill_column( const point_om_omt &start, int count, float *out ) const;
         virtual ~om_noise_layer() = default;
     protected:
         /**
@@ -55,6 +63,7 @@ class om_noise_layer_forest : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void fill_column( const point_om_omt &start, int count, float *out ) const override;
 };
 
 class om_noise_layer_floodplain : public om_noise_layer
@@ -65,6 +74,7 @@ class om_noise_layer_floodplain : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void fill_column( const point_om_omt &start, int count, float *out ) const override;
 };
 
 class om_noise_layer_lake : public om_noise_layer
@@ -75,6 +85,36 @@ class om_noise_layer_lake : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void fill_column( const point_om_omt &start, int count, float *out ) const override;
+};
+
+/**
+ * The values of a noise layer over every terrain of one overmap, worked out once before the
+ * passes that read them.  Points off the overmap are passed on to the layer.
+ */
+class om_noise_field
+{
+    public:
+        explicit om_noise_field( const om_noise_layer &layer ) : layer( layer ) {}
+
+        float noise_at( const point_om_omt &omt_local ) const {
+            const point &p = omt_local.raw();
+            if( values.empty() || p.x < 0 || p.y < 0 || p.x >= OMAPX || p.y >= OMAPY ) {
+                return layer.noise_at( omt_local );
+            }
+            return values[p.x * OMAPY + p.y];
+        }
+
+        /**
+         * Computes the values of all fields, one column of one field per task of the shared
+         * thread pool, through om_noise_layer::fill_column.  The layers only read their seed,
+         * so the columns are independent.
+         */
+        static void fill( std::initializer_list<om_noise_field *> fields );
+
+    private:
+        const om_noise_layer &layer;
+        std::vector<float> values;
 };
 
 } // namespace om_noise
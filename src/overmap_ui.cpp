@@ -508,6 +508,114 @@ static point_abs_omt draw_notes( const tripoint_abs_omt &origin )
     return result;
 }
 
+namespace
+{
+
+// The part of the look of an OMT that changes only with the overmap itself.
+struct omt_glyph {
+    bool see = false;
+    // Null unless seen.
+    oter_id ter = oter_str_id::NULL_ID();
+    std::string sym = " ";
+    nc_color color = c_black;
+    bool has_note = false;
+    std::string note_sym;
+    nc_color note_color = c_black;
+};
+
+// What the glyphs were looked up for, any change means they are all stale.
+struct omt_glyph_settings {
+    bool debug_vision = false;
+    bool show_explored = false;
+    bool land_use_codes = false;
+    bool forest_trails = false;
+
+    bool operator==( const omt_glyph_settings &rhs ) const {
+        return debug_vision == rhs.debug_vision && show_explored == rhs.show_explored &&
+               land_use_codes == rhs.land_use_codes && forest_trails == rhs.forest_trails;
+    }
+};
+
+/**
+ * Glyphs of the OMTs drawn lately, looked up a square chunk at a time when first drawn,
+ * so redrawing or panning the overmap doesn't query @ref overmap_buffer for every OMT.
+ * They are dropped whenever the @ref overmapbuffer::look_revision changes.
+ */
+class omt_glyph_cache
+{
+    public:
+        static constexpr int chunk_size = 16;
+        // About as many as a huge terminal shows at once.
+        static constexpr size_t max_chunks = 256;
+
+        void clear() {
+            chunks.clear();
+        }
+
+        const omt_glyph &get( const tripoint_abs_omt &p, const omt_glyph_settings &settings ) {
+            if( !( settings == this->settings ) || revision != overmap_buffer.look_revision() ) {
+                chunks.clear();
+                this->settings = settings;
+                revision = overmap_buffer.look_revision();
+            }
+            const tripoint_abs_omt origin( divide_round_down( p.x(), chunk_size ) * chunk_size,
+                                           divide_round_down( p.y(), chunk_size ) * chunk_size,
+                                           p.z() );
+            const point_rel_omt in_chunk = ( p - origin ).xy();
+            auto it = chunks.find( origin );
+            if( it == chunks.end() ) {
+                if( chunks.size() >= max_chunks ) {
+                    chunks.clear();
+                }
+                it = chunks.emplace( origin, build_chunk( origin ) ).first;
+            }
+            return it->second[in_chunk.y() * chunk_size + in_chunk.x()];
+        }
+
+    private:
+        using chunk = std::array<omt_glyph, chunk_size *chunk_size>;
+
+        chunk build_chunk( const tripoint_abs_omt &origin ) const {
+            static const oter_id forest = oter_forest.id();
+            chunk result;
+            for( int y = 0; y < chunk_size; ++y ) {
+                for( int x = 0; x < chunk_size; ++x ) {
+                    const tripoint_abs_omt omp = origin + point( x, y );
+                    omt_glyph &glyph = result[y * chunk_size + x];
+                    glyph.has_note = overmap_buffer.has_note( omp );
+                    if( glyph.has_note ) {
+                        std::tie( glyph.note_sym, glyph.note_color, std::ignore ) =
+                            get_note_display_info( overmap_buffer.note( omp ) );
+                    }
+                    glyph.see = settings.debug_vision || overmap_buffer.seen( omp );
+                    if( !glyph.see ) {
+                        continue;
+                    }
+                    // Only load terrain if we can actually see it
+                    glyph.ter = overmap_buffer.ter( omp );
+                    // If forest trails shouldn't be displayed, render them like a forest.
+                    const oter_t &info = !settings.forest_trails &&
+                                         glyph.ter->get_type_id() == oter_type_forest_trail ?
+                                         forest.obj() : glyph.ter.obj();
+                    const bool explored = settings.show_explored &&
+                                          overmap_buffer.is_explored( omp );
+                    glyph.color = explored ? c_dark_gray :
+                                  info.get_color( settings.land_use_codes );
+                    glyph.sym = info.get_symbol( settings.land_use_codes );
+                }
+            }
+            return result;
+        }
+
+        omt_glyph_settings settings;
+        int revision = 0;
+        std::unordered_map<tripoint_abs_omt, chunk> chunks;
+};
+
+omt_glyph_cache glyph_cache;
+
+} // namespace
+
 static void draw_ascii(
     const catacurses::window &w, const tripoint_abs_omt &center,
     const tripoint_abs_omt &orig, bool blink, bool show_explored, bool /* fast_scroll */,
@@ -535,7 +643,10 @@ static void draw_ascii(
     // Whether showing hordes is currently enabled
     const bool showhordes = uistate.overmap_show_hordes;
 
-    const oter_id forest = oter_forest.id();
+    const omt_glyph_settings glyph_settings = {
+        has_debug_vision, show_explored, uistate.overmap_show_land_use_codes,
+        uistate.overmap_show_forest_trails
+    };
 
     std::string sZoneName;
     tripoint_abs_omt tripointZone( -1, -1, -1 );
@@ -562,36 +673,6 @@ static void draw_ascii(
         }
     }
 
-    // A small LRU cache: most oter_id's occur in clumps like forests of swamps.
-    // This cache helps avoid much more costly lookups in the full hashmap.
-    constexpr size_t cache_size = 8; // used below to calculate the next index
-    std::array<std::pair<oter_id, oter_t const *>, cache_size> cache{ {} };
-    size_t cache_next = 0;
-
-    const auto set_color_and_symbol = [&]( const oter_id & cur_ter, const tripoint_abs_omt & omp,
-    std::string & ter_sym, nc_color & ter_color ) {
-        // First see if we have the oter_t cached
-        oter_t const *info = nullptr;
-        for( const auto &c : cache ) {
-            if( c.first == cur_ter ) {
-                info = c.second;
-                break;
-            }
-        }
-        // Nope, look in the hash map next
-        if( !info ) {
-            info = &cur_ter.obj();
-            cache[cache_next] = std::make_pair( cur_ter, info );
-            cache_next = ( cache_next + 1 ) % cache_size;
-        }
-        // Ok, we found something
-        if( info ) {
-            const bool explored = show_explored && overmap_buffer.is_explored( omp );
-            ter_color = explored ? c_dark_gray : info->get_color( uistate.overmap_show_land_use_codes );
-            ter_sym = info->get_symbol( uistate.overmap_show_land_use_codes );
-        }
-    };
-
     const tripoint_abs_omt corner = center - point( om_half_width, om_half_height );
 
     // For use with place_special: cache the color and symbol of each submap
@@ -699,15 +780,12 @@ static void draw_ascii(
     for( int i = 0; i < om_map_width; ++i ) {
         for( int j = 0; j < om_map_height; ++j ) {
             const tripoint_abs_omt omp = corner + point( i, j );
-            oter_id cur_ter = oter_str_id::NULL_ID();
+            const omt_glyph &glyph = glyph_cache.get( omp, glyph_settings );
+            const oter_id &cur_ter = glyph.ter;
             nc_color ter_color = c_black;
             std::string ter_sym = " ";
 
-            const bool see = has_debug_vision || overmap_buffer.seen( omp );
-            if( see ) {
-                // Only load terrain if we can actually see it
-                cur_ter = overmap_buffer.ter( omp );
-            }
+            const bool see = glyph.see;
 
             // Check if location is within player line-of-sight
             const bool los = see && player_character.overmap_los( omp, sight_points );
@@ -734,10 +812,10 @@ static void draw_ascii(
                 } else if( target.z() < center.z() ) {
                     ter_sym = "v";
                 }
-            } else if( blink && uistate.overmap_show_map_notes && overmap_buffer.has_note( omp ) ) {
+            } else if( blink && uistate.overmap_show_map_notes && glyph.has_note ) {
                 // Display notes in all situations, even when not seen
-                std::tie( ter_sym, ter_color, std::ignore ) =
-                    get_note_display_info( overmap_buffer.note( omp ) );
+                ter_color = glyph.note_color;
+                ter_sym = glyph.note_sym;
             } else if( !see ) {
                 // All cases above ignore the seen-status,
                 ter_color = c_dark_gray;
@@ -771,14 +849,10 @@ static void draw_ascii(
             } else if( !sZoneName.empty() && tripointZone.xy() == omp.xy() ) {
                 ter_color = c_yellow;
                 ter_sym = "Z";
-            } else if( !uistate.overmap_show_forest_trails && cur_ter &&
-                       ( cur_ter->get_type_id() == oter_type_forest_trail ) ) {
-                // If forest trails shouldn't be displayed, and this is a forest trail, then
-                // instead render it like a forest.
-                set_color_and_symbol( forest, omp, ter_sym, ter_color );
             } else {
                 // Nothing special, but is visible to the player.
-                set_color_and_symbol( cur_ter, omp, ter_sym, ter_color );
+                ter_color = glyph.color;
+                ter_sym = glyph.sym;
             }
 
             // Are we debugging monster groups?
@@ -1680,6 +1754,10 @@ static tripoint_abs_omt display( const tripoint_abs_omt &orig,
         g->mark_main_ui_adaptor_resize();
     } );
 
+    // Not every change to the overmap counts in its look_revision, but none happen while
+    // it is shown other than through the overmap buffer.
+    glyph_cache.clear();
+
     background_pane bg_pane;
 
     ui_adaptor ui;
@@ -5,8 +5,11 @@
 #include <iterator>
 #include <list>
 #include <map>
+#include <sstream>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "basecamp.h"
 #include "calendar.h"
@@ -26,6 +29,7 @@
 #include "line.h"
 #include "map.h"
 #include "memory_fast.h"
+#include "memory_stats.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "npc.h"
@@ -36,8 +40,10 @@
 #include "path_info.h"
 #include "point.h"
 #include "rng.h"
+#include "save_stats.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "vehicle.h"
 
@@ -105,6 +111,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
         return *( last_requested_overmap = it->second.get() );
     }
 
+    invalidate_travel_paths();
     // That constructor loads an existing overmap or creates a new one.
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate();
@@ -125,6 +132,7 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
             last_requested_overmap = nullptr;
         }
     }
+    invalidate_travel_paths();
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate( specials );
 }
@@ -245,19 +253,59 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
 
 void overmapbuffer::save()
 {
-    for( auto &omp : overmaps ) {
+    save_timer timer( save_part::overmaps );
+    std::vector<const overmap *> saved;
+    saved.reserve( overmaps.size() );
+    for( const auto &omp : overmaps ) {
+        saved.push_back( omp.second.get() );
+    }
+    std::sort( saved.begin(), saved.end(), []( const overmap * a, const overmap * b ) {
+        return a->pos() < b->pos();
+    } );
+
+    // Serializing takes most of the time and the overmaps are independent, so it is
+    // spread over the thread pool. Files are then written in order on this thread.
+    std::vector<std::string> views( saved.size() );
+    std::vector<std::string> terrains( saved.size() );
+    get_thread_pool().parallel_for( 0, static_cast<int>( saved.size() ), [&]( const int i ) {
+        std::ostringstream view;
+        saved[i]->serialize_view( view );
+        views[i] = view.str();
+        if( saved[i]->can_serialize_concurrently() ) {
+            std::ostringstream terrain;
+            saved[i]->serialize( terrain );
+            terrains[i] = terrain.str();
+        }
+    } );
+    for( size_t i = 0; i < saved.size(); ++i ) {
+        if( terrains[i].empty() ) {
+            std::ostringstream terrain;
+            saved[i]->serialize( terrain );
+            terrains[i] = terrain.str();
+        }
         // Note: this may throw io errors from std::ofstream
-        omp.second->save();
+        saved[i]->save( views[i], terrains[i] );
     }
 }
 
 void overmapbuffer::clear()
 {
+    invalidate_travel_paths();
+    travel_cost_tables.clear();
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
 }
 
+memory_usage overmapbuffer::memory_use() const
+{
+    memory_usage usage;
+    usage.count = overmaps.size();
+    // The layers of terrain are held in the overmap itself and make up most of it.
+    usage.bytes = overmaps.size() * sizeof( overmap );
+    return usage;
+}
+
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
 {
     overmap *om = get_om_global( p ).om;
@@ -268,6 +316,7 @@ void overmapbuffer::add_note( const tripoint_abs_omt &p, const std::string &mess
 {
     overmap_with_local_coords om_loc = get_om_global( p );
     om_loc.om->add_note( om_loc.local, message );
+    ++look_revision_;
 }
 
 void overmapbuffer::delete_note( const tripoint_abs_omt &p )
@@ -275,6 +324,8 @@ void overmapbuffer::delete_note( const tripoint_abs_omt &p )
     if( has_note( p ) ) {
         overmap_with_local_coords om_loc = get_om_global( p );
         om_loc.om->delete_note( om_loc.local );
+        invalidate_travel_paths();
+        ++look_revision_;
     }
 }
 
@@ -283,6 +334,7 @@ void overmapbuffer::mark_note_dangerous( const tripoint_abs_omt &p, int radius,
     if( has_note( p ) ) {
         overmap_with_local_coords om_loc = get_om_global( p );
         om_loc.om->mark_note_dangerous( om_loc.local, radius, is_dangerous );
+        invalidate_travel_paths();
     }
 }
 
@@ -334,6 +386,18 @@ bool overmapbuffer::has( const point_abs_om &p )
     return get_existing( p ) != nullptr;
 }
 
+bool overmapbuffer::prepare_neighbor( const point_abs_om &center )
+{
+    for( const tripoint &offset : eight_horizontal_neighbors ) {
+        const point_abs_om p = center + offset.xy();
+        if( overmaps.find( p ) == overmaps.end() ) {
+            get( p );
+            return true;
+        }
+    }
+    return false;
+}
+
 overmap_with_local_coords
 overmapbuffer::get_om_global( const point_abs_omt &p )
 {
@@ -435,6 +499,7 @@ void overmapbuffer::toggle_explored( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
     om_loc.om->explored( om_loc.local ) = !om_loc.om->explored( om_loc.local );
+    ++look_revision_;
 }
 
 bool overmapbuffer::has_horde( const tripoint_abs_omt &p )
@@ -738,7 +803,11 @@ bool overmapbuffer::seen( const tripoint_abs_omt &p )
 void overmapbuffer::set_seen( const tripoint_abs_omt &p, bool seen )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->seen( om_loc.local ) = seen;
+    bool &was_seen = om_loc.om->seen( om_loc.local );
+    if( was_seen != seen ) {
+        was_seen = seen;
+        invalidate_travel_paths();
+    }
 }
 
 const oter_id &overmapbuffer::ter( const tripoint_abs_omt &p )
@@ -875,15 +944,8 @@ overmap_path_params overmap_path_params::for_aircraft()
     return ret;
 }
 
-static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path_params &params )
+static int get_terrain_cost( const oter_id &oter, const overmap_path_params &params )
 {
-    if( params.only_known_by_player && !overmap_buffer.seen( omt_pos ) ) {
-        return -1;
-    }
-    if( params.avoid_danger && overmap_buffer.is_marked_dangerous( omt_pos ) ) {
-        return -1;
-    }
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
     if( ( oter->get_type_id() == oter_type_road ) ||
         ( oter->get_type_id() == oter_type_bridge_road ) ||
         ( oter->get_type_id() == oter_type_bridgehead_ground ) ||
@@ -925,13 +987,30 @@ static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path
     }
 }
 
-static bool is_ramp( const tripoint_abs_omt &omt_pos )
+static bool is_ramp( const oter_id &oter )
 {
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
     return ( oter->get_type_id() == oter_type_bridgehead_ground ) ||
            ( oter->get_type_id() == oter_type_bridgehead_ramp );
 }
 
+// Keeps this many paths around, about one per NPC travelling at the same time.
+static constexpr size_t max_travel_paths = 16;
+
+const overmapbuffer::oter_travel_cost &overmapbuffer::travel_cost( const oter_id &oter,
+        travel_cost_table &table )
+{
+    if( table.costs.empty() ) {
+        table.costs.resize( overmap_terrains::get_all().size() );
+    }
+    oter_travel_cost &entry = table.costs[oter.to_i()];
+    if( !entry.known ) {
+        entry.known = true;
+        entry.cost = get_terrain_cost( oter, table.params );
+        entry.ramp = is_ramp( oter );
+    }
+    return entry;
+}
+
 std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
     const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params )
 {
@@ -939,17 +1018,68 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
         return {};
     }
 
+    // From a point on a remembered path to the same dest, the rest of that path is reused.
+    // It is not always what a new search would find, since turns are charged by the direction
+    // a node is entered from, but it is a valid path and the one already being followed.
+    for( auto it = travel_paths.begin(); it != travel_paths.end(); ++it ) {
+        if( it->dest != dest || !( it->params == params ) ) {
+            continue;
+        }
+        std::vector<tripoint_abs_omt> points;
+        if( it->src == src ) {
+            points = it->points;
+        } else {
+            // The points run from dest back to the source
+            const auto found = std::find( it->points.begin(), it->points.end(), src );
+            if( found == it->points.end() ) {
+                continue;
+            }
+            points.assign( it->points.begin(), found + 1 );
+        }
+        std::rotate( travel_paths.begin(), it, it + 1 );
+        return points;
+    }
+
+    auto table = std::find_if( travel_cost_tables.begin(), travel_cost_tables.end(),
+    [&params]( const travel_cost_table & t ) {
+        return t.params == params;
+    } );
+    if( table == travel_cost_tables.end() ) {
+        travel_cost_tables.push_back( { params, {} } );
+        table = travel_cost_tables.end() - 1;
+    }
     const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
-        const int cur_cost = pos == src ? 0 : get_terrain_cost( pos, params );
-        if( cur_cost < 0 ) {
+        if( pos == src ) {
+            return pf::omt_score( 0, is_ramp( ter_existing( pos ) ) );
+        }
+        if( params.only_known_by_player && !seen( pos ) ) {
             return pf::omt_score::rejected;
         }
-        return pf::omt_score( cur_cost, is_ramp( pos ) );
+        if( params.avoid_danger && is_marked_dangerous( pos ) ) {
+            return pf::omt_score::rejected;
+        }
+        const oter_travel_cost &cost = travel_cost( ter_existing( pos ), *table );
+        if( cost.cost < 0 ) {
+            return pf::omt_score::rejected;
+        }
+        return pf::omt_score( cost.cost, cost.ramp );
     };
 
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
-    const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate );
-    return path.points;
+    pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate );
+
+    if( travel_paths.size() >= max_travel_paths ) {
+        travel_paths.pop_back();
+    }
+    travel_paths.insert( travel_paths.begin(), travel_path{ src, dest, params, path.points } );
+    return std::move( path.points );
+}
+
+void overmapbuffer::invalidate_travel_paths()
+{
+    travel_paths.clear();
+    // Everything that makes paths stale changes the look of the map as well.
+    ++look_revision_;
 }
 
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
@@ -1113,6 +1243,89 @@ bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
     return true;
 }
 
+// Which oter_ids (by index) match one of the types of @p params.
+static std::vector<bool> matching_terrains( const omt_find_params &params )
+{
+    std::vector<bool> wanted( overmap_terrains::get_all().size(), false );
+    for( size_t i = 0; i < wanted.size(); ++i ) {
+        const oter_id oter( static_cast<int>( i ) );
+        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
+            if( is_ot_match( elem.first, oter, elem.second ) ) {
+                wanted[i] = true;
+                break;
+            }
+        }
+    }
+    return wanted;
+}
+
+cata::optional<std::vector<tripoint_abs_omt>> overmapbuffer::find_indexed(
+            const tripoint_abs_omt &origin, const int min_dist, const int max_dist, const bool all_z,
+            const omt_find_params &params, const bool closest_only )
+{
+    const std::vector<bool> wanted = matching_terrains( params );
+
+    // Overmaps touching the search square, by the distance to their closest OMT.
+    const point_abs_om om_min = project_to<coords::om>( origin.xy() + point( -max_dist, -max_dist ) );
+    const point_abs_om om_max = project_to<coords::om>( origin.xy() + point( max_dist, max_dist ) );
+    std::vector<std::pair<int, point_abs_om>> overmaps_in_range;
+    for( int x = om_min.x(); x <= om_max.x(); ++x ) {
+        for( int y = om_min.y(); y <= om_max.y(); ++y ) {
+            const point_abs_om om_pos( x, y );
+            const point_abs_omt corner = project_to<coords::omt>( om_pos );
+            const point_abs_omt closest( clamp( origin.x(), corner.x(), corner.x() + OMAPX - 1 ),
+                                         clamp( origin.y(), corner.y(), corner.y() + OMAPY - 1 ) );
+            overmaps_in_range.emplace_back( square_dist( origin.xy(), closest ), om_pos );
+        }
+    }
+    std::sort( overmaps_in_range.begin(), overmaps_in_range.end(),
+    []( const std::pair<int, point_abs_om> &l, const std::pair<int, point_abs_om> &r ) {
+        return l.first < r.first;
+    } );
+
+    std::vector<tripoint_abs_omt> result;
+    cata::optional<int> found_dist;
+    for( const std::pair<int, point_abs_om> &in_range : overmaps_in_range ) {
+        if( found_dist && *found_dist < in_range.first ) {
+            break;
+        }
+        const overmap *om = params.existing_only ? get_existing( in_range.second ) :
+                            &get( in_range.second );
+        if( om == nullptr ) {
+            continue;
+        }
+        const cata::optional<std::vector<tripoint_om_omt>> locations =
+            om->find_terrain_locations( wanted );
+        if( !locations ) {
+            return cata::nullopt;
+        }
+        for( const tripoint_om_omt &local : *locations ) {
+            const tripoint_abs_omt loc = project_combine( in_range.second, local );
+            const int dist_xy = square_dist( origin.xy(), loc.xy() );
+            if( dist_xy < min_dist || dist_xy > max_dist || ( !all_z && loc.z() != origin.z() ) ) {
+                continue;
+            }
+            const int dist = square_dist( origin, loc );
+            if( closest_only && found_dist && *found_dist < dist ) {
+                continue;
+            }
+            if( !is_findable_location( loc, params ) ) {
+                continue;
+            }
+            if( closest_only && ( !found_dist || dist < *found_dist ) ) {
+                found_dist = dist;
+                result.clear();
+            }
+            result.push_back( loc );
+        }
+    }
+    std::sort( result.begin(), result.end(), [&origin]( const tripoint_abs_omt & l,
+    const tripoint_abs_omt & r ) {
+        return square_dist( origin, l ) < square_dist( origin, r );
+    } );
+    return result;
+}
+
 tripoint_abs_omt overmapbuffer::find_closest(
     const tripoint_abs_omt &origin, const std::string &type, int const radius, bool must_be_seen,
     ot_match_type match_type, bool existing_overmaps_only,
@@ -1149,6 +1362,11 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX * 5;
 
+    if( const cata::optional<std::vector<tripoint_abs_omt>> indexed = find_indexed( origin, min_dist,
+            max_dist, true, params, true ) ) {
+        return random_entry( *indexed, overmap::invalid_tripoint );
+    }
+
     std::vector<tripoint_abs_omt> result;
     cata::optional<int> found_dist;
 
@@ -1185,6 +1403,11 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
 
+    if( cata::optional<std::vector<tripoint_abs_omt>> indexed = find_indexed( origin, min_dist,
+            max_dist, false, params, false ) ) {
+        return std::move( *indexed );
+    }
+
     for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
         if( is_findable_location( loc, params ) ) {
             result.push_back( loc );
@@ -1542,8 +1765,9 @@ void overmapbuffer::spawn_monster( const tripoint_abs_sm &p )
         const tripoint local = here.getlocal( this_monster.get_location().raw() );
         // The monster position must be local to the main map when added to the game
         cata_assert( here.inbounds( local ) );
-        monster *const placed = g->place_critter_around( make_shared_fast<monster>( this_monster ),
-                                local, 0, true );
+        // The bucket is erased below, so the monster can be moved out of it.
+        monster *const placed = g->place_critter_around( make_shared_fast<monster>( std::move(
+                                    this_monster ) ), local, 0, true );
         if( placed ) {
             placed->on_load();
         }
@@ -30,6 +30,7 @@ class overmap;
 class overmap_special_batch;
 class vehicle;
 struct mapgen_arguments;
+struct memory_usage;
 struct mongroup;
 struct om_vehicle;
 struct radio_tower;
@@ -51,6 +52,16 @@ struct overmap_path_params {
     bool only_known_by_player = true;
 
     static constexpr int standard_cost = 10;
+
+    bool operator==( const overmap_path_params &rhs ) const {
+        return road_cost == rhs.road_cost && field_cost == rhs.field_cost &&
+               dirt_road_cost == rhs.dirt_road_cost && trail_cost == rhs.trail_cost &&
+               forest_cost == rhs.forest_cost && small_building_cost == rhs.small_building_cost &&
+               shore_cost == rhs.shore_cost && swamp_cost == rhs.swamp_cost &&
+               water_cost == rhs.water_cost && air_cost == rhs.air_cost && other_cost == rhs.other_cost &&
+               avoid_danger == rhs.avoid_danger && only_known_by_player == rhs.only_known_by_player;
+    }
+
     static overmap_path_params for_player();
     static overmap_path_params for_npc();
     static overmap_path_params for_land_vehicle( float offroad_coeff, bool tiny, bool amphibious );
@@ -153,6 +164,8 @@ class overmapbuffer
         overmap &get( const point_abs_om & );
         void save();
         void clear();
+        /** The loaded overmaps, and an estimate of the bytes they hold. */
+        memory_usage memory_use() const;
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
 
         /**
@@ -340,8 +353,23 @@ class overmapbuffer
         bool reveal( const tripoint_abs_omt &center, int radius );
         bool reveal( const tripoint_abs_omt &center, int radius,
                      const std::function<bool( const oter_id & )> &filter );
+        /**
+         * Cheapest path from src to dest for @p params, dest first. Recent paths are
+         * remembered until @ref invalidate_travel_paths, and a path is also reused for
+         * any of its points asking for the same destination.
+         */
         std::vector<tripoint_abs_omt> get_travel_path(
             const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params );
+        /** Forgets the paths remembered by @ref get_travel_path. Call when any OMT it
+         * may have routed through changed terrain, visibility or danger. */
+        void invalidate_travel_paths();
+        /**
+         * Increases whenever the look of an OMT may have changed: its terrain, whether it
+         * was seen or explored, or its note. Caches of that compare it to know they are stale.
+         */
+        int look_revision() const {
+            return look_revision_;
+        }
         bool reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                            int radius = 0, bool road_only = false );
         /**
@@ -382,6 +410,13 @@ class overmapbuffer
          * (x,y) are global overmap coordinates (same as @ref get).
          */
         overmap *get_existing( const point_abs_om &p );
+        /**
+         * Loads or generates one of the eight overmaps around center that is not in the
+         * buffer yet.  Generating takes a while, so this is meant for times nobody is waiting
+         * on the screen.
+         * @returns whether there was an overmap left to prepare.
+         */
+        bool prepare_neighbor( const point_abs_om &center );
         /**
          * Returns whether or not the location has been generated (e.g. mapgen has run).
          * @param loc is in world-global omt coordinates.
@@ -523,6 +558,15 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        /**
+         * Findable locations at a square distance in [min_dist, max_dist] from origin, on its
+         * z-level only unless @p all_z, looked up in the terrain index of each overmap in
+         * range. With @p closest_only, only the closest of them, and overmaps farther away
+         * than those are not looked at. Returns nullopt if one of the terrains is too common
+         * to be indexed; scanning outwards finds those quickly anyway.
+         */
+        cata::optional<std::vector<tripoint_abs_omt>> find_indexed( const tripoint_abs_omt &origin,
+                int min_dist, int max_dist, bool all_z, const omt_find_params &params, bool closest_only );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -533,6 +577,30 @@ class overmapbuffer
         // Cached result of previous call to overmapbuffer::get_existing
         overmap mutable *last_requested_overmap;
 
+        struct travel_path {
+            tripoint_abs_omt src;
+            tripoint_abs_omt dest;
+            overmap_path_params params;
+            std::vector<tripoint_abs_omt> points;
+        };
+        // Paths found by get_travel_path, most recently used first.
+        std::vector<travel_path> travel_paths;
+        int look_revision_ = 0;
+
+        struct oter_travel_cost {
+            bool known = false;
+            int cost = -1;
+            bool ramp = false;
+        };
+        // Travel costs of every oter_id (by index) for one overmap_path_params, filled in
+        // as get_travel_path comes across them.
+        struct travel_cost_table {
+            overmap_path_params params;
+            std::vector<oter_travel_cost> costs;
+        };
+        std::vector<travel_cost_table> travel_cost_tables;
+        const oter_travel_cost &travel_cost( const oter_id &oter, travel_cost_table &table );
+
         /**
          * Get a list of notes in the (loaded) overmaps.
          * @param z only this specific z-level is search for notes.
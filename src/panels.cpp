@@ -1,6 +1,7 @@
 #include "panels.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
@@ -47,6 +48,7 @@
 #include "overmap.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
+#include "perf_stats.h"
 #include "pimpl.h"
 #include "point.h"
 #include "string_formatter.h"
@@ -2401,8 +2403,9 @@ static void draw_mod_sidebar( avatar &u, const catacurses::window &w, const std:
     int row_num = 0;
     for( const widget_id &row_wid : root._widgets ) {
         widget row_widget = row_wid.obj();
+        // Widget values are kept until their inputs may have changed.
         trim_and_print( w, point( 1, row_num ), width - 1, c_light_gray, _( row_widget.layout( u,
-                        width - 1 ) ) );
+                        width - 1, true ) ) );
         row_num++;
     }
 
@@ -2467,6 +2470,39 @@ static void draw_ai_goal( const avatar &u, const catacurses::window &w )
     wnoutrefresh( w );
 }
 
+static void draw_timings_row( const catacurses::window &w, const int y, const std::string &name,
+                              const perf_stats::stage_summary &s,
+                              const perf_stats::histogram &hist )
+{
+    static const std::array<std::string, 9> bars = {{
+            " ", "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"
+        }
+    };
+    const int most = *std::max_element( hist.begin(), hist.end() );
+    std::string spark;
+    for( const int count : hist ) {
+        spark += bars[most == 0 ? 0 : ( count * 8 + most - 1 ) / most];
+    }
+    mvwprintz( w, point( 0, y ), c_light_gray, "%-7s %6.1f %6.1f", name, s.p50 / 1000,
+               s.p99 / 1000 );
+    mvwprintz( w, point( 22, y ), c_white, spark );
+}
+
+// The rolling windows of perf_stats, with a spark line of the histogram of each.
+static void draw_timings( const avatar &, const catacurses::window &w )
+{
+    werase( w );
+    mvwprintz( w, point_zero, c_light_gray, "%-7s %6s %6s %s", _( "ms" ), "p50", "p99",
+               "<1 … 64+" );
+    draw_timings_row( w, 1, _( "frame" ), perf_stats::summarize( frame_stat::render ),
+                      perf_stats::get_histogram( frame_stat::render ) );
+    draw_timings_row( w, 2, _( "input" ), perf_stats::summarize( frame_stat::input_latency ),
+                      perf_stats::get_histogram( frame_stat::input_latency ) );
+    draw_timings_row( w, 3, _( "turn" ), perf_stats::summarize( perf_stage::do_turn ),
+                      perf_stats::get_histogram( perf_stage::do_turn ) );
+    wnoutrefresh( w );
+}
+
 static void draw_location_classic( const avatar &u, const catacurses::window &w )
 {
     werase( w );
@@ -2739,6 +2775,8 @@ static std::vector<window_panel> initialize_default_classic_panels()
 #endif // TILES
     ret.emplace_back( window_panel( draw_ai_goal, "AI Needs", to_translation( "AI Needs" ),
                                     1, 44, false ) );
+    ret.emplace_back( window_panel( draw_timings, "Timings", to_translation( "Timings" ),
+                                    4, 44, false ) );
     return ret;
 }
 
@@ -2783,6 +2821,8 @@ static std::vector<window_panel> initialize_default_compact_panels()
 #endif // TILES
     ret.emplace_back( window_panel( draw_ai_goal, "AI Needs", to_translation( "AI Needs" ),
                                     1, 32, false ) );
+    ret.emplace_back( window_panel( draw_timings, "Timings", to_translation( "Timings" ),
+                                    4, 32, false ) );
 
     return ret;
 }
@@ -2836,6 +2876,8 @@ static std::vector<window_panel> initialize_default_label_narrow_panels()
 #endif // TILES
     ret.emplace_back( window_panel( draw_ai_goal, "AI Needs", to_translation( "AI Needs" ),
                                     1, 32, false ) );
+    ret.emplace_back( window_panel( draw_timings, "Timings", to_translation( "Timings" ),
+                                    4, 32, false ) );
 
     return ret;
 }
@@ -2893,6 +2935,8 @@ static std::vector<window_panel> initialize_default_label_panels()
 #endif // TILES
     ret.emplace_back( window_panel( draw_ai_goal, "AI Needs", to_translation( "AI Needs" ),
                                     1, 44, false ) );
+    ret.emplace_back( window_panel( draw_timings, "Timings", to_translation( "Timings" ),
+                                    4, 44, false ) );
 
     return ret;
 }
@@ -2,13 +2,17 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <queue>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "cata_utility.h"
 #include "coordinates.h"
 #include "debug.h"
@@ -18,6 +22,7 @@
 #include "optional.h"
 #include "point.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "trap.h"
 #include "type_id.h"
 #include "veh_type.h"
@@ -37,34 +42,78 @@ static constexpr int flat_index( const point &p )
 }
 
 // Flattened 2D array representing a single z-level worth of pathfinding data
+// Layers are kept from one search to the next. A cell takes part in the current search only if
+// its tag is one of the two tags of that search, so nothing has to be cleared in between.
 struct path_data_layer {
-    // State is accessed way more often than all other values here
-    std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
+    // Tag is accessed way more often than all other values here
+    std::array< uint32_t, MAPSIZE_X *MAPSIZE_Y > tag;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
+    // Tag of open cells in the current search, closed cells have open_tag + 1.
+    // Tags 0 and 1 are never used by a search, so 0 always means unvisited.
+    uint32_t open_tag = 2;
 
-    void init( const point &min, const point &max ) {
-        for( int x = min.x; x <= max.x; x++ ) {
-            for( int y = min.y; y <= max.y; y++ ) {
-                const int ind = flat_index( point( x, y ) );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    path_data_layer() {
+        tag.fill( 0 );
+    }
+
+    void next_search() {
+        open_tag += 2;
+        if( open_tag == 0 ) {
+            // Wrapped around, old tags could come back.
+            tag.fill( 0 );
+            open_tag = 2;
+        }
+    }
+
+    astar_state state( const int index ) const {
+        if( tag[index] == open_tag ) {
+            return ASL_OPEN;
         }
+        if( tag[index] == open_tag + 1 ) {
+            return ASL_CLOSED;
+        }
+        return ASL_NONE;
+    }
+
+    void set_state( const int index, const astar_state new_state ) {
+        if( state( index ) == ASL_NONE ) {
+            gscore[index] = 0;
+            score[index] = 0;
+        }
+        tag[index] = new_state == ASL_OPEN ? open_tag : new_state == ASL_CLOSED ? open_tag + 1 : 0;
+    }
+
+    // Scores as a zeroed layer would have them, 0 where this search hasn't been yet.
+    int gscore_at( const int index ) const {
+        return state( index ) == ASL_NONE ? 0 : gscore[index];
+    }
+    int score_at( const int index ) const {
+        return state( index ) == ASL_NONE ? 0 : score[index];
     }
 };
 
 struct pathfinder {
     point min;
     point max;
-    pathfinder( const point &_min, const point &_max ) :
-        min( _min ), max( _max ) {
-    }
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
+    // Binary heap ordered by pair_greater_cmp_first, kept as a vector so its storage is reused.
+    std::vector< std::pair<int, tripoint> > open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
 
+    // Forgets the previous search, keeping the memory.
+    void start( const point &_min, const point &_max ) {
+        min = _min;
+        max = _max;
+        open.clear();
+        for( std::unique_ptr< path_data_layer > &ptr : path_data ) {
+            if( ptr != nullptr ) {
+                ptr->next_search();
+            }
+        }
+    }
+
     path_data_layer &get_layer( const int z ) {
         std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
         if( ptr != nullptr ) {
@@ -72,7 +121,6 @@ struct pathfinder {
         }
 
         ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
         return *ptr;
     }
 
@@ -81,39 +129,284 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const tripoint pt = open.back().second;
+        open.pop_back();
+        return pt;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to.xy() );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state state = layer.state( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) || state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        layer.set_state( index, ASL_OPEN );
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.push( std::make_pair( score, to ) );
+        open.emplace_back( score, to );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
     }
 
     void close_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p.xy() );
-        layer.state[index] = ASL_CLOSED;
+        layer.set_state( index, ASL_CLOSED );
     }
 
     void unclose_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p.xy() );
-        layer.state[index] = ASL_NONE;
+        layer.set_state( index, ASL_NONE );
     }
 };
 
+// Takes a pathfinder from a per-thread pool and gives it back when done, so that a route
+// doesn't begin by allocating and clearing several hundred KB of search state.
+class pooled_pathfinder
+{
+    public:
+        pooled_pathfinder( const point &min, const point &max ) {
+            std::vector< std::unique_ptr< pathfinder > > &free = pool();
+            if( free.empty() ) {
+                pf = std::make_unique<pathfinder>();
+            } else {
+                pf = std::move( free.back() );
+                free.pop_back();
+            }
+            pf->start( min, max );
+        }
+        ~pooled_pathfinder() {
+            pool().push_back( std::move( pf ) );
+        }
+
+        pooled_pathfinder( const pooled_pathfinder & ) = delete;
+        pooled_pathfinder &operator=( const pooled_pathfinder & ) = delete;
+
+        pathfinder &operator*() {
+            return *pf;
+        }
+
+    private:
+        static std::vector< std::unique_ptr< pathfinder > > &pool() {
+            thread_local std::vector< std::unique_ptr< pathfinder > > free;
+            return free;
+        }
+
+        std::unique_ptr< pathfinder > pf;
+};
+
+static const pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+
+// Routes longer than this are first planned over the submap cluster graph.
+static constexpr int cluster_route_min_dist = 2 * SEEX;
+
+struct pathfinding_clusters {
+    struct cluster {
+        // Tiles of this submap from which one can step into a neighbouring submap.
+        std::vector<point> nodes;
+        // For each node, the tiles of neighbouring submaps it steps on to.
+        std::vector< std::vector<point> > across;
+        // Cost of walking from node i to node j without leaving the submap, at
+        // costs[i * nodes.size() + j], or -1 if that can't be done.
+        std::vector<int> costs;
+    };
+    // Entrances across the east and the south edge of each submap, as (this side, other side).
+    std::array< std::vector< std::pair<point, point> >, MAPSIZE *MAPSIZE > east;
+    std::array< std::vector< std::pair<point, point> >, MAPSIZE *MAPSIZE > south;
+    std::array< cluster, MAPSIZE *MAPSIZE > clusters;
+};
+
+pathfinding_cache::pathfinding_cache()
+{
+    dirty = true;
+    std::uninitialized_fill_n( &special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    cluster_dirty.set();
+}
+
+pathfinding_cache::~pathfinding_cache() = default;
+
+static int cluster_index( const point &p )
+{
+    return p.x / SEEX * MAPSIZE + p.y / SEEY;
+}
+
+// Index of a tile within its submap.
+static int cluster_tile_index( const point &p )
+{
+    return p.x % SEEX * SEEY + p.y % SEEY;
+}
+
+static bool cluster_walkable( const pathfinding_cache &cache, const point &p )
+{
+    return pf_cluster_step_cost( cache.special[p.x][p.y] ) > 0;
+}
+
+// Costs of walking from `from` to every tile of its submap without leaving it, -1 where it
+// can't be done. With `reverse`, costs of walking from every tile to `from` instead.
+static std::array<int, SEEX *SEEY> cluster_distances( const pathfinding_cache &cache,
+        const point &from, const bool reverse )
+{
+    std::array<int, SEEX *SEEY> dist;
+    dist.fill( -1 );
+    const point origin( from.x / SEEX * SEEX, from.y / SEEY * SEEY );
+    std::priority_queue< std::pair<int, point>, std::vector< std::pair<int, point> >, pair_greater_cmp_first >
+    open;
+    dist[cluster_tile_index( from )] = 0;
+    open.emplace( 0, from );
+    while( !open.empty() ) {
+        const std::pair<int, point> top = open.top();
+        open.pop();
+        const point &cur = top.second;
+        if( top.first > dist[cluster_tile_index( cur )] ) {
+            continue;
+        }
+        const int leave_cost = pf_cluster_step_cost( cache.special[cur.x][cur.y] );
+        for( const tripoint &offset : eight_horizontal_neighbors ) {
+            const point p = cur + offset.xy();
+            if( p.x < origin.x || p.x >= origin.x + SEEX || p.y < origin.y || p.y >= origin.y + SEEY ) {
+                continue;
+            }
+            const int enter_cost = pf_cluster_step_cost( cache.special[p.x][p.y] );
+            if( enter_cost == 0 ) {
+                continue;
+            }
+            // Penalize diagonals the same way route_tiles does
+            const int d = top.first + ( reverse ? leave_cost : enter_cost ) +
+                          ( offset.x != 0 && offset.y != 0 ? 1 : 0 );
+            int &best = dist[cluster_tile_index( p )];
+            if( best < 0 || d < best ) {
+                best = d;
+                open.emplace( d, p );
+            }
+        }
+    }
+    return dist;
+}
+
+// One entrance in the middle of every run of tiles along a submap edge that are walkable on both
+// sides. `start` is the first tile on this side, `along` steps along the edge and `across` steps
+// over it.
+static void find_cluster_entrances( const pathfinding_cache &cache, const point &start,
+                                    const point &along, const point &across, const int length,
+                                    std::vector< std::pair<point, point> > &entrances )
+{
+    entrances.clear();
+    int run_start = -1;
+    for( int i = 0; i <= length; ++i ) {
+        const point p = start + along * i;
+        const bool open = i < length && cluster_walkable( cache, p ) &&
+                          cluster_walkable( cache, p + across );
+        if( open && run_start < 0 ) {
+            run_start = i;
+        } else if( !open && run_start >= 0 ) {
+            const point middle = start + along * ( ( run_start + i - 1 ) / 2 );
+            entrances.emplace_back( middle, middle + across );
+            run_start = -1;
+        }
+    }
+}
+
+// Brings the cluster graph up to date with cache.special, redoing only the submaps marked in
+// cache.cluster_dirty and the neighbours that share an edge with them.
+static void update_clusters( pathfinding_cache &cache, const int map_size )
+{
+    if( !cache.clusters ) {
+        cache.clusters = std::make_unique<pathfinding_clusters>();
+        cache.cluster_dirty.set();
+    }
+    if( cache.cluster_dirty.none() ) {
+        return;
+    }
+    pathfinding_clusters &graph = *cache.clusters;
+
+    std::bitset<MAPSIZE *MAPSIZE> rebuild;
+    for( int cx = 0; cx < map_size; ++cx ) {
+        for( int cy = 0; cy < map_size; ++cy ) {
+            const int c = cx * MAPSIZE + cy;
+            if( !cache.cluster_dirty[c] ) {
+                continue;
+            }
+            rebuild.set( c );
+            const point corner( cx * SEEX, cy * SEEY );
+            if( cx + 1 < map_size ) {
+                find_cluster_entrances( cache, corner + point( SEEX - 1, 0 ), point_south, point_east, SEEY,
+                                        graph.east[c] );
+                rebuild.set( c + MAPSIZE );
+            }
+            if( cx > 0 ) {
+                find_cluster_entrances( cache, corner + point_west, point_south, point_east, SEEY,
+                                        graph.east[c - MAPSIZE] );
+                rebuild.set( c - MAPSIZE );
+            }
+            if( cy + 1 < map_size ) {
+                find_cluster_entrances( cache, corner + point( 0, SEEY - 1 ), point_east, point_south, SEEX,
+                                        graph.south[c] );
+                rebuild.set( c + 1 );
+            }
+            if( cy > 0 ) {
+                find_cluster_entrances( cache, corner + point_north, point_east, point_south, SEEX,
+                                        graph.south[c - 1] );
+                rebuild.set( c - 1 );
+            }
+        }
+    }
+
+    for( int cx = 0; cx < map_size; ++cx ) {
+        for( int cy = 0; cy < map_size; ++cy ) {
+            const int c = cx * MAPSIZE + cy;
+            if( !rebuild[c] ) {
+                continue;
+            }
+            pathfinding_clusters::cluster &cl = graph.clusters[c];
+            cl.nodes.clear();
+            cl.across.clear();
+            const auto add = [&cl]( const point & node, const point & other ) {
+                const auto it = std::find( cl.nodes.begin(), cl.nodes.end(), node );
+                const size_t i = it - cl.nodes.begin();
+                if( it == cl.nodes.end() ) {
+                    cl.nodes.push_back( node );
+                    cl.across.emplace_back();
+                }
+                cl.across[i].push_back( other );
+            };
+            if( cx + 1 < map_size ) {
+                for( const std::pair<point, point> &e : graph.east[c] ) {
+                    add( e.first, e.second );
+                }
+            }
+            if( cx > 0 ) {
+                for( const std::pair<point, point> &e : graph.east[c - MAPSIZE] ) {
+                    add( e.second, e.first );
+                }
+            }
+            if( cy + 1 < map_size ) {
+                for( const std::pair<point, point> &e : graph.south[c] ) {
+                    add( e.first, e.second );
+                }
+            }
+            if( cy > 0 ) {
+                for( const std::pair<point, point> &e : graph.south[c - 1] ) {
+                    add( e.second, e.first );
+                }
+            }
+
+            const size_t n = cl.nodes.size();
+            cl.costs.assign( n * n, -1 );
+            for( size_t i = 0; i < n; ++i ) {
+                const std::array<int, SEEX *SEEY> dist = cluster_distances( cache, cl.nodes[i], false );
+                for( size_t j = 0; j < n; ++j ) {
+                    cl.costs[i * n + j] = dist[cluster_tile_index( cl.nodes[j] )];
+                }
+            }
+        }
+    }
+    cache.cluster_dirty.reset();
+}
+
 // Modifies `t` to point to a tile with `flag` in a 1-submap radius of `t`'s original value,
 // searching nearest points first (starting with `t` itself).
 // return false if it could not find a suitable point
@@ -163,6 +456,28 @@ static bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+// The straight line from f to t if it runs on flat ground only, else an empty route.
+// Not if the line contains a pre-closed tile - we need to do regular pathing then
+static std::vector<tripoint> straight_route( const map &m, const tripoint &f, const tripoint &t,
+        const std::set<tripoint> &pre_closed )
+{
+    if( f.z == t.z ) {
+        auto line_path = line_to( f, t );
+        const auto &pf_cache = m.get_pathfinding_cache_ref( f.z );
+        // Check all points for any special case (including just hard terrain)
+        if( std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
+        return !( pf_cache.special[p.x][p.y] & non_normal );
+        } ) ) {
+            const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
+
+            if( is_disjoint( sorted_line, pre_closed ) ) {
+                return line_path;
+            }
+        }
+    }
+    return std::vector<tripoint>();
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -182,35 +497,672 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return route( f, clipped, settings, pre_closed );
     }
     // First, check for a simple straight line on flat ground
-    // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
-    if( f.z == t.z ) {
-        const auto line_path = line_to( f, t );
-        const auto &pf_cache = get_pathfinding_cache_ref( f.z );
-        // Check all points for any special case (including just hard terrain)
-        if( std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
-        return !( pf_cache.special[p.x][p.y] & non_normal );
-        } ) ) {
-            const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
+    ret = straight_route( *this, f, t, pre_closed );
+    if( !ret.empty() ) {
+        return ret;
+    }
 
-            if( is_disjoint( sorted_line, pre_closed ) ) {
-                return line_path;
+    // If expected path length is greater than max distance, allow only line path, like above
+    if( rl_dist( f, t ) > settings.max_dist ) {
+        return ret;
+    }
+
+    if( f.z == t.z && rl_dist( f, t ) > cluster_route_min_dist ) {
+        ret = route_clusters( f, t, settings, pre_closed );
+        if( !ret.empty() ) {
+            return ret;
+        }
+    }
+    return route_tiles( f, t, settings, pre_closed );
+}
+
+// A goal that moved farther than this from the end of a route is planned for from scratch.
+static constexpr int max_goal_extension = 4;
+// Tiles of the old route kept clear on either side of a blocked step when planning around it.
+static constexpr int repair_margin = 3;
+static constexpr int max_repairs = 4;
+
+// Cuts out the loops from a route starting at f, e.g. where an extension to a goal that moved
+// back towards us walks over the old route again.
+static void remove_route_loops( const tripoint &f, std::vector<tripoint> &route )
+{
+    std::unordered_map<tripoint, size_t> kept;
+    kept.emplace( f, 0 );
+    std::vector<tripoint> result;
+    for( const tripoint &p : route ) {
+        const auto found = kept.find( p );
+        if( found != kept.end() ) {
+            // Back to where we were after found->second steps
+            const size_t steps = found->second;
+            for( size_t i = steps; i < result.size(); ++i ) {
+                kept.erase( result[i] );
             }
+            result.resize( steps );
+            continue;
         }
+        result.push_back( p );
+        kept.emplace( p, result.size() );
     }
+    route = std::move( result );
+}
 
-    // If expected path length is greater than max distance, allow only line path, like above
-    if( rl_dist( f, t ) > settings.max_dist ) {
+std::vector<tripoint> map::repair_route( const tripoint &f, const std::vector<tripoint> &old_route,
+        const tripoint &t, const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed ) const
+{
+    std::vector<tripoint> ret( std::find_if( old_route.begin(), old_route.end(),
+    [&f]( const tripoint & p ) {
+        return p != f;
+    } ), old_route.end() );
+    if( ret.empty() || f == t || !inbounds( f ) || !inbounds( t ) || square_dist( f, ret.front() ) > 1 ) {
+        return std::vector<tripoint>();
+    }
+
+    const auto on_route = std::find( ret.begin(), ret.end(), t );
+    if( on_route != ret.end() ) {
+        // The goal came towards us
+        ret.erase( on_route + 1, ret.end() );
+    } else {
+        const tripoint old_goal = ret.back();
+        if( old_goal.z != t.z || square_dist( old_goal, t ) > max_goal_extension ) {
+            return std::vector<tripoint>();
+        }
+        const std::vector<tripoint> extension = route_tiles( old_goal, t, settings, pre_closed );
+        if( extension.empty() ) {
+            return std::vector<tripoint>();
+        }
+        ret.insert( ret.end(), extension.begin(), extension.end() );
+    }
+
+    // Check every step against the map as it is now.
+    int repairs = 0;
+    for( size_t i = 0; i < ret.size(); ++i ) {
+        const tripoint &prev = i == 0 ? f : ret[i - 1];
+        const tripoint &p = ret[i];
+        if( prev.z != p.z ) {
+            continue;
+        }
+        const pf_step step = route_step( prev, p, get_pathfinding_cache_ref( p.z ).special[p.x][p.y],
+                                         settings );
+        const bool blocked = step.cost < 0 || step.drop || ( p != t && pre_closed.count( p ) );
+        if( !blocked ) {
+            continue;
+        }
+        if( p == t || ++repairs > max_repairs ) {
+            return std::vector<tripoint>();
+        }
+        // Walk around it, from a few steps before to a few steps after
+        const int from_index = static_cast<int>( i ) - 1 - repair_margin;
+        const size_t to_index = std::min( i + repair_margin, ret.size() - 1 );
+        const tripoint from = from_index < 0 ? f : ret[from_index];
+        const std::vector<tripoint> detour = route_tiles( from, ret[to_index], settings, pre_closed );
+        if( detour.empty() ) {
+            return std::vector<tripoint>();
+        }
+        const size_t kept = std::max( from_index + 1, 0 );
+        ret.erase( ret.begin() + kept, ret.begin() + to_index + 1 );
+        ret.insert( ret.begin() + kept, detour.begin(), detour.end() );
+        // The detour is fresh, go on checking after it
+        i = kept + detour.size() - 1;
+    }
+
+    remove_route_loops( f, ret );
+    return ret;
+}
+
+// A field is only flooded for goals asked for this often in one turn, a single route is cheaper.
+static constexpr int flow_field_min_requests = 2;
+static constexpr size_t max_flow_fields = 4;
+// Margin around the goal on top of max_dist, so a field covers every box route_tiles would search.
+static constexpr int flow_field_pad = 16;
+
+void map::flood_flow_field( pathfinding_flow_field &field ) const
+{
+    field.cost.fill( -1 );
+    const tripoint &goal = field.goal;
+    const pathfinding_settings &settings = field.settings;
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( goal.z );
+    const int reach = settings.max_dist + flow_field_pad;
+    point min( goal.x - reach, goal.y - reach );
+    point max( goal.x + reach, goal.y + reach );
+    clip_to_bounds( min.x, min.y );
+    clip_to_bounds( max.x, max.y );
+
+    // Dijkstra outwards from the goal, over the steps into each settled tile.
+    std::priority_queue< std::pair<int, point>, std::vector< std::pair<int, point> >, pair_greater_cmp_first >
+    open;
+    field.cost[flat_index( goal.xy() )] = 0;
+    open.emplace( 0, goal.xy() );
+    while( !open.empty() ) {
+        const std::pair<int, point> top = open.top();
+        open.pop();
+        const point &to = top.second;
+        if( top.first > field.cost[flat_index( to )] || top.first > settings.max_length ) {
+            continue;
+        }
+        const tripoint to3( to, goal.z );
+        const pf_special to_special = pf_cache.special[to.x][to.y];
+        for( size_t dir = 0; dir < eight_horizontal_neighbors.size(); ++dir ) {
+            const point &offset = eight_horizontal_neighbors[dir].xy();
+            const point from = to - offset;
+            if( from.x < min.x || from.x > max.x || from.y < min.y || from.y > max.y ) {
+                continue;
+            }
+            const pf_step step = route_step( tripoint( from, goal.z ), to3, to_special, settings );
+            if( step.close ) {
+                // Not from any other side either
+                break;
+            }
+            if( step.cost < 0 || step.drop ) {
+                continue;
+            }
+            // Penalize for diagonals the same way route_tiles does
+            const int cost = top.first + step.cost + ( offset.x != 0 && offset.y != 0 ? 1 : 0 );
+            const int index = flat_index( from );
+            if( field.cost[index] < 0 || cost < field.cost[index] ) {
+                field.cost[index] = cost;
+                field.next[index] = static_cast<uint8_t>( dir );
+                open.emplace( cost, from );
+            }
+        }
+    }
+}
+
+static void start_flow_field_turn( pathfinding_flow_fields &shared, const int turn )
+{
+    if( shared.turn != turn ) {
+        shared.turn = turn;
+        shared.requests.clear();
+        shared.solved.clear();
+    }
+}
+
+// Walks down @p field from f to its goal. False if f can't reach the goal at all, and an
+// empty route if it can't within max_length.
+static bool follow_flow_field( const pathfinding_flow_field &field, const tripoint &f,
+                               std::vector<tripoint> &ret )
+{
+    const int cost = field.cost[flat_index( f.xy() )];
+    if( cost < 0 ) {
+        return false;
+    }
+    if( cost > field.settings.max_length ) {
+        return true;
+    }
+    for( tripoint cur = f; cur != field.goal; ) {
+        cur += eight_horizontal_neighbors[field.next[flat_index( cur.xy() )]];
+        ret.push_back( cur );
+    }
+    return true;
+}
+
+std::vector<tripoint> map::route_shared( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed ) const
+{
+    if( !pre_closed.empty() || f == t || f.z != t.z || !inbounds( f ) || !inbounds( t ) ) {
+        return route( f, t, settings, pre_closed );
+    }
+    std::vector<tripoint> ret = straight_route( *this, f, t, pre_closed );
+    if( !ret.empty() || rl_dist( f, t ) > settings.max_dist ) {
         return ret;
     }
 
+    if( !flow_fields ) {
+        flow_fields = std::make_unique<pathfinding_flow_fields>();
+    }
+    pathfinding_flow_fields &shared = *flow_fields;
+    const int turn = to_turn<int>( calendar::turn );
+    const int generation = get_pathfinding_cache_ref( t.z ).generation;
+    start_flow_field_turn( shared, turn );
+
+    auto solved = std::find_if( shared.solved.begin(), shared.solved.end(),
+    [&]( const route_request & r ) {
+        return r.from == f && r.to == t && r.settings == settings;
+    } );
+    if( solved != shared.solved.end() ) {
+        const bool current = solved->generation == generation;
+        if( current ) {
+            ret = std::move( solved->route );
+        }
+        std::swap( *solved, shared.solved.back() );
+        shared.solved.pop_back();
+        if( current ) {
+            return ret;
+        }
+    }
+
+    auto found = std::find_if( shared.fields.begin(), shared.fields.end(),
+    [&]( const std::unique_ptr<pathfinding_flow_field> &field ) {
+        return field->turn == turn && field->generation == generation && field->goal == t &&
+               field->settings == settings;
+    } );
+    if( found == shared.fields.end() ) {
+        auto request = std::find_if( shared.requests.begin(), shared.requests.end(),
+        [&]( const pathfinding_flow_fields::request & r ) {
+            return r.goal == t && r.settings == settings;
+        } );
+        if( request == shared.requests.end() ) {
+            shared.requests.push_back( { t, settings, 1 } );
+            return route( f, t, settings, pre_closed );
+        }
+        if( ++request->count < flow_field_min_requests ) {
+            return route( f, t, settings, pre_closed );
+        }
+        shared.requests.erase( request );
+
+        std::unique_ptr<pathfinding_flow_field> field;
+        if( shared.fields.size() < max_flow_fields ) {
+            field = std::make_unique<pathfinding_flow_field>();
+        } else {
+            field = std::move( shared.fields.back() );
+            shared.fields.pop_back();
+        }
+        field->goal = t;
+        field->settings = settings;
+        field->turn = turn;
+        field->generation = generation;
+        flood_flow_field( *field );
+        shared.fields.insert( shared.fields.begin(), std::move( field ) );
+    } else {
+        std::rotate( shared.fields.begin(), found, found + 1 );
+    }
+
+    if( !follow_flow_field( *shared.fields.front(), f, ret ) ) {
+        return route( f, t, settings, pre_closed );
+    }
+    return ret;
+}
+
+void map::route_batch( std::vector<route_request> &requests ) const
+{
+    if( requests.empty() ) {
+        return;
+    }
+    // Everything route() may update lazily is brought up to date here, on this thread.
+    // Routes may step one level past the ones they start and end on.
+    int minz = OVERMAP_HEIGHT;
+    int maxz = -OVERMAP_DEPTH;
+    for( const route_request &r : requests ) {
+        minz = std::min( { minz, r.from.z, r.to.z } );
+        maxz = std::max( { maxz, r.from.z, r.to.z } );
+    }
+    minz = std::max( minz - 1, -OVERMAP_DEPTH );
+    maxz = std::min( maxz + 1, OVERMAP_HEIGHT );
+    for( int z = minz; z <= maxz; ++z ) {
+        get_pathfinding_cache_ref( z );
+        update_clusters( get_pathfinding_cache( z ), my_MAPSIZE );
+    }
+
+    // Requests for the same goal with the same settings are solved together.
+    struct goal_group {
+        std::vector<int> members;
+        std::unique_ptr<pathfinding_flow_field> field;
+    };
+    std::vector<goal_group> groups;
+    for( int i = 0; i < static_cast<int>( requests.size() ); ++i ) {
+        const route_request &r = requests[i];
+        auto group = std::find_if( groups.begin(), groups.end(), [&]( const goal_group & g ) {
+            const route_request &first = requests[g.members.front()];
+            return first.to == r.to && first.settings == r.settings;
+        } );
+        if( group == groups.end() ) {
+            groups.emplace_back();
+            group = groups.end() - 1;
+        }
+        group->members.push_back( i );
+    }
+
+    const int turn = to_turn<int>( calendar::turn );
+    get_thread_pool().parallel_for( 0, static_cast<int>( groups.size() ), [&]( const int g ) {
+        goal_group &group = groups[g];
+        const tripoint &t = requests[group.members.front()].to;
+        const pathfinding_settings &settings = requests[group.members.front()].settings;
+        const bool shared = group.members.size() >= static_cast<size_t>( flow_field_min_requests ) &&
+                            inbounds( t );
+        for( const int i : group.members ) {
+            route_request &r = requests[i];
+            r.generation = get_pathfinding_cache_ref( r.from.z ).generation;
+            r.route.clear();
+            if( !shared || r.from == t || r.from.z != t.z || !inbounds( r.from ) ) {
+                r.route = route( r.from, t, settings );
+                continue;
+            }
+            r.route = straight_route( *this, r.from, t, {} );
+            if( !r.route.empty() || rl_dist( r.from, t ) > settings.max_dist ) {
+                continue;
+            }
+            if( !group.field ) {
+                group.field = std::make_unique<pathfinding_flow_field>();
+                group.field->goal = t;
+                group.field->settings = settings;
+                group.field->turn = turn;
+                group.field->generation = r.generation;
+                flood_flow_field( *group.field );
+            }
+            if( !follow_flow_field( *group.field, r.from, r.route ) ) {
+                r.route = route( r.from, t, settings );
+            }
+        }
+    } );
+
+    if( !flow_fields ) {
+        flow_fields = std::make_unique<pathfinding_flow_fields>();
+    }
+    pathfinding_flow_fields &shared = *flow_fields;
+    start_flow_field_turn( shared, turn );
+    for( goal_group &group : groups ) {
+        if( group.field ) {
+            shared.fields.insert( shared.fields.begin(), std::move( group.field ) );
+        }
+    }
+    if( shared.fields.size() > max_flow_fields ) {
+        shared.fields.resize( max_flow_fields );
+    }
+    shared.solved.insert( shared.solved.end(), requests.begin(), requests.end() );
+}
+
+std::vector<tripoint> map::route_clusters( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings,
+        const std::set<tripoint> &pre_closed ) const
+{
+    // Brings special up to date first.
+    get_pathfinding_cache_ref( f.z );
+    pathfinding_cache &cache = get_pathfinding_cache( f.z );
+    update_clusters( cache, my_MAPSIZE );
+    const pathfinding_clusters &graph = *cache.clusters;
+
+    const point from = f.xy();
+    const point to = t.xy();
+    const int goal_cluster = cluster_index( to );
+    const std::array<int, SEEX *SEEY> from_start = cluster_distances( cache, from, false );
+    const std::array<int, SEEX *SEEY> to_goal = cluster_distances( cache, to, true );
+
+    // A* over the entrance tiles, with `from` and `to` linked to the entrances of their submaps.
+    std::unordered_map< point, std::pair<int, point> > best;
+    std::priority_queue< std::pair<int, point>, std::vector< std::pair<int, point> >, pair_greater_cmp_first >
+    open;
+    const auto reach = [&]( const point & p, const int cost, const point & prev ) {
+        const auto it = best.find( p );
+        if( cost > settings.max_length || ( it != best.end() && it->second.first <= cost ) ) {
+            return;
+        }
+        best[p] = std::make_pair( cost, prev );
+        open.emplace( cost + 2 * rl_dist( p, to ), p );
+    };
+    best[from] = std::make_pair( 0, from );
+    const pathfinding_clusters::cluster &start = graph.clusters[cluster_index( from )];
+    for( const point &node : start.nodes ) {
+        const int cost = from_start[cluster_tile_index( node )];
+        if( cost >= 0 ) {
+            reach( node, cost, from );
+        }
+    }
+
+    bool found = false;
+    while( !open.empty() ) {
+        const std::pair<int, point> top = open.top();
+        open.pop();
+        const point cur = top.second;
+        const int cost = best[cur].first;
+        if( top.first != cost + 2 * rl_dist( cur, to ) ) {
+            // Reached more cheaply since
+            continue;
+        }
+        if( cur == to ) {
+            found = true;
+            break;
+        }
+        const int c = cluster_index( cur );
+        const pathfinding_clusters::cluster &cl = graph.clusters[c];
+        const size_t i = std::find( cl.nodes.begin(), cl.nodes.end(), cur ) - cl.nodes.begin();
+        if( i == cl.nodes.size() ) {
+            continue;
+        }
+        if( c == goal_cluster && to_goal[cluster_tile_index( cur )] >= 0 ) {
+            reach( to, cost + to_goal[cluster_tile_index( cur )], cur );
+        }
+        const size_t n = cl.nodes.size();
+        for( size_t j = 0; j < n; ++j ) {
+            if( j != i && cl.costs[i * n + j] >= 0 ) {
+                reach( cl.nodes[j], cost + cl.costs[i * n + j], cur );
+            }
+        }
+        for( const point &other : cl.across[i] ) {
+            reach( other, cost + pf_cluster_step_cost( cache.special[other.x][other.y] ), cur );
+        }
+    }
+    if( !found ) {
+        return std::vector<tripoint>();
+    }
+
+    std::vector<point> waypoints;
+    for( point p = to; p != from; p = best[p].second ) {
+        waypoints.push_back( p );
+    }
+    std::reverse( waypoints.begin(), waypoints.end() );
+
+    // Refine tile by tile with the real costs, skipping waypoints the next one is close enough
+    // to be reached without.
+    std::vector<tripoint> ret;
+    tripoint cur = f;
+    for( size_t i = 0; i < waypoints.size(); ++i ) {
+        const tripoint waypoint( waypoints[i], f.z );
+        if( waypoint == cur ) {
+            continue;
+        }
+        if( i + 1 < waypoints.size() &&
+            ( pre_closed.count( waypoint ) || rl_dist( cur.xy(), waypoints[i + 1] ) <= cluster_route_min_dist ) ) {
+            continue;
+        }
+        pathfinding_settings segment_settings = settings;
+        segment_settings.max_length -= 2 * static_cast<int>( ret.size() );
+        if( segment_settings.max_length <= 0 ) {
+            return std::vector<tripoint>();
+        }
+        const std::vector<tripoint> segment = route_tiles( cur, waypoint, segment_settings, pre_closed );
+        if( segment.empty() ) {
+            return std::vector<tripoint>();
+        }
+        ret.insert( ret.end(), segment.begin(), segment.end() );
+        cur = waypoint;
+    }
+    return ret;
+}
+
+pf_step map::route_step( const tripoint &cur, const tripoint &p, const pf_special p_special,
+                         const pathfinding_settings &settings ) const
+{
+    pf_step step;
+    // TODO: De-uglify, de-huge-n
+    if( !( p_special & non_normal ) ) {
+        // Boring flat dirt - the most common case above the ground
+        return step;
+    }
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+    const auto closed = [&step]() {
+        step.cost = -1;
+        step.close = true;
+        return step;
+    };
+    const auto skipped = [&step]() {
+        step.cost = -1;
+        return step;
+    };
+
+    if( settings.avoid_rough_terrain ) {
+        // Close all rough terrain tiles
+        return closed();
+    }
+
+    int part = -1;
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const auto &field = tile.get_field();
+    const vehicle *veh = veh_at_internal( p, part );
+
+    const int cost = move_cost_internal( furniture, terrain, field, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
+        climb_cost <= 0 ) {
+        // Close it so that next time we won't try to calculate costs
+        return closed();
+    }
+
+    step.cost = cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            step.cost += climb_cost;
+        } else if( doors && ( terrain.open || furniture.open ) &&
+                   ( !terrain.has_flag( ter_furn_flag::TFLAG_OPENCLOSE_INSIDE ) ||
+                     !furniture.has_flag( ter_furn_flag::TFLAG_OPENCLOSE_INSIDE ) ||
+                     !is_outside( cur ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            step.cost += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            int dummy = -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
+                  veh_at_internal( cur, dummy ) == veh ) ) {
+                // Handle car doors, but don't try to path through curtains
+                step.cost += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->part( part ).hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    return closed();
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                step.cost += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
+                    // Won't be openable, don't try from other sides
+                    return closed();
+                }
+
+                return skipped();
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            step.cost += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            step.cost += 500;
+        } else {
+            // Unbashable and unopenable from here
+            if( !doors || !terrain.open || !furniture.open ) {
+                // Or anywhere else for that matter
+                return closed();
+            }
+
+            return skipped();
+        }
+    }
+
+    if( settings.avoid_traps && ( p_special & PF_TRAP ) ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
+                    // Close p, because we won't be walking on it
+                    closed();
+                    step.drop = true;
+                    return step;
+                }
+            } else {
+                // Otherwise it's walkable
+                step.cost += 500;
+            }
+        }
+    }
+
+    if( settings.avoid_sharp && p_special & PF_SHARP ) {
+        // Avoid sharp things
+        return closed();
+    }
+    return step;
+}
+
+// Jump point search over open ground. A tile is open when it and all of its neighbours are
+// flat, flag-free ground according to the pathfinding cache, so that every step between them
+// costs the same. Routes across such tiles only need to turn at tiles that are not open or
+// where a straight line towards them starts, and the tiles in between are jumped over.
+// Tiles that are not open are expanded the usual way.
+struct jump_area {
+    const pathfinding_cache &cache;
+    // The search box of route_tiles, max exclusive.
+    point min;
+    point max;
+    point target;
+
+    bool open( const point &p ) const {
+        if( p.x <= min.x || p.x >= max.x - 1 || p.y <= min.y || p.y >= max.y - 1 ) {
+            return false;
+        }
+        for( int x = p.x - 1; x <= p.x + 1; ++x ) {
+            for( int y = p.y - 1; y <= p.y + 1; ++y ) {
+                if( cache.special[x][y] != PF_NORMAL ) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // The next tile along dir from the open tile `from` to stop at, if any.
+    cata::optional<point> jump( const point &from, const point &dir ) const {
+        for( point cur = from + dir; ; cur += dir ) {
+            if( cur == target || !open( cur ) ) {
+                return cur;
+            }
+            if( dir.x != 0 && dir.y != 0 &&
+                ( jump( cur, point( dir.x, 0 ) ) || jump( cur, point( 0, dir.y ) ) ) ) {
+                return cur;
+            }
+        }
+    }
+};
+
+// Offsets where the route goes straight or diagonally across tiles a jump skipped.
+static bool is_jump( const tripoint &from, const tripoint &to )
+{
+    const int dx = std::abs( to.x - from.x );
+    const int dy = std::abs( to.y - from.y );
+    return from.z == to.z && std::max( dx, dy ) > 1 && ( dx == 0 || dy == 0 || dx == dy );
+}
+
+static int sign( const int v )
+{
+    return ( v > 0 ) - ( v < 0 );
+}
+
+std::vector<tripoint> map::route_tiles( const tripoint &f, const tripoint &t,
+                                        const pathfinding_settings &settings,
+                                        const std::set<tripoint> &pre_closed ) const
+{
+    std::vector<tripoint> ret;
+
     int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
-    bool sharpavoid = settings.avoid_sharp;
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     tripoint min( std::min( f.x, t.x ) - pad, std::min( f.y, t.y ) - pad, std::min( f.z, t.z ) );
@@ -218,7 +1170,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     clip_to_bounds( min.x, min.y, min.z );
     clip_to_bounds( max.x, max.y, max.z );
 
-    pathfinder pf( min.xy(), max.xy() );
+    pooled_pathfinder pooled_pf( min.xy(), max.xy() );
+    pathfinder &pf = *pooled_pf;
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -239,8 +1192,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur.xy() );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
-        if( cur_state == ASL_CLOSED ) {
+        if( layer.state( parent_index ) == ASL_CLOSED ) {
             continue;
         }
 
@@ -254,11 +1206,44 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             break;
         }
 
-        cur_state = ASL_CLOSED;
+        layer.set_state( parent_index, ASL_CLOSED );
 
         const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
         const pf_special cur_special = pf_cache.special[cur.x][cur.y];
 
+        const jump_area area{ pf_cache, min.xy(), max.xy(), t.z == cur.z ? t.xy() : point_min };
+        if( pre_closed.empty() && area.open( cur.xy() ) ) {
+            // Only continue the way we came, and for diagonals also along both of its axes.
+            const tripoint &parent = layer.parent[parent_index];
+            std::vector<point> directions;
+            if( parent == cur || parent.z != cur.z ) {
+                directions.assign( eight_horizontal_neighbors.size(), point_zero );
+                std::transform( eight_horizontal_neighbors.begin(), eight_horizontal_neighbors.end(),
+                directions.begin(), []( const tripoint & d ) {
+                    return d.xy();
+                } );
+            } else {
+                const point dir( sign( cur.x - parent.x ), sign( cur.y - parent.y ) );
+                directions.push_back( dir );
+                if( dir.x != 0 && dir.y != 0 ) {
+                    directions.emplace_back( dir.x, 0 );
+                    directions.emplace_back( 0, dir.y );
+                }
+            }
+            for( const point &dir : directions ) {
+                const cata::optional<point> jumped = area.jump( cur.xy(), dir );
+                if( !jumped ) {
+                    continue;
+                }
+                const tripoint p( *jumped, cur.z );
+                // 2 per step, and 1 more for diagonals, as in the loop below
+                const int newg = layer.gscore[parent_index] + square_dist( cur.xy(), *jumped ) *
+                                 ( dir.x != 0 && dir.y != 0 ? 3 : 2 );
+                pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
+            }
+            continue;
+        }
+
         // 7 3 5
         // 1 . 2
         // 6 4 8
@@ -273,7 +1258,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( layer.state( index ) == ASL_CLOSED ) {
                 continue;
             }
 
@@ -281,134 +1266,30 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
 
             const pf_special p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
-            if( !( p_special & non_normal ) ) {
-                // Boring flat dirt - the most common case above the ground
-                newg += 2;
-            } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
-                    continue;
-                }
-
-                int part = -1;
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-                const auto &field = tile.get_field();
-                const vehicle *veh = veh_at_internal( p, part );
-
-                const int cost = move_cost_internal( furniture, terrain, field, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
-                    climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
-                    continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( ter_furn_flag::TFLAG_OPENCLOSE_INSIDE ) ||
-                                 !furniture.has_flag( ter_furn_flag::TFLAG_OPENCLOSE_INSIDE ) ||
-                                 !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->part( part ).hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
-
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open || !furniture.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
-                    }
-                }
-
-                if( trapavoid && ( p_special & PF_TRAP ) ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
-                                tripoint below( p.xy(), p.z - 1 );
-                                if( !has_flag( ter_furn_flag::TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
-
-                if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
+            const pf_step step = route_step( cur, p, p_special, settings );
+            if( step.close ) {
+                layer.set_state( index, ASL_CLOSED );
+            }
+            if( step.drop ) {
+                tripoint below( p.xy(), p.z - 1 );
+                if( !has_flag( ter_furn_flag::TFLAG_NO_FLOOR, below ) ) {
+                    // Otherwise this would have been a huge fall
+                    auto &layer = pf.get_layer( p.z - 1 );
+                    // From cur, not p, because we won't be walking on air
+                    pf.add_point( layer.gscore_at( parent_index ) + 10,
+                                  layer.score_at( parent_index ) + 10 + 2 * rl_dist( below, t ),
+                                  cur, below );
                 }
-
+                continue;
             }
+            if( step.cost < 0 ) {
+                continue;
+            }
+            newg += step.cost;
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( layer.state( index ) == ASL_NONE || newg < layer.gscore[index] ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
@@ -425,8 +1306,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.xy(), cur.z - 1 );
             if( vertical_move_destination( *this, ter_furn_flag::TFLAG_GOES_UP, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 2,
+                              layer.score_at( parent_index ) + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -435,8 +1316,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             tripoint dest( cur.xy(), cur.z + 1 );
             if( vertical_move_destination( *this, ter_furn_flag::TFLAG_GOES_DOWN, dest ) ) {
                 auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 2,
+                              layer.score_at( parent_index ) + 2 * rl_dist( dest, t ),
                               cur, dest );
             }
         }
@@ -445,8 +1326,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 4,
+                              layer.score_at( parent_index ) + 4 + 2 * rl_dist( above, t ),
                               cur, above );
             }
         }
@@ -455,8 +1336,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 4,
+                              layer.score_at( parent_index ) + 4 + 2 * rl_dist( above, t ),
                               cur, above );
             }
         }
@@ -465,8 +1346,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             auto &layer = pf.get_layer( cur.z - 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint below( cur.x + x_offset[it], cur.y + y_offset[it], cur.z - 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( below, t ),
+                pf.add_point( layer.gscore_at( parent_index ) + 4,
+                              layer.score_at( parent_index ) + 4 + 2 * rl_dist( below, t ),
                               cur, below );
             }
         }
@@ -486,9 +1367,15 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             }
 
             ret.push_back( cur );
-            // Jumps are acceptable on 1 z-level changes
-            // This is because stairs teleport the player too
-            if( rl_dist( cur, par ) > 1 && std::abs( cur.z - par.z ) != 1 ) {
+            if( is_jump( par, cur ) ) {
+                // The open tiles jump_area skipped over
+                const tripoint step( sign( par.x - cur.x ), sign( par.y - cur.y ), 0 );
+                for( tripoint skipped = cur + step; skipped != par; skipped += step ) {
+                    ret.push_back( skipped );
+                }
+            } else if( rl_dist( cur, par ) > 1 && std::abs( cur.z - par.z ) != 1 ) {
+                // Jumps are acceptable on 1 z-level changes
+                // This is because stairs teleport the player too
                 debugmsg( "Jump in our route!  %d:%d:%d->%d:%d:%d",
                           cur.x, cur.y, cur.z, par.x, par.y, par.z );
                 return ret;
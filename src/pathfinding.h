@@ -2,7 +2,14 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -38,13 +45,45 @@ inline pf_special &operator &= ( pf_special &lhs, pf_special rhs )
     return lhs;
 }
 
+// Cost of stepping onto a tile in the submap cluster graph used for long routes,
+// or 0 if the graph treats the tile as blocked.
+constexpr int pf_cluster_step_cost( const pf_special special )
+{
+    return ( special & PF_WALL ) ? 0 : ( special & PF_SLOW ) ? 4 : 2;
+}
+
+// Entrances between neighbouring submaps and the costs of crossing each submap, see map::route.
+struct pathfinding_clusters;
+
 struct pathfinding_cache {
     pathfinding_cache();
     ~pathfinding_cache();
 
+    // The whole level needs to be rebuilt.
     bool dirty = false;
+    // Tiles to look up again when the level isn't dirty as a whole, also as a set
+    // (x * MAPSIZE_Y + y) to keep the list free of repeats.
+    std::vector<point> dirty_points;
+    std::bitset<MAPSIZE_X *MAPSIZE_Y> dirty_point_set;
+    // Bumped whenever special changes.
+    int generation = 0;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
+
+    // Submaps (x * MAPSIZE + y) where pf_cluster_step_cost of a tile changed since clusters
+    // last looked at them.
+    std::bitset<MAPSIZE *MAPSIZE> cluster_dirty;
+    std::unique_ptr<pathfinding_clusters> clusters;
+};
+
+// Outcome of stepping from one tile onto a neighbouring one in a route search, see map::route_step.
+struct pf_step {
+    // Cost of the step, not counting the diagonal penalty, or -1 if it can't be taken.
+    int cost = 2;
+    // The tile can't be entered from any side either, searches may stop looking at it.
+    bool close = false;
+    // The tile is a trapped ledge, one would drop to the tile below instead of walking on it.
+    bool drop = false;
 };
 
 struct pathfinding_settings {
@@ -72,6 +111,55 @@ struct pathfinding_settings {
           avoid_sharp( as ) {}
 
     pathfinding_settings &operator=( const pathfinding_settings & ) = default;
+
+    bool operator==( const pathfinding_settings &rhs ) const {
+        return bash_strength == rhs.bash_strength && max_dist == rhs.max_dist &&
+               max_length == rhs.max_length && climb_cost == rhs.climb_cost &&
+               allow_open_doors == rhs.allow_open_doors && avoid_traps == rhs.avoid_traps &&
+               allow_climb_stairs == rhs.allow_climb_stairs &&
+               avoid_rough_terrain == rhs.avoid_rough_terrain && avoid_sharp == rhs.avoid_sharp;
+    }
+};
+
+// Costs of walking to one goal from the tiles of its z-level, shared during one turn by
+// everyone heading there with the same settings, see map::route_shared.
+struct pathfinding_flow_field {
+    tripoint goal;
+    pathfinding_settings settings;
+    // Turn and pathfinding_cache::generation of the goal's level the field was flooded for.
+    int turn = 0;
+    int generation = 0;
+
+    // Cost of walking from each tile (x * MAPSIZE_Y + y) to the goal, -1 if it can't be done.
+    std::array<int, MAPSIZE_X *MAPSIZE_Y> cost;
+    // Index into eight_horizontal_neighbors of the next step from each tile.
+    std::array<uint8_t, MAPSIZE_X *MAPSIZE_Y> next;
+};
+
+// A route asked for ahead of the move that needs it, see map::route_batch.
+struct route_request {
+    tripoint from;
+    tripoint to;
+    pathfinding_settings settings;
+    std::vector<tripoint> route;
+    // pathfinding_cache::generation of the level of `from` the route was solved against.
+    int generation = 0;
+};
+
+struct pathfinding_flow_fields {
+    // Turn the requests and routes below belong to.
+    int turn = 0;
+    struct request {
+        tripoint goal;
+        pathfinding_settings settings;
+        int count = 0;
+    };
+    // Goals and settings asked for this turn that have no field yet.
+    std::vector<request> requests;
+    // Most recently used first. Outdated fields stay around to be flooded again.
+    std::vector< std::unique_ptr<pathfinding_flow_field> > fields;
+    // Solved by map::route_batch and not yet taken by map::route_shared.
+    std::vector<route_request> solved;
 };
 
 #endif // CATA_SRC_PATHFINDING_H
@@ -0,0 +1,331 @@
+#include "perf_stats.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_utility.h"
+#include "debug.h"
+#include "enum_conversions.h"
+#include "filesystem.h"
+#include "path_info.h"
+#include "string_formatter.h"
+
+namespace io
+{
+
+template<>
+std::string enum_to_string<perf_stage>( perf_stage data )
+{
+    switch( data ) {
+        // *INDENT-OFF*
+        case perf_stage::do_turn: return "do_turn";
+        case perf_stage::process_fields: return "process_fields";
+        case perf_stage::build_map_cache: return "build_map_cache";
+        case perf_stage::build_transparency_cache: return "build_transparency_cache";
+        case perf_stage::build_sunlight_cache: return "build_sunlight_cache";
+        case perf_stage::generate_lightmap: return "generate_lightmap";
+        case perf_stage::build_seen_cache: return "build_seen_cache";
+        case perf_stage::update_visibility_cache: return "update_visibility_cache";
+        case perf_stage::monmove: return "monmove";
+        // *INDENT-ON*
+        case perf_stage::last:
+            break;
+    }
+    cata_fatal( "Invalid perf_stage" );
+}
+
+template<>
+std::string enum_to_string<frame_stat>( frame_stat data )
+{
+    switch( data ) {
+        // *INDENT-OFF*
+        case frame_stat::render: return "render";
+        case frame_stat::input_latency: return "input_latency";
+        // *INDENT-ON*
+        case frame_stat::last:
+            break;
+    }
+    cata_fatal( "Invalid frame_stat" );
+}
+
+} // namespace io
+
+namespace
+{
+
+constexpr int num_stages = static_cast<int>( perf_stage::last );
+constexpr int num_frame_stats = static_cast<int>( frame_stat::last );
+// Ten minutes of game time at one turn per second.
+constexpr int window_turns = 600;
+
+// Ring buffer of the latest samples, in microseconds.
+struct sample_window {
+    std::array<float, window_turns> samples{};
+    int head = 0;
+    int count = 0;
+
+    void add( const float sample ) {
+        samples[head] = sample;
+        head = ( head + 1 ) % window_turns;
+        count = std::min( count + 1, window_turns );
+    }
+};
+
+struct stage_history {
+    // Totals of the turn in progress, in nanoseconds.
+    std::atomic<int64_t> current{ 0 };
+    sample_window turns;
+};
+
+std::array<stage_history, num_stages> &histories()
+{
+    static std::array<stage_history, num_stages> data;
+    return data;
+}
+
+// Only the main thread draws, so these need no atomics.
+std::array<sample_window, num_frame_stats> &frame_histories()
+{
+    static std::array<sample_window, num_frame_stats> data;
+    return data;
+}
+
+bool input_pending = false;
+std::chrono::steady_clock::time_point input_time;
+
+std::unique_ptr<cata::ofstream> csv_file;
+
+void write_csv_header( std::ostream &out )
+{
+    out << "turn";
+    for( int i = 0; i < num_stages; ++i ) {
+        out << ',' << io::enum_to_string( static_cast<perf_stage>( i ) ) << "_us";
+    }
+    out << '\n';
+}
+
+double percentile( const std::vector<float> &sorted, const double fraction )
+{
+    const size_t index = std::min( sorted.size() - 1,
+                                   static_cast<size_t>( fraction * sorted.size() ) );
+    return sorted[index];
+}
+
+perf_stats::stage_summary summarize_window( const sample_window &w )
+{
+    perf_stats::stage_summary result;
+    if( w.count == 0 ) {
+        return result;
+    }
+    std::vector<float> sorted( w.samples.begin(), w.samples.begin() + w.count );
+    std::sort( sorted.begin(), sorted.end() );
+    result.turns = w.count;
+    result.p50 = percentile( sorted, 0.50 );
+    result.p90 = percentile( sorted, 0.90 );
+    result.p99 = percentile( sorted, 0.99 );
+    result.max = sorted.back();
+    return result;
+}
+
+perf_stats::histogram histogram_of( const sample_window &w )
+{
+    perf_stats::histogram result{};
+    for( int i = 0; i < w.count; ++i ) {
+        const int last_bucket = perf_stats::histogram_buckets - 1;
+        int bucket = 0;
+        for( float limit = 1000.0f; w.samples[i] >= limit && bucket < last_bucket; limit *= 2 ) {
+            ++bucket;
+        }
+        ++result[bucket];
+    }
+    return result;
+}
+
+void write_histogram_row( std::ostream &out, const std::string &name, const sample_window &w )
+{
+    const perf_stats::stage_summary s = summarize_window( w );
+    out << name << ',' << s.turns << ',' << s.p50 << ',' << s.p99 << ',' << s.max;
+    for( const int count : histogram_of( w ) ) {
+        out << ',' << count;
+    }
+    out << '\n';
+}
+
+} // namespace
+
+namespace perf_stats
+{
+
+void add_sample( const perf_stage stage, const std::chrono::steady_clock::duration elapsed )
+{
+    histories()[static_cast<int>( stage )].current.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count(),
+        std::memory_order_relaxed );
+}
+
+void end_turn()
+{
+    std::array<float, num_stages> totals;
+    for( int i = 0; i < num_stages; ++i ) {
+        stage_history &h = histories()[i];
+        totals[i] = h.current.exchange( 0, std::memory_order_relaxed ) / 1000.0f;
+        h.turns.add( totals[i] );
+    }
+
+    if( csv_file ) {
+        *csv_file << to_turns<int>( calendar::turn - calendar::turn_zero );
+        for( const float total : totals ) {
+            *csv_file << ',' << total;
+        }
+        *csv_file << '\n';
+    }
+}
+
+stage_summary summarize( const perf_stage stage )
+{
+    return summarize_window( histories()[static_cast<int>( stage )].turns );
+}
+
+stage_summary summarize( const frame_stat stat )
+{
+    return summarize_window( frame_histories()[static_cast<int>( stat )] );
+}
+
+void input_received()
+{
+    // Several inputs before a redraw count from the first.
+    if( !input_pending ) {
+        input_pending = true;
+        input_time = std::chrono::steady_clock::now();
+    }
+}
+
+void frame_drawn( const std::chrono::steady_clock::duration elapsed )
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    frame_histories()[static_cast<int>( frame_stat::render )].add(
+        duration_cast<nanoseconds>( elapsed ).count() / 1000.0f );
+    if( input_pending ) {
+        input_pending = false;
+        frame_histories()[static_cast<int>( frame_stat::input_latency )].add(
+            duration_cast<nanoseconds>( std::chrono::steady_clock::now() - input_time ).count() /
+            1000.0f );
+    }
+}
+
+histogram get_histogram( const perf_stage stage )
+{
+    return histogram_of( histories()[static_cast<int>( stage )].turns );
+}
+
+histogram get_histogram( const frame_stat stat )
+{
+    return histogram_of( frame_histories()[static_cast<int>( stat )] );
+}
+
+std::string histogram_bucket_name( const int i )
+{
+    if( i == 0 ) {
+        return "<1ms";
+    }
+    if( i == histogram_buckets - 1 ) {
+        return string_format( "%d+ms", 1 << ( i - 1 ) );
+    }
+    return string_format( "%d-%dms", 1 << ( i - 1 ), 1 << i );
+}
+
+bool write_histograms()
+{
+    return write_to_file( histograms_path(), []( std::ostream & fout ) {
+        fout << std::fixed << std::setprecision( 0 );
+        fout << "name,samples,p50_us,p99_us,max_us";
+        for( int i = 0; i < histogram_buckets; ++i ) {
+            fout << ',' << histogram_bucket_name( i );
+        }
+        fout << '\n';
+        for( int i = 0; i < num_frame_stats; ++i ) {
+            write_histogram_row( fout, io::enum_to_string( static_cast<frame_stat>( i ) ),
+                                 frame_histories()[i] );
+        }
+        for( int i = 0; i < num_stages; ++i ) {
+            write_histogram_row( fout, io::enum_to_string( static_cast<perf_stage>( i ) ),
+                                 histories()[i].turns );
+        }
+    }, "timing histograms" );
+}
+
+std::string histograms_path()
+{
+    return PATH_INFO::config_dir() + "perf_histograms.csv";
+}
+
+std::string summary_table()
+{
+    std::ostringstream out;
+    out << string_format( "%-26s %10s %10s %10s %10s\n", "stage (us per turn)", "p50", "p90",
+                          "p99", "max" );
+    for( int i = 0; i < num_stages; ++i ) {
+        const perf_stage stage = static_cast<perf_stage>( i );
+        const stage_summary s = summarize( stage );
+        out << string_format( "%-26s %10.0f %10.0f %10.0f %10.0f\n", io::enum_to_string( stage ),
+                              s.p50, s.p90, s.p99, s.max );
+    }
+    out << string_format( "over the last %d turns", summarize( perf_stage::do_turn ).turns );
+    return out.str();
+}
+
+void reset()
+{
+    for( stage_history &h : histories() ) {
+        h.current = 0;
+        h.turns = sample_window();
+    }
+    for( sample_window &w : frame_histories() ) {
+        w = sample_window();
+    }
+    input_pending = false;
+}
+
+void set_csv_dump( const bool enabled )
+{
+    if( !enabled ) {
+        csv_file.reset();
+        return;
+    }
+    if( csv_file ) {
+        return;
+    }
+    const std::string path = csv_path();
+    const bool existed = file_exist( path );
+    csv_file = std::make_unique<cata::ofstream>( fs::u8path( path ), std::ios::out | std::ios::app );
+    if( !csv_file->is_open() ) {
+        debugmsg( "Could not open %s for writing", path );
+        csv_file.reset();
+        return;
+    }
+    *csv_file << std::fixed << std::setprecision( 0 );
+    if( !existed ) {
+        write_csv_header( *csv_file );
+    }
+}
+
+bool csv_dump_enabled()
+{
+    return csv_file != nullptr;
+}
+
+std::string csv_path()
+{
+    return PATH_INFO::config_dir() + "perf_stages.csv";
+}
+
+} // namespace perf_stats
@@ -0,0 +1,122 @@
+#pragma once
+#ifndef CATA_SRC_PERF_STATS_H
+#define CATA_SRC_PERF_STATS_H
+
+#include <array>
+#include <chrono>
+#include <string>
+
+#include "enum_traits.h"
+
+// Wall clock time spent in the expensive per-turn stages, so that one slow turn
+// can be pinned on the stage responsible instead of on "the game".
+//
+// Time is summed per stage over a turn and handed to a rolling window of recent
+// turns by perf_stats::end_turn(), which do_turn() calls once per turn.
+
+enum class perf_stage : int {
+    do_turn,
+    process_fields,
+    build_map_cache,
+    build_transparency_cache,
+    build_sunlight_cache,
+    generate_lightmap,
+    build_seen_cache,
+    update_visibility_cache,
+    monmove,
+    last
+};
+
+template<>
+struct enum_traits<perf_stage> {
+    static constexpr perf_stage last = perf_stage::last;
+};
+
+// Sampled per frame rather than per turn, as a turn can draw many frames or none.
+enum class frame_stat : int {
+    // Time ui_manager takes to redraw the invalidated UIs.
+    render,
+    // From input_context receiving an input to the end of the next redraw.
+    input_latency,
+    last
+};
+
+template<>
+struct enum_traits<frame_stat> {
+    static constexpr frame_stat last = frame_stat::last;
+};
+
+namespace perf_stats
+{
+
+/**
+ * Per-turn totals of one stage over the rolling window, in microseconds. For a
+ * @ref frame_stat, the samples of single frames and @ref turns counts the frames.
+ */
+struct stage_summary {
+    int turns = 0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/** Adds @p elapsed to the current turn's total for @p stage. Safe to call from worker threads. */
+void add_sample( perf_stage stage, std::chrono::steady_clock::duration elapsed );
+
+/** Closes the current turn: moves the totals into the window and writes the CSV row, if enabled. */
+void end_turn();
+
+stage_summary summarize( perf_stage stage );
+stage_summary summarize( frame_stat stat );
+
+/** Called when an input reaches the game, to time how long until it is shown. */
+void input_received();
+/** Adds one frame that took @p elapsed to redraw. */
+void frame_drawn( std::chrono::steady_clock::duration elapsed );
+
+// Histograms of the rolling window with buckets doubling in width: under 1 ms, 1-2 ms,
+// 2-4 ms and so on, the last also holding everything longer.
+constexpr int histogram_buckets = 8;
+using histogram = std::array<int, histogram_buckets>;
+histogram get_histogram( perf_stage stage );
+histogram get_histogram( frame_stat stat );
+/** Name of bucket @p i, like "2-4ms". */
+std::string histogram_bucket_name( int i );
+
+/** Writes the percentiles and histogram of every stage and frame stat to @ref histograms_path. */
+bool write_histograms();
+std::string histograms_path();
+
+/** Human readable table of @ref summarize for every stage. */
+std::string summary_table();
+
+/** Discards every recorded turn and frame. */
+void reset();
+
+/** Writes one row per turn with the total of every stage to @ref csv_path. */
+void set_csv_dump( bool enabled );
+bool csv_dump_enabled();
+std::string csv_path();
+
+} // namespace perf_stats
+
+/** Adds the time between construction and destruction to a stage of the current turn. */
+class perf_timer
+{
+    public:
+        explicit perf_timer( perf_stage stage ) : stage( stage ),
+            start( std::chrono::steady_clock::now() ) {}
+        ~perf_timer() {
+            perf_stats::add_sample( stage, std::chrono::steady_clock::now() - start );
+        }
+
+        perf_timer( const perf_timer & ) = delete;
+        perf_timer &operator=( const perf_timer & ) = delete;
+
+    private:
+        perf_stage stage;
+        std::chrono::steady_clock::time_point start;
+};
+
+#endif // CATA_SRC_PERF_STATS_H
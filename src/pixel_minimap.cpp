@@ -176,6 +176,8 @@ struct pixel_minimap::submap_cache {
     std::vector<point> update_list;
     //flag used to indicate that the texture needs to be cleared before first use
     bool ready = false;
+    //whether minimap_colors hold the color of every tile, so only changed tiles are looked at
+    bool evaluated = false;
     shared_texture_pool &pool;
 
     //reserve the SEEX * SEEY submap tiles
@@ -296,20 +298,25 @@ void pixel_minimap::flush_cache_updates()
     }
 }
 
-void pixel_minimap::update_cache_at( const tripoint &sm_pos )
+void pixel_minimap::update_cache_at( const tripoint &sm_pos, const bool all_tiles )
 {
     const map &here = get_map();
     const level_cache &access_cache = here.access_cache( sm_pos.z );
-    const bool nv_goggle = get_player_character().get_vision_modes()[NV_GOGGLES];
+    const bool nv_goggle = cached_nv_goggle;
 
     submap_cache &cache_item = get_cache_at( here.get_abs_sub() + sm_pos );
     const tripoint ms_pos = sm_to_ms_copy( sm_pos );
 
     cache_item.touched = true;
+    const bool evaluate_all = all_tiles || !cache_item.evaluated;
+    cache_item.evaluated = true;
 
     for( int y = 0; y < SEEY; ++y ) {
         for( int x = 0; x < SEEX; ++x ) {
             const tripoint p = ms_pos + tripoint{ x, y, 0 };
+            if( !evaluate_all && !access_cache.minimap_dirty[p.x * MAPSIZE_X + p.y] ) {
+                continue;
+            }
             const lit_level lighting = access_cache.visibility_cache[p.x][p.y];
 
             SDL_Color color;
@@ -359,11 +366,20 @@ void pixel_minimap::process_cache( const tripoint &center )
 {
     prepare_cache_for_updates( center );
 
+    map &here = get_map();
+    // The tiles are looked at again only where the map marked them dirty, unless something
+    // that colors all of them changed.
+    const bool nv_goggle = get_player_character().get_vision_modes()[NV_GOGGLES];
+    const bool all_tiles = nv_goggle != cached_nv_goggle || here.get_abs_sub() != cached_abs_sub;
+    cached_nv_goggle = nv_goggle;
+    cached_abs_sub = here.get_abs_sub();
+
     for( int y = 0; y < MAPSIZE; ++y ) {
         for( int x = 0; x < MAPSIZE; ++x ) {
-            update_cache_at( { x, y, center.z } );
+            update_cache_at( { x, y, center.z }, all_tiles );
         }
     }
+    here.access_cache( center.z ).minimap_dirty.reset();
 
     flush_cache_updates();
     clear_unused_cache();
@@ -55,7 +55,8 @@ class pixel_minimap
         void process_cache( const tripoint &center );
 
         void flush_cache_updates();
-        void update_cache_at( const tripoint &pos );
+        // Updates the colors of the tiles the map marked dirty, or of all of them.
+        void update_cache_at( const tripoint &pos, bool all_tiles );
         void prepare_cache_for_updates( const tripoint &center );
         void clear_unused_cache();
 
@@ -76,6 +77,9 @@ class pixel_minimap
 
         //track the previous viewing area to determine if the minimap cache needs to be cleared
         tripoint cached_center_sm;
+        //the view the cached colors were evaluated for, any change recolors every tile
+        bool cached_nv_goggle = false;
+        tripoint cached_abs_sub;
 
         SDL_Rect screen_rect;
         SDL_Rect main_tex_clip_rect;
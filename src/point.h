@@ -138,6 +138,28 @@ inline int divide_round_to_minus_infinity( int n, int d )
     return ( n - d + 1 ) / d; // NOLINT(clang-analyzer-core.DivideZero)
 }
 
+constexpr int log2_of_power_of_two( int n )
+{
+    return n <= 1 ? 0 : 1 + log2_of_power_of_two( n / 2 );
+}
+
+// Right shifting a negative number is arithmetic on every compiler we build with.
+static_assert( -3 >> 1 == -2, "right shift must round to minus infinity" );
+
+/**
+ * As above, for a divisor known at compile time, as those of the coordinate scales are.
+ * A power of two divides with a shift, which rounds to minus infinity as it is.
+ */
+template<int D>
+constexpr int divide_round_to_minus_infinity( int n )
+{
+    static_assert( D > 0, "divisor must be positive" );
+    if( ( D & ( D - 1 ) ) == 0 ) {
+        return n >> log2_of_power_of_two( D );
+    }
+    return n >= 0 ? n / D : ( n - D + 1 ) / D;
+}
+
 inline point multiply_xy( const point &p, int f )
 {
     return point( p.x * f, p.y * f );
@@ -149,6 +171,13 @@ inline point divide_xy_round_to_minus_infinity( const point &p, int d )
                   divide_round_to_minus_infinity( p.y, d ) );
 }
 
+template<int D>
+constexpr point divide_xy_round_to_minus_infinity( const point &p )
+{
+    return point( divide_round_to_minus_infinity<D>( p.x ),
+                  divide_round_to_minus_infinity<D>( p.y ) );
+}
+
 // NOLINTNEXTLINE(cata-xy)
 struct tripoint {
     static constexpr int dimension = 3;
@@ -280,6 +309,14 @@ inline tripoint divide_xy_round_to_minus_infinity( const tripoint &p, int d )
                      p.z );
 }
 
+template<int D>
+constexpr tripoint divide_xy_round_to_minus_infinity( const tripoint &p )
+{
+    return tripoint( divide_round_to_minus_infinity<D>( p.x ),
+                     divide_round_to_minus_infinity<D>( p.y ),
+                     p.z );
+}
+
 static constexpr tripoint tripoint_zero{};
 static constexpr point point_zero{};
 
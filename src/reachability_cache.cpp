@@ -1,27 +1,17 @@
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstdlib>
 #include <tuple>
 
-#include "cuboid_rectangle.h"
 #include "level_cache.h"
 #include "point.h"
 #include "reachability_cache.h"
 
-//helper functions
-static constexpr half_open_rectangle<point> bounding_rect( point_zero, {MAPSIZE_X, MAPSIZE_Y} );
-
 // needs to be explicitly defined to avoid linker errors
 // see https://stackoverflow.com/questions/8452952/c-linker-error-with-class-static-constexpr
 static constexpr int MAX_D = reachability_cache_layer::MAX_D;
 
-bool reachability_cache_layer::update( const point &p, reachability_cache_layer::ElType value )
-{
-    bool change = ( *this )[ p ] != value;
-    ( *this )[ p ] = value;
-    return change;
-}
-
 inline reachability_cache_layer::ElType &reachability_cache_layer::operator[]( const point &p )
 {
     return cache[p.x][p.y];
@@ -32,12 +22,6 @@ inline const reachability_cache_layer::ElType &reachability_cache_layer::operato
     return cache[p.x][p.y];
 }
 
-inline reachability_cache_layer::ElType
-reachability_cache_layer::get_or( const point &p, reachability_cache_layer::ElType def ) const
-{
-    return bounding_rect.contains( p ) ? ( *this )[ p ] : def;
-}
-
 template<bool Horizontal, typename... Types>
 void reachability_cache<Horizontal, Types...>::invalidate()
 {
@@ -49,7 +33,17 @@ template<bool Horizontal, typename... Types>
 void reachability_cache<Horizontal, Types...>::invalidate( const point &p )
 {
     dirty_any = true;
-    dirty[dirty_idx( p )] = true;
+    // The tiles next to p read its transparency and floor, so a change to p can change them
+    // even when they are on the other side of a submap edge, while p itself stays the same.
+    // From there, rebuild passes the changes on by itself.
+    for( int dx = -1; dx <= 1; ++dx ) {
+        for( int dy = -1; dy <= 1; ++dy ) {
+            const point n = p + point( dx, dy );
+            if( n.x >= 0 && n.x < MAPSIZE_X && n.y >= 0 && n.y < MAPSIZE_Y ) {
+                dirty[dirty_idx( n )] = true;
+            }
+        }
+    }
 }
 
 template<bool Horizontal, typename... Types>
@@ -99,10 +93,12 @@ void reachability_cache<Horizontal, Types...>::rebuild( Q q,
             bool next_y_dirty = false;
             int sm_last_x = cur_sm_end.x - dir.x;
             for( int x = smx; x != cur_sm_end.x; x += dir.x ) {
-                for( int y = start.y; y != cur_sm_end.y; y += dir.y ) {
-                    last_change = Spec::dynamic_fun( layer, {x, y}, dir, params ... );
-                    next_x_dirty |= ( x == sm_last_x ) & last_change;
-                }
+                // Tiles of the submaps before this one in the column are either up to date
+                // or were not touched, so they are only read.
+                const reachability_column_change change = Spec::update_column( layer, x, smy, SEEY, dir,
+                        params ... );
+                last_change = change.last;
+                next_x_dirty |= ( x == sm_last_x ) && change.any;
                 next_y_dirty |= last_change;
             }
 
@@ -187,75 +183,111 @@ inline int reachability_cache<Horizontal, Params...>::dirty_idx( const point &p
     return ( p.x / SEEX ) * MAPSIZE + p.y / SEEY;
 }
 
-static inline bool transp( const level_cache &lc, const point &p )
+static bool in_column( const int y )
 {
-    return lc.transparent_cache_wo_fields[p.x][p.y];
+    return y >= 0 && y < MAPSIZE_Y;
 }
 
-static inline int max3( int arg,  int arg2, int arg3 )
+// The column before x in the direction of the DP, or nullptr at the edge of the map.
+static const reachability_cache_layer::ElType *previous_column(
+    const reachability_cache_layer::ElType( &cache )[MAPSIZE_X][MAPSIZE_Y], const int x,
+    const point &dir )
 {
-    return std::max( std::max( arg, arg2 ), arg3 );
+    const int px = x - dir.x;
+    return px >= 0 && px < MAPSIZE_X ? cache[px] : nullptr;
 }
 
-static int min4( int arg,  int arg2, int arg3, int arg4 )
-{
-    return std::min( std::min( arg, arg2 ), std::min( arg3, arg4 ) );
-}
+// Each column is done in two passes. The first reads only the previous column, so it has no
+// dependency between its iterations and compilers can vectorize it; the second adds the tile
+// before in the same column, one after another.
 
 // DP function for the "horizontal" cache
 // el = 0;  if not transparent, or else:
 // el = max( horizontal_neighbor + 1, vertical_neighbor + 1, diagonal_neighbor + 2)
-bool reachability_cache_specialization<true, level_cache>::dynamic_fun(
-    reachability_cache_layer &layer, const point &p, const point &dir, const level_cache &this_lc )
+// where neighbors that are not transparent count as 0
+reachability_column_change reachability_cache_specialization<true, level_cache>::update_column(
+    reachability_cache_layer &layer, const int x, const int y_from, const int count,
+    const point &dir, const level_cache &this_lc )
 {
-    using Layer = reachability_cache_layer;
-
-    // if point is transparent, returns given prev_value, otherwise returns zero
-    const auto transp_or_zero = [&]( const point & p, int prev_value ) {
-        return prev_value != 0 && !transp( this_lc, p ) ? 0 : prev_value;
-    };
-
-    const Layer::ElType v =
-        std::min(
-            MAX_D,
-            max3(
-                transp_or_zero( p - dir, layer.get_or( p - dir, 0 ) ) + 2,
-                transp_or_zero( p - point( dir.x, 0 ), layer.get_or( p - point( dir.x, 0 ), 0 ) ) + 1,
-                transp_or_zero( p - point( 0, dir.y ), layer.get_or( p - point( 0, dir.y ), 0 ) ) + 1
-            ) );
+    using ElType = reachability_cache_layer::ElType;
+    const std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> &transp = this_lc.transparent_cache_wo_fields;
+
+    std::array<int, MAPSIZE_Y> from_prev;
+    if( const ElType *prev = previous_column( layer.cache, x, dir ) ) {
+        const std::bitset<MAPSIZE_Y> &prev_transp = transp[x - dir.x];
+        for( int i = 0; i < count; ++i ) {
+            const int y = y_from + i * dir.y;
+            const int dy = y - dir.y;
+            const int horizontal = prev_transp[y] ? prev[y] : 0;
+            const int diagonal = in_column( dy ) && prev_transp[dy] ? prev[dy] : 0;
+            from_prev[i] = std::max( diagonal + 2, horizontal + 1 );
+        }
+    } else {
+        std::fill( from_prev.begin(), from_prev.begin() + count, 2 );
+    }
 
-    return layer.update( p, v );
+    ElType *col = layer.cache[x];
+    const std::bitset<MAPSIZE_Y> &col_transp = transp[x];
+    reachability_column_change change;
+    for( int i = 0; i < count; ++i ) {
+        const int y = y_from + i * dir.y;
+        const int vy = y - dir.y;
+        const int vertical = in_column( vy ) && col_transp[vy] ? col[vy] : 0;
+        const ElType v = std::min( MAX_D, std::max( from_prev[i], vertical + 1 ) );
+        change.last = col[y] != v;
+        change.any |= change.last;
+        col[y] = v;
+    }
+    return change;
 }
 
 // DP function for the "vertical" cache
 // el = 0;  if this tile doesn't have floor/roof
 // el = MAX_D; if tile is not transparent, else:
 // el = min( horizontal_neighbor + 1, vertical_neighbor + 1, diagonal_neighbor + 2)
-bool reachability_cache_specialization<false, level_cache, level_cache>::dynamic_fun(
-    reachability_cache_layer &layer,
-    const point &p, const point &dir,
-    const level_cache &this_lc,
-    const level_cache &floor_lc )
+// where neighbors that are not transparent or outside of the map count as MAX_D
+reachability_column_change
+reachability_cache_specialization<false, level_cache, level_cache>::update_column(
+    reachability_cache_layer &layer, const int x, const int y_from, const int count,
+    const point &dir, const level_cache &this_lc, const level_cache &floor_lc )
 {
-    using Layer = reachability_cache_layer;
-
-    if( !floor_lc.floor_cache[p.x][p.y] && transp( this_lc, p ) ) {
-        return layer.update( p, 0 );
-    }
-
-    const auto val_if_transp = [&]( const point & p, int prev_v ) {
-        return prev_v >= MAX_D || !transp( this_lc, p ) ? MAX_D : prev_v;
+    using ElType = reachability_cache_layer::ElType;
+    const std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> &transp = this_lc.transparent_cache_wo_fields;
+    const auto val_if_transp = []( const int v, const bool transparent ) {
+        return v >= MAX_D || !transparent ? MAX_D : v;
     };
 
-    const Layer::ElType v =
-        min4(
-            MAX_D,
-            val_if_transp( p - dir, layer.get_or( p - dir, MAX_D ) ) + 2,
-            val_if_transp( p - point( dir.x, 0 ), layer.get_or( p - point( dir.x, 0 ), MAX_D ) ) + 1,
-            val_if_transp( p - point( 0, dir.y ), layer.get_or( p - point( 0, dir.y ), MAX_D ) ) + 1
-        );
+    std::array<int, MAPSIZE_Y> from_prev;
+    if( const ElType *prev = previous_column( layer.cache, x, dir ) ) {
+        const std::bitset<MAPSIZE_Y> &prev_transp = transp[x - dir.x];
+        for( int i = 0; i < count; ++i ) {
+            const int y = y_from + i * dir.y;
+            const int dy = y - dir.y;
+            const int horizontal = val_if_transp( prev[y], prev_transp[y] );
+            const int diagonal = in_column( dy ) ? val_if_transp( prev[dy], prev_transp[dy] ) : MAX_D;
+            from_prev[i] = std::min( diagonal + 2, horizontal + 1 );
+        }
+    } else {
+        std::fill( from_prev.begin(), from_prev.begin() + count, MAX_D + 1 );
+    }
 
-    return layer.update( p, v );
+    ElType *col = layer.cache[x];
+    const std::bitset<MAPSIZE_Y> &col_transp = transp[x];
+    const bool( &floor )[MAPSIZE_Y] = floor_lc.floor_cache[x];
+    reachability_column_change change;
+    for( int i = 0; i < count; ++i ) {
+        const int y = y_from + i * dir.y;
+        const int vy = y - dir.y;
+        ElType v = 0;
+        if( floor[y] || !col_transp[y] ) {
+            const int vertical = in_column( vy ) ? val_if_transp( col[vy], col_transp[vy] ) : MAX_D;
+            v = std::min( { MAX_D, from_prev[i], vertical + 1 } );
+        }
+        change.last = col[y] != v;
+        change.any |= change.last;
+        col[y] = v;
+    }
+    return change;
 }
 
 // horizontal cache test
@@ -12,6 +12,13 @@ class reachability_cache_layer;
 struct level_cache;
 struct point;
 
+// What reachability_cache_specialization::update_column changed.
+struct reachability_column_change {
+    bool any = false;
+    // Whether the last tile updated changed.
+    bool last = false;
+};
+
 // Implementation note:
 // Code could be somewhat simpler if virtual inheritance was used, but cache is a performance-critical structure
 // so templates were used as an attempt to reduce the overhead of virtual method calls.
@@ -23,8 +30,9 @@ struct reachability_cache_specialization {};
 template<>
 struct reachability_cache_specialization<true, level_cache> {
 
-    static bool dynamic_fun( reachability_cache_layer &layer, const point &p,
-                             const point &dir, const level_cache &this_lc );
+    // DP over `count` tiles of column x, starting at y_from and stepping by dir.y
+    static reachability_column_change update_column( reachability_cache_layer &layer, int x,
+            int y_from, int count, const point &dir, const level_cache &this_lc );
 
     // returns "false" if there is no LOS, "true" is "maybe there is LOS"
     static bool test( int d, int cache_v );
@@ -36,8 +44,10 @@ struct reachability_cache_specialization<true, level_cache> {
 // specialization for vertical cache
 template<>
 struct reachability_cache_specialization<false, level_cache, level_cache> {
-    static bool dynamic_fun( reachability_cache_layer &layer, const point &p,
-                             const point &dir, const level_cache &this_lc, const level_cache &floor_lc );
+    // DP over `count` tiles of column x, starting at y_from and stepping by dir.y
+    static reachability_column_change update_column( reachability_cache_layer &layer, int x,
+            int y_from, int count, const point &dir, const level_cache &this_lc,
+            const level_cache &floor_lc );
 
     // returns "false" if there is no LOS, "true" is "maybe there is LOS"
     static bool test( int d, int cache_v );
@@ -58,10 +68,8 @@ class reachability_cache_layer
     private:
         ElType cache[MAPSIZE_X][MAPSIZE_Y];
 
-        bool update( const point &p, ElType value );
         ElType &operator[]( const point &p );
         const ElType &operator[]( const point &p ) const;
-        ElType get_or( const point &p, ElType def ) const;
 
         template<bool Horizontal, typename ... Params>
         friend class reachability_cache;
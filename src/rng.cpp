@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 
 #include "calendar.h"
 #include "cata_utility.h"
@@ -11,13 +12,13 @@
 unsigned int rng_bits()
 {
     // Whole uint range.
-    static std::uniform_int_distribution<unsigned int> rng_uint_dist;
+    static thread_local std::uniform_int_distribution<unsigned int> rng_uint_dist;
     return rng_uint_dist( rng_get_engine() );
 }
 
 int rng( int lo, int hi )
 {
-    static std::uniform_int_distribution<int> rng_int_dist;
+    static thread_local std::uniform_int_distribution<int> rng_int_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -26,7 +27,7 @@ int rng( int lo, int hi )
 
 double rng_float( double lo, double hi )
 {
-    static std::uniform_real_distribution<double> rng_real_dist;
+    static thread_local std::uniform_real_distribution<double> rng_real_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -40,13 +41,13 @@ units::angle random_direction()
 
 double normal_roll( double mean, double stddev )
 {
-    static std::normal_distribution<double> rng_normal_dist;
+    static thread_local std::normal_distribution<double> rng_normal_dist;
     return rng_normal_dist( rng_get_engine(), std::normal_distribution<>::param_type( mean, stddev ) );
 }
 
 double exponential_roll( double lambda )
 {
-    static std::exponential_distribution<double> rng_exponential_dist;
+    static thread_local std::exponential_distribution<double> rng_exponential_dist;
     return rng_exponential_dist( rng_get_engine(),
                                  std::exponential_distribution<>::param_type( lambda ) );
 }
@@ -127,17 +128,55 @@ double rng_normal( double lo, double hi )
     return clamp( val, lo, hi );
 }
 
-cata_default_random_engine &rng_get_engine()
+// The seed the global engine last started from, which the streams are seeded from too.
+static unsigned int &engine_seed()
 {
     // NOLINTNEXTLINE(cata-determinism)
-    static cata_default_random_engine eng(
-        std::chrono::high_resolution_clock::now().time_since_epoch().count() );
+    static unsigned int seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return seed;
+}
+
+static cata_default_random_engine &global_engine()
+{
+    static cata_default_random_engine eng( engine_seed() );
     return eng;
 }
 
+static thread_local cata_default_random_engine *stream_engine = nullptr;
+
+cata_default_random_engine &rng_get_engine()
+{
+    return stream_engine != nullptr ? *stream_engine : global_engine();
+}
+
 void rng_set_engine_seed( unsigned int seed )
 {
     if( seed != 0 ) {
-        rng_get_engine().seed( seed );
+        engine_seed() = seed;
+        global_engine().seed( seed );
     }
 }
+
+// splitmix64, so that neighbouring keys still start far apart.
+static unsigned int stream_seed( const size_t key )
+{
+    uint64_t z = ( static_cast<uint64_t>( engine_seed() ) << 32 ) ^ key;
+    z += 0x9E3779B97F4A7C15ull;
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    // minstd_rand0 turns a seed of 0 into 1 anyway.
+    return static_cast<unsigned int>( z );
+}
+
+rng_stream::rng_stream( const size_t key )
+    : engine( stream_seed( key ) )
+    , outer( stream_engine )
+{
+    stream_engine = &engine;
+}
+
+rng_stream::~rng_stream()
+{
+    stream_engine = outer;
+}
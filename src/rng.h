@@ -26,9 +26,32 @@ class tripoint_range;
 void rng_set_engine_seed( unsigned int seed );
 
 using cata_default_random_engine = std::minstd_rand0;
+/** The engine of the current thread's @ref rng_stream, or else the global engine. */
 cata_default_random_engine &rng_get_engine();
 unsigned int rng_bits();
 
+/**
+ * While alive, every PRNG function called on this thread draws from an engine of its own,
+ * seeded from the global seed and @p key instead of from the global engine.  Work handed out
+ * to several threads can so get the same numbers whichever thread runs it and in whatever
+ * order, as long as every task has a key of its own, e.g. the hash of the overmap terrain or
+ * the id of the monster it works on.  The global engine is not advanced meanwhile.
+ *
+ * Streams nest; the outer one is used again once the inner one is gone.
+ */
+class rng_stream
+{
+    public:
+        explicit rng_stream( size_t key );
+        ~rng_stream();
+
+        rng_stream( const rng_stream & ) = delete;
+        rng_stream &operator=( const rng_stream & ) = delete;
+    private:
+        cata_default_random_engine engine;
+        cata_default_random_engine *outer;
+};
+
 int rng( int lo, int hi );
 double rng_float( double lo, double hi );
 
@@ -26,8 +26,11 @@ class safe_reference
     public:
         safe_reference() = default;
 
+        // Only checks whether the anchor is gone rather than locking it, which would touch the
+        // reference counts twice on every dereference.  References are only used on the main
+        // thread, so the anchor cannot go away between the check and the use.
         T *get() const {
-            return impl.lock().get();
+            return impl.expired() ? nullptr : object;
         }
 
         explicit operator bool() const {
@@ -48,9 +51,10 @@ class safe_reference
     private:
         friend class safe_reference_anchor;
 
-        explicit safe_reference( const std::shared_ptr<T> &p ) : impl( p ) {}
+        explicit safe_reference( const std::shared_ptr<T> &p ) : impl( p ), object( p.get() ) {}
 
         std::weak_ptr<T> impl;
+        T *object = nullptr;
 };
 
 class safe_reference_anchor
@@ -0,0 +1,265 @@
+#include "save_journal.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <ios>
+#include <locale>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "debug.h"
+#include "filesystem.h"
+#include "ofstream_wrapper.h"
+#include "path_info.h"
+
+// The journal is a run of records. A write record is a line "W <size> <path>" followed by
+// the size bytes of the file and a newline. A settle record is a line "S <path>": the file
+// was written into place since. Paths are relative to the world folder. Whatever follows a
+// record that is cut short (by a crash while appending) is ignored.
+
+namespace
+{
+
+struct record_span {
+    std::streamoff offset = 0;
+    size_t size = 0;
+};
+
+using record_map = std::map<std::string, record_span>;
+
+struct journal_state {
+    std::mutex mutex;
+    // The world folder, with a trailing separator, and its journal.
+    std::string base;
+    std::string path;
+    // Open while the journal has records that were not settled.
+    std::unique_ptr<cata::ofstream> out;
+    // Where the last complete record ends.
+    std::streamoff end = 0;
+    // Where the latest contents of each journaled file are, for files not settled yet.
+    record_map live;
+};
+
+journal_state &get_state()
+{
+    static journal_state state;
+    return state;
+}
+
+std::atomic<bool> capturing_files( false );
+// Whether any record is live, so settle can return without taking the lock.
+std::atomic<bool> has_live_records( false );
+
+record_map read_records( const std::string &path, std::streamoff &end )
+{
+    record_map records;
+    end = 0;
+    cata::ifstream fin( fs::u8path( path ), std::ios::binary );
+    std::string line;
+    while( std::getline( fin, line ) && !fin.eof() ) {
+        if( line.compare( 0, 2, "S " ) == 0 ) {
+            records.erase( line.substr( 2 ) );
+        } else if( line.compare( 0, 2, "W " ) == 0 ) {
+            char *name_start = nullptr;
+            const unsigned long long size = std::strtoull( line.c_str() + 2, &name_start, 10 );
+            if( *name_start != ' ' ) {
+                break;
+            }
+            const record_span span{ fin.tellg(), static_cast<size_t>( size ) };
+            fin.seekg( static_cast<std::streamoff>( size ), std::ios::cur );
+            if( fin.get() != '\n' ) {
+                break;
+            }
+            records[name_start + 1] = span;
+        } else {
+            break;
+        }
+        end = fin.tellg();
+    }
+    return records;
+}
+
+std::string read_record( const std::string &path, const record_span &span )
+{
+    cata::ifstream fin( fs::u8path( path ), std::ios::binary );
+    fin.seekg( span.offset );
+    std::string contents( span.size, '\0' );
+    fin.read( &contents[0], contents.size() );
+    if( !fin ) {
+        throw std::runtime_error( "reading the save journal failed" );
+    }
+    return contents;
+}
+
+void write_into_place( const std::string &path, const std::string &contents )
+{
+    ofstream_wrapper fout( fs::u8path( path ), std::ios::binary );
+    fout.stream().write( contents.data(), contents.size() );
+    fout.close();
+}
+
+// Appends a record, throwing if the journal could not be written.
+void append_record( journal_state &state, const std::string &header, const std::string *contents )
+{
+    if( !state.out ) {
+        // Drop whatever a crash left after the last complete record.
+        std::error_code ec;
+        if( fs::exists( fs::u8path( state.path ), ec ) ) {
+            fs::resize_file( fs::u8path( state.path ), state.end, ec );
+        } else {
+            state.end = 0;
+        }
+        state.out = std::make_unique<cata::ofstream>( fs::u8path( state.path ),
+                    std::ios::binary | std::ios::app );
+    }
+    *state.out << header;
+    if( contents != nullptr ) {
+        state.out->write( contents->data(), contents->size() );
+        state.out->put( '\n' );
+    }
+    state.out->flush();
+    if( !*state.out ) {
+        state.out.reset();
+        throw std::runtime_error( "writing to the save journal failed" );
+    }
+    state.end += header.size() + ( contents != nullptr ? contents->size() + 1 : 0 );
+}
+
+void remove_journal( journal_state &state )
+{
+    state.out.reset();
+    state.live.clear();
+    state.end = 0;
+    has_live_records = false;
+    std::error_code ec;
+    fs::remove( fs::u8path( state.path ), ec );
+}
+
+} // namespace
+
+namespace save_journal
+{
+
+std::string journal_path()
+{
+    return PATH_INFO::world_base_save_path() + "/save.journal";
+}
+
+capture::capture( const bool enabled ) : enabled( enabled )
+{
+    if( !enabled ) {
+        return;
+    }
+    bool same_world;
+    {
+        journal_state &state = get_state();
+        std::lock_guard<std::mutex> lock( state.mutex );
+        same_world = state.path == journal_path();
+    }
+    if( !same_world ) {
+        apply();
+    }
+    capturing_files = true;
+}
+
+capture::~capture()
+{
+    if( enabled ) {
+        capturing_files = false;
+    }
+}
+
+bool capturing()
+{
+    return capturing_files;
+}
+
+bool append( const std::string &path, const std::string &contents )
+{
+    journal_state &state = get_state();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    if( state.base.empty() || path.compare( 0, state.base.size(), state.base ) != 0 ) {
+        return false;
+    }
+    const std::string name = path.substr( state.base.size() );
+    std::ostringstream header;
+    header.imbue( std::locale::classic() );
+    header << "W " << contents.size() << " " << name << "\n";
+    const std::streamoff offset = state.end + header.str().size();
+    append_record( state, header.str(), &contents );
+    state.live[name] = record_span{ offset, contents.size() };
+    has_live_records = true;
+    return true;
+}
+
+void settle( const std::string &path )
+{
+    if( !has_live_records ) {
+        return;
+    }
+    journal_state &state = get_state();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    if( path.compare( 0, state.base.size(), state.base ) != 0 ) {
+        return;
+    }
+    const auto it = state.live.find( path.substr( state.base.size() ) );
+    if( it == state.live.end() ) {
+        return;
+    }
+    try {
+        write_into_place( path, read_record( state.path, it->second ) );
+        append_record( state, "S " + it->first + "\n", nullptr );
+    } catch( const std::exception &err ) {
+        // This may run on a background thread, so it can't show anything. The reader gets
+        // the older file, and the journal keeps the record for the next apply.
+        DebugLog( D_ERROR, D_GAME ) << "Failed to settle \"" << path << "\": " << err.what();
+        return;
+    }
+    state.live.erase( it );
+    if( state.live.empty() ) {
+        remove_journal( state );
+    }
+}
+
+void apply()
+{
+    journal_state &state = get_state();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.out.reset();
+    state.path = journal_path();
+    state.base = PATH_INFO::world_base_save_path() + "/";
+    state.live = read_records( state.path, state.end );
+    std::vector<std::string> restored;
+    for( auto it = state.live.begin(); it != state.live.end(); ) {
+        try {
+            write_into_place( state.base + it->first, read_record( state.path, it->second ) );
+            restored.push_back( it->first );
+            it = state.live.erase( it );
+        } catch( const std::exception &err ) {
+            debugmsg( "Failed to restore \"%s\" from the save journal: %s", it->first, err.what() );
+            ++it;
+        }
+    }
+    if( state.live.empty() ) {
+        remove_journal( state );
+        return;
+    }
+    // The journal stays, so the files that were restored must not be replayed over
+    // whatever replaces them later.
+    has_live_records = true;
+    try {
+        for( const std::string &name : restored ) {
+            append_record( state, "S " + name + "\n", nullptr );
+        }
+    } catch( const std::exception &err ) {
+        debugmsg( "Failed to update the save journal: %s", err.what() );
+    }
+}
+
+} // namespace save_journal
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef CATA_SRC_SAVE_JOURNAL_H
+#define CATA_SRC_SAVE_JOURNAL_H
+
+#include <string>
+
+// An append-only journal of save files, so that an autosave can be made durable by
+// appending the files it changed to one file instead of replacing each of them.
+//
+// While a capture is alive, the save files of the active world written through
+// write_to_file go to the journal. @ref apply folds the journal back into the regular
+// files: game::save calls it before a normal save, and game::load_master before anything
+// of the world is read, which replays a journal an earlier session left behind. Until it
+// is applied, a journaled file is settled (written into place from the journal) before
+// anything reads or replaces it, so no one sees a file older than what was last saved.
+
+namespace save_journal
+{
+
+/** Journals the save files written while it is alive, if enabled. Main thread only. */
+class capture
+{
+    public:
+        explicit capture( bool enabled );
+        ~capture();
+
+        capture( const capture & ) = delete;
+        capture &operator=( const capture & ) = delete;
+
+    private:
+        bool enabled;
+};
+
+/** Whether save files are being journaled right now. */
+bool capturing();
+
+/**
+ * Appends the whole contents of the save file at path to the journal.
+ * @return false if path is not in the active world, so it has to be written normally.
+ * @throw std::exception when the journal could not be written.
+ */
+bool append( const std::string &path, const std::string &contents );
+
+/** Writes the journaled contents of the file at path into place, if the journal has any. */
+void settle( const std::string &path );
+
+/**
+ * Writes every file in the journal of the active world into place and deletes the
+ * journal. Files that could not be written are reported and stay in the journal.
+ */
+void apply();
+
+/** Where the journal of the active world is. */
+std::string journal_path();
+
+} // namespace save_journal
+
+#endif // CATA_SRC_SAVE_JOURNAL_H
@@ -0,0 +1,206 @@
+#include "save_stats.h"
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+
+#include "cata_utility.h"
+#include "debug.h"
+#include "enum_conversions.h"
+#include "json.h"
+#include "path_info.h"
+#include "string_formatter.h"
+
+namespace io
+{
+
+template<>
+std::string enum_to_string<save_part>( save_part data )
+{
+    switch( data ) {
+        // *INDENT-OFF*
+        case save_part::player: return "player";
+        case save_part::map_memory: return "map_memory";
+        case save_part::master: return "master";
+        case save_part::overmaps: return "overmaps";
+        case save_part::submaps: return "submaps";
+        case save_part::other: return "other";
+        // *INDENT-ON*
+        case save_part::last:
+            break;
+    }
+    cata_fatal( "Invalid save_part" );
+}
+
+} // namespace io
+
+namespace
+{
+
+constexpr int num_parts = static_cast<int>( save_part::last );
+// A busy warehouse is what this is for, not a full listing.
+constexpr size_t max_listed_quads = 10;
+
+struct save_report {
+    std::array<save_stats::part_totals, num_parts> parts;
+    std::vector<save_stats::quad_summary> quads;
+};
+
+save_report &report()
+{
+    static save_report data;
+    return data;
+}
+
+save_timer *innermost_timer = nullptr;
+
+double to_milliseconds( const std::chrono::steady_clock::duration d )
+{
+    return std::chrono::duration<double, std::milli>( d ).count();
+}
+
+} // namespace
+
+namespace save_stats
+{
+
+void begin_save()
+{
+    report() = save_report();
+}
+
+void add_file( const save_part part, const size_t bytes )
+{
+    part_totals &totals = report().parts[static_cast<int>( part )];
+    totals.files++;
+    totals.bytes += bytes;
+}
+
+void add_unchanged_file( const save_part part )
+{
+    report().parts[static_cast<int>( part )].unchanged_files++;
+}
+
+void add_time( const save_part part, const std::chrono::steady_clock::duration elapsed )
+{
+    report().parts[static_cast<int>( part )].time += elapsed;
+}
+
+void add_quad( const tripoint &om_addr, const size_t bytes, const int items )
+{
+    std::vector<quad_summary> &quads = report().quads;
+    if( quads.size() == max_listed_quads && quads.back().bytes >= bytes ) {
+        return;
+    }
+    const auto pos = std::find_if( quads.begin(), quads.end(), [bytes]( const quad_summary & q ) {
+        return q.bytes < bytes;
+    } );
+    quads.insert( pos, quad_summary{ om_addr, bytes, items } );
+    if( quads.size() > max_listed_quads ) {
+        quads.pop_back();
+    }
+}
+
+part_totals totals( const save_part part )
+{
+    return report().parts[static_cast<int>( part )];
+}
+
+std::vector<quad_summary> largest_quads()
+{
+    return report().quads;
+}
+
+std::string summary_table()
+{
+    std::ostringstream out;
+    out << string_format( "%-12s %8s %10s %10s %10s\n", "part", "files", "unchanged", "kB",
+                          "ms" );
+    part_totals sum;
+    for( int i = 0; i < num_parts; ++i ) {
+        const save_part part = static_cast<save_part>( i );
+        const part_totals t = totals( part );
+        out << string_format( "%-12s %8d %10d %10.0f %10.0f\n", io::enum_to_string( part ),
+                              t.files, t.unchanged_files, t.bytes / 1024.0,
+                              to_milliseconds( t.time ) );
+        sum.files += t.files;
+        sum.unchanged_files += t.unchanged_files;
+        sum.bytes += t.bytes;
+        sum.time += t.time;
+    }
+    out << string_format( "%-12s %8d %10d %10.0f %10.0f\n", "total", sum.files,
+                          sum.unchanged_files, sum.bytes / 1024.0, to_milliseconds( sum.time ) );
+    const std::vector<quad_summary> &quads = report().quads;
+    if( !quads.empty() ) {
+        out << "\nlargest quads (overmap terrain, kB, items)\n";
+        for( const quad_summary &q : quads ) {
+            out << string_format( "%-20s %10.0f %10d\n", q.om_addr.to_string(), q.bytes / 1024.0,
+                                  q.items );
+        }
+    }
+    return out.str();
+}
+
+void serialize( JsonOut &jsout )
+{
+    jsout.start_object();
+    jsout.member( "parts" );
+    jsout.start_array();
+    for( int i = 0; i < num_parts; ++i ) {
+        const save_part part = static_cast<save_part>( i );
+        const part_totals t = totals( part );
+        jsout.start_object();
+        jsout.member( "part", io::enum_to_string( part ) );
+        jsout.member( "files", t.files );
+        jsout.member( "unchanged_files", t.unchanged_files );
+        jsout.member( "bytes", t.bytes );
+        jsout.member( "ms", to_milliseconds( t.time ) );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.member( "largest_quads" );
+    jsout.start_array();
+    for( const quad_summary &q : report().quads ) {
+        jsout.start_object();
+        jsout.member( "om_addr", q.om_addr );
+        jsout.member( "bytes", q.bytes );
+        jsout.member( "items", q.items );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+bool write_report()
+{
+    return write_to_file( report_path(), []( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        serialize( jsout );
+    }, "save report" );
+}
+
+std::string report_path()
+{
+    return PATH_INFO::config_dir() + "save_stats.json";
+}
+
+} // namespace save_stats
+
+save_timer::save_timer( const save_part part ) : part( part ), outer( innermost_timer ),
+    start( std::chrono::steady_clock::now() )
+{
+    if( outer ) {
+        save_stats::add_time( outer->part, start - outer->start );
+    }
+    innermost_timer = this;
+}
+
+save_timer::~save_timer()
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    save_stats::add_time( part, now - start );
+    innermost_timer = outer;
+    if( outer ) {
+        outer->start = now;
+    }
+}
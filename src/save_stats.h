@@ -0,0 +1,96 @@
+#pragma once
+#ifndef CATA_SRC_SAVE_STATS_H
+#define CATA_SRC_SAVE_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "enum_traits.h"
+#include "point.h"
+
+class JsonOut;
+
+// What the last save spent its time and bytes on, by part of the world, so that it can
+// be seen which parts make saves slow or large.
+//
+// game::save starts a new report. Bytes are counted as serialized, before compression,
+// and only for files that were written: files that came out unchanged are counted
+// separately. Everything here is only called from the main thread.
+
+enum class save_part : int {
+    player,
+    map_memory,
+    master,
+    overmaps,
+    submaps,
+    other,
+    last
+};
+
+template<>
+struct enum_traits<save_part> {
+    static constexpr save_part last = save_part::last;
+};
+
+namespace save_stats
+{
+
+struct part_totals {
+    int files = 0;
+    int unchanged_files = 0;
+    size_t bytes = 0;
+    std::chrono::steady_clock::duration time{};
+};
+
+/** One quad of submaps, for the list of the largest ones. */
+struct quad_summary {
+    tripoint om_addr;
+    size_t bytes = 0;
+    int items = 0;
+};
+
+/** Forgets the previous save. */
+void begin_save();
+
+void add_file( save_part part, size_t bytes );
+void add_unchanged_file( save_part part );
+void add_time( save_part part, std::chrono::steady_clock::duration elapsed );
+/** Notes a serialized quad; the largest ones are kept. */
+void add_quad( const tripoint &om_addr, size_t bytes, int items );
+
+part_totals totals( save_part part );
+/** The largest quads of the last save, largest first. */
+std::vector<quad_summary> largest_quads();
+
+/** Human readable table of the last save. */
+std::string summary_table();
+
+void serialize( JsonOut &jsout );
+/** Writes @ref serialize to @ref report_path. */
+bool write_report();
+std::string report_path();
+
+} // namespace save_stats
+
+/**
+ * Adds the time between construction and destruction to a part of the save. Timers
+ * nest: while an inner one runs, the time goes to its part instead of the outer one.
+ */
+class save_timer
+{
+    public:
+        explicit save_timer( save_part part );
+        ~save_timer();
+
+        save_timer( const save_timer & ) = delete;
+        save_timer &operator=( const save_timer & ) = delete;
+
+    private:
+        save_part part;
+        save_timer *outer;
+        std::chrono::steady_clock::time_point start;
+};
+
+#endif // CATA_SRC_SAVE_STATS_H
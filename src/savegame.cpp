@@ -478,10 +478,18 @@ void overmap::load_monster_groups( JsonIn &jsin )
         mongroup new_group;
         new_group.deserialize( jsin.get_object() );
 
+        // Positions are a flat run of x, y, z triples, or in older saves one array each.
         jsin.start_array();
         tripoint_om_sm temp;
         while( !jsin.end_array() ) {
-            temp.deserialize( jsin );
+            if( jsin.test_array() ) {
+                temp.deserialize( jsin );
+            } else {
+                const int x = jsin.get_int();
+                const int y = jsin.get_int();
+                const int z = jsin.get_int();
+                temp = tripoint_om_sm( x, y, z );
+            }
             new_group.pos = temp;
             add_mon_group( new_group );
         }
@@ -505,39 +513,67 @@ void overmap::unserialize( std::istream &fin )
 {
     chkversion( fin );
     JsonIn jsin( fin );
+    // The terrain names each run of "layers" refers to by index.  Overmaps saved before
+    // there was such a list name the terrain in every run instead.
+    struct terrain_name {
+        std::string name;
+        oter_id id;
+        bool obsolete;
+    };
+    std::vector<terrain_name> terrain_names;
+    const auto resolve = [&]( const std::string & ter ) {
+        if( obsolete_terrain( ter ) ) {
+            return terrain_name{ ter, oter_id( 0 ), true };
+        } else if( oter_str_id( ter ).is_valid() ) {
+            return terrain_name{ ter, oter_id( ter ), false };
+        }
+        debugmsg( "Loaded bad ter!  ter %s", ter.c_str() );
+        return terrain_name{ ter, oter_id( 0 ), false };
+    };
     jsin.start_object();
     while( !jsin.end_object() ) {
         const std::string name = jsin.get_member_name();
-        if( name == "layers" ) {
+        if( name == "terrain_names" ) {
+            terrain_names.clear();
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                terrain_names.push_back( resolve( jsin.get_string() ) );
+            }
+        } else if( name == "layers" ) {
+            terrain_index.clear();
             std::unordered_map<tripoint_om_omt, std::string> needs_conversion;
             jsin.start_array();
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
                 jsin.start_array();
                 int count = 0;
-                std::string tmp_ter;
-                oter_id tmp_otid( 0 );
+                terrain_name named_ter;
+                const terrain_name *tmp_ter = nullptr;
                 for( int j = 0; j < OMAPY; j++ ) {
                     for( int i = 0; i < OMAPX; i++ ) {
                         if( count == 0 ) {
                             jsin.start_array();
-                            jsin.read( tmp_ter );
+                            if( jsin.test_string() ) {
+                                named_ter = resolve( jsin.get_string() );
+                                tmp_ter = &named_ter;
+                            } else {
+                                const int index = jsin.get_int();
+                                if( index < 0 ||
+                                    static_cast<size_t>( index ) >= terrain_names.size() ) {
+                                    jsin.error( "overmap terrain index out of range" );
+                                }
+                                tmp_ter = &terrain_names[index];
+                            }
                             jsin.read( count );
                             jsin.end_array();
-                            if( obsolete_terrain( tmp_ter ) ) {
+                            if( tmp_ter->obsolete ) {
                                 for( int p = i; p < i + count; p++ ) {
                                     needs_conversion.emplace(
-                                        tripoint_om_omt( p, j, z - OVERMAP_DEPTH ), tmp_ter );
+                                        tripoint_om_omt( p, j, z - OVERMAP_DEPTH ), tmp_ter->name );
                                 }
-                                tmp_otid = oter_id( 0 );
-                            } else if( oter_str_id( tmp_ter ).is_valid() ) {
-                                tmp_otid = oter_id( tmp_ter );
-                            } else {
-                                debugmsg( "Loaded bad ter!  ter %s", tmp_ter.c_str() );
-                                tmp_otid = oter_id( 0 );
                             }
                         }
                         count--;
-                        layer[z].terrain[i][j] = tmp_otid;
+                        layer[z].terrain[i][j] = tmp_ter->id;
                     }
                 }
                 jsin.end_array();
@@ -966,13 +1002,13 @@ void overmap::save_monster_groups( JsonOut &jout ) const
     jout.member( "monster_groups" );
     jout.start_array();
     // Bin groups by their fields, except positions and monsters
-    std::unordered_map<mongroup, std::list<tripoint_om_sm>, mongroup_hash, mongroup_bin_eq>
+    std::unordered_map<mongroup, std::vector<tripoint_om_sm>, mongroup_hash, mongroup_bin_eq>
     binned_groups;
     binned_groups.reserve( zg.size() );
     for( const auto &pos_group : zg ) {
         // Each group in bin adds only position
         // so that 100 identical groups are 1 group data and 100 tripoints
-        std::list<tripoint_om_sm> &positions = binned_groups[pos_group.second];
+        std::vector<tripoint_om_sm> &positions = binned_groups[pos_group.second];
         positions.emplace_back( pos_group.first );
     }
 
@@ -984,7 +1020,15 @@ void overmap::save_monster_groups( JsonOut &jout ) const
         mongroup saved_group = group_bin.first;
         saved_group.pos = tripoint_om_sm();
         jout.write( saved_group );
-        jout.write( group_bin.second );
+        // Hordes put thousands of groups in one bin, so the positions are one flat run
+        // of x, y, z triples rather than an array apiece.
+        jout.start_array();
+        for( const tripoint_om_sm &pos : group_bin.second ) {
+            jout.write( pos.x() );
+            jout.write( pos.y() );
+            jout.write( pos.z() );
+        }
+        jout.end_array();
         jout.end_array();
     }
     jout.end_array();
@@ -997,6 +1041,24 @@ void overmap::serialize( std::ostream &fout ) const
     JsonOut json( fout, false );
     json.start_object();
 
+    // Each terrain is named once, and the runs of "layers" refer to it by index.
+    std::unordered_map<int, int> terrain_indices;
+    json.member( "terrain_names" );
+    json.start_array();
+    for( const map_layer &l : layer ) {
+        for( int j = 0; j < OMAPY; j++ ) {
+            for( int i = 0; i < OMAPX; i++ ) {
+                const oter_id &t = l.terrain[i][j];
+                const int next_index = terrain_indices.size();
+                if( terrain_indices.emplace( t.to_i(), next_index ).second ) {
+                    json.write( t.id() );
+                }
+            }
+        }
+    }
+    json.end_array();
+    fout << std::endl;
+
     json.member( "layers" );
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
@@ -1015,7 +1077,7 @@ void overmap::serialize( std::ostream &fout ) const
                     }
                     last_tertype = t;
                     json.start_array();
-                    json.write( t.id() );
+                    json.write( terrain_indices.at( t.to_i() ) );
                     count = 1;
                 } else {
                     count++;
@@ -1412,7 +1474,7 @@ void faction_manager::deserialize( JsonIn &jsin )
 void creature_tracker::deserialize( JsonIn &jsin )
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_location_map();
     jsin.start_array();
     while( !jsin.end_array() ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
@@ -763,11 +763,13 @@ void Character::load( const JsonObject &data )
 
     data.read( "mutations", my_mutations );
 
+    mutation_bits.clear();
     for( auto it = my_mutations.begin(); it != my_mutations.end(); ) {
         const trait_id &mid = it->first;
         if( mid.is_valid() ) {
             on_mutation_gain( mid );
             cached_mutations.push_back( &mid.obj() );
+            set_mutation_bit( mid, true );
             ++it;
             // Remove after 0.G
         } else if( mid == trait_PARKOUR ) {
@@ -2791,6 +2793,7 @@ void item::io( Archive &archive )
     erase_if( item_tags, [&]( const flag_id & f ) {
         return !f.is_valid();
     } );
+    item_tag_bits.assign( item_tags );
 
     if( note_read ) {
         snip_id = SNIPPET.migrate_hash_to_id( note );
@@ -2826,13 +2829,9 @@ void item::io( Archive &archive )
     // Books without any chapters don't need to store a remaining-chapters
     // counter, it will always be 0 and it prevents proper stacking.
     if( get_chapters() == 0 ) {
-        for( auto it = item_vars.begin(); it != item_vars.end(); ) {
-            if( it->first.compare( 0, 19, "remaining-chapters-" ) == 0 ) {
-                item_vars.erase( it++ );
-            } else {
-                ++it;
-            }
-        }
+        item_vars.erase_if( []( const std::string & name ) {
+            return name.compare( 0, 19, "remaining-chapters-" ) == 0;
+        } );
     }
 
     // Remove stored translated gerund in favor of storing the inscription tool type
@@ -3061,7 +3060,7 @@ void vehicle_part::deserialize( const JsonObject &data )
     data.read( "mount_dx", mount.x );
     data.read( "mount_dy", mount.y );
     data.read( "open", open );
-    int direction_int;
+    int direction_int = 0;
     data.read( "direction", direction_int );
     direction = units::from_degrees( direction_int );
     data.read( "blood", blood );
@@ -3117,11 +3116,24 @@ void vehicle_part::serialize( JsonOut &json ) const
     json.member( "base", base );
     json.member( "mount_dx", mount.x );
     json.member( "mount_dy", mount.y );
-    json.member( "open", open );
-    json.member( "direction", std::lround( to_degrees( direction ) ) );
-    json.member( "blood", blood );
-    json.member( "enabled", enabled );
-    json.member( "flags", flags );
+    // Members still at the value a new part starts out with are left out, deserialize keeps
+    // those defaults; vehicles are most of the bulk of a map save.
+    if( open ) {
+        json.member( "open", open );
+    }
+    const long direction_degrees = std::lround( to_degrees( direction ) );
+    if( direction_degrees != 0 ) {
+        json.member( "direction", direction_degrees );
+    }
+    if( blood != 0 ) {
+        json.member( "blood", blood );
+    }
+    if( !enabled ) {
+        json.member( "enabled", enabled );
+    }
+    if( flags != 0 ) {
+        json.member( "flags", flags );
+    }
     if( !carry_names.empty() ) {
         std::stack<std::string, std::vector<std::string> > carry_copy = carry_names;
         json.member( "carry" );
@@ -3132,12 +3144,18 @@ void vehicle_part::serialize( JsonOut &json ) const
         }
         json.end_array();
     }
-    json.member( "passenger_id", passenger_id );
-    json.member( "crew_id", crew_id );
+    if( passenger_id != character_id() ) {
+        json.member( "passenger_id", passenger_id );
+    }
+    if( crew_id != character_id() ) {
+        json.member( "crew_id", crew_id );
+    }
     if( precalc[0].z ) {
         json.member( "z_offset", precalc[0].z );
     }
-    json.member( "items", items );
+    if( !items.empty() ) {
+        json.member( "items", items );
+    }
     if( target.first != tripoint_min ) {
         json.member( "target_first_x", target.first.x );
         json.member( "target_first_y", target.first.y );
@@ -3148,7 +3166,9 @@ void vehicle_part::serialize( JsonOut &json ) const
         json.member( "target_second_y", target.second.y );
         json.member( "target_second_z", target.second.z );
     }
-    json.member( "ammo_pref", ammo_pref );
+    if( !ammo_pref.is_null() ) {
+        json.member( "ammo_pref", ammo_pref );
+    }
     json.end_object();
 }
 
@@ -3739,6 +3759,7 @@ void Creature::load( const JsonObject &jsin )
     jsin.read( "underwater", underwater );
 
     jsin.read( "body", body );
+    body_index.parts.clear();
 
     fake = false; // see Creature::load
 
@@ -3785,10 +3806,11 @@ void player_morale::load( const JsonObject &jsin )
 {
     jsin.allow_omitted_members();
     jsin.read( "morale", points );
+    invalidate();
 }
 
 struct mm_elem {
-    memorized_terrain_tile tile;
+    mm_submap::packed_tile tile;
     int symbol;
 
     bool operator==( const mm_elem &rhs ) const {
@@ -3796,7 +3818,19 @@ struct mm_elem {
     }
 };
 
-void mm_submap::serialize( JsonOut &jsout ) const
+/** The tile names of one mm_region, in the order they are saved in. */
+struct mm_tile_palette {
+    std::unordered_map<uint32_t, int> index;
+    std::vector<uint32_t> ids;
+
+    void add( const uint32_t id ) {
+        if( index.emplace( id, static_cast<int>( ids.size() ) ).second ) {
+            ids.push_back( id );
+        }
+    }
+};
+
+void mm_submap::serialize( JsonOut &jsout, const mm_tile_palette &palette ) const
 {
     jsout.start_array();
 
@@ -3806,10 +3840,11 @@ void mm_submap::serialize( JsonOut &jsout ) const
     int num_same = 1;
 
     const auto write_seq = [&]() {
+        const memorized_terrain_tile tile = unpack( last.tile );
         jsout.start_array();
-        jsout.write( last.tile.tile );
-        jsout.write( last.tile.subtile );
-        jsout.write( last.tile.rotation );
+        jsout.write( palette.index.at( tile_id( last.tile ) ) );
+        jsout.write( tile.subtile );
+        jsout.write( tile.rotation );
         jsout.write( last.symbol );
         if( num_same != 1 ) {
             jsout.write( num_same );
@@ -3820,7 +3855,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     for( size_t y = 0; y < SEEY; y++ ) {
         for( size_t x = 0; x < SEEX; x++ ) {
             point p( x, y );
-            const mm_elem elem = { tile( p ), symbol( p ) };
+            const mm_elem elem = { packed( p ), symbol( p ) };
             if( x == 0 && y == 0 ) {
                 last = elem;
                 continue;
@@ -3839,7 +3874,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( JsonIn &jsin )
+void mm_submap::deserialize( JsonIn &jsin, const std::vector<uint32_t> &palette )
 {
     jsin.start_array();
 
@@ -3854,9 +3889,20 @@ void mm_submap::deserialize( JsonIn &jsin )
                 remaining -= 1;
             } else {
                 jsin.start_array();
-                elem.tile.tile = jsin.get_string();
-                elem.tile.subtile = jsin.get_int();
-                elem.tile.rotation = jsin.get_int();
+                memorized_terrain_tile tile;
+                uint32_t id = 0;
+                if( jsin.test_string() ) {
+                    id = intern_tile_name( jsin.get_string() );
+                } else {
+                    const int i = jsin.get_int();
+                    if( i < 0 || static_cast<size_t>( i ) >= palette.size() ) {
+                        jsin.error( "memorized tile index out of range" );
+                    }
+                    id = palette[i];
+                }
+                tile.subtile = jsin.get_int();
+                tile.rotation = jsin.get_int();
+                elem.tile = pack( tile ) | id;
                 elem.symbol = jsin.get_int();
                 if( jsin.test_int() ) {
                     remaining = jsin.get_int() - 1;
@@ -3865,9 +3911,7 @@ void mm_submap::deserialize( JsonIn &jsin )
             }
             point p( x, y );
             // Try to avoid assigning to save up on memory
-            if( elem.tile != mm_submap::default_tile ) {
-                set_tile( p, elem.tile );
-            }
+            set_packed( p, elem.tile );
             if( elem.symbol != mm_submap::default_symbol ) {
                 set_symbol( p, elem.symbol );
             }
@@ -3878,6 +3922,26 @@ void mm_submap::deserialize( JsonIn &jsin )
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    mm_tile_palette palette;
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            const shared_ptr_fast<mm_submap> &sm = submaps[x][y];
+            for( size_t sy = 0; sy < SEEY; sy++ ) {
+                for( size_t sx = 0; sx < SEEX; sx++ ) {
+                    palette.add( mm_submap::tile_id( sm->packed( point( sx, sy ) ) ) );
+                }
+            }
+        }
+    }
+
+    jsout.start_object();
+    jsout.member( "tile_names" );
+    jsout.start_array();
+    for( const uint32_t id : palette.ids ) {
+        jsout.write( mm_submap::tile_name( id ) );
+    }
+    jsout.end_array();
+    jsout.member( "submaps" );
     jsout.start_array();
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
         for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
@@ -3885,15 +3949,32 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, palette );
             }
         }
     }
     jsout.end_array();
+    jsout.end_object();
 }
 
 void mm_region::deserialize( JsonIn &jsin )
 {
+    // Regions saved before the tile names were pulled out are just the array of submaps.
+    std::vector<uint32_t> palette;
+    const bool has_palette = jsin.test_object();
+    if( has_palette ) {
+        jsin.start_object();
+        if( jsin.get_member_name() != "tile_names" ) {
+            jsin.error( "expected the tile names of the memory map region first" );
+        }
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            palette.push_back( mm_submap::intern_tile_name( jsin.get_string() ) );
+        }
+        if( jsin.get_member_name() != "submaps" ) {
+            jsin.error( "expected the submaps of the memory map region" );
+        }
+    }
     jsin.start_array();
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
         for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
@@ -3902,11 +3983,14 @@ void mm_region::deserialize( JsonIn &jsin )
             if( jsin.test_null() ) {
                 jsin.skip_null();
             } else {
-                sm->deserialize( jsin );
+                sm->deserialize( jsin, palette );
             }
         }
     }
     jsin.end_array();
+    if( has_palette ) {
+        jsin.end_object();
+    }
 }
 
 void map_memory::load_legacy( JsonIn &jsin )
@@ -4294,6 +4378,10 @@ void stats_tracker::deserialize( const JsonObject &jo )
         d.second.set_type( d.first );
     }
     jo.read( "initial_scores", initial_scores );
+    // Anything already derived from the events has to start again from the loaded ones.
+    for( const auto &p : event_type_watchers ) {
+        p.second.send_to_all( &event_multiset_watcher::events_reset, get_events( p.first ), *this );
+    }
 }
 
 void submap::store( JsonOut &jsout ) const
@@ -4303,44 +4391,36 @@ void submap::store( JsonOut &jsout ) const
 
     // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
     // this feature but the algorithm is backward compatible.
+    // Runs are found by comparing int ids; the string id is only looked up once per run.
     jsout.member( "terrain" );
     jsout.start_array();
-    std::string last_id;
-    int num_same = 1;
+    const auto write_run = [&jsout]( const ter_id & id, int num_same ) {
+        if( num_same == 1 ) {
+            // if there's only one element don't write as an array
+            jsout.write( id.id() );
+        } else {
+            jsout.start_array();
+            jsout.write( id.id() );
+            jsout.write( num_same );
+            jsout.end_array();
+        }
+    };
+    ter_id last_id = ter[0][0];
+    int num_same = 0;
     for( int j = 0; j < SEEY; j++ ) {
         // NOLINTNEXTLINE(modernize-loop-convert)
         for( int i = 0; i < SEEX; i++ ) {
-            const std::string this_id = ter[i][j].obj().id.str();
-            if( !last_id.empty() ) {
-                if( this_id == last_id ) {
-                    num_same++;
-                } else {
-                    if( num_same == 1 ) {
-                        // if there's only one element don't write as an array
-                        jsout.write( last_id );
-                    } else {
-                        jsout.start_array();
-                        jsout.write( last_id );
-                        jsout.write( num_same );
-                        jsout.end_array();
-                        num_same = 1;
-                    }
-                    last_id = this_id;
-                }
+            if( ter[i][j] == last_id ) {
+                num_same++;
             } else {
-                last_id = this_id;
+                write_run( last_id, num_same );
+                last_id = ter[i][j];
+                num_same = 1;
             }
         }
     }
     // Because of the RLE scheme we have to do one last pass
-    if( num_same == 1 ) {
-        jsout.write( last_id );
-    } else {
-        jsout.start_array();
-        jsout.write( last_id );
-        jsout.write( num_same );
-        jsout.end_array();
-    }
+    write_run( last_id, num_same );
     jsout.end_array();
 
     // Write out the radiation array in a simple RLE scheme.
@@ -4431,7 +4511,7 @@ void submap::store( JsonOut &jsout ) const
                     const field_entry &cur = elem.second;
                     jsout.write( cur.get_field_type().id() );
                     jsout.write( cur.get_field_intensity() );
-                    jsout.write( cur.get_field_age() );
+                    jsout.write( cur.get_field_age( last_touched ) );
                 }
                 jsout.end_array();
             }
@@ -4515,6 +4595,31 @@ void submap::store( JsonOut &jsout ) const
     }
 }
 
+namespace
+{
+// A submap uses only a handful of distinct terrains, furniture, traps and fields, but
+// names them over and over. Resolving each name once per array spares the interning
+// and factory lookups for the rest; the lists are short enough to search linearly.
+template<typename T>
+class id_palette
+{
+    public:
+        int_id<T> resolve( const std::string &name ) {
+            for( const std::pair<std::string, int_id<T>> &e : entries ) {
+                if( e.first == name ) {
+                    return e.second;
+                }
+            }
+            const int_id<T> id = string_id<T>( name ).id();
+            entries.emplace_back( name, id );
+            return id;
+        }
+
+    private:
+        std::vector<std::pair<std::string, int_id<T>>> entries;
+};
+} // namespace
+
 void submap::load( JsonIn &jsin, const std::string &member_name, int version )
 {
     bool rubpow_update = version < 22;
@@ -4561,15 +4666,16 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
             // terrain is encoded using simple RLE
             int remaining = 0;
             int_id<ter_t> iid;
+            id_palette<ter_t> palette;
             for( int j = 0; j < SEEY; j++ ) {
                 // NOLINTNEXTLINE(modernize-loop-convert)
                 for( int i = 0; i < SEEX; i++ ) {
                     if( !remaining ) {
                         if( jsin.test_string() ) {
-                            iid = ter_str_id( jsin.get_string() ).id();
+                            iid = palette.resolve( jsin.get_string() );
                         } else if( jsin.test_array() ) {
                             jsin.start_array();
-                            iid = ter_str_id( jsin.get_string() ).id();
+                            iid = palette.resolve( jsin.get_string() );
                             remaining = jsin.get_int() - 1;
                             jsin.end_array();
                         } else {
@@ -4600,12 +4706,13 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
             }
         }
     } else if( member_name == "furniture" ) {
+        id_palette<furn_t> palette;
         jsin.start_array();
         while( !jsin.end_array() ) {
             jsin.start_array();
             int i = jsin.get_int();
             int j = jsin.get_int();
-            frn[i][j] = furn_id( jsin.get_string() );
+            frn[i][j] = palette.resolve( jsin.get_string() );
             jsin.end_array();
         }
     } else if( member_name == "items" ) {
@@ -4633,6 +4740,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
             }
         }
     } else if( member_name == "traps" ) {
+        id_palette<trap> palette;
         jsin.start_array();
         while( !jsin.end_array() ) {
             jsin.start_array();
@@ -4640,11 +4748,11 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
             int j = jsin.get_int();
             const point p( i, j );
             // TODO: jsin should support returning an id like jsin.get_id<trap>()
-            const trap_str_id trid( jsin.get_string() );
-            trp[p.x][p.y] = trid.id();
+            trp[p.x][p.y] = palette.resolve( jsin.get_string() );
             jsin.end_array();
         }
     } else if( member_name == "fields" ) {
+        id_palette<field_type> palette;
         jsin.start_array();
         while( !jsin.end_array() ) {
             // Coordinates loop
@@ -4664,11 +4772,12 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                 int age = jsin.get_int();
                 field_type_id ft;
                 if( !type_str.empty() ) {
-                    ft = field_type_id( type_str );
+                    ft = palette.resolve( type_str );
                 } else {
                     ft = field_types::get_field_type_by_legacy_enum( type_int ).id;
                 }
                 if( fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) ) ) {
+                    mark_field_tile( { i, j } );
                     field_count++;
                 }
             }
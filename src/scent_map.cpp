@@ -1,6 +1,8 @@
 #include "scent_map.h"
 
 #include <algorithm>
+#include <array>
+#include <climits>
 #include <cstdlib>
 #include <new>
 
@@ -170,11 +172,37 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
+    // for loop constants
+    const int scentmap_minx = center.x - SCENT_RADIUS;
+    const int scentmap_maxx = center.x + SCENT_RADIUS;
+    const int scentmap_miny = center.y - SCENT_RADIUS;
+    const int scentmap_maxy = center.y + SCENT_RADIUS;
+
+    // Scent only ever spreads to the neighbours of scented squares, everything else stays at
+    // zero. Shrink the update to the squares next to some scent, often that is nothing at all.
+    point scented_min( INT_MAX, INT_MAX );
+    point scented_max( INT_MIN, INT_MIN );
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        const std::array<int, MAPSIZE_Y> &column = grscent[x];
+        for( int y = scentmap_miny - 1; y <= scentmap_maxy + 1; ++y ) {
+            if( column[y] != 0 ) {
+                scented_min.x = std::min( scented_min.x, x );
+                scented_max.x = x;
+                scented_min.y = std::min( scented_min.y, y );
+                scented_max.y = std::max( scented_max.y, y );
+            }
+        }
+    }
+    const int minx = std::max( scentmap_minx, scented_min.x - 1 );
+    const int maxx = std::min( scentmap_maxx, scented_max.x + 1 );
+    const int miny = std::max( scentmap_miny, scented_min.y - 1 );
+    const int maxy = std::min( scentmap_maxy, scented_max.y + 1 );
+    if( minx > maxx || miny > maxy ) {
+        return;
+    }
 
-    // These two matrices are transposed so that x addresses are contiguous in memory
+    // These are indexed [x][y] like grscent, so that the inner loops over y below run along
+    // contiguous memory and without branches, which lets the compiler vectorize them.
     scent_array<int> sum_3_scent_y;
     scent_array<int> squares_used_y;
 
@@ -182,79 +210,62 @@ void scent_map::update( const tripoint &center, map &m )
     scent_array<bool> blocks_scent; // currently only ter_furn_flag::TFLAG_NO_SCENT blocks scent
     scent_array<bool> reduces_scent;
 
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
-
     // decrease this to reduce gas spread. Keep it under 125 for
     // stability. This is essentially a decimal number * 1000.
     const int diffusivity = 100;
 
     // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+    m.scent_blockers( blocks_scent, reduces_scent, point( minx - 1, miny - 1 ),
+                      point( maxx + 1, maxy + 1 ) );
     // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
     // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
+    // is a net performance improvement over the old code.
     // note: this method needs an array that is one square larger on each side in the x direction
     // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
     // MAPSIZE_X, but if that changes, this may need tweaking.
-    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        // How much each square of the column takes part in diffusion, and its weighted scent.
+        // Only 20% of scent can diffuse on REDUCE_SCENT squares, none on NO_SCENT ones.
+        std::array<int, MAPSIZE_Y> weight;
+        std::array<int, MAPSIZE_Y> weighted_scent;
+        for( int y = miny - 1; y <= maxy + 1; ++y ) {
+            weight[y] = blocks_scent[x][y] ? 0 : reduces_scent[x][y] ? 2 : 10;
+            weighted_scent[y] = weight[y] * grscent[x][y];
+        }
+        for( int y = miny; y <= maxy; ++y ) {
             // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+            sum_3_scent_y[x][y] = weighted_scent[y - 1] + weighted_scent[y] + weighted_scent[y + 1];
+            squares_used_y[x][y] = weight[y - 1] + weight[y] + weight[y + 1];
         }
     }
 
     // Rest of the scent map
-    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            int &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring REDUCE_SCENT squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent via NO_SCENT (in json)
-                scent_here = 0;
-            }
+    for( int x = minx; x <= maxx; ++x ) {
+        std::array<int, MAPSIZE_Y> &column = grscent[x];
+        for( int y = miny; y <= maxy; ++y ) {
+            const int scent_here = column[y];
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int squares_used = squares_used_y[x - 1][y]
+                                     + squares_used_y[x][y]
+                                     + squares_used_y[x + 1][y];
+            //less air movement for REDUCE_SCENT square
+            const int this_diffusivity = reduces_scent[x][y] ? diffusivity / 5 : diffusivity;
+            // take the old scent and subtract what diffuses out
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            // neighboring REDUCE_SCENT squares absorb some scent
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            // we've already summed neighboring scent values in the y direction in the previous
+            // loop. Now we do it for the x direction, multiply by diffusion, and this is what
+            // diffuses into our current square.
+            const int diffused =
+                ( temp_scent
+                  + this_diffusivity * ( sum_3_scent_y[x - 1][y]
+                                         + sum_3_scent_y[x][y]
+                                         + sum_3_scent_y[x + 1][y] )
+                ) / ( 1000 * 10 );
+            // cells that block scent via NO_SCENT (in json) hold none
+            column[y] = blocks_scent[x][y] ? 0 : diffused;
         }
     }
 }
@@ -74,7 +74,7 @@ std::unique_ptr<Font> Font::load_font( SDL_Renderer_Ptr &renderer, SDL_PixelForm
     }
     // Not loaded as bitmap font (or it failed), try to load as truetype
     try {
-        return std::unique_ptr<Font>( std::make_unique<CachedTTFFont>( width, height,
+        return std::unique_ptr<Font>( std::make_unique<CachedTTFFont>( renderer, width, height,
                                       palette, typeface, fontsize, fontblending ) );
     } catch( std::exception &err ) {
         dbg( D_ERROR ) << "Failed to load font " << typeface << ": " << err.what();
@@ -180,11 +180,13 @@ void Font::draw_ascii_lines( const SDL_Renderer_Ptr &renderer, const GeometryRen
 }
 
 CachedTTFFont::CachedTTFFont(
+    const SDL_Renderer_Ptr &renderer,
     const int w, const int h,
     const palette_array &palette,
     std::string typeface, int fontsize,
     const bool fontblending )
     : Font( w, h, palette )
+    , glyphs( renderer )
     , fontblending( fontblending )
 {
     int faceIndex = 0;
@@ -278,12 +280,11 @@ CachedTTFFont::CachedTTFFont(
     TTF_SetFontStyle( font.get(), TTF_STYLE_NORMAL );
 }
 
-SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
-        const std::string &ch,
-        const int color )
+SDL_Surface_Ptr CachedTTFFont::create_glyph( const std::string &ch )
 {
     const auto function = fontblending ? TTF_RenderUTF8_Blended : TTF_RenderUTF8_Solid;
-    SDL_Surface_Ptr sglyph( function( font.get(), ch.c_str(), windowsPalette[color] ) );
+    constexpr SDL_Color white{255, 255, 255, 255};
+    SDL_Surface_Ptr sglyph( function( font.get(), ch.c_str(), white ) );
     if( !sglyph ) {
         dbg( D_ERROR ) << "Failed to create glyph for " << ch << ": " << TTF_GetError();
         return nullptr;
@@ -323,12 +324,61 @@ SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
         src_rect.h = dst_rect.h;
     }
 
-    if( !printErrorIf( SDL_BlitSurface( sglyph.get(), &src_rect, surface.get(), &dst_rect ) != 0,
-                       "SDL_BlitSurface failed" ) ) {
-        sglyph = std::move( surface );
+    if( printErrorIf( SDL_BlitSurface( sglyph.get(), &src_rect, surface.get(), &dst_rect ) != 0,
+                      "SDL_BlitSurface failed" ) ) {
+        return nullptr;
     }
+    return surface;
+}
 
-    return CreateTextureFromSurface( renderer, sglyph );
+CachedTTFFont::cached_t CachedTTFFont::add_to_atlas( const SDL_Renderer_Ptr &renderer,
+        const SDL_Surface_Ptr &glyph )
+{
+    cached_t ret{ nullptr, { 0, 0, 0, 0 } };
+    if( !glyph ) {
+        return ret;
+    }
+    if( atlas_pages.empty() ) {
+        SDL_RendererInfo info;
+        int max_size = 0;
+        if( SDL_GetRendererInfo( renderer.get(), &info ) == 0 ) {
+            max_size = std::min( info.max_texture_width, info.max_texture_height );
+        }
+        const int size = max_size > 0 ? std::min( 1024, max_size ) : 1024;
+        page_size = point( size, size );
+    }
+    // Glyphs are kept a pixel apart, so that scaling them never blends in their neighbours.
+    if( glyph->w + 1 > page_size.x || glyph->h + 1 > page_size.y ) {
+        dbg( D_ERROR ) << "Glyph of " << glyph->w << "x" << glyph->h << " does not fit the atlas";
+        return ret;
+    }
+    if( !atlas_pages.empty() && next_glyph.x + glyph->w + 1 > page_size.x ) {
+        next_glyph = point( 0, next_glyph.y + height + 1 );
+    }
+    if( atlas_pages.empty() || next_glyph.y + glyph->h + 1 > page_size.y ) {
+        SDL_Texture_Ptr page = CreateTexture( renderer, SDL_PIXELFORMAT_RGBA32,
+                                              SDL_TEXTUREACCESS_STATIC, page_size.x, page_size.y );
+        if( !page ) {
+            return ret;
+        }
+        // Clear the page, so that the gaps between the glyphs are transparent.
+        const std::vector<Uint32> blank( static_cast<size_t>( page_size.x ) * page_size.y, 0 );
+        printErrorIf( SDL_UpdateTexture( page.get(), nullptr, blank.data(),
+                                         page_size.x * sizeof( Uint32 ) ) != 0,
+                      "SDL_UpdateTexture failed" );
+        SetTextureBlendMode( page, SDL_BLENDMODE_BLEND );
+        atlas_pages.emplace_back( std::move( page ) );
+        next_glyph = point_zero;
+    }
+    const SDL_Rect dst{ next_glyph.x, next_glyph.y, glyph->w, glyph->h };
+    if( printErrorIf( SDL_UpdateTexture( atlas_pages.back().get(), &dst, glyph->pixels,
+                                         glyph->pitch ) != 0, "SDL_UpdateTexture failed" ) ) {
+        return ret;
+    }
+    next_glyph.x += glyph->w + 1;
+    ret.page = atlas_pages.back().get();
+    ret.src = dst;
+    return ret;
 }
 
 bool CachedTTFFont::isGlyphProvided( const std::string &ch ) const
@@ -348,32 +398,37 @@ void CachedTTFFont::OutputChar( const SDL_Renderer_Ptr &renderer, const Geometry
                                 const std::string &ch, const point &p,
                                 unsigned char color, const float opacity )
 {
-    key_t    key {ch, static_cast<unsigned char>( color & 0xf )};
-
-    auto it = glyph_cache_map.find( key );
+    auto it = glyph_cache_map.find( ch );
     if( it == std::end( glyph_cache_map ) ) {
-        cached_t new_entry {
-            create_glyph( renderer, key.codepoints, key.color ),
-            static_cast<int>( width * utf8_wrapper( key.codepoints ).display_width() )
-        };
-        it = glyph_cache_map.insert( std::make_pair( std::move( key ), std::move( new_entry ) ) ).first;
+        it = glyph_cache_map.emplace( ch, add_to_atlas( renderer, create_glyph( ch ) ) ).first;
     }
     const cached_t &value = it->second;
 
-    if( !value.texture ) {
+    if( !value.page ) {
         // Nothing we can do here )-:
         return;
     }
-    SDL_Rect rect {p.x, p.y, value.width, height};
-    if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), opacity * 255.0f );
-    }
-    RenderCopy( renderer, value.texture, nullptr, &rect );
-    if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), 255 );
+    const SDL_Rect rect {p.x, p.y, value.src.w, value.src.h};
+    SDL_Color tint = windowsPalette[color & 0xf];
+    tint.a = static_cast<Uint8>( opacity * 255.0f );
+    printErrorIf( glyphs.add( value.page, value.src, rect, 0, SDL_FLIP_NONE, tint ) != 0,
+                  "SDL_RenderCopyEx failed" );
+    if( !batching ) {
+        glyphs.flush();
     }
 }
 
+void CachedTTFFont::begin_batch()
+{
+    batching = true;
+}
+
+void CachedTTFFont::end_batch()
+{
+    glyphs.flush();
+    batching = false;
+}
+
 BitmapFont::BitmapFont(
     SDL_Renderer_Ptr &renderer, SDL_PixelFormat_Ptr &format,
     const int w, const int h,
@@ -610,4 +665,18 @@ void FontFallbackList::OutputChar( const SDL_Renderer_Ptr &renderer,
     ( *cached->second )->OutputChar( renderer, geometry, ch, p, color, opacity );
 }
 
+void FontFallbackList::begin_batch()
+{
+    for( const std::unique_ptr<Font> &font : fonts ) {
+        font->begin_batch();
+    }
+}
+
+void FontFallbackList::end_batch()
+{
+    for( const std::unique_ptr<Font> &font : fonts ) {
+        font->end_batch();
+    }
+}
+
 #endif // TILES
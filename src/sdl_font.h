@@ -12,6 +12,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "sdl_geometry.h"
 #include "color.h"
@@ -20,6 +21,7 @@
 #include "font_loader.h"
 #include "point.h"
 #include "hash_utils.h"
+#include "sdl_sprite_batch.h"
 #include "sdl_wrappers.h"
 
 using palette_array = std::array<SDL_Color, color_loader<SDL_Color>::COLOR_NAMES_COUNT>;
@@ -52,6 +54,12 @@ class Font
                                        const GeometryRenderer_Ptr &geometry,
                                        unsigned char line_id, const point &p, unsigned char color ) const;
 
+        /// Allow the characters drawn from now on to be held back and drawn together. Until
+        /// @ref end_batch, only other characters of this font may be drawn over them.
+        virtual void begin_batch() { }
+        /// Draw the characters held back since @ref begin_batch.
+        virtual void end_batch() { }
+
         /// Try to load a font by typeface (Bitmap or Truetype).
         static std::unique_ptr<Font> load_font(
             SDL_Renderer_Ptr &renderer, SDL_PixelFormat_Ptr &format,
@@ -74,6 +82,7 @@ class CachedTTFFont : public Font
 {
     public:
         CachedTTFFont(
+            const SDL_Renderer_Ptr &renderer,
             int w, int h,
             const palette_array &palette,
             std::string typeface, int fontsize, bool fontblending );
@@ -84,37 +93,34 @@ class CachedTTFFont : public Font
                          const std::string &ch,
                          const point &p,
                          unsigned char color, float opacity = 1.0f ) override;
+        void begin_batch() override;
+        void end_batch() override;
     protected:
-        SDL_Texture_Ptr create_glyph( const SDL_Renderer_Ptr &renderer, const std::string &ch, int color );
+        /** Renders ch in white, centered in a surface of the size of its cells. */
+        SDL_Surface_Ptr create_glyph( const std::string &ch );
 
         TTF_Font_Ptr font;
-        // Maps (character code, color) to SDL_Texture*
-
-        struct key_t {
-            std::string   codepoints;
-            unsigned char color;
-
-            std::pair<std::string, unsigned char> as_pair() const {
-                return std::make_pair( codepoints, color );
-            }
-
-            friend bool operator==( const key_t &lhs, const key_t &rhs ) noexcept {
-                return lhs.as_pair() == rhs.as_pair();
-            }
-        };
-
-        struct key_t_hash {
-            size_t operator()( const key_t &k ) const {
-                return cata::auto_hash<std::pair<std::string, unsigned char>>()( k.as_pair() );
-            }
-        };
 
+        /**
+         * Glyphs are rendered once in white onto pages of an atlas, and tinted with the
+         * color they are drawn in, so that text of any color is drawn from a few textures.
+         */
         struct cached_t {
-            SDL_Texture_Ptr texture;
-            int          width;
+            // The atlas page the glyph is on, null if it could not be rendered.
+            SDL_Texture *page;
+            SDL_Rect src;
         };
+        cached_t add_to_atlas( const SDL_Renderer_Ptr &renderer, const SDL_Surface_Ptr &glyph );
+
+        std::unordered_map<std::string, cached_t> glyph_cache_map;
+        std::vector<SDL_Texture_Ptr> atlas_pages;
+        // The size of every page, and where the next glyph goes on the last page: glyphs are
+        // packed in rows as high as the font.
+        point page_size;
+        point next_glyph;
 
-        std::unordered_map<key_t, cached_t, key_t_hash> glyph_cache_map;
+        sprite_batch glyphs;
+        bool batching = false;
 
         const bool fontblending;
 };
@@ -164,6 +170,8 @@ class FontFallbackList : public Font
                          const std::string &ch,
                          const point &p,
                          unsigned char color, float opacity = 1.0f ) override;
+        void begin_batch() override;
+        void end_batch() override;
     protected:
         std::vector<std::unique_ptr<Font>> fonts;
         std::map<std::string, std::vector<std::unique_ptr<Font>>::iterator> glyph_font;
@@ -0,0 +1,122 @@
+#if defined(TILES)
+#include "sdl_sprite_batch.h"
+
+#include <array>
+#include <utility>
+
+#include "sdl_utils.h"
+
+sprite_batch::sprite_batch( const SDL_Renderer_Ptr &renderer ) : renderer( renderer )
+{
+}
+
+// Draws a sprite right away, tinting the texture just for it.
+static int render_copy_tinted( const SDL_Renderer_Ptr &renderer, SDL_Texture *const tex,
+                               const SDL_Rect &src, const SDL_Rect &dst, const int angle,
+                               const SDL_RendererFlip flip, const SDL_Color &color )
+{
+    const bool modulated = color.r != 0xFF || color.g != 0xFF || color.b != 0xFF;
+    const bool translucent = color.a != 0xFF;
+    if( modulated ) {
+        SDL_SetTextureColorMod( tex, color.r, color.g, color.b );
+    }
+    if( translucent ) {
+        SDL_SetTextureAlphaMod( tex, color.a );
+    }
+    const int ret = SDL_RenderCopyEx( renderer.get(), tex, &src, &dst, angle, nullptr, flip );
+    if( modulated ) {
+        SDL_SetTextureColorMod( tex, 0xFF, 0xFF, 0xFF );
+    }
+    if( translucent ) {
+        SDL_SetTextureAlphaMod( tex, 0xFF );
+    }
+    return ret;
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+int sprite_batch::add( SDL_Texture *const tex, const SDL_Rect &src, const SDL_Rect &dst,
+                       const int angle, const SDL_RendererFlip flip, const SDL_Color &color )
+{
+    if( angle % 90 != 0 ) {
+        flush();
+        return render_copy_tinted( renderer, tex, src, dst, angle, flip, color );
+    }
+    if( tex != this->tex ) {
+        flush();
+        this->tex = tex;
+        if( SDL_QueryTexture( tex, nullptr, nullptr, &tex_size.x, &tex_size.y ) != 0 ) {
+            this->tex = nullptr;
+            return -1;
+        }
+    }
+
+    float u0 = static_cast<float>( src.x ) / tex_size.x;
+    float u1 = static_cast<float>( src.x + src.w ) / tex_size.x;
+    float v0 = static_cast<float>( src.y ) / tex_size.y;
+    float v1 = static_cast<float>( src.y + src.h ) / tex_size.y;
+    if( flip & SDL_FLIP_HORIZONTAL ) {
+        std::swap( u0, u1 );
+    }
+    if( flip & SDL_FLIP_VERTICAL ) {
+        std::swap( v0, v1 );
+    }
+    // The corners clockwise from the top left, relative to the center of dst.
+    const float half_w = dst.w / 2.0f;
+    const float half_h = dst.h / 2.0f;
+    std::array<SDL_Vertex, 4> corners = { {
+            { { -half_w, -half_h }, color, { u0, v0 } },
+            { { half_w, -half_h }, color, { u1, v0 } },
+            { { half_w, half_h }, color, { u1, v1 } },
+            { { -half_w, half_h }, color, { u0, v1 } }
+        }
+    };
+    // Turned clockwise, as the y axis points down.
+    const int quarter_turns = ( angle / 90 % 4 + 4 ) % 4;
+    const SDL_FPoint center = { dst.x + half_w, dst.y + half_h };
+    for( SDL_Vertex &corner : corners ) {
+        for( int i = 0; i < quarter_turns; ++i ) {
+            corner.position = { -corner.position.y, corner.position.x };
+        }
+        corner.position.x += center.x;
+        corner.position.y += center.y;
+    }
+
+    const int first = static_cast<int>( vertices.size() );
+    vertices.insert( vertices.end(), corners.begin(), corners.end() );
+    for( const int corner : {
+             0, 1, 2, 0, 2, 3
+         } ) {
+        indices.push_back( first + corner );
+    }
+    return 0;
+}
+
+void sprite_batch::flush()
+{
+    if( !indices.empty() ) {
+        printErrorIf( SDL_RenderGeometry( renderer.get(), tex, vertices.data(),
+                                          static_cast<int>( vertices.size() ), indices.data(),
+                                          static_cast<int>( indices.size() ) ) != 0,
+                      "SDL_RenderGeometry failed" );
+        vertices.clear();
+        indices.clear();
+    }
+    tex = nullptr;
+}
+
+#else
+
+int sprite_batch::add( SDL_Texture *const tex, const SDL_Rect &src, const SDL_Rect &dst,
+                       const int angle, const SDL_RendererFlip flip, const SDL_Color &color )
+{
+    return render_copy_tinted( renderer, tex, src, dst, angle, flip, color );
+}
+
+void sprite_batch::flush()
+{
+}
+
+#endif
+
+#endif // TILES
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef CATA_SRC_SDL_SPRITE_BATCH_H
+#define CATA_SRC_SDL_SPRITE_BATCH_H
+
+#if defined(TILES)
+#include <vector>
+
+#include "point.h"
+#include "sdl_wrappers.h"
+
+/**
+ * Collects sprites and hands them to the renderer in as few calls as possible: the sprites
+ * added one after another from the same texture are drawn by one SDL_RenderGeometry call.
+ * That needs SDL 2.0.18, with older versions every sprite is drawn right away.
+ *
+ * Whatever is drawn in another way while sprites are collected has to @ref flush them
+ * first, so that everything overlaps in the order it was drawn in.
+ */
+class sprite_batch
+{
+    public:
+        explicit sprite_batch( const SDL_Renderer_Ptr &renderer );
+
+        /** Whether sprites are collected, rather than drawn right away. */
+        static constexpr bool collects() {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * Draws the part src of tex into dst, like SDL_RenderCopyEx turning it around the
+         * center of dst, with its colors multiplied by color.  Only sprites turned by a
+         * multiple of 90 degrees are collected.
+         * @return 0 on success, like SDL_RenderCopyEx.
+         */
+        int add( SDL_Texture *tex, const SDL_Rect &src, const SDL_Rect &dst, int angle,
+                 SDL_RendererFlip flip, const SDL_Color &color );
+
+        /** Draws the sprites collected so far. */
+        void flush();
+
+    private:
+        const SDL_Renderer_Ptr &renderer;
+        // The texture of the sprites collected so far, and its size in pixels.
+        SDL_Texture *tex = nullptr;
+        point tex_size;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+#endif
+};
+
+#endif // TILES
+
+#endif // CATA_SRC_SDL_SPRITE_BATCH_H
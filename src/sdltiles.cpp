@@ -1292,10 +1292,10 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
         }
     }
 
-    // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
-    static const std::string space_string = " ";
-
     bool update = false;
+    // Each character is drawn inside its own cells, after their background, so characters
+    // may be drawn later than the backgrounds of the cells after them.
+    font->begin_batch();
     for( int j = 0; j < win->height; j++ ) {
         if( !win->line[j].touched ) {
             continue;
@@ -1338,21 +1338,22 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
             }
 
             // Spaces are used a lot, so this does help noticeably
-            if( cell.ch == space_string ) {
+            if( cell.ch == " " ) {
                 geometry->rect( renderer, draw, font->width, font->height,
                                 color_as_sdl( cell.BG ) );
                 continue;
             }
-            const int codepoint = UTF8_getch( cell.ch );
+            const std::string ch = cell.ch.str();
+            const int codepoint = UTF8_getch( ch );
             const catacurses::base_color FG = cell.FG;
             const catacurses::base_color BG = cell.BG;
-            int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( cell.ch );
+            int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( ch );
             if( cw < 1 ) {
                 // utf8_width() may return a negative width
                 continue;
             }
             bool use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
-            unsigned char uc = static_cast<unsigned char>( cell.ch[0] );
+            unsigned char uc = static_cast<unsigned char>( ch[0] );
             switch( codepoint ) {
                 case LINE_XOXO_UNICODE:
                     uc = LINE_XOXO_C;
@@ -1399,10 +1400,11 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
             if( use_draw_ascii_lines_routine ) {
                 font->draw_ascii_lines( renderer, geometry, uc, draw, FG );
             } else {
-                font->OutputChar( renderer, geometry, cell.ch, draw, FG );
+                font->OutputChar( renderer, geometry, ch, draw, FG );
             }
         }
     }
+    font->end_batch();
     win->draw = false; //We drew the window, mark it as so
     //Keeping track of last drawn window and tilemode zoom level
     ::winBuffer = w.weak_ptr();
@@ -3168,6 +3170,10 @@ static void CheckMessages()
                 }
                 break;
             case SDL_RENDER_TARGETS_RESET:
+                // The contents of the textures we render to are gone.
+                if( tilecontext ) {
+                    tilecontext->forget_retained_frame();
+                }
                 need_redraw = true;
                 needupdate = true;
                 break;
@@ -122,6 +122,19 @@ void castLightAll( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
                    const point &offset, int offsetDistance = 0,
                    T numerator = 1.0 );
 
+// Same result as castLightAll, but the eight octants are cast at the same time on the
+// shared thread_pool. Each octant casts into a private grid seeded from output_cache
+// and the grids are merged afterwards with update_output, so update_output must be a
+// max-style merge (as update_light is) for the result to match castLightAll.
+template<typename T, T( *calc )( const T &, const T &, const int & ),
+         bool( *check )( const T &, const T & ),
+         void( *update_output )( T &, const T &, quadrant ),
+         T( *accumulate )( const T &, const T &, const int & )>
+void castLightAllParallel( T( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                           const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                           const point &offset, int offsetDistance = 0,
+                           T numerator = 1.0 );
+
 template<typename T>
 using array_of_grids_of = std::array<T( * )[MAPSIZE_X][MAPSIZE_Y], OVERMAP_LAYERS>;
 
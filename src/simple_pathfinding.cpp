@@ -1,5 +1,6 @@
 #include "simple_pathfinding.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <queue>
@@ -62,24 +63,53 @@ directed_path<point> greedy_path( const point &source, const point &dest, const
                 cata::nullopt ).node_cost < 0 ) {
         return res;
     }
+
+    // Overmap generation lays out hundreds of connections, so the search state of one is
+    // kept for the next. A tile's entries are only meaningful if its stamp is this search's.
+    static std::vector<unsigned> seen;
+    static std::vector<bool> closed;
+    static std::vector<int> open;
+    static std::vector<short> dirs;
+    static std::vector<Node> nodes;
+    static unsigned search = 0;
     const size_t map_size = static_cast<size_t>( max.x * max.y );
-    std::vector<bool> closed( map_size, false );
-    std::vector<int> open( map_size, 0 );
-    std::vector<short> dirs( map_size, 0 );
-    std::priority_queue<Node, std::vector<Node>> nodes[2];
+    if( seen.size() < map_size || ++search == 0 ) {
+        seen.assign( std::max( seen.size(), map_size ), 0 );
+        closed.resize( seen.size() );
+        open.resize( seen.size() );
+        dirs.resize( seen.size() );
+        search = 1;
+    }
+    const auto visit = [&]( const int n ) {
+        if( seen[n] != search ) {
+            seen[n] = search;
+            closed[n] = false;
+            open[n] = 0;
+            dirs[n] = 0;
+        }
+    };
+    // The heap keeps nodes that were improved on, and drops them once they come out closed.
+    nodes.clear();
+    const auto push = [&]( const Node & node ) {
+        nodes.push_back( node );
+        std::push_heap( nodes.begin(), nodes.end() );
+    };
 
-    int i = 0;
-    nodes[i].push( first_node );
+    push( first_node );
+    visit( map_index( source ) );
     open[map_index( source )] = std::numeric_limits<int>::max();
-    while( !nodes[i].empty() ) {
-        const Node mn( nodes[i].top() ); // get the best-looking node
-        nodes[i].pop();
+    while( !nodes.empty() ) {
+        std::pop_heap( nodes.begin(), nodes.end() );
+        const Node mn( nodes.back() ); // get the best-looking node
+        nodes.pop_back();
+        if( closed[map_index( mn.pos )] ) {
+            continue;
+        }
         // mark it visited
         closed[map_index( mn.pos )] = true;
         // if we've reached the end, draw the path and return
         if( mn.pos == dest ) {
             point p = mn.pos;
-            res.nodes.reserve( nodes[i].size() );
             while( p != source ) {
                 const int n = map_index( p );
                 const om_direction::type dir = static_cast<om_direction::type>( dirs[n] );
@@ -91,9 +121,13 @@ directed_path<point> greedy_path( const point &source, const point &dest, const
         }
         for( om_direction::type dir : om_direction::all ) {
             const point p = mn.pos + om_direction::displace( dir );
-            const int n = map_index( p );
             // don't allow out of bounds or already traversed tiles
-            if( !inbounds( p ) || closed[n] ) {
+            if( !inbounds( p ) ) {
+                continue;
+            }
+            const int n = map_index( p );
+            visit( n );
+            if( closed[n] ) {
                 continue;
             }
             const node_score score = scorer( directed_node<point>( p, dir ), directed_node<point>( mn.pos,
@@ -105,23 +139,8 @@ directed_path<point> greedy_path( const point &source, const point &dest, const
             // record direction to shortest path
             if( open[n] == 0 || open[n] > priority ) {
                 dirs[n] = ( static_cast<int>( dir ) + 2 ) % 4;
-                if( open[n] != 0 ) {
-                    while( nodes[i].top().pos != p ) {
-                        nodes[1 - i].push( nodes[i].top() );
-                        nodes[i].pop();
-                    }
-                    nodes[i].pop();
-                    if( nodes[i].size() > nodes[1 - i].size() ) {
-                        i = 1 - i;
-                    }
-                    while( !nodes[i].empty() ) {
-                        nodes[1 - i].push( nodes[i].top() );
-                        nodes[i].pop();
-                    }
-                    i = 1 - i;
-                }
                 open[n] = priority;
-                nodes[i].emplace( p, dir, priority );
+                push( Node( p, dir, priority ) );
             }
         }
     }
@@ -141,6 +141,39 @@ float scaled_octave_noise_3d( const float octaves, const float persistence, cons
                             z ) * ( hiBound - loBound ) / 2 + ( hiBound + loBound ) / 2;
 }
 
+// 3D Scaled Multi-octave Simplex noise over a row of consecutive y.
+//
+// Sums the octaves of each point in the same order as scaled_octave_noise_3d,
+// so the results match it bit for bit.
+void scaled_octave_noise_3d_row( const float octaves, const float persistence, const float scale,
+                                 const float loBound, const float hiBound, const float x,
+                                 const int y_begin, const int count, const float z, float *out )
+{
+    for( int n = 0; n < count; n++ ) {
+        out[n] = 0.0f;
+    }
+    float frequency = scale;
+    float amplitude = 1.0f;
+    float maxAmplitude = 0.0f;
+
+    for( int i = 0; i < octaves; i++ ) {
+        const float xf = x * frequency;
+        const float zf = z * frequency;
+        for( int n = 0; n < count; n++ ) {
+            const float y = static_cast<float>( y_begin + n );
+            out[n] += raw_noise_3d( xf, y * frequency, zf ) * amplitude;
+        }
+
+        frequency *= 2;
+        maxAmplitude += amplitude;
+        amplitude *= persistence;
+    }
+
+    for( int n = 0; n < count; n++ ) {
+        out[n] = out[n] / maxAmplitude * ( hiBound - loBound ) / 2 + ( hiBound + loBound ) / 2;
+    }
+}
+
 // 4D Scaled Multi-octave Simplex noise.
 //
 // Returned value will be between loBound and hiBound.
@@ -82,6 +82,20 @@ float scaled_octave_noise_3d( float octaves,
                               float x,
                               float y,
                               float z );
+/* Writes scaled_octave_noise_3d( ..., x, y_begin + n, z ) to out[n] for n in [0, count).
+ * Gives exactly the values of the point function, but works through one octave of the
+ * whole row at a time, so every octave's setup is shared and the per-point loop stays tight.
+ */
+void scaled_octave_noise_3d_row( float octaves,
+                                 float persistence,
+                                 float scale,
+                                 float loBound,
+                                 float hiBound,
+                                 float x,
+                                 int y_begin,
+                                 int count,
+                                 float z,
+                                 float *out );
 float scaled_octave_noise_4d( float octaves,
                               float persistence,
                               float scale,
@@ -7,6 +7,8 @@
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "activity_type.h"
 #include "cached_options.h" // IWYU pragma: keep
@@ -27,6 +29,7 @@
 #include "map_iterator.h"
 #include "messages.h"
 #include "monster.h"
+#include "mtype.h"
 #include "npc.h"
 #include "output.h"
 #include "overmapbuffer.h"
@@ -449,6 +452,16 @@ void sounds::process_sounds()
 {
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = get_weather().weather_id->sound_attn;
+    // The monsters that can hear and how far a sound of volume 1 carries for them, found once
+    // for all the clusters.
+    std::vector<std::pair<monster *, int>> listeners;
+    if( !sound_clusters.empty() ) {
+        for( monster &critter : g->all_monsters() ) {
+            if( critter.can_hear() ) {
+                listeners.emplace_back( &critter, critter.has_flag( MF_GOODHEARING ) ? 2 : 1 );
+            }
+        }
+    }
     for( const auto &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -467,12 +480,12 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        for( const std::pair<monster *, int> &listener : listeners ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
-            if( vol * 2 > dist ) {
+            const int dist = sound_distance( source, listener.first->pos() );
+            if( vol * listener.second > dist ) {
                 // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist, this_centroid.provocative );
+                listener.first->hear_sound( source, vol, dist, this_centroid.provocative );
             }
         }
     }
@@ -237,12 +237,20 @@ event_multiset &stats_tracker::get_events( event_type type )
 event_multiset stats_tracker::get_events(
     const string_id<event_transformation> &transform_id )
 {
-    return transform_id->value( *this );
+    std::unique_ptr<stats_tracker_state> &state = event_transformation_states[ transform_id ];
+    if( !state ) {
+        state = transform_id->watch( *this );
+    }
+    return static_cast<const stats_tracker_multiset_state &>( *state ).get_events();
 }
 
 cata_variant stats_tracker::value_of( const string_id<event_statistic> &stat )
 {
-    return stat->value( *this );
+    std::unique_ptr<stats_tracker_state> &state = stat_states[ stat ];
+    if( !state ) {
+        state = stat->watch( *this );
+    }
+    return state->get_value();
 }
 
 void stats_tracker::add_watcher( event_type type, event_multiset_watcher *watcher )
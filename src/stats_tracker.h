@@ -181,6 +181,7 @@ class stats_tracker_multiset_state : public stats_tracker_state
 {
     public:
         [[noreturn]] const cata_variant &get_value() const override;
+        virtual const event_multiset &get_events() const = 0;
 };
 
 class stats_tracker : public event_subscriber
@@ -189,6 +190,9 @@ class stats_tracker : public event_subscriber
         ~stats_tracker() override;
 
         event_multiset &get_events( event_type );
+        // The transformed events and the statistics are kept up to date as
+        // events arrive once they have first been asked for, so asking again
+        // does not go through all the events.
         event_multiset get_events( const string_id<event_transformation> & );
 
         cata_variant value_of( const string_id<event_statistic> & );
@@ -1,11 +1,49 @@
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
+#include "cata_assert.h"
 #include "string_id.h"
 
 namespace
 {
 using InternMapType = std::unordered_map<std::string, int>;
-using ReverseLookupVecType = std::vector<const std::string *>;
+
+// The interned strings by id.  The storage is split into fixed-size chunks that never
+// move once allocated, so get_interned_string can read it without taking the lock: an
+// id only reaches other code after its entry has been written under the lock.
+class reverse_lookup
+{
+    public:
+        const std::string &operator[]( int id ) const {
+            return *( *chunks[id >> chunk_bits] )[id & ( chunk_size - 1 )];
+        }
+
+        int size() const {
+            return count;
+        }
+
+        void push_back( const std::string *s ) {
+            const int chunk = count >> chunk_bits;
+            cata_assert( chunk < max_chunks );
+            if( !chunks[chunk] ) {
+                chunks[chunk] = std::make_unique<chunk_type>();
+            }
+            ( *chunks[chunk] )[count & ( chunk_size - 1 )] = s;
+            ++count;
+        }
+
+    private:
+        static constexpr int chunk_bits = 12;
+        static constexpr int chunk_size = 1 << chunk_bits;
+        static constexpr int max_chunks = 1 << 12;
+        using chunk_type = std::array<const std::string *, chunk_size>;
+
+        std::array<std::unique_ptr<chunk_type>, max_chunks> chunks;
+        int count = 0;
+};
 } // namespace
 
 inline static InternMapType &get_intern_map()
@@ -14,21 +52,35 @@ inline static InternMapType &get_intern_map()
     return map;
 }
 
-inline static ReverseLookupVecType &get_reverse_lookup_vec()
+inline static reverse_lookup &get_reverse_lookup_vec()
 {
-    static ReverseLookupVecType vec{};
+    static reverse_lookup vec{};
     return vec;
 }
 
+// Guards the intern map and additions to the reverse lookup, so ids can be interned
+// from more than one thread.
+static std::mutex &get_intern_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
 template<typename S>
 inline static int universal_string_id_intern( S &&s )
 {
-    int next_id = get_reverse_lookup_vec().size();
-    const auto &pair = get_intern_map().emplace( std::forward<S>( s ), next_id );
-    if( pair.second ) { // inserted
-        get_reverse_lookup_vec().push_back( &pair.first->first );
+    std::lock_guard<std::mutex> lock( get_intern_mutex() );
+    InternMapType &map = get_intern_map();
+    // Most strings were interned before, and emplace would build a node (copying the
+    // string) before finding that out.
+    const auto found = map.find( s );
+    if( found != map.end() ) {
+        return found->second;
     }
-    return pair.first->second;
+    const int next_id = get_reverse_lookup_vec().size();
+    const auto &pair = map.emplace( std::forward<S>( s ), next_id );
+    get_reverse_lookup_vec().push_back( &pair.first->first );
+    return next_id;
 }
 
 int string_identity_static::string_id_intern( const std::string &s )
@@ -48,7 +100,7 @@ int string_identity_static::string_id_intern( std::string &&s )
 
 const std::string &string_identity_static::get_interned_string( int id )
 {
-    return *get_reverse_lookup_vec()[id];
+    return get_reverse_lookup_vec()[id];
 }
 
 int string_identity_static::empty_interned_string()
@@ -25,6 +25,14 @@ void maptile_soa<sx, sy>::swap_soa_tile( const point &p1, const point &p2 )
     std::swap( fld[p1.x][p1.y], fld[p2.x][p2.y] );
     std::swap( trp[p1.x][p1.y], trp[p2.x][p2.y] );
     std::swap( rad[p1.x][p1.y], rad[p2.x][p2.y] );
+    const size_t b1 = p1.x * sy + p1.y;
+    const size_t b2 = p2.x * sy + p2.y;
+    const bool marked = fld_tiles[b1];
+    fld_tiles[b1] = fld_tiles[b2];
+    fld_tiles[b2] = marked;
+    const bool asleep = fld_asleep[b1];
+    fld_asleep[b1] = fld_asleep[b2];
+    fld_asleep[b2] = asleep;
 }
 
 submap::submap()
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -21,6 +22,7 @@
 #include "game_constants.h"
 #include "item.h"
 #include "mapgen.h"
+#include "optional.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -58,6 +60,10 @@ struct maptile_soa {
     field              fld[sx][sy];  // Field on each square
     trap_id            trp[sx][sy];  // Trap on each square
     int                rad[sx][sy];  // Irradiation of each square
+    // Squares whose field may hold entries, as bit x * sy + y
+    std::bitset<sx * sy> fld_tiles;
+    // Marked squares whose field entries are all idle, skipped until they wake
+    std::bitset<sx * sy> fld_asleep;
 
     void swap_soa_tile( const point &p1, const point &p2 );
 };
@@ -176,6 +182,50 @@ class submap : maptile_soa<SEEX, SEEY>
             return fld[p.x][p.y];
         }
 
+        /**
+         * Field processing only visits the squares marked here.  Mark a square whenever a
+         * field entry is added to it; processing unmarks it once its field is empty.
+         */
+        void mark_field_tile( const point &p ) {
+            fld_tiles.set( p.x * SEEY + p.y );
+            fld_asleep.reset( p.x * SEEY + p.y );
+        }
+        void unmark_field_tile( const point &p ) {
+            fld_tiles.reset( p.x * SEEY + p.y );
+            fld_asleep.reset( p.x * SEEY + p.y );
+        }
+        bool field_tile_marked( const point &p ) const {
+            return fld_tiles.test( p.x * SEEY + p.y );
+        }
+        bool any_field_tile_marked() const {
+            return fld_tiles.any();
+        }
+
+        /**
+         * A marked square whose field entries have nothing to do but age can be put to
+         * sleep; processing skips it until it is marked again or until @p wake, the next
+         * time one of its entries decays.  Without a wake time it sleeps until marked.
+         */
+        void sleep_field_tile( const point &p, const cata::optional<time_point> &wake ) {
+            fld_asleep.set( p.x * SEEY + p.y );
+            if( wake && ( !field_wake || *wake < *field_wake ) ) {
+                field_wake = wake;
+            }
+        }
+        bool field_tile_asleep( const point &p ) const {
+            return fld_asleep.test( p.x * SEEY + p.y );
+        }
+        /** Wake every sleeping square once the earliest of their wake times has come. */
+        void wake_field_tiles( const time_point &now ) {
+            if( field_wake && *field_wake <= now ) {
+                wake_field_tiles();
+            }
+        }
+        void wake_field_tiles() {
+            fld_asleep.reset();
+            field_wake.reset();
+        }
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -254,6 +304,7 @@ class submap : maptile_soa<SEEX, SEEY>
         std::map<point, computer> computers;
         std::unique_ptr<computer> legacy_computer;
         int temperature = 0;
+        cata::optional<time_point> field_wake; // NOLINT(cata-serialize)
 
         void update_legacy_computer();
 
@@ -0,0 +1,116 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+// One thread is the caller, who always takes part in the work.
+static size_t hardware_worker_count()
+{
+    return std::max( 1U, std::thread::hardware_concurrency() ) - 1;
+}
+
+thread_pool::thread_pool( const size_t worker_count )
+{
+    start_workers( worker_count );
+}
+
+thread_pool::~thread_pool()
+{
+    stop_workers();
+}
+
+void thread_pool::set_worker_count( const size_t count )
+{
+    if( count != workers.size() ) {
+        stop_workers();
+        start_workers( count );
+    }
+}
+
+void thread_pool::start_workers( const size_t count )
+{
+    stopping = false;
+    workers.reserve( count );
+    for( size_t i = 0; i < count; ++i ) {
+        workers.emplace_back( &thread_pool::worker_loop, this );
+    }
+}
+
+void thread_pool::stop_workers()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for( std::thread &t : workers ) {
+        t.join();
+    }
+    workers.clear();
+}
+
+bool thread_pool::run_one( std::unique_lock<std::mutex> &lock )
+{
+    if( job == nullptr || next_index >= end_index ) {
+        return false;
+    }
+    const int index = next_index++;
+    const std::function<void( int )> &fn = *job;
+    ++running;
+    lock.unlock();
+    fn( index );
+    lock.lock();
+    if( --running == 0 && next_index >= end_index ) {
+        work_done.notify_all();
+    }
+    return true;
+}
+
+void thread_pool::worker_loop()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        work_ready.wait( lock, [this]() {
+            return stopping || ( job != nullptr && next_index < end_index );
+        } );
+        if( stopping ) {
+            return;
+        }
+        while( run_one( lock ) ) {
+        }
+    }
+}
+
+void thread_pool::parallel_for( const int begin, const int end,
+                                const std::function<void( int )> &fn )
+{
+    if( end - begin <= 1 || workers.empty() ) {
+        for( int i = begin; i < end; ++i ) {
+            fn( i );
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock( mutex );
+    job = &fn;
+    next_index = begin;
+    end_index = end;
+    work_ready.notify_all();
+    while( run_one( lock ) ) {
+    }
+    work_done.wait( lock, [this]() {
+        return running == 0 && next_index >= end_index;
+    } );
+    job = nullptr;
+}
+
+thread_pool &get_thread_pool()
+{
+    static thread_pool pool( hardware_worker_count() );
+    return pool;
+}
+
+void set_thread_pool_threads( const int threads )
+{
+    get_thread_pool().set_worker_count( threads <= 0 ? hardware_worker_count() :
+                                        static_cast<size_t>( threads - 1 ) );
+}
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef CATA_SRC_THREAD_POOL_H
+#define CATA_SRC_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+/**
+ * A small, fixed-size pool of worker threads for splitting short pieces of
+ * independent per-turn work, e.g. one task per z-level.
+ *
+ * The calling thread takes part in the work, and @ref parallel_for only returns
+ * once every task has finished, so it can replace a plain loop in place.
+ *
+ * Tasks run off the main thread and must therefore not touch the UI, the
+ * message log, or any global state that is not safe to read concurrently.
+ * Batches are not reentrant: only call @ref parallel_for from the main thread,
+ * never from inside a task.
+ */
+class thread_pool
+{
+    public:
+        explicit thread_pool( size_t worker_count );
+        ~thread_pool();
+
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+
+        /** Number of extra threads, not counting the caller. */
+        size_t worker_count() const {
+            return workers.size();
+        }
+        /**
+         * Stops the workers and starts @p count new ones.  With none, every batch runs on
+         * the calling thread alone.  Only call it from the main thread, between batches.
+         */
+        void set_worker_count( size_t count );
+
+        /** Calls fn( i ) for every i in [begin, end) and waits until all calls are done. */
+        void parallel_for( int begin, int end, const std::function<void( int )> &fn );
+
+    private:
+        void start_workers( size_t count );
+        void stop_workers();
+        void worker_loop();
+        // Takes the next index of the current batch and runs it; returns false if none was left.
+        bool run_one( std::unique_lock<std::mutex> &lock );
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::condition_variable work_done;
+
+        const std::function<void( int )> *job = nullptr;
+        int next_index = 0;
+        int end_index = 0;
+        int running = 0;
+        bool stopping = false;
+};
+
+/** Shared pool sized to the hardware, created on first use. */
+thread_pool &get_thread_pool();
+
+/**
+ * Sizes the shared pool for @p threads threads in all, the caller included, as the
+ * WORKER_THREADS option gives it.  0 sizes it to the hardware; 1 runs everything on the
+ * calling thread, which helps telling whether a bug comes from the threading.
+ */
+void set_thread_pool_threads( int threads );
+
+#endif // CATA_SRC_THREAD_POOL_H
@@ -1,9 +1,11 @@
 #include "timed_event.h"
 
 #include <array>
+#include <map>
 #include <memory>
 #include <new>
 #include <string>
+#include <utility>
 
 #include "avatar.h"
 #include "avatar_action.h"
@@ -272,6 +274,22 @@ void timed_event::actualize()
     }
 }
 
+// The types timed_event::per_turn has something to do for.
+static bool acts_every_turn( const timed_event_type type )
+{
+    switch( type ) {
+        case timed_event_type::WANTED:
+        case timed_event_type::SPAWN_WYRMS:
+        case timed_event_type::AMIGARA:
+        case timed_event_type::AMIGARA_WHISPERS:
+        case timed_event_type::TEMPLE_OPEN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Keep acts_every_turn in step with the types handled here.
 void timed_event::per_turn()
 {
     Character &player_character = get_player_character();
@@ -342,15 +360,23 @@ void timed_event::per_turn()
 
 void timed_event_manager::process()
 {
-    for( auto it = events.begin(); it != events.end(); ) {
+    for( auto it = per_turn_events.begin(); it != per_turn_events.end(); ) {
         it->per_turn();
         if( it->when <= calendar::turn ) {
+            --counts[static_cast<int>( it->type )];
             it->actualize();
-            it = events.erase( it );
+            it = per_turn_events.erase( it );
         } else {
             it++;
         }
     }
+    // Taken out of the queue first, as happening may queue other events.
+    while( !scheduled_events.empty() && scheduled_events.begin()->first <= calendar::turn ) {
+        timed_event e = scheduled_events.begin()->second;
+        scheduled_events.erase( scheduled_events.begin() );
+        --counts[static_cast<int>( e.type )];
+        e.actualize();
+    }
 }
 
 void timed_event_manager::add( const timed_event_type type, const time_point &when,
@@ -364,20 +390,33 @@ void timed_event_manager::add( const timed_event_type type, const time_point &wh
                                const tripoint_abs_sm &where,
                                int strength )
 {
-    events.emplace_back( type, when, faction_id, where, strength );
+    ++counts[static_cast<int>( type )];
+    if( acts_every_turn( type ) ) {
+        per_turn_events.emplace_back( type, when, faction_id, where, strength );
+    } else {
+        scheduled_events.emplace( when, timed_event( type, when, faction_id, where, strength ) );
+    }
 }
 
 bool timed_event_manager::queued( const timed_event_type type ) const
 {
-    return const_cast<timed_event_manager &>( *this ).get( type ) != nullptr;
+    return counts[static_cast<int>( type )] > 0;
 }
 
-timed_event *timed_event_manager::get( const timed_event_type type )
+const timed_event *timed_event_manager::get( const timed_event_type type ) const
 {
-    for( auto &e : events ) {
+    if( !queued( type ) ) {
+        return nullptr;
+    }
+    for( const timed_event &e : per_turn_events ) {
         if( e.type == type ) {
             return &e;
         }
     }
+    for( const std::pair<const time_point, timed_event> &e : scheduled_events ) {
+        if( e.second.type == type ) {
+            return &e.second;
+        }
+    }
     return nullptr;
 }
@@ -2,7 +2,9 @@
 #ifndef CATA_SRC_TIMED_EVENT_H
 #define CATA_SRC_TIMED_EVENT_H
 
+#include <array>
 #include <list>
+#include <map>
 
 #include "calendar.h"
 #include "coordinates.h"
@@ -47,7 +49,12 @@ struct timed_event {
 class timed_event_manager
 {
     private:
-        std::list<timed_event> events;
+        /** The events that do something every turn, see @ref timed_event::per_turn. */
+        std::list<timed_event> per_turn_events;
+        /** All the other events, by when they happen. */
+        std::multimap<time_point, timed_event> scheduled_events;
+        /** How many events of every type are queued, so asking for a missing one is cheap. */
+        std::array<int, static_cast<int>( timed_event_type::NUM_TIMED_EVENT_TYPES )> counts = {};
 
     public:
         /**
@@ -65,7 +72,7 @@ class timed_event_manager
         bool queued( timed_event_type type ) const;
         /// @returns One of the queued events of the given type, or `nullptr`
         /// if no event of that type is queued.
-        timed_event *get( timed_event_type type );
+        const timed_event *get( timed_event_type type ) const;
         /// Process all queued events, potentially altering the game state and
         /// modifying the event queue.
         void process();
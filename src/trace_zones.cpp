@@ -0,0 +1,85 @@
+#include "trace_zones.h"
+
+#if defined(CATA_TRACE_ZONES) && !defined(TRACY_ENABLE)
+
+#include <atomic>
+#include <ios>
+#include <memory>
+#include <mutex>
+
+#include "filesystem.h"
+#include "path_info.h"
+
+// The trace is in the JSON array format of Chrome trace events, one complete event ("ph":
+// "X") per zone. The closing bracket is optional in that format, so the file can be appended
+// to until the game exits, and even a trace cut short by a crash can be opened.
+
+namespace
+{
+
+struct trace_file {
+    std::mutex mutex;
+    std::unique_ptr<cata::ofstream> out;
+    bool failed = false;
+};
+
+// Timestamps are counted from the start of the program.
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+trace_file &get_trace_file()
+{
+    static trace_file file;
+    return file;
+}
+
+// Small numbers for the threads, in the order they first closed a zone.
+int thread_number()
+{
+    static std::atomic<int> next_number( 1 );
+    thread_local const int number = next_number++;
+    return number;
+}
+
+} // namespace
+
+namespace trace_zones
+{
+
+std::string trace_path()
+{
+    return PATH_INFO::config_dir() + "trace.json";
+}
+
+void add( const char *name, const std::chrono::steady_clock::time_point start,
+          const std::chrono::steady_clock::time_point end )
+{
+    const int tid = thread_number();
+    trace_file &file = get_trace_file();
+    std::lock_guard<std::mutex> lock( file.mutex );
+    if( file.failed ) {
+        return;
+    }
+    if( !file.out ) {
+        file.out = std::make_unique<cata::ofstream>( fs::u8path( trace_path() ),
+                   std::ios::out | std::ios::trunc );
+        if( !file.out->is_open() ) {
+            // Not a debugmsg: this may be a worker thread, and it would come up for every zone.
+            file.out.reset();
+            file.failed = true;
+            return;
+        }
+        *file.out << "[\n";
+    } else {
+        *file.out << ",\n";
+    }
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    // The names are string literals in the code, so they need no escaping.
+    *file.out << R"({"name":")" << name << R"(","ph":"X","pid":1,"tid":)" << tid
+              << R"(,"ts":)" << duration_cast<microseconds>( start - epoch ).count()
+              << R"(,"dur":)" << duration_cast<microseconds>( end - start ).count() << "}";
+}
+
+} // namespace trace_zones
+
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+#ifndef CATA_SRC_TRACE_ZONES_H
+#define CATA_SRC_TRACE_ZONES_H
+
+// Named zones around the expensive parts of a turn and of drawing, for looking at single
+// frames in a profiler instead of the averages a sampling profiler gives.
+//
+// CATA_TRACE_ZONE( "name" ) marks the rest of the enclosing scope as a zone. The name has to
+// be a string literal. What the zones turn into depends on the build:
+//  * with TRACY_ENABLE (linking Tracy's client) they are Tracy zones,
+//  * with CATA_TRACE_ZONES (the TRACE_ZONES build option) they are appended to
+//    @ref trace_zones::trace_path as Chrome trace events, which the Perfetto UI and
+//    chrome://tracing open,
+//  * otherwise they compile to nothing.
+
+#if defined(TRACY_ENABLE)
+
+#include <tracy/Tracy.hpp>
+
+#define CATA_TRACE_ZONE( name ) ZoneScopedN( name )
+
+#elif defined(CATA_TRACE_ZONES)
+
+#include <chrono>
+#include <string>
+
+namespace trace_zones
+{
+
+/** Where the trace is written, in the config folder. */
+std::string trace_path();
+
+/** Appends a complete zone to the trace. Safe to call from worker threads. */
+void add( const char *name, std::chrono::steady_clock::time_point start,
+          std::chrono::steady_clock::time_point end );
+
+} // namespace trace_zones
+
+class trace_zone
+{
+    public:
+        explicit trace_zone( const char *name ) : name( name ),
+            start( std::chrono::steady_clock::now() ) {}
+        ~trace_zone() {
+            trace_zones::add( name, start, std::chrono::steady_clock::now() );
+        }
+
+        trace_zone( const trace_zone & ) = delete;
+        trace_zone &operator=( const trace_zone & ) = delete;
+
+    private:
+        const char *name;
+        std::chrono::steady_clock::time_point start;
+};
+
+#define CATA_TRACE_ZONE_CAT_( a, b ) a##b
+#define CATA_TRACE_ZONE_CAT( a, b ) CATA_TRACE_ZONE_CAT_( a, b )
+#define CATA_TRACE_ZONE( name ) \
+    const trace_zone CATA_TRACE_ZONE_CAT( trace_zone_, __LINE__ )( name )
+
+#else
+
+#define CATA_TRACE_ZONE( name ) static_cast<void>( 0 )
+
+#endif
+
+#endif // CATA_SRC_TRACE_ZONES_H
@@ -75,8 +75,10 @@ TranslationDocument::TranslationDocument( const std::string &path )
     if( file_size > max_file_size ) {
         throw InvalidTranslationDocumentException( path, "file too large" );
     }
-    data = std::string( ( std::istreambuf_iterator<char>( fin ) ), std::istreambuf_iterator<char>() );
-    if( data.size() != file_size ) {
+    // One read straight into the buffer instead of going through it character by character.
+    data.resize( file_size );
+    fin.read( &data[0], static_cast<std::streamsize>( file_size ) );
+    if( static_cast<std::uintmax_t>( fin.gcount() ) != file_size ) {
         throw InvalidTranslationDocumentException( path, "did not read the entire file" );
     }
     if( GetByte( 0 ) == 0x95U &&
@@ -115,6 +117,7 @@ TranslationDocument::TranslationDocument( const std::string &path )
     }
     original_offsets.reserve( number_of_strings );
     translated_offsets.reserve( number_of_strings );
+    translated_forms_begin.reserve( number_of_strings + 1 );
     for( std::size_t i = 0; i < number_of_strings; i++ ) {
         std::size_t length = GetUint32( original_strings_table_offset + 8 * i );
         std::size_t offset = GetUint32( original_strings_table_offset + 8 * i + 4 );
@@ -131,7 +134,6 @@ TranslationDocument::TranslationDocument( const std::string &path )
         original_offsets.emplace_back( offset );
     }
     for( std::size_t i = 0; i < number_of_strings; i++ ) {
-        std::vector<std::size_t> offsets;
         std::size_t length = GetUint32( translated_strings_table_offset + 8 * i );
         std::size_t offset = GetUint32( translated_strings_table_offset + 8 * i + 4 );
         if( offset >= data.size() || length >= data.size() || offset + length >= data.size() ) {
@@ -144,14 +146,15 @@ TranslationDocument::TranslationDocument( const std::string &path )
                     string_format( "translated string %zu offset %zu with length %zu not terminated by '\\0'",
                                    i, offset, length ) );
         }
-        offsets.emplace_back( offset );
+        translated_forms_begin.emplace_back( translated_offsets.size() );
+        translated_offsets.emplace_back( offset );
         for( std::size_t idx = offset; idx + 1 < offset + length; idx++ ) {
             if( data[idx] == '\0' ) {
-                offsets.emplace_back( idx + 1 );
+                translated_offsets.emplace_back( idx + 1 );
             }
         }
-        translated_offsets.emplace_back( offsets );
     }
+    translated_forms_begin.emplace_back( translated_offsets.size() );
     const std::string metadata( GetTranslatedString( 0 ) );
     const std::string plural_rules_header( "Plural-Forms:" );
     std::size_t plural_rules_header_pos = metadata.find( plural_rules_header );
@@ -191,6 +194,13 @@ std::size_t TranslationDocument::Count() const
     return number_of_strings;
 }
 
+std::size_t TranslationDocument::MemoryUsage() const
+{
+    return sizeof( *this ) + data.capacity() +
+           ( original_offsets.capacity() + translated_offsets.capacity() +
+             translated_forms_begin.capacity() ) * sizeof( std::size_t );
+}
+
 const char *TranslationDocument::GetOriginalString( const std::size_t index ) const
 {
     return GetString( original_offsets[index] );
@@ -198,19 +208,20 @@ const char *TranslationDocument::GetOriginalString( const std::size_t index ) co
 
 const char *TranslationDocument::GetTranslatedString( const std::size_t index ) const
 {
-    return GetString( translated_offsets[index][0] );
+    return GetString( translated_offsets[translated_forms_begin[index]] );
 }
 
 const char *TranslationDocument::GetTranslatedStringPlural( const std::size_t index,
         std::size_t n ) const
 {
     std::size_t plural_form = EvaluatePluralForm( n );
-    if( plural_form >= translated_offsets[index].size() ) {
+    const std::size_t begin = translated_forms_begin[index];
+    if( plural_form >= translated_forms_begin[index + 1] - begin ) {
         DebugLog( D_ERROR, DC_ALL ) << "Plural forms expression evaluated out-of-bound at string entry " <<
                                     index << " with n=" << n;
-        return GetString( translated_offsets[index][0] );
+        return GetString( translated_offsets[begin] );
     }
-    return GetString( translated_offsets[index][plural_form] );
+    return GetString( translated_offsets[begin + plural_form] );
 }
 
 #endif // defined(LOCALIZE)
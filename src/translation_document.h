@@ -40,7 +40,10 @@ class TranslationDocument
         std::string data;
         Endianness endianness;
         std::vector<std::size_t> original_offsets;
-        std::vector<std::vector<std::size_t>> translated_offsets;
+        // The offsets of every plural form of every translated string, one string after the
+        // other.  The forms of string i start at translated_forms_begin[i].
+        std::vector<std::size_t> translated_offsets;
+        std::vector<std::size_t> translated_forms_begin;
         std::unique_ptr<TranslationPluralRulesEvaluator> plural_rules;
 
         std::uint8_t GetByte( const std::size_t byteIndex ) const;
@@ -55,6 +58,8 @@ class TranslationDocument
         explicit TranslationDocument( const std::string &path );
 
         std::size_t Count() const;
+        /** Estimate of the bytes held, the document and the tables into it. */
+        std::size_t MemoryUsage() const;
         const char *GetOriginalString( const std::size_t index ) const;
         const char *GetTranslatedString( const std::size_t index ) const;
         const char *GetTranslatedStringPlural( const std::size_t index, std::size_t n ) const;
@@ -28,6 +28,16 @@ std::string TranslationManager::GetCurrentLanguage() const
     return impl->GetCurrentLanguage();
 }
 
+std::size_t TranslationManager::CountStrings() const
+{
+    return impl->CountStrings();
+}
+
+std::size_t TranslationManager::MemoryUsage() const
+{
+    return impl->MemoryUsage();
+}
+
 void TranslationManager::LoadDocuments( const std::vector<std::string> &files )
 {
     impl->LoadDocuments( files );
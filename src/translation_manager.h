@@ -16,6 +16,9 @@ class TranslationManagerInterface
         virtual void SetLanguage( const std::string &language_code ) = 0;
         virtual std::string GetCurrentLanguage() const = 0;
         virtual void LoadDocuments( const std::vector<std::string> &files ) = 0;
+        /** The strings of the loaded documents, and an estimate of the bytes they take. */
+        virtual std::size_t CountStrings() const = 0;
+        virtual std::size_t MemoryUsage() const = 0;
 
         virtual const char *Translate( const std::string &message ) const = 0;
         virtual const char *Translate( const char *message ) const = 0;
@@ -37,6 +40,8 @@ class TranslationManager
         void SetLanguage( const std::string &language_code );
         std::string GetCurrentLanguage() const;
         void LoadDocuments( const std::vector<std::string> &files );
+        std::size_t CountStrings() const;
+        std::size_t MemoryUsage() const;
 
         const char *Translate( const std::string &message ) const;
         const char *Translate( const char *message ) const;
@@ -118,6 +118,29 @@ std::string TranslationManagerImpl::GetCurrentLanguage() const
     return current_language_code;
 }
 
+std::size_t TranslationManagerImpl::CountStrings() const
+{
+    std::size_t count = 0;
+    for( const TranslationDocument &document : documents ) {
+        count += document.Count();
+    }
+    return count;
+}
+
+std::size_t TranslationManagerImpl::MemoryUsage() const
+{
+    std::size_t bytes = 0;
+    for( const TranslationDocument &document : documents ) {
+        bytes += document.MemoryUsage();
+    }
+    // The lookup table: one list of (document, string) pairs per hash, in a hash node.
+    for( const auto &entry : strings ) {
+        bytes += sizeof( entry ) + 2 * sizeof( void * ) +
+                 entry.second.capacity() * sizeof( entry.second[0] );
+    }
+    return bytes;
+}
+
 void TranslationManagerImpl::LoadDocuments( const std::vector<std::string> &files )
 {
     Reset();
@@ -136,15 +159,16 @@ void TranslationManagerImpl::LoadDocuments( const std::vector<std::string> &file
             DebugLog( D_ERROR, DC_ALL ) << e.what();
         }
     }
+    std::size_t total = 0;
+    for( const TranslationDocument &document : documents ) {
+        total += document.Count();
+    }
+    strings.reserve( total );
     for( std::size_t document = 0; document < documents.size(); document++ ) {
         for( std::size_t i = 0; i < documents[document].Count(); i++ ) {
             const char *message = documents[document].GetOriginalString( i );
             if( message[0] != '\0' ) {
-                const std::uint32_t hash = Hash( message );
-                if( strings.count( hash ) == 0 ) {
-                    strings[hash] = std::vector<std::pair<std::size_t, std::size_t>>( 1 );
-                }
-                strings[hash].emplace_back( document, i );
+                strings[Hash( message )].emplace_back( document, i );
             }
         }
     }
@@ -31,6 +31,8 @@ class TranslationManagerImpl : public TranslationManagerInterface
         void SetLanguage( const std::string &language_code ) override;
         std::string GetCurrentLanguage() const override;
         void LoadDocuments( const std::vector<std::string> &files ) override;
+        std::size_t CountStrings() const override;
+        std::size_t MemoryUsage() const override;
 
         const char *Translate( const std::string &message ) const override;
         const char *Translate( const char *message ) const override;
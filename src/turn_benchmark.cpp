@@ -0,0 +1,50 @@
+#include "turn_benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "avatar.h"
+#include "do_turn.h"
+#include "game.h"
+#include "map.h"
+#include "perf_stats.h"
+#include "rng.h"
+#include "type_id.h"
+
+static const mtype_id mon_zombie( "mon_zombie" );
+
+namespace turn_benchmark
+{
+
+bool run( const int turns, const int zombies, const int seed )
+{
+    rng_set_engine_seed( seed );
+    avatar &u = get_avatar();
+    int spawned = 0;
+    for( int i = 0; i < zombies; ++i ) {
+        if( g->place_critter_around( mon_zombie, u.pos(), rng( 5, SEEX * 4 ) ) ) {
+            ++spawned;
+        }
+    }
+
+    perf_stats::reset();
+    int done = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while( done < turns && !u.is_dead_state() ) {
+        // The avatar stands still, so no turn waits for input.
+        u.moves = 0;
+        if( do_turn() ) {
+            break;
+        }
+        ++done;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    printf( "%d turns with %d zombies in %.3f s, %.1f turns per second\n", done, spawned,
+            elapsed.count(), elapsed.count() > 0 ? done / elapsed.count() : 0.0 );
+    printf( "%s\n", perf_stats::summary_table().c_str() );
+    return done == turns;
+}
+
+} // namespace turn_benchmark
@@ -0,0 +1,22 @@
+#pragma once
+#ifndef CATA_SRC_TURN_BENCHMARK_H
+#define CATA_SRC_TURN_BENCHMARK_H
+
+// Runs the game without a UI for a fixed number of turns and reports how long they took,
+// as a reproducible measure of turn processing speed. Started by the --benchmark command
+// line parameter together with --world, and --seed for runs that can be compared.
+
+namespace turn_benchmark
+{
+
+/**
+ * Spawns @p zombies zombies around the avatar of the loaded game, then runs @p turns turns
+ * with the avatar standing still and prints the turns per second and the time spent per
+ * stage of @ref perf_stats to stdout. Stops early if the avatar dies.
+ * @return Whether all the turns were run.
+ */
+bool run( int turns, int zombies, int seed );
+
+} // namespace turn_benchmark
+
+#endif // CATA_SRC_TURN_BENCHMARK_H
@@ -1,5 +1,7 @@
 #include "ui_manager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <vector>
@@ -7,8 +9,10 @@
 #include "cached_options.h"
 #include "cursesdef.h"
 #include "game_ui.h"
+#include "perf_stats.h"
 #include "point.h"
 #include "sdltiles.h" // IWYU pragma: keep
+#include "trace_zones.h"
 
 using ui_stack_t = std::vector<std::reference_wrapper<ui_adaptor>>;
 
@@ -38,6 +42,18 @@ ui_adaptor::~ui_adaptor()
     }
 }
 
+// The part of the screen covered by win, in the units of ui_adaptor::dimensions.
+static rectangle<point> window_rectangle( const catacurses::window &win )
+{
+#ifdef TILES
+    const window_dimensions dim = get_window_dimensions( win );
+    return rectangle<point>( dim.window_pos_pixel, dim.window_pos_pixel + dim.window_size_pixel );
+#else
+    const point origin( getbegx( win ), getbegy( win ) );
+    return rectangle<point>( origin, origin + point( getmaxx( win ), getmaxy( win ) ) );
+#endif
+}
+
 void ui_adaptor::position_from_window( const catacurses::window &win )
 {
     if( !win ) {
@@ -45,15 +61,8 @@ void ui_adaptor::position_from_window( const catacurses::window &win )
     } else {
         const rectangle<point> old_dimensions = dimensions;
         // ensure position is updated before calling invalidate
-#ifdef TILES
-        const window_dimensions dim = get_window_dimensions( win );
-        dimensions = rectangle<point>(
-                         dim.window_pos_pixel, dim.window_pos_pixel + dim.window_size_pixel );
-#else
-        const point origin( getbegx( win ), getbegy( win ) );
-        dimensions = rectangle<point>( origin, origin + point( getmaxx( win ), getmaxy( win ) ) );
-#endif
-        invalidated = true;
+        dimensions = window_rectangle( win );
+        invalidate_all();
         ui_manager::invalidate( old_dimensions, false );
     }
 }
@@ -69,7 +78,7 @@ void ui_adaptor::position( const point &topleft, const point &size )
 #else
     dimensions = rectangle<point>( topleft, topleft + size );
 #endif
-    invalidated = true;
+    invalidate_all();
     ui_manager::invalidate( old_dimensions, false );
 }
 
@@ -100,6 +109,86 @@ static bool overlap( const rectangle<point> &lhs, const rectangle<point> &rhs )
            rhs.p_min.x < lhs.p_max.x && rhs.p_min.y < lhs.p_max.y;
 }
 
+// Past this many separate dirty rectangles, redraw the whole UI instead.
+static constexpr size_t max_dirty_rects = 8;
+
+void ui_adaptor::invalidate_rect( const rectangle<point> &rect ) const
+{
+    if( !overlap( dimensions, rect ) || ( invalidated && dirty.empty() ) ) {
+        return;
+    }
+    const rectangle<point> clipped( point( std::max( rect.p_min.x, dimensions.p_min.x ),
+                                           std::max( rect.p_min.y, dimensions.p_min.y ) ),
+                                    point( std::min( rect.p_max.x, dimensions.p_max.x ),
+                                           std::min( rect.p_max.y, dimensions.p_max.y ) ) );
+    if( contains( clipped, dimensions ) ) {
+        invalidate_all();
+        return;
+    }
+    invalidated = true;
+    for( const rectangle<point> &other : dirty ) {
+        if( contains( other, clipped ) ) {
+            return;
+        }
+    }
+    dirty.erase( std::remove_if( dirty.begin(), dirty.end(),
+    [&]( const rectangle<point> &other ) {
+        return contains( clipped, other );
+    } ), dirty.end() );
+    dirty.push_back( clipped );
+    if( dirty.size() > max_dirty_rects ) {
+        dirty.clear();
+    }
+}
+
+void ui_adaptor::invalidate_all() const
+{
+    invalidated = true;
+    dirty.clear();
+}
+
+void ui_adaptor::validate() const
+{
+    invalidated = false;
+    dirty.clear();
+}
+
+std::vector<rectangle<point>> ui_adaptor::dirty_rects() const
+{
+    if( dirty.empty() ) {
+        return { dimensions };
+    }
+    return dirty;
+}
+
+bool ui_adaptor::is_dirty( const catacurses::window &win ) const
+{
+    if( !win ) {
+        return false;
+    }
+    const rectangle<point> rect = window_rectangle( win );
+    if( dirty.empty() ) {
+        return overlap( dimensions, rect );
+    }
+    return std::any_of( dirty.begin(), dirty.end(), [&]( const rectangle<point> &other ) {
+        return overlap( other, rect );
+    } );
+}
+
+bool ui_adaptor::is_dirty_outside( const catacurses::window &win ) const
+{
+    if( !win ) {
+        return true;
+    }
+    const rectangle<point> rect = window_rectangle( win );
+    if( dirty.empty() ) {
+        return !contains( rect, dimensions );
+    }
+    return std::any_of( dirty.begin(), dirty.end(), [&]( const rectangle<point> &other ) {
+        return !contains( rect, other );
+    } );
+}
+
 // This function does two things:
 // 1. Ensure that any UI that would be overwritten by redrawing a lower invalidated
 //    UI also gets redrawn.
@@ -125,15 +214,17 @@ void ui_adaptor::invalidation_consistency_and_optimization()
         const ui_adaptor &ui_upper = it_upper->get();
         for( auto it_lower = first; it_lower < it_upper; ++it_lower ) {
             const ui_adaptor &ui_lower = it_lower->get();
-            if( !ui_upper.invalidated && ui_lower.invalidated &&
-                overlap( ui_upper.dimensions, ui_lower.dimensions ) ) {
-                // invalidated by lower invalidated UIs
-                ui_upper.invalidated = true;
+            if( ui_lower.invalidated && overlap( ui_upper.dimensions, ui_lower.dimensions ) ) {
+                // invalidated where lower invalidated UIs are redrawn
+                for( const rectangle<point> &rect : ui_lower.dirty_rects() ) {
+                    ui_upper.invalidate_rect( rect );
+                }
             }
             if( ui_upper.invalidated && ui_lower.invalidated &&
                 contains( ui_upper.dimensions, ui_lower.dimensions ) ) {
-                // fully obscured lower UIs do not need to be redrawn.
-                ui_lower.invalidated = false;
+                // fully obscured lower UIs do not need to be redrawn: all of the parts
+                // they would redraw were just marked to be redrawn in ui_upper.
+                ui_lower.validate();
                 // Note: we don't need to re-test ui_lower from earlier iterations
                 // during which ui_upper.invalidated hadn't yet been determined to
                 // be true, because if the ui_lower would be obscured by ui_upper,
@@ -147,7 +238,7 @@ void ui_adaptor::invalidation_consistency_and_optimization()
 
 void ui_adaptor::invalidate_ui() const
 {
-    if( invalidated ) {
+    if( invalidated && dirty.empty() ) {
         return;
     }
     auto it = ui_stack.cbegin();
@@ -168,7 +259,16 @@ void ui_adaptor::invalidate_ui() const
     // Always mark this UI for redraw even if it is below another UI with
     // `disable_uis_below`, so when the UI with `disable_uis_below` is removed,
     // this UI is correctly marked for redraw.
-    invalidated = true;
+    invalidate_all();
+    invalidation_consistency_and_optimization();
+}
+
+void ui_adaptor::invalidate_window( const catacurses::window &win ) const
+{
+    if( !win ) {
+        return;
+    }
+    invalidate_rect( window_rectangle( win ) );
     invalidation_consistency_and_optimization();
 }
 
@@ -191,11 +291,8 @@ void ui_adaptor::invalidate( const rectangle<point> &rect, const bool reenable_u
     // `disable_uis_below`, so when the UI with `disable_uis_below` is removed,
     // UIs below are correctly marked for redraw.
     for( auto it_upper = ui_stack.cbegin(); it_upper < ui_stack.cend(); ++it_upper ) {
-        const ui_adaptor &ui_upper = it_upper->get();
-        if( !ui_upper.invalidated && overlap( ui_upper.dimensions, rect ) ) {
-            // invalidated by `rect`
-            ui_upper.invalidated = true;
-        }
+        // invalidated by `rect`
+        it_upper->get().invalidate_rect( rect );
     }
     invalidation_consistency_and_optimization();
 }
@@ -203,7 +300,7 @@ void ui_adaptor::invalidate( const rectangle<point> &rect, const bool reenable_u
 void ui_adaptor::redraw()
 {
     if( !ui_stack.empty() ) {
-        ui_stack.back().get().invalidated = true;
+        ui_stack.back().get().invalidate_all();
     }
     redraw_invalidated();
 }
@@ -213,6 +310,7 @@ void ui_adaptor::redraw_invalidated()
     if( test_mode || ui_stack.empty() ) {
         return;
     }
+    CATA_TRACE_ZONE( "ui_adaptor::redraw_invalidated" );
 
     // Find the first enabled UI. From now on enabling and disabling UIs
     // have no effect until the end of this call.
@@ -269,6 +367,7 @@ void ui_adaptor::redraw_invalidated()
         }
     }
     if( needs_redraw ) {
+        const std::chrono::steady_clock::time_point redraw_start = std::chrono::steady_clock::now();
         if( !ui_stack_copy ) {
             // Callbacks may change the UI stack; make a copy of the original one.
             ui_stack_copy = std::make_unique<ui_stack_t>( *ui_stack_orig );
@@ -281,9 +380,10 @@ void ui_adaptor::redraw_invalidated()
                 if( ui.redraw_cb ) {
                     ui.redraw_cb( ui );
                 }
-                ui.invalidated = false;
+                ui.validate();
             }
         }
+        perf_stats::frame_drawn( std::chrono::steady_clock::now() - redraw_start );
     }
 }
 
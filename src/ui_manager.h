@@ -3,6 +3,7 @@
 #define CATA_SRC_UI_MANAGER_H
 
 #include <functional>
+#include <vector>
 
 #include "cuboid_rectangle.h"
 #include "point.h"
@@ -61,10 +62,22 @@ class ui_adaptor
         // unless an upper UI completely occludes this UI. May also cause upper UIs
         // to redraw.
         void invalidate_ui() const;
+        // Invalidate only the part of this UI covered by win, like invalidate_ui.
+        void invalidate_window( const catacurses::window &win ) const;
 
         // Reset all callbacks and dimensions
         void reset();
 
+        // The parts of this UI the redraw callback has to draw, in the same units as its
+        // dimensions. Only meaningful while the callback runs: a UI is often redrawn only
+        // where an upper UI moved away or was redrawn itself, and the callback may skip
+        // whatever lies outside of these.
+        std::vector<rectangle<point>> dirty_rects() const;
+        // Whether any of the part of the screen covered by win has to be drawn.
+        bool is_dirty( const catacurses::window &win ) const;
+        // Whether any part of this UI not covered by win has to be drawn.
+        bool is_dirty_outside( const catacurses::window &win ) const;
+
         static void invalidate( const rectangle<point> &rect, bool reenable_uis_below );
         static void redraw();
         static void redraw_invalidated();
@@ -72,6 +85,12 @@ class ui_adaptor
     private:
         static void invalidation_consistency_and_optimization();
 
+        // Marks rect, clipped to the UI, to be redrawn.
+        void invalidate_rect( const rectangle<point> &rect ) const;
+        // Marks the whole UI to be redrawn.
+        void invalidate_all() const;
+        void validate() const;
+
         // pixel dimensions in tiles, console cell dimensions in curses
         rectangle<point> dimensions;
         redraw_callback_t redraw_cb;
@@ -80,6 +99,8 @@ class ui_adaptor
         bool disabling_uis_below;
 
         mutable bool invalidated;
+        // The parts to redraw while invalidated, or empty if it is the whole UI.
+        mutable std::vector<rectangle<point>> dirty;
         mutable bool deferred_resize;
 };
 
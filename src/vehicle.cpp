@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <climits>
 #include <cmath>
 #include <complex>
 #include <cstdint>
@@ -137,7 +138,6 @@ class RemovePartHandler
         virtual void unboard( const tripoint &loc ) = 0;
         virtual void add_item_or_charges( const tripoint &loc, item it, bool permit_oob ) = 0;
         virtual void set_transparency_cache_dirty( int z ) = 0;
-        virtual void set_floor_cache_dirty( int z ) = 0;
         virtual void removed( vehicle &veh, int part ) = 0;
         virtual void spawn_animal_from_part( item &base, const tripoint &loc ) = 0;
 };
@@ -158,9 +158,6 @@ class DefaultRemovePartHandler : public RemovePartHandler
             here.set_transparency_cache_dirty( z );
             here.set_seen_cache_dirty( tripoint_zero );
         }
-        void set_floor_cache_dirty( const int z ) override {
-            get_map().set_floor_cache_dirty( z );
-        }
         void removed( vehicle &veh, const int part ) override {
             avatar &player_character = get_avatar();
             // If the player is currently working on the removed part, stop them as it's futile now.
@@ -224,9 +221,6 @@ class MapgenRemovePartHandler : public RemovePartHandler
         void set_transparency_cache_dirty( const int /*z*/ ) override {
             // Ignored for now. We don't initialize the transparency cache in mapgen anyway.
         }
-        void set_floor_cache_dirty( const int /*z*/ ) override {
-            // Ignored for now. We don't initialize the floor cache in mapgen anyway.
-        }
         void removed( vehicle &veh, const int /*part*/ ) override {
             // TODO: check if this is necessary, it probably isn't during mapgen
             m.dirty_vehicle_list.insert( &veh );
@@ -1588,7 +1582,7 @@ int vehicle::install_part( const point &dp, const vehicle_part &new_part )
 
     pt.mount = dp;
 
-    refresh();
+    refresh_installed_part( parts.size() - 1 );
     coeff_air_changed = true;
     return parts.size() - 1;
 }
@@ -1857,10 +1851,6 @@ bool vehicle::remove_part( const int p, RemovePartHandler &handler )
         handler.set_transparency_cache_dirty( sm_pos.z );
     }
 
-    if( part_flag( p, VPFLAG_ROOF ) || part_flag( p, VPFLAG_OPAQUE ) ) {
-        handler.set_floor_cache_dirty( sm_pos.z + 1 );
-    }
-
     remove_dependent_part( "SEAT", "SEATBELT" );
     remove_dependent_part( "BATTERY_MOUNT", "NEEDS_BATTERY_MOUNT" );
     remove_dependent_part( "HANDHELD_BATTERY_MOUNT", "NEEDS_HANDHELD_BATTERY_MOUNT" );
@@ -1926,7 +1916,7 @@ bool vehicle::remove_part( const int p, RemovePartHandler &handler )
             handler.add_item_or_charges( dest, i, true );
         }
     }
-    refresh();
+    refresh_removed_part( p );
     coeff_air_changed = true;
     return shift_if_needed();
 }
@@ -2423,14 +2413,41 @@ std::vector<int> vehicle::parts_at_relative( const point &dp,
         }
         return res;
     } else {
-        const auto &iter = relative_parts.find( dp );
-        if( iter != relative_parts.end() ) {
-            return iter->second;
-        } else {
-            std::vector<int> res;
-            return res;
+        return parts_at_mount( dp );
+    }
+}
+
+const std::vector<int> &vehicle::parts_at_mount( const point &dp ) const
+{
+    static const std::vector<int> no_parts;
+    relative_parts_grid &grid = relative_grid;
+    if( grid.dirty ) {
+        grid.cells.clear();
+        grid.min = point_zero;
+        grid.size = point_zero;
+        if( !relative_parts.empty() ) {
+            // The map is ordered by x first, so only y has to be searched for.
+            point max( relative_parts.rbegin()->first.x, INT_MIN );
+            grid.min = point( relative_parts.begin()->first.x, INT_MAX );
+            for( const std::pair<const point, std::vector<int>> &here : relative_parts ) {
+                grid.min.y = std::min( grid.min.y, here.first.y );
+                max.y = std::max( max.y, here.first.y );
+            }
+            grid.size = max - grid.min + point_south_east;
+            grid.cells.assign( grid.size.x * grid.size.y, nullptr );
+            for( const std::pair<const point, std::vector<int>> &here : relative_parts ) {
+                const point rel = here.first - grid.min;
+                grid.cells[rel.x * grid.size.y + rel.y] = &here.second;
+            }
         }
+        grid.dirty = false;
+    }
+    const point rel = dp - grid.min;
+    if( rel.x < 0 || rel.y < 0 || rel.x >= grid.size.x || rel.y >= grid.size.y ) {
+        return no_parts;
     }
+    const std::vector<int> *here = grid.cells[rel.x * grid.size.y + rel.y];
+    return here != nullptr ? *here : no_parts;
 }
 
 cata::optional<vpart_reference> vpart_position::obstacle_at_part() const
@@ -2705,10 +2722,10 @@ void vpart_position::set_label( const std::string &text ) const
 
 int vehicle::next_part_to_close( int p, bool outside ) const
 {
-    std::vector<int> parts_here = parts_at_relative( parts[p].mount, true );
+    const std::vector<int> &parts_here = parts_at_mount( parts[p].mount );
 
     // We want reverse, since we close the outermost thing first (curtains), and then the innermost thing (door)
-    for( std::vector<int>::reverse_iterator part_it = parts_here.rbegin();
+    for( std::vector<int>::const_reverse_iterator part_it = parts_here.rbegin();
          part_it != parts_here.rend();
          ++part_it ) {
 
@@ -2724,7 +2741,7 @@ int vehicle::next_part_to_close( int p, bool outside ) const
 
 int vehicle::next_part_to_open( int p, bool outside ) const
 {
-    std::vector<int> parts_here = parts_at_relative( parts[p].mount, true );
+    const std::vector<int> &parts_here = parts_at_mount( parts[p].mount );
 
     // We want forwards, since we open the innermost thing first (curtains), and then the innermost thing (door)
     for( const int &elem : parts_here ) {
@@ -3000,7 +3017,7 @@ int vehicle::part_displayed_at( const point &dp ) const
     // it's clear where the magic number comes from.
     const int ON_ROOF_Z = 9;
 
-    std::vector<int> parts_in_square = parts_at_relative( dp, true );
+    const std::vector<int> &parts_in_square = parts_at_mount( dp );
 
     if( parts_in_square.empty() ) {
         return -1;
@@ -3037,7 +3054,7 @@ int vehicle::part_displayed_at( const point &dp ) const
 
 int vehicle::roof_at_part( const int part ) const
 {
-    std::vector<int> parts_in_square = parts_at_relative( parts[part].mount, true );
+    const std::vector<int> &parts_in_square = parts_at_mount( parts[part].mount );
     for( const int p : parts_in_square ) {
         if( part_info( p ).location == "on_roof" || part_flag( p, "ROOF" ) ) {
             return p;
@@ -3928,7 +3945,7 @@ double vehicle::coeff_air_drag() const
                   p.info().has_flag( "OPENABLE" ) );
     };
 
-    const auto d_protrusion = [&]( std::vector<int> parts_at ) {
+    const auto d_protrusion = [&]( const std::vector<int> &parts_at ) {
         if( parts_at.size() > 1 ) {
             return false;
         } else {
@@ -3951,7 +3968,7 @@ double vehicle::coeff_air_drag() const
             continue;
         }
         int col = parts[ p ].mount.y - mount_min.y;
-        std::vector<int> parts_at = parts_at_relative( parts[ p ].mount, true );
+        const std::vector<int> &parts_at = parts_at_mount( parts[ p ].mount );
         d_check_min( drag[ col ].pro, parts[ p ], d_protrusion( parts_at ) );
         for( int pa_index : parts_at ) {
             const vehicle_part &pa = parts[ pa_index ];
@@ -4043,32 +4060,67 @@ double vehicle::coeff_air_drag() const
     return coefficient_air_resistance;
 }
 
-double vehicle::coeff_rolling_drag() const
+void vehicle::update_drag_shape() const
 {
-    if( !coeff_rolling_dirty ) {
-        return coefficient_rolling_resistance;
+    if( !drag_shape_dirty ) {
+        return;
     }
     constexpr double wheel_ratio = 1.25;
     constexpr double base_wheels = 4.0;
-    // SAE J2452 measurements are in F_rr = N * C_rr * 0.000225 * ( v + 33.33 )
-    // Don't ask me why, but it's the numbers we have. We want N * C_rr * 0.000225 here,
-    // and N is mass * accel from gravity (aka weight)
-    constexpr double sae_ratio = 0.000225;
-    constexpr double newton_ratio = accel_g * sae_ratio;
-    double wheel_factor = 0;
     if( wheelcache.empty() ) {
-        wheel_factor = 50;
+        rolling_wheel_factor = 50;
     } else {
         // should really sum the each wheel's c_rolling_resistance * it's share of vehicle mass
+        rolling_wheel_factor = 0;
         for( int wheel : wheelcache ) {
-            wheel_factor += parts[ wheel ].info().wheel_rolling_resistance();
+            rolling_wheel_factor += parts[ wheel ].info().wheel_rolling_resistance();
         }
         // mildly increasing rolling resistance for vehicles with more than 4 wheels and mildly
         // decrease it for vehicles with less
-        wheel_factor *= wheel_ratio /
-                        ( base_wheels * wheel_ratio - base_wheels + wheelcache.size() );
+        rolling_wheel_factor *= wheel_ratio /
+                                ( base_wheels * wheel_ratio - base_wheels + wheelcache.size() );
     }
-    coefficient_rolling_resistance = newton_ratio * wheel_factor * to_kilogram( total_mass() );
+
+    const size_t structure_count = all_parts_at_location( part_location_structure ).size();
+    if( structure_count == 0 ) {
+        hull_coverage = 0;
+        hull_width_m = 1;
+        hull_area_m = 0;
+    } else {
+        hull_coverage = static_cast<double>( floating.size() ) / structure_count;
+
+        int tile_width = mount_max.y - mount_min.y + 1;
+        hull_width_m = tile_to_width( tile_width );
+
+        // actual area of the hull in m^2 (handles non-rectangular shapes)
+        // footprint area in tiles = tile width * tile length
+        // effective footprint percent = # of structure tiles / footprint area in tiles
+        // actual hull area in m^2 = footprint percent * length in meters * width in meters
+        // length in meters = length in tiles
+        // actual area in m = # of structure tiles * length in tiles * width in meters /
+        //                    ( length in tiles * width in tiles )
+        // actual area in m = # of structure tiles * width in meters / width in tiles
+        double actual_area_m = hull_width_m * structure_count / tile_width;
+
+        // effective hull area is actual hull area * hull coverage
+        hull_area_m = actual_area_m * std::max( 0.1, hull_coverage );
+    }
+    drag_shape_dirty = false;
+}
+
+double vehicle::coeff_rolling_drag() const
+{
+    if( !coeff_rolling_dirty ) {
+        return coefficient_rolling_resistance;
+    }
+    // SAE J2452 measurements are in F_rr = N * C_rr * 0.000225 * ( v + 33.33 )
+    // Don't ask me why, but it's the numbers we have. We want N * C_rr * 0.000225 here,
+    // and N is mass * accel from gravity (aka weight)
+    constexpr double sae_ratio = 0.000225;
+    constexpr double newton_ratio = accel_g * sae_ratio;
+    update_drag_shape();
+    coefficient_rolling_resistance = newton_ratio * rolling_wheel_factor *
+                                     to_kilogram( total_mass() );
     coeff_rolling_dirty = false;
     return coefficient_rolling_resistance;
 }
@@ -4213,31 +4265,14 @@ double vehicle::coeff_water_drag() const
     if( !coeff_water_dirty ) {
         return coefficient_water_resistance;
     }
-    std::vector<int> structure_indices = all_parts_at_location( part_location_structure );
-    if( structure_indices.empty() ) {
+    update_drag_shape();
+    if( hull_area_m <= 0 ) {
         // huh?
         coeff_water_dirty = false;
         hull_height = 0.3;
         draft_m = 1.0;
         return 1250.0;
     }
-    double hull_coverage = static_cast<double>( floating.size() ) / structure_indices.size();
-
-    int tile_width = mount_max.y - mount_min.y + 1;
-    double width_m = tile_to_width( tile_width );
-
-    // actual area of the hull in m^2 (handles non-rectangular shapes)
-    // footprint area in tiles = tile width * tile length
-    // effective footprint percent = # of structure tiles / footprint area in tiles
-    // actual hull area in m^2 = footprint percent * length in meters * width in meters
-    // length in meters = length in tiles
-    // actual area in m = # of structure tiles * length in tiles * width in meters /
-    //                    ( length in tiles * width in tiles )
-    // actual area in m = # of structure tiles * width in meters / width in tiles
-    double actual_area_m = width_m * structure_indices.size() / tile_width;
-
-    // effective hull area is actual hull area * hull coverage
-    double hull_area_m   = actual_area_m * std::max( 0.1, hull_coverage );
     // Treat the hullform as a simple cuboid to calculate displaced depth of
     // water.
     // Apply Archimedes' principle (mass of water displaced is mass of vehicle).
@@ -4253,7 +4288,7 @@ double vehicle::coeff_water_drag() const
     hull_height = 0.3 + 0.5 * hull_coverage;
     // F_water_drag = c_water_drag * cross_area * 1/2 * water_density * v^2
     // coeff_water_resistance = c_water_drag * cross_area * 1/2 * water_density
-    coefficient_water_resistance = c_water_drag * width_m * draft_m * 0.5 * water_density;
+    coefficient_water_resistance = c_water_drag * hull_width_m * draft_m * 0.5 * water_density;
     coeff_water_dirty = false;
     return coefficient_water_resistance;
 }
@@ -5047,31 +5082,138 @@ int vehicle::traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action
     return amount;
 }
 
+namespace
+{
+
+struct battery_fill {
+    vehicle_part *part;
+    int remaining;
+    int capacity;
+};
+
+} // namespace
+
+// Whether a is less full than b, as a fraction of its capacity.
+static bool emptier_battery( const battery_fill &a, const battery_fill &b )
+{
+    return static_cast<int64_t>( a.remaining ) * b.capacity <
+           static_cast<int64_t>( b.remaining ) * a.capacity;
+}
+
+// Hand out one unit at a time to the given batteries that can still take (or give) one, for
+// the few units the common level rounded away.
+template<typename Step>
+static int spread_remainder( std::vector<battery_fill> &fills, size_t count, int amount,
+                             Step step )
+{
+    bool progress = true;
+    while( amount > 0 && progress ) {
+        progress = false;
+        for( size_t i = 0; i < count && amount > 0; ++i ) {
+            if( step( fills[i] ) ) {
+                --amount;
+                progress = true;
+            }
+        }
+    }
+    return amount;
+}
+
+// Raise the emptiest batteries to a common charge fraction in one go, which is where
+// charging them a percent at a time ends up.  Returns the charge that did not fit.
+static int fill_batteries( std::vector<battery_fill> &fills, int amount )
+{
+    std::sort( fills.begin(), fills.end(), emptier_battery );
+    int64_t sum_remaining = 0;
+    int64_t sum_capacity = 0;
+    size_t count = 0;
+    while( count < fills.size() ) {
+        sum_remaining += fills[count].remaining;
+        sum_capacity += fills[count].capacity;
+        ++count;
+        if( count == fills.size() ) {
+            break;
+        }
+        // Stop once bringing these up to the next battery's level would take all of amount.
+        const battery_fill &next = fills[count];
+        if( static_cast<int64_t>( next.remaining ) * sum_capacity >=
+            ( amount + sum_remaining ) * next.capacity ) {
+            break;
+        }
+    }
+    const int64_t level = amount + sum_remaining;
+    for( size_t i = 0; i < count; ++i ) {
+        battery_fill &f = fills[i];
+        const int target = static_cast<int>( std::min<int64_t>( f.capacity,
+                                             level * f.capacity / sum_capacity ) );
+        amount -= target - f.remaining;
+        f.remaining = target;
+    }
+    return spread_remainder( fills, count, amount, []( battery_fill & f ) {
+        if( f.remaining >= f.capacity ) {
+            return false;
+        }
+        ++f.remaining;
+        return true;
+    } );
+}
+
+// The reverse of fill_batteries: lower the fullest batteries to a common charge fraction.
+// Returns the charge that could not be drawn.
+static int drain_batteries( std::vector<battery_fill> &fills, int amount )
+{
+    std::sort( fills.begin(), fills.end(), []( const battery_fill & a, const battery_fill & b ) {
+        return emptier_battery( b, a );
+    } );
+    int64_t sum_remaining = 0;
+    int64_t sum_capacity = 0;
+    size_t count = 0;
+    while( count < fills.size() ) {
+        sum_remaining += fills[count].remaining;
+        sum_capacity += fills[count].capacity;
+        ++count;
+        if( count == fills.size() ) {
+            break;
+        }
+        const battery_fill &next = fills[count];
+        if( sum_remaining * next.capacity - static_cast<int64_t>( next.remaining ) * sum_capacity >=
+            static_cast<int64_t>( amount ) * next.capacity ) {
+            break;
+        }
+    }
+    const int64_t level = std::max<int64_t>( 0, sum_remaining - amount );
+    for( size_t i = 0; i < count; ++i ) {
+        battery_fill &f = fills[i];
+        const int target = static_cast<int>( ( level * f.capacity + sum_capacity - 1 ) /
+                                             sum_capacity );
+        amount -= f.remaining - target;
+        f.remaining = target;
+    }
+    return spread_remainder( fills, count, amount, []( battery_fill & f ) {
+        if( f.remaining <= 0 ) {
+            return false;
+        }
+        --f.remaining;
+        return true;
+    } );
+}
+
 int vehicle::charge_battery( int amount, bool include_other_vehicles )
 {
-    // Key parts by percentage charge level.
-    std::multimap<int, vehicle_part *> chargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() &&
-            p.ammo_capacity( ammo_battery ) > p.ammo_remaining() ) {
-            chargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity( ammo_battery ), &p } );
+    std::vector<battery_fill> chargeable_parts;
+    for( const int bi : batteries ) {
+        vehicle_part &p = parts[bi];
+        const int capacity = p.ammo_capacity( ammo_battery );
+        if( p.is_available() && capacity > p.ammo_remaining() ) {
+            chargeable_parts.push_back( { &p, p.ammo_remaining(), capacity } );
         }
     }
-    while( amount > 0 && !chargeable_parts.empty() ) {
-        // Grab first part, charge until it reaches the next %, then re-insert with new % key.
-        auto iter = chargeable_parts.begin();
-        int charge_level = iter->first;
-        vehicle_part *p = iter->second;
-        chargeable_parts.erase( iter );
-        // Calculate number of charges to reach the next %, but insure it's at least
-        // one more than current charge.
-        int next_charge_level = ( ( charge_level + 1 ) * p->ammo_capacity( ammo_battery ) ) / 100;
-        next_charge_level = std::max( next_charge_level, p->ammo_remaining() + 1 );
-        int qty = std::min( amount, next_charge_level - p->ammo_remaining() );
-        p->ammo_set( fuel_type_battery, p->ammo_remaining() + qty );
-        amount -= qty;
-        if( p->ammo_capacity( ammo_battery ) > p->ammo_remaining() ) {
-            chargeable_parts.insert( { ( p->ammo_remaining() * 100 ) / p->ammo_capacity( ammo_battery ), p } );
+    if( amount > 0 && !chargeable_parts.empty() ) {
+        amount = fill_batteries( chargeable_parts, amount );
+        for( const battery_fill &f : chargeable_parts ) {
+            if( f.remaining != f.part->ammo_remaining() ) {
+                f.part->ammo_set( fuel_type_battery, f.remaining );
+            }
         }
     }
 
@@ -5089,26 +5231,20 @@ int vehicle::charge_battery( int amount, bool include_other_vehicles )
 
 int vehicle::discharge_battery( int amount, bool recurse )
 {
-    // Key parts by percentage charge level.
-    std::multimap<int, vehicle_part *> dischargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() && p.ammo_remaining() > 0 ) {
-            dischargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity( ammo_battery ), &p } );
+    std::vector<battery_fill> dischargeable_parts;
+    for( const int bi : batteries ) {
+        vehicle_part &p = parts[bi];
+        if( p.is_available() && p.ammo_remaining() > 0 ) {
+            dischargeable_parts.push_back( { &p, p.ammo_remaining(), p.ammo_capacity( ammo_battery ) } );
         }
     }
-    while( amount > 0 && !dischargeable_parts.empty() ) {
-        // Grab first part, discharge until it reaches the next %, then re-insert with new % key.
-        auto iter = std::prev( dischargeable_parts.end() );
-        int charge_level = iter->first;
-        vehicle_part *p = iter->second;
-        dischargeable_parts.erase( iter );
-        // Calculate number of charges to reach the previous %.
-        int prev_charge_level = ( ( charge_level - 1 ) * p->ammo_capacity( ammo_battery ) ) / 100;
-        int amount_to_discharge = std::min( p->ammo_remaining() - prev_charge_level, amount );
-        p->ammo_consume( amount_to_discharge, global_part_pos3( *p ) );
-        amount -= amount_to_discharge;
-        if( p->ammo_remaining() > 0 ) {
-            dischargeable_parts.insert( { ( p->ammo_remaining() * 100 ) / p->ammo_capacity( ammo_battery ), p } );
+    if( amount > 0 && !dischargeable_parts.empty() ) {
+        amount = drain_batteries( dischargeable_parts, amount );
+        for( const battery_fill &f : dischargeable_parts ) {
+            const int drawn = f.part->ammo_remaining() - f.remaining;
+            if( drawn > 0 ) {
+                f.part->ammo_consume( drawn, global_part_pos3( *f.part ) );
+            }
         }
     }
 
@@ -5336,10 +5472,11 @@ cata::optional<vehicle_stack::iterator> vehicle::add_item( int part, const item
     if( charge ) {
         item *here = istack.stacks_with( itm );
         if( here ) {
-            invalidate_mass();
+            const units::mass old_weight = here->weight();
             if( !here->merge_charges( itm ) ) {
                 return cata::nullopt;
             } else {
+                add_cargo_mass( p, here->weight() - old_weight );
                 return cata::optional<vehicle_stack::iterator>( istack.get_iterator_from_pointer( here ) );
             }
         }
@@ -5358,7 +5495,7 @@ cata::optional<vehicle_stack::iterator> vehicle::add_item( int part, const item
         active_items.add( *new_pos, p.mount );
     }
 
-    invalidate_mass();
+    add_cargo_mass( p, new_pos->weight() );
     return cata::optional<vehicle_stack::iterator>( new_pos );
 }
 
@@ -5380,7 +5517,7 @@ vehicle_stack::iterator vehicle::remove_item( int part, const vehicle_stack::con
     // remove from the active items cache (if it isn't there does nothing)
     active_items.remove( &*it );
 
-    invalidate_mass();
+    add_cargo_mass( parts[part], -it->weight() );
     return veh_items.erase( it );
 }
 
@@ -5585,6 +5722,7 @@ void vehicle::enable_refresh()
     coeff_air_dirty = true;
     coeff_water_dirty = true;
     coeff_air_changed = true;
+    drag_shape_dirty = true;
     refresh();
 }
 
@@ -5592,6 +5730,118 @@ void vehicle::enable_refresh()
  * Refreshes all caches and refinds all parts. Used after the vehicle has had a part added or removed.
  * Makes indices of different part types so they're easy to find. Also calculates power drain.
  */
+void vehicle::add_to_part_caches( const vpart_reference &vp )
+{
+    const int p = vp.part_index();
+    const vpart_info &vpi = vp.info();
+    const point pt = vp.mount();
+
+    // Keep the parts at pt sorted, so they display properly when examining
+    const auto inserted = relative_parts.emplace( pt, std::vector<int>() );
+    if( inserted.second ) {
+        relative_grid.dirty = true;
+    }
+    std::vector<int> &parts_here = inserted.first->second;
+    const auto by_list_order = [this]( const int p1, const int p2 ) {
+        return part_info( p1 ).list_order < part_info( p2 ).list_order;
+    };
+    parts_here.insert( std::lower_bound( parts_here.begin(), parts_here.end(), p, by_list_order ),
+                       p );
+
+    if( vpi.has_flag( VPFLAG_FLOATS ) ) {
+        floating.push_back( p );
+    }
+
+    if( vp.part().is_unavailable() ) {
+        return;
+    }
+    if( vpi.has_flag( VPFLAG_ALTERNATOR ) ) {
+        alternators.push_back( p );
+    }
+    if( vpi.has_flag( VPFLAG_ENGINE ) ) {
+        engines.push_back( p );
+    }
+    if( vpi.has_flag( VPFLAG_REACTOR ) ) {
+        reactors.push_back( p );
+    }
+    if( vpi.has_flag( VPFLAG_SOLAR_PANEL ) ) {
+        solar_panels.push_back( p );
+    }
+    if( vpi.has_flag( VPFLAG_ROTOR ) || vpi.has_flag( VPFLAG_ROTOR_SIMPLE ) ) {
+        rotors.push_back( p );
+    }
+    if( vp.part().is_battery() ) {
+        batteries.push_back( p );
+    }
+    if( vp.part().is_fuel_store( false ) ) {
+        fuel_containers.push_back( p );
+    }
+    if( vp.part().is_turret() ) {
+        turret_locations.push_back( p );
+    }
+    if( vpi.has_flag( "WIND_TURBINE" ) ) {
+        wind_turbines.push_back( p );
+    }
+    if( vpi.has_flag( "WIND_POWERED" ) ) {
+        sails.push_back( p );
+    }
+    if( vpi.has_flag( "WATER_WHEEL" ) ) {
+        water_wheels.push_back( p );
+    }
+    if( vpi.has_flag( "FUNNEL" ) ) {
+        funnels.push_back( p );
+    }
+    if( vpi.has_flag( "UNMOUNT_ON_MOVE" ) ) {
+        loose_parts.push_back( p );
+    }
+    if( !vpi.emissions.empty() || !vpi.exhaust.empty() ) {
+        emitters.push_back( p );
+    }
+    if( vpi.has_flag( VPFLAG_WHEEL ) ) {
+        wheelcache.push_back( p );
+    }
+    if( vpi.has_flag( "SMART_ENGINE_CONTROLLER" ) && vp.part().enabled ) {
+        has_enabled_smart_controller = true;
+    }
+    if( vpi.has_flag( VPFLAG_WHEEL ) && vpi.has_flag( VPFLAG_RAIL ) ) {
+        rail_wheelcache.push_back( p );
+    }
+    if( ( vpi.has_flag( "STEERABLE" ) && part_with_feature( pt, "STEERABLE", true ) != -1 ) ||
+        vpi.has_flag( "TRACKED" ) ) {
+        // TRACKED contributes to steering effectiveness but
+        //  (a) doesn't count as a steering axle for install difficulty
+        //  (b) still contributes to drag for the center of steering calculation
+        steering.push_back( p );
+    }
+    if( vpi.has_flag( "SECURITY" ) ) {
+        speciality.push_back( p );
+    }
+    if( vp.part().enabled && vpi.has_flag( "EXTRA_DRAG" ) ) {
+        extra_drag += vpi.power;
+    }
+    if( vpi.has_flag( "EXTRA_DRAG" ) && ( vpi.has_flag( "WIND_TURBINE" ) ||
+                                          vpi.has_flag( "WATER_WHEEL" ) ) ) {
+        extra_drag += vpi.power;
+    }
+    if( camera_on && vpi.has_flag( "CAMERA" ) ) {
+        vp.part().enabled = true;
+    } else if( !camera_on && vpi.has_flag( "CAMERA" ) ) {
+        vp.part().enabled = false;
+    }
+    if( vpi.has_flag( "TURRET" ) && !has_part( global_part_pos3( vp.part() ), "TURRET_CONTROLS" ) ) {
+        vp.part().enabled = false;
+    }
+    if( vpi.has_flag( "MUFFLER" ) ) {
+        mufflers.push_back( p );
+    }
+    if( vpi.has_flag( "PLANTER" ) ) {
+        planters.push_back( p );
+    }
+    if( vpi.has_flag( VPFLAG_ENABLED_DRAINS_EPOWER ) ) {
+        accessories.push_back( p );
+    }
+}
+
 void vehicle::refresh()
 {
     if( no_refresh ) {
@@ -5608,6 +5858,7 @@ void vehicle::refresh()
     funnels.clear();
     emitters.clear();
     relative_parts.clear();
+    relative_grid.dirty = true;
     loose_parts.clear();
     wheelcache.clear();
     rail_wheelcache.clear();
@@ -5627,14 +5878,6 @@ void vehicle::refresh()
     all_wheels_on_one_axis = true;
     int first_wheel_y_mount = INT_MAX;
 
-    // Used to sort part list so it displays properly when examining
-    struct sort_veh_part_vector {
-        vehicle *veh;
-        inline bool operator()( const int p1, const int p2 ) {
-            return veh->part_info( p1 ).list_order < veh->part_info( p2 ).list_order;
-        }
-    } svpv = { this };
-
     mount_min.x = 123;
     mount_min.y = 123;
     mount_max.x = -123;
@@ -5652,87 +5895,26 @@ void vehicle::refresh()
 
     // Main loop over all vehicle parts.
     for( const vpart_reference &vp : get_all_parts() ) {
-        const size_t p = vp.part_index();
-        const vpart_info &vpi = vp.info();
         if( vp.part().removed ) {
             continue;
         }
         refresh_done = true;
 
-        // Build map of point -> all parts in that point
         const point pt = vp.mount();
         mount_min.x = std::min( mount_min.x, pt.x );
         mount_min.y = std::min( mount_min.y, pt.y );
         mount_max.x = std::max( mount_max.x, pt.x );
         mount_max.y = std::max( mount_max.y, pt.y );
 
-        // This will keep the parts at point pt sorted
-        std::vector<int>::iterator vii = std::lower_bound( relative_parts[pt].begin(),
-                                         relative_parts[pt].end(),
-                                         static_cast<int>( p ), svpv );
-        relative_parts[pt].insert( vii, p );
+        add_to_part_caches( vp );
 
-        if( vpi.has_flag( VPFLAG_FLOATS ) ) {
-            floating.push_back( p );
-        }
-
-        if( vp.part().is_unavailable() ) {
-            continue;
-        }
-        if( vpi.has_flag( VPFLAG_ALTERNATOR ) ) {
-            alternators.push_back( p );
-        }
-        if( vpi.has_flag( VPFLAG_ENGINE ) ) {
-            engines.push_back( p );
-        }
-        if( vpi.has_flag( VPFLAG_REACTOR ) ) {
-            reactors.push_back( p );
-        }
-        if( vpi.has_flag( VPFLAG_SOLAR_PANEL ) ) {
-            solar_panels.push_back( p );
-        }
-        if( vpi.has_flag( VPFLAG_ROTOR ) || vpi.has_flag( VPFLAG_ROTOR_SIMPLE ) ) {
-            rotors.push_back( p );
-        }
-        if( vp.part().is_battery() ) {
-            batteries.push_back( p );
-        }
-        if( vp.part().is_fuel_store( false ) ) {
-            fuel_containers.push_back( p );
-        }
-        if( vp.part().is_turret() ) {
-            turret_locations.push_back( p );
-        }
-        if( vpi.has_flag( "WIND_TURBINE" ) ) {
-            wind_turbines.push_back( p );
-        }
-        if( vpi.has_flag( "WIND_POWERED" ) ) {
-            sails.push_back( p );
-        }
-        if( vpi.has_flag( "WATER_WHEEL" ) ) {
-            water_wheels.push_back( p );
-        }
-        if( vpi.has_flag( "FUNNEL" ) ) {
-            funnels.push_back( p );
-        }
-        if( vpi.has_flag( "UNMOUNT_ON_MOVE" ) ) {
-            loose_parts.push_back( p );
-        }
-        if( !vpi.emissions.empty() || !vpi.exhaust.empty() ) {
-            emitters.push_back( p );
-        }
-        if( vpi.has_flag( VPFLAG_WHEEL ) ) {
-            wheelcache.push_back( p );
-        }
-        if( vpi.has_flag( "SMART_ENGINE_CONTROLLER" ) && vp.part().enabled ) {
-            has_enabled_smart_controller = true;
-        }
-        if( vpi.has_flag( VPFLAG_WHEEL ) && vpi.has_flag( VPFLAG_RAIL ) ) {
-            rail_wheelcache.push_back( p );
+        const vpart_info &vpi = vp.info();
+        if( !vp.part().is_unavailable() && vpi.has_flag( VPFLAG_WHEEL ) &&
+            vpi.has_flag( VPFLAG_RAIL ) ) {
             if( first_wheel_y_mount == INT_MAX ) {
-                first_wheel_y_mount = vp.part().mount.y;
+                first_wheel_y_mount = pt.y;
             }
-            if( first_wheel_y_mount != vp.part().mount.y ) {
+            if( first_wheel_y_mount != pt.y ) {
                 // vehicle have wheels on different axis
                 all_wheels_on_one_axis = false;
             }
@@ -5742,40 +5924,6 @@ void vehicle::refresh()
             railwheel_xmax = std::max( railwheel_xmax, pt.x );
             railwheel_ymax = std::max( railwheel_ymax, pt.y );
         }
-        if( ( vpi.has_flag( "STEERABLE" ) && part_with_feature( pt, "STEERABLE", true ) != -1 ) ||
-            vpi.has_flag( "TRACKED" ) ) {
-            // TRACKED contributes to steering effectiveness but
-            //  (a) doesn't count as a steering axle for install difficulty
-            //  (b) still contributes to drag for the center of steering calculation
-            steering.push_back( p );
-        }
-        if( vpi.has_flag( "SECURITY" ) ) {
-            speciality.push_back( p );
-        }
-        if( vp.part().enabled && vpi.has_flag( "EXTRA_DRAG" ) ) {
-            extra_drag += vpi.power;
-        }
-        if( vpi.has_flag( "EXTRA_DRAG" ) && ( vpi.has_flag( "WIND_TURBINE" ) ||
-                                              vpi.has_flag( "WATER_WHEEL" ) ) ) {
-            extra_drag += vpi.power;
-        }
-        if( camera_on && vpi.has_flag( "CAMERA" ) ) {
-            vp.part().enabled = true;
-        } else if( !camera_on && vpi.has_flag( "CAMERA" ) ) {
-            vp.part().enabled = false;
-        }
-        if( vpi.has_flag( "TURRET" ) && !has_part( global_part_pos3( vp.part() ), "TURRET_CONTROLS" ) ) {
-            vp.part().enabled = false;
-        }
-        if( vpi.has_flag( "MUFFLER" ) ) {
-            mufflers.push_back( p );
-        }
-        if( vpi.has_flag( "PLANTER" ) ) {
-            planters.push_back( p );
-        }
-        if( vpi.has_flag( VPFLAG_ENABLED_DRAINS_EPOWER ) ) {
-            accessories.push_back( p );
-        }
     }
 
     rail_wheel_bounding_box.p1 = point( railwheel_xmin, railwheel_ymin );
@@ -5792,13 +5940,113 @@ void vehicle::refresh()
 
     // NB: using the _old_ pivot point, don't recalc here, we only do that when moving!
     precalc_mounts( 0, pivot_rotation[0], pivot_anchor[0] );
+    refresh_dirty_caches();
+}
+
+void vehicle::refresh_dirty_caches()
+{
     check_environmental_effects = true;
     insides_dirty = true;
     zones_dirty = true;
+    drag_shape_dirty = true;
     invalidate_mass();
     occupied_cache_pos = { -1, -1, -1 };
 }
 
+// Parts whose caches depend on other parts, or on state refresh() last saw; changing one
+// of these needs the full refresh.
+static bool needs_full_refresh( const vpart_info &vpi )
+{
+    return ( vpi.has_flag( VPFLAG_WHEEL ) && vpi.has_flag( VPFLAG_RAIL ) ) ||
+           vpi.has_flag( "SMART_ENGINE_CONTROLLER" ) || vpi.has_flag( "TURRET_CONTROLS" ) ||
+           vpi.has_flag( "EXTRA_DRAG" );
+}
+
+void vehicle::remove_from_part_caches( const int p, const bool unmount )
+{
+    const auto erase_from = [p]( std::vector<int> &list ) {
+        list.erase( std::remove( list.begin(), list.end(), p ), list.end() );
+    };
+    for( std::vector<int> *list : {
+             &alternators, &engines, &reactors, &solar_panels, &wind_turbines, &sails,
+             &water_wheels, &funnels, &emitters, &loose_parts, &wheelcache, &rotors, &steering,
+             &speciality, &batteries, &fuel_containers, &turret_locations, &mufflers, &planters,
+             &accessories
+         } ) {
+        erase_from( *list );
+    }
+    if( unmount ) {
+        erase_from( floating );
+        const auto here = relative_parts.find( parts[p].mount );
+        if( here != relative_parts.end() ) {
+            erase_from( here->second );
+            if( here->second.empty() ) {
+                relative_parts.erase( here );
+                relative_grid.dirty = true;
+            }
+        }
+    }
+}
+
+void vehicle::refresh_installed_part( const int p )
+{
+    if( no_refresh ) {
+        return;
+    }
+    const vehicle_part &vp = parts[p];
+    if( relative_parts.empty() || needs_full_refresh( vp.info() ) ) {
+        refresh();
+        return;
+    }
+    smart_controller_state = cata::nullopt;
+    // The new part has the highest index, so it goes to the back of every index list.
+    add_to_part_caches( vpart_reference( *this, p ) );
+    mount_min.x = std::min( mount_min.x, vp.mount.x );
+    mount_min.y = std::min( mount_min.y, vp.mount.y );
+    mount_max.x = std::max( mount_max.x, vp.mount.x );
+    mount_max.y = std::max( mount_max.y, vp.mount.y );
+    front_left.x = mount_max.x;
+    front_left.y = mount_min.y;
+    front_right = mount_max;
+    precalc_mounts( 0, pivot_rotation[0], pivot_anchor[0] );
+    refresh_dirty_caches();
+}
+
+void vehicle::refresh_broken_part( const int p )
+{
+    if( no_refresh ) {
+        return;
+    }
+    if( needs_full_refresh( parts[p].info() ) ) {
+        refresh();
+        return;
+    }
+    smart_controller_state = cata::nullopt;
+    // Broken parts keep their place on the mount, but leave every list of working parts.
+    remove_from_part_caches( p, false );
+    refresh_dirty_caches();
+}
+
+void vehicle::refresh_removed_part( const int p )
+{
+    if( no_refresh ) {
+        return;
+    }
+    const point pt = parts[p].mount;
+    const auto here = relative_parts.find( pt );
+    // Emptying a square on the edge may shrink the mount bounds.
+    const bool on_edge = pt.x == mount_min.x || pt.x == mount_max.x ||
+                         pt.y == mount_min.y || pt.y == mount_max.y;
+    if( needs_full_refresh( parts[p].info() ) || here == relative_parts.end() ||
+        ( on_edge && here->second.size() <= 1 ) ) {
+        refresh();
+        return;
+    }
+    smart_controller_state = cata::nullopt;
+    remove_from_part_caches( p, true );
+    refresh_dirty_caches();
+}
+
 const point &vehicle::pivot_point() const
 {
     if( pivot_dirty ) {
@@ -6668,7 +6916,7 @@ int vehicle::damage_direct( int p, int dmg, damage_type type )
         coeff_air_changed = true;
 
         // refresh cache in case the broken part has changed the status
-        refresh();
+        refresh_broken_part( p );
     }
 
     if( parts[p].is_fuel_store() ) {
@@ -7048,8 +7296,10 @@ void vehicle::refresh_mass() const
 
 void vehicle::calc_mass_center( bool use_precalc ) const
 {
-    units::quantity<float, units::mass::unit_type> xf;
-    units::quantity<float, units::mass::unit_type> yf;
+    units::quantity<double, units::mass::unit_type> xf;
+    units::quantity<double, units::mass::unit_type> yf;
+    units::quantity<double, units::mass::unit_type> mount_xf;
+    units::quantity<double, units::mass::unit_type> mount_yf;
     units::mass m_total = 0_gram;
     for( const vpart_reference &vp : get_all_parts() ) {
         const size_t i = vp.part_index();
@@ -7077,10 +7327,9 @@ void vehicle::calc_mass_center( bool use_precalc ) const
         if( use_precalc ) {
             xf += vp.part().precalc[0].x * m_part;
             yf += vp.part().precalc[0].y * m_part;
-        } else {
-            xf += vp.mount().x * m_part;
-            yf += vp.mount().y * m_part;
         }
+        mount_xf += vp.mount().x * m_part;
+        mount_yf += vp.mount().y * m_part;
 
         m_total += m_part;
     }
@@ -7088,19 +7337,44 @@ void vehicle::calc_mass_center( bool use_precalc ) const
     mass_cache = m_total;
     mass_dirty = false;
 
-    const float x = xf / mass_cache;
-    const float y = yf / mass_cache;
+    // Both centers come out of the same walk, and the mount based one is kept up to date
+    // by add_cargo_mass from here on.
+    mass_moment_x = mount_xf;
+    mass_moment_y = mount_yf;
+    mass_center_no_precalc.x = std::round( mount_xf / mass_cache );
+    mass_center_no_precalc.y = std::round( mount_yf / mass_cache );
+    mass_center_no_precalc_dirty = false;
     if( use_precalc ) {
-        mass_center_precalc.x = std::round( x );
-        mass_center_precalc.y = std::round( y );
+        mass_center_precalc.x = std::round( xf / mass_cache );
+        mass_center_precalc.y = std::round( yf / mass_cache );
         mass_center_precalc_dirty = false;
-    } else {
-        mass_center_no_precalc.x = std::round( x );
-        mass_center_no_precalc.y = std::round( y );
-        mass_center_no_precalc_dirty = false;
     }
 }
 
+void vehicle::add_cargo_mass( const vehicle_part &vp, units::mass delta )
+{
+    if( vp.info().cargo_weight_modifier != 100 ) {
+        delta *= vp.info().cargo_weight_modifier / 100;
+    }
+    if( no_refresh ) {
+        return;
+    }
+    if( mass_dirty || mass_center_no_precalc_dirty || mass_cache + delta <= 0_gram ) {
+        invalidate_mass();
+        return;
+    }
+    mass_cache += delta;
+    mass_moment_x += vp.mount.x * delta;
+    mass_moment_y += vp.mount.y * delta;
+    mass_center_no_precalc.x = std::round( mass_moment_x / mass_cache );
+    mass_center_no_precalc.y = std::round( mass_moment_y / mass_cache );
+    // Everything else that depends on the mass still has to be worked out again.
+    mass_center_precalc_dirty = true;
+    pivot_dirty = true;
+    coeff_rolling_dirty = true;
+    coeff_water_dirty = true;
+}
+
 bounding_box vehicle::get_bounding_box()
 {
     int min_x = INT_MAX;
@@ -7197,7 +7471,6 @@ std::set<int> vehicle::advance_precalc_mounts( const point &new_pos, const tripo
     int index = -1;
     for( vehicle_part &prt : parts ) {
         index += 1;
-        here.clear_vehicle_point_from_cache( this, src + prt.precalc[0] );
         // no parts means this is a normal horizontal or vertical move
         if( parts_to_move.empty() ) {
             prt.precalc[0] = prt.precalc[1];
@@ -49,6 +49,7 @@ class vehicle;
 class vehicle_part_range;
 class vpart_info;
 class vpart_position;
+class vpart_reference;
 class zone_data;
 struct input_event;
 struct itype;
@@ -728,6 +729,11 @@ class vehicle
 
         //Refresh all caches and re-locate all parts
         void refresh();
+        // Patch the caches for a single part that was just installed, broke or was removed,
+        // falling back to refresh() where that part's caches depend on the others.
+        void refresh_installed_part( int p );
+        void refresh_broken_part( int p );
+        void refresh_removed_part( int p );
 
         // Do stuff like clean up blood and produce smoke from broken parts. Returns false if nothing needs doing.
         bool do_environmental_effects();
@@ -751,9 +757,20 @@ class vehicle
 
         // refresh pivot_cache, clear pivot_dirty
         void refresh_pivot() const;
+        // Add one part to relative_parts and the lists of part indices, as refresh() does
+        void add_to_part_caches( const vpart_reference &vp );
+        // Take one part off the lists of part indices, and off its mount point if unmount
+        void remove_from_part_caches( int p, bool unmount );
+        // Mark everything derived from the set of parts as needing to be recalculated
+        void refresh_dirty_caches();
+        // Recalculate the wheel and hull figures the drag coeffs scale by mass
+        void update_drag_shape() const;
 
         void refresh_mass() const;
         void calc_mass_center( bool precalc ) const;
+        // Account for cargo of the given (unscaled) weight going into or out of vp, without
+        // walking every part again
+        void add_cargo_mass( const vehicle_part &vp, units::mass delta );
 
         /** empty the contents of a tank, battery or turret spilling liquids randomly on the ground */
         void leak_fuel( vehicle_part &pt );
@@ -1023,6 +1040,11 @@ class vehicle
 
         // returns the list of indices of parts at certain position (not accounting frame direction)
         std::vector<int> parts_at_relative( const point &dp, bool use_cache ) const;
+        /**
+         * The parts at dp from the relative parts cache, without copying them. The reference
+         * is only good until parts are next added to or taken off the vehicle.
+         */
+        const std::vector<int> &parts_at_mount( const point &dp ) const;
 
         // returns index of part, inner to given, with certain flag, or -1
         int part_with_feature( int p, const std::string &f, bool unbroken ) const;
@@ -1832,6 +1854,12 @@ class vehicle
         mutable double coefficient_water_resistance = 1; // NOLINT(cata-serialize)
         mutable double draft_m = 1; // NOLINT(cata-serialize)
         mutable double hull_height = 0.3; // NOLINT(cata-serialize)
+        // the mass independent parts of the rolling and water drag: the summed wheel
+        // resistance, and the hull's width, area and board coverage
+        mutable double rolling_wheel_factor = 50; // NOLINT(cata-serialize)
+        mutable double hull_width_m = 1; // NOLINT(cata-serialize)
+        mutable double hull_area_m = 0; // NOLINT(cata-serialize)
+        mutable double hull_coverage = 0; // NOLINT(cata-serialize)
 
         // Global location when cache was last refreshed.
         mutable tripoint occupied_cache_pos = { -1, -1, -1 }; // NOLINT(cata-serialize)
@@ -1859,7 +1887,7 @@ class vehicle
         // Forcibly removes a part from this vehicle. Only exists to support faction_camp.cpp
         void force_erase_part( int part_num );
         // Updates the internal precalculated mount offsets after the vehicle has been displaced
-        // used in map::displace_vehicle()
+        // used in map::displace_vehicle(), which also keeps the map's vehicle caches in step
         std::set<int> advance_precalc_mounts( const point &new_pos, const tripoint &src,
                                               const tripoint &dp, int ramp_offset,
                                               bool adjust_pos, std::set<int> parts_to_move );
@@ -1900,6 +1928,26 @@ class vehicle
         vproto_id type;
         // parts_at_relative(dp) is used a lot (to put it mildly)
         std::map<point, std::vector<int>> relative_parts; // NOLINT(cata-serialize)
+    private:
+        // A flat grid over the bounding box of relative_parts, pointing at its entries, so that
+        // parts_at_mount does not have to walk the map. Marked dirty when an entry is added or
+        // erased. The pointers are into this vehicle's map, so copies start out dirty too.
+        struct relative_parts_grid {
+            std::vector<const std::vector<int> *> cells;
+            point min;
+            point size;
+            bool dirty = true;
+
+            relative_parts_grid() = default;
+            relative_parts_grid( const relative_parts_grid & ) {}
+            relative_parts_grid &operator=( const relative_parts_grid & ) {
+                cells.clear();
+                dirty = true;
+                return *this;
+            }
+        };
+        mutable relative_parts_grid relative_grid; // NOLINT(cata-serialize)
+    public:
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
@@ -1932,6 +1980,9 @@ class vehicle
         mutable point mount_min; // NOLINT(cata-serialize)
         mutable point mass_center_precalc; // NOLINT(cata-serialize)
         mutable point mass_center_no_precalc; // NOLINT(cata-serialize)
+        // mass weighted sums of the part mount points behind mass_center_no_precalc
+        mutable units::quantity<double, units::mass::unit_type> mass_moment_x; // NOLINT(cata-serialize)
+        mutable units::quantity<double, units::mass::unit_type> mass_moment_y; // NOLINT(cata-serialize)
         tripoint autodrive_local_target = tripoint_zero; // current node the autopilot is aiming for
         class autodrive_controller;
         std::shared_ptr<autodrive_controller> active_autodrive_controller; // NOLINT(cata-serialize)
@@ -2019,6 +2070,9 @@ class vehicle
         mutable bool coeff_rolling_dirty = true; // NOLINT(cata-serialize)
         mutable bool coeff_air_dirty = true; // NOLINT(cata-serialize)
         mutable bool coeff_water_dirty = true; // NOLINT(cata-serialize)
+        // set when parts change; mass changes only dirty the coeffs above, which then
+        // rescale the cached wheel and hull figures instead of walking the parts again
+        mutable bool drag_shape_dirty = true; // NOLINT(cata-serialize)
         // air uses a two stage dirty check: one dirty bit gets set on part install,
         // removal, or breakage. The other dirty bit only gets set during part_removal_cleanup,
         // and that's the bit that controls recalculation.  The intent is to only recalculate
@@ -282,6 +282,10 @@ struct auto_navigation_data {
     int max_steer;
 
     std::array<vehicle_profile, NUM_ORIENTATIONS> profiles;
+    // what the profiles were computed for; the shape of the vehicle only changes if it loses
+    // parts on the way, so they are kept from one OMT to the next
+    int profile_part_count;
+    point profile_pivot;
     // known obstacles on the view map
     bool is_obstacle[NAV_VIEW_SIZE_X][NAV_VIEW_SIZE_Y];
     // where on the nav map the vehicle pivot may be placed
@@ -296,6 +300,7 @@ struct auto_navigation_data {
 
     void clear() {
         current_omt = { 0, 0, -100 };
+        profile_part_count = -1;
         path.clear();
     }
     vehicle_profile &profile( orientation dir ) {
@@ -741,15 +746,23 @@ void vehicle::autodrive_controller::compute_obstacles()
 void vehicle::autodrive_controller::compute_valid_positions()
 {
     const coord_transformation veh_rot = {point_zero, -data.nav_to_map.rotation, point_zero};
+    const point veh_origin = veh_rot.transform( point_zero );
+    std::vector<point> view_offsets;
     for( orientation facing : all_orientations() ) {
         const vehicle_profile &profile = data.profile( data.nav_to_map.transform( facing ) );
+        // Where each point of the vehicle lands on the view map relative to the nav point,
+        // the same for every nav point under this facing.
+        view_offsets.clear();
+        for( const point &veh_pt : profile.occupied_zone ) {
+            view_offsets.push_back( veh_rot.transform( veh_pt ) - veh_origin );
+        }
         for( int mx = 0; mx < NAV_MAP_SIZE_X; mx++ ) {
             for( int my = 0; my < NAV_MAP_SIZE_Y; my++ ) {
                 const point nav_pt( mx, my );
+                const point view_base = data.nav_to_view.transform( nav_pt );
                 bool valid = true;
-                for( const point &veh_pt : profile.occupied_zone ) {
-                    const point view_pt = data.nav_to_view.transform( nav_pt ) + veh_rot.transform(
-                                              veh_pt ) - veh_rot.transform( point_zero );
+                for( const point &offset : view_offsets ) {
+                    const point view_pt = view_base + offset;
                     if( !data.view_bounds.contains( view_pt ) || data.is_obstacle[view_pt.x][view_pt.y] ) {
                         valid = false;
                         break;
@@ -819,8 +832,13 @@ void vehicle::autodrive_controller::precompute_data()
         // TODO: change it during simulation based on vehicle speed and terrain
         // or maybe just keep track of player moves?
         data.max_steer = 1;
-        for( orientation dir : all_orientations() ) {
-            data.profile( dir ) = compute_profile( dir );
+        const point pivot = driven_veh.pivot_point();
+        if( driven_veh.part_count() != data.profile_part_count || pivot != data.profile_pivot ) {
+            data.profile_part_count = driven_veh.part_count();
+            data.profile_pivot = pivot;
+            for( orientation dir : all_orientations() ) {
+                data.profile( dir ) = compute_profile( dir );
+            }
         }
 
         // initialize navigation data
@@ -772,13 +772,9 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != sm_pos.z;
-    Character &player_character = get_player_character();
-    const bool pl_ctrl = player_in_control( player_character );
     Creature *critter = get_creature_tracker().creature_at( p, true );
     Character *ph = dynamic_cast<Character *>( critter );
 
-    Creature *driver = pl_ctrl ? &player_character : nullptr;
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
@@ -897,6 +893,10 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         // Hit nothing or we aren't actually hitting
         return ret;
     }
+    // Only worked out once something is hit: most parts of a moving vehicle hit nothing.
+    Character &player_character = get_player_character();
+    const bool pl_ctrl = player_in_control( player_character );
+    Creature *driver = pl_ctrl ? &player_character : nullptr;
     stop_autodriving();
     // Calculate mass AFTER checking for collision
     //  because it involves iterating over all cargo
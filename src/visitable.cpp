@@ -6,6 +6,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -128,7 +129,7 @@ static int has_quality_from_vpart( const vehicle &veh, int part, const quality_i
     int qty = 0;
 
     point pos = veh.part( part ).mount;
-    for( const auto &n : veh.parts_at_relative( pos, true ) ) {
+    for( const int n : veh.parts_at_mount( pos ) ) {
 
         // only unbroken parts can provide tool qualities
         if( !veh.part( n ).is_broken() ) {
@@ -149,12 +150,55 @@ bool read_only_visitable::has_quality( const quality_id &qual, int level, int qt
     return has_quality_internal( *this, qual, level, qty ) == qty;
 }
 
+void inventory::index_qualities() const
+{
+    quality_index.clear();
+    for( const std::list<item> &stack : items ) {
+        const int stack_size = stack.size();
+        stack.front().visit_items( [this, stack_size]( const item * e, item * ) {
+            // An item also has the qualities of whatever it contains.
+            std::set<quality_id> qualities;
+            e->visit_items( [&qualities]( const item * sub, item * ) {
+                for( const std::pair<const quality_id, int> &q : sub->type->qualities ) {
+                    qualities.insert( q.first );
+                }
+                return VisitResponse::NEXT;
+            } );
+            const int num = sum_no_wrap( 0, static_cast<int>( e->count() ) * stack_size );
+            for( const quality_id &q : qualities ) {
+                int &count = quality_index[q][e->get_quality( q )];
+                count = sum_no_wrap( count, num );
+            }
+            return VisitResponse::NEXT;
+        } );
+    }
+    qualities_indexed = true;
+}
+
 /** @relates visitable */
 bool inventory::has_quality( const quality_id &qual, int level, int qty ) const
 {
+    if( level <= 0 ) {
+        // Every item counts as having any quality at level 0, which the index does not track.
+        int res = 0;
+        for( const auto &stack : this->items ) {
+            res += stack.size() * has_quality_internal( stack.front(), qual, level, qty );
+            if( res >= qty ) {
+                return true;
+            }
+        }
+        return false;
+    }
+    if( !qualities_indexed ) {
+        index_qualities();
+    }
+    const auto levels = quality_index.find( qual );
+    if( levels == quality_index.end() ) {
+        return false;
+    }
     int res = 0;
-    for( const auto &stack : this->items ) {
-        res += stack.size() * has_quality_internal( stack.front(), qual, level, qty );
+    for( auto it = levels->second.lower_bound( level ); it != levels->second.end(); ++it ) {
+        res = sum_no_wrap( res, it->second );
         if( res >= qty ) {
             return true;
         }
@@ -237,7 +281,7 @@ static int max_quality_from_vpart( const vehicle &veh, int part, const quality_i
     int res = INT_MIN;
 
     point pos = veh.part( part ).mount;
-    for( const auto &n : veh.parts_at_relative( pos, true ) ) {
+    for( const int n : veh.parts_at_mount( pos ) ) {
 
         // only unbroken parts can provide tool qualities
         if( !veh.part( n ).is_broken() ) {
@@ -582,6 +626,7 @@ std::list<item> inventory::remove_items_with( const
 
     // Invalidate binning cache
     binned = false;
+    qualities_indexed = false;
 
     return res;
 }
@@ -169,7 +169,7 @@ static inline void proc_weather_sum( const weather_type_id &wtype, weather_sum &
 weather_type_id current_weather( const tripoint &location, const time_point &t )
 {
     weather_manager &weather = get_weather();
-    const weather_generator wgen = weather.get_cur_weather_gen();
+    const weather_generator &wgen = weather.get_cur_weather_gen();
     if( weather.weather_override != WEATHER_NULL ) {
         return weather.weather_override;
     }
@@ -184,6 +184,13 @@ weather_sum sum_conditions( const time_point &start, const time_point &end,
     weather_sum data;
 
     weather_manager &weather = get_weather();
+    const weather_generator &wgen = weather.get_cur_weather_gen();
+    const unsigned seed = g->get_seed();
+    // The wind here does not depend on the time, so look it up once for the whole span.
+    const double windpower = get_local_windpower( weather.windspeed,
+                             // TODO: fix point types
+                             overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( location ) ) ),
+                             location, weather.winddirection, false );
     for( time_point t = start; t < end; t += tick_size ) {
         const time_duration diff = end - t;
         if( diff < 10_turns ) {
@@ -194,13 +201,11 @@ weather_sum sum_conditions( const time_point &start, const time_point &end,
             tick_size = 1_minutes;
         }
 
-        weather_type_id wtype = current_weather( location, t );
+        const weather_type_id wtype = weather.weather_override != WEATHER_NULL ?
+                                      weather.weather_override :
+                                      wgen.get_weather_conditions( location, t, seed );
         proc_weather_sum( wtype, data, t, tick_size );
-        data.wind_amount += get_local_windpower( weather.windspeed,
-                            // TODO: fix point types
-                            overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( location ) ) ),
-                            location,
-                            weather.winddirection, false ) * to_turns<int>( tick_size );
+        data.wind_amount += windpower * to_turns<int>( tick_size );
     }
     return data;
 }
@@ -418,16 +423,7 @@ void wet_character( Character &target, int amount )
     if( !calendar::once_every( 6_seconds ) ) {
         return;
     }
-    std::map<bodypart_id, std::vector<const item *>> clothing_map;
-    for( const bodypart_id &bp : target.get_all_body_parts() ) {
-        clothing_map.emplace( bp, std::vector<const item *>() );
-    }
-    for( const item &it : target.worn ) {
-        for( const bodypart_str_id &covered : it.get_covered_body_parts() ) {
-            clothing_map[covered.id()].emplace_back( &it );
-        }
-    }
-    std::map<bodypart_id, int> warmth_bp = target.warmth( clothing_map );
+    std::map<bodypart_id, int> warmth_bp = target.warmth( target.get_clothing_map() );
     const int warmth_delay = warmth_bp[body_part_torso] * 0.8 +
                              warmth_bp[body_part_head] * 0.2;
     if( rng( 0, 100 - amount + warmth_delay ) > 10 ) {
@@ -992,12 +988,7 @@ int weather_manager::get_temperature( const tripoint &location )
     }
 
     // local modifier
-    int temp_mod = 0;
-
-    if( !g->new_game ) {
-        temp_mod += get_heat_radiation( location, false );
-        temp_mod += get_convection_temperature( location );
-    }
+    const int temp_mod = g->new_game ? 0 : get_temperature_mod( location );
     //underground temperature = average New England temperature = 43F/6C rounded to int
     const int temp = ( location.z < 0 ? AVERAGE_ANNUAL_TEMPERATURE : temperature ) +
                      ( g->new_game ? 0 : get_map().get_temperature( location ) + temp_mod );
@@ -1011,9 +1002,21 @@ int weather_manager::get_temperature( const tripoint_abs_omt &location )
     return location.z() < 0 ? AVERAGE_ANNUAL_TEMPERATURE : temperature;
 }
 
+int weather_manager::get_temperature_mod( const tripoint &location )
+{
+    const auto cached = temperature_mod_cache.find( location );
+    if( cached != temperature_mod_cache.end() ) {
+        return cached->second;
+    }
+    const int temp_mod = get_heat_radiation( location, false ) + get_convection_temperature( location );
+    temperature_mod_cache.emplace( location, temp_mod );
+    return temp_mod;
+}
+
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    temperature_mod_cache.clear();
 }
 
 const weather_manager &get_weather_const()
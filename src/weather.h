@@ -181,10 +181,14 @@ class weather_manager
         time_point nextweather;
         /** temperature cache, cleared every turn, sparse map of map tripoints to temperatures */
         std::unordered_map< tripoint, int > temperature_cache;
+        /** Heat radiation plus convection at map tripoints, cleared along with @ref temperature_cache */
+        std::unordered_map< tripoint, int > temperature_mod_cache;
         // Returns outdoor or indoor temperature of given location (in absolute (@ref map::getabs))
         int get_temperature( const tripoint &location );
         // Returns outdoor or indoor temperature of given location
         int get_temperature( const tripoint_abs_omt &location );
+        // Returns the warming of nearby fires, hot terrain and fields at the given location
+        int get_temperature_mod( const tripoint &location );
         void clear_temp_cache();
         static void unserialize_all( JsonIn &jsin );
 };
@@ -105,7 +105,24 @@ static double weather_temperature_from_common_data( const weather_generator &wg,
 double weather_generator::get_weather_temperature( const tripoint &location, const time_point &t,
         unsigned seed ) const
 {
-    return weather_temperature_from_common_data( *this, get_common_data( location, t, seed ), t );
+    static constexpr size_t max_cached_temperatures = 4096;
+    const temperature_key key( location.x, location.y, to_turn<int>( t ), seed );
+    {
+        std::lock_guard<std::mutex> lock( temperature_cache.mutex );
+        const auto cached = temperature_cache.values.find( key );
+        if( cached != temperature_cache.values.end() ) {
+            return cached->second;
+        }
+    }
+    // Computed outside the lock; another thread doing the same work meanwhile finds the same.
+    const double temperature = weather_temperature_from_common_data( *this,
+                               get_common_data( location, t, seed ), t );
+    std::lock_guard<std::mutex> lock( temperature_cache.mutex );
+    if( temperature_cache.values.size() >= max_cached_temperatures ) {
+        temperature_cache.values.clear();
+    }
+    temperature_cache.values.emplace( key, temperature );
+    return temperature;
 }
 w_point weather_generator::get_weather( const tripoint &location, const time_point &t,
                                         unsigned seed ) const
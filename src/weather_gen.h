@@ -4,9 +4,13 @@
 
 #include <iosfwd>
 #include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "calendar.h"
+#include "hash_utils.h"
 #include "type_id.h"
 
 class JsonObject;
@@ -62,9 +66,32 @@ class weather_generator
         int get_water_temperature() const;
         void test_weather( unsigned seed ) const;
 
+        /**
+         * Same as the temperature of @ref get_weather, but remembered per position, turn and
+         * seed: items catching up on a long absence ask for the same hours again and again.
+         */
         double get_weather_temperature( const tripoint &, const time_point &, unsigned ) const;
 
         static weather_generator load( const JsonObject &jo );
+
+    private:
+        using temperature_key = std::tuple<int, int, int, unsigned>;
+        /**
+         * The temperatures remembered by @ref get_weather_temperature, which also runs on pool
+         * threads, hence the lock.  A copy of the generator starts with none.
+         */
+        struct temperature_memo {
+            std::mutex mutex;
+            // Bounded by clearing it whenever it grows past a few thousand entries.
+            std::unordered_map<temperature_key, double, cata::tuple_hash> values;
+
+            temperature_memo() = default;
+            temperature_memo( const temperature_memo & ) {}
+            temperature_memo &operator=( const temperature_memo & ) {
+                return *this;
+            }
+        };
+        mutable temperature_memo temperature_cache;
 };
 
 #endif // CATA_SRC_WEATHER_GEN_H
@@ -5,6 +5,7 @@
 #include "json.h"
 #include "rng.h"
 
+#include <algorithm>
 #include <climits>
 #include <cstdlib>
 #include <functional>
@@ -206,8 +207,75 @@ template <typename W, typename T> struct weighted_list {
         W total_weight;
         std::vector<weighted_object<W, T> > objects;
 
+        /** Lists shorter than this are scanned, building the alias table would cost more. */
+        static constexpr size_t alias_min_size = 16;
+
         virtual size_t pick_ent( unsigned int ) const = 0;
-        virtual void invalidate_precalc() {}
+        virtual void invalidate_precalc() {
+            alias_prob.clear();
+            alias_index.clear();
+        }
+
+        /**
+         * Picks with the alias method in constant time, building the table on the first pick
+         * after the list changed.  The high part of @p randi chooses a column, the rest
+         * chooses between the column's own entry and its alias.
+         */
+        size_t pick_alias( unsigned int randi ) const {
+            if( alias_prob.empty() ) {
+                build_alias_table();
+            }
+            const size_t n = objects.size();
+            const double u = static_cast<double>( randi ) / ( static_cast<double>( UINT_MAX ) + 1 ) *
+                             n;
+            const size_t col = std::min( static_cast<size_t>( u ), n - 1 );
+            return u - col < alias_prob[col] ? col : alias_index[col];
+        }
+
+    private:
+        // Vose's method: every column holds its own entry with some probability and one other
+        // entry that makes up the rest.
+        void build_alias_table() const {
+            const size_t n = objects.size();
+            alias_prob.assign( n, 0.0 );
+            alias_index.assign( n, 0 );
+            std::vector<double> scaled( n );
+            std::vector<size_t> small;
+            std::vector<size_t> large;
+            size_t heaviest = 0;
+            for( size_t i = 0; i < n; ++i ) {
+                scaled[i] = static_cast<double>( objects[i].weight ) * n / total_weight;
+                ( scaled[i] < 1.0 ? small : large ).push_back( i );
+                if( objects[i].weight > objects[heaviest].weight ) {
+                    heaviest = i;
+                }
+            }
+            while( !small.empty() && !large.empty() ) {
+                const size_t s = small.back();
+                small.pop_back();
+                const size_t l = large.back();
+                alias_prob[s] = scaled[s];
+                alias_index[s] = l;
+                scaled[l] -= 1.0 - scaled[s];
+                if( scaled[l] < 1.0 ) {
+                    large.pop_back();
+                    small.push_back( l );
+                }
+            }
+            // Whatever is left is only off from 1 by rounding, but never hand out an entry
+            // that weighs nothing.
+            for( const std::vector<size_t> *rest : {
+                     &small, &large
+                 } ) {
+                for( const size_t i : *rest ) {
+                    alias_prob[i] = objects[i].weight > 0 ? 1.0 : 0.0;
+                    alias_index[i] = heaviest;
+                }
+            }
+        }
+
+        mutable std::vector<double> alias_prob;
+        mutable std::vector<size_t> alias_index;
 };
 
 template <typename T> struct weighted_int_list : public weighted_list<int, T> {
@@ -234,6 +302,8 @@ template <typename T> struct weighted_int_list : public weighted_list<int, T> {
             if( !precalc_array.empty() ) {
                 // if the precalc_array is populated, use it for O(1) lookup
                 i = precalc_array[picked - 1];
+            } else if( this->objects.size() >= this->alias_min_size ) {
+                i = this->pick_alias( randi );
             } else {
                 // otherwise do O(N) search through items
                 int accumulated_weight = 0;
@@ -248,6 +318,7 @@ template <typename T> struct weighted_int_list : public weighted_list<int, T> {
         }
 
         void invalidate_precalc() override {
+            weighted_list<int, T>::invalidate_precalc();
             precalc_array.clear();
         }
 
@@ -258,11 +329,12 @@ static_assert( std::is_nothrow_move_constructible<weighted_int_list<int>>::value
 
 template <typename T> struct weighted_float_list : public weighted_list<double, T> {
 
-        // TODO: precalc using alias method
-
     protected:
 
         size_t pick_ent( unsigned int randi ) const override {
+            if( this->objects.size() >= this->alias_min_size ) {
+                return this->pick_alias( randi );
+            }
             const double picked = static_cast<double>( randi ) / UINT_MAX * this->total_weight;
             double accumulated_weight = 0;
             size_t i;
@@ -1,5 +1,10 @@
 #include "widget.h"
 
+#include <unordered_map>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "character_id.h"
 #include "character_martial_arts.h"
 #include "color.h"
 #include "generic_factory.h"
@@ -12,6 +17,16 @@
 namespace
 {
 generic_factory<widget> widget_factory( "widgets" );
+
+// The text each widget showed last, and when.
+struct shown_text {
+    time_point turn;
+    int moves = 0;
+    character_id avatar_id;
+    std::string text;
+};
+
+std::unordered_map<widget_id, shown_text> shown_texts;
 } // namespace
 
 template<>
@@ -34,6 +49,7 @@ void widget::load_widget( const JsonObject &jo, const std::string &src )
 void widget::reset()
 {
     widget_factory.reset();
+    shown_texts.clear();
 }
 
 // Convert widget "var" enums to string equivalents
@@ -303,8 +319,35 @@ int widget::get_var_value( const avatar &ava )
     return value;
 }
 
-std::string widget::show( avatar &ava )
+widget_refresh widget::refresh_of( const widget_var var )
 {
+    switch( var ) {
+        case widget_var::date_text:
+        case widget_var::moon_phase_text:
+            return widget_refresh::turn;
+        case widget_var::safe_mode_text:
+        case widget_var::style_text:
+            return widget_refresh::always;
+        default:
+            return widget_refresh::action;
+    }
+}
+
+std::string widget::show( avatar &ava, const bool cached )
+{
+    const widget_refresh refresh = refresh_of( _var );
+    if( cached && refresh != widget_refresh::always ) {
+        const auto it = shown_texts.find( id );
+        if( it != shown_texts.end() && it->second.turn == calendar::turn &&
+            it->second.avatar_id == ava.getID() &&
+            ( refresh == widget_refresh::turn || it->second.moves == ava.moves ) ) {
+            return it->second.text;
+        }
+        std::string text = show( ava );
+        shown_texts[id] = shown_text{ calendar::turn, ava.moves, ava.getID(), text };
+        return text;
+    }
+
     if( uses_text_function() ) {
         // Text functions are a carry-over from before widgets, with existing functions generating
         // descriptive colorized text for avatar attributes.  The "value" for these is immaterial;
@@ -554,7 +597,7 @@ std::string widget::graph( int value, int value_max )
     return ret;
 }
 
-std::string widget::layout( avatar &ava, const unsigned int max_width )
+std::string widget::layout( avatar &ava, const unsigned int max_width, const bool cached )
 {
     std::string ret;
     if( _style == "layout" ) {
@@ -571,14 +614,14 @@ std::string widget::layout( avatar &ava, const unsigned int max_width )
             }
             // Allow 2 spaces of padding after each column, except last column (full-justified)
             if( wid != _widgets.back() ) {
-                ret += string_format( "%s  ", cur_child.layout( ava, cur_width - 2 ) );
+                ret += string_format( "%s  ", cur_child.layout( ava, cur_width - 2, cached ) );
             } else {
-                ret += string_format( "%s", cur_child.layout( ava, cur_width ) );
+                ret += string_format( "%s", cur_child.layout( ava, cur_width, cached ) );
             }
         }
     } else {
         // Get displayed value (colorized)
-        std::string shown = show( ava );
+        std::string shown = show( ava, cached );
         const std::string tlabel = _label.translated();
         // Width used by label, ": " and value, using utf8_width to ignore color tags
         unsigned int used_width = utf8_width( tlabel, true ) + 2 + utf8_width( shown, true );
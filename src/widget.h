@@ -71,6 +71,14 @@ struct enum_traits<widget_var> {
     static constexpr widget_var last = widget_var::last;
 };
 
+// What the value of a widget_var may change with. The sidebar keeps the text shown by a
+// widget until then instead of working it out again every frame.
+enum class widget_refresh : int {
+    turn,   // Only as turns pass, like the date
+    action, // As turns pass or the avatar spends moves, like stats, needs or the weather
+    always  // Also without either, like modes toggled for free
+};
+
 // Use generic_factory for loading JSON data.
 class JsonObject;
 template<typename T>
@@ -128,9 +136,12 @@ class widget
         // Layout this widget within max_width, including child widgets. Calling layout on a regular
         // (non-layout style) widget is the same as show(), but will pad with spaces inside the
         // label area, so the returned string is equal to max_width.
-        std::string layout( avatar &ava, unsigned int max_width = 0 );
-        // Display labeled widget, with value (number, graph, or string) from an avatar
-        std::string show( avatar &ava );
+        std::string layout( avatar &ava, unsigned int max_width = 0, bool cached = false );
+        // Display labeled widget, with value (number, graph, or string) from an avatar.
+        // If cached, the text shown last time is reused while refresh_of( _var ) allows.
+        std::string show( avatar &ava, bool cached = false );
+        // What the value of var may change with
+        static widget_refresh refresh_of( widget_var var );
         // Return a colorized string for a _var associated with a description function
         std::string color_text_function_string( avatar &ava );
         // Return true if the current _var is one which uses a description function
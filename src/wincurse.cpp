@@ -463,13 +463,13 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
                 int FG = cell.FG;
                 int BG = cell.BG;
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, BG );
-                static const std::string space_string = " ";
                 // Spaces don't need any drawing except background
-                if( cell.ch == space_string ) {
+                if( cell.ch == " " ) {
                     continue;
                 }
 
-                tmp = UTF8_getch( cell.ch );
+                const std::string ch = cell.ch.str();
+                tmp = UTF8_getch( ch );
                 if( tmp != UNKNOWN_UNICODE ) {
 
                     int color = RGB( windowsPalette[FG].rgbRed, windowsPalette[FG].rgbGreen,
@@ -482,11 +482,11 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
                         i += cw - 1;
                     }
                     if( tmp ) {
-                        const std::wstring utf16 = widen( cell.ch );
+                        const std::wstring utf16 = widen( ch );
                         ExtTextOutW( backbuffer, drawx, drawy, 0, nullptr, utf16.c_str(), utf16.length(), nullptr );
                     }
                 } else {
-                    switch( static_cast<unsigned char>( win->line[j].chars[i].ch[0] ) ) {
+                    switch( static_cast<unsigned char>( ch[0] ) ) {
                         // box bottom/top side (horizontal line)
                         case LINE_OXOX_C:
                             HorzLineDIB( drawx, drawy + halfheight, drawx + fontwidth, 1, FG );
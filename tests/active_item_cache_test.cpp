@@ -1,5 +1,10 @@
+#include <iterator>
+#include <list>
+#include <map>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "cata_catch.h"
 #include "game_constants.h"
@@ -45,3 +50,42 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_item_cache_returns_each_item_once_per_cycle", "[item]" )
+{
+    active_item_cache cache;
+    std::list<item> items;
+    // Food is processed every 10 minutes, the firecracker every turn.
+    item &fast = *items.emplace( items.end(), "firecracker_act", calendar::turn_zero );
+    REQUIRE( fast.processing_speed() == 1 );
+    cache.add( fast, point_zero );
+    const int slow_speed = item( "apple" ).processing_speed();
+    REQUIRE( slow_speed > 1 );
+    for( int i = 0; i < 2 * slow_speed; ++i ) {
+        cache.add( *items.emplace( items.end(), "apple" ), point( i % SEEX, 0 ) );
+    }
+    // Adding an item twice changes nothing.
+    cache.add( items.back(), point_zero );
+    REQUIRE( cache.get().size() == items.size() );
+
+    item &removed = *std::next( items.begin() );
+    cache.remove( &removed );
+
+    std::map<const item *, int> times_returned;
+    for( int turn = 0; turn < slow_speed; ++turn ) {
+        const std::vector<item_reference> due = cache.get_for_processing();
+        CHECK( due.size() <= 3 );
+        for( const item_reference &ref : due ) {
+            ++times_returned[ref.item_ref.get()];
+        }
+    }
+    CHECK( times_returned[&fast] == slow_speed );
+    CHECK( times_returned.count( &removed ) == 0 );
+    int slow_returned_once = 0;
+    for( const item &it : items ) {
+        if( &it != &fast && &it != &removed && times_returned[&it] == 1 ) {
+            ++slow_returned_once;
+        }
+    }
+    CHECK( slow_returned_once == static_cast<int>( items.size() ) - 2 );
+}
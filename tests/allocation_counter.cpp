@@ -0,0 +1,105 @@
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+// Plain integers, so that using them needs no thread_local initialization, which could
+// itself allocate.
+thread_local size_t thread_allocations = 0;
+thread_local size_t thread_bytes = 0;
+
+} // namespace
+
+#if !defined(CATA_NO_ALLOCATION_COUNTING)
+
+static void *counted_allocation( size_t size )
+{
+    ++thread_allocations;
+    thread_bytes += size;
+    // malloc( 0 ) may return nullptr, which operator new must not.
+    return std::malloc( size == 0 ? 1 : size );
+}
+
+void *operator new( size_t size )
+{
+    void *p = counted_allocation( size );
+    if( !p ) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[]( size_t size )
+{
+    return operator new( size );
+}
+
+void *operator new( size_t size, const std::nothrow_t & ) noexcept
+{
+    return counted_allocation( size );
+}
+
+void *operator new[]( size_t size, const std::nothrow_t & ) noexcept
+{
+    return counted_allocation( size );
+}
+
+void operator delete( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, size_t ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p, size_t ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void *p, const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
+
+#endif
+
+bool allocation_counting_available()
+{
+#if defined(CATA_NO_ALLOCATION_COUNTING)
+    return false;
+#else
+    return true;
+#endif
+}
+
+allocation_counter::allocation_counter() :
+    start_allocations( thread_allocations ),
+    start_bytes( thread_bytes )
+{
+}
+
+size_t allocation_counter::allocations() const
+{
+    return thread_allocations - start_allocations;
+}
+
+size_t allocation_counter::bytes() const
+{
+    return thread_bytes - start_bytes;
+}
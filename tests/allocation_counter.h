@@ -0,0 +1,46 @@
+#pragma once
+#ifndef CATA_TESTS_ALLOCATION_COUNTER_H
+#define CATA_TESTS_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+// The test binary replaces the global operator new and delete to count the heap
+// allocations of every thread, so that tests can hold code to an allocation budget:
+//
+//     allocation_counter counter;
+//     it.has_flag( json_flag_FILTHY );
+//     CHECK( counter.allocations() == 0 );
+//
+// The sanitizers bring their own operator new, so the replacement is left out of the
+// builds using them and @ref allocation_counting_available is false there.
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define CATA_NO_ALLOCATION_COUNTING
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || \
+    __has_feature(memory_sanitizer)
+#define CATA_NO_ALLOCATION_COUNTING
+#endif
+#endif
+
+bool allocation_counting_available();
+
+/**
+ * Counts the allocations this thread makes from its construction on. Allocations of
+ * other threads, such as the workers of the thread pool, are not counted. Counters can
+ * be nested.
+ */
+class allocation_counter
+{
+    public:
+        allocation_counter();
+
+        size_t allocations() const;
+        size_t bytes() const;
+
+    private:
+        size_t start_allocations;
+        size_t start_bytes;
+};
+
+#endif // CATA_TESTS_ALLOCATION_COUNTER_H
@@ -0,0 +1,43 @@
+#include <memory>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "cata_catch.h"
+#include "item.h"
+#include "type_id.h"
+
+static const flag_id json_flag_FILTHY( "FILTHY" );
+
+static const itype_id itype_rock( "rock" );
+
+TEST_CASE( "allocation_counter_counts_this_thread", "[allocation_counter]" )
+{
+    if( !allocation_counting_available() ) {
+        WARN( "Allocations are not counted in sanitizer builds." );
+        return;
+    }
+
+    allocation_counter outer;
+    std::vector<int> numbers;
+    numbers.reserve( 100 );
+    CHECK( outer.allocations() == 1 );
+    CHECK( outer.bytes() >= 100 * sizeof( int ) );
+
+    allocation_counter inner;
+    std::unique_ptr<int> one = std::make_unique<int>( 1 );
+    CHECK( inner.allocations() == 1 );
+    CHECK( outer.allocations() == 2 );
+}
+
+TEST_CASE( "item_has_flag_does_not_allocate", "[allocation_counter][item]" )
+{
+    if( !allocation_counting_available() ) {
+        WARN( "Allocations are not counted in sanitizer builds." );
+        return;
+    }
+
+    const item rock( itype_rock );
+    allocation_counter counter;
+    CHECK_FALSE( rock.has_flag( json_flag_FILTHY ) );
+    CHECK( counter.allocations() == 0 );
+}
@@ -18,6 +18,7 @@
 #include "units.h"
 
 static const bionic_id bio_batteries( "bio_batteries" );
+static const bionic_id bio_flashlight( "bio_flashlight" );
 static const bionic_id bio_fuel_cell_gasoline( "bio_fuel_cell_gasoline" );
 static const bionic_id bio_power_storage( "bio_power_storage" );
 
@@ -84,6 +85,33 @@ TEST_CASE( "Bionic power capacity", "[bionics] [power]" )
     }
 }
 
+TEST_CASE( "powered_bionics_drain_power_every_turn", "[bionics] [power]" )
+{
+    avatar &dummy = get_avatar();
+    clear_avatar();
+    clear_bionics( dummy );
+    dummy.add_bionic( bio_power_storage );
+    dummy.add_bionic( bio_power_storage );
+    dummy.add_bionic( bio_flashlight );
+    dummy.set_power_level( dummy.get_max_power_level() );
+    const units::energy full = dummy.get_power_level();
+
+    bionic &light = dummy.my_bionics->back();
+    REQUIRE( light.id == bio_flashlight );
+    REQUIRE( light.info().charge_time == 1 );
+
+    dummy.process_bionics();
+    CHECK( dummy.get_power_level() == full );
+
+    light.powered = true;
+    light.charge_timer = 0;
+    dummy.process_bionics();
+    CHECK( dummy.get_power_level() == full - bio_flashlight->power_over_time );
+    dummy.process_bionics();
+    CHECK( dummy.get_power_level() == full - bio_flashlight->power_over_time * 2 );
+    CHECK( light.powered );
+}
+
 TEST_CASE( "bionics", "[bionics] [item]" )
 {
     avatar &dummy = get_avatar();
@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <iosfwd>
+#include <istream>
+#include <iterator>
 #include <map>
 #include <set>
 #include <string>
@@ -11,6 +13,9 @@
 #include "cata_utility.h"
 #include "cata_catch.h"
 #include "debug_menu.h"
+#include "filesystem.h"
+#include "path_info.h"
+#include "string_formatter.h"
 #include "units.h"
 #include "units_utility.h"
 
@@ -306,3 +311,52 @@ TEST_CASE( "check_debug_menu_string_methods", "[debug_menu]" )
         CHECK( pair.first == joined );
     }
 }
+
+TEST_CASE( "compressed_files_read_back_unchanged", "[utility]" )
+{
+    const std::string path = PATH_INFO::savedir() + "compressed_file_test.json";
+    std::string contents = "{ \"rows\": [";
+    for( int i = 0; i < 5000; ++i ) {
+        contents += string_format( "%s\"row %d\"", i == 0 ? "" : ", ", i % 37 );
+    }
+    contents += "] }";
+    const auto read_back = [&]() {
+        std::string read;
+        REQUIRE( read_from_file( path, [&]( std::istream & fin ) {
+            read.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+        } ) );
+        return read;
+    };
+
+    write_to_file( path, [&]( std::ostream & fout ) {
+        fout << contents;
+    }, true );
+    const std::string compressed = read_entire_file( path );
+    REQUIRE( compressed.size() >= 2 );
+    CHECK( compressed[0] == '\x1f' );
+    CHECK( compressed[1] == '\x8b' );
+    CHECK( compressed.size() < contents.size() / 4 );
+    CHECK( read_back() == contents );
+
+    write_to_file( path, [&]( std::ostream & fout ) {
+        fout << contents;
+    }, false );
+    CHECK( read_entire_file( path ) == contents );
+    CHECK( read_back() == contents );
+
+    remove_file( path );
+}
+
+TEST_CASE( "lcmatch_query_matches_like_lcmatch", "[utility]" )
+{
+    const lcmatch_query query( "RoCk" );
+    CHECK( query.matches( "small rock" ) );
+    CHECK( query.matches( "ROCKET" ) );
+    CHECK_FALSE( query.matches( "roc" ) );
+    CHECK_FALSE( query.matches( "" ) );
+    CHECK( lcmatch( "Rocks", "rOCK" ) );
+
+    const lcmatch_query empty( "" );
+    CHECK( empty.matches( "" ) );
+    CHECK( empty.matches( "anything" ) );
+}
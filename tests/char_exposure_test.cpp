@@ -1,6 +1,7 @@
 #include <list>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "cata_catch.h"
 #include "character.h"
@@ -115,3 +116,28 @@ TEST_CASE( "character body part exposure", "[char][bodypart][exposure]" )
     }
 }
 
+
+TEST_CASE( "clothing_map_follows_the_worn_items", "[char][bodypart][exposure]" )
+{
+    Character &dummy = get_player_character();
+    clear_avatar();
+    dummy.worn.clear();
+    CHECK( dummy.get_clothing_map().at( body_part_foot_l ).empty() );
+
+    dummy.wear_item( item( "legpouch" ), false );
+    REQUIRE( dummy.worn.size() == 1 );
+    const std::vector<const item *> pouch = { &dummy.worn.front() };
+    const bool left = dummy.worn.front().covers( body_part_foot_l );
+    const bodypart_id worn_on = left ? body_part_foot_l : body_part_foot_r;
+    const bodypart_id other = left ? body_part_foot_r : body_part_foot_l;
+    CHECK( dummy.get_clothing_map().at( worn_on ) == pouch );
+    CHECK( dummy.get_clothing_map().at( other ).empty() );
+
+    // The side is switched on the item, without the character being told.
+    dummy.worn.front().swap_side();
+    CHECK( dummy.get_clothing_map().at( worn_on ).empty() );
+    CHECK( dummy.get_clothing_map().at( other ) == pouch );
+
+    dummy.worn.clear();
+    CHECK( dummy.get_clothing_map().at( other ).empty() );
+}
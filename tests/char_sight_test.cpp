@@ -294,3 +294,24 @@ TEST_CASE( "ursine vision", "[character][ursine][vision]" )
     }
 }
 
+
+TEST_CASE( "sight_range_follows_perception_within_a_turn", "[character][sight][vision]" )
+{
+    Character &dummy = get_player_character();
+    clear_avatar();
+    clear_map();
+    g->reset_light_level();
+    calendar::turn = calendar::turn_zero;
+    get_map().build_map_cache( 0, false );
+    dummy.recalc_sight_limits();
+
+    dummy.set_per_bonus( 0 );
+    const int range = dummy.sight_range( LIGHT_AMBIENT_DIM );
+    CHECK( dummy.sight_range( LIGHT_AMBIENT_DIM ) == range );
+
+    dummy.set_per_bonus( 12 );
+    CHECK( dummy.sight_range( LIGHT_AMBIENT_DIM ) > range );
+
+    dummy.set_per_bonus( 0 );
+    CHECK( dummy.sight_range( LIGHT_AMBIENT_DIM ) == range );
+}
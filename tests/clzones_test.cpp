@@ -1,4 +1,5 @@
 #include <iosfwd>
+#include <unordered_set>
 #include <vector>
 
 #include "cata_catch.h"
@@ -7,6 +8,7 @@
 #include "item_category.h"
 #include "item_pocket.h"
 #include "map_helpers.h"
+#include "optional.h"
 #include "point.h"
 #include "ret_val.h"
 #include "type_id.h"
@@ -223,3 +225,34 @@ TEST_CASE( "zone sorting comestibles ", "[zones][items][food][activities]" )
         }
     }
 }
+
+TEST_CASE( "zone_queries_near_a_zone", "[zones]" )
+{
+    clear_map();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.add( "Food", zone_type_LOOT_FOOD, faction_your_followers, false, true,
+            tripoint( 10, 10, 0 ), tripoint( 14, 12, 0 ) );
+
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_FOOD, tripoint_zero, 9 ) );
+    CHECK( zm.has_near( zone_type_LOOT_FOOD, tripoint_zero, 10 ) );
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_FOOD, tripoint( 12, 11, 1 ), 10 ) );
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_DRINK, tripoint( 12, 11, 0 ), 10 ) );
+
+    const std::unordered_set<tripoint> near = zm.get_near( zone_type_LOOT_FOOD,
+            tripoint( 15, 13, 0 ), 2 );
+    CHECK( near.size() == 4 );
+    CHECK( near.count( tripoint( 13, 11, 0 ) ) == 1 );
+    CHECK( near.count( tripoint( 14, 12, 0 ) ) == 1 );
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, tripoint( 12, 11, 1 ), 2 ).empty() );
+
+    const cata::optional<tripoint> outside = zm.get_nearest( zone_type_LOOT_FOOD,
+            tripoint( 20, 11, 0 ), 10 );
+    REQUIRE( outside );
+    CHECK( *outside == tripoint( 14, 11, 0 ) );
+    const cata::optional<tripoint> inside = zm.get_nearest( zone_type_LOOT_FOOD,
+            tripoint( 12, 11, 0 ), 10 );
+    REQUIRE( inside );
+    CHECK( *inside == tripoint( 12, 11, 0 ) );
+    CHECK_FALSE( zm.get_nearest( zone_type_LOOT_FOOD, tripoint( 20, 11, 0 ), 5 ) );
+    clear_map();
+}
@@ -16,6 +16,10 @@ static_assert( tripoint::dimension == 3, "" );
 static_assert( point_abs_omt::dimension == 2, "" );
 static_assert( tripoint_abs_omt::dimension == 3, "" );
 
+static_assert( divide_round_to_minus_infinity<2>( -1 ) == -1, "" );
+static_assert( divide_round_to_minus_infinity<12>( -13 ) == -2, "" );
+static_assert( divide_round_to_minus_infinity<12>( 13 ) == 1, "" );
+
 TEST_CASE( "coordinate_strings", "[point][coords]" )
 {
     CHECK( point_abs_omt( point( 3, 4 ) ).to_string() == "(3,4)" );
@@ -189,6 +193,58 @@ TEST_CASE( "coordinate_hash", "[point][coords]" )
     }
 }
 
+template<int D>
+static void check_fixed_divisor()
+{
+    CAPTURE( D );
+    for( int n = -3 * D - 1; n <= 3 * D + 1; ++n ) {
+        CAPTURE( n );
+        CHECK( divide_round_to_minus_infinity<D>( n ) == divide_round_to_minus_infinity( n, D ) );
+    }
+}
+
+TEST_CASE( "fixed_divisors_round_like_the_others", "[point][coords]" )
+{
+    check_fixed_divisor<1>();
+    check_fixed_divisor<2>();
+    check_fixed_divisor<8>();
+    check_fixed_divisor<12>();
+    check_fixed_divisor<24>();
+    check_fixed_divisor<180>();
+
+    const tripoint p( -25, 37, -2 );
+    CHECK( divide_xy_round_to_minus_infinity<24>( p ) ==
+           divide_xy_round_to_minus_infinity( p, 24 ) );
+}
+
+TEST_CASE( "coordinate_projection_benchmark", "[.][point][coords][benchmark]" )
+{
+    BENCHMARK( "project ms to sm" ) {
+        int sum = 0;
+        for( int i = -1000; i <= 1000; ++i ) {
+            sum += project_to<coords::sm>( point_abs_ms( i, -i ) ).x();
+        }
+        return sum;
+    };
+    BENCHMARK( "project sm to omt" ) {
+        int sum = 0;
+        for( int i = -1000; i <= 1000; ++i ) {
+            sum += project_to<coords::omt>( point_abs_sm( i, -i ) ).x();
+        }
+        return sum;
+    };
+    BENCHMARK( "remain of omt in om" ) {
+        int sum = 0;
+        for( int i = -1000; i <= 1000; ++i ) {
+            point_abs_om om;
+            point_om_omt omt;
+            std::tie( om, omt ) = project_remain<coords::om>( point_abs_omt( i, -i ) );
+            sum += om.x() + omt.y();
+        }
+        return sum;
+    };
+}
+
 TEST_CASE( "coordinate_conversion_consistency", "[point][coords]" )
 {
     // Verifies that the new coord_point-based conversions yield the same
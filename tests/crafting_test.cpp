@@ -1070,3 +1070,26 @@ TEST_CASE( "partial_proficiency_mitigation", "[crafting][proficiency]" )
         }
     }
 }
+
+TEST_CASE( "crafting_inventory_keeps_each_radius_cached", "[crafting][inventory]" )
+{
+    clear_map();
+    clear_avatar();
+    avatar &you = get_avatar();
+    map &here = get_map();
+    here.add_item( you.pos() + point_east, item( itype_hammer ) );
+    you.invalidate_crafting_inventory();
+
+    const inventory &own = you.crafting_inventory( you.pos(), -1 );
+    const inventory &nearby = you.crafting_inventory();
+    CHECK_FALSE( own.has_tools( itype_hammer, 1 ) );
+    CHECK( nearby.has_tools( itype_hammer, 1 ) );
+
+    // Alternating between the two does not rebuild either of them.
+    CHECK( &you.crafting_inventory( you.pos(), -1 ) == &own );
+    CHECK( &you.crafting_inventory() == &nearby );
+
+    here.i_clear( you.pos() + point_east );
+    you.invalidate_crafting_inventory();
+    CHECK_FALSE( you.crafting_inventory().has_tools( itype_hammer, 1 ) );
+}
@@ -121,6 +121,21 @@ TEST_CASE( "body_part_sorting_main", "[bodypart]" )
     CHECK( observed == expected );
 }
 
+TEST_CASE( "body_parts_of_a_copy_are_its_own", "[bodypart]" )
+{
+    monster original( mon_zombie );
+    const bodypart_id torso( "torso" );
+    REQUIRE( original.has_part( torso ) );
+    // Looking a part up fills the index of the original before it is copied.
+    original.set_part_hp_cur( torso, 10 );
+
+    monster copy( original );
+    copy.set_part_hp_cur( torso, 5 );
+    CHECK( original.get_part_hp_cur( torso ) == 10 );
+    CHECK( copy.get_part_hp_cur( torso ) == 5 );
+    CHECK( copy.get_part( torso ) != original.get_part( torso ) );
+}
+
 TEST_CASE( "mtype_species_test", "[monster]" )
 {
     CHECK( mon_zombie->same_species( *mon_zombie ) );
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_catch.h"
+#include "creature.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "player_helpers.h"
+#include "point.h"
+
+static std::vector<Creature *> creatures_in_radius( const tripoint &center, int radius,
+        int radiusz )
+{
+    std::vector<Creature *> found;
+    get_creature_tracker().for_each_in_radius( get_map().getglobal( center ), radius, radiusz,
+    [&]( Creature & critter ) {
+        found.push_back( &critter );
+    } );
+    return found;
+}
+
+static bool contains( const std::vector<Creature *> &found, const Creature &critter )
+{
+    return std::find( found.begin(), found.end(), &critter ) != found.end();
+}
+
+TEST_CASE( "creature_tracker_radius_queries_follow_moves", "[monster][creature_tracker]" )
+{
+    clear_map();
+    clear_avatar();
+    avatar &you = get_avatar();
+    const tripoint center( 60, 60, 0 );
+    you.setpos( center );
+
+    // Either side of a submap boundary, so the buckets of several submaps are involved.
+    monster &near = spawn_test_monster( "mon_zombie", center + tripoint( 3, 0, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", center + tripoint( -9, 7, 0 ) );
+
+    std::vector<Creature *> found = creatures_in_radius( center, 5, 0 );
+    CHECK( found.size() == 2 );
+    CHECK( contains( found, you ) );
+    CHECK( contains( found, near ) );
+    CHECK_FALSE( contains( found, far ) );
+
+    found = creatures_in_radius( center, 9, 0 );
+    CHECK( found.size() == 3 );
+    CHECK( contains( found, far ) );
+
+    CHECK( get_creature_tracker().nearest_hostile( you, 12 ) == &near );
+    CHECK( get_creature_tracker().nearest_hostile( you, 2 ) == nullptr );
+
+    SECTION( "moved monsters are found at their new place" ) {
+        far.setpos( center + tripoint( 1, 1, 0 ) );
+        near.setpos( center + tripoint( 20, 0, 0 ) );
+        found = creatures_in_radius( center, 5, 0 );
+        CHECK( contains( found, far ) );
+        CHECK_FALSE( contains( found, near ) );
+        CHECK( get_creature_tracker().nearest_hostile( you, 12 ) == &far );
+    }
+
+    SECTION( "other z-levels are searched only when asked to" ) {
+        far.setpos( center + tripoint( 0, 2, 1 ) );
+        CHECK_FALSE( contains( creatures_in_radius( center, 5, 0 ), far ) );
+        CHECK( contains( creatures_in_radius( center, 5, 1 ), far ) );
+    }
+
+    SECTION( "removed monsters are gone" ) {
+        g->remove_zombie( near );
+        found = creatures_in_radius( center, 9, 0 );
+        CHECK( found.size() == 2 );
+        CHECK_FALSE( contains( found, near ) );
+        CHECK( get_creature_tracker().nearest_hostile( you, 12 ) == &far );
+    }
+
+    SECTION( "map::get_creatures_in_radius agrees" ) {
+        const std::list<Creature *> listed = get_map().get_creatures_in_radius( center, 5 );
+        CHECK( listed.size() == 2 );
+        CHECK( std::find( listed.begin(), listed.end(), &near ) != listed.end() );
+    }
+}
+
+TEST_CASE( "avatar_visible_creatures_follow_changes", "[monster][creature_tracker][vision]" )
+{
+    clear_map();
+    clear_avatar();
+    calendar::turn = calendar::turn_zero + 12_hours;
+    g->reset_light_level();
+    avatar &you = get_avatar();
+    map &here = get_map();
+    const tripoint center( 60, 60, 0 );
+    you.setpos( center );
+    monster &zed = spawn_test_monster( "mon_zombie", center + tripoint( 4, 0, 0 ) );
+    here.build_map_cache( 0 );
+
+    REQUIRE( contains( you.get_visible_creatures( 10 ), zed ) );
+    CHECK_FALSE( contains( you.get_visible_creatures( 3 ), zed ) );
+
+    SECTION( "a monster that moved is seen at its new distance" ) {
+        zed.setpos( center + tripoint( 20, 0, 0 ) );
+        CHECK_FALSE( contains( you.get_visible_creatures( 10 ), zed ) );
+        CHECK( contains( you.get_visible_creatures( 30 ), zed ) );
+    }
+
+    SECTION( "dead monsters are gone before and after cleanup" ) {
+        zed.die( nullptr );
+        CHECK_FALSE( contains( you.get_visible_creatures( 10 ), zed ) );
+        g->cleanup_dead();
+        CHECK( you.get_visible_creatures( 10 ).empty() );
+    }
+
+    SECTION( "new monsters show up" ) {
+        monster &other = spawn_test_monster( "mon_zombie", center + tripoint( 0, 5, 0 ) );
+        const std::vector<Creature *> seen = you.get_visible_creatures( 10 );
+        CHECK( seen.size() == 2 );
+        CHECK( contains( seen, other ) );
+    }
+}
+
+TEST_CASE( "creature_tracker_sweeps_only_the_dead", "[monster][creature_tracker]" )
+{
+    clear_map();
+    const tripoint center( 60, 60, 0 );
+    monster &first = spawn_test_monster( "mon_zombie", center );
+    monster &second = spawn_test_monster( "mon_zombie", center + tripoint( 2, 0, 0 ) );
+    monster &third = spawn_test_monster( "mon_zombie", center + tripoint( 4, 0, 0 ) );
+    creature_tracker &creatures = get_creature_tracker();
+    REQUIRE( creatures.size() == 3 );
+
+    // Nothing dead: nothing to do.
+    CHECK_FALSE( creatures.kill_marked_for_death() );
+
+    first.set_hp( 0 );
+    third.die( nullptr );
+    g->cleanup_dead();
+    CHECK( creatures.size() == 1 );
+    CHECK( creatures.creature_at<monster>( second.pos() ) == &second );
+    CHECK( creatures.creature_at<monster>( center ) == nullptr );
+    CHECK( creatures.temporary_id( second ) == 0 );
+}
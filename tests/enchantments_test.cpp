@@ -3,6 +3,7 @@
 #include "field.h"
 #include "item.h"
 #include "item_location.h"
+#include "magic_enchantment.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "monster.h"
@@ -88,3 +89,18 @@ TEST_CASE( "mutation enchantments", "[enchantments][mutations]" )
 
     test_generic_ench( p, str_before );
 }
+
+TEST_CASE( "enchantment values add up", "[enchantments]" )
+{
+    enchantment combined;
+    combined.add_value_add( enchant_vals::mod::STRENGTH, 2 );
+    enchantment other;
+    other.add_value_add( enchant_vals::mod::STRENGTH, 3 );
+    other.add_value_mult( enchant_vals::mod::SPEED, 0.5f );
+    combined.force_add( other );
+
+    CHECK( combined.get_value_add( enchant_vals::mod::STRENGTH ) == 5 );
+    CHECK( combined.get_value_add( enchant_vals::mod::DEXTERITY ) == 0 );
+    CHECK( combined.modify_value( enchant_vals::mod::SPEED, 10.0 ) == Approx( 15.0 ) );
+    CHECK( combined.modify_value( enchant_vals::mod::STRENGTH, 10.0 ) == Approx( 15.0 ) );
+}
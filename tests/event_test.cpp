@@ -93,3 +93,48 @@ TEST_CASE( "notify_subscriber_2", "[event]" )
     sub.notify( original_event );
     REQUIRE( sub.found );
 }
+
+struct kills_monster_subscriber : public test_subscriber {
+    bool handles( const event_type type ) const override {
+        return type == event_type::character_kills_monster;
+    }
+};
+
+TEST_CASE( "subscribers_get_only_the_event_types_they_handle", "[event]" )
+{
+    event_bus bus;
+    test_subscriber all;
+    kills_monster_subscriber kills_monster;
+    bus.subscribe( &all );
+    bus.subscribe( &kills_monster );
+
+    bus.send<event_type::character_kills_character>( character_id( 5 ), character_id( 6 ),
+            std::string( "victim" ) );
+    bus.send<event_type::character_kills_monster>( character_id( 5 ), zombie );
+    CHECK( all.events.size() == 2 );
+    REQUIRE( kills_monster.events.size() == 1 );
+    CHECK( kills_monster.events[0].type() == event_type::character_kills_monster );
+}
+
+TEST_CASE( "deferred_subscribers_get_the_events_in_order_when_processed", "[event]" )
+{
+    event_bus bus;
+    test_subscriber immediate;
+    test_subscriber deferred;
+    bus.subscribe( &immediate );
+    bus.subscribe( &deferred, event_dispatch::deferred );
+
+    bus.send<event_type::character_kills_monster>( character_id( 5 ), zombie );
+    bus.send<event_type::character_kills_character>( character_id( 5 ), character_id( 6 ),
+            std::string( "victim" ) );
+    CHECK( immediate.events.size() == 2 );
+    CHECK( deferred.events.empty() );
+
+    bus.process_deferred();
+    REQUIRE( deferred.events.size() == 2 );
+    CHECK( deferred.events[0].type() == event_type::character_kills_monster );
+    CHECK( deferred.events[1].type() == event_type::character_kills_character );
+
+    bus.process_deferred();
+    CHECK( deferred.events.size() == 2 );
+}
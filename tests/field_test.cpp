@@ -472,3 +472,83 @@ TEST_CASE( "field API test", "[field]" )
 
     fields_test_cleanup();
 }
+
+TEST_CASE( "field entries stay put while others come and go", "[field]" )
+{
+    field f;
+    REQUIRE( f.add_field( fd_fire, 2 ) );
+    field_entry *const fire = f.find_field( fd_fire );
+    REQUIRE( fire != nullptr );
+
+    // Processors hold on to the entry they work on while adding others to the same square.
+    CHECK( f.add_field( fd_smoke, 1 ) );
+    CHECK( f.add_field( fd_acid, 1 ) );
+    CHECK( f.remove_field( fd_smoke ) );
+    CHECK( f.find_field( fd_fire ) == fire );
+    CHECK( fire->get_field_intensity() == 2 );
+    CHECK( f.field_count() == 2 );
+
+    for( int i = 0; i < 100; ++i ) {
+        CHECK( f.add_field( fd_smoke, 1 ) );
+        CHECK( f.remove_field( fd_smoke ) );
+    }
+    CHECK( f.find_field( fd_fire ) == fire );
+    CHECK_FALSE( f.find_field( fd_smoke ) );
+
+    field copy = f;
+    CHECK( copy.field_count() == 2 );
+    CHECK( copy.find_field( fd_fire ) != fire );
+    CHECK( copy.find_field( fd_fire )->get_field_intensity() == 2 );
+}
+
+TEST_CASE( "idle fields age and decay the same while skipped", "[field]" )
+{
+    fields_test_setup();
+    const tripoint p{ 33, 33, 0 };
+    map &m = get_map();
+    // Sap has no processors, so its square is skipped between decays.
+    m.add_field( p, fd_sap, 3 );
+    REQUIRE( m.get_field( p, fd_sap ) );
+
+    SECTION( "age counts every turn until the field is gone" ) {
+        time_point last_change = calendar::turn;
+        int intensity = m.get_field_intensity( p, fd_sap );
+        int wrong_ages = 0;
+        while( m.get_field( p, fd_sap ) && fields_test_turns() < 10000 ) {
+            calendar::turn += 1_turns;
+            // Ahead of processing, the age is still the one of the previous turn.
+            const time_duration age_before = m.get_field( p, fd_sap )->get_field_age();
+            if( age_before != calendar::turn - 1_turns - last_change ) {
+                ++wrong_ages;
+            }
+            m.process_fields();
+            const field_entry *sap = m.get_field( p, fd_sap );
+            if( sap == nullptr ) {
+                break;
+            }
+            if( sap->get_field_intensity() != intensity ) {
+                intensity = sap->get_field_intensity();
+                last_change = calendar::turn;
+            }
+            if( sap->get_field_age() != calendar::turn - last_change ) {
+                ++wrong_ages;
+            }
+        }
+        CHECK( wrong_ages == 0 );
+        CHECK_FALSE( m.get_field( p, fd_sap ) );
+    }
+
+    SECTION( "changes through the map wake the square" ) {
+        for( int i = 0; i < 5; ++i ) {
+            calendar::turn += 1_turns;
+            m.process_fields();
+        }
+        REQUIRE( m.get_field( p, fd_sap ) );
+        m.set_field_intensity( p, fd_sap, 0 );
+        calendar::turn += 1_turns;
+        m.process_fields();
+        CHECK( m.field_at( p ).field_count() == 0 );
+    }
+
+    fields_test_cleanup();
+}
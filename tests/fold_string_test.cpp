@@ -105,4 +105,15 @@ TEST_CASE( "fold-string" )
         };
         check_equal( folded.begin(), folded.end(), expected.begin(), expected.end() );
     }
+
+    SECTION( "Case 6 - test folding the same text again" ) {
+        const std::string text = "Lorem ipsum dolor sit amet";
+        // Folded lines are cached, which must not mix up different widths or split characters.
+        const std::vector<std::string> first = foldstring( text, 12 );
+        CHECK( foldstring( text, 12 ) == first );
+        const std::vector<std::string> expected = { "Lorem ipsum ", "dolor sit ", "amet" };
+        CHECK( first == expected );
+        CHECK( foldstring( text, 30 ) == std::vector<std::string> { text } );
+        CHECK( foldstring( text, 12, 'o' ) != first );
+    }
 }
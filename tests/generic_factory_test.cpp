@@ -123,6 +123,38 @@ TEST_CASE( "generic_factory_repeated_invalidation", "[generic_factory]" )
     }
 }
 
+TEST_CASE( "generic_factory_finds_ids_built_from_strings", "[generic_factory]" )
+{
+    static constexpr int num_objs = 5000;
+    generic_factory<test_obj> test_factory( "test_factory" );
+    for( int i = 0; i < num_objs; ++i ) {
+        const std::string name = "many_" + std::to_string( i );
+        test_factory.insert( { test_obj_id( name ), std::to_string( i ) } );
+    }
+    if( GENERATE( false, true ) ) {
+        INFO( "Calling finalize" );
+        test_factory.finalize();
+    }
+
+    // Fresh ids have nothing cached, so each of these goes through the lookup table.
+    int wrong = 0;
+    for( int i = 0; i < num_objs; ++i ) {
+        const test_obj_id id( "many_" + std::to_string( i ) );
+        if( !test_factory.is_valid( id ) || test_factory.obj( id ).value != std::to_string( i ) ) {
+            ++wrong;
+        }
+        if( test_factory.is_valid( test_obj_id( "few_" + std::to_string( i ) ) ) ) {
+            ++wrong;
+        }
+    }
+    CHECK( wrong == 0 );
+
+    test_factory.reset();
+    CHECK_FALSE( test_factory.is_valid( test_obj_id( "many_0" ) ) );
+    test_factory.insert( { test_obj_id( "many_1" ), "again" } );
+    CHECK( test_factory.obj( test_obj_id( "many_1" ) ).value == "again" );
+}
+
 TEST_CASE( "generic_factory_common_null_ids", "[generic_factory]" )
 {
     CHECK( itype_id::NULL_ID().is_null() );
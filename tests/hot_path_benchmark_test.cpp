@@ -0,0 +1,305 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_catch.h"
+#include "game.h"
+#include "game_constants.h"
+#include "item.h"
+#include "item_location.h"
+#include "json.h"
+#include "magic_enchantment.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "scent_map.h"
+#include "submap.h"
+#include "type_id.h"
+#include "units.h"
+#include "vehicle.h"
+
+// Benchmarks of the code that runs every turn or for every tile on screen, so that a change
+// that slows one of them down can be told apart from noise. Run them with
+// cata_test "[hot_path]" --reporter xml to get results that can be compared between builds.
+
+static const field_type_str_id field_fd_blood( "fd_blood" );
+
+static const itype_id itype_backpack_hiking( "backpack_hiking" );
+static const itype_id itype_meat_cooked( "meat_cooked" );
+static const itype_id itype_rock( "rock" );
+static const itype_id itype_test_ring_strength_1( "test_ring_strength_1" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_wall( "t_wall" );
+
+static const trait_id trait_TEST_ENCH_MUTATION( "TEST_ENCH_MUTATION" );
+
+static const vproto_id vehicle_prototype_car( "car" );
+
+static const int z = 0;
+static const tripoint map_center( MAPSIZE_X / 2, MAPSIZE_Y / 2, z );
+
+// A floor with walls every few tiles, so that lines of sight, light and routes get cut short
+// some of the time, like in a town.
+static void build_walled_map()
+{
+    clear_map();
+    map &here = get_map();
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const bool wall = ( x % 12 == 0 && y % 5 != 0 ) || ( y % 17 == 0 && x % 7 == 0 );
+            here.ter_set( tripoint( x, y, z ), wall ? ter_t_wall : ter_t_floor );
+        }
+    }
+    here.build_map_cache( z );
+}
+
+TEST_CASE( "map_route_benchmark", "[.][benchmark][hot_path][pathfinding]" )
+{
+    build_walled_map();
+    map &here = get_map();
+    const pathfinding_settings settings( 0, 100, 1000, 0, false, false, true, false, false );
+    const tripoint from( 10, 10, z );
+    const tripoint to( MAPSIZE_X - 10, MAPSIZE_Y - 10, z );
+    REQUIRE( !here.route( from, to, settings ).empty() );
+
+    BENCHMARK( "across the map" ) {
+        return here.route( from, to, settings );
+    };
+    BENCHMARK( "a few tiles away" ) {
+        return here.route( map_center, map_center + tripoint( 8, 3, 0 ), settings );
+    };
+}
+
+TEST_CASE( "map_sees_benchmark", "[.][benchmark][hot_path][vision]" )
+{
+    build_walled_map();
+    map &here = get_map();
+    std::vector<tripoint> targets;
+    for( int x = map_center.x - 30; x <= map_center.x + 30; x += 3 ) {
+        for( int y = map_center.y - 30; y <= map_center.y + 30; y += 3 ) {
+            targets.emplace_back( x, y, z );
+        }
+    }
+
+    BENCHMARK( "tiles around the center" ) {
+        int seen = 0;
+        for( const tripoint &p : targets ) {
+            seen += here.sees( map_center, p, 60 );
+        }
+        return seen;
+    };
+}
+
+TEST_CASE( "map_cache_benchmark", "[.][benchmark][hot_path][cache]" )
+{
+    build_walled_map();
+    clear_avatar();
+    get_player_character().setpos( map_center );
+    player_add_headlamp();
+    calendar::turn = calendar::turn_zero + 1_days;
+    map &here = get_map();
+
+    // The lightmap is generated every time, so the time it takes is the difference between
+    // the first two.
+    BENCHMARK( "build_map_cache without changes, skipping the lightmap" ) {
+        here.build_map_cache( z, true );
+    };
+    BENCHMARK( "build_map_cache without changes, with the lightmap at night" ) {
+        here.build_map_cache( z );
+    };
+    BENCHMARK( "build_map_cache of a changed map" ) {
+        here.set_transparency_cache_dirty( z );
+        here.set_outside_cache_dirty( z );
+        here.build_map_cache( z );
+    };
+    clear_avatar();
+}
+
+TEST_CASE( "scent_map_update_benchmark", "[.][benchmark][hot_path][scent]" )
+{
+    build_walled_map();
+    map &here = get_map();
+    scent_map scent( *g );
+    scent.reset();
+    for( int x = map_center.x - 40; x <= map_center.x + 40; x += 2 ) {
+        for( int y = map_center.y - 40; y <= map_center.y + 40; y += 3 ) {
+            scent.set( tripoint( x, y, z ), 500 );
+        }
+    }
+
+    BENCHMARK( "update" ) {
+        scent.update( map_center, here );
+    };
+}
+
+TEST_CASE( "map_process_benchmark", "[.][benchmark][hot_path]" )
+{
+    clear_map();
+    map &here = get_map();
+    const time_point start = calendar::turn;
+
+    SECTION( "process_fields" ) {
+        // Blood just sits there for a long time, so the fields stay the same between runs.
+        for( int x = 0; x < MAPSIZE_X; x += 2 ) {
+            for( int y = 0; y < MAPSIZE_Y; y += 2 ) {
+                here.add_field( tripoint( x, y, z ), field_fd_blood, 3 );
+            }
+        }
+        BENCHMARK( "fields on a quarter of the tiles" ) {
+            calendar::turn += 1_turns;
+            here.process_fields();
+        };
+    }
+
+    SECTION( "process_items" ) {
+        const item meat( itype_meat_cooked, start );
+        for( int x = 0; x < MAPSIZE_X; x += 3 ) {
+            for( int y = 0; y < MAPSIZE_Y; y += 3 ) {
+                here.add_item( tripoint( x, y, z ), meat );
+            }
+        }
+        REQUIRE( !here.get_submaps_with_active_items().empty() );
+        BENCHMARK( "food on a ninth of the tiles" ) {
+            calendar::turn += 1_turns;
+            here.process_items();
+        };
+    }
+
+    calendar::turn = start;
+    clear_map();
+}
+
+TEST_CASE( "vehicle_refresh_benchmark", "[.][benchmark][hot_path][vehicle]" )
+{
+    clear_map();
+    vehicle *veh = get_map().add_vehicle( vehicle_prototype_car, map_center, 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+
+    BENCHMARK( "refresh of a car" ) {
+        veh->suspend_refresh();
+        veh->enable_refresh();
+        return veh->part_count();
+    };
+    clear_map();
+}
+
+TEST_CASE( "item_tname_benchmark", "[.][benchmark][hot_path][item]" )
+{
+    const item rock( itype_rock );
+    item backpack( itype_backpack_hiking );
+    for( int i = 0; i < 10; ++i ) {
+        backpack.put_in( item( itype_rock ), item_pocket::pocket_type::CONTAINER );
+    }
+
+    BENCHMARK( "simple item" ) {
+        return rock.tname();
+    };
+    BENCHMARK( "container with contents" ) {
+        return backpack.tname();
+    };
+}
+
+TEST_CASE( "json_parsing_benchmark", "[.][benchmark][hot_path][json]" )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_array();
+    const item meat( itype_meat_cooked, calendar::turn_zero );
+    for( int i = 0; i < 100; ++i ) {
+        meat.serialize( jsout );
+    }
+    jsout.end_array();
+    const std::string text = os.str();
+
+    BENCHMARK( "skipping 100 items" ) {
+        std::istringstream is( text );
+        JsonIn jsin( is );
+        jsin.skip_value();
+        return jsin.tell();
+    };
+    BENCHMARK( "reading 100 items" ) {
+        std::istringstream is( text );
+        JsonIn jsin( is );
+        std::vector<item> items( 100 );
+        jsin.start_array();
+        for( item &it : items ) {
+            it.deserialize( jsin.get_object() );
+        }
+        jsin.end_array();
+        return items;
+    };
+}
+
+TEST_CASE( "submap_load_save_benchmark", "[.][benchmark][hot_path][submap]" )
+{
+    submap sm;
+    const ter_id floor = ter_t_floor.id();
+    const ter_id wall = ter_t_wall.id();
+    for( int x = 0; x < SEEX; ++x ) {
+        for( int y = 0; y < SEEY; ++y ) {
+            sm.set_ter( point( x, y ), ( x + y ) % 5 == 0 ? wall : floor );
+        }
+    }
+    for( int x = 0; x < SEEX; x += 4 ) {
+        sm.get_items( point( x, x ) ).insert( item( itype_rock ) );
+    }
+    const auto store = [&sm]() {
+        std::ostringstream os;
+        JsonOut jsout( os );
+        jsout.start_object();
+        jsout.member( "version", savegame_version );
+        sm.store( jsout );
+        jsout.end_object();
+        return os.str();
+    };
+    const std::string text = store();
+
+    BENCHMARK( "store" ) {
+        return store();
+    };
+    BENCHMARK( "load" ) {
+        std::istringstream is( text );
+        JsonIn jsin( is );
+        submap loaded;
+        jsin.start_object();
+        int version = 0;
+        while( !jsin.end_object() ) {
+            const std::string name = jsin.get_member_name();
+            if( name == "version" ) {
+                version = jsin.get_int();
+            } else {
+                loaded.load( jsin, name, version );
+            }
+        }
+        return loaded.get_ter( point_zero );
+    };
+}
+
+TEST_CASE( "enchantment_cache_benchmark", "[.][benchmark][hot_path][enchantments]" )
+{
+    avatar &you = get_avatar();
+    clear_avatar();
+    for( int i = 0; i < 4; ++i ) {
+        item &ring = you.i_add( item( itype_test_ring_strength_1 ) );
+        you.wear( item_location( you, &ring ), false );
+    }
+    you.toggle_trait( trait_TEST_ENCH_MUTATION );
+
+    BENCHMARK( "recalculate" ) {
+        you.recalculate_enchantment_cache();
+        return you.get_str();
+    };
+    BENCHMARK( "modify 100 values" ) {
+        double value = 0.0;
+        for( int i = 0; i < 100; ++i ) {
+            value += you.calculate_by_enchantment( 10.0, enchant_vals::mod::SPEED );
+        }
+        return value;
+    };
+    clear_avatar();
+}
@@ -0,0 +1,51 @@
+#include <string>
+
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "input.h"
+#include "input_replay.h"
+#include "path_info.h"
+#include "point.h"
+
+TEST_CASE( "input_replay_plays_back_the_recorded_events", "[input_replay]" )
+{
+    const std::string path = PATH_INFO::savedir() + "input_replay_test.jsonl";
+
+    input_event key( { keymod_t::ctrl }, 'k', input_event_t::keyboard_code );
+    input_event click( MOUSE_BUTTON_LEFT, input_event_t::mouse );
+    click.mouse_pos = point( 12, 7 );
+    input_event text( 'e', input_event_t::keyboard_char );
+    text.text = "é";
+
+    REQUIRE( input_replay::start_recording( path, 1234 ) );
+    input_replay::record( key );
+    input_replay::record( click );
+    input_replay::record( text );
+    input_replay::stop_recording();
+    CHECK_FALSE( input_replay::is_recording() );
+
+    int seed = 0;
+    bool ended = false;
+    REQUIRE( input_replay::start_playback( path, seed, [&ended]() {
+        ended = true;
+    } ) );
+    CHECK( seed == 1234 );
+    CHECK( input_replay::is_playing() );
+
+    const input_event played_key = input_replay::next_event();
+    CHECK( played_key == key );
+    const input_event played_click = input_replay::next_event();
+    CHECK( played_click == click );
+    CHECK( played_click.mouse_pos == click.mouse_pos );
+    const input_event played_text = input_replay::next_event();
+    CHECK( played_text == text );
+    CHECK( played_text.text == text.text );
+
+    CHECK_FALSE( ended );
+    CHECK( input_replay::next_event().type == input_event_t::error );
+    CHECK( ended );
+    CHECK_FALSE( input_replay::is_playing() );
+
+    remove_file( path );
+}
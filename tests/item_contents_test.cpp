@@ -1,4 +1,5 @@
 #include <functional>
+#include <list>
 
 #include "cata_catch.h"
 #include "item.h"
@@ -75,6 +76,15 @@ TEST_CASE( "item_contents" )
     // overflow should only spill items if they can't fit
     CHECK( tool_belt.num_item_stacks() == 4 );
 
+    // walking the pockets in place sees the same items as the materialized list
+    std::list<const item *> walked;
+    for( const item_pocket *pocket : tool_belt.get_all_contained_pockets().value() ) {
+        for( const item *it : pocket->top_items() ) {
+            walked.push_back( it );
+        }
+    }
+    CHECK( walked == static_cast<const item &>( tool_belt ).all_items_top() );
+
     tool_belt.remove_items_with( []( const item & it ) {
         return it.typeId() == itype_crowbar;
     } );
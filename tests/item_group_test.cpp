@@ -12,9 +12,11 @@
 #include "item_group.h"
 #include "options.h"
 #include "options_helpers.h"
+#include "rng.h"
 #include "type_id.h"
 
 static const itype_id itype_match( "match" );
+static const itype_id itype_test_rock( "test_rock" );
 
 TEST_CASE( "truncate_spawn_when_items_dont_fit", "[item_group]" )
 {
@@ -261,3 +263,51 @@ TEST_CASE( "Event-based item spawns do not spawn outside event", "[item_group]"
         CHECK( items[0].typeId() == test_rock );
     }
 }
+
+TEST_CASE( "distribution_picks_follow_their_weights", "[item_group]" )
+{
+    Item_group group( Item_group::G_DISTRIBUTION, 100, 0, 0, "test distribution" );
+    group.add_item_entry( itype_match, 25 );
+    group.add_item_entry( itype_test_rock, 75 );
+    const Item_spawn_data &spawn = group;
+    int matches = 0;
+    const int rolls = 4000;
+    for( int i = 0; i < rolls; ++i ) {
+        const item it = spawn.create_single( calendar::turn_zero );
+        REQUIRE( !it.is_null() );
+        if( it.typeId() == itype_match ) {
+            ++matches;
+        }
+    }
+    CHECK( matches == Approx( rolls / 4 ).margin( rolls / 20 ) );
+
+    SECTION( "removed entries are never picked" ) {
+        group.remove_item( itype_match );
+        for( int i = 0; i < 100; ++i ) {
+            CHECK( spawn.create_single( calendar::turn_zero ).typeId() == itype_test_rock );
+        }
+    }
+}
+
+TEST_CASE( "spawning_a_group_several_times_at_once", "[item_group]" )
+{
+    const item_group_id group_id( "test_event_item_spawn" );
+    const auto type_ids = []( const item_group::ItemList & items ) {
+        std::vector<itype_id> ids;
+        for( const item &it : items ) {
+            ids.push_back( it.typeId() );
+        }
+        return ids;
+    };
+
+    rng_set_engine_seed( 1234 );
+    std::vector<itype_id> one_at_a_time;
+    for( int i = 0; i < 5; ++i ) {
+        const std::vector<itype_id> ids = type_ids( item_group::items_from( group_id,
+                                          calendar::turn_zero ) );
+        one_at_a_time.insert( one_at_a_time.end(), ids.begin(), ids.end() );
+    }
+    rng_set_engine_seed( 1234 );
+    CHECK( type_ids( item_group::items_from( group_id, calendar::turn_zero, 5 ) ) ==
+           one_at_a_time );
+}
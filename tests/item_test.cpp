@@ -5,6 +5,7 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <vector>
 
 #include "avatar.h"
@@ -15,6 +16,7 @@
 #include "item_factory.h"
 #include "item_pocket.h"
 #include "itype.h"
+#include "json.h"
 #include "math_defines.h"
 #include "monstergenerator.h"
 #include "mtype.h"
@@ -315,6 +317,74 @@ TEST_CASE( "item variables round-trip accurately", "[item]" )
     CHECK( i.get_var( "C", tripoint() ) == tripoint( 2, 3, 4 ) );
 }
 
+TEST_CASE( "item variables keep their order and survive saving", "[item]" )
+{
+    item i( "water" );
+    i.set_var( "zulu", 3 );
+    i.set_var( "alpha", "first" );
+    i.set_var( "mike", tripoint( 1, 2, 3 ) );
+    i.set_var( "alpha", "again" );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.write( i );
+    CHECK( os.str().find( R"("item_vars":{"alpha":"again","mike":"1,2,3","zulu":"3"})" ) !=
+           std::string::npos );
+
+    std::istringstream is( os.str() );
+    JsonIn jsin( is );
+    item read;
+    jsin.read( read );
+    CHECK( read.get_var( "zulu", 0 ) == 3 );
+    CHECK( read.get_var( "alpha" ) == "again" );
+    CHECK( read.get_var( "mike", tripoint() ) == tripoint( 1, 2, 3 ) );
+    CHECK( read.stacks_with( i ) );
+
+    read.erase_var( "mike" );
+    CHECK_FALSE( read.has_var( "mike" ) );
+    CHECK_FALSE( read.has_var( "never set on any item" ) );
+    CHECK_FALSE( read.stacks_with( i ) );
+}
+
+TEST_CASE( "item flags agree with the flag sets they mirror", "[item][flag]" )
+{
+    SECTION( "item types" ) {
+        int mismatches = 0;
+        for( const itype *type : item_controller->all() ) {
+            for( const json_flag &f : json_flag::get_all() ) {
+                if( type->has_flag( f.id ) != ( type->get_flags().count( f.id ) > 0 ) ) {
+                    ++mismatches;
+                }
+            }
+        }
+        CHECK( mismatches == 0 );
+    }
+
+    SECTION( "item instances" ) {
+        item i( "water" );
+        CHECK_FALSE( i.has_own_flag( json_flag_FILTHY ) );
+        i.set_flag( json_flag_FILTHY ).set_flag( json_flag_HOT );
+        CHECK( i.has_own_flag( json_flag_FILTHY ) );
+        CHECK( i.has_flag( json_flag_HOT ) );
+        i.unset_flag( json_flag_HOT );
+        CHECK_FALSE( i.has_flag( json_flag_HOT ) );
+
+        std::ostringstream os;
+        JsonOut jsout( os );
+        jsout.write( i );
+        std::istringstream is( os.str() );
+        JsonIn jsin( is );
+        item read;
+        jsin.read( read );
+        CHECK( read.has_own_flag( json_flag_FILTHY ) );
+        CHECK_FALSE( read.has_own_flag( json_flag_HOT ) );
+        CHECK_FALSE( read.has_own_flag( json_flag_COLD ) );
+
+        read.unset_flags();
+        CHECK_FALSE( read.has_flag( json_flag_FILTHY ) );
+    }
+}
+
 TEST_CASE( "water affect items while swimming check", "[item][water][swimming]" )
 {
     avatar &guy = get_avatar();
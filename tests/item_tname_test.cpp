@@ -496,3 +496,28 @@ TEST_CASE( "nested_items_tname", "[item][tname]" )
         }
     }
 }
+
+TEST_CASE( "tname_name_cache_scope", "[item][tname]" )
+{
+    item rock( itype_rock );
+    item purse( itype_purse );
+    const std::string rock_name = rock.tname();
+    const std::string rocks_name = rock.tname( 2 );
+    const std::string purse_name = purse.tname( 1, false );
+
+    {
+        item::scoped_name_cache names;
+        CHECK( rock.tname() == rock_name );
+        CHECK( rock.tname( 2 ) == rocks_name );
+        CHECK( purse.tname( 1, false ) == purse_name );
+        {
+            item::scoped_name_cache inner;
+            CHECK( rock.tname() == rock_name );
+        }
+        // Names are remembered for the whole outer scope, even across changes.
+        purse.put_in( rock, item_pocket::pocket_type::CONTAINER );
+        CHECK( purse.tname( 1, false ) == purse_name );
+    }
+    // Once the scope ends, names are built afresh.
+    CHECK( purse.tname( 1, false ) != purse_name );
+}
@@ -2,6 +2,7 @@
 #include <array>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <map>
 #include <set>
@@ -831,6 +832,49 @@ TEST_CASE( "jsonin_get_string", "[json]" )
         R"("foo\nbar")", 5 );
 }
 
+TEST_CASE( "jsonin_reads_numbers_and_skips_members", "[json]" )
+{
+    std::istringstream iss(
+        R"({ "skip": "a\"b…\u2026", "also_skip": [ 1.5e3, -0, { "x": null } ],)"
+        R"( "str": "plain ascii, then …", "nums": [ 1, -2.5e3, 0.25, 3E+2, 10 ] })" );
+    JsonIn jsin( iss );
+    JsonObject jo = jsin.get_object();
+    jo.allow_omitted_members();
+    CHECK( jo.get_string( "str" ) == "plain ascii, then …" );
+    JsonArray nums = jo.get_array( "nums" );
+    CHECK( nums.next_int() == 1 );
+    CHECK( nums.next_float() == Approx( -2500.0 ) );
+    CHECK( nums.next_float() == Approx( 0.25 ) );
+    CHECK( nums.next_int() == 300 );
+    CHECK( nums.next_int() == 10 );
+    CHECK_FALSE( nums.has_more() );
+
+    std::istringstream duplicate( R"({ "a": 1, "a": 2 })" );
+    JsonIn jsin_duplicate( duplicate );
+    CHECK_THROWS_AS( jsin_duplicate.get_object(), JsonError );
+}
+
+TEST_CASE( "jsonout_writes_numbers_and_escapes_strings", "[json]" )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_array();
+    jsout.write( 0 );
+    jsout.write( -17 );
+    jsout.write( std::numeric_limits<int>::min() );
+    jsout.write( std::numeric_limits<long long>::min() );
+    jsout.write( std::numeric_limits<unsigned long long>::max() );
+    jsout.write( static_cast<short>( -3 ) );
+    jsout.write( true );
+    jsout.write( false );
+    jsout.write( 0.5 );
+    jsout.write( "plain" );
+    jsout.write( std::string( "q\"b\\s/\n\x01…" ) );
+    jsout.end_array();
+    CHECK( os.str() == "[0,-17,-2147483648,-9223372036854775808,18446744073709551615,-3,"
+           "true,false,0.500000,\"plain\",\"q\\\"b\\\\s/\\n\\u0001…\"]" );
+}
+
 TEST_CASE( "item_colony_ser_deser", "[json][item]" )
 {
     // calculates the number of substring (needle) occurrences withing the target string (haystack)
@@ -887,6 +931,10 @@ TEST_CASE( "item_colony_ser_deser", "[json][item]" )
             INFO( "should be identical to the original " );
             CHECK( is_same( col, read_val ) );
         }
+        {
+            INFO( "should be read into a single group" );
+            CHECK( read_val.capacity() == 10 );
+        }
     }
 
     SECTION( "different items are saved individually" ) {
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "lru_cache.h"
+#include "point.h"
+
+TEST_CASE( "lru_cache_forgets_least_recent", "[lru_cache]" )
+{
+    lru_cache<point, char> cache;
+    cache.insert( 3, point( 1, 0 ), 'a' );
+    cache.insert( 3, point( 2, 0 ), 'b' );
+    cache.insert( 3, point( 3, 0 ), 'c' );
+    // Inserting again makes an entry the most recent one.
+    cache.insert( 3, point( 1, 0 ), 'A' );
+    cache.insert( 3, point( 4, 0 ), 'd' );
+
+    CHECK( cache.size() == 3 );
+    CHECK( cache.get( point( 1, 0 ), '-' ) == 'A' );
+    CHECK( cache.get( point( 2, 0 ), '-' ) == '-' );
+    CHECK( cache.get( point( 4, 0 ), '-' ) == 'd' );
+    const std::vector<std::pair<point, char>> expected{
+        { point( 3, 0 ), 'c' }, { point( 1, 0 ), 'A' }, { point( 4, 0 ), 'd' }
+    };
+    CHECK( cache.list() == expected );
+
+    cache.remove( point( 1, 0 ) );
+    cache.remove( point( 9, 9 ) );
+    CHECK( cache.size() == 2 );
+    CHECK( cache.get( point( 1, 0 ), '-' ) == '-' );
+
+    cache.clear();
+    CHECK( cache.size() == 0 );
+    CHECK( cache.get( point( 3, 0 ), '-' ) == '-' );
+}
+
+TEST_CASE( "lru_cache_matches_list_model", "[lru_cache]" )
+{
+    // The std::list and search the cache used to be built on.
+    std::list<std::pair<tripoint, int>> model;
+    lru_cache<tripoint, int> cache;
+    const auto model_find = [&]( const tripoint & p ) {
+        return std::find_if( model.begin(), model.end(), [&]( const std::pair<tripoint, int> &e ) {
+            return e.first == p;
+        } );
+    };
+
+    const int limit = 50;
+    unsigned int state = 12345;
+    for( int step = 0; step < 20000; ++step ) {
+        state = state * 1103515245 + 12345;
+        // Few enough distinct keys that the cache keeps hitting, evicting and colliding.
+        const tripoint p( ( state >> 8 ) % 13 - 6, ( state >> 12 ) % 11 - 5, ( state >> 16 ) % 2 );
+        const auto found = model_find( p );
+        if( ( state >> 20 ) % 8 == 0 ) {
+            cache.remove( p );
+            if( found != model.end() ) {
+                model.erase( found );
+            }
+        } else {
+            cache.insert( limit, p, step );
+            if( found != model.end() ) {
+                model.erase( found );
+            }
+            model.emplace_back( p, step );
+            if( model.size() > static_cast<size_t>( limit ) ) {
+                model.pop_front();
+            }
+        }
+        const auto kept = model_find( p );
+        REQUIRE( cache.get( p, -1 ) == ( kept == model.end() ? -1 : kept->second ) );
+    }
+    CHECK( cache.size() == model.size() );
+    CHECK( cache.list() == std::vector<std::pair<tripoint, int>>( model.begin(), model.end() ) );
+}
+
+TEST_CASE( "lru_cache_benchmark", "[.][lru_cache][benchmark]" )
+{
+    lru_cache<tripoint, int> cache;
+    int i = 0;
+    BENCHMARK( "insert into a full cache" ) {
+        for( int j = -60; j <= 60; ++j ) {
+            cache.insert( 10000, tripoint( i, j, 0 ), j );
+        }
+        ++i;
+        return cache.size();
+    };
+    BENCHMARK( "get" ) {
+        int sum = 0;
+        for( int j = -60; j <= 60; ++j ) {
+            sum += cache.get( tripoint( i - 1, j, 0 ), 0 );
+        }
+        return sum;
+    };
+}
@@ -73,7 +73,81 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.memorize_symbol( p3, 1 );
 }
 
-// TODO: map memory save / load
+TEST_CASE( "map_memory_packs_tiles", "[map_memory]" )
+{
+    mm_submap sm;
+    const memorized_terrain_tile wall{ "t_wall", 3, 2 };
+    const memorized_terrain_tile door{ "vp_door", 6, 270 };
+    sm.set_tile( point_zero, wall );
+    sm.set_tile( point( 5, 7 ), door );
+    sm.set_tile( point( 6, 7 ), memorized_terrain_tile{ "vp_door", 0, -90 } );
+    CHECK( sm.tile( point_zero ) == wall );
+    CHECK( sm.tile( point( 5, 7 ) ) == door );
+    CHECK( sm.tile( point( 6, 7 ) ).rotation == 270 );
+    CHECK( sm.tile( point( 1, 0 ) ) == mm_submap::default_tile );
+    CHECK( mm_submap::tile_id( sm.packed( point( 5, 7 ) ) ) ==
+           mm_submap::tile_id( sm.packed( point( 6, 7 ) ) ) );
+
+    mm_submap untouched;
+    untouched.set_tile( point( 2, 2 ), mm_submap::default_tile );
+    CHECK( untouched.is_empty() );
+}
+
+static std::string serialized( const mm_region &reg )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    reg.serialize( jsout );
+    return os.str();
+}
+
+TEST_CASE( "map_memory_region_round_trip", "[map_memory]" )
+{
+    const memorized_terrain_tile wall{ "t_wall", 1, 3 };
+    mm_region reg;
+    for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+        for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+            reg.submaps[x][y] = make_shared_fast<mm_submap>();
+        }
+    }
+    reg.submaps[0][0]->set_tile( point( 3, 4 ), wall );
+    reg.submaps[0][0]->set_symbol( point( 3, 4 ), '#' );
+    reg.submaps[1][2]->set_tile( point( 0, 0 ), memorized_terrain_tile{ "f_chair", 0, 0 } );
+    reg.submaps[1][2]->set_tile( point( 1, 0 ), memorized_terrain_tile{ "t_wall", 0, 0 } );
+    reg.submaps[1][2]->set_symbol( point( SEEX - 1, SEEY - 1 ), 'x' );
+
+    const std::string saved = serialized( reg );
+    // Each name is written once, before the submaps.
+    CHECK( saved.find( "t_wall" ) == saved.rfind( "t_wall" ) );
+
+    std::istringstream is( saved );
+    JsonIn jsin( is );
+    mm_region loaded;
+    loaded.deserialize( jsin );
+    CHECK( serialized( loaded ) == saved );
+    CHECK( loaded.submaps[0][0]->tile( point( 3, 4 ) ) == wall );
+    CHECK( loaded.submaps[0][0]->symbol( point( 3, 4 ) ) == '#' );
+    CHECK( loaded.submaps[1][2]->tile( point( 0, 0 ) ).tile == "f_chair" );
+    CHECK( loaded.submaps[1][2]->symbol( point( SEEX - 1, SEEY - 1 ) ) == 'x' );
+    CHECK( loaded.submaps[2][2]->is_empty() );
+
+    SECTION( "regions saved with tile names in every submap still load" ) {
+        std::string old_format = "[";
+        for( size_t i = 0; i < MM_REG_SIZE * MM_REG_SIZE; i++ ) {
+            old_format += i == 0 ? "[[\"t_wall\",1,3,35],[\"\",0,0,0," +
+                          std::to_string( SEEX * SEEY - 1 ) + "]]" : ",null";
+        }
+        old_format += "]";
+        std::istringstream old_is( old_format );
+        JsonIn old_jsin( old_is );
+        mm_region old_reg;
+        old_reg.deserialize( old_jsin );
+        CHECK( old_reg.submaps[0][0]->tile( point_zero ) == wall );
+        CHECK( old_reg.submaps[0][0]->symbol( point_zero ) == '#' );
+        CHECK( old_reg.submaps[0][0]->tile( point_east ) == mm_submap::default_tile );
+        CHECK( old_reg.submaps[1][0]->is_empty() );
+    }
+}
 
 #include <chrono>
 
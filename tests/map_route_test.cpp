@@ -0,0 +1,261 @@
+#include "cata_catch.h"
+#include "map.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "line.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "type_id.h"
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_wall( "t_wall" );
+
+TEST_CASE( "route_is_unaffected_by_earlier_searches", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // A wall across the straight line, so the route has to walk around it.
+    for( int y = 30; y <= 50; ++y ) {
+        here.ter_set( tripoint( 40, y, 0 ), ter_t_wall );
+    }
+    here.build_map_cache( 0, true );
+
+    const pathfinding_settings settings( 0, 100, 400, 0, false, false, true, false, false );
+    const tripoint from( 30, 40, 0 );
+    const tripoint to( 50, 40, 0 );
+    const std::vector<tripoint> first = here.route( from, to, settings );
+    REQUIRE( !first.empty() );
+    CHECK( first.back() == to );
+    for( const tripoint &p : first ) {
+        CHECK( p.x != 40 );
+    }
+
+    // Searches in between leave their marks in the reused search state.
+    const std::set<tripoint> closed = { tripoint( 35, 29, 0 ) };
+    CHECK( !here.route( to, from, settings ).empty() );
+    CHECK( !here.route( from, tripoint( 35, 10, 0 ), settings, closed ).empty() );
+    CHECK( here.route( from, to, settings ) == first );
+}
+
+static void check_route_is_walkable( const map &here, const tripoint &from,
+                                     const std::vector<tripoint> &route )
+{
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        CAPTURE( prev, p );
+        REQUIRE( square_dist( prev, p ) == 1 );
+        REQUIRE( here.passable( p ) );
+        prev = p;
+    }
+}
+
+TEST_CASE( "long_routes_follow_changes_to_the_map", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // A long wall across the whole map, but for one gap.
+    const tripoint gap( 60, 100, 0 );
+    for( int y = 0; y < MAPSIZE_Y; ++y ) {
+        if( y != gap.y ) {
+            here.ter_set( tripoint( gap.x, y, 0 ), ter_t_wall );
+        }
+    }
+    here.build_map_cache( 0, true );
+
+    const pathfinding_settings settings( 0, 200, 1000, 0, false, false, true, false, false );
+    const tripoint from( 10, 60, 0 );
+    const tripoint to( 110, 60, 0 );
+    std::vector<tripoint> route = here.route( from, to, settings );
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    check_route_is_walkable( here, from, route );
+    CHECK( std::find( route.begin(), route.end(), gap ) != route.end() );
+
+    // Moving the gap only touches two submaps.
+    const tripoint new_gap( 60, 20, 0 );
+    here.ter_set( gap, ter_t_wall );
+    here.ter_set( new_gap, ter_t_floor );
+    route = here.route( from, to, settings );
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    check_route_is_walkable( here, from, route );
+    CHECK( std::find( route.begin(), route.end(), new_gap ) != route.end() );
+
+    here.ter_set( new_gap, ter_t_wall );
+    CHECK( here.route( from, to, settings ).empty() );
+}
+
+TEST_CASE( "shared_routes_match_the_map", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    for( int y = 30; y <= 50; ++y ) {
+        here.ter_set( tripoint( 40, y, 0 ), ter_t_wall );
+    }
+    here.build_map_cache( 0, true );
+
+    const pathfinding_settings settings( 0, 40, 400, 0, false, false, true, false, false );
+    const tripoint to( 50, 40, 0 );
+    // The first request for a goal is an ordinary route, the ones after it follow the field.
+    for( const tripoint &from : {
+             tripoint( 30, 40, 0 ), tripoint( 30, 35, 0 ), tripoint( 28, 44, 0 ), tripoint( 30, 40, 0 )
+         } ) {
+        CAPTURE( from );
+        const std::vector<tripoint> route = here.route_shared( from, to, settings );
+        REQUIRE( !route.empty() );
+        CHECK( route.back() == to );
+        check_route_is_walkable( here, from, route );
+    }
+
+    // A change to the level floods the field again.
+    here.ter_set( tripoint( 40, 29, 0 ), ter_t_wall );
+    here.ter_set( tripoint( 40, 51, 0 ), ter_t_wall );
+    const std::vector<tripoint> route = here.route_shared( tripoint( 30, 40, 0 ), to, settings );
+    REQUIRE( !route.empty() );
+    check_route_is_walkable( here, tripoint( 30, 40, 0 ), route );
+}
+
+TEST_CASE( "batched_routes_are_handed_out_by_route_shared", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    for( int y = 30; y <= 50; ++y ) {
+        here.ter_set( tripoint( 40, y, 0 ), ter_t_wall );
+    }
+    here.build_map_cache( 0, true );
+
+    const pathfinding_settings settings( 0, 40, 400, 0, false, false, true, false, false );
+    std::vector<route_request> requests;
+    for( const tripoint &from : {
+             tripoint( 30, 40, 0 ), tripoint( 30, 35, 0 ), tripoint( 28, 44, 0 ), tripoint( 60, 40, 0 )
+         } ) {
+        route_request request;
+        request.from = from;
+        request.to = from.x < 40 ? tripoint( 50, 40, 0 ) : tripoint( 35, 45, 0 );
+        request.settings = settings;
+        requests.push_back( request );
+    }
+    here.route_batch( requests );
+
+    for( const route_request &request : requests ) {
+        CAPTURE( request.from );
+        REQUIRE( !request.route.empty() );
+        CHECK( request.route.back() == request.to );
+        check_route_is_walkable( here, request.from, request.route );
+        CHECK( here.route_shared( request.from, request.to, settings ) == request.route );
+    }
+
+    // Routes solved before a change to the level are not handed out after it.
+    here.route_batch( requests );
+    here.ter_set( tripoint( 40, 29, 0 ), ter_t_wall );
+    here.ter_set( tripoint( 40, 51, 0 ), ter_t_wall );
+    const std::vector<tripoint> route = here.route_shared( requests[0].from, requests[0].to,
+                                        settings );
+    REQUIRE( !route.empty() );
+    check_route_is_walkable( here, requests[0].from, route );
+}
+
+static int route_cost( const tripoint &from, const std::vector<tripoint> &route )
+{
+    int cost = 0;
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        cost += 2 + ( p.x != prev.x && p.y != prev.y ? 1 : 0 );
+        prev = p;
+    }
+    return cost;
+}
+
+TEST_CASE( "jumps_over_open_ground_keep_routes_optimal", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    for( int y = 30; y <= 50; ++y ) {
+        here.ter_set( tripoint( 40, y, 0 ), ter_t_wall );
+    }
+    here.ter_set( tripoint( 45, 36, 0 ), ter_t_wall );
+    here.build_map_cache( 0, true );
+
+    const pathfinding_settings settings( 0, 40, 400, 0, false, false, true, false, false );
+    // Any pre-closed tile turns jumping off, even one outside the search.
+    const std::set<tripoint> plain_search = {{ tripoint( 1, 1, 0 ) }};
+    const tripoint to( 50, 40, 0 );
+    for( const tripoint &from : {
+             tripoint( 30, 35, 0 ), tripoint( 33, 44, 0 ), tripoint( 38, 40, 0 ), tripoint( 30, 28, 0 )
+         } ) {
+        CAPTURE( from );
+        const std::vector<tripoint> jumped = here.route( from, to, settings );
+        const std::vector<tripoint> plain = here.route( from, to, settings, plain_search );
+        REQUIRE( !jumped.empty() );
+        CHECK( jumped.back() == to );
+        check_route_is_walkable( here, from, jumped );
+        CHECK( route_cost( from, jumped ) == route_cost( from, plain ) );
+    }
+}
+
+TEST_CASE( "repaired_routes_follow_the_goal_and_the_map", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    for( int y = 30; y <= 50; ++y ) {
+        here.ter_set( tripoint( 40, y, 0 ), ter_t_wall );
+    }
+    here.build_map_cache( 0, true );
+
+    const pathfinding_settings settings( 0, 40, 400, 0, false, false, true, false, false );
+    const tripoint from( 30, 40, 0 );
+    const tripoint to( 50, 40, 0 );
+    const std::vector<tripoint> route = here.route( from, to, settings );
+    REQUIRE( !route.empty() );
+
+    SECTION( "the goal moved a little" ) {
+        const tripoint moved = to + point( 2, 1 );
+        const std::vector<tripoint> repaired = here.repair_route( from, route, moved, settings );
+        REQUIRE( !repaired.empty() );
+        CHECK( repaired.back() == moved );
+        check_route_is_walkable( here, from, repaired );
+    }
+    SECTION( "the goal came closer along the route" ) {
+        const tripoint closer = route[route.size() / 2];
+        const std::vector<tripoint> repaired = here.repair_route( from, route, closer, settings );
+        CHECK( repaired == std::vector<tripoint>( route.begin(), route.begin() + route.size() / 2 + 1 ) );
+    }
+    SECTION( "a step got blocked" ) {
+        const tripoint blocked = route[route.size() / 3];
+        here.ter_set( blocked, ter_t_wall );
+        const std::vector<tripoint> repaired = here.repair_route( from, route, to, settings );
+        REQUIRE( !repaired.empty() );
+        CHECK( repaired.back() == to );
+        CHECK( std::find( repaired.begin(), repaired.end(), blocked ) == repaired.end() );
+        check_route_is_walkable( here, from, repaired );
+    }
+    SECTION( "the goal moved far away" ) {
+        CHECK( here.repair_route( from, route, to + point( 10, 0 ), settings ).empty() );
+    }
+}
+
+TEST_CASE( "pathfinding_cache_tile_updates_match_full_rebuild", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.get_pathfinding_cache_ref( 0 );
+
+    for( int i = 0; i < 20; ++i ) {
+        here.ter_set( tripoint( 10 + i * 5, 20 + i * 3, 0 ), i % 2 == 0 ? ter_t_wall : ter_t_floor );
+    }
+    const pathfinding_cache &cache = here.get_pathfinding_cache_ref( 0 );
+    CHECK( ( cache.special[10][20] & PF_WALL ) );
+    CHECK( !( cache.special[15][23] & PF_WALL ) );
+    const std::vector<pf_special> incremental( &cache.special[0][0],
+            &cache.special[0][0] + MAPSIZE_X * MAPSIZE_Y );
+
+    here.set_pathfinding_cache_dirty( 0 );
+    here.get_pathfinding_cache_ref( 0 );
+    const std::vector<pf_special> rebuilt( &cache.special[0][0],
+                                           &cache.special[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    CHECK( incremental == rebuilt );
+}
@@ -1,18 +1,37 @@
 #include "cata_catch.h"
 #include "map.h"
 
+#include <algorithm>
+#include <list>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "avatar.h"
+#include "calendar.h"
 #include "coordinates.h"
 #include "enums.h"
 #include "game.h"
 #include "game_constants.h"
+#include "item.h"
+#include "level_cache.h"
 #include "map_helpers.h"
+#include "mapbuffer.h"
 #include "point.h"
 #include "type_id.h"
 
+static const field_type_str_id field_fd_smoke( "fd_smoke" );
+
+static const furn_str_id furn_f_bookcase( "f_bookcase" );
+static const furn_str_id furn_f_chair( "f_chair" );
+
+static const itype_id itype_rock( "rock" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_open_air( "t_open_air" );
+static const ter_str_id ter_t_wall( "t_wall" );
+static const ter_str_id ter_t_window( "t_window" );
+
 TEST_CASE( "destroy_grabbed_furniture" )
 {
     clear_map();
@@ -93,3 +112,332 @@ TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
     g->place_player( tripoint_zero );
     CHECK( get_map().check_submap_active_item_consistency().empty() );
 }
+
+TEST_CASE( "transparency_cache_row_kernel_matches_reference" )
+{
+    clear_map();
+    map &here = get_map();
+    const int z = 0;
+    // Scatter opaque and transparent terrain, furniture and fields so that every
+    // submap is non-uniform and both builders have to take their per-row path.
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const tripoint p( x, y, z );
+            const int k = x * 7 + y * 3;
+            if( k % 11 == 0 ) {
+                here.ter_set( p, ter_t_wall );
+            } else if( k % 13 == 0 ) {
+                here.ter_set( p, ter_t_window );
+            } else if( k % 17 == 0 ) {
+                here.furn_set( p, furn_f_bookcase );
+            } else if( k % 19 == 0 ) {
+                here.furn_set( p, furn_f_chair );
+            }
+            if( k % 5 == 0 ) {
+                here.add_field( p, field_fd_smoke, 1 + k % 3 );
+            }
+        }
+    }
+
+    here.set_transparency_cache_dirty( z );
+    here.build_map_cache( z );
+    const level_cache &cache = here.get_cache_ref( z );
+    std::vector<float> kernel_transparency( &cache.transparency_cache[0][0],
+                                            &cache.transparency_cache[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    const auto kernel_wo_fields = cache.transparent_cache_wo_fields;
+
+    here.set_transparency_row_kernel( false );
+    here.set_transparency_cache_dirty( z );
+    here.build_map_cache( z );
+    here.set_transparency_row_kernel( true );
+
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( kernel_transparency[x * MAPSIZE_Y + y] != cache.transparency_cache[x][y] ||
+                kernel_wo_fields[x][y] != cache.transparent_cache_wo_fields[x][y] ) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "shifted_transparency_cache_matches_full_rebuild", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const int z = 0;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const tripoint p( x, y, z );
+            const int k = x * 5 + y * 3;
+            if( k % 11 == 0 ) {
+                here.ter_set( p, ter_t_wall );
+            } else if( k % 23 == 0 ) {
+                here.add_field( p, field_fd_smoke, 1 );
+            }
+        }
+    }
+    here.build_map_cache( z );
+
+    const point shift = GENERATE( point_east, point_north_west, point_south );
+    CAPTURE( shift );
+    here.shift( shift );
+    here.build_map_cache( z );
+    const level_cache &cache = here.get_cache_ref( z );
+    std::vector<float> shifted( &cache.transparency_cache[0][0],
+                                &cache.transparency_cache[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    const auto shifted_wo_fields = cache.transparent_cache_wo_fields;
+
+    here.set_transparency_cache_dirty( z );
+    here.build_map_cache( z );
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( shifted[x * MAPSIZE_Y + y] != cache.transparency_cache[x][y] ||
+                shifted_wo_fields[x][y] != cache.transparent_cache_wo_fields[x][y] ) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+    here.shift( -shift );
+    here.build_map_cache( z );
+}
+
+static std::vector<float> light_levels( const map &here, const int zmin, const int zmax )
+{
+    std::vector<float> result;
+    for( int z = zmin; z <= zmax; ++z ) {
+        const level_cache &cache = here.get_cache_ref( z );
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                result.insert( result.end(), cache.lm[x][y].values.begin(), cache.lm[x][y].values.end() );
+            }
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "sunlight_cache_incremental_matches_full_rebuild", "[shadowcasting]" )
+{
+    clear_map();
+    map &here = get_map();
+    calendar::turn = calendar::turn_zero + 12_hours;
+    // Roof over part of the map, then open holes in it one at a time.
+    for( int x = 30; x < 70; ++x ) {
+        for( int y = 30; y < 70; ++y ) {
+            here.ter_set( tripoint( x, y, 1 ), ter_t_floor );
+        }
+    }
+    here.build_map_cache( 0 );
+    const float under_roof = here.get_cache_ref( 0 ).lm[40][40].max();
+
+    for( const tripoint &hole : {
+             tripoint( 40, 40, 1 ), tripoint( 47, 59, 1 ), tripoint( 69, 30, 1 )
+         } ) {
+        CAPTURE( hole );
+        here.ter_set( hole, ter_t_open_air );
+        here.build_map_cache( 0 );
+        const std::vector<float> incremental = light_levels( here, -2, 1 );
+
+        here.invalidate_sunlight_cache();
+        here.build_map_cache( 0 );
+        CHECK( incremental == light_levels( here, -2, 1 ) );
+    }
+    CHECK( here.get_cache_ref( 0 ).lm[40][40].max() > under_roof );
+}
+
+// Scatters walls and windows over the z-level 0, except on @p from.
+static void scatter_sight_blockers( map &here, const tripoint &from )
+{
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const int k = x * 7 + y * 3;
+            if( k % 11 == 0 && tripoint( x, y, 0 ) != from ) {
+                here.ter_set( tripoint( x, y, 0 ), k % 2 == 0 ? ter_t_wall : ter_t_window );
+            }
+        }
+    }
+    here.build_map_cache( 0 );
+}
+
+TEST_CASE( "sees_many_matches_sees", "[map][vision]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint from( 60, 60, 0 );
+    scatter_sight_blockers( here, from );
+
+    std::vector<tripoint> targets;
+    for( int x = 0; x < MAPSIZE_X; x += 3 ) {
+        for( int y = 0; y < MAPSIZE_Y; y += 5 ) {
+            targets.emplace_back( x, y, 0 );
+        }
+    }
+    std::vector<bool> expected;
+    for( const tripoint &t : targets ) {
+        expected.push_back( here.sees( from, t, 40 ) );
+    }
+
+    // Touch the terrain so the rebuild drops the lines remembered by sees().
+    here.ter_set( tripoint_zero, ter_t_floor );
+    here.build_map_cache( 0 );
+    CHECK( here.sees_many( from, targets, 40 ) == expected );
+    CHECK( std::count( expected.begin(), expected.end(), true ) > 0 );
+    CHECK( std::count( expected.begin(), expected.end(), false ) > 0 );
+}
+
+TEST_CASE( "prefetched_sight_lines_match_sees", "[map][vision]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint from( 60, 60, 0 );
+    scatter_sight_blockers( here, from );
+
+    std::vector<std::pair<tripoint, tripoint>> pairs;
+    for( int x = 0; x < MAPSIZE_X; x += 3 ) {
+        for( int y = 0; y < MAPSIZE_Y; y += 5 ) {
+            // Both ways round, and from a second viewer, so that some pairs share a line.
+            pairs.emplace_back( from, tripoint( x, y, 0 ) );
+            pairs.emplace_back( tripoint( x, y, 0 ), from );
+            pairs.emplace_back( tripoint( 30, 90, 0 ), tripoint( x, y, 0 ) );
+        }
+    }
+    std::vector<bool> expected;
+    for( const std::pair<tripoint, tripoint> &pair : pairs ) {
+        expected.push_back( here.sees( pair.first, pair.second, -1 ) );
+    }
+
+    // Drop the lines remembered above, so that the checks below read the prefetched ones.
+    here.ter_set( tripoint_zero, ter_t_floor );
+    here.build_map_cache( 0 );
+    here.prefetch_sees( pairs );
+    std::vector<bool> prefetched;
+    for( const std::pair<tripoint, tripoint> &pair : pairs ) {
+        prefetched.push_back( here.sees( pair.first, pair.second, -1 ) );
+    }
+    CHECK( prefetched == expected );
+    CHECK( std::count( expected.begin(), expected.end(), false ) > 0 );
+}
+
+TEST_CASE( "floor_cache_point_updates_match_full_rebuild", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0, true );
+    const level_cache &ground = here.get_cache_ref( 0 );
+    REQUIRE( ground.no_floor_gaps );
+
+    const tripoint hole( 40, 50, 0 );
+    here.ter_set( hole, ter_t_open_air );
+    CHECK( !ground.floor_cache[hole.x][hole.y] );
+    CHECK( ground.floor_gap_count == 1 );
+    CHECK( !ground.no_floor_gaps );
+
+    const tripoint roof( 41, 50, 1 );
+    here.ter_set( roof, ter_t_floor );
+    const level_cache &sky = here.get_cache_ref( 1 );
+    CHECK( sky.floor_cache[roof.x][roof.y] );
+    CHECK( sky.floor_gap_count == MAPSIZE_X * MAPSIZE_Y - 1 );
+
+    std::vector<bool> incremental;
+    for( int z = 0; z <= 1; ++z ) {
+        const level_cache &cache = here.get_cache_ref( z );
+        incremental.insert( incremental.end(), &cache.floor_cache[0][0],
+                            &cache.floor_cache[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    }
+    here.invalidate_map_cache( 0 );
+    here.invalidate_map_cache( 1 );
+    here.build_map_cache( 0, true );
+    std::vector<bool> rebuilt;
+    for( int z = 0; z <= 1; ++z ) {
+        const level_cache &cache = here.get_cache_ref( z );
+        rebuilt.insert( rebuilt.end(), &cache.floor_cache[0][0],
+                        &cache.floor_cache[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    }
+    CHECK( incremental == rebuilt );
+    CHECK( ground.floor_gap_count == 1 );
+    CHECK( sky.floor_gap_count == MAPSIZE_X * MAPSIZE_Y - 1 );
+
+    here.ter_set( hole, ter_t_floor );
+    CHECK( ground.no_floor_gaps );
+    // Leave the level above as clear_map found it.
+    here.ter_set( roof, ter_t_open_air );
+}
+
+TEST_CASE( "map_generates_the_quads_ahead_of_a_shift", "[map][mapgen]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint abs = here.get_abs_sub();
+    // The quads ahead reach one submap past the new column, and cover every z-level.
+    std::vector<tripoint> ahead;
+    for( int gridx = MAPSIZE; gridx <= MAPSIZE + 1; ++gridx ) {
+        for( int gridy = -1; gridy <= MAPSIZE; ++gridy ) {
+            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+                ahead.emplace_back( abs.xy() + point( gridx, gridy ), z );
+            }
+        }
+    }
+    std::vector<tripoint> generated;
+    for( const tripoint &p : ahead ) {
+        if( MAPBUFFER.lookup_submap( p ) == nullptr ) {
+            generated.push_back( p );
+        }
+    }
+
+    here.prefetch_ahead( point_east );
+    // Far more calls than there are quads queued; each call does at most one mapgen.
+    for( int i = 0; i < 1000; ++i ) {
+        here.generate_ahead();
+    }
+    for( int gridy = 0; gridy < MAPSIZE; ++gridy ) {
+        CAPTURE( gridy );
+        CHECK( MAPBUFFER.lookup_submap( abs + tripoint( MAPSIZE, gridy, 0 ) ) != nullptr );
+    }
+
+    // Leave the buffer as it was for the tests after this one.
+    for( const tripoint &p : generated ) {
+        MAPBUFFER.drop_submap( p );
+    }
+}
+
+TEST_CASE( "clear_path_is_the_same_when_asked_again", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.build_map_cache( 0 );
+    const tripoint source( 60, 60, 0 );
+    const tripoint destination( 67, 63, 0 );
+
+    const std::vector<tripoint> path = here.find_clear_path( source, destination );
+    REQUIRE( !path.empty() );
+    CHECK( path.back() == destination );
+    CHECK( here.find_clear_path( source, destination ) == path );
+    // The way back is a path of its own, not the cached one.
+    const std::vector<tripoint> back = here.find_clear_path( destination, source );
+    REQUIRE( !back.empty() );
+    CHECK( back.back() == source );
+}
+
+TEST_CASE( "use_amount_takes_the_nearest_items_first", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint origin( 60, 60, 0 );
+    here.add_item( origin + point( 3, 3 ), item( itype_rock ) );
+    here.add_item( origin + point( 1, 0 ), item( itype_rock ) );
+    here.add_item( origin + point( -2, 1 ), item( itype_rock ) );
+
+    int quantity = 2;
+    const std::list<item> used = here.use_amount( origin, 3, itype_rock, quantity );
+    CHECK( quantity == 0 );
+    CHECK( used.size() == 2 );
+    CHECK( here.i_at( origin + point( 1, 0 ) ).empty() );
+    CHECK( here.i_at( origin + point( -2, 1 ) ).empty() );
+    CHECK( here.i_at( origin + point( 3, 3 ) ).size() == 1 );
+    clear_map();
+}
@@ -236,6 +236,15 @@ TEST_CASE( "player::get_dodge", "[player][melee][dodge]" )
         dummy.set_speed_base( 25 );
         CHECK( dummy.get_dodge() == Approx( 0.25 * base_dodge ) );
     }
+
+    SECTION( "no dodges left: cannot dodge" ) {
+        dummy.dodges_left = 0;
+        CHECK( dummy.get_dodge() == 0.0f );
+        dummy.add_effect( effect_grabbed, 1_minutes );
+        CHECK( dummy.get_dodge() == 0.0f );
+        dummy.dodges_left = 1;
+        CHECK( dummy.get_dodge() > 0.0f );
+    }
 }
 
 TEST_CASE( "player::get_dodge with effects", "[player][melee][dodge][effect]" )
@@ -42,6 +42,8 @@ void check_memorial( memorial_logger &m, event_bus &b, const std::string &ref, A
     CAPTURE( ref );
     m.clear();
     b.send( cata::event::make<Type>( args... ) );
+    // The game's memorial only gets the events at the end of the turn.
+    b.process_deferred();
 
     std::string result = m.dump();
     CAPTURE( result );
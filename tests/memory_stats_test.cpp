@@ -0,0 +1,28 @@
+#include "cata_catch.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "memory_stats.h"
+#include "point.h"
+#include "type_id.h"
+
+static const itype_id itype_backpack( "backpack" );
+static const itype_id itype_rock( "rock" );
+
+TEST_CASE( "memory_stats_count_items_with_their_contents", "[memory_stats]" )
+{
+    clear_map();
+    const memory_usage before = memory_stats::measure( memory_part::items );
+
+    map &here = get_map();
+    item backpack( itype_backpack );
+    REQUIRE( backpack.put_in( item( itype_rock ), item_pocket::pocket_type::CONTAINER ).success() );
+    here.add_item( tripoint( 60, 60, 0 ), backpack );
+    here.add_item( tripoint( 61, 60, 0 ), item( itype_rock ) );
+
+    const memory_usage after = memory_stats::measure( memory_part::items );
+    CHECK( after.count == before.count + 3 );
+    CHECK( after.bytes >= before.bytes + 3 * sizeof( item ) );
+    CHECK( memory_stats::measure( memory_part::submaps ).count > 0 );
+    clear_map();
+}
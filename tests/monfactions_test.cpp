@@ -145,3 +145,16 @@ TEST_CASE( "monfactions_attitude", "[monster][monfactions]" )
         CHECK( attitude( "small_animal", "zombie" ) == MFA_NEUTRAL );
     }
 }
+
+TEST_CASE( "monfactions_attitude_table_matches_factions", "[monster][monfactions]" )
+{
+    int mismatches = 0;
+    for( const monfaction &from : monfactions::get_all() ) {
+        for( const monfaction &to : monfactions::get_all() ) {
+            if( monfactions::attitude( from.id, to.id ) != from.attitude( to.id ) ) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
@@ -8,8 +8,9 @@
 #include <utility>
 #include <vector>
 
-#include "cata_utility.h"
+#include "bodypart.h"
 #include "cata_catch.h"
+#include "cata_utility.h"
 #include "character.h"
 #include "filesystem.h"
 #include "game.h"
@@ -400,3 +401,36 @@ TEST_CASE( "limit_mod_size_bonus", "[monster]" )
     test_monster2.mod_size_bonus( 3 );
     CHECK( test_monster2.get_size() == creature_size::huge );
 }
+
+TEST_CASE( "idle_monsters_sit_out_turns_until_disturbed", "[monster]" )
+{
+    clear_map();
+    get_player_character().setpos( tripoint( 5, 5, 0 ) );
+    monster &zombie = spawn_test_monster( "mon_zombie", tripoint( 65, 65, 0 ) );
+    zombie.unset_dest();
+    // Nothing in sight, so it plans without a target.
+    zombie.plan();
+    REQUIRE( zombie.is_idle() );
+
+    // Acts one turn in four.
+    CHECK( zombie.skip_idle_turn( 4 ) );
+    CHECK( zombie.skip_idle_turn( 4 ) );
+    CHECK( zombie.skip_idle_turn( 4 ) );
+    CHECK_FALSE( zombie.skip_idle_turn( 4 ) );
+    CHECK( zombie.skip_idle_turn( 4 ) );
+    CHECK_FALSE( zombie.skip_idle_turn( 1 ) );
+
+    SECTION( "a sound wakes it up" ) {
+        zombie.hear_sound( tripoint( 60, 65, 0 ), 20, 5, false );
+        CHECK_FALSE( zombie.is_idle() );
+        CHECK_FALSE( zombie.skip_idle_turn( 4 ) );
+    }
+
+    SECTION( "getting hurt wakes it up" ) {
+        zombie.apply_damage( nullptr, bodypart_id( "torso" ), 1 );
+        CHECK_FALSE( zombie.is_idle() );
+        CHECK_FALSE( zombie.skip_idle_turn( 4 ) );
+        // Back to sitting out turns once it has acted.
+        CHECK( zombie.skip_idle_turn( 4 ) );
+    }
+}
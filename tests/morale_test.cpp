@@ -104,6 +104,29 @@ TEST_CASE( "player_morale_decay", "[player_morale]" )
     }
 }
 
+TEST_CASE( "player_morale_level_follows_consecutive_decays", "[player_morale]" )
+{
+    player_morale m;
+    m.add( MORALE_FOOD_GOOD, 20, 40, 20_turns, 10_turns );
+    m.add( MORALE_FOOD_BAD, -10, -20, 20_turns, 10_turns );
+    REQUIRE( m.get_level() == 10 );
+
+    m.decay( 10_turns );
+    CHECK( m.get_level() == 10 );
+    CHECK( m.get_total_positive_value() == 20 );
+    CHECK( m.get_total_negative_value() == 10 );
+
+    m.decay( 5_turns );
+    CHECK( m.get_level() == 5 );
+    CHECK( m.get_total_positive_value() == 10 );
+    CHECK( m.get_total_negative_value() == 5 );
+
+    m.decay( 5_turns );
+    CHECK( m.get_level() == 0 );
+    CHECK( m.get_total_positive_value() == 0 );
+    CHECK( m.get_total_negative_value() == 0 );
+}
+
 TEST_CASE( "player_morale_persistent", "[player_morale]" )
 {
     player_morale m;
@@ -433,3 +433,21 @@ TEST_CASE( "The various type of triggers work", "[mutations]" )
     }
 
 }
+
+TEST_CASE( "has_trait_follows_set_and_unset_mutation", "[mutations]" )
+{
+    npc dummy;
+    dummy.clear_mutations();
+    REQUIRE_FALSE( dummy.has_trait( trait_SMELLY ) );
+
+    dummy.set_mutation( trait_SMELLY );
+    CHECK( dummy.has_trait( trait_SMELLY ) );
+    CHECK_FALSE( dummy.has_trait( trait_UGLY ) );
+
+    dummy.unset_mutation( trait_SMELLY );
+    CHECK_FALSE( dummy.has_trait( trait_SMELLY ) );
+
+    dummy.set_mutation( trait_UGLY );
+    dummy.clear_mutations();
+    CHECK_FALSE( dummy.has_trait( trait_UGLY ) );
+}
@@ -308,6 +308,35 @@ TEST_CASE( "NPC faces zombies", "[npc_attack]" )
     }
 }
 
+TEST_CASE( "NPC weapon choice follows inventory and rule changes", "[npc_attack]" )
+{
+    clear_map_and_put_player_underground();
+    clear_vehicles();
+    scoped_weather_override sunny_weather( weather_sunny );
+    npc &main_npc = npc_attack_setup::respawn_main_npc();
+    main_npc.set_fac( faction_your_followers );
+    main_npc.rules.set_flag( ally_rule::use_guns );
+    main_npc.rules.clear_flag( ally_rule::use_silent );
+    monster *zombie = npc_attack_setup::spawn_zombie_at_range( 4 );
+
+    const auto chosen_gun = [&]() {
+        main_npc.evaluate_best_weapon( zombie );
+        return dynamic_cast<npc_attack_gun *>( main_npc.get_current_attack().get() ) != nullptr;
+    };
+
+    item weapon( "knife_chef" );
+    main_npc.set_wielded_item( weapon );
+    CHECK_FALSE( chosen_gun() );
+    // Nothing changed, the same answer from the remembered candidates.
+    CHECK_FALSE( chosen_gun() );
+
+    arm_shooter( main_npc, "m16a4" );
+    CHECK( chosen_gun() );
+
+    main_npc.rules.set_flag( ally_rule::use_silent );
+    CHECK_FALSE( chosen_gun() );
+}
+
 // TODO: Add scenarios for:
 // - NPCs carrying a mix of weapons
 // - NPCs trying to shoot through allies
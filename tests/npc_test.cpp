@@ -19,6 +19,7 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "memory_fast.h"
+#include "monster.h"
 #include "npc.h"
 #include "npc_class.h"
 #include "optional.h"
@@ -36,6 +37,7 @@
 class Creature;
 
 static const efftype_id effect_bouldering( "bouldering" );
+static const efftype_id effect_npc_fire_bad( "npc_fire_bad" );
 static const efftype_id effect_sleep( "sleep" );
 
 static const trait_id trait_WEB_WEAVER( "WEB_WEAVER" );
@@ -465,3 +467,49 @@ TEST_CASE( "npc_can_target_player" )
     REQUIRE( hostile.current_target() != nullptr );
     CHECK( hostile.current_target() == static_cast<Creature *>( &player_character ) );
 }
+
+TEST_CASE( "npc_notices_hostiles_after_quiet_turns" )
+{
+    clear_map();
+    calendar::turn = calendar::turn_zero + 12_hours;
+    g->faction_manager_ptr->create_if_needed();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    clear_npcs();
+    clear_creatures();
+
+    Character &player_character = get_player_character();
+    npc &guy = spawn_npc( player_character.pos().xy() + point( 5, 0 ), "thug" );
+    guy.set_attitude( NPCATT_NULL );
+
+    // Nothing to fear, twice, so the second assessment is answered from the first.
+    guy.regen_ai_cache();
+    guy.regen_ai_cache();
+    CHECK( guy.current_target() == nullptr );
+
+    monster &zed = spawn_test_monster( "mon_zombie", guy.pos() + tripoint( 2, 0, 0 ) );
+    guy.regen_ai_cache();
+    CHECK( guy.current_target() == static_cast<Creature *>( &zed ) );
+}
+
+TEST_CASE( "npc_backs_off_from_fire_in_quiet_turns" )
+{
+    clear_map();
+    calendar::turn = calendar::turn_zero + 12_hours;
+    g->faction_manager_ptr->create_if_needed();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    clear_npcs();
+    clear_creatures();
+
+    Character &player_character = get_player_character();
+    npc &guy = spawn_npc( player_character.pos().xy() + point( 5, 0 ), "thug" );
+    guy.set_attitude( NPCATT_NULL );
+    get_map().add_field( guy.pos() + tripoint_east, fd_fire, 1 );
+
+    guy.regen_ai_cache();
+    REQUIRE( guy.has_effect( effect_npc_fire_bad ) );
+
+    // Nothing changed around, so the danger assessment is skipped, but not the fire check.
+    guy.remove_effect( effect_npc_fire_bad );
+    guy.regen_ai_cache();
+    CHECK( guy.has_effect( effect_npc_fire_bad ) );
+}
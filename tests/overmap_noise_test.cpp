@@ -1,8 +1,11 @@
+#include <vector>
+
 #include "cata_catch.h"
 #include "coordinates.h"
 #include "filesystem.h"
 #include "game_constants.h"
 #include "overmap_noise.h"
+#include "point.h"
 
 static void export_raw_noise( const std::string &filename, const om_noise::om_noise_layer &noise,
                               int width, int height )
@@ -65,3 +68,52 @@ TEST_CASE( "om_noise_layer_lake_export", "[.]" )
     export_raw_noise( "lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5 );
     export_interpreted_noise( "lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25 );
 }
+
+TEST_CASE( "om_noise_field_matches_its_layer", "[overmap][noise]" )
+{
+    const point_abs_omt base( OMAPX * 3, -OMAPY );
+    const om_noise::om_noise_layer_forest forest( base, 1920237457 );
+    const om_noise::om_noise_layer_lake lake( base, 1920237457 );
+    om_noise::om_noise_field forest_field( forest );
+    om_noise::om_noise_field lake_field( lake );
+    om_noise::om_noise_field::fill( { &forest_field, &lake_field } );
+
+    int mismatches = 0;
+    for( int x = -2; x < OMAPX + 2; x++ ) {
+        for( int y = -2; y < OMAPY + 2; y++ ) {
+            const point_om_omt p( x, y );
+            if( forest_field.noise_at( p ) != forest.noise_at( p ) ||
+                lake_field.noise_at( p ) != lake.noise_at( p ) ) {
+                mismatches++;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "om_noise_columns_match_points", "[overmap][noise]" )
+{
+    const point_abs_omt base( -OMAPX * 2, OMAPY * 5 );
+    const om_noise::om_noise_layer_forest forest( base, 89218 );
+    const om_noise::om_noise_layer_floodplain floodplain( base, 89218 );
+    const om_noise::om_noise_layer_lake lake( base, 89218 );
+    const int count = OMAPY + 7;
+    std::vector<float> column( count );
+    for( const om_noise::om_noise_layer *layer : {
+             static_cast<const om_noise::om_noise_layer *>( &forest ),
+             static_cast<const om_noise::om_noise_layer *>( &floodplain ),
+             static_cast<const om_noise::om_noise_layer *>( &lake )
+         } ) {
+        int mismatches = 0;
+        for( int x = -3; x < OMAPX + 3; x += 7 ) {
+            const point_om_omt start( x, -4 );
+            layer->fill_column( start, count, column.data() );
+            for( int n = 0; n < count; n++ ) {
+                if( column[n] != layer->noise_at( start + point( 0, n ) ) ) {
+                    mismatches++;
+                }
+            }
+        }
+        CHECK( mismatches == 0 );
+    }
+}
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "all_enum_values.h"
@@ -9,8 +12,10 @@
 #include "enums.h"
 #include "game_constants.h"
 #include "map.h"
+#include "mongroup.h"
 #include "omdata.h"
 #include "overmap.h"
+#include "overmap_location.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
 #include "type_id.h"
@@ -384,3 +389,163 @@ TEST_CASE( "overmap_terrain_coverage", "[overmap][slow]" )
     }
     */
 }
+
+TEST_CASE( "travel_paths_follow_overmap_changes", "[overmap][pathfinding]" )
+{
+    overmap_path_params params;
+    for( int *cost : {
+             &params.road_cost, &params.field_cost, &params.dirt_road_cost, &params.trail_cost,
+             &params.forest_cost, &params.small_building_cost, &params.shore_cost, &params.swamp_cost,
+             &params.water_cost, &params.air_cost, &params.other_cost
+         } ) {
+        *cost = overmap_path_params::standard_cost;
+    }
+    params.only_known_by_player = false;
+    params.avoid_danger = false;
+
+    const tripoint_abs_omt src( 10, 10, 0 );
+    const tripoint_abs_omt dest( 20, 10, 0 );
+    const std::vector<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest, params );
+    REQUIRE( path.size() > 2 );
+    CHECK( path.front() == dest );
+    CHECK( path.back() == src );
+
+    // Asking again from a point on the way gives the rest of the same path.
+    const size_t middle = path.size() / 2;
+    const std::vector<tripoint_abs_omt> rest = overmap_buffer.get_travel_path( path[middle], dest,
+            params );
+    CHECK( rest == std::vector<tripoint_abs_omt>( path.begin(), path.begin() + middle + 1 ) );
+
+    // Blocking the way is noticed.
+    overmap_buffer.ter_set( path[middle], oter_id( "empty_rock" ) );
+    const std::vector<tripoint_abs_omt> detour = overmap_buffer.get_travel_path( src, dest, params );
+    REQUIRE( !detour.empty() );
+    CHECK( detour.front() == dest );
+    CHECK( std::find( detour.begin(), detour.end(), path[middle] ) == detour.end() );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "find_terrain_follows_overmap_changes", "[overmap]" )
+{
+    overmap_buffer.get( point_abs_om() );
+    const tripoint_abs_omt origin( 90, 90, 0 );
+    omt_find_params params;
+    params.types = {{ "hospital_1", ot_match_type::type }};
+    params.search_range = 90;
+    params.existing_only = true;
+    const std::vector<tripoint_abs_omt> before = overmap_buffer.find_all( origin, params );
+
+    const tripoint_abs_omt target = origin + point( 5, -3 );
+    const oter_id old_ter = overmap_buffer.ter( target );
+    REQUIRE( !is_ot_match( "hospital_1", old_ter, ot_match_type::type ) );
+    overmap_buffer.ter_set( target, oter_id( "hospital_1_north" ) );
+
+    const std::vector<tripoint_abs_omt> with_target = overmap_buffer.find_all( origin, params );
+    CHECK( with_target.size() == before.size() + 1 );
+    CHECK( std::find( with_target.begin(), with_target.end(), target ) != with_target.end() );
+    CHECK( overmap_buffer.find_closest( target, params ) == target );
+
+    overmap_buffer.ter_set( target, old_ter );
+    CHECK( overmap_buffer.find_all( origin, params ).size() == before.size() );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "overmap_location_test_follows_its_terrain_types", "[overmap]" )
+{
+    for( const char *name : {
+             "field", "forest", "land", "swamp"
+         } ) {
+        const overmap_location &location = overmap_location_id( name ).obj();
+        const overmap_location::TerrColType &types = location.get_all_terrains();
+        int mismatches = 0;
+        for( const oter_t &ter : overmap_terrains::get_all() ) {
+            if( location.test( ter.id.id() ) != ( types.count( ter.get_type_id() ) > 0 ) ) {
+                mismatches++;
+            }
+        }
+        INFO( name );
+        CHECK( mismatches == 0 );
+    }
+}
+
+TEST_CASE( "overmap_terrain_round_trips_through_its_palette", "[overmap]" )
+{
+    const oter_id field( "field" );
+    const oter_id forest( "forest" );
+    std::unique_ptr<overmap> om = std::make_unique<overmap>( point_abs_om() );
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                om->ter_set( tripoint_om_omt( x, y, z ), ( x + y ) % 3 == 0 ? forest : field );
+            }
+        }
+    }
+    om->ter_set( tripoint_om_omt( 7, 9, 0 ), oter_cabin_east.id() );
+
+    std::ostringstream saved;
+    om->serialize( saved );
+    const std::string text = saved.str();
+    // Every terrain is named once.
+    CHECK( text.find( "\"field\"" ) == text.rfind( "\"field\"" ) );
+
+    std::unique_ptr<overmap> loaded = std::make_unique<overmap>( point_abs_om() );
+    std::istringstream is( text );
+    loaded->unserialize( is );
+    int mismatches = 0;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                const tripoint_om_omt p( x, y, z );
+                if( loaded->ter( p ) != om->ter( p ) ) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+
+    SECTION( "overmaps saved with names in every run still load" ) {
+        std::string old_format = "{\"layers\":[";
+        for( int z = 0; z < OVERMAP_LAYERS; z++ ) {
+            old_format += z == 0 ? "" : ",";
+            old_format += "[[\"forest\",1],[\"field\",";
+            old_format += std::to_string( OMAPX * OMAPY - 1 ) + "]]";
+        }
+        old_format += "]}";
+        std::istringstream old_is( old_format );
+        loaded->unserialize( old_is );
+        CHECK( loaded->ter( tripoint_om_omt( 0, 0, 0 ) ) == forest );
+        CHECK( loaded->ter( tripoint_om_omt( 1, 0, 0 ) ) == field );
+        CHECK( loaded->ter( tripoint_om_omt( OMAPX - 1, OMAPY - 1, OVERMAP_HEIGHT ) ) == field );
+    }
+}
+
+TEST_CASE( "overmap_monster_groups_load_both_position_formats", "[overmap][monster]" )
+{
+    const mongroup first( "GROUP_ZOMBIE", tripoint( 1, 2, 0 ), 1, 3, tripoint_zero, 0, false, true,
+                          false );
+    const mongroup second( "GROUP_ZOMBIE", tripoint( 4, 5, -1 ), 1, 3, tripoint_zero, 0, false,
+                           true, false );
+    const std::string group = "{\"type\":\"GROUP_ZOMBIE\",\"radius\":1,\"population\":3,"
+                              "\"horde\":true}";
+
+    std::unique_ptr<overmap> om = std::make_unique<overmap>( point_abs_om() );
+    SECTION( "flat position triples" ) {
+        std::istringstream is( "{\"monster_groups\":[[" + group + ",[1,2,0,4,5,-1]]]}" );
+        om->unserialize( is );
+    }
+    SECTION( "one array per position" ) {
+        std::istringstream is( "{\"monster_groups\":[[" + group + ",[[1,2,0],[4,5,-1]]]]}" );
+        om->unserialize( is );
+    }
+    CHECK( om->mongroup_check( first ) );
+    CHECK( om->mongroup_check( second ) );
+
+    std::ostringstream saved;
+    om->serialize( saved );
+    std::unique_ptr<overmap> loaded = std::make_unique<overmap>( point_abs_om() );
+    std::istringstream is( saved.str() );
+    loaded->unserialize( is );
+    CHECK( loaded->mongroup_check( first ) );
+    CHECK( loaded->mongroup_check( second ) );
+}
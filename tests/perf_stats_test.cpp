@@ -0,0 +1,57 @@
+#include <chrono>
+
+#include "cata_catch.h"
+#include "perf_stats.h"
+
+TEST_CASE( "perf_stats_percentiles_over_turns", "[perf_stats]" )
+{
+    perf_stats::reset();
+    for( int i = 1; i <= 100; ++i ) {
+        // Two samples in one turn add up.
+        perf_stats::add_sample( perf_stage::monmove, std::chrono::microseconds( i ) );
+        perf_stats::add_sample( perf_stage::monmove, std::chrono::microseconds( i ) );
+        perf_stats::end_turn();
+    }
+
+    const perf_stats::stage_summary monmove = perf_stats::summarize( perf_stage::monmove );
+    CHECK( monmove.turns == 100 );
+    CHECK( monmove.p50 == Approx( 102 ) );
+    CHECK( monmove.p90 == Approx( 182 ) );
+    CHECK( monmove.p99 == Approx( 200 ) );
+    CHECK( monmove.max == Approx( 200 ) );
+
+    const perf_stats::stage_summary fields = perf_stats::summarize( perf_stage::process_fields );
+    CHECK( fields.turns == 100 );
+    CHECK( fields.max == 0 );
+
+    perf_stats::reset();
+    CHECK( perf_stats::summarize( perf_stage::monmove ).turns == 0 );
+}
+
+TEST_CASE( "perf_stats_histogram_buckets_double", "[perf_stats]" )
+{
+    perf_stats::reset();
+    for( const int us : {
+             500, 1500, 1999, 3000, 100000
+         } ) {
+        perf_stats::frame_drawn( std::chrono::microseconds( us ) );
+    }
+
+    const perf_stats::histogram hist = perf_stats::get_histogram( frame_stat::render );
+    CHECK( hist[0] == 1 );
+    CHECK( hist[1] == 2 );
+    CHECK( hist[2] == 1 );
+    CHECK( hist[perf_stats::histogram_buckets - 1] == 1 );
+    CHECK( perf_stats::summarize( frame_stat::render ).turns == 5 );
+    CHECK( perf_stats::histogram_bucket_name( 0 ) == "<1ms" );
+    CHECK( perf_stats::histogram_bucket_name( 2 ) == "2-4ms" );
+    CHECK( perf_stats::histogram_bucket_name( perf_stats::histogram_buckets - 1 ) == "64+ms" );
+
+    // Only a frame drawn after an input counts towards the latency.
+    CHECK( perf_stats::summarize( frame_stat::input_latency ).turns == 0 );
+    perf_stats::input_received();
+    perf_stats::frame_drawn( std::chrono::microseconds( 10 ) );
+    perf_stats::frame_drawn( std::chrono::microseconds( 10 ) );
+    CHECK( perf_stats::summarize( frame_stat::input_latency ).turns == 1 );
+    perf_stats::reset();
+}
@@ -1,10 +1,15 @@
 #include <functional>
+#include <memory>
 #include <new>
 #include <ostream>
+#include <random>
 #include <vector>
 
 #include "cached_options.h"
 #include "cata_catch.h"
+#include "enums.h"
+#include "game_constants.h"
+#include "level_cache.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "map_iterator.h"
@@ -13,6 +18,7 @@
 #include "optional.h"
 #include "options_helpers.h"
 #include "point.h"
+#include "reachability_cache.h"
 
 using namespace map_test_case_common;
 using namespace map_test_case_common::tiles;
@@ -113,3 +119,85 @@ TEST_CASE( "reachability_vertical", "[map][cache][vision][los][reachability]" )
         }
     }, /*up*/ true );
 }
+
+// A level with every fifth tile opaque and patches without floor, at fixed places.
+static std::unique_ptr<level_cache> make_scattered_level()
+{
+    std::unique_ptr<level_cache> lc = std::make_unique<level_cache>();
+    lc->transparency_cache_dirty.reset();
+    std::minstd_rand gen( 7 );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            lc->transparent_cache_wo_fields[x][y] = gen() % 5 != 0;
+            lc->floor_cache[x][y] = gen() % 7 != 0;
+        }
+    }
+    return lc;
+}
+
+template<typename Cache, typename... Levels>
+static void check_partial_rebuild_matches_full_rebuild( level_cache &lc, const Levels &... levels )
+{
+    Cache partial;
+    partial.has_potential_los( point_zero, point_south_east, levels... );
+
+    std::minstd_rand gen( 11 );
+    for( int i = 0; i < 40; ++i ) {
+        point p( gen() % MAPSIZE_X, gen() % MAPSIZE_Y );
+        // Half of them on the edge of a submap, where the change reaches into its neighbors.
+        if( i % 2 == 0 ) {
+            p.x = p.x / SEEX * SEEX + ( i % 4 == 0 ? 0 : SEEX - 1 );
+        }
+        lc.transparent_cache_wo_fields[p.x][p.y].flip();
+        lc.floor_cache[p.x][p.y] = !lc.floor_cache[p.x][p.y];
+        partial.invalidate( p );
+    }
+    partial.has_potential_los( point_zero, point_south_east, levels... );
+
+    Cache full;
+    full.has_potential_los( point_zero, point_south_east, levels... );
+    int differing = 0;
+    for( int q = 0; q < enum_traits<reachability_cache_quadrant>::size; ++q ) {
+        const reachability_cache_quadrant quad = static_cast<reachability_cache_quadrant>( q );
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                const point p( x, y );
+                if( partial.get_value( quad, p ) != full.get_value( quad, p ) ) {
+                    ++differing;
+                }
+            }
+        }
+    }
+    CHECK( differing == 0 );
+}
+
+TEST_CASE( "reachability_partial_rebuild", "[cache][reachability]" )
+{
+    std::unique_ptr<level_cache> lc = make_scattered_level();
+    SECTION( "horizontal" ) {
+        check_partial_rebuild_matches_full_rebuild<reachability_cache_horizontal>( *lc, *lc );
+    }
+    SECTION( "vertical" ) {
+        check_partial_rebuild_matches_full_rebuild<reachability_cache_vertical>( *lc, *lc, *lc );
+    }
+}
+
+TEST_CASE( "reachability_rebuild_benchmark", "[.][cache][reachability][benchmark]" )
+{
+    std::unique_ptr<level_cache> lc = make_scattered_level();
+    reachability_cache_horizontal horizontal;
+    reachability_cache_vertical vertical;
+
+    BENCHMARK( "horizontal, full rebuild" ) {
+        horizontal.invalidate();
+        return horizontal.has_potential_los( point_zero, point_south_east, *lc );
+    };
+    BENCHMARK( "horizontal, one tile changed" ) {
+        horizontal.invalidate( point( 60, 60 ) );
+        return horizontal.has_potential_los( point_zero, point_south_east, *lc );
+    };
+    BENCHMARK( "vertical, full rebuild" ) {
+        vertical.invalidate();
+        return vertical.has_potential_los( point_zero, point_south_east, *lc, *lc );
+    };
+}
@@ -78,3 +78,35 @@ TEST_CASE( "random_entry_preserves_constness" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+static std::vector<int> draw_ten()
+{
+    std::vector<int> drawn;
+    for( int i = 0; i < 10; ++i ) {
+        drawn.push_back( rng( 0, 1000000 ) );
+    }
+    return drawn;
+}
+
+TEST_CASE( "rng_streams_repeat_for_the_same_key", "[rng]" )
+{
+    const cata_default_random_engine global_before = rng_get_engine();
+    std::vector<int> first;
+    std::vector<int> other_key;
+    {
+        rng_stream stream( 42 );
+        first = draw_ten();
+        {
+            rng_stream inner( 43 );
+            other_key = draw_ten();
+        }
+        // Back to the outer stream, where it left off.
+        CHECK( draw_ten() != first );
+    }
+    // The streams left the global engine alone.
+    CHECK( rng_get_engine() == global_before );
+
+    rng_stream again( 42 );
+    CHECK( draw_ten() == first );
+    CHECK( other_key != first );
+}
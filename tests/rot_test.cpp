@@ -127,3 +127,25 @@ TEST_CASE( "Hourly rotpoints", "[rot]" )
     // Maximum rot at above 105 F
     CHECK( normal_item.get_hourly_rotpoints_at_temp( 107 ) == Approx( 20364.67 ).margin( 0.1 ) );
 }
+
+TEST_CASE( "Rot of a long absence is caught up in one pass", "[rot]" )
+{
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    // A root cellar keeps a steady temperature, so the days away are folded into one chunk.
+    item away_item( "meat_cooked" );
+    item watched_item( "meat_cooked" );
+    away_item.process( nullptr, tripoint_zero, 1, temperature_flag::ROOT_CELLAR );
+    watched_item.process( nullptr, tripoint_zero, 1, temperature_flag::ROOT_CELLAR );
+
+    for( int hour = 0; hour < 72; ++hour ) {
+        calendar::turn += 1_hours;
+        watched_item.process( nullptr, tripoint_zero, 1, temperature_flag::ROOT_CELLAR );
+    }
+    away_item.process( nullptr, tripoint_zero, 1, temperature_flag::ROOT_CELLAR );
+
+    REQUIRE( watched_item.get_rot() > 0_turns );
+    CHECK( to_turns<int>( away_item.get_rot() ) ==
+           Approx( to_turns<int>( watched_item.get_rot() ) ).epsilon( 0.02 ) );
+}
@@ -0,0 +1,82 @@
+#include <fstream>
+#include <string>
+
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "path_info.h"
+#include "save_journal.h"
+
+static void write_text( const std::string &path, const std::string &text )
+{
+    write_to_file( path, [&]( std::ostream & fout ) {
+        fout << text;
+    } );
+}
+
+TEST_CASE( "save_journal_holds_files_until_they_are_needed", "[save_journal]" )
+{
+    save_journal::apply();
+    const std::string journal = save_journal::journal_path();
+    const std::string path = PATH_INFO::world_base_save_path() + "/save_journal_test.txt";
+    write_text( path, "old" );
+
+    {
+        save_journal::capture capture( true );
+        write_text( path, "new" );
+    }
+    REQUIRE( file_exist( journal ) );
+
+    SECTION( "reading a journaled file settles it" ) {
+        CHECK( read_entire_file( path ) == "new" );
+        // It was the only file in the journal.
+        CHECK_FALSE( file_exist( journal ) );
+    }
+
+    SECTION( "replacing a journaled file settles it first" ) {
+        write_text( path, "newer" );
+        CHECK_FALSE( file_exist( journal ) );
+        CHECK( read_entire_file( path ) == "newer" );
+    }
+
+    SECTION( "applying writes every file into place" ) {
+        {
+            save_journal::capture capture( true );
+            write_text( path, "newest" );
+        }
+        save_journal::apply();
+        CHECK_FALSE( file_exist( journal ) );
+        CHECK( read_entire_file( path ) == "newest" );
+    }
+
+    remove_file( path );
+}
+
+TEST_CASE( "save_journal_replays_what_a_crash_left", "[save_journal]" )
+{
+    save_journal::apply();
+    const std::string journal = save_journal::journal_path();
+    const std::string path = PATH_INFO::world_base_save_path() + "/save_journal_test.txt";
+    write_text( path, "old" );
+    {
+        // Two complete records, then one cut short while it was appended.
+        std::ofstream fout( journal, std::ios::binary );
+        fout << "W 5 save_journal_test.txt\nfirst\n";
+        fout << "W 6 save_journal_test.txt\nsecond\n";
+        fout << "W 9 save_journal_test.txt\nthi";
+    }
+    save_journal::apply();
+    CHECK_FALSE( file_exist( journal ) );
+    CHECK( read_entire_file( path ) == "second" );
+
+    {
+        std::ofstream fout( journal, std::ios::binary );
+        fout << "W 5 save_journal_test.txt\nfirst\n";
+        fout << "S save_journal_test.txt\n";
+    }
+    save_journal::apply();
+    // It was settled, so the file on disk is newer than the record.
+    CHECK( read_entire_file( path ) == "second" );
+
+    remove_file( path );
+}
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "cata_catch.h"
+#include "point.h"
+#include "save_stats.h"
+
+TEST_CASE( "save_stats_totals_and_largest_quads", "[save_stats]" )
+{
+    save_stats::begin_save();
+    save_stats::add_file( save_part::overmaps, 100 );
+    save_stats::add_file( save_part::overmaps, 50 );
+    save_stats::add_unchanged_file( save_part::overmaps );
+    for( int i = 1; i <= 20; ++i ) {
+        save_stats::add_quad( tripoint( i, 0, 0 ), i * 10, i );
+    }
+
+    const save_stats::part_totals overmaps = save_stats::totals( save_part::overmaps );
+    CHECK( overmaps.files == 2 );
+    CHECK( overmaps.unchanged_files == 1 );
+    CHECK( overmaps.bytes == 150 );
+    CHECK( save_stats::totals( save_part::submaps ).files == 0 );
+
+    const std::vector<save_stats::quad_summary> quads = save_stats::largest_quads();
+    REQUIRE( quads.size() == 10 );
+    CHECK( quads.front().om_addr == tripoint( 20, 0, 0 ) );
+    CHECK( quads.front().items == 20 );
+    CHECK( quads.back().bytes == 110 );
+
+    save_stats::begin_save();
+    CHECK( save_stats::totals( save_part::overmaps ).files == 0 );
+    CHECK( save_stats::largest_quads().empty() );
+}
+
+TEST_CASE( "save_timers_charge_only_their_own_time", "[save_stats]" )
+{
+    save_stats::begin_save();
+    {
+        save_timer outer( save_part::other );
+        {
+            save_timer inner( save_part::master );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        }
+    }
+    CHECK( save_stats::totals( save_part::master ).time >= std::chrono::milliseconds( 20 ) );
+    CHECK( save_stats::totals( save_part::other ).time < std::chrono::milliseconds( 20 ) );
+}
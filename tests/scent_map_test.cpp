@@ -0,0 +1,170 @@
+#include <array>
+
+#include "cata_catch.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "point.h"
+#include "scent_map.h"
+#include "type_id.h"
+
+static const furn_str_id furn_f_generator_broken( "f_generator_broken" );
+
+static const ter_str_id ter_t_dirt( "t_dirt" );
+static const ter_str_id ter_t_wall( "t_wall" );
+
+namespace
+{
+
+class test_scent_map : public scent_map
+{
+    public:
+        using scent_map::scent_array;
+        using scent_map::grscent;
+
+        test_scent_map() : scent_map( *g ) {}
+};
+
+} // namespace
+
+// The diffusion step of scent_map::update as it was written before the row kernel, one
+// square at a time over the whole scent radius, kept to check the kernel against.
+static void reference_diffusion( test_scent_map::scent_array<int> &grscent, const tripoint &center,
+                                 map &m )
+{
+    constexpr int radius = 40;
+    const int minx = center.x - radius;
+    const int maxx = center.x + radius;
+    const int miny = center.y - radius;
+    const int maxy = center.y + radius;
+    const int diffusivity = 100;
+
+    test_scent_map::scent_array<int> sum_3_scent_y;
+    test_scent_map::scent_array<int> squares_used_y;
+    test_scent_map::scent_array<bool> blocks_scent;
+    test_scent_map::scent_array<bool> reduces_scent;
+    m.scent_blockers( blocks_scent, reduces_scent, point( minx - 1, miny - 1 ),
+                      point( maxx + 1, maxy + 1 ) );
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        for( int y = miny; y <= maxy; ++y ) {
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( !blocks_scent[x][i] ) {
+                    if( reduces_scent[x][i] ) {
+                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
+                        squares_used_y[y][x] += 2;
+                    } else {
+                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
+                        squares_used_y[y][x] += 10;
+                    }
+                }
+            }
+        }
+    }
+    for( int x = minx; x <= maxx; ++x ) {
+        for( int y = miny; y <= maxy; ++y ) {
+            int &scent_here = grscent[x][y];
+            if( !blocks_scent[x][y] ) {
+                const int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] +
+                                         squares_used_y[y][x + 1];
+                const int this_diffusivity = reduces_scent[x][y] ? diffusivity / 5 : diffusivity;
+                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+                scent_here = ( temp_scent + this_diffusivity * ( sum_3_scent_y[y][x - 1] +
+                               sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1] ) ) / ( 1000 * 10 );
+            } else {
+                scent_here = 0;
+            }
+        }
+    }
+}
+
+TEST_CASE( "scent_diffusion_matches_reference", "[scent]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint center( 60, 60, 0 );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const int k = x * 5 + y * 7;
+            if( k % 13 == 0 ) {
+                here.ter_set( tripoint( x, y, 0 ), ter_t_wall );
+            } else if( k % 17 == 0 ) {
+                here.furn_set( tripoint( x, y, 0 ), furn_f_generator_broken );
+            }
+        }
+    }
+
+    test_scent_map scent;
+    scent.reset();
+    SECTION( "scent all over the radius" ) {
+        for( int x = 15; x < 106; x += 2 ) {
+            for( int y = 15; y < 106; y += 3 ) {
+                scent.grscent[x][y] = ( x * 31 + y * 17 ) % 900;
+            }
+        }
+    }
+    SECTION( "scent in one corner" ) {
+        for( int x = 20; x < 30; ++x ) {
+            for( int y = 90; y < 101; ++y ) {
+                scent.grscent[x][y] = 500;
+            }
+        }
+    }
+    SECTION( "scent just outside the radius" ) {
+        scent.grscent[19][60] = 800;
+        scent.grscent[60][101] = 800;
+    }
+    SECTION( "no scent" ) {
+    }
+
+    test_scent_map::scent_array<int> expected = scent.grscent;
+    reference_diffusion( expected, center, here );
+    for( int turn = 0; turn < 3; ++turn ) {
+        scent.update( center, here );
+        CHECK( scent.grscent == expected );
+        reference_diffusion( expected, center, here );
+    }
+}
+
+TEST_CASE( "scent_blockers_follow_terrain_changes", "[scent]" )
+{
+    clear_map();
+    map &here = get_map();
+    const point min( 30, 30 );
+    const point max( 90, 90 );
+    test_scent_map::scent_array<bool> blocks_scent;
+    test_scent_map::scent_array<bool> reduces_scent;
+    const auto check_against_flags = [&]() {
+        here.scent_blockers( blocks_scent, reduces_scent, min, max );
+        int mismatches = 0;
+        for( int x = min.x; x <= max.x; ++x ) {
+            for( int y = min.y; y <= max.y; ++y ) {
+                const tripoint p( x, y, 0 );
+                const bool blocks = here.has_flag_ter( ter_furn_flag::TFLAG_NO_SCENT, p );
+                const bool reduces = !blocks && here.has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT, p );
+                if( blocks_scent[x][y] != blocks || reduces_scent[x][y] != reduces ) {
+                    ++mismatches;
+                }
+            }
+        }
+        CHECK( mismatches == 0 );
+    };
+
+    check_against_flags();
+
+    here.ter_set( tripoint( 40, 40, 0 ), ter_t_wall );
+    here.furn_set( tripoint( 41, 40, 0 ), furn_f_generator_broken );
+    here.ter_set( tripoint( 75, 62, 0 ), ter_t_wall );
+    check_against_flags();
+    CHECK( blocks_scent[40][40] );
+    CHECK( reduces_scent[41][40] );
+
+    here.ter_set( tripoint( 40, 40, 0 ), ter_t_dirt );
+    here.furn_set( tripoint( 41, 40, 0 ), furn_str_id::NULL_ID() );
+    check_against_flags();
+    CHECK_FALSE( blocks_scent[40][40] );
+    CHECK_FALSE( reduces_scent[41][40] );
+}
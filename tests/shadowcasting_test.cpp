@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstdio>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <type_traits>
 #include <vector>
@@ -11,6 +12,7 @@
 #include "cuboid_rectangle.h"
 #include "game_constants.h"
 #include "level_cache.h"
+#include "level_cache_layout.h"
 #include "lightmap.h"
 #include "line.h" // For rl_dist.
 #include "map.h"
@@ -346,6 +348,138 @@ static void shadowcasting_float_quad(
     REQUIRE( passed );
 }
 
+static void shadowcasting_parallel_octants(
+    const int iterations, const unsigned int denominator = DENOMINATOR )
+{
+    struct test_grids {
+        float seen_squares_control[MAPSIZE * SEEX][MAPSIZE * SEEY] = {};
+        float seen_squares_experiment[MAPSIZE * SEEX][MAPSIZE * SEEY] = {};
+        float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY] = {};
+    };
+
+    std::unique_ptr<test_grids> grids = std::make_unique<test_grids>();
+    float ( &seen_squares_control )[MAPSIZE * SEEX][MAPSIZE * SEEY] = grids->seen_squares_control;
+    float ( &seen_squares_experiment )[MAPSIZE * SEEX][MAPSIZE * SEEY] =
+        grids->seen_squares_experiment;
+    float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY] = grids->transparency_cache;
+
+    randomly_fill_transparency( transparency_cache, denominator );
+
+    const point offset( 65, 65 );
+
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            seen_squares_control, transparency_cache, offset );
+    }
+    const auto end1 = std::chrono::high_resolution_clock::now();
+
+    const auto start2 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        castLightAllParallel<float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            seen_squares_experiment, transparency_cache, offset );
+    }
+    const auto end2 = std::chrono::high_resolution_clock::now();
+
+    if( iterations > 1 ) {
+        const long long diff1 = std::chrono::duration_cast<std::chrono::microseconds>
+                                ( end1 - start1 ).count();
+        const long long diff2 = std::chrono::duration_cast<std::chrono::microseconds>
+                                ( end2 - start2 ).count();
+        printf( "castLightAll() (denominator %u) executed %d times in %lld microseconds.\n",
+                denominator, iterations, diff1 );
+        printf( "castLightAllParallel() (denominator %u) executed %d times in %lld microseconds.\n",
+                denominator, iterations, diff2 );
+    }
+
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE * SEEX; ++x ) {
+        for( int y = 0; y < MAPSIZE * SEEY; ++y ) {
+            if( seen_squares_control[x][y] != seen_squares_experiment[x][y] ) {
+                ++mismatches;
+            }
+        }
+    }
+    if( mismatches != 0 ) {
+        print_grid_comparison( offset, transparency_cache, seen_squares_control,
+                               seen_squares_experiment );
+    }
+
+    REQUIRE( mismatches == 0 );
+}
+
+// Runs map::apparent_light_helper over the whole level against the flat level_cache
+// arrays and against a packed, submap-tiled copy, and checks both give the same answers.
+static void apparent_light_layouts( const int iterations )
+{
+    std::unique_ptr<level_cache> cache = std::make_unique<level_cache>();
+    randomly_fill_transparency( cache->transparency_cache );
+    std::copy_n( &cache->transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
+                 &cache->vision_transparency_cache[0][0] );
+    const point offset( 65, 65 );
+    cache->seen_cache[offset.x][offset.y] = VISIBILITY_FULL;
+    castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+        cache->seen_cache, cache->vision_transparency_cache, offset );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            for( float &v : cache->lm[x][y].values ) {
+                v = rng_float( 0.0, 20.0 );
+            }
+        }
+    }
+
+    std::unique_ptr<apparent_light_tiles> tiles = std::make_unique<apparent_light_tiles>();
+    pack_apparent_light_tiles( *cache, *tiles );
+    const level_cache_flat_view flat{ *cache };
+    const level_cache_tiled_view tiled{ *tiles };
+
+    float flat_sum = 0.0f;
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                flat_sum += map::apparent_light_helper( flat, point( x, y ) ).apparent_light;
+            }
+        }
+    }
+    const auto end1 = std::chrono::high_resolution_clock::now();
+
+    float tiled_sum = 0.0f;
+    const auto start2 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                tiled_sum += map::apparent_light_helper( tiled, point( x, y ) ).apparent_light;
+            }
+        }
+    }
+    const auto end2 = std::chrono::high_resolution_clock::now();
+
+    if( iterations > 1 ) {
+        const long long diff1 = std::chrono::duration_cast<std::chrono::microseconds>
+                                ( end1 - start1 ).count();
+        const long long diff2 = std::chrono::duration_cast<std::chrono::microseconds>
+                                ( end2 - start2 ).count();
+        printf( "apparent_light_helper() on flat arrays executed %d times in %lld microseconds.\n",
+                iterations, diff1 );
+        printf( "apparent_light_helper() on submap tiles executed %d times in %lld microseconds.\n",
+                iterations, diff2 );
+    }
+
+    CHECK( flat_sum == tiled_sum );
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const map::apparent_light_info a = map::apparent_light_helper( flat, point( x, y ) );
+            const map::apparent_light_info b = map::apparent_light_helper( tiled, point( x, y ) );
+            if( a.obstructed != b.obstructed || a.apparent_light != b.apparent_light ) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
 static void do_3d_benchmark(
     std::array<const float ( * )[MAPSIZE *SEEX][MAPSIZE *SEEY], OVERMAP_LAYERS> &transparency_caches,
     const int iterations )
@@ -1121,6 +1255,28 @@ TEST_CASE( "shadowcasting_float_quad_performance", "[.]" )
     shadowcasting_float_quad( 1000000, 100 );
 }
 
+TEST_CASE( "shadowcasting_parallel_octants_equivalence", "[shadowcasting]" )
+{
+    shadowcasting_parallel_octants( 1 );
+    shadowcasting_parallel_octants( 1, 100 );
+}
+
+TEST_CASE( "shadowcasting_parallel_octants_performance", "[.]" )
+{
+    shadowcasting_parallel_octants( 100000 );
+    shadowcasting_parallel_octants( 100000, 100 );
+}
+
+TEST_CASE( "apparent_light_layout_equivalence", "[shadowcasting]" )
+{
+    apparent_light_layouts( 1 );
+}
+
+TEST_CASE( "apparent_light_layout_performance", "[.]" )
+{
+    apparent_light_layouts( 1000 );
+}
+
 // I'm not sure this will ever work.
 TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
 {
@@ -1,6 +1,8 @@
 #include "cata_catch.h"
 #include "simple_pathfinding.h"
 
+#include <vector>
+
 #include "coordinates.h"
 #include "cuboid_rectangle.h"
 #include "line.h"
@@ -135,3 +137,35 @@ TEST_CASE( "find_overmap_path_bridge", "[pathfinding]" )
     CHECK( pth.points[0] == Point( 2, 0, 0 ) );
 }
 
+
+TEST_CASE( "greedy_path_is_the_same_when_searched_again", "[pathfinding]" )
+{
+    // A wall with one gap, and a cost for turning, so some tiles are reached a second,
+    // cheaper way.
+    const auto search = []( const point & max ) {
+        const point finish( max.x - 1, 0 );
+        const pf::two_node_scoring_fn<point> estimate =
+        [&]( pf::directed_node<point> cur, cata::optional<pf::directed_node<point>> prev ) {
+            if( cur.pos.x == max.x / 2 && cur.pos.y != max.y - 1 ) {
+                return pf::node_score::rejected;
+            }
+            const int turn = prev && prev->dir != cur.dir ? 3 : 0;
+            return pf::node_score( turn, manhattan_dist( cur.pos, finish ) );
+        };
+        const pf::directed_path<point> pth = pf::greedy_path( point_zero, finish, max, estimate );
+        std::vector<point> points;
+        for( const pf::directed_node<point> &node : pth.nodes ) {
+            points.push_back( node.pos );
+        }
+        return points;
+    };
+
+    const std::vector<point> small = search( point( 9, 9 ) );
+    REQUIRE( small.size() >= 9 + 2 * 8 );
+    CHECK( small.front() == point( 8, 0 ) );
+    CHECK( small.back() == point_zero );
+    const std::vector<point> large = search( point( 60, 40 ) );
+    CHECK( large.front() == point( 59, 0 ) );
+    CHECK( search( point( 9, 9 ) ) == small );
+    CHECK( search( point( 60, 40 ) ) == large );
+}
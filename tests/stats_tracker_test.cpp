@@ -966,3 +966,39 @@ TEST_CASE( "legacy_stats_tracker_save_loading", "[stats]" )
     CHECK( s.get_events( event_type::character_triggers_trap ).count() == 2 );
     CHECK( s.get_events( event_type::character_kills_monster ).count() == 0 );
 }
+
+TEST_CASE( "stats_tracker_cached_statistics_follow_events", "[stats]" )
+{
+    stats_tracker s;
+    event_bus b;
+    b.subscribe( &s );
+
+    const mtype_id no_monster;
+    const ter_id t_null( "t_null" );
+    const cata::event walk = cata::event::make<event_type::avatar_moves>( no_monster, t_null,
+                             move_mode_walk, false, 0 );
+    const cata::event run = cata::event::make<event_type::avatar_moves>( no_monster, t_null,
+                            move_mode_run, false, 0 );
+
+    // The first query sets up the cached value, later ones must see the new events.
+    CHECK( s.value_of( event_statistic_num_moves_walked ).get<int>() == 0 );
+    b.send( walk );
+    b.send( run );
+    b.send( walk );
+    CHECK( s.value_of( event_statistic_num_moves_walked ).get<int>() == 2 );
+    CHECK( s.value_of( event_statistic_num_moves ).get<int>() == 3 );
+
+    SECTION( "after loading" ) {
+        std::ostringstream os;
+        JsonOut jsout( os );
+        stats_tracker saved;
+        saved.notify( walk );
+        saved.serialize( jsout );
+
+        std::istringstream is( os.str() );
+        JsonIn jsin( is );
+        s.deserialize( jsin.get_object() );
+        CHECK( s.value_of( event_statistic_num_moves_walked ).get<int>() == 1 );
+        CHECK( s.value_of( event_statistic_num_moves ).get<int>() == 1 );
+    }
+}
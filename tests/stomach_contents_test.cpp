@@ -321,3 +321,28 @@ TEST_CASE( "hunger" )
     CHECK( hunger_time <= 240 );
     CHECK( hunger_time >= 180 );
 }
+
+TEST_CASE( "sleeping_body_is_updated_once_a_minute", "[stomach][sleep]" )
+{
+    Character &dummy = get_player_character();
+    reset_time();
+    while( !calendar::once_every( 1_minutes ) ) {
+        calendar::turn += 1_turns;
+        dummy.update_body();
+    }
+    dummy.fall_asleep();
+    REQUIRE( dummy.in_sleep_state() );
+    dummy.set_stamina( dummy.get_stamina_max() / 2 );
+    const int stamina = dummy.get_stamina();
+
+    for( int turn = 1; turn < 60; ++turn ) {
+        calendar::turn += 1_turns;
+        dummy.update_body();
+    }
+    CHECK( dummy.get_stamina() == stamina );
+
+    // The whole minute is recovered at once.
+    calendar::turn += 1_turns;
+    dummy.update_body();
+    CHECK( dummy.get_stamina() > stamina );
+}
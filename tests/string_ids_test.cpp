@@ -3,6 +3,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -68,6 +69,42 @@ TEST_CASE( "string_ids_intern_test", "[string_id]" )
     }
 }
 
+TEST_CASE( "string_ids_intern_from_several_threads", "[string_id]" )
+{
+    static constexpr int num_ids = 20000;
+    static constexpr int num_threads = 4;
+
+    struct test_obj {};
+    // Every thread interns the same names, each starting at a different one.
+    std::vector<std::vector<string_id<test_obj>>> ids( num_threads );
+    std::vector<std::thread> threads;
+    for( int t = 0; t < num_threads; ++t ) {
+        threads.emplace_back( [t, &ids]() {
+            ids[t].resize( num_ids );
+            for( int n = 0; n < num_ids; ++n ) {
+                const int i = ( n + t * num_ids / num_threads ) % num_ids;
+                ids[t][i] = string_id<test_obj>( "threaded_id" + std::to_string( i ) );
+            }
+        } );
+    }
+    for( std::thread &t : threads ) {
+        t.join();
+    }
+
+    int mismatches = 0;
+    for( int i = 0; i < num_ids; ++i ) {
+        for( int t = 1; t < num_threads; ++t ) {
+            if( ids[t][i] != ids[0][i] || &ids[t][i].str() != &ids[0][i].str() ) {
+                ++mismatches;
+            }
+        }
+        if( ids[0][i].str() != "threaded_id" + std::to_string( i ) ) {
+            ++mismatches;
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
 TEST_CASE( "string_ids_collection_equality", "[string_id]" )
 {
     struct test_obj {};
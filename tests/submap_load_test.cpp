@@ -905,6 +905,41 @@ TEST_CASE( "submap_terrain_rle_load", "[submap][load]" )
     }
 }
 
+TEST_CASE( "submap_terrain_rle_round_trip", "[submap][load]" )
+{
+    submap sm;
+    for( int y = 0; y < SEEY; ++y ) {
+        for( int x = 0; x < SEEX; ++x ) {
+            const ter_id mixed = y < SEEY / 2 ? t_floor : t_rock_floor;
+            sm.set_ter( { x, y }, ( x + 2 * y ) % 7 < 4 ? t_dirt : mixed );
+        }
+    }
+    // Runs of one, at both ends of the submap.
+    sm.set_ter( corner_ne, t_floor_red );
+    sm.set_ter( corner_sw, t_floor_blue );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_object();
+    jsout.member( "version", savegame_version );
+    sm.store( jsout );
+    jsout.end_object();
+
+    std::istringstream is( os.str() );
+    JsonIn jsin( is );
+    submap loaded;
+    load_from_jsin( loaded, jsin );
+    int mismatches = 0;
+    for( int y = 0; y < SEEY; ++y ) {
+        for( int x = 0; x < SEEX; ++x ) {
+            if( loaded.get_ter( { x, y } ) != sm.get_ter( { x, y } ) ) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
 TEST_CASE( "submap_furniture_load", "[submap][load]" )
 {
     submap sm;
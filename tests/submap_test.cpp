@@ -1,7 +1,11 @@
 #include "cata_catch.h"
 #include "submap.h"
 
+#include <memory>
+
+#include "coordinate_conversions.h"
 #include "game_constants.h"
+#include "mapbuffer.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -115,3 +119,86 @@ TEST_CASE( "submap rotation2", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap field tile marks follow rotation", "[submap][field]" )
+{
+    int rotation_turns = GENERATE( 0, 1, 2, 3 );
+    CAPTURE( rotation_turns );
+    submap sm;
+    const point marked( 2, 5 );
+    REQUIRE_FALSE( sm.any_field_tile_marked() );
+    sm.mark_field_tile( marked );
+
+    sm.rotate( rotation_turns );
+
+    const point rotated = marked.rotate( rotation_turns, {SEEX, SEEY} );
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point p( x, y );
+            CAPTURE( p );
+            CHECK( sm.field_tile_marked( p ) == ( p == rotated ) );
+        }
+    }
+    sm.unmark_field_tile( rotated );
+    CHECK_FALSE( sm.any_field_tile_marked() );
+}
+
+TEST_CASE( "mapbuffer_lookups_follow_added_submaps", "[submap]" )
+{
+    mapbuffer buffer;
+    // Far from any save, and 8 apart so both share one slot of the recent submaps.
+    const tripoint first( 4000, 4000, 0 );
+    const tripoint second( 4008, 4000, 0 );
+    std::unique_ptr<submap> sm = std::make_unique<submap>();
+    submap *const first_sm = sm.get();
+    REQUIRE( buffer.add_submap( first, sm ) );
+    CHECK( sm == nullptr );
+
+    sm = std::make_unique<submap>();
+    submap *const second_sm = sm.get();
+    REQUIRE( buffer.add_submap( second, sm ) );
+
+    for( int i = 0; i < 2; ++i ) {
+        CHECK( buffer.lookup_submap( first ) == first_sm );
+        CHECK( buffer.lookup_submap( second ) == second_sm );
+    }
+    CHECK( buffer.lookup_submap( first + tripoint_above ) == nullptr );
+
+    // A second submap at the same place is refused and stays with the caller.
+    sm = std::make_unique<submap>();
+    CHECK_FALSE( buffer.add_submap( first, sm ) );
+    CHECK( sm != nullptr );
+    CHECK( buffer.lookup_submap( first ) == first_sm );
+
+    buffer.clear();
+    CHECK( buffer.lookup_submap( first ) == nullptr );
+}
+
+TEST_CASE( "mapbuffer_drops_only_uniform_quads", "[submap]" )
+{
+    mapbuffer buffer;
+    const tripoint uniform_quad( 2000, 2000, 0 );
+    const tripoint mixed_quad( 2001, 2000, 0 );
+    const auto add_quad = [&]( const tripoint & om_addr, bool uniform ) {
+        for( const point &offset : {
+                 point_zero, point_south, point_east, point_south_east
+             } ) {
+            std::unique_ptr<submap> sm = std::make_unique<submap>();
+            sm->is_uniform = uniform || offset != point_east;
+            REQUIRE( buffer.add_submap( omt_to_sm_copy( om_addr ) + offset, sm ) );
+        }
+    };
+    add_quad( uniform_quad, true );
+    add_quad( mixed_quad, false );
+    const tripoint mixed_first = omt_to_sm_copy( mixed_quad );
+    REQUIRE( buffer.lookup_submap( omt_to_sm_copy( uniform_quad ) ) != nullptr );
+
+    CHECK( buffer.drop_uniform_quad( uniform_quad ) );
+    CHECK( buffer.lookup_submap( omt_to_sm_copy( uniform_quad ) ) == nullptr );
+    CHECK( buffer.lookup_submap( omt_to_sm_copy( uniform_quad ) + point_south_east ) == nullptr );
+    CHECK_FALSE( buffer.drop_uniform_quad( uniform_quad ) );
+
+    CHECK_FALSE( buffer.drop_uniform_quad( mixed_quad ) );
+    CHECK( buffer.lookup_submap( mixed_first ) != nullptr );
+    CHECK( buffer.lookup_submap( mixed_first + point_east ) != nullptr );
+}
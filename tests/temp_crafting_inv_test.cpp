@@ -1,7 +1,10 @@
 #include "../src/temp_crafting_inventory.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "inventory.h"
 #include "item.h"
+#include "item_pocket.h"
+#include "ret_val.h"
 #include "type_id.h"
 
 static const itype_id itype_test_gum( "test_gum" );
@@ -46,3 +49,31 @@ TEST_CASE( "temp_crafting_inv_test_quality", "[crafting][inventory]" )
 
     CHECK( inv.max_quality( qual_PRY ) == 4 );
 }
+
+TEST_CASE( "inventory_quality_index_follows_changes", "[crafting][inventory]" )
+{
+    inventory inv;
+    CHECK_FALSE( inv.has_quality( qual_HAMMER ) );
+
+    inv.add_item( item( "test_halligan" ) );
+    CHECK( inv.has_quality( qual_HAMMER, 2 ) );
+    CHECK_FALSE( inv.has_quality( qual_HAMMER, 3 ) );
+    CHECK_FALSE( inv.has_quality( qual_HAMMER, 1, 2 ) );
+
+    inv.add_item( item( "test_halligan" ) );
+    CHECK( inv.has_quality( qual_HAMMER, 1, 2 ) );
+
+    inv.remove_item( &inv.find_item( 0 ) );
+    CHECK_FALSE( inv.has_quality( qual_HAMMER, 1, 2 ) );
+
+    // Contained tools count, and so do their containers.
+    item bag( "test_duffelbag" );
+    REQUIRE( bag.put_in( item( "test_fire_ax" ), item_pocket::pocket_type::CONTAINER ).success() );
+    inv.add_item( bag );
+    CHECK( inv.has_quality( qual_AXE, 1, 2 ) );
+    CHECK_FALSE( inv.has_quality( qual_AXE, 1, 3 ) );
+
+    inv.clear();
+    CHECK_FALSE( inv.has_quality( qual_HAMMER ) );
+    CHECK_FALSE( inv.has_quality( qual_AXE ) );
+}
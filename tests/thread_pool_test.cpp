@@ -0,0 +1,34 @@
+#include <atomic>
+#include <vector>
+
+#include "cata_catch.h"
+#include "thread_pool.h"
+
+static void check_every_index_runs_once( thread_pool &pool )
+{
+    std::vector<std::atomic<int>> runs( 100 );
+    for( std::atomic<int> &r : runs ) {
+        r = 0;
+    }
+    pool.parallel_for( 0, 100, [&runs]( const int i ) {
+        ++runs[i];
+    } );
+    for( int i = 0; i < 100; ++i ) {
+        CAPTURE( i );
+        CHECK( runs[i] == 1 );
+    }
+}
+
+TEST_CASE( "thread_pool_runs_every_index_after_resizing", "[thread_pool]" )
+{
+    thread_pool pool( 2 );
+    check_every_index_runs_once( pool );
+
+    pool.set_worker_count( 0 );
+    CHECK( pool.worker_count() == 0 );
+    check_every_index_runs_once( pool );
+
+    pool.set_worker_count( 3 );
+    CHECK( pool.worker_count() == 3 );
+    check_every_index_runs_once( pool );
+}
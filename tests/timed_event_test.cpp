@@ -0,0 +1,32 @@
+#include "calendar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "timed_event.h"
+
+TEST_CASE( "timed_events_happen_once_they_are_due", "[timed_event]" )
+{
+    const time_point start = calendar::turn;
+    timed_event_manager events;
+    // Neither type does anything when it happens.
+    events.add( timed_event_type::DIM, start + 10_turns, -1, tripoint_abs_sm(), 3 );
+    events.add( timed_event_type::NONE, start + 5_turns, -1, tripoint_abs_sm() );
+    REQUIRE( events.queued( timed_event_type::DIM ) );
+    REQUIRE( events.queued( timed_event_type::NONE ) );
+    CHECK_FALSE( events.queued( timed_event_type::ARTIFACT_LIGHT ) );
+    CHECK( events.get( timed_event_type::ARTIFACT_LIGHT ) == nullptr );
+
+    events.process();
+    CHECK( events.queued( timed_event_type::NONE ) );
+
+    calendar::turn = start + 5_turns;
+    events.process();
+    CHECK_FALSE( events.queued( timed_event_type::NONE ) );
+    const timed_event *dim = events.get( timed_event_type::DIM );
+    REQUIRE( dim != nullptr );
+    CHECK( dim->strength == 3 );
+
+    calendar::turn = start + 10_turns;
+    events.process();
+    CHECK_FALSE( events.queued( timed_event_type::DIM ) );
+    calendar::turn = start;
+}
@@ -3,6 +3,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,6 +17,7 @@
 #include "inventory.h"
 #include "item.h"
 #include "itype.h"
+#include "json.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "optional.h"
@@ -40,6 +42,7 @@ static const recipe_id recipe_oatmeal_cooked( "oatmeal_cooked" );
 
 static const vpart_id vpart_halfboard_horizontal( "halfboard_horizontal" );
 
+static const vproto_id vehicle_prototype_car( "car" );
 static const vproto_id vehicle_prototype_test_rv( "test_rv" );
 
 static time_point midnight = calendar::turn_zero;
@@ -227,3 +230,48 @@ TEST_CASE( "craft_available_via_vehicle_rig", "[vehicle][vehicle_craft]" )
         test_craft_via_rig( items, 2, 0, 1, 0, recipe_oatmeal_cooked.obj(), true );
     }
 }
+
+static vehicle_part round_trip( const vehicle_part &pt, std::string &saved )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    pt.serialize( jsout );
+    saved = os.str();
+    std::istringstream is( saved );
+    JsonIn jsin( is );
+    vehicle_part read;
+    read.deserialize( jsin.get_object() );
+    return read;
+}
+
+TEST_CASE( "vehicle_parts_save_only_what_differs_from_a_new_part", "[vehicle][vehicle_parts]" )
+{
+    clear_map();
+    vehicle *veh = get_map().add_vehicle( vehicle_prototype_car, tripoint( 60, 60, 0 ),
+                                          0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+
+    std::string saved;
+    for( const vpart_reference &vp : veh->get_all_parts() ) {
+        vehicle_part &pt = vp.part();
+        CAPTURE( pt.name() );
+        pt.blood = 0;
+        pt.open = false;
+        pt.enabled = true;
+        const vehicle_part plain = round_trip( pt, saved );
+        CHECK( saved.find( "\"blood\"" ) == std::string::npos );
+        CHECK( saved.find( "\"open\"" ) == std::string::npos );
+        CHECK( saved.find( "\"enabled\"" ) == std::string::npos );
+        CHECK( plain.mount == pt.mount );
+        CHECK( plain.direction == pt.direction );
+        CHECK( plain.flags == pt.flags );
+
+        pt.blood = 200;
+        pt.open = true;
+        pt.enabled = false;
+        const vehicle_part changed = round_trip( pt, saved );
+        CHECK( changed.blood == 200 );
+        CHECK( changed.open );
+        CHECK_FALSE( changed.enabled );
+    }
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 
@@ -14,11 +15,16 @@
 #include "weather.h"
 #include "weather_type.h"
 
+static const ammotype ammo_battery( "battery" );
+
 static const efftype_id effect_blind( "blind" );
 
 static const itype_id fuel_type_battery( "battery" );
 static const itype_id fuel_type_plut_cell( "plut_cell" );
 
+static const vpart_id vpart_small_storage_battery( "small_storage_battery" );
+static const vpart_id vpart_storage_battery( "storage_battery" );
+
 static const vproto_id vehicle_prototype_reactor_test( "reactor_test" );
 static const vproto_id vehicle_prototype_scooter_electric_test( "scooter_electric_test" );
 static const vproto_id vehicle_prototype_scooter_test( "scooter_test" );
@@ -190,3 +196,49 @@ TEST_CASE( "maximum reverse velocity", "[vehicle][power][reverse]" )
     }
 }
 
+
+TEST_CASE( "battery charge is spread by charge level", "[vehicle][power]" )
+{
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+    clear_vehicles();
+    map &here = get_map();
+
+    vehicle *veh_ptr = here.add_vehicle( vehicle_prototype_scooter_electric_test,
+                                         tripoint( 10, 0, 0 ), 0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    veh_ptr->install_part( point_zero, vpart_small_storage_battery, "", true );
+    veh_ptr->install_part( point_zero, vpart_storage_battery, "", true );
+    REQUIRE( veh_ptr->batteries.size() >= 3 );
+    veh_ptr->discharge_battery( veh_ptr->fuel_left( fuel_type_battery ) );
+    REQUIRE( veh_ptr->fuel_left( fuel_type_battery ) == 0 );
+    const int capacity = veh_ptr->battery_power_level().second;
+
+    // Every battery ends up within a percent of the same charge level.
+    const auto check_even = [&]() {
+        int lowest = 100;
+        int highest = 0;
+        for( const int bi : veh_ptr->batteries ) {
+            const vehicle_part &pt = veh_ptr->part( bi );
+            const int level = pt.ammo_remaining() * 100 / pt.ammo_capacity( ammo_battery );
+            lowest = std::min( lowest, level );
+            highest = std::max( highest, level );
+        }
+        CHECK( highest - lowest <= 1 );
+    };
+
+    CHECK( veh_ptr->charge_battery( capacity / 3 ) == 0 );
+    CHECK( veh_ptr->fuel_left( fuel_type_battery ) == capacity / 3 );
+    check_even();
+
+    CHECK( veh_ptr->discharge_battery( capacity / 5 ) == 0 );
+    CHECK( veh_ptr->fuel_left( fuel_type_battery ) == capacity / 3 - capacity / 5 );
+    check_even();
+
+    const int stored = veh_ptr->fuel_left( fuel_type_battery );
+    CHECK( veh_ptr->charge_battery( capacity ) == stored );
+    CHECK( veh_ptr->fuel_left( fuel_type_battery ) == capacity );
+
+    CHECK( veh_ptr->discharge_battery( capacity + 100 ) == 100 );
+    CHECK( veh_ptr->fuel_left( fuel_type_battery ) == 0 );
+}
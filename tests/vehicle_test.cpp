@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <map>
+#include <set>
 #include <vector>
 
 #include "avatar.h"
+#include "calendar.h"
 #include "cata_catch.h"
 #include "character.h"
 #include "damage.h"
@@ -12,9 +16,20 @@
 #include "point.h"
 #include "type_id.h"
 #include "units.h"
+#include "veh_type.h"
 #include "vehicle.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
+
+static const itype_id itype_battery( "battery" );
+static const itype_id itype_rock( "rock" );
+
+static const vpart_id vpart_frame( "frame" );
+static const vpart_id vpart_seat( "seat" );
+static const vpart_id vpart_wheel( "wheel" );
 
 static const vproto_id vehicle_prototype_bicycle( "bicycle" );
+static const vproto_id vehicle_prototype_car( "car" );
 
 TEST_CASE( "detaching_vehicle_unboards_passengers" )
 {
@@ -113,3 +128,142 @@ TEST_CASE( "starting_bicycle_damaged_pedal" )
 
     here.detach_vehicle( veh_ptr );
 }
+
+TEST_CASE( "vehicle_part_caches_match_a_full_refresh", "[vehicle]" )
+{
+    clear_map();
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vehicle_prototype_car, tripoint( 60, 60, 0 ), 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+
+    const auto caches = [veh]() {
+        return std::make_pair( veh->relative_parts, std::vector<std::vector<int>> {
+            veh->alternators, veh->engines, veh->solar_panels, veh->funnels, veh->emitters,
+            veh->wheelcache, veh->steering, veh->speciality, veh->floating, veh->batteries,
+            veh->fuel_containers, veh->turret_locations, veh->mufflers, veh->accessories
+        } );
+    };
+    // The flat lookup grid has to follow the patched mount points too.
+    const auto check_mount_lookup = [veh]() {
+        int mismatches = 0;
+        for( int x = -10; x <= 10; ++x ) {
+            for( int y = -10; y <= 10; ++y ) {
+                const point dp( x, y );
+                const auto here = veh->relative_parts.find( dp );
+                const std::vector<int> expected = here == veh->relative_parts.end() ?
+                                                  std::vector<int>() : here->second;
+                if( veh->parts_at_mount( dp ) != expected ) {
+                    ++mismatches;
+                }
+            }
+        }
+        CHECK( mismatches == 0 );
+    };
+    // Every change below patches the caches in place; a full refresh must agree.
+    const auto check_against_refresh = [&]() {
+        check_mount_lookup();
+        const auto patched = caches();
+        veh->suspend_refresh();
+        veh->enable_refresh();
+        CHECK( patched == caches() );
+    };
+
+    const int part_count = veh->part_count();
+    for( int p = 0; p < part_count; p += 5 ) {
+        CAPTURE( p );
+        veh->damage( p, 100000, damage_type::PURE );
+        check_against_refresh();
+    }
+    for( int p = 1; p < veh->part_count(); p += 7 ) {
+        CAPTURE( p );
+        veh->remove_part( p );
+        check_against_refresh();
+    }
+    int max_x = 0;
+    for( const auto &mount : veh->relative_parts ) {
+        max_x = std::max( max_x, mount.first.x );
+    }
+    const point outside( max_x + 1, 0 );
+    veh->install_part( outside, vpart_frame, "", true );
+    check_against_refresh();
+    veh->install_part( outside, vpart_seat, "", true );
+    check_against_refresh();
+    veh->install_part( point_zero, vpart_wheel, "", true );
+    check_against_refresh();
+}
+
+TEST_CASE( "vehicle_caches_follow_displacement", "[vehicle]" )
+{
+    clear_map();
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vehicle_prototype_car, tripoint( 60, 60, 0 ), 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+
+    const auto check_caches = [&]() {
+        const std::set<tripoint> &points = veh->get_points( true );
+        int mismatches = 0;
+        for( int x = 40; x < 90; ++x ) {
+            for( int y = 40; y < 80; ++y ) {
+                const tripoint p( x, y, 0 );
+                const optional_vpart_position vp = here.veh_at( p );
+                if( vp.has_value() != ( points.count( p ) > 0 ) ||
+                    ( vp && &vp->vehicle() != veh ) ) {
+                    ++mismatches;
+                }
+            }
+        }
+        CHECK( mismatches == 0 );
+    };
+
+    check_caches();
+    // Far enough to cross into the next submap, along and across the car.
+    for( int i = 0; i < 14; ++i ) {
+        REQUIRE( here.displace_vehicle( *veh, tripoint_east ) );
+        check_caches();
+    }
+    for( int i = 0; i < 3; ++i ) {
+        REQUIRE( here.displace_vehicle( *veh, tripoint_south ) );
+        check_caches();
+    }
+}
+
+TEST_CASE( "vehicle_mass_follows_cargo_without_a_full_recount", "[vehicle]" )
+{
+    clear_map();
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vehicle_prototype_car, tripoint( 60, 60, 0 ), 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+
+    std::vector<int> cargo;
+    for( const vpart_reference &vp : veh->get_avail_parts( vpart_bitflags::VPFLAG_CARGO ) ) {
+        cargo.push_back( vp.part_index() );
+    }
+    REQUIRE( cargo.size() >= 2 );
+
+    // Mass and center of mass as they come out of walking every part.
+    const auto check_against_recount = [veh]() {
+        const units::mass mass = veh->total_mass();
+        const point center = veh->local_center_of_mass();
+        veh->invalidate_mass();
+        CHECK( to_gram( mass ) == to_gram( veh->total_mass() ) );
+        CHECK( center == veh->local_center_of_mass() );
+    };
+
+    veh->total_mass();
+    // Heavy enough to pull the center of mass towards the front or the back.
+    for( int i = 0; i < 20; ++i ) {
+        veh->add_item( cargo.front(), item( itype_rock ) );
+    }
+    check_against_recount();
+    for( int i = 0; i < 20; ++i ) {
+        veh->add_item( cargo.back(), item( itype_rock ) );
+    }
+    veh->add_item( cargo.back(), item( itype_battery, calendar::turn, 100 ) );
+    veh->add_item( cargo.back(), item( itype_battery, calendar::turn, 100 ) );
+    check_against_recount();
+    while( !veh->get_items( cargo.front() ).empty() ) {
+        vehicle_stack items = veh->get_items( cargo.front() );
+        items.erase( items.begin() );
+    }
+    check_against_recount();
+}
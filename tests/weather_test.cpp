@@ -5,6 +5,10 @@
 
 #include "calendar.h"
 #include "cata_catch.h"
+#include "field_type.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
 #include "options_helpers.h"
 #include "point.h"
 #include "type_id.h"
@@ -342,3 +346,44 @@ TEST_CASE( "local wind chill calculation", "[weather][wind_chill]" )
     }
 }
 
+
+TEST_CASE( "remembered weather temperatures match fresh ones", "[weather]" )
+{
+    const weather_generator &wgen = get_weather().get_cur_weather_gen();
+    const unsigned seed = 317'024'741;
+    const tripoint pos( 40, 70, 0 );
+    // More hours than the cache holds, so it is also cleared along the way.
+    for( int pass = 0; pass < 2; ++pass ) {
+        for( int hour = 0; hour < 24 * 1500; hour += 7 ) {
+            const time_point t = calendar::turn_zero + 1_hours * hour;
+            CAPTURE( pass, hour );
+            CHECK( wgen.get_weather_temperature( pos, t, seed ) ==
+                   wgen.get_weather( pos, t, seed ).temperature );
+        }
+    }
+    CHECK( wgen.get_weather_temperature( pos, calendar::turn_zero, seed ) !=
+           wgen.get_weather_temperature( pos, calendar::turn_zero, seed + 1 ) );
+}
+
+TEST_CASE( "local temperature mods are kept until the cache is cleared", "[weather]" )
+{
+    clear_map();
+    map &here = get_map();
+    weather_manager &weather = get_weather();
+    const tripoint pos( 60, 60, 0 );
+    const tripoint fire_pos = pos + tripoint_east * 2;
+    weather.clear_temp_cache();
+    REQUIRE( weather.get_temperature_mod( pos ) == 0 );
+
+    here.add_field( fire_pos, fd_fire, 3 );
+    // Still the value seen earlier this turn.
+    CHECK( weather.get_temperature_mod( pos ) == 0 );
+    weather.clear_temp_cache();
+    const int warmed = weather.get_temperature_mod( pos );
+    CHECK( warmed > 0 );
+    CHECK( warmed == get_heat_radiation( pos, false ) + get_convection_temperature( pos ) );
+
+    here.remove_field( fire_pos, fd_fire );
+    weather.clear_temp_cache();
+    CHECK( weather.get_temperature_mod( pos ) == 0 );
+}
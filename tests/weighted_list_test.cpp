@@ -0,0 +1,59 @@
+#include <climits>
+#include <vector>
+
+#include "cata_catch.h"
+#include "weighted_list.h"
+
+// Picks with evenly spread random numbers and checks every entry comes up as often as its
+// weight says.
+template<typename List>
+static void check_pick_frequencies( List &list, const std::vector<int> &weights )
+{
+    constexpr unsigned int picks = 1 << 20;
+    std::vector<int> counts( weights.size() );
+    for( unsigned int k = 0; k < picks; ++k ) {
+        const int *picked = list.pick( k * ( UINT_MAX / picks ) );
+        REQUIRE( picked != nullptr );
+        ++counts[*picked];
+    }
+    int total = 0;
+    for( const int w : weights ) {
+        total += w;
+    }
+    for( size_t i = 0; i < weights.size(); ++i ) {
+        CAPTURE( i );
+        if( weights[i] == 0 ) {
+            CHECK( counts[i] == 0 );
+        } else {
+            CHECK( counts[i] == Approx( static_cast<double>( picks ) * weights[i] / total ).epsilon(
+                       0.01 ) );
+        }
+    }
+}
+
+TEST_CASE( "long_weighted_lists_pick_by_weight", "[weighted_list]" )
+{
+    std::vector<int> weights;
+    for( int i = 0; i < 40; ++i ) {
+        weights.push_back( i % 7 == 3 ? 0 : 1 + i % 5 );
+    }
+
+    SECTION( "int weights" ) {
+        weighted_int_list<int> list;
+        for( size_t i = 0; i < weights.size(); ++i ) {
+            list.add( static_cast<int>( i ), weights[i] );
+        }
+        check_pick_frequencies( list, weights );
+        // The table is built again after a change.
+        list.add_or_replace( 0, 30 );
+        weights[0] = 30;
+        check_pick_frequencies( list, weights );
+    }
+    SECTION( "float weights" ) {
+        weighted_float_list<int> list;
+        for( size_t i = 0; i < weights.size(); ++i ) {
+            list.add( static_cast<int>( i ), weights[i] );
+        }
+        check_pick_frequencies( list, weights );
+    }
+}
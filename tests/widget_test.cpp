@@ -359,6 +359,30 @@ TEST_CASE( "widgets showing avatar attributes", "[widget][avatar]" )
     }
 }
 
+TEST_CASE( "cached widgets", "[widget][cache]" )
+{
+    avatar &ava = get_avatar();
+    clear_avatar();
+    widget str_w = widget_test_str_num.obj();
+    REQUIRE( widget::refresh_of( widget_var::stat_str ) == widget_refresh::action );
+
+    ava.str_max = 8;
+    ava.moves = 100;
+    CHECK( str_w.layout( ava, 0, true ) == "STR: 8" );
+
+    ava.str_max = 9;
+    // Nothing happened that may have changed the value, so the old text is shown.
+    CHECK( str_w.layout( ava, 0, true ) == "STR: 8" );
+    CHECK( str_w.layout( ava ) == "STR: 9" );
+
+    ava.moves -= 50;
+    CHECK( str_w.layout( ava, 0, true ) == "STR: 9" );
+
+    ava.str_max = 10;
+    calendar::turn += 1_turns;
+    CHECK( str_w.layout( ava, 0, true ) == "STR: 10" );
+}
+
 TEST_CASE( "layout widgets", "[widget][layout]" )
 {
     widget stats_w = widget_test_stat_panel.obj();